@@ -0,0 +1,39 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "TidopLib::Core" for configuration "Release"
+set_property(TARGET TidopLib::Core APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(TidopLib::Core PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libtl_core.a"
+  )
+
+list(APPEND _cmake_import_check_targets TidopLib::Core )
+list(APPEND _cmake_import_check_files_for_TidopLib::Core "${_IMPORT_PREFIX}/lib/libtl_core.a" )
+
+# Import target "TidopLib::Math" for configuration "Release"
+set_property(TARGET TidopLib::Math APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(TidopLib::Math PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libtl_math.a"
+  )
+
+list(APPEND _cmake_import_check_targets TidopLib::Math )
+list(APPEND _cmake_import_check_files_for_TidopLib::Math "${_IMPORT_PREFIX}/lib/libtl_math.a" )
+
+# Import target "TidopLib::Geom" for configuration "Release"
+set_property(TARGET TidopLib::Geom APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(TidopLib::Geom PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libtl_geom.a"
+  )
+
+list(APPEND _cmake_import_check_targets TidopLib::Geom )
+list(APPEND _cmake_import_check_files_for_TidopLib::Geom "${_IMPORT_PREFIX}/lib/libtl_geom.a" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
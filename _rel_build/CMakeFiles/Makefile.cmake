@@ -0,0 +1,281 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/fmt/fmt-config-version.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-config.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets-release.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/apps/CMakeLists.txt"
+  "/root/repo/cmake/CompilerInfo.cmake"
+  "/root/repo/cmake/OperatingSystemInfo.cmake"
+  "/root/repo/cmake/TidopLibConfig.cmake.in"
+  "/root/repo/cmake/TidopLibSIMDSupport.cmake"
+  "/root/repo/cmake/TidopUtils.cmake"
+  "/root/repo/cmake/config.h.in"
+  "/root/repo/doc/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/tidop/core/CMakeLists.txt"
+  "/root/repo/src/tidop/featmatch/CMakeLists.txt"
+  "/root/repo/src/tidop/geometry/CMakeLists.txt"
+  "/root/repo/src/tidop/geospatial/CMakeLists.txt"
+  "/root/repo/src/tidop/geotools/CMakeLists.txt"
+  "/root/repo/src/tidop/graphic/CMakeLists.txt"
+  "/root/repo/src/tidop/img/CMakeLists.txt"
+  "/root/repo/src/tidop/imgprocess/CMakeLists.txt"
+  "/root/repo/src/tidop/math/CMakeLists.txt"
+  "/root/repo/src/tidop/pctools/CMakeLists.txt"
+  "/root/repo/src/tidop/vect/CMakeLists.txt"
+  "/root/repo/src/tidop/viewer/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/test/GeoTools/CMakeLists.txt"
+  "/root/repo/test/PointCloudTools/CMakeLists.txt"
+  "/root/repo/test/core/CMakeLists.txt"
+  "/root/repo/test/core/argument/CMakeLists.txt"
+  "/root/repo/test/core/concurrency/CMakeLists.txt"
+  "/root/repo/test/core/console/CMakeLists.txt"
+  "/root/repo/test/core/flag/CMakeLists.txt"
+  "/root/repo/test/core/licence/CMakeLists.txt"
+  "/root/repo/test/core/messages/CMakeLists.txt"
+  "/root/repo/test/core/path/CMakeLists.txt"
+  "/root/repo/test/core/process/CMakeLists.txt"
+  "/root/repo/test/core/units/CMakeLists.txt"
+  "/root/repo/test/core/utils/CMakeLists.txt"
+  "/root/repo/test/core/validator/CMakeLists.txt"
+  "/root/repo/test/core/xml/CMakeLists.txt"
+  "/root/repo/test/featmatch/CMakeLists.txt"
+  "/root/repo/test/geometry/CMakeLists.txt"
+  "/root/repo/test/geospatial/CMakeLists.txt"
+  "/root/repo/test/graphic/CMakeLists.txt"
+  "/root/repo/test/math/CMakeLists.txt"
+  "/root/repo/test/math/affine/CMakeLists.txt"
+  "/root/repo/test/math/angle_conversion/CMakeLists.txt"
+  "/root/repo/test/math/cholesky/CMakeLists.txt"
+  "/root/repo/test/math/data/CMakeLists.txt"
+  "/root/repo/test/math/eigen/CMakeLists.txt"
+  "/root/repo/test/math/fitting/CMakeLists.txt"
+  "/root/repo/test/math/levenberg_marquardt/CMakeLists.txt"
+  "/root/repo/test/math/lu/CMakeLists.txt"
+  "/root/repo/test/math/matrix/CMakeLists.txt"
+  "/root/repo/test/math/mixed_precision/CMakeLists.txt"
+  "/root/repo/test/math/qr/CMakeLists.txt"
+  "/root/repo/test/math/quaternion/CMakeLists.txt"
+  "/root/repo/test/math/ransac/CMakeLists.txt"
+  "/root/repo/test/math/rotation/CMakeLists.txt"
+  "/root/repo/test/math/rotation_batch/CMakeLists.txt"
+  "/root/repo/test/math/rotation_converter/CMakeLists.txt"
+  "/root/repo/test/math/scaling/CMakeLists.txt"
+  "/root/repo/test/math/simd/CMakeLists.txt"
+  "/root/repo/test/math/sparse_matrix/CMakeLists.txt"
+  "/root/repo/test/math/sparse_solvers/CMakeLists.txt"
+  "/root/repo/test/math/statistic/CMakeLists.txt"
+  "/root/repo/test/math/statistics/CMakeLists.txt"
+  "/root/repo/test/math/svd/CMakeLists.txt"
+  "/root/repo/test/math/transform/CMakeLists.txt"
+  "/root/repo/test/math/transform_batch/CMakeLists.txt"
+  "/root/repo/test/math/translation/CMakeLists.txt"
+  "/root/repo/test/math/umeyama/CMakeLists.txt"
+  "/root/repo/test/math/utils/CMakeLists.txt"
+  "/root/repo/test/math/vector/CMakeLists.txt"
+  "/root/repo/test/vect/CMakeLists.txt"
+  "/root/repo/test/viewer/CMakeLists.txt"
+  "/root/repo/third_party/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/BoostDetectToolset-1.74.0.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/boost_filesystem-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/boost_filesystem-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/libboost_filesystem-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/libboost_filesystem-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/boost_unit_test_framework-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/boost_unit_test_framework-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/libboost_unit_test_framework-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/libboost_unit_test_framework-variant-static.cmake"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-AnyNewerVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "tidop/config.h"
+  "TidopLibConfigVersion.cmake"
+  "TidopLibConfig.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "doc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/math/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/geometry/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/img/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/featmatch/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/graphic/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/imgprocess/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/vect/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/geospatial/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/viewer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/geotools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tidop/pctools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/argument/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/console/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/concurrency/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/flag/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/licence/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/messages/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/path/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/process/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/xml/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/validator/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/core/units/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/featmatch/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/geometry/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/geospatial/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/GeoTools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/graphic/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/matrix/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/quaternion/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/vector/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/angle_conversion/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/rotation_converter/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/statistics/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/statistic/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/qr/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/lu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/cholesky/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/svd/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/simd/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/umeyama/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/transform/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/affine/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/translation/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/scaling/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/rotation/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/data/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/transform_batch/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/rotation_batch/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/ransac/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/fitting/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/mixed_precision/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/sparse_matrix/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/sparse_solvers/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/levenberg_marquardt/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/math/eigen/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/PointCloudTools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/vect/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/viewer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "src/tidop/core/CMakeFiles/Core.dir/DependInfo.cmake"
+  "src/tidop/math/CMakeFiles/Math.dir/DependInfo.cmake"
+  "src/tidop/geometry/CMakeFiles/Geom.dir/DependInfo.cmake"
+  "test/core/argument/CMakeFiles/argument_test.dir/DependInfo.cmake"
+  "test/core/console/CMakeFiles/console_test.dir/DependInfo.cmake"
+  "test/core/concurrency/CMakeFiles/concurrency_test.dir/DependInfo.cmake"
+  "test/core/flag/CMakeFiles/flag_test.dir/DependInfo.cmake"
+  "test/core/licence/CMakeFiles/licence_test.dir/DependInfo.cmake"
+  "test/core/messages/CMakeFiles/msg_test.dir/DependInfo.cmake"
+  "test/core/path/CMakeFiles/path_test.dir/DependInfo.cmake"
+  "test/core/process/CMakeFiles/process_test.dir/DependInfo.cmake"
+  "test/core/utils/CMakeFiles/utils_test.dir/DependInfo.cmake"
+  "test/core/xml/CMakeFiles/xml_test.dir/DependInfo.cmake"
+  "test/core/validator/CMakeFiles/validator_test.dir/DependInfo.cmake"
+  "test/core/units/CMakeFiles/units_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/box_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/convex_hull_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/dbscan.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/kdtree_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/linestring_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/operation_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/point_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/polygon_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/polylabel_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/prepared_polygon_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/rect_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/rtree_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/segment_intersection_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/segment_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/shapes_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/size_test.dir/DependInfo.cmake"
+  "test/geometry/CMakeFiles/window_test.dir/DependInfo.cmake"
+  "test/math/utils/CMakeFiles/mathutils_test.dir/DependInfo.cmake"
+  "test/math/matrix/CMakeFiles/matrix_test.dir/DependInfo.cmake"
+  "test/math/quaternion/CMakeFiles/quaternion_test.dir/DependInfo.cmake"
+  "test/math/vector/CMakeFiles/vector_test.dir/DependInfo.cmake"
+  "test/math/angle_conversion/CMakeFiles/angle_conversion_test.dir/DependInfo.cmake"
+  "test/math/rotation_converter/CMakeFiles/rotation_converter_test.dir/DependInfo.cmake"
+  "test/math/statistics/CMakeFiles/statistics_test.dir/DependInfo.cmake"
+  "test/math/statistic/CMakeFiles/statistic_test.dir/DependInfo.cmake"
+  "test/math/qr/CMakeFiles/qr_test.dir/DependInfo.cmake"
+  "test/math/lu/CMakeFiles/lu_test.dir/DependInfo.cmake"
+  "test/math/cholesky/CMakeFiles/cholesky_test.dir/DependInfo.cmake"
+  "test/math/svd/CMakeFiles/svd_test.dir/DependInfo.cmake"
+  "test/math/simd/CMakeFiles/simd_test.dir/DependInfo.cmake"
+  "test/math/umeyama/CMakeFiles/umeyama_test.dir/DependInfo.cmake"
+  "test/math/transform/CMakeFiles/transform_test.dir/DependInfo.cmake"
+  "test/math/affine/CMakeFiles/affine_test.dir/DependInfo.cmake"
+  "test/math/translation/CMakeFiles/translation_test.dir/DependInfo.cmake"
+  "test/math/scaling/CMakeFiles/scaling_test.dir/DependInfo.cmake"
+  "test/math/rotation/CMakeFiles/rotation_test.dir/DependInfo.cmake"
+  "test/math/data/CMakeFiles/data_test.dir/DependInfo.cmake"
+  "test/math/transform_batch/CMakeFiles/transform_batch_test.dir/DependInfo.cmake"
+  "test/math/rotation_batch/CMakeFiles/rotation_batch_test.dir/DependInfo.cmake"
+  "test/math/ransac/CMakeFiles/ransac_test.dir/DependInfo.cmake"
+  "test/math/fitting/CMakeFiles/fitting_test.dir/DependInfo.cmake"
+  "test/math/mixed_precision/CMakeFiles/mixed_precision_test.dir/DependInfo.cmake"
+  "test/math/sparse_matrix/CMakeFiles/sparse_matrix_test.dir/DependInfo.cmake"
+  "test/math/sparse_solvers/CMakeFiles/sparse_solvers_test.dir/DependInfo.cmake"
+  "test/math/levenberg_marquardt/CMakeFiles/levenberg_marquardt_test.dir/DependInfo.cmake"
+  "test/math/eigen/CMakeFiles/eigen_test.dir/DependInfo.cmake"
+  )
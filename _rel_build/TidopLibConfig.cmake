@@ -0,0 +1,134 @@
+##########################################################################
+#                                                                        #
+# Copyright (C) 2021 by Tidop Research Group                             #
+# Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       #
+#                                                                        #
+# This file is part of TidopLib                                          #
+#                                                                        #
+# TidopLib is free software: you can redistribute it and/or modify       #
+# it under the terms of the GNU Lesser General Public License as         #
+# published by the Free Software Foundation, either version 3 of the     #
+# License, or (at your option) any later version.                        #
+#                                                                        #
+# TidopLib is distributed in the hope that it will be useful,            #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of         #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          #
+# GNU Lesser General Public License for more details.                    #
+#                                                                        #
+# You should have received a copy of the GNU Lesser General Public       #
+# License along with Foobar. If not, see <http://www.gnu.org/licenses/>. #
+#                                                                        #
+# @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         #
+#                                                                        #
+##########################################################################
+
+
+####### Expanded from @PACKAGE_INIT@ by configure_package_config_file() #######
+####### Any changes to this file will be overwritten by the next CMake run ####
+####### The input file was TidopLibConfig.cmake.in                            ########
+
+get_filename_component(PACKAGE_PREFIX_DIR "${CMAKE_CURRENT_LIST_DIR}/../../../" ABSOLUTE)
+
+macro(set_and_check _var _file)
+  set(${_var} "${_file}")
+  if(NOT EXISTS "${_file}")
+    message(FATAL_ERROR "File or directory ${_file} referenced by variable ${_var} does not exist !")
+  endif()
+endmacro()
+
+macro(check_required_components _NAME)
+  foreach(comp ${${_NAME}_FIND_COMPONENTS})
+    if(NOT ${_NAME}_${comp}_FOUND)
+      if(${_NAME}_FIND_REQUIRED_${comp})
+        set(${_NAME}_FOUND FALSE)
+      endif()
+    endif()
+  endforeach()
+endmacro()
+
+####################################################################################
+
+include(CMakeFindDependencyMacro)
+
+set(TidopLib_INCLUDE_DIRS "/usr/local/include")
+
+message(STATUS "Find TidopLib dependencies")
+
+
+if(YES)
+set(Boost_USE_STATIC_LIBS        ON) # only find static libs
+set(Boost_USE_MULTITHREADED      ON)
+set(Boost_USE_STATIC_RUNTIME     OFF)
+set(Boost_DIR "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0" CACHE PATH "The directory containing BoostConfig.cmake")
+
+find_dependency(Boost QUIET REQUIRED filesystem system)
+endif()
+
+if()
+    set(GDAL_DIR "" CACHE PATH "The directory containing GDALConfig.cmake")
+    find_dependency(GDAL QUIET)
+    if(NOT GDAL_FOUND)
+        set(TL_HAVE_GDAL NO)
+        message(STATUS "  GDAL not found")
+    else()
+        message(STATUS "  GDAL version: ${GDAL_VERSION}")
+        set(TL_HAVE_GDAL YES)
+    endif()		
+endif()
+
+if()
+    set(PROJ_DIR "" CACHE PATH "The directory containing PROJConfig.cmake")
+    find_dependency(PROJ QUIET)
+endif()
+
+if()
+    set(PROJ4_DIR "" CACHE PATH "The directory containing PROJ4Config.cmake")
+    find_dependency(PROJ4 QUIET)
+endif()
+
+if()
+    set(OpenCV_DIR "" CACHE PATH "The directory containing OpenCVConfig.cmake")
+    find_dependency(OpenCV QUIET)
+endif()
+	
+if()
+    set(OpenBLAS_DIR "" CACHE PATH "The directory containing OpenBLASConfig.cmake")
+    find_dependency(OpenBLAS QUIET)
+endif()
+
+if()
+    find_dependency(OpenMP QUIET)
+endif()
+
+if(YES)
+    set(fmt_DIR "/root/miniconda/lib/cmake/fmt" CACHE PATH "The directory containing fmt-config.cmake")
+    find_dependency(fmt QUIET)
+    add_compile_definitions(TL_HAVE_FMT)
+    add_compile_definitions("FORMAT_NAMESPACE=fmt::")
+else()
+    add_compile_definitions("FORMAT_NAMESPACE=std::")
+endif()
+
+if()
+    set(COPCLIB_DIR "" CACHE PATH "The directory containing COPCLIBConfig.cmake")
+	find_dependency(COPCLIB REQUIRED)
+	
+    set(LAZPERF_DIR "" CACHE PATH "The directory containing lazperf-config.cmake")
+	find_dependency(LAZPERF REQUIRED)
+	
+	set(PDAL_DIR "" CACHE PATH "The directory containing PDALConfig.cmake")
+	find_dependency(PDAL REQUIRED)
+endif()
+	
+include("${CMAKE_CURRENT_LIST_DIR}/TidopLibTargets.cmake")
+check_required_components("TidopLib")
+
+#set(_supported_components Core Math)
+#
+#foreach(comp ${TidopLib_FIND_COMPONENTS})
+#  if (NOT ";${_supported_components};" MATCHES comp)
+#    set(TidopLib_FOUND False)
+#    set(TidopLib_NOT_FOUND_MESSAGE "Unsupported component: ${comp}")
+#  endif()
+#  #include("${CMAKE_CURRENT_LIST_DIR}/ClimbingStats${_comp}Targets.cmake")
+#endforeach()
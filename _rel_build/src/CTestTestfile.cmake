@@ -0,0 +1,18 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src
+# Build directory: /root/repo/_rel_build/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("tidop/core")
+subdirs("tidop/math")
+subdirs("tidop/geometry")
+subdirs("tidop/img")
+subdirs("tidop/featmatch")
+subdirs("tidop/graphic")
+subdirs("tidop/imgprocess")
+subdirs("tidop/vect")
+subdirs("tidop/geospatial")
+subdirs("tidop/viewer")
+subdirs("tidop/geotools")
+subdirs("tidop/pctools")
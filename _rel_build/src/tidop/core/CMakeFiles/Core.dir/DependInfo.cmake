@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/tidop/core/app.cpp" "src/tidop/core/CMakeFiles/Core.dir/app.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/app.cpp.o.d"
+  "/root/repo/src/tidop/core/chrono.cpp" "src/tidop/core/CMakeFiles/Core.dir/chrono.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/chrono.cpp.o.d"
+  "/root/repo/src/tidop/core/concurrency/parallel.cpp" "src/tidop/core/CMakeFiles/Core.dir/concurrency/parallel.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/concurrency/parallel.cpp.o.d"
+  "/root/repo/src/tidop/core/console/argument.cpp" "src/tidop/core/CMakeFiles/Core.dir/console/argument.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/console/argument.cpp.o.d"
+  "/root/repo/src/tidop/core/console/command.cpp" "src/tidop/core/CMakeFiles/Core.dir/console/command.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/console/command.cpp.o.d"
+  "/root/repo/src/tidop/core/console/console.cpp" "src/tidop/core/CMakeFiles/Core.dir/console/console.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/console/console.cpp.o.d"
+  "/root/repo/src/tidop/core/console/menu.cpp" "src/tidop/core/CMakeFiles/Core.dir/console/menu.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/console/menu.cpp.o.d"
+  "/root/repo/src/tidop/core/event.cpp" "src/tidop/core/CMakeFiles/Core.dir/event.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/event.cpp.o.d"
+  "/root/repo/src/tidop/core/exception.cpp" "src/tidop/core/CMakeFiles/Core.dir/exception.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/exception.cpp.o.d"
+  "/root/repo/src/tidop/core/gdalreg.cpp" "src/tidop/core/CMakeFiles/Core.dir/gdalreg.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/gdalreg.cpp.o.d"
+  "/root/repo/src/tidop/core/licence.cpp" "src/tidop/core/CMakeFiles/Core.dir/licence.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/licence.cpp.o.d"
+  "/root/repo/src/tidop/core/log.cpp" "src/tidop/core/CMakeFiles/Core.dir/log.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/log.cpp.o.d"
+  "/root/repo/src/tidop/core/msg/message.cpp" "src/tidop/core/CMakeFiles/Core.dir/msg/message.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/msg/message.cpp.o.d"
+  "/root/repo/src/tidop/core/path.cpp" "src/tidop/core/CMakeFiles/Core.dir/path.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/path.cpp.o.d"
+  "/root/repo/src/tidop/core/progress.cpp" "src/tidop/core/CMakeFiles/Core.dir/progress.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/progress.cpp.o.d"
+  "/root/repo/src/tidop/core/task/events.cpp" "src/tidop/core/CMakeFiles/Core.dir/task/events.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/task/events.cpp.o.d"
+  "/root/repo/src/tidop/core/task/process.cpp" "src/tidop/core/CMakeFiles/Core.dir/task/process.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/task/process.cpp.o.d"
+  "/root/repo/src/tidop/core/task/task.cpp" "src/tidop/core/CMakeFiles/Core.dir/task/task.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/task/task.cpp.o.d"
+  "/root/repo/src/tidop/core/task/tasklist.cpp" "src/tidop/core/CMakeFiles/Core.dir/task/tasklist.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/task/tasklist.cpp.o.d"
+  "/root/repo/src/tidop/core/task/taskqueue.cpp" "src/tidop/core/CMakeFiles/Core.dir/task/taskqueue.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/task/taskqueue.cpp.o.d"
+  "/root/repo/src/tidop/core/task/tasktree.cpp" "src/tidop/core/CMakeFiles/Core.dir/task/tasktree.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/task/tasktree.cpp.o.d"
+  "/root/repo/src/tidop/core/utils.cpp" "src/tidop/core/CMakeFiles/Core.dir/utils.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/utils.cpp.o.d"
+  "/root/repo/src/tidop/core/xml.cpp" "src/tidop/core/CMakeFiles/Core.dir/xml.cpp.o" "gcc" "src/tidop/core/CMakeFiles/Core.dir/xml.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Core.dir/app.cpp.o"
+  "CMakeFiles/Core.dir/app.cpp.o.d"
+  "CMakeFiles/Core.dir/chrono.cpp.o"
+  "CMakeFiles/Core.dir/chrono.cpp.o.d"
+  "CMakeFiles/Core.dir/concurrency/parallel.cpp.o"
+  "CMakeFiles/Core.dir/concurrency/parallel.cpp.o.d"
+  "CMakeFiles/Core.dir/console/argument.cpp.o"
+  "CMakeFiles/Core.dir/console/argument.cpp.o.d"
+  "CMakeFiles/Core.dir/console/command.cpp.o"
+  "CMakeFiles/Core.dir/console/command.cpp.o.d"
+  "CMakeFiles/Core.dir/console/console.cpp.o"
+  "CMakeFiles/Core.dir/console/console.cpp.o.d"
+  "CMakeFiles/Core.dir/console/menu.cpp.o"
+  "CMakeFiles/Core.dir/console/menu.cpp.o.d"
+  "CMakeFiles/Core.dir/event.cpp.o"
+  "CMakeFiles/Core.dir/event.cpp.o.d"
+  "CMakeFiles/Core.dir/exception.cpp.o"
+  "CMakeFiles/Core.dir/exception.cpp.o.d"
+  "CMakeFiles/Core.dir/gdalreg.cpp.o"
+  "CMakeFiles/Core.dir/gdalreg.cpp.o.d"
+  "CMakeFiles/Core.dir/licence.cpp.o"
+  "CMakeFiles/Core.dir/licence.cpp.o.d"
+  "CMakeFiles/Core.dir/log.cpp.o"
+  "CMakeFiles/Core.dir/log.cpp.o.d"
+  "CMakeFiles/Core.dir/msg/message.cpp.o"
+  "CMakeFiles/Core.dir/msg/message.cpp.o.d"
+  "CMakeFiles/Core.dir/path.cpp.o"
+  "CMakeFiles/Core.dir/path.cpp.o.d"
+  "CMakeFiles/Core.dir/progress.cpp.o"
+  "CMakeFiles/Core.dir/progress.cpp.o.d"
+  "CMakeFiles/Core.dir/task/events.cpp.o"
+  "CMakeFiles/Core.dir/task/events.cpp.o.d"
+  "CMakeFiles/Core.dir/task/process.cpp.o"
+  "CMakeFiles/Core.dir/task/process.cpp.o.d"
+  "CMakeFiles/Core.dir/task/task.cpp.o"
+  "CMakeFiles/Core.dir/task/task.cpp.o.d"
+  "CMakeFiles/Core.dir/task/tasklist.cpp.o"
+  "CMakeFiles/Core.dir/task/tasklist.cpp.o.d"
+  "CMakeFiles/Core.dir/task/taskqueue.cpp.o"
+  "CMakeFiles/Core.dir/task/taskqueue.cpp.o.d"
+  "CMakeFiles/Core.dir/task/tasktree.cpp.o"
+  "CMakeFiles/Core.dir/task/tasktree.cpp.o.d"
+  "CMakeFiles/Core.dir/utils.cpp.o"
+  "CMakeFiles/Core.dir/utils.cpp.o.d"
+  "CMakeFiles/Core.dir/xml.cpp.o"
+  "CMakeFiles/Core.dir/xml.cpp.o.d"
+  "libtl_core.a"
+  "libtl_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
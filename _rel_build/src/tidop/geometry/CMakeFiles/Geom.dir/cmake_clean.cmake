@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Geom.dir/entities/segment.cpp.o"
+  "CMakeFiles/Geom.dir/entities/segment.cpp.o.d"
+  "libtl_geom.a"
+  "libtl_geom.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Geom.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
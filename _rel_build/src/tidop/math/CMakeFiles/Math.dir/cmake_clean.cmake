@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Math.dir/algebra/matrix.cpp.o"
+  "CMakeFiles/Math.dir/algebra/matrix.cpp.o.d"
+  "libtl_math.a"
+  "libtl_math.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Math.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
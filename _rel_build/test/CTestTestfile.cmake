@@ -0,0 +1,16 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_rel_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("core")
+subdirs("featmatch")
+subdirs("geometry")
+subdirs("geospatial")
+subdirs("GeoTools")
+subdirs("graphic")
+subdirs("math")
+subdirs("PointCloudTools")
+subdirs("vect")
+subdirs("viewer")
@@ -0,0 +1,18 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core
+# Build directory: /root/repo/_rel_build/test/core
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("argument")
+subdirs("console")
+subdirs("concurrency")
+subdirs("flag")
+subdirs("licence")
+subdirs("messages")
+subdirs("path")
+subdirs("process")
+subdirs("utils")
+subdirs("xml")
+subdirs("validator")
+subdirs("units")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/argument_test.dir/argument_test.cpp.o"
+  "CMakeFiles/argument_test.dir/argument_test.cpp.o.d"
+  "argument_test"
+  "argument_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/argument_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/argument
+# Build directory: /root/repo/_rel_build/test/core/argument
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[argument_test]=] "/root/repo/_rel_build/test/core/argument/argument_test")
+set_tests_properties([=[argument_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/argument/CMakeLists.txt;46;add_test;/root/repo/test/core/argument/CMakeLists.txt;0;")
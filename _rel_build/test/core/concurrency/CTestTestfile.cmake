@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/concurrency
+# Build directory: /root/repo/_rel_build/test/core/concurrency
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[concurrency_test]=] "/root/repo/_rel_build/test/core/concurrency/concurrency_test")
+set_tests_properties([=[concurrency_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/concurrency/CMakeLists.txt;46;add_test;/root/repo/test/core/concurrency/CMakeLists.txt;0;")
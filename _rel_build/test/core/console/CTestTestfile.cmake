@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/console
+# Build directory: /root/repo/_rel_build/test/core/console
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[console_test]=] "/root/repo/_rel_build/test/core/console/console_test")
+set_tests_properties([=[console_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/console/CMakeLists.txt;46;add_test;/root/repo/test/core/console/CMakeLists.txt;0;")
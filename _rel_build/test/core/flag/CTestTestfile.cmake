@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/flag
+# Build directory: /root/repo/_rel_build/test/core/flag
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[flag_test]=] "/root/repo/_rel_build/test/core/flag/flag_test")
+set_tests_properties([=[flag_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/flag/CMakeLists.txt;46;add_test;/root/repo/test/core/flag/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/licence_test.dir/licence_test.cpp.o"
+  "CMakeFiles/licence_test.dir/licence_test.cpp.o.d"
+  "licence_test"
+  "licence_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/licence_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
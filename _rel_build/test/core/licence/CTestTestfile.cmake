@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/licence
+# Build directory: /root/repo/_rel_build/test/core/licence
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[licence_test]=] "/root/repo/_rel_build/test/core/licence/licence_test")
+set_tests_properties([=[licence_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/licence/CMakeLists.txt;46;add_test;/root/repo/test/core/licence/CMakeLists.txt;0;")
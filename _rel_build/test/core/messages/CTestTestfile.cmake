@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/messages
+# Build directory: /root/repo/_rel_build/test/core/messages
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[msg_test]=] "/root/repo/_rel_build/test/core/messages/msg_test")
+set_tests_properties([=[msg_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/messages/CMakeLists.txt;46;add_test;/root/repo/test/core/messages/CMakeLists.txt;0;")
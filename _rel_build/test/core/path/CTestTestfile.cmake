@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/path
+# Build directory: /root/repo/_rel_build/test/core/path
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[path_test]=] "/root/repo/_rel_build/test/core/path/path_test")
+set_tests_properties([=[path_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/path/CMakeLists.txt;46;add_test;/root/repo/test/core/path/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/process_test.dir/process_test.cpp.o"
+  "CMakeFiles/process_test.dir/process_test.cpp.o.d"
+  "process_test"
+  "process_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/process_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
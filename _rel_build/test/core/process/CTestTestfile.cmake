@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/process
+# Build directory: /root/repo/_rel_build/test/core/process
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[process_test]=] "/root/repo/_rel_build/test/core/process/process_test")
+set_tests_properties([=[process_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/process/CMakeLists.txt;51;add_test;/root/repo/test/core/process/CMakeLists.txt;0;")
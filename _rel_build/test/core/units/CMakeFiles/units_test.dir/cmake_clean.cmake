@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/units_test.dir/units_test.cpp.o"
+  "CMakeFiles/units_test.dir/units_test.cpp.o.d"
+  "units_test"
+  "units_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/units_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/units
+# Build directory: /root/repo/_rel_build/test/core/units
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[units_test]=] "/root/repo/_rel_build/test/core/units/units_test")
+set_tests_properties([=[units_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/units/CMakeLists.txt;46;add_test;/root/repo/test/core/units/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/utils_test.dir/utils_test.cpp.o"
+  "CMakeFiles/utils_test.dir/utils_test.cpp.o.d"
+  "utils_test"
+  "utils_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/utils_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/utils
+# Build directory: /root/repo/_rel_build/test/core/utils
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[utils_test]=] "/root/repo/_rel_build/test/core/utils/utils_test")
+set_tests_properties([=[utils_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/utils/CMakeLists.txt;46;add_test;/root/repo/test/core/utils/CMakeLists.txt;0;")
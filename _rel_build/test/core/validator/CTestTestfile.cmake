@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/validator
+# Build directory: /root/repo/_rel_build/test/core/validator
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[validator_test]=] "/root/repo/_rel_build/test/core/validator/validator_test")
+set_tests_properties([=[validator_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/validator/CMakeLists.txt;46;add_test;/root/repo/test/core/validator/CMakeLists.txt;0;")
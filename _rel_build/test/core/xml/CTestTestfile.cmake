@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/core/xml
+# Build directory: /root/repo/_rel_build/test/core/xml
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[xml_test]=] "/root/repo/_rel_build/test/core/xml/xml_test")
+set_tests_properties([=[xml_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/core/xml/CMakeLists.txt;47;add_test;/root/repo/test/core/xml/CMakeLists.txt;0;")
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/geometry/convex_hull_test.cpp" "test/geometry/CMakeFiles/convex_hull_test.dir/convex_hull_test.cpp.o" "gcc" "test/geometry/CMakeFiles/convex_hull_test.dir/convex_hull_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/src/tidop/core/CMakeFiles/Core.dir/DependInfo.cmake"
+  "/root/repo/_rel_build/src/tidop/geometry/CMakeFiles/Geom.dir/DependInfo.cmake"
+  "/root/repo/_rel_build/src/tidop/math/CMakeFiles/Math.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
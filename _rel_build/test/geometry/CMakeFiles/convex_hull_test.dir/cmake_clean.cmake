@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/convex_hull_test.dir/convex_hull_test.cpp.o"
+  "CMakeFiles/convex_hull_test.dir/convex_hull_test.cpp.o.d"
+  "convex_hull_test"
+  "convex_hull_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/convex_hull_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dbscan.dir/dbscan.cpp.o"
+  "CMakeFiles/dbscan.dir/dbscan.cpp.o.d"
+  "dbscan"
+  "dbscan.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dbscan.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
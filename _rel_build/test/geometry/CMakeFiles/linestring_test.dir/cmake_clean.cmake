@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/linestring_test.dir/linestring_test.cpp.o"
+  "CMakeFiles/linestring_test.dir/linestring_test.cpp.o.d"
+  "linestring_test"
+  "linestring_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/linestring_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/point_test.dir/point_test.cpp.o"
+  "CMakeFiles/point_test.dir/point_test.cpp.o.d"
+  "point_test"
+  "point_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/point_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
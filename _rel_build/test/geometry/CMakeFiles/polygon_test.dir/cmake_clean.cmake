@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/polygon_test.dir/polygon_test.cpp.o"
+  "CMakeFiles/polygon_test.dir/polygon_test.cpp.o.d"
+  "polygon_test"
+  "polygon_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/polygon_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
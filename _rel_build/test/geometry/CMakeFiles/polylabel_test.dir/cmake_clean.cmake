@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/polylabel_test.dir/polylabel_test.cpp.o"
+  "CMakeFiles/polylabel_test.dir/polylabel_test.cpp.o.d"
+  "polylabel_test"
+  "polylabel_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/polylabel_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/prepared_polygon_test.dir/prepared_polygon_test.cpp.o"
+  "CMakeFiles/prepared_polygon_test.dir/prepared_polygon_test.cpp.o.d"
+  "prepared_polygon_test"
+  "prepared_polygon_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/prepared_polygon_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rect_test.dir/rect_test.cpp.o"
+  "CMakeFiles/rect_test.dir/rect_test.cpp.o.d"
+  "rect_test"
+  "rect_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rect_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
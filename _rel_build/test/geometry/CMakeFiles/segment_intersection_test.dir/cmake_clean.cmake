@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/segment_intersection_test.dir/segment_intersection_test.cpp.o"
+  "CMakeFiles/segment_intersection_test.dir/segment_intersection_test.cpp.o.d"
+  "segment_intersection_test"
+  "segment_intersection_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/segment_intersection_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/shapes_test.dir/shapes_test.cpp.o"
+  "CMakeFiles/shapes_test.dir/shapes_test.cpp.o.d"
+  "shapes_test"
+  "shapes_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/shapes_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
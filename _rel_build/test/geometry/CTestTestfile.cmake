@@ -0,0 +1,40 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/geometry
+# Build directory: /root/repo/_rel_build/test/geometry
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[box_test]=] "/root/repo/_rel_build/test/geometry/box_test")
+set_tests_properties([=[box_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[convex_hull_test]=] "/root/repo/_rel_build/test/geometry/convex_hull_test")
+set_tests_properties([=[convex_hull_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[dbscan]=] "/root/repo/_rel_build/test/geometry/dbscan")
+set_tests_properties([=[dbscan]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[kdtree_test]=] "/root/repo/_rel_build/test/geometry/kdtree_test")
+set_tests_properties([=[kdtree_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[linestring_test]=] "/root/repo/_rel_build/test/geometry/linestring_test")
+set_tests_properties([=[linestring_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[operation_test]=] "/root/repo/_rel_build/test/geometry/operation_test")
+set_tests_properties([=[operation_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[point_test]=] "/root/repo/_rel_build/test/geometry/point_test")
+set_tests_properties([=[point_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[polygon_test]=] "/root/repo/_rel_build/test/geometry/polygon_test")
+set_tests_properties([=[polygon_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[polylabel_test]=] "/root/repo/_rel_build/test/geometry/polylabel_test")
+set_tests_properties([=[polylabel_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[prepared_polygon_test]=] "/root/repo/_rel_build/test/geometry/prepared_polygon_test")
+set_tests_properties([=[prepared_polygon_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[rect_test]=] "/root/repo/_rel_build/test/geometry/rect_test")
+set_tests_properties([=[rect_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[rtree_test]=] "/root/repo/_rel_build/test/geometry/rtree_test")
+set_tests_properties([=[rtree_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[segment_intersection_test]=] "/root/repo/_rel_build/test/geometry/segment_intersection_test")
+set_tests_properties([=[segment_intersection_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[segment_test]=] "/root/repo/_rel_build/test/geometry/segment_test")
+set_tests_properties([=[segment_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[shapes_test]=] "/root/repo/_rel_build/test/geometry/shapes_test")
+set_tests_properties([=[shapes_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[size_test]=] "/root/repo/_rel_build/test/geometry/size_test")
+set_tests_properties([=[size_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
+add_test([=[window_test]=] "/root/repo/_rel_build/test/geometry/window_test")
+set_tests_properties([=[window_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/geometry/CMakeLists.txt;63;add_test;/root/repo/test/geometry/CMakeLists.txt;72;DEFINE_TEST;/root/repo/test/geometry/CMakeLists.txt;0;")
@@ -0,0 +1,35 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math
+# Build directory: /root/repo/_rel_build/test/math
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("utils")
+subdirs("matrix")
+subdirs("quaternion")
+subdirs("vector")
+subdirs("angle_conversion")
+subdirs("rotation_converter")
+subdirs("statistics")
+subdirs("statistic")
+subdirs("qr")
+subdirs("lu")
+subdirs("cholesky")
+subdirs("svd")
+subdirs("simd")
+subdirs("umeyama")
+subdirs("transform")
+subdirs("affine")
+subdirs("translation")
+subdirs("scaling")
+subdirs("rotation")
+subdirs("data")
+subdirs("transform_batch")
+subdirs("rotation_batch")
+subdirs("ransac")
+subdirs("fitting")
+subdirs("mixed_precision")
+subdirs("sparse_matrix")
+subdirs("sparse_solvers")
+subdirs("levenberg_marquardt")
+subdirs("eigen")
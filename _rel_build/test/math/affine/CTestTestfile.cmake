@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/affine
+# Build directory: /root/repo/_rel_build/test/math/affine
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[affine_test]=] "/root/repo/_rel_build/test/math/affine/affine_test")
+set_tests_properties([=[affine_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/affine/CMakeLists.txt;55;add_test;/root/repo/test/math/affine/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/angle_conversion_test.dir/angle_conversion_test.cpp.o"
+  "CMakeFiles/angle_conversion_test.dir/angle_conversion_test.cpp.o.d"
+  "angle_conversion_test"
+  "angle_conversion_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/angle_conversion_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/angle_conversion
+# Build directory: /root/repo/_rel_build/test/math/angle_conversion
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[angle_conversion_test]=] "/root/repo/_rel_build/test/math/angle_conversion/angle_conversion_test")
+set_tests_properties([=[angle_conversion_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/angle_conversion/CMakeLists.txt;50;add_test;/root/repo/test/math/angle_conversion/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/cholesky
+# Build directory: /root/repo/_rel_build/test/math/cholesky
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[cholesky_test]=] "/root/repo/_rel_build/test/math/cholesky/cholesky_test")
+set_tests_properties([=[cholesky_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/cholesky/CMakeLists.txt;55;add_test;/root/repo/test/math/cholesky/CMakeLists.txt;0;")
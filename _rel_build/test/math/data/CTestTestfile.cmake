@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/data
+# Build directory: /root/repo/_rel_build/test/math/data
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[data_test]=] "/root/repo/_rel_build/test/math/data/data_test")
+set_tests_properties([=[data_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/data/CMakeLists.txt;55;add_test;/root/repo/test/math/data/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/eigen
+# Build directory: /root/repo/_rel_build/test/math/eigen
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[eigen_test]=] "/root/repo/_rel_build/test/math/eigen/eigen_test")
+set_tests_properties([=[eigen_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/eigen/CMakeLists.txt;55;add_test;/root/repo/test/math/eigen/CMakeLists.txt;0;")
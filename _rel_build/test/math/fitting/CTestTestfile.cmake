@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/fitting
+# Build directory: /root/repo/_rel_build/test/math/fitting
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[fitting_test]=] "/root/repo/_rel_build/test/math/fitting/fitting_test")
+set_tests_properties([=[fitting_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/fitting/CMakeLists.txt;55;add_test;/root/repo/test/math/fitting/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/levenberg_marquardt_test.dir/levenberg_marquardt_test.cpp.o"
+  "CMakeFiles/levenberg_marquardt_test.dir/levenberg_marquardt_test.cpp.o.d"
+  "levenberg_marquardt_test"
+  "levenberg_marquardt_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/levenberg_marquardt_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
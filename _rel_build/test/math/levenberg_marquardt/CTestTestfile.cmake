@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/levenberg_marquardt
+# Build directory: /root/repo/_rel_build/test/math/levenberg_marquardt
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[levenberg_marquardt_test]=] "/root/repo/_rel_build/test/math/levenberg_marquardt/levenberg_marquardt_test")
+set_tests_properties([=[levenberg_marquardt_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/levenberg_marquardt/CMakeLists.txt;55;add_test;/root/repo/test/math/levenberg_marquardt/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/lu
+# Build directory: /root/repo/_rel_build/test/math/lu
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[lu_test]=] "/root/repo/_rel_build/test/math/lu/lu_test")
+set_tests_properties([=[lu_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/lu/CMakeLists.txt;55;add_test;/root/repo/test/math/lu/CMakeLists.txt;0;")
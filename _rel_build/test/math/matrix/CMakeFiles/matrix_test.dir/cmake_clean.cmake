@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/matrix_test.dir/matrix_test.cpp.o"
+  "CMakeFiles/matrix_test.dir/matrix_test.cpp.o.d"
+  "matrix_test"
+  "matrix_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/matrix_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
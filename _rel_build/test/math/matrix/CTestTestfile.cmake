@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/matrix
+# Build directory: /root/repo/_rel_build/test/math/matrix
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[matrix_test]=] "/root/repo/_rel_build/test/math/matrix/matrix_test")
+set_tests_properties([=[matrix_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/matrix/CMakeLists.txt;59;add_test;/root/repo/test/math/matrix/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mixed_precision_test.dir/mixed_precision_test.cpp.o"
+  "CMakeFiles/mixed_precision_test.dir/mixed_precision_test.cpp.o.d"
+  "mixed_precision_test"
+  "mixed_precision_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mixed_precision_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/mixed_precision
+# Build directory: /root/repo/_rel_build/test/math/mixed_precision
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[mixed_precision_test]=] "/root/repo/_rel_build/test/math/mixed_precision/mixed_precision_test")
+set_tests_properties([=[mixed_precision_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/mixed_precision/CMakeLists.txt;55;add_test;/root/repo/test/math/mixed_precision/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/qr
+# Build directory: /root/repo/_rel_build/test/math/qr
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[qr_test]=] "/root/repo/_rel_build/test/math/qr/qr_test")
+set_tests_properties([=[qr_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/qr/CMakeLists.txt;57;add_test;/root/repo/test/math/qr/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/quaternion_test.dir/quaternion_test.cpp.o"
+  "CMakeFiles/quaternion_test.dir/quaternion_test.cpp.o.d"
+  "quaternion_test"
+  "quaternion_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quaternion_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/quaternion
+# Build directory: /root/repo/_rel_build/test/math/quaternion
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[quaternion_test]=] "/root/repo/_rel_build/test/math/quaternion/quaternion_test")
+set_tests_properties([=[quaternion_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/quaternion/CMakeLists.txt;55;add_test;/root/repo/test/math/quaternion/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ransac_test.dir/ransac_test.cpp.o"
+  "CMakeFiles/ransac_test.dir/ransac_test.cpp.o.d"
+  "ransac_test"
+  "ransac_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ransac_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/ransac
+# Build directory: /root/repo/_rel_build/test/math/ransac
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[ransac_test]=] "/root/repo/_rel_build/test/math/ransac/ransac_test")
+set_tests_properties([=[ransac_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/ransac/CMakeLists.txt;55;add_test;/root/repo/test/math/ransac/CMakeLists.txt;0;")
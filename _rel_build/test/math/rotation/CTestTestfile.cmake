@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/rotation
+# Build directory: /root/repo/_rel_build/test/math/rotation
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[rotation_test]=] "/root/repo/_rel_build/test/math/rotation/rotation_test")
+set_tests_properties([=[rotation_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/rotation/CMakeLists.txt;55;add_test;/root/repo/test/math/rotation/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/rotation_batch
+# Build directory: /root/repo/_rel_build/test/math/rotation_batch
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[rotation_batch_test]=] "/root/repo/_rel_build/test/math/rotation_batch/rotation_batch_test")
+set_tests_properties([=[rotation_batch_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/rotation_batch/CMakeLists.txt;55;add_test;/root/repo/test/math/rotation_batch/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rotation_converter_test.dir/rotation_converter_test.cpp.o"
+  "CMakeFiles/rotation_converter_test.dir/rotation_converter_test.cpp.o.d"
+  "rotation_converter_test"
+  "rotation_converter_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rotation_converter_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
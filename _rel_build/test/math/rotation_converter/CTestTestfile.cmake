@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/rotation_converter
+# Build directory: /root/repo/_rel_build/test/math/rotation_converter
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[rotation_converter_test]=] "/root/repo/_rel_build/test/math/rotation_converter/rotation_converter_test")
+set_tests_properties([=[rotation_converter_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/rotation_converter/CMakeLists.txt;55;add_test;/root/repo/test/math/rotation_converter/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/scaling
+# Build directory: /root/repo/_rel_build/test/math/scaling
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[scaling_test]=] "/root/repo/_rel_build/test/math/scaling/scaling_test")
+set_tests_properties([=[scaling_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/scaling/CMakeLists.txt;55;add_test;/root/repo/test/math/scaling/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/simd
+# Build directory: /root/repo/_rel_build/test/math/simd
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[simd_test]=] "/root/repo/_rel_build/test/math/simd/simd_test")
+set_tests_properties([=[simd_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/simd/CMakeLists.txt;55;add_test;/root/repo/test/math/simd/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/sparse_matrix
+# Build directory: /root/repo/_rel_build/test/math/sparse_matrix
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[sparse_matrix_test]=] "/root/repo/_rel_build/test/math/sparse_matrix/sparse_matrix_test")
+set_tests_properties([=[sparse_matrix_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/sparse_matrix/CMakeLists.txt;55;add_test;/root/repo/test/math/sparse_matrix/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sparse_solvers_test.dir/sparse_solvers_test.cpp.o"
+  "CMakeFiles/sparse_solvers_test.dir/sparse_solvers_test.cpp.o.d"
+  "sparse_solvers_test"
+  "sparse_solvers_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sparse_solvers_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/sparse_solvers
+# Build directory: /root/repo/_rel_build/test/math/sparse_solvers
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[sparse_solvers_test]=] "/root/repo/_rel_build/test/math/sparse_solvers/sparse_solvers_test")
+set_tests_properties([=[sparse_solvers_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/sparse_solvers/CMakeLists.txt;55;add_test;/root/repo/test/math/sparse_solvers/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/statistic_test.dir/statistic_test.cpp.o"
+  "CMakeFiles/statistic_test.dir/statistic_test.cpp.o.d"
+  "statistic_test"
+  "statistic_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/statistic_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
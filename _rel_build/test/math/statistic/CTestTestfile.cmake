@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/statistic
+# Build directory: /root/repo/_rel_build/test/math/statistic
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[statistic_test]=] "/root/repo/_rel_build/test/math/statistic/statistic_test")
+set_tests_properties([=[statistic_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/statistic/CMakeLists.txt;52;add_test;/root/repo/test/math/statistic/CMakeLists.txt;0;")
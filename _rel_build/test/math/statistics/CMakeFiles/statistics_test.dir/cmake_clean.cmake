@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/statistics_test.dir/statistics_test.cpp.o"
+  "CMakeFiles/statistics_test.dir/statistics_test.cpp.o.d"
+  "statistics_test"
+  "statistics_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/statistics_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/statistics
+# Build directory: /root/repo/_rel_build/test/math/statistics
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[statistics_test]=] "/root/repo/_rel_build/test/math/statistics/statistics_test")
+set_tests_properties([=[statistics_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/statistics/CMakeLists.txt;48;add_test;/root/repo/test/math/statistics/CMakeLists.txt;0;")
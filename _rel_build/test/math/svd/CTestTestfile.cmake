@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/svd
+# Build directory: /root/repo/_rel_build/test/math/svd
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[svd_test]=] "/root/repo/_rel_build/test/math/svd/svd_test")
+set_tests_properties([=[svd_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/svd/CMakeLists.txt;53;add_test;/root/repo/test/math/svd/CMakeLists.txt;0;")
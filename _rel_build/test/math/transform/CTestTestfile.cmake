@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/transform
+# Build directory: /root/repo/_rel_build/test/math/transform
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[transform_test]=] "/root/repo/_rel_build/test/math/transform/transform_test")
+set_tests_properties([=[transform_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/transform/CMakeLists.txt;57;add_test;/root/repo/test/math/transform/CMakeLists.txt;0;")
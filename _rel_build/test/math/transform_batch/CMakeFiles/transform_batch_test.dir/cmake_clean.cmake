@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/transform_batch_test.dir/transform_batch_test.cpp.o"
+  "CMakeFiles/transform_batch_test.dir/transform_batch_test.cpp.o.d"
+  "transform_batch_test"
+  "transform_batch_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/transform_batch_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
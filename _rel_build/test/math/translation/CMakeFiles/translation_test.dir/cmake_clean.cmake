@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/translation_test.dir/translation_test.cpp.o"
+  "CMakeFiles/translation_test.dir/translation_test.cpp.o.d"
+  "translation_test"
+  "translation_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/translation_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
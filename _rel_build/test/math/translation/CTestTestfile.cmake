@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/translation
+# Build directory: /root/repo/_rel_build/test/math/translation
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[translation_test]=] "/root/repo/_rel_build/test/math/translation/translation_test")
+set_tests_properties([=[translation_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/translation/CMakeLists.txt;55;add_test;/root/repo/test/math/translation/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umeyama_test.dir/umeyama_test.cpp.o"
+  "CMakeFiles/umeyama_test.dir/umeyama_test.cpp.o.d"
+  "umeyama_test"
+  "umeyama_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umeyama_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
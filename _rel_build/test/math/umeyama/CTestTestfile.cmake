@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/umeyama
+# Build directory: /root/repo/_rel_build/test/math/umeyama
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[umeyama_test]=] "/root/repo/_rel_build/test/math/umeyama/umeyama_test")
+set_tests_properties([=[umeyama_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/umeyama/CMakeLists.txt;57;add_test;/root/repo/test/math/umeyama/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mathutils_test.dir/mathutils_test.cpp.o"
+  "CMakeFiles/mathutils_test.dir/mathutils_test.cpp.o.d"
+  "mathutils_test"
+  "mathutils_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mathutils_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
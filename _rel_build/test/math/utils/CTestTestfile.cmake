@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/utils
+# Build directory: /root/repo/_rel_build/test/math/utils
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[mathutils_test]=] "/root/repo/_rel_build/test/math/utils/mathutils_test")
+set_tests_properties([=[mathutils_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/utils/CMakeLists.txt;54;add_test;/root/repo/test/math/utils/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/math/vector
+# Build directory: /root/repo/_rel_build/test/math/vector
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[vector_test]=] "/root/repo/_rel_build/test/math/vector/vector_test")
+set_tests_properties([=[vector_test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/math/vector/CMakeLists.txt;45;add_test;/root/repo/test/math/vector/CMakeLists.txt;0;")
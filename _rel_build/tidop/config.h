@@ -0,0 +1,123 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+#ifndef TL_CONFIG_H
+#define TL_CONFIG_H
+
+/* Cabecera para configuración */
+
+#define TL_VERSION_MAJOR 3
+#define TL_VERSION_MINOR 2
+#define TL_VERSION_PATCH 3
+#define TL_VERSION "3.2.3"
+
+
+/* #undef TL_ENABLE_DEPRECATED_METHODS */
+/* #undef TL_WARNING_DEPRECATED_METHOD */
+/* #undef TL_WARNING_TODO */
+
+/* TidopLib Modules */
+
+#define TL_HAVE_CORE
+#define TL_HAVE_MATH
+#define TL_HAVE_GEOMETRY
+/* #undef TL_HAVE_IMG */
+/* #undef TL_HAVE_IMG_PROCESS */
+/* #undef TL_HAVE_FEAT_MATCH */
+/* #undef TL_HAVE_GRAPHIC */
+/* #undef TL_HAVE_GEOSPATIAL */
+/* #undef TL_HAVE_VECT */
+/* #undef TL_HAVE_GEOTOOLS */
+/* #undef TL_HAVE_PCTOOLS */
+
+/* TidopLib dependencies */
+
+// Boost
+#define TL_HAVE_BOOST
+
+// OpenCV
+/* #undef TL_HAVE_OPENCV */
+
+// GDAL
+/* #undef TL_HAVE_GDAL */
+
+/* #undef TL_HAVE_PROJ */
+/* #undef TL_HAVE_PROJ4 */
+
+// libraw: Lectura de formato raw
+/* #undef TL_HAVE_LIBRAW */
+/* #undef TL_HAVE_EDSDK */
+
+// Eigen Lib
+/* #undef TL_HAVE_EIGEN */
+
+// OpenMP
+/* #undef TL_HAVE_OPENMP */
+
+// Parallel Patterns Library
+// https://msdn.microsoft.com/es-es/library/dd492418.aspx
+/* #undef TL_HAVE_PPL */
+
+// Visual Leak Detector
+/* #undef TL_HAVE_VLD */
+
+// minizip
+/* #undef TL_HAVE_MINIZIP */
+
+/* #undef TL_HAVE_OPENBLAS */
+/* #undef TL_HAVE_CUDA */
+
+
+// SIMD INTRINSICS
+#define TL_HAVE_SSE 
+#define TL_HAVE_SSE2
+/* #undef TL_HAVE_SSE3 */
+/* #undef TL_HAVE_SSE4_1 */
+/* #undef TL_HAVE_SSE4_2 */
+/* #undef TL_HAVE_AVX */
+/* #undef TL_HAVE_AVX2 */
+/* #undef TL_HAVE_AVX512 */
+#define TL_HAVE_SIMD_INTRINSICS
+
+#define TL_DATA_PATH "/root/repo\\test\\data"
+
+/// https://philippegroarke.com/blog/2017/11/20/simplifying-compile-time-options-with-if-constexpr/
+
+#define CPP_VERSION 14
+
+namespace tl
+{
+
+enum class CppVersion {
+  //cpp_11 = 11, 
+  cpp_14 = 14, 
+  cpp_17 = 17, 
+  cpp_20 = 20
+};
+
+constexpr static CppVersion cpp_version = static_cast<CppVersion>(14);
+
+}
+
+#endif // TL_CONFIG_H
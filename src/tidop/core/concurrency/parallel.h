@@ -33,6 +33,7 @@
 #include <condition_variable>
 #include <future>
 #include <algorithm>
+#include <vector>
 
 #include "tidop/core/defs.h"
 #include "tidop/core/concurrency.h"
@@ -144,6 +145,62 @@ Function parallel_for_each(Iter first,
     return f;
 }
 
+/*!
+ * \brief Sorts a range in parallel
+ *
+ * Each thread sorts a chunk of the range and the sorted chunks are merged
+ * in pairs, also in parallel. Small ranges or single thread machines use
+ * std::sort.
+ *
+ * \param[in] first First element
+ * \param[in] last Last element
+ * \param[in] comp Comparison function
+ */
+template<typename RandomIt, typename Compare>
+void parallel_sort(RandomIt first,
+                   RandomIt last,
+                   Compare comp)
+{
+    constexpr size_t min_per_thread = 1 << 16;
+
+    size_t size = static_cast<size_t>(std::distance(first, last));
+    size_t num_threads = std::min<size_t>(optimalNumberOfThreads(), size / min_per_thread);
+
+    if (num_threads <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<size_t> bounds(num_threads + 1);
+    for (size_t i = 0; i <= num_threads; i++)
+        bounds[i] = i * size / num_threads;
+
+    parallel_for(0, num_threads, [&](size_t i) {
+        std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    });
+
+    for (size_t width = 1; width < num_threads; width *= 2) {
+
+        size_t merges = (num_threads + 2 * width - 1) / (2 * width);
+
+        parallel_for(0, merges, [&](size_t i) {
+            size_t ini = 2 * i * width;
+            size_t middle = std::min(ini + width, num_threads);
+            size_t end = std::min(ini + 2 * width, num_threads);
+            if (middle < end) {
+                std::inplace_merge(first + bounds[ini], first + bounds[middle], first + bounds[end], comp);
+            }
+        });
+    }
+}
+
+template<typename RandomIt>
+void parallel_sort(RandomIt first,
+                   RandomIt last)
+{
+    parallel_sort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
 /// \cond
 
 ///Pruebas basadas en C++ Concurrency in Action
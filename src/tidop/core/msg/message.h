@@ -125,7 +125,7 @@ public:
     template<typename... Args>
     static std::string format(FORMAT_NAMESPACE format_string<Args...> s, Args&&... args)
     {
-        return FORMAT_NAMESPACE vformat(s.get(), FORMAT_NAMESPACE make_format_args(args...));
+        return FORMAT_NAMESPACE vformat(static_cast<FORMAT_NAMESPACE string_view>(s), FORMAT_NAMESPACE make_format_args(args...));
     }
 
     /*!
@@ -30,6 +30,7 @@
 
 #include <opencv2/features2d.hpp>
 
+#include "tidop/core/concurrency/parallel.h"
 #include "tidop/geometry/entities/point.h"
 
 namespace tl
@@ -45,6 +46,8 @@ class Curve
 protected:
 
     std::vector<std::pair<T, int>> mData;
+    /* Number of positives in the first i scores (sorted in decreasing order) */
+    std::vector<size_t> mCumulativePositives;
     std::vector<Point<double>> mCurve;
     size_t mPositives;
     size_t mNegatives;
@@ -186,6 +189,34 @@ public:
     static auto negativePredictiveValue(size_t fn, size_t tn) -> double;
     static auto accuracy(size_t tp, size_t tn, size_t positives, size_t negatives) -> double;
 
+protected:
+
+    /*!
+     * \brief Confusion matrix when the first index scores are negatives
+     */
+    void counts(size_t index, size_t &tp, size_t &fp, size_t &tn, size_t &fn) const;
+
+    /*!
+     * \brief Number of scores greater than the threshold
+     */
+    auto negativesIndex(T threshold) const -> size_t;
+
+    /*!
+     * \brief Builds the curve with one point per distinct score in a single sweep
+     * \param[in] point Function that maps tp, fp, tn, fn to a point of the curve
+     * \param[in] computeAuc Area under the curve with the trapezoidal rule
+     */
+    template<typename Function>
+    void sweep(Function point, bool computeAuc);
+
+    /*!
+     * \brief Builds the curve for equally spaced thresholds
+     */
+    template<typename Function>
+    void sweep(size_t steeps, Function point, bool computeAuc);
+
+    void computeAuc();
+
 };
 
 
@@ -263,10 +294,13 @@ Curve<T>::Curve(const std::vector<std::pair<T, int>> &data)
     mNegatives(0),
     mAuc(0.0)
 {
-    std::sort(mData.begin(), mData.end(),
-              [](const std::pair<T, int> &data1,
-              const std::pair<T, int> &data2) {
-                  return data1.first > data2.first; }); // Ordenado al reves al utilizar la distancia de los matches
+    parallel_sort(mData.begin(), mData.end(),
+                  [](const std::pair<T, int> &data1,
+                  const std::pair<T, int> &data2) {
+                      return data1.first > data2.first; }); // Ordenado al reves al utilizar la distancia de los matches
+
+    mCumulativePositives.resize(mData.size() + 1);
+    mCumulativePositives[0] = 0;
 
     for (size_t i = 0; i < mData.size(); i++) {
         if (mData[i].second == 1) {
@@ -274,6 +308,7 @@ Curve<T>::Curve(const std::vector<std::pair<T, int>> &data)
         } else {
             mNegatives++;
         }
+        mCumulativePositives[i + 1] = mPositives;
     }
 
 }
@@ -281,26 +316,12 @@ Curve<T>::Curve(const std::vector<std::pair<T, int>> &data)
 template<typename T> 
 auto Curve<T>::confusionMatrix(T threshold) const -> std::map<Curve<T>::Classification, size_t>
 {
-    size_t true_positives = 0;
-    size_t false_positives = 0;
-    size_t true_negatives = 0;
-    size_t false_negatives = 0;
+    size_t true_positives;
+    size_t false_positives;
+    size_t true_negatives;
+    size_t false_negatives;
 
-    for (size_t j = 0; j < mData.size(); j++) {
-
-        if (mData[j].first > threshold) {
-            if (mData[j].second == 1)
-                false_negatives++;
-            else
-                true_negatives++;
-        } else {
-            if (mData[j].second == 0)
-                false_positives++;
-            else
-                true_positives++;
-        }
-
-    }
+    counts(negativesIndex(threshold), true_positives, false_positives, true_negatives, false_negatives);
 
     std::map<Classification, size_t> confussion_matrix;
     confussion_matrix[Classification::true_positives] = true_positives;
@@ -476,96 +497,128 @@ auto Curve<T>::accuracy(size_t tp, size_t tn, size_t positives, size_t negatives
 
 
 
-/*------------------------------------------------------------------------------------*/
+template<typename T>
+void Curve<T>::counts(size_t index, size_t &tp, size_t &fp, size_t &tn, size_t &fn) const
+{
+    fn = mCumulativePositives[index];
+    tn = index - fn;
+    tp = mPositives - fn;
+    fp = mNegatives - tn;
+}
 
+template<typename T>
+auto Curve<T>::negativesIndex(T threshold) const -> size_t
+{
+    auto it = std::partition_point(mData.begin(), mData.end(),
+                                   [threshold](const std::pair<T, int> &data) {
+                                       return data.first > threshold;
+                                   });
 
-/* PR Curve class implementation */
+    return static_cast<size_t>(std::distance(mData.begin(), it));
+}
 
 template<typename T>
-PRCurve<T>::PRCurve(const std::vector<std::pair<T, int>> &data)
-  : Curve<T>(data)
+template<typename Function>
+void Curve<T>::sweep(Function point, bool computeAuc)
 {
+    mCurve.resize(0);
+    mAuc = 0.0;
+
+    if (mData.empty()) return;
+
+    size_t tp, fp, tn, fn;
+    size_t i = 0;
+
+    while (i < mData.size()) {
+        T threshold = mData[i].first;
+        counts(i, tp, fp, tn, fn);
+        mCurve.push_back(point(tp, fp, tn, fn));
+        while (i < mData.size() && !(mData[i].first < threshold)) i++;
+    }
+
+    /// Every score classified as negative
+    counts(mData.size(), tp, fp, tn, fn);
+    mCurve.push_back(point(tp, fp, tn, fn));
+
+    if (computeAuc) this->computeAuc();
 }
 
 template<typename T>
-void PRCurve<T>::compute(size_t steeps)
+template<typename Function>
+void Curve<T>::sweep(size_t steeps, Function point, bool computeAuc)
 {
     TL_TODO("para enteros habria que especializar la plantilla")
 
-    if (this->mData.empty()) return;
+    mCurve.resize(0);
+    mAuc = 0.0;
 
-    this->mCurve.resize(0);
+    if (mData.empty()) return;
 
-
-    T min = this->mData.front().first;
-    T max = this->mData.back().first;
+    T min = mData.front().first;
+    T max = mData.back().first;
 
     T step = (max - min) / static_cast<double>(steeps);
 
     T threshold = min;
 
-    for (size_t i = 0; i < steeps; i++) {
-
-        auto confussion_matrix = this->confusionMatrix(threshold);
+    size_t tp, fp, tn, fn;
 
-        double recall = this->truePositiveRate(confussion_matrix[PRCurve<T>::Classification::true_positives],
-                                               confussion_matrix[PRCurve<T>::Classification::false_negatives]);
-        double precision = this->positivePredictiveValue(confussion_matrix[PRCurve<T>::Classification::true_positives],
-                                                         confussion_matrix[PRCurve<T>::Classification::false_positives]);
-        this->mCurve.emplace_back(recall, precision);
+    for (size_t i = 0; i < steeps; i++) {
+        counts(negativesIndex(threshold), tp, fp, tn, fn);
+        mCurve.push_back(point(tp, fp, tn, fn));
         threshold += step;
     }
 
-    /// AUC
-    size_t size = this->mCurve.size();
-    this->mAuc = 0.0;
+    if (computeAuc) this->computeAuc();
+}
+
+template<typename T>
+void Curve<T>::computeAuc()
+{
+    size_t size = mCurve.size();
+    mAuc = 0.0;
 
     if (size > 2) {
-        Point<double> point1 = this->mCurve[0];
+        Point<double> point1 = mCurve[0];
         Point<double> point2;
 
         for (size_t i = 1; i < size; i++) {
-            point2 = this->mCurve[i];
-            this->mAuc += std::abs(point1.x - point2.x) * (point1.y + point2.y) / 2.;
+            point2 = mCurve[i];
+            mAuc += std::abs(point1.x - point2.x) * (point1.y + point2.y) / 2.;
             point1 = point2;
         }
     }
-
 }
 
-template<typename T>
-void PRCurve<T>::compute()
-{
-    if (this->mData.empty()) return;
 
-    this->mCurve.resize(0);
 
-    for (auto &data : this->mData) {
-
-        auto confussionMatrix = this->confusionMatrix(data.first);
+/*------------------------------------------------------------------------------------*/
 
-        double recall = this->truePositiveRate(confussionMatrix[PRCurve<T>::Classification::true_positives],
-                                               confussionMatrix[PRCurve<T>::Classification::false_negatives]);
-        double precision = this->positivePredictiveValue(confussionMatrix[PRCurve<T>::Classification::true_positives],
-                                                         confussionMatrix[PRCurve<T>::Classification::false_positives]);
-        this->mCurve.emplace_back(recall, precision);
-    }
 
-    /// AUC
-    size_t size = this->mCurve.size();
-    this->mAuc = 0.0;
+/* PR Curve class implementation */
 
-    if (size > 2) {
-        Point<double> point1 = this->mCurve[0];
-        Point<double> point2;
+template<typename T>
+PRCurve<T>::PRCurve(const std::vector<std::pair<T, int>> &data)
+  : Curve<T>(data)
+{
+}
 
-        for (size_t i = 1; i < size; i++) {
-            point2 = this->mCurve[i];
-            this->mAuc += std::abs(point1.x - point2.x) * (point1.y + point2.y) / 2.;
-            point1 = point2;
-        }
-    }
+template<typename T>
+void PRCurve<T>::compute(size_t steeps)
+{
+    this->sweep(steeps, [](size_t tp, size_t fp, size_t, size_t fn) {
+        return Point<double>(Curve<T>::truePositiveRate(tp, fn),
+                             Curve<T>::positivePredictiveValue(tp, fp));
+    }, true);
+}
 
+template<typename T>
+void PRCurve<T>::compute()
+{
+    this->sweep([](size_t tp, size_t fp, size_t, size_t fn) {
+        return Point<double>(Curve<T>::truePositiveRate(tp, fn),
+                             Curve<T>::positivePredictiveValue(tp, fp));
+    }, true);
 }
 
 /*------------------------------------------------------------------------------------*/
@@ -583,76 +636,19 @@ ROCCurve<T>::ROCCurve(const std::vector<std::pair<T, int>> &data)
 template<typename T>
 void ROCCurve<T>::compute(size_t steeps)
 {
-    TL_TODO("para enteros habria que especializar la plantilla")
-    if (this->mData.empty()) return;
-
-    this->mCurve.resize(0);
-    T min = this->mData.front().first;
-    T max = this->mData.back().first;
-
-    T step = (max - min) / static_cast<double>(steeps);
-
-    T threshold = min;
-    for (size_t i = 0; i < steeps; i++) {
-
-        auto confussion_matrix = this->confusionMatrix(threshold);
-        double fpr = this->falsePositiveRate(confussion_matrix[ROCCurve<T>::Classification::false_positives],
-                                             confussion_matrix[ROCCurve<T>::Classification::true_negatives]);
-        double tpr = this->truePositiveRate(confussion_matrix[ROCCurve<T>::Classification::true_positives],
-                                            confussion_matrix[ROCCurve<T>::Classification::false_negatives]);
-        this->mCurve.emplace_back(fpr, tpr);
-        threshold += step;
-    }
-
-    /// AUC
-    size_t size = this->mCurve.size();
-    this->mAuc = 0.0;
-
-    if (size > 2) {
-        Point<double> point1 = this->mCurve[0];
-        Point<double> point2;
-
-        for (size_t i = 1; i < size; i++) {
-            point2 = this->mCurve[i];
-            this->mAuc += std::abs(point1.x - point2.x) * (point1.y + point2.y) / 2.;
-            point1 = point2;
-        }
-
-    }
+    this->sweep(steeps, [](size_t tp, size_t fp, size_t tn, size_t fn) {
+        return Point<double>(Curve<T>::falsePositiveRate(fp, tn),
+                             Curve<T>::truePositiveRate(tp, fn));
+    }, true);
 }
 
 template<typename T>
 void ROCCurve<T>::compute()
 {
-    if (this->mData.empty()) return;
-
-    this->mCurve.resize(0);
-
-    for (auto &data : this->mData) {
-
-        auto confussion_matrix = this->confusionMatrix(data.first);
-        double fpr = this->falsePositiveRate(confussion_matrix[ROCCurve<T>::Classification::false_positives],
-                                             confussion_matrix[ROCCurve<T>::Classification::true_negatives]);
-        double tpr = this->truePositiveRate(confussion_matrix[ROCCurve<T>::Classification::true_positives],
-                                            confussion_matrix[ROCCurve<T>::Classification::false_negatives]);
-        this->mCurve.emplace_back(fpr, tpr);
-    }
-
-    /// AUC
-    size_t size = this->mCurve.size();
-    this->mAuc = 0.0;
-
-    if (size > 2) {
-        Point<double> point1 = this->mCurve[0];
-        Point<double> point2;
-
-        for (size_t i = 1; i < size; i++) {
-            point2 = this->mCurve[i];
-            this->mAuc += std::abs(point1.x - point2.x) * (point1.y + point2.y) / 2.;
-            point1 = point2;
-        }
-
-    }
+    this->sweep([](size_t tp, size_t fp, size_t tn, size_t fn) {
+        return Point<double>(Curve<T>::falsePositiveRate(fp, tn),
+                             Curve<T>::truePositiveRate(tp, fn));
+    }, true);
 }
 
 /*------------------------------------------------------------------------------------*/
@@ -669,75 +665,19 @@ DETCurve<T>::DETCurve(const std::vector<std::pair<T, int>> &data)
 template<typename T>
 void DETCurve<T>::compute(size_t steeps)
 {
-    TL_TODO("para enteros habría que especializar la plantilla")
-
-    if (this->mData.empty()) return;
-
-    this->mCurve.resize(0);
-
-    T min = this->mData.front().first;
-    T max = this->mData.back().first;
-
-    T step = (max - min) / static_cast<double>(steeps);
-
-    T threshold = min;
-    for (size_t i = 0; i < steeps; i++) {
-
-        auto confussion_matrix = this->confusionMatrix(threshold);
-        double fpr = this->falsePositiveRate(confussion_matrix[DETCurve<T>::Classification::false_positives],
-                                             confussion_matrix[DETCurve<T>::Classification::true_negatives]);
-        double fnr = this->falseNegativeRate(confussion_matrix[DETCurve<T>::Classification::false_negatives],
-                                             confussion_matrix[DETCurve<T>::Classification::true_positives]);
-        this->mCurve.emplace_back(fpr, fnr);
-        threshold += step;
-    }
-
-    /// AUC
-    //size_t size = this->mCurve.size();
-    this->mAuc = 0.0;
-
-    //if (size > 2) {
-    //  Point<double> point1 = this->mCurve[0];
-    //  Point<double> point2;
-
-    //  for(size_t i = 1; i < size; i++){
-    //    point2 = this->mCurve[i];
-    //    this->mAuc += std::abs((1 - point1.x + 1 - point2.x) / 2. * (point1.y - point2.y));
-    //    point1 = point2;
-    //  }
-    //}
+    this->sweep(steeps, [](size_t tp, size_t fp, size_t tn, size_t fn) {
+        return Point<double>(Curve<T>::falsePositiveRate(fp, tn),
+                             Curve<T>::falseNegativeRate(fn, tp));
+    }, false);
 }
 
 template<typename T>
 void DETCurve<T>::compute()
 {
-    if (this->mData.empty()) return;
-
-    this->mCurve.resize(0);
-
-    for (auto &data : this->mData) {
-        auto confussion_matrix = this->confusionMatrix(data.first);
-        double fpr = this->falsePositiveRate(confussion_matrix[DETCurve<T>::Classification::false_positives],
-                                             confussion_matrix[DETCurve<T>::Classification::true_negatives]);
-        double fnr = this->falseNegativeRate(confussion_matrix[DETCurve<T>::Classification::false_negatives],
-                                             confussion_matrix[DETCurve<T>::Classification::true_positives]);
-        this->mCurve.emplace_back(fpr, fnr);
-    }
-
-    /// AUC
-    //size_t size = this->mCurve.size();
-    this->mAuc = 0.0;
-
-    //if (size > 2) {
-    //  Point<double> point1 = this->mCurve[0];
-    //  Point<double> point2;
-
-    //  for (size_t i = 1; i < size; i++) {
-    //    point2 = this->mCurve[i];
-    //    this->mAuc += std::abs((1 - point1.x + 1 - point2.x) / 2. * (point1.y - point2.y));
-    //    point1 = point2;
-    //  }
-    //}
+    this->sweep([](size_t tp, size_t fp, size_t tn, size_t fn) {
+        return Point<double>(Curve<T>::falsePositiveRate(fp, tn),
+                             Curve<T>::falseNegativeRate(fn, tp));
+    }, false);
 }
 
 } // namespace tl
@@ -0,0 +1,708 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "tidop/core/defs.h"
+#include "tidop/core/exception.h"
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/geometry/entities/multipoint.h"
+#include "tidop/geometry/entities/polygon.h"
+#include "tidop/geometry/algorithms/predicates.h"
+
+namespace tl
+{
+
+/*! \addtogroup geometry
+ *  \{
+ */
+
+/*! \addtogroup geometry_algorithms
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+/* Points per parallel task of the 2D convex hull */
+constexpr size_t convex_hull_block_size = 1 << 16;
+
+template<typename Point_t>
+auto convex_hull_point(double x, double y) -> Point_t
+{
+    using scalar = typename Point_t::value_type;
+
+    Point_t point;
+    if (std::is_integral<scalar>::value) {
+        point.x = static_cast<scalar>(roundToInteger(x));
+        point.y = static_cast<scalar>(roundToInteger(y));
+    } else {
+        point.x = static_cast<scalar>(x);
+        point.y = static_cast<scalar>(y);
+    }
+
+    return point;
+}
+
+template<typename Point_t>
+bool convex_hull_less(const Point_t &pt1, const Point_t &pt2)
+{
+    return pt1.x < pt2.x || (pt1.x == pt2.x && pt1.y < pt2.y);
+}
+
+/* Andrew's monotone chain. Sorts the points and returns the hull counterclockwise,
+   starting at the lowest x (and y), without collinear points */
+template<typename Point_t>
+auto convex_hull_chain(std::vector<Point_t> &points) -> std::vector<Point_t>
+{
+    std::sort(points.begin(), points.end(), convex_hull_less<Point_t>);
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+    size_t size = points.size();
+    if (size < 3) return points;
+
+    std::vector<Point_t> hull(2 * size);
+    size_t k = 0;
+
+    /* Lower chain */
+    for (size_t i = 0; i < size; i++) {
+        while (k >= 2 && orientation(hull[k - 2], hull[k - 1], points[i]) <= 0) k--;
+        hull[k++] = points[i];
+    }
+
+    /* Upper chain */
+    for (size_t i = size - 1, lower = k + 1; i > 0; i--) {
+        while (k >= lower && orientation(hull[k - 2], hull[k - 1], points[i - 1]) <= 0) k--;
+        hull[k++] = points[i - 1];
+    }
+
+    hull.resize(k - 1);
+
+    return hull;
+}
+
+/* Akl-Toussaint heuristic: the extreme points in x, y, x + y and x - y form an
+   octagon inside the hull and the points strictly inside it are discarded.
+   Each block keeps its remaining points and reduces them to its own hull, and
+   the hull of the block hulls is the hull of the set. */
+template<typename Point_t, typename It>
+auto convex_hull(It first, size_t size) -> std::vector<Point_t>
+{
+    std::vector<Point_t> hull;
+    if (size == 0) return hull;
+
+    size_t blocks = (size + convex_hull_block_size - 1) / convex_hull_block_size;
+
+    /* Extreme points: min x, min x + y, min y, max x - y, max x, max x + y, max y, min x - y */
+    std::vector<std::array<size_t, 8>> block_extremes(blocks);
+
+    auto keys = [&](size_t i, std::array<double, 8> &values) {
+        const auto &point = *(first + i);
+        double x = static_cast<double>(point.x);
+        double y = static_cast<double>(point.y);
+        values = {-x, -(x + y), -y, x - y, x, x + y, y, y - x};
+    };
+
+    std::vector<std::array<double, 8>> block_values(blocks);
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * convex_hull_block_size;
+        size_t end = std::min(ini + convex_hull_block_size, size);
+        auto &extremes = block_extremes[block];
+        auto &best = block_values[block];
+        extremes.fill(ini);
+        keys(ini, best);
+        std::array<double, 8> values;
+        for (size_t i = ini + 1; i < end; i++) {
+            keys(i, values);
+            for (size_t direction = 0; direction < 8; direction++) {
+                if (values[direction] > best[direction]) {
+                    best[direction] = values[direction];
+                    extremes[direction] = i;
+                }
+            }
+        }
+    });
+
+    std::array<size_t, 8> extremes = block_extremes[0];
+    std::array<double, 8> best = block_values[0];
+    for (size_t block = 1; block < blocks; block++) {
+        for (size_t direction = 0; direction < 8; direction++) {
+            if (block_values[block][direction] > best[direction]) {
+                best[direction] = block_values[block][direction];
+                extremes[direction] = block_extremes[block][direction];
+            }
+        }
+    }
+
+    /* The extremes are hull points in counterclockwise order */
+    std::vector<Point_t> octagon;
+    for (size_t index : extremes) {
+        const Point_t &point = *(first + index);
+        if (octagon.empty() || !(octagon.back() == point)) octagon.push_back(point);
+    }
+    while (octagon.size() > 1 && octagon.front() == octagon.back()) octagon.pop_back();
+
+    /* A point is discarded only if it is inside every edge by more than the
+       rounding error of the cross product. The points are inside the box of the
+       octagon, so the error is bounded by its size; keeping a few more points
+       than needed is harmless */
+    size_t edges = octagon.size() < 3 ? 0 : octagon.size();
+    std::array<double, 8> origin_x{};
+    std::array<double, 8> origin_y{};
+    std::array<double, 8> edge_x{};
+    std::array<double, 8> edge_y{};
+    for (size_t i = 0; i < edges; i++) {
+        const Point_t &pt1 = octagon[i];
+        const Point_t &pt2 = octagon[(i + 1) % edges];
+        origin_x[i] = static_cast<double>(pt1.x);
+        origin_y[i] = static_cast<double>(pt1.y);
+        edge_x[i] = static_cast<double>(pt2.x) - origin_x[i];
+        edge_y[i] = static_cast<double>(pt2.y) - origin_y[i];
+    }
+
+    double extent = (best[0] + best[4]) + (best[2] + best[6]);
+    double tolerance = 8. * std::numeric_limits<double>::epsilon() * extent * extent;
+
+    auto inside_octagon = [&](const Point_t &point) {
+        if (edges == 0) return false;
+        double x = static_cast<double>(point.x);
+        double y = static_cast<double>(point.y);
+        for (size_t i = 0; i < edges; i++) {
+            if (edge_x[i] * (y - origin_y[i]) - edge_y[i] * (x - origin_x[i]) <= tolerance) return false;
+        }
+        return true;
+    };
+
+    std::vector<std::vector<Point_t>> block_hulls(blocks);
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * convex_hull_block_size;
+        size_t end = std::min(ini + convex_hull_block_size, size);
+        std::vector<Point_t> candidates;
+        for (size_t i = ini; i < end; i++) {
+            const Point_t &point = *(first + i);
+            if (!inside_octagon(point)) candidates.push_back(point);
+        }
+        block_hulls[block] = convex_hull_chain(candidates);
+    });
+
+    if (blocks == 1) return block_hulls[0];
+
+    for (const auto &block_hull : block_hulls)
+        hull.insert(hull.end(), block_hull.begin(), block_hull.end());
+
+    return convex_hull_chain(hull);
+}
+
+/* Rotating calipers over the edges of a counterclockwise hull. For each edge,
+   the enclosing rectangle with a side on it is passed to the function as
+   (origin, direction, min, max, height): the rectangle spans [min, max] along the
+   unit direction of the edge and [0, height] along its left normal. */
+template<typename Point_t, typename Function>
+void convex_hull_calipers(const std::vector<Point_t> &hull, Function function)
+{
+    size_t size = hull.size();
+
+    auto x = [&](size_t i) { return static_cast<double>(hull[i % size].x); };
+    auto y = [&](size_t i) { return static_cast<double>(hull[i % size].y); };
+
+    if (size < 3) {
+        double dx = size == 2 ? x(1) - x(0) : 1.;
+        double dy = size == 2 ? y(1) - y(0) : 0.;
+        double length = std::sqrt(dx * dx + dy * dy);
+        function(x(0), y(0), dx / length, dy / length, 0., size == 2 ? length : 0., 0.);
+        return;
+    }
+
+    size_t right = 1;
+    size_t top = 1;
+    size_t left = 1;
+
+    for (size_t i = 0; i < size; i++) {
+
+        double ox = x(i);
+        double oy = y(i);
+        double dx = x(i + 1) - ox;
+        double dy = y(i + 1) - oy;
+        double length = std::sqrt(dx * dx + dy * dy);
+        double ux = dx / length;
+        double uy = dy / length;
+
+        auto along = [&](size_t k) { return (x(k) - ox) * ux + (y(k) - oy) * uy; };
+        auto across = [&](size_t k) { return (y(k) - oy) * ux - (x(k) - ox) * uy; };
+
+        /* The three calipers only move forward */
+        if (right < i + 1) right = i + 1;
+        for (size_t n = 0; n < size && along(right + 1) >= along(right); n++) right++;
+        if (top < right) top = right;
+        for (size_t n = 0; n < size && across(top + 1) >= across(top); n++) top++;
+        if (left < top) left = top;
+        for (size_t n = 0; n < size && along(left + 1) <= along(left); n++) left++;
+
+        function(ox, oy, ux, uy, along(left), along(right), across(top));
+    }
+}
+
+enum class RectangleCriterion
+{
+    area,
+    perimeter
+};
+
+template<typename Point_t>
+auto convex_hull_rectangle(const std::vector<Point_t> &hull,
+                           RectangleCriterion criterion) -> Polygon<Point_t>
+{
+    Polygon<Point_t> rectangle;
+    if (hull.empty()) return rectangle;
+
+    double best = std::numeric_limits<double>::max();
+    std::array<double, 8> corners{};
+
+    convex_hull_calipers(hull, [&](double ox, double oy, double ux, double uy,
+                                   double min, double max, double height) {
+        double width = max - min;
+        double value = criterion == RectangleCriterion::area ? width * height : width + height;
+        if (value < best) {
+            best = value;
+            double vx = -uy;
+            double vy = ux;
+            corners = {ox + min * ux, oy + min * uy,
+                       ox + max * ux, oy + max * uy,
+                       ox + max * ux + height * vx, oy + max * uy + height * vy,
+                       ox + min * ux + height * vx, oy + min * uy + height * vy};
+        }
+    });
+
+    for (size_t i = 0; i < 4; i++)
+        rectangle.push_back(convex_hull_point<Point_t>(corners[2 * i], corners[2 * i + 1]));
+
+    return rectangle;
+}
+
+
+struct QuickHullFace
+{
+    std::array<size_t, 3> vertices;
+    /* Face across the edge vertices[i] -> vertices[(i + 1) % 3] */
+    std::array<size_t, 3> neighbours;
+    std::array<double, 3> normal;
+    double offset;
+    std::vector<size_t> outside;
+    size_t furthest;
+    double furthest_distance;
+    bool removed;
+};
+
+/* QuickHull 3D (Barber, Dobkin and Huhdanpaa). Every face keeps the points
+   above it and the furthest one is added to the hull: the faces it sees are
+   removed and the horizon is joined to it with a cone of new faces. */
+template<typename It>
+auto quickhull3d(It first, size_t size) -> std::vector<std::array<size_t, 3>>
+{
+    std::vector<std::array<double, 3>> points(size);
+    double scale = 0.;
+    for (size_t i = 0; i < size; i++) {
+        const auto &point = *(first + i);
+        points[i] = {static_cast<double>(point.x), static_cast<double>(point.y), static_cast<double>(point.z)};
+        scale = std::max(scale, std::abs(points[i][0]) + std::abs(points[i][1]) + std::abs(points[i][2]));
+    }
+
+    /* Distance below which a point is considered on a plane */
+    double tolerance = 3. * std::numeric_limits<double>::epsilon() * scale;
+
+    auto sub = [](const std::array<double, 3> &a, const std::array<double, 3> &b) {
+        return std::array<double, 3>{a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+    };
+    auto cross = [](const std::array<double, 3> &a, const std::array<double, 3> &b) {
+        return std::array<double, 3>{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    };
+    auto dot = [](const std::array<double, 3> &a, const std::array<double, 3> &b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    };
+    auto norm = [&](const std::array<double, 3> &a) {
+        return std::sqrt(dot(a, a));
+    };
+
+    /* Initial tetrahedron */
+    std::array<size_t, 6> extremes{};
+    for (size_t i = 1; i < size; i++) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (points[i][axis] < points[extremes[2 * axis]][axis]) extremes[2 * axis] = i;
+            if (points[i][axis] > points[extremes[2 * axis + 1]][axis]) extremes[2 * axis + 1] = i;
+        }
+    }
+
+    size_t v0 = 0;
+    size_t v1 = 0;
+    double max_distance = 0.;
+    for (size_t i = 0; i < 6; i++) {
+        for (size_t j = i + 1; j < 6; j++) {
+            double distance = norm(sub(points[extremes[i]], points[extremes[j]]));
+            if (distance > max_distance) {
+                max_distance = distance;
+                v0 = extremes[i];
+                v1 = extremes[j];
+            }
+        }
+    }
+
+    TL_ASSERT(max_distance > tolerance, "All the points are coincident");
+
+    size_t v2 = 0;
+    max_distance = 0.;
+    auto line = sub(points[v1], points[v0]);
+    for (size_t i = 0; i < size; i++) {
+        double distance = norm(cross(line, sub(points[i], points[v0]))) / norm(line);
+        if (distance > max_distance) {
+            max_distance = distance;
+            v2 = i;
+        }
+    }
+
+    TL_ASSERT(max_distance > tolerance, "All the points are collinear");
+
+    size_t v3 = 0;
+    max_distance = 0.;
+    auto plane = cross(line, sub(points[v2], points[v0]));
+    double plane_norm = norm(plane);
+    for (size_t i = 0; i < size; i++) {
+        double distance = std::abs(dot(plane, sub(points[i], points[v0]))) / plane_norm;
+        if (distance > max_distance) {
+            max_distance = distance;
+            v3 = i;
+        }
+    }
+
+    TL_ASSERT(max_distance > tolerance, "All the points are coplanar");
+
+    if (dot(plane, sub(points[v3], points[v0])) > 0.) std::swap(v1, v2);
+
+    std::vector<QuickHullFace> faces;
+
+    auto add_face = [&](size_t a, size_t b, size_t c) -> size_t {
+        QuickHullFace face;
+        face.vertices = {a, b, c};
+        face.neighbours = {0, 0, 0};
+        auto normal = cross(sub(points[b], points[a]), sub(points[c], points[a]));
+        double length = norm(normal);
+        if (length > 0.) {
+            for (auto &coordinate : normal) coordinate /= length;
+        }
+        face.normal = normal;
+        face.offset = dot(normal, points[a]);
+        face.furthest = 0;
+        face.furthest_distance = 0.;
+        face.removed = false;
+        faces.push_back(std::move(face));
+        return faces.size() - 1;
+    };
+
+    auto distance = [&](const QuickHullFace &face, size_t point) {
+        return dot(face.normal, points[point]) - face.offset;
+    };
+
+    /* Assigns the point to the first face in [ini, end) that it is above */
+    auto assign = [&](size_t point, size_t ini, size_t end) {
+        for (size_t f = ini; f < end; f++) {
+            auto &face = faces[f];
+            double d = distance(face, point);
+            if (d > tolerance) {
+                face.outside.push_back(point);
+                if (d > face.furthest_distance) {
+                    face.furthest_distance = d;
+                    face.furthest = point;
+                }
+                return;
+            }
+        }
+    };
+
+    add_face(v0, v1, v2);
+    add_face(v0, v3, v1);
+    add_face(v1, v3, v2);
+    add_face(v2, v3, v0);
+
+    /* Neighbours of the tetrahedron: the face with the reversed edge */
+    for (size_t f = 0; f < 4; f++) {
+        for (size_t e = 0; e < 3; e++) {
+            size_t a = faces[f].vertices[e];
+            size_t b = faces[f].vertices[(e + 1) % 3];
+            for (size_t g = 0; g < 4; g++) {
+                if (g == f) continue;
+                for (size_t k = 0; k < 3; k++) {
+                    if (faces[g].vertices[k] == b && faces[g].vertices[(k + 1) % 3] == a)
+                        faces[f].neighbours[e] = g;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        if (i != v0 && i != v1 && i != v2 && i != v3) assign(i, 0, 4);
+    }
+
+    std::vector<size_t> pending{0, 1, 2, 3};
+    std::vector<size_t> visited;
+    std::vector<size_t> visible;
+    std::vector<std::array<size_t, 3>> horizon;
+    std::unordered_map<size_t, size_t> edge_start;
+    std::unordered_map<size_t, size_t> edge_end;
+    size_t stamp = 0;
+
+    while (!pending.empty()) {
+
+        size_t current = pending.back();
+        pending.pop_back();
+        if (faces[current].removed || faces[current].outside.empty()) continue;
+
+        size_t eye = faces[current].furthest;
+
+        /* Faces seen from the eye point and the edges of the horizon */
+        stamp++;
+        visited.resize(faces.size(), 0);
+        visited[current] = stamp;
+        faces[current].removed = true;
+        visible.assign(1, current);
+        horizon.clear();
+
+        for (size_t v = 0; v < visible.size(); v++) {
+            size_t f = visible[v];
+            for (size_t e = 0; e < 3; e++) {
+                size_t neighbour = faces[f].neighbours[e];
+                if (visited[neighbour] != stamp) {
+                    visited[neighbour] = stamp;
+                    if (distance(faces[neighbour], eye) > tolerance) {
+                        faces[neighbour].removed = true;
+                        visible.push_back(neighbour);
+                        continue;
+                    }
+                }
+                if (!faces[neighbour].removed)
+                    horizon.push_back({faces[f].vertices[e], faces[f].vertices[(e + 1) % 3], neighbour});
+            }
+        }
+
+        /* Cone of new faces from the horizon to the eye point */
+        size_t first_face = faces.size();
+        edge_start.clear();
+        edge_end.clear();
+        for (const auto &edge : horizon) {
+            size_t f = add_face(edge[0], edge[1], eye);
+            faces[f].neighbours[0] = edge[2];
+            edge_start[edge[0]] = f;
+            edge_end[edge[1]] = f;
+            auto &neighbour = faces[edge[2]];
+            for (size_t k = 0; k < 3; k++) {
+                if (neighbour.vertices[k] == edge[1] && neighbour.vertices[(k + 1) % 3] == edge[0])
+                    neighbour.neighbours[k] = f;
+            }
+        }
+
+        for (size_t f = first_face; f < faces.size(); f++) {
+            faces[f].neighbours[1] = edge_start[faces[f].vertices[1]];
+            faces[f].neighbours[2] = edge_end[faces[f].vertices[0]];
+        }
+
+        for (size_t f : visible) {
+            std::vector<size_t> outside;
+            outside.swap(faces[f].outside);
+            for (size_t point : outside) {
+                if (point != eye) assign(point, first_face, faces.size());
+            }
+        }
+
+        for (size_t f = first_face; f < faces.size(); f++) {
+            if (!faces[f].outside.empty()) pending.push_back(f);
+        }
+    }
+
+    std::vector<std::array<size_t, 3>> triangles;
+    for (const auto &face : faces) {
+        if (!face.removed) triangles.push_back(face.vertices);
+    }
+
+    return triangles;
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Convex hull of a set of 2D points
+ *
+ * Andrew's monotone chain in O(n log n), preceded by the Akl-Toussaint
+ * heuristic: the points inside the octagon of the extreme points in x, y,
+ * x + y and x - y can't be on the hull and are discarded in a linear pass,
+ * which removes nearly all the points of large sets. The set is processed in
+ * blocks in parallel (extremes, filter and hull of each block) and the hull of
+ * the block hulls is the result.
+ *
+ * The orientation test is exact, so collinear points are never hull vertices
+ * and the hull is strictly convex.
+ *
+ * \param[in] points Points
+ * \return Counterclockwise hull starting at the point with the lowest x (and y).
+ * A single point or two points for degenerate sets
+ */
+template<typename Point_t>
+auto convexHull(const std::vector<Point_t> &points) -> Polygon<Point_t>
+{
+    return Polygon<Point_t>(internal::convex_hull<Point_t>(points.begin(), points.size()));
+}
+
+/*!
+ * \brief Convex hull of a multi-point
+ * \param[in] multiPoint Multi-point
+ * \return Counterclockwise hull
+ * \see convexHull(const std::vector<Point_t> &)
+ */
+template<typename Point_t>
+auto convexHull(const MultiPoint<Point_t> &multiPoint) -> Polygon<Point_t>
+{
+    return Polygon<Point_t>(internal::convex_hull<Point_t>(multiPoint.begin(), multiPoint.size()));
+}
+
+/*!
+ * \brief Minimum area rectangle enclosing a set of 2D points
+ *
+ * The rectangle has a side on an edge of the convex hull (Freeman and
+ * Shapira), so rotating calipers over the hull find it in linear time after
+ * the hull is computed.
+ *
+ * \param[in] points Points
+ * \return Counterclockwise corners of the rectangle. Rounded for integer coordinates
+ * \see convexHull
+ */
+template<typename Point_t>
+auto minimumAreaRectangle(const std::vector<Point_t> &points) -> Polygon<Point_t>
+{
+    return internal::convex_hull_rectangle(internal::convex_hull<Point_t>(points.begin(), points.size()),
+                                           internal::RectangleCriterion::area);
+}
+
+template<typename Point_t>
+auto minimumAreaRectangle(const MultiPoint<Point_t> &multiPoint) -> Polygon<Point_t>
+{
+    return internal::convex_hull_rectangle(internal::convex_hull<Point_t>(multiPoint.begin(), multiPoint.size()),
+                                           internal::RectangleCriterion::area);
+}
+
+/*!
+ * \brief Minimum perimeter rectangle enclosing a set of 2D points
+ * \param[in] points Points
+ * \return Counterclockwise corners of the rectangle. Rounded for integer coordinates
+ * \see minimumAreaRectangle
+ */
+template<typename Point_t>
+auto minimumPerimeterRectangle(const std::vector<Point_t> &points) -> Polygon<Point_t>
+{
+    return internal::convex_hull_rectangle(internal::convex_hull<Point_t>(points.begin(), points.size()),
+                                           internal::RectangleCriterion::perimeter);
+}
+
+template<typename Point_t>
+auto minimumPerimeterRectangle(const MultiPoint<Point_t> &multiPoint) -> Polygon<Point_t>
+{
+    return internal::convex_hull_rectangle(internal::convex_hull<Point_t>(multiPoint.begin(), multiPoint.size()),
+                                           internal::RectangleCriterion::perimeter);
+}
+
+/*!
+ * \brief Convex hull of a set of 3D points
+ *
+ * QuickHull in O(n log n) expected time. The points closer to a face than a
+ * tolerance relative to the coordinates are considered on the face, so
+ * coplanar faces are triangulated without the points inside them.
+ *
+ * \param[in] points Points
+ * \return Triangles of the hull as indexes of the points, counterclockwise
+ * seen from outside
+ * \exception Exception if there are less than four non coplanar points
+ */
+template<typename Point3_t>
+auto convexHull3D(const std::vector<Point3_t> &points) -> std::vector<std::array<size_t, 3>>
+{
+    std::vector<std::array<size_t, 3>> triangles;
+
+    try {
+
+        TL_ASSERT(points.size() >= 4, "At least four points are needed");
+
+        triangles = internal::quickhull3d(points.begin(), points.size());
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return triangles;
+}
+
+/*!
+ * \brief Convex hull of a 3D multi-point
+ * \param[in] multiPoint Multi-point
+ * \return Triangles of the hull as indexes of the points
+ * \see convexHull3D(const std::vector<Point3_t> &)
+ */
+template<typename Point3_t>
+auto convexHull3D(const MultiPoint3D<Point3_t> &multiPoint) -> std::vector<std::array<size_t, 3>>
+{
+    std::vector<std::array<size_t, 3>> triangles;
+
+    try {
+
+        TL_ASSERT(multiPoint.size() >= 4, "At least four points are needed");
+
+        triangles = internal::quickhull3d(multiPoint.begin(), multiPoint.size());
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return triangles;
+}
+
+
+/*! \} */ // end of geometry_algorithms
+
+/*! \} */ // end of geometry
+
+} // End namespace tl
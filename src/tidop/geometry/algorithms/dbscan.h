@@ -22,13 +22,15 @@
  *                                                                        *
  **************************************************************************/
 
+
 #pragma once
 
-#include "tidop/geometry/entities/point.h"
-#include "tidop/geometry/algorithms/distance.h"
-#include "tidop/math/algebra/matrix.h"
+#include <type_traits>
+#include <vector>
 
-#include <map>
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/geometry/entities/point.h"
+#include "tidop/geometry/algorithms/kdtree.h"
 
 namespace tl
 {
@@ -41,117 +43,273 @@ namespace tl
  *  \{
  */
 
- //https://stackoverflow.com/questions/23842940/clustering-image-segments-in-opencv/23997322#23997322
+
+/// \cond
+
+namespace internal
+{
+
+/* Point type used by the spatial index (integer coordinates are indexed as double) */
+template<typename Point_t>
+struct DbScanIndexPoint;
 
 template<typename T>
+struct DbScanIndexPoint<Point<T>>
+{
+    using type = Point<typename std::conditional<std::is_floating_point<T>::value, T, double>::type>;
+};
+
+template<typename T>
+struct DbScanIndexPoint<Point3<T>>
+{
+    using type = Point3<typename std::conditional<std::is_floating_point<T>::value, T, double>::type>;
+};
+
+/* Points per parallel task in the core point search */
+constexpr size_t dbscan_block_size = 256;
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Density-based spatial clustering (DBSCAN)
+ *
+ * The neighbourhoods are searched with a KDTree, so the clustering runs in
+ * O(n log n) for well distributed data and the memory is linear in the
+ * number of points. Core points (points with at least minPoints neighbours
+ * within eps, the point itself included) are found in parallel. Clusters
+ * are then grown from each unvisited core point with an explicit queue.
+ *
+ * Points that are not reachable from any core point are labelled as noise.
+ * A border point reachable from several clusters is assigned to the first
+ * one that reaches it.
+ *
+ * <h4>Example</h4>
+ * \code
+ * DbScan<double> dbscan(points, 0.2, 10);
+ * dbscan.run();
+ * auto clusters = dbscan.groups();
+ * \endcode
+ *
+ * \tparam T Coordinate type
+ * \tparam Point_t Point<T> (default) or Point3<T>
+ */
+template<typename T, typename Point_t = Point<T>>
 class DbScan
 {
 
 public:
 
-    std::map<size_t, int> labels;
-    std::vector<Point<T>> mData;
-    int C;
-    double eps;
-    size_t mnpts;
-    Matrix<double> dp;
+    using point_type = Point_t;
+
+    /*!
+     * \brief Label of the points that do not belong to any cluster
+     */
+    static constexpr int noise = -1;
 
 public:
 
-    DbScan(const std::vector<Point<T>> &data, double _eps, size_t _mnpts)
-        : mData(data), 
-          C(-1),
-          eps(_eps),
-          mnpts(_mnpts),
-          dp(Matrix<double>(mData.size(), mData.size(), -1.))
-    {
+    /*!
+     * \brief Constructor
+     * \param[in] data Points
+     * \param[in] eps Neighbourhood radius
+     * \param[in] minPoints Minimum number of points in the neighbourhood of a core point
+     */
+    DbScan(const std::vector<Point_t> &data, 
+           double eps, 
+           size_t minPoints);
+
+    /*!
+     * \brief Runs the clustering
+     */
+    void run();
+
+    /*!
+     * \brief Number of clusters found
+     */
+    auto clusterCount() const -> size_t;
+
+    /*!
+     * \brief Cluster of each point
+     * \return Cluster index or DbScan::noise
+     */
+    auto labels() const -> const std::vector<int>&;
+
+    /*!
+     * \brief Whether the point is a core point
+     */
+    auto isCore(size_t index) const -> bool;
+
+    /*!
+     * \brief Indices of the points within eps of a point, the point itself included
+     */
+    auto regionQuery(size_t index) const -> std::vector<size_t>;
+
+    /*!
+     * \brief Points of each cluster
+     */
+    auto groups() const -> std::vector<std::vector<Point_t>>;
+
+private:
+
+    using index_point = typename internal::DbScanIndexPoint<Point_t>::type;
+    using index_scalar = typename index_point::value_type;
+
+    void buildIndex();
+    void findCorePoints();
+    void expandCluster(size_t seed, int cluster);
+
+private:
+
+    std::vector<Point_t> mData;
+    double mEps;
+    size_t mMinPoints;
+    KDTree<index_point> mIndex;
+    std::vector<int> mLabels;
+    std::vector<unsigned char> mCore;
+    size_t mClusterCount;
 
-        for (size_t i = 0; i < mData.size(); i++) {
-            labels[i] = -99;
-        }
+};
 
-    }
 
-    void run()
-    {
-        for (size_t i = 0; i < mData.size(); i++) {
-            dp.at(i, i) = 0.;
-        }
+/* Implementation */
 
-        for (size_t i = 0; i < mData.size(); i++) {
-            if (!isVisited(i)) {
-                std::vector<size_t> neighbours = regionQuery(i);
-                if (neighbours.size() < mnpts) {
-                    labels[i] = -1;
-                } else {
-                    C++;
-                    expandCluster(i, neighbours);
-                }
-            }
-        }
-    }
+template<typename T, typename Point_t>
+constexpr int DbScan<T, Point_t>::noise;
+
+template<typename T, typename Point_t>
+DbScan<T, Point_t>::DbScan(const std::vector<Point_t> &data,
+                           double eps,
+                           size_t minPoints)
+  : mData(data),
+    mEps(eps),
+    mMinPoints(minPoints),
+    mClusterCount(0)
+{
+}
 
-    void expandCluster(size_t p, const std::vector<size_t> &neighbours)
-    {
-        labels[p] = C;
+template<typename T, typename Point_t>
+void DbScan<T, Point_t>::run()
+{
+    mLabels.assign(mData.size(), noise);
+    mClusterCount = 0;
 
-        for (auto neighbour : neighbours) {
-            if (!isVisited(neighbour)) {
-                labels[neighbour] = C;
-                std::vector<size_t> neighbours_p = regionQuery(neighbour);
-                if (neighbours_p.size() >= mnpts) {
-                    expandCluster(neighbour, neighbours_p);
-                }
-            }
+    buildIndex();
+    findCorePoints();
+
+    for (size_t i = 0; i < mData.size(); i++) {
+        if (mCore[i] && mLabels[i] == noise) {
+            expandCluster(i, static_cast<int>(mClusterCount));
+            mClusterCount++;
         }
     }
+}
 
-    bool isVisited(size_t i)
-    {
-        return labels[i] != -99;
+template<typename T, typename Point_t>
+void DbScan<T, Point_t>::buildIndex()
+{
+    std::vector<index_point> points;
+    points.reserve(mData.size());
+    for (const auto &point : mData) {
+        points.push_back(static_cast<index_point>(point));
     }
 
-    std::vector<size_t> regionQuery(size_t p)
-    {
-        std::vector<size_t> res;
+    mIndex.build(points);
+}
 
-        for (size_t i = 0; i < mData.size(); i++) {
-            if (distanceFunc(p, i) <= eps) {
-                res.push_back(i);
-            }
+template<typename T, typename Point_t>
+void DbScan<T, Point_t>::findCorePoints()
+{
+    mCore.assign(mData.size(), 0);
+
+    size_t blocks = (mData.size() + internal::dbscan_block_size - 1) / internal::dbscan_block_size;
+    index_scalar radius = static_cast<index_scalar>(mEps);
+
+    parallel_for(0, blocks, [&](size_t block) {
+        std::vector<size_t> neighbours;
+        std::vector<index_scalar> squared_distances;
+        size_t ini = block * internal::dbscan_block_size;
+        size_t end = std::min(ini + internal::dbscan_block_size, mData.size());
+        for (size_t i = ini; i < end; i++) {
+            mIndex.radiusSearch(static_cast<index_point>(mData[i]), radius, neighbours, squared_distances);
+            mCore[i] = neighbours.size() >= mMinPoints ? 1 : 0;
         }
+    });
+}
 
-        return res;
-    }
+template<typename T, typename Point_t>
+void DbScan<T, Point_t>::expandCluster(size_t seed, int cluster)
+{
+    std::vector<size_t> queue{seed};
+    std::vector<size_t> neighbours;
+    std::vector<index_scalar> squared_distances;
+    index_scalar radius = static_cast<index_scalar>(mEps);
 
-    double distanceFunc(size_t ai, size_t bi)
-    {
-        if (dp.at(ai, bi) > -1)
-            return dp.at(ai, bi);
-        
-        double dist = distance(mData[ai], mData[bi]);
+    mLabels[seed] = cluster;
 
-        dp.at(ai,bi) = dist;
-        dp.at(bi,ai) = dist;
+    /* Only core points are queued, border points are labelled but not expanded */
+    while (!queue.empty()) {
 
-        return dp.at(ai, bi);
-    }
+        size_t point = queue.back();
+        queue.pop_back();
 
-    std::vector<std::vector<Point<T>> > groups()
-    {
-        std::vector<std::vector<Point<T>>> ret(C+1, std::vector<Point<T>>());
+        mIndex.radiusSearch(static_cast<index_point>(mData[point]), radius, neighbours, squared_distances);
 
-        for (int i = 0; i <= C; i++) {
-            for (size_t j = 0; j < mData.size(); j++) {
-                if (labels[j] == i) {
-                    ret[i].push_back(mData[j]);
-                }
-            }
+        for (auto neighbour : neighbours) {
+            if (mLabels[neighbour] != noise) continue;
+            mLabels[neighbour] = cluster;
+            if (mCore[neighbour]) queue.push_back(neighbour);
         }
+    }
+}
+
+template<typename T, typename Point_t>
+auto DbScan<T, Point_t>::clusterCount() const -> size_t
+{
+    return mClusterCount;
+}
+
+template<typename T, typename Point_t>
+auto DbScan<T, Point_t>::labels() const -> const std::vector<int>&
+{
+    return mLabels;
+}
+
+template<typename T, typename Point_t>
+auto DbScan<T, Point_t>::isCore(size_t index) const -> bool
+{
+    return index < mCore.size() && mCore[index] != 0;
+}
+
+template<typename T, typename Point_t>
+auto DbScan<T, Point_t>::regionQuery(size_t index) const -> std::vector<size_t>
+{
+    return mIndex.radiusSearch(static_cast<index_point>(mData[index]),
+                               static_cast<index_scalar>(mEps));
+}
 
-        return ret;
+template<typename T, typename Point_t>
+auto DbScan<T, Point_t>::groups() const -> std::vector<std::vector<Point_t>>
+{
+    std::vector<std::vector<Point_t>> clusters(mClusterCount);
+
+    for (size_t i = 0; i < mLabels.size(); i++) {
+        if (mLabels[i] != noise) {
+            clusters[static_cast<size_t>(mLabels[i])].push_back(mData[i]);
+        }
     }
-};
+
+    return clusters;
+}
+
+
+/*!
+ * \brief DBSCAN for 3D points
+ */
+template<typename T>
+using DbScan3D = DbScan<T, Point3<T>>;
 
 
 /*! \} */ // end of geometry_algorithms
@@ -159,4 +317,3 @@ public:
 /*! \} */ // end of geometry
 
 } // End namespace tl
-
@@ -0,0 +1,807 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "tidop/core/exception.h"
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/geometry/entities/point.h"
+#include "tidop/geometry/entities/window.h"
+#include "tidop/geometry/entities/bbox.h"
+
+namespace tl
+{
+
+/*! \addtogroup geometry
+ *  \{
+ */
+
+/*! \addtogroup geometry_algorithms
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+template<typename Point_t>
+struct KDTreePointTraits;
+
+template<typename T>
+struct KDTreePointTraits<Point<T>>
+{
+    static constexpr size_t dimensions = 2;
+
+    static auto coordinate(const Point<T> &point, size_t i) -> T
+    {
+        return i == 0 ? point.x : point.y;
+    }
+};
+
+template<typename T>
+struct KDTreePointTraits<Point3<T>>
+{
+    static constexpr size_t dimensions = 3;
+
+    static auto coordinate(const Point3<T> &point, size_t i) -> T
+    {
+        return i == 0 ? point.x : (i == 1 ? point.y : point.z);
+    }
+};
+
+/* Queries per parallel task in the batched searches */
+constexpr size_t kdtree_query_block_size = 64;
+
+/* Minimum number of points for the parallel construction */
+constexpr size_t kdtree_parallel_build_size = 1 << 15;
+
+/* Depth at which the construction is split into independent subtrees */
+constexpr size_t kdtree_parallel_build_depth = 4;
+
+/*
+ * Bounded max-heap with the k nearest candidates found so far
+ */
+template<typename T>
+class KDTreeKnnHeap
+{
+
+public:
+
+    explicit KDTreeKnnHeap(size_t k)
+      : mK(k)
+    {
+        mItems.reserve(k);
+    }
+
+    auto worst() const -> T
+    {
+        return mItems.size() < mK ? std::numeric_limits<T>::max() : mItems.front().first;
+    }
+
+    void push(T distance, size_t index)
+    {
+        if (mItems.size() < mK) {
+            mItems.emplace_back(distance, index);
+            std::push_heap(mItems.begin(), mItems.end());
+        } else if (distance < mItems.front().first) {
+            std::pop_heap(mItems.begin(), mItems.end());
+            mItems.back() = std::make_pair(distance, index);
+            std::push_heap(mItems.begin(), mItems.end());
+        }
+    }
+
+    auto sorted() -> std::vector<std::pair<T, size_t>> &
+    {
+        std::sort_heap(mItems.begin(), mItems.end());
+        return mItems;
+    }
+
+private:
+
+    size_t mK;
+    std::vector<std::pair<T, size_t>> mItems;
+
+};
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief KD-tree spatial index for 2D and 3D points
+ *
+ * Balanced tree built by median splits along the dimension of largest
+ * spread. The layout is implicit: the split planes are stored in arrays
+ * indexed as a binary heap (the children of node i are 2i+1 and 2i+2)
+ * and the coordinates are copied in tree order, so every leaf is a
+ * contiguous block of memory and no pointers are followed during the
+ * searches. Large trees are built in parallel once the top levels have
+ * been partitioned.
+ *
+ * The indices returned by the queries refer to the position of the
+ * points in the vector used to build the tree.
+ *
+ * <h4>Example</h4>
+ * \code
+ * std::vector<Point3<double>> cloud = ...;
+ * KDTree<Point3<double>> tree(cloud);
+ *
+ * auto nearest = tree.knnSearch(Point3<double>(1., 2., 3.), 8);
+ * auto neighbours = tree.radiusSearch(cloud[0], 0.5);
+ * \endcode
+ *
+ * \tparam Point_t Point<T> or Point3<T> with float or double coordinates
+ */
+template<typename Point_t>
+class KDTree
+{
+
+public:
+
+    using point_type = Point_t;
+    using scalar = typename Point_t::value_type;
+
+    static constexpr size_t dimensions = internal::KDTreePointTraits<Point_t>::dimensions;
+
+    static_assert(std::is_floating_point<scalar>::value, "KDTree requires float or double coordinates");
+
+public:
+
+    /*!
+     * \brief Default constructor. Empty tree
+     */
+    KDTree() = default;
+
+    /*!
+     * \brief Builds the tree
+     * \param[in] points Points to index
+     * \param[in] leafSize Maximum number of points per leaf
+     */
+    explicit KDTree(const std::vector<Point_t> &points,
+                    size_t leafSize = 16);
+
+    ~KDTree() = default;
+
+    /*!
+     * \brief Builds the tree, replacing the previous content
+     * \param[in] points Points to index
+     * \param[in] leafSize Maximum number of points per leaf
+     */
+    void build(const std::vector<Point_t> &points,
+               size_t leafSize = 16);
+
+    /*!
+     * \brief Number of indexed points
+     */
+    auto size() const -> size_t;
+
+    auto empty() const -> bool;
+
+    auto leafSize() const -> size_t;
+
+    /*!
+     * \name k nearest neighbours
+     * Results are sorted by increasing distance
+     * \{
+     */
+
+    /*!
+     * \brief Indices of the k nearest points
+     */
+    auto knnSearch(const Point_t &query,
+                   size_t k) const -> std::vector<size_t>;
+
+    /*!
+     * \brief Indices and squared distances of the k nearest points
+     */
+    void knnSearch(const Point_t &query,
+                   size_t k,
+                   std::vector<size_t> &indices,
+                   std::vector<scalar> &squaredDistances) const;
+
+    /*!
+     * \brief k nearest points of each query, computed in parallel
+     */
+    auto knnSearch(const std::vector<Point_t> &queries,
+                   size_t k) const -> std::vector<std::vector<size_t>>;
+
+    /*! \} */
+
+    /*!
+     * \name Radius search
+     * Points at a distance less than or equal to the radius, in no particular order
+     * \{
+     */
+
+    auto radiusSearch(const Point_t &query,
+                      scalar radius) const -> std::vector<size_t>;
+
+    void radiusSearch(const Point_t &query,
+                      scalar radius,
+                      std::vector<size_t> &indices,
+                      std::vector<scalar> &squaredDistances) const;
+
+    auto radiusSearch(const std::vector<Point_t> &queries,
+                      scalar radius) const -> std::vector<std::vector<size_t>>;
+
+    /*! \} */
+
+    /*!
+     * \name Window and box search
+     * Points inside the window (2D) or the bounding box (3D), borders included
+     * \{
+     */
+
+    template<typename Point_t2>
+    auto windowSearch(const Window<Point_t2> &window) const -> std::vector<size_t>;
+
+    template<typename Point_t2>
+    auto windowSearch(const std::vector<Window<Point_t2>> &windows) const -> std::vector<std::vector<size_t>>;
+
+    template<typename Point3_t>
+    auto boxSearch(const BoundingBox<Point3_t> &box) const -> std::vector<size_t>;
+
+    template<typename Point3_t>
+    auto boxSearch(const std::vector<BoundingBox<Point3_t>> &boxes) const -> std::vector<std::vector<size_t>>;
+
+    /*! \} */
+
+private:
+
+    using coordinates = std::array<scalar, dimensions>;
+
+    static auto toCoordinates(const Point_t &point) -> coordinates;
+
+    void buildNode(size_t node, size_t begin, size_t end, size_t depth,
+                   const std::vector<scalar> &source,
+                   std::vector<std::array<size_t, 3>> *frontier);
+
+    auto squaredDistance(size_t position, const coordinates &query) const -> scalar;
+
+    auto rootDistance(const coordinates &query, coordinates &offsets) const -> scalar;
+
+    void knnNode(size_t node, size_t begin, size_t end,
+                 const coordinates &query,
+                 coordinates &offsets,
+                 scalar distance,
+                 internal::KDTreeKnnHeap<scalar> &heap) const;
+
+    void radiusNode(size_t node, size_t begin, size_t end,
+                    const coordinates &query,
+                    coordinates &offsets,
+                    scalar distance,
+                    scalar squaredRadius,
+                    std::vector<size_t> &indices,
+                    std::vector<scalar> *squaredDistances) const;
+
+    void rangeNode(size_t node, size_t begin, size_t end,
+                   const coordinates &min,
+                   const coordinates &max,
+                   std::vector<size_t> &indices) const;
+
+    auto rangeSearch(coordinates min, coordinates max) const -> std::vector<size_t>;
+
+    template<typename Query, typename Search>
+    auto batch(const std::vector<Query> &queries, Search search) const -> std::vector<std::vector<size_t>>;
+
+private:
+
+    size_t mLeafSize{16};
+    /// Coordinates in tree order
+    std::vector<scalar> mCoordinates;
+    /// Original index of each point in tree order
+    std::vector<size_t> mIndices;
+    /// Split dimension of each internal node
+    std::vector<unsigned char> mSplitDimension;
+    /// Split value of each internal node
+    std::vector<scalar> mSplitValue;
+    coordinates mMin{};
+    coordinates mMax{};
+
+};
+
+
+
+/* Implementation */
+
+template<typename Point_t>
+constexpr size_t KDTree<Point_t>::dimensions;
+
+template<typename Point_t>
+KDTree<Point_t>::KDTree(const std::vector<Point_t> &points,
+                        size_t leafSize)
+{
+    build(points, leafSize);
+}
+
+template<typename Point_t>
+void KDTree<Point_t>::build(const std::vector<Point_t> &points,
+                            size_t leafSize)
+{
+    TL_ASSERT(leafSize > 0, "Invalid leaf size");
+
+    mLeafSize = leafSize;
+
+    size_t size = points.size();
+
+    std::vector<scalar> source(size * dimensions);
+    for (size_t i = 0; i < size; i++) {
+        for (size_t d = 0; d < dimensions; d++) {
+            source[i * dimensions + d] = internal::KDTreePointTraits<Point_t>::coordinate(points[i], d);
+        }
+    }
+
+    mIndices.resize(size);
+    std::iota(mIndices.begin(), mIndices.end(), size_t{0});
+
+    /* Depth of the deepest internal node */
+    size_t depth = 0;
+    for (size_t count = size; count > mLeafSize; count = (count + 1) / 2) {
+        depth++;
+    }
+
+    size_t internal_nodes = (size_t{1} << depth) - 1;
+    mSplitDimension.assign(internal_nodes, 0);
+    mSplitValue.assign(internal_nodes, scalar{0});
+
+    for (size_t d = 0; d < dimensions; d++) {
+        mMin[d] = std::numeric_limits<scalar>::max();
+        mMax[d] = std::numeric_limits<scalar>::lowest();
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        for (size_t d = 0; d < dimensions; d++) {
+            mMin[d] = std::min(mMin[d], source[i * dimensions + d]);
+            mMax[d] = std::max(mMax[d], source[i * dimensions + d]);
+        }
+    }
+
+    if (size >= internal::kdtree_parallel_build_size && depth > internal::kdtree_parallel_build_depth) {
+
+        std::vector<std::array<size_t, 3>> frontier;
+        buildNode(0, 0, size, 0, source, &frontier);
+
+        parallel_for(0, frontier.size(), [&](size_t i) {
+            buildNode(frontier[i][0], frontier[i][1], frontier[i][2], 
+                      internal::kdtree_parallel_build_depth, source, nullptr);
+        });
+
+    } else {
+        buildNode(0, 0, size, 0, source, nullptr);
+    }
+
+    mCoordinates.resize(size * dimensions);
+    for (size_t i = 0; i < size; i++) {
+        for (size_t d = 0; d < dimensions; d++) {
+            mCoordinates[i * dimensions + d] = source[mIndices[i] * dimensions + d];
+        }
+    }
+}
+
+template<typename Point_t>
+void KDTree<Point_t>::buildNode(size_t node, size_t begin, size_t end, size_t depth,
+                                const std::vector<scalar> &source,
+                                std::vector<std::array<size_t, 3>> *frontier)
+{
+    if (end - begin <= mLeafSize) return;
+
+    if (frontier && depth == internal::kdtree_parallel_build_depth) {
+        frontier->push_back({node, begin, end});
+        return;
+    }
+
+    coordinates min;
+    coordinates max;
+    for (size_t d = 0; d < dimensions; d++) {
+        min[d] = std::numeric_limits<scalar>::max();
+        max[d] = std::numeric_limits<scalar>::lowest();
+    }
+
+    for (size_t i = begin; i < end; i++) {
+        const scalar *point = &source[mIndices[i] * dimensions];
+        for (size_t d = 0; d < dimensions; d++) {
+            min[d] = std::min(min[d], point[d]);
+            max[d] = std::max(max[d], point[d]);
+        }
+    }
+
+    size_t split_dimension = 0;
+    for (size_t d = 1; d < dimensions; d++) {
+        if (max[d] - min[d] > max[split_dimension] - min[split_dimension])
+            split_dimension = d;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+
+    std::nth_element(mIndices.begin() + begin, mIndices.begin() + mid, mIndices.begin() + end,
+                     [&](size_t a, size_t b) {
+                         return source[a * dimensions + split_dimension] < source[b * dimensions + split_dimension];
+                     });
+
+    mSplitDimension[node] = static_cast<unsigned char>(split_dimension);
+    mSplitValue[node] = source[mIndices[mid] * dimensions + split_dimension];
+
+    buildNode(2 * node + 1, begin, mid, depth + 1, source, frontier);
+    buildNode(2 * node + 2, mid, end, depth + 1, source, frontier);
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::size() const -> size_t
+{
+    return mIndices.size();
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::empty() const -> bool
+{
+    return mIndices.empty();
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::leafSize() const -> size_t
+{
+    return mLeafSize;
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::toCoordinates(const Point_t &point) -> coordinates
+{
+    coordinates query;
+    for (size_t d = 0; d < dimensions; d++) {
+        query[d] = internal::KDTreePointTraits<Point_t>::coordinate(point, d);
+    }
+    return query;
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::squaredDistance(size_t position, const coordinates &query) const -> scalar
+{
+    const scalar *point = &mCoordinates[position * dimensions];
+    scalar distance = 0;
+    for (size_t d = 0; d < dimensions; d++) {
+        scalar diff = point[d] - query[d];
+        distance += diff * diff;
+    }
+    return distance;
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::rootDistance(const coordinates &query, coordinates &offsets) const -> scalar
+{
+    scalar distance = 0;
+    for (size_t d = 0; d < dimensions; d++) {
+        if (query[d] < mMin[d]) offsets[d] = query[d] - mMin[d];
+        else if (query[d] > mMax[d]) offsets[d] = query[d] - mMax[d];
+        else offsets[d] = 0;
+        distance += offsets[d] * offsets[d];
+    }
+    return distance;
+}
+
+/*
+ * Searches use the incremental distance to the cell of each node: when
+ * crossing a split plane only the offset along the split dimension
+ * changes, so the lower bound is updated in constant time.
+ */
+
+template<typename Point_t>
+void KDTree<Point_t>::knnNode(size_t node, size_t begin, size_t end,
+                              const coordinates &query,
+                              coordinates &offsets,
+                              scalar distance,
+                              internal::KDTreeKnnHeap<scalar> &heap) const
+{
+    if (end - begin <= mLeafSize) {
+        for (size_t i = begin; i < end; i++) {
+            scalar point_distance = squaredDistance(i, query);
+            if (point_distance < heap.worst())
+                heap.push(point_distance, i);
+        }
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    size_t split_dimension = mSplitDimension[node];
+    scalar diff = query[split_dimension] - mSplitValue[node];
+
+    if (diff < 0) {
+        knnNode(2 * node + 1, begin, mid, query, offsets, distance, heap);
+    } else {
+        knnNode(2 * node + 2, mid, end, query, offsets, distance, heap);
+    }
+
+    scalar offset = offsets[split_dimension];
+    scalar far_distance = distance - offset * offset + diff * diff;
+
+    if (far_distance < heap.worst()) {
+        offsets[split_dimension] = diff;
+        if (diff < 0) {
+            knnNode(2 * node + 2, mid, end, query, offsets, far_distance, heap);
+        } else {
+            knnNode(2 * node + 1, begin, mid, query, offsets, far_distance, heap);
+        }
+        offsets[split_dimension] = offset;
+    }
+}
+
+template<typename Point_t>
+void KDTree<Point_t>::radiusNode(size_t node, size_t begin, size_t end,
+                                 const coordinates &query,
+                                 coordinates &offsets,
+                                 scalar distance,
+                                 scalar squaredRadius,
+                                 std::vector<size_t> &indices,
+                                 std::vector<scalar> *squaredDistances) const
+{
+    if (end - begin <= mLeafSize) {
+        for (size_t i = begin; i < end; i++) {
+            scalar point_distance = squaredDistance(i, query);
+            if (point_distance <= squaredRadius) {
+                indices.push_back(mIndices[i]);
+                if (squaredDistances) squaredDistances->push_back(point_distance);
+            }
+        }
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    size_t split_dimension = mSplitDimension[node];
+    scalar diff = query[split_dimension] - mSplitValue[node];
+
+    if (diff < 0) {
+        radiusNode(2 * node + 1, begin, mid, query, offsets, distance, squaredRadius, indices, squaredDistances);
+    } else {
+        radiusNode(2 * node + 2, mid, end, query, offsets, distance, squaredRadius, indices, squaredDistances);
+    }
+
+    scalar offset = offsets[split_dimension];
+    scalar far_distance = distance - offset * offset + diff * diff;
+
+    if (far_distance <= squaredRadius) {
+        offsets[split_dimension] = diff;
+        if (diff < 0) {
+            radiusNode(2 * node + 2, mid, end, query, offsets, far_distance, squaredRadius, indices, squaredDistances);
+        } else {
+            radiusNode(2 * node + 1, begin, mid, query, offsets, far_distance, squaredRadius, indices, squaredDistances);
+        }
+        offsets[split_dimension] = offset;
+    }
+}
+
+template<typename Point_t>
+void KDTree<Point_t>::rangeNode(size_t node, size_t begin, size_t end,
+                                const coordinates &min,
+                                const coordinates &max,
+                                std::vector<size_t> &indices) const
+{
+    if (end - begin <= mLeafSize) {
+        for (size_t i = begin; i < end; i++) {
+            const scalar *point = &mCoordinates[i * dimensions];
+            bool inside = true;
+            for (size_t d = 0; d < dimensions; d++) {
+                inside = inside && point[d] >= min[d] && point[d] <= max[d];
+            }
+            if (inside) indices.push_back(mIndices[i]);
+        }
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    size_t split_dimension = mSplitDimension[node];
+    scalar split = mSplitValue[node];
+
+    if (min[split_dimension] <= split)
+        rangeNode(2 * node + 1, begin, mid, min, max, indices);
+    if (max[split_dimension] >= split)
+        rangeNode(2 * node + 2, mid, end, min, max, indices);
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::knnSearch(const Point_t &query,
+                                size_t k) const -> std::vector<size_t>
+{
+    std::vector<size_t> indices;
+    std::vector<scalar> squared_distances;
+    knnSearch(query, k, indices, squared_distances);
+    return indices;
+}
+
+template<typename Point_t>
+void KDTree<Point_t>::knnSearch(const Point_t &query,
+                                size_t k,
+                                std::vector<size_t> &indices,
+                                std::vector<scalar> &squaredDistances) const
+{
+    indices.clear();
+    squaredDistances.clear();
+
+    if (empty() || k == 0) return;
+
+    k = std::min(k, size());
+
+    coordinates point = toCoordinates(query);
+    coordinates offsets;
+    scalar distance = rootDistance(point, offsets);
+
+    internal::KDTreeKnnHeap<scalar> heap(k);
+    knnNode(0, 0, size(), point, offsets, distance, heap);
+
+    auto &neighbours = heap.sorted();
+    indices.reserve(neighbours.size());
+    squaredDistances.reserve(neighbours.size());
+    for (const auto &neighbour : neighbours) {
+        indices.push_back(mIndices[neighbour.second]);
+        squaredDistances.push_back(neighbour.first);
+    }
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::knnSearch(const std::vector<Point_t> &queries,
+                                size_t k) const -> std::vector<std::vector<size_t>>
+{
+    return batch(queries, [this, k](const Point_t &query) {
+        return knnSearch(query, k);
+    });
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::radiusSearch(const Point_t &query,
+                                   scalar radius) const -> std::vector<size_t>
+{
+    std::vector<size_t> indices;
+
+    if (empty() || radius < 0) return indices;
+
+    coordinates point = toCoordinates(query);
+    coordinates offsets;
+    scalar distance = rootDistance(point, offsets);
+
+    radiusNode(0, 0, size(), point, offsets, distance, radius * radius, indices, nullptr);
+
+    return indices;
+}
+
+template<typename Point_t>
+void KDTree<Point_t>::radiusSearch(const Point_t &query,
+                                   scalar radius,
+                                   std::vector<size_t> &indices,
+                                   std::vector<scalar> &squaredDistances) const
+{
+    indices.clear();
+    squaredDistances.clear();
+
+    if (empty() || radius < 0) return;
+
+    coordinates point = toCoordinates(query);
+    coordinates offsets;
+    scalar distance = rootDistance(point, offsets);
+
+    radiusNode(0, 0, size(), point, offsets, distance, radius * radius, indices, &squaredDistances);
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::radiusSearch(const std::vector<Point_t> &queries,
+                                   scalar radius) const -> std::vector<std::vector<size_t>>
+{
+    return batch(queries, [this, radius](const Point_t &query) {
+        return radiusSearch(query, radius);
+    });
+}
+
+template<typename Point_t>
+auto KDTree<Point_t>::rangeSearch(coordinates min, coordinates max) const -> std::vector<size_t>
+{
+    std::vector<size_t> indices;
+
+    if (empty()) return indices;
+
+    for (size_t d = 0; d < dimensions; d++) {
+        if (min[d] > max[d]) std::swap(min[d], max[d]);
+    }
+
+    rangeNode(0, 0, size(), min, max, indices);
+
+    return indices;
+}
+
+template<typename Point_t>
+template<typename Point_t2>
+auto KDTree<Point_t>::windowSearch(const Window<Point_t2> &window) const -> std::vector<size_t>
+{
+    static_assert(dimensions == 2, "Window search requires a 2D tree. Use boxSearch");
+
+    coordinates min{static_cast<scalar>(window.pt1.x), static_cast<scalar>(window.pt1.y)};
+    coordinates max{static_cast<scalar>(window.pt2.x), static_cast<scalar>(window.pt2.y)};
+
+    return rangeSearch(min, max);
+}
+
+template<typename Point_t>
+template<typename Point_t2>
+auto KDTree<Point_t>::windowSearch(const std::vector<Window<Point_t2>> &windows) const -> std::vector<std::vector<size_t>>
+{
+    return batch(windows, [this](const Window<Point_t2> &window) {
+        return windowSearch(window);
+    });
+}
+
+template<typename Point_t>
+template<typename Point3_t>
+auto KDTree<Point_t>::boxSearch(const BoundingBox<Point3_t> &box) const -> std::vector<size_t>
+{
+    static_assert(dimensions == 3, "Box search requires a 3D tree. Use windowSearch");
+
+    coordinates min{static_cast<scalar>(box.pt1.x), static_cast<scalar>(box.pt1.y), static_cast<scalar>(box.pt1.z)};
+    coordinates max{static_cast<scalar>(box.pt2.x), static_cast<scalar>(box.pt2.y), static_cast<scalar>(box.pt2.z)};
+
+    return rangeSearch(min, max);
+}
+
+template<typename Point_t>
+template<typename Point3_t>
+auto KDTree<Point_t>::boxSearch(const std::vector<BoundingBox<Point3_t>> &boxes) const -> std::vector<std::vector<size_t>>
+{
+    return batch(boxes, [this](const BoundingBox<Point3_t> &box) {
+        return boxSearch(box);
+    });
+}
+
+template<typename Point_t>
+template<typename Query, typename Search>
+auto KDTree<Point_t>::batch(const std::vector<Query> &queries, Search search) const -> std::vector<std::vector<size_t>>
+{
+    std::vector<std::vector<size_t>> results(queries.size());
+
+    size_t blocks = (queries.size() + internal::kdtree_query_block_size - 1) / internal::kdtree_query_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * internal::kdtree_query_block_size;
+        size_t end = std::min(ini + internal::kdtree_query_block_size, queries.size());
+        for (size_t i = ini; i < end; i++) {
+            results[i] = search(queries[i]);
+        }
+    });
+
+    return results;
+}
+
+/*! \} */ // end of geometry_algorithms
+
+/*! \} */ // end of geometry
+
+} // End namespace tl
@@ -0,0 +1,259 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "tidop/core/exception.h"
+#include "tidop/geometry/entities/polygon.h"
+#include "tidop/geometry/algorithms/prepared_polygon.h"
+
+namespace tl
+{
+
+/*! \addtogroup geometry
+ *  \{
+ */
+
+/*! \addtogroup geometry_algorithms
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+struct PolylabelCell
+{
+    double x;
+    double y;
+    /// Half of the cell side
+    double half;
+    /// Signed distance from the centre to the polygon
+    double distance;
+    /// Upper bound of the distance inside the cell
+    double max;
+
+    PolylabelCell(double x, double y, double half, double distance)
+      : x(x), y(y), half(half), distance(distance),
+        max(distance + half * std::sqrt(2.))
+    {
+    }
+
+    bool operator<(const PolylabelCell &cell) const
+    {
+        return max < cell.max;
+    }
+};
+
+template<typename Point_t>
+auto polylabel_centroid(const Polygon<Point_t> &polygon) -> std::pair<double, double>
+{
+    double area = 0.;
+    double x = 0.;
+    double y = 0.;
+
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        double ax = static_cast<double>(polygon[i].x);
+        double ay = static_cast<double>(polygon[i].y);
+        double bx = static_cast<double>(polygon[j].x);
+        double by = static_cast<double>(polygon[j].y);
+        double f = ax * by - bx * ay;
+        x += (ax + bx) * f;
+        y += (ay + by) * f;
+        area += f * 3.;
+    }
+
+    if (area == 0.)
+        return std::make_pair(static_cast<double>(polygon[0].x), static_cast<double>(polygon[0].y));
+
+    return std::make_pair(x / area, y / area);
+}
+
+template<typename Point_t>
+auto polylabel(const PreparedPolygon<Point_t> &polygon,
+               const std::pair<double, double> &initialGuess,
+               double precision,
+               double *distance) -> Point_t
+{
+    const auto &window = polygon.window();
+    double min_x = static_cast<double>(std::min(window.pt1.x, window.pt2.x));
+    double min_y = static_cast<double>(std::min(window.pt1.y, window.pt2.y));
+    double max_x = static_cast<double>(std::max(window.pt1.x, window.pt2.x));
+    double max_y = static_cast<double>(std::max(window.pt1.y, window.pt2.y));
+
+    double width = max_x - min_x;
+    double height = max_y - min_y;
+
+    if (std::min(width, height) <= 0.) {
+        if (distance) *distance = 0.;
+        return Point_t(window.pt1.x, window.pt1.y);
+    }
+
+    /* A single cell covering the window. Seeding with the short side
+       would create (long side / short side) cells for thin polygons */
+    double cell_size = std::max(width, height);
+    double half = cell_size / 2.;
+
+    std::priority_queue<PolylabelCell> queue;
+    for (double x = min_x; x < max_x; x += cell_size) {
+        for (double y = min_y; y < max_y; y += cell_size) {
+            queue.emplace(x + half, y + half, half, polygon.signedDistance(x + half, y + half));
+        }
+    }
+
+    /* Initial solutions: the guess (centroid of the polygon) and the centre of the window */
+    PolylabelCell best(initialGuess.first, initialGuess.second, 0.,
+                       polygon.signedDistance(initialGuess.first, initialGuess.second));
+
+    PolylabelCell center_cell(min_x + width / 2., min_y + height / 2., 0.,
+                              polygon.signedDistance(min_x + width / 2., min_y + height / 2.));
+    if (center_cell.distance > best.distance) best = center_cell;
+
+    while (!queue.empty()) {
+
+        PolylabelCell cell = queue.top();
+        queue.pop();
+
+        if (cell.distance > best.distance) best = cell;
+
+        /* The cell can't contain a better solution */
+        if (cell.max - best.distance <= precision) continue;
+
+        double child_half = cell.half / 2.;
+        queue.emplace(cell.x - child_half, cell.y - child_half, child_half, polygon.signedDistance(cell.x - child_half, cell.y - child_half));
+        queue.emplace(cell.x + child_half, cell.y - child_half, child_half, polygon.signedDistance(cell.x + child_half, cell.y - child_half));
+        queue.emplace(cell.x - child_half, cell.y + child_half, child_half, polygon.signedDistance(cell.x - child_half, cell.y + child_half));
+        queue.emplace(cell.x + child_half, cell.y + child_half, child_half, polygon.signedDistance(cell.x + child_half, cell.y + child_half));
+    }
+
+    if (distance) *distance = best.distance;
+
+    Point_t pole;
+    pole.x = static_cast<typename Point_t::value_type>(best.x);
+    pole.y = static_cast<typename Point_t::value_type>(best.y);
+
+    return pole;
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Pole of inaccessibility of a polygon (polylabel)
+ *
+ * Inner point farthest from the boundary (outer ring and holes), usually
+ * the best anchor for a label. The window of the polygon is covered with
+ * square cells that are explored best first: each cell is queued with the
+ * upper bound of the distance that any point inside it can reach (distance
+ * of its centre plus half of its diagonal) and is split in four while that
+ * bound can improve the best distance found by more than the precision.
+ *
+ * The distances are computed with a PreparedPolygon, so each cell costs a
+ * point-in-polygon test and a nearest edge query.
+ *
+ * \param[in] polygon Prepared polygon
+ * \param[in] precision Tolerance of the distance of the solution
+ * \param[out] distance Distance from the solution to the boundary (optional)
+ * \return Pole of inaccessibility
+ * \exception Exception if the precision isn't positive
+ */
+template<typename Point_t>
+auto polylabel(const PreparedPolygon<Point_t> &polygon,
+               double precision = 1.,
+               double *distance = nullptr) -> Point_t
+{
+    Point_t pole;
+
+    try {
+
+        TL_ASSERT(precision > 0., "The precision must be greater than zero: {}", precision);
+
+        const auto &window = polygon.window();
+        auto center = std::make_pair(static_cast<double>(window.pt1.x) / 2. + static_cast<double>(window.pt2.x) / 2.,
+                                     static_cast<double>(window.pt1.y) / 2. + static_cast<double>(window.pt2.y) / 2.);
+
+        pole = internal::polylabel(polygon, center, precision, distance);
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return pole;
+}
+
+/*!
+ * \brief Pole of inaccessibility of a polygon (polylabel)
+ * \param[in] polygon Polygon
+ * \param[in] precision Tolerance of the distance of the solution
+ * \param[out] distance Distance from the solution to the boundary (optional)
+ * \return Pole of inaccessibility
+ * \exception Exception if the precision isn't positive
+ * \see polylabel(const PreparedPolygon<Point_t> &, double, double *)
+ */
+template<typename Point_t>
+auto polylabel(const Polygon<Point_t> &polygon,
+               double precision = 1.,
+               double *distance = nullptr) -> Point_t
+{
+    Point_t pole;
+
+    try {
+
+        TL_ASSERT(precision > 0., "The precision must be greater than zero: {}", precision);
+
+        if (polygon.size() == 0) {
+            if (distance) *distance = 0.;
+            return pole;
+        }
+
+        PreparedPolygon<Point_t> prepared(polygon);
+
+        pole = internal::polylabel(prepared, internal::polylabel_centroid(polygon), precision, distance);
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return pole;
+}
+
+
+/*! \} */ // end of geometry_algorithms
+
+/*! \} */ // end of geometry
+
+} // End namespace tl
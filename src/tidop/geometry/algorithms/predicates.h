@@ -0,0 +1,162 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace tl
+{
+
+/*! \addtogroup geometry
+ *  \{
+ */
+
+/*! \addtogroup geometry_algorithms
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+/* Error-free sum (Knuth) */
+inline void orientation_two_sum(double a, double b, double &sum, double &error)
+{
+    sum = a + b;
+    double b_virtual = sum - a;
+    double a_virtual = sum - b_virtual;
+    error = (a - a_virtual) + (b - b_virtual);
+}
+
+/* Exact sign of the orientation determinant with an expansion of the six products */
+inline int orientation_exact(double ax, double ay,
+                             double bx, double by,
+                             double cx, double cy)
+{
+    /* (a - c) x (b - c) = ax*by - ax*cy - cx*by - ay*bx + ay*cx + cy*bx */
+    const double factors[6][3] = {{ax, by, 1.}, {ax, cy, -1.}, {cx, by, -1.},
+                                  {ay, bx, -1.}, {ay, cx, 1.}, {cy, bx, 1.}};
+
+    std::array<double, 12> expansion{};
+    size_t size = 0;
+
+    auto grow = [&](double value) {
+        double q = value;
+        for (size_t i = 0; i < size; i++) {
+            double sum;
+            double error;
+            orientation_two_sum(q, expansion[i], sum, error);
+            expansion[i] = error;
+            q = sum;
+        }
+        expansion[size++] = q;
+    };
+
+    for (const auto &factor : factors) {
+        double product = factor[0] * factor[1];
+        double error = std::fma(factor[0], factor[1], -product);
+        grow(factor[2] * product);
+        grow(factor[2] * error);
+    }
+
+    /* The most significant non zero component gives the sign */
+    for (size_t i = size; i > 0; i--) {
+        if (expansion[i - 1] > 0.) return 1;
+        if (expansion[i - 1] < 0.) return -1;
+    }
+
+    return 0;
+}
+
+/* Sign of the orientation of c with respect to ab (1 left, -1 right, 0 collinear).
+   Floating point filter with an exact fallback (Shewchuk) */
+inline int orientation(double ax, double ay,
+                       double bx, double by,
+                       double cx, double cy)
+{
+    double det_left = (ax - cx) * (by - cy);
+    double det_right = (ay - cy) * (bx - cx);
+    double det = det_left - det_right;
+    double det_sum;
+
+    if (det_left > 0.) {
+        if (det_right <= 0.) return det > 0. ? 1 : (det < 0. ? -1 : 0);
+        det_sum = det_left + det_right;
+    } else if (det_left < 0.) {
+        if (det_right >= 0.) return det > 0. ? 1 : (det < 0. ? -1 : 0);
+        det_sum = -det_left - det_right;
+    } else {
+        return det > 0. ? 1 : (det < 0. ? -1 : 0);
+    }
+
+    constexpr double epsilon = std::numeric_limits<double>::epsilon() / 2.;
+    constexpr double error_bound = (3. + 16. * epsilon) * epsilon;
+
+    if (det > error_bound * det_sum) return 1;
+    if (-det > error_bound * det_sum) return -1;
+
+    return orientation_exact(ax, ay, bx, by, cx, cy);
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Orientation of a point with respect to a line
+ *
+ * Exact sign of the cross product (pt2 - pt1) x (pt3 - pt1). The floating
+ * point result is only recomputed with exact arithmetic when it is too close
+ * to zero to trust its sign, so the predicate costs the same as the plain
+ * cross product except for (nearly) collinear points.
+ *
+ * \param[in] pt1 First point of the line
+ * \param[in] pt2 Second point of the line
+ * \param[in] pt3 Point
+ * \return 1 if pt3 is to the left of pt1-pt2 (counterclockwise turn), -1 if it
+ * is to the right (clockwise turn) and 0 if the three points are collinear
+ */
+template<typename Point_t>
+auto orientation(const Point_t &pt1, const Point_t &pt2, const Point_t &pt3) -> int
+{
+    return internal::orientation(static_cast<double>(pt1.x), static_cast<double>(pt1.y),
+                                 static_cast<double>(pt2.x), static_cast<double>(pt2.y),
+                                 static_cast<double>(pt3.x), static_cast<double>(pt3.y));
+}
+
+
+/*! \} */ // end of geometry_algorithms
+
+/*! \} */ // end of geometry
+
+} // End namespace tl
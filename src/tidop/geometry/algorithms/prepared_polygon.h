@@ -0,0 +1,472 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/geometry/entities/polygon.h"
+#include "tidop/geometry/entities/window.h"
+#include "tidop/geometry/algorithms/predicates.h"
+#include "tidop/geometry/algorithms/rtree.h"
+
+namespace tl
+{
+
+/*! \addtogroup geometry
+ *  \{
+ */
+
+/*! \addtogroup geometry_algorithms
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+/* Points per parallel task in the batch point-in-polygon test */
+constexpr size_t prepared_polygon_block_size = 4096;
+
+/* Maximum number of horizontal bands of the edge index */
+constexpr size_t prepared_polygon_max_bands = 1 << 16;
+
+/* Maximum number of edge copies in the bands per edge */
+constexpr size_t prepared_polygon_max_band_copies = 8;
+
+struct PreparedPolygonEdge
+{
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+};
+
+/* Number of bands of the edge index. One band per edge, reduced so that the
+   edges copied in every band they span are at most
+   prepared_polygon_max_band_copies times the number of edges. An edge is
+   copied in (span * bands / height + 2) bands at most */
+inline auto prepared_polygon_band_count(size_t edges, double height, double span) -> size_t
+{
+    if (edges == 0 || !(height > 0.)) return 1;
+
+    size_t bands = std::min(edges, prepared_polygon_max_bands);
+
+    if (span > 0.) {
+        double max_bands = static_cast<double>((prepared_polygon_max_band_copies - 2) * edges) * height / span;
+        if (max_bands < static_cast<double>(bands))
+            bands = std::max(static_cast<size_t>(max_bands), static_cast<size_t>(1));
+    }
+
+    return bands;
+}
+
+inline auto prepared_polygon_squared_distance(const PreparedPolygonEdge &edge, double x, double y) -> double
+{
+    double dx = edge.x1 - edge.x0;
+    double dy = edge.y1 - edge.y0;
+    double length = dx * dx + dy * dy;
+    double t = length > 0. ? ((x - edge.x0) * dx + (y - edge.y0) * dy) / length : 0.;
+    t = std::max(0., std::min(1., t));
+    double ex = edge.x0 + t * dx - x;
+    double ey = edge.y0 + t * dy - y;
+    return ex * ex + ey * ey;
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Polygon prepared for repeated point-in-polygon tests
+ *
+ * The window of the polygon is computed once and the edges (outer ring and
+ * holes) are distributed in horizontal bands, so a test only visits the
+ * edges that cross the band of the point. Inside points are found with the
+ * winding number with exact orientation predicates. The rings are reoriented so that the holes cancel the
+ * outer ring, and the fill rule decides the inside of self-intersecting
+ * polygons: FillRule::even_odd (odd winding number, the rule of
+ * Polygon::isInner) or FillRule::non_zero.
+ *
+ * As Polygon::isInner, points on the boundary (vertices and edges) are
+ * inner points. Unlike Polygon::isInner, points strictly inside a hole are
+ * outside the polygon.
+ *
+ * The edges are also indexed in an RTree for the distance to the boundary.
+ *
+ * <h4>Example</h4>
+ * \code
+ * PreparedPolygon<Point<double>> prepared(polygon);
+ *
+ * std::vector<unsigned char> mask(x.size());
+ * prepared.isInner(x.data(), y.data(), x.size(), mask.data());
+ * \endcode
+ */
+template<typename Point_t>
+class PreparedPolygon
+{
+
+public:
+
+    using point_type = Point_t;
+    using scalar = typename Point_t::value_type;
+
+    enum class FillRule
+    {
+        even_odd,  /*!< Odd winding number */
+        non_zero   /*!< Non-zero winding number */
+    };
+
+public:
+
+    /*!
+     * \brief Constructor
+     * \param[in] polygon Polygon
+     * \param[in] fillRule Inside of self-intersecting polygons
+     */
+    explicit PreparedPolygon(const Polygon<Point_t> &polygon,
+                             FillRule fillRule = FillRule::even_odd);
+
+    ~PreparedPolygon() = default;
+
+    /*!
+     * \brief Window of the polygon
+     */
+    auto window() const -> const Window<Point_t> &;
+
+    /*!
+     * \brief Check if a point is inside the polygon
+     * \param[in] point Point
+     */
+    auto isInner(const Point_t &point) const -> bool;
+
+    /*!
+     * \brief Batch test over points stored as separate coordinate arrays
+     * 
+     * The points are processed in parallel.
+     * 
+     * \param[in] x X coordinates
+     * \param[in] y Y coordinates
+     * \param[in] size Number of points
+     * \param[out] inside 1 for the inner points and 0 for the rest
+     */
+    void isInner(const scalar *x,
+                 const scalar *y,
+                 size_t size,
+                 unsigned char *inside) const;
+
+    /*!
+     * \brief Batch test
+     * \param[in] points Points
+     * \return 1 for the inner points and 0 for the rest
+     */
+    auto isInner(const std::vector<Point_t> &points) const -> std::vector<unsigned char>;
+
+    /*!
+     * \brief Check if a point given by its coordinates is inside the polygon
+     */
+    auto isInner(double x, double y) const -> bool;
+
+    /*!
+     * \brief Distance from a point to the boundary (outer ring and holes)
+     */
+    auto distance(const Point_t &point) const -> double;
+
+    auto distance(double x, double y) const -> double;
+
+    /*!
+     * \brief Distance to the boundary, positive for inner points and negative outside
+     */
+    auto signedDistance(const Point_t &point) const -> double;
+
+    auto signedDistance(double x, double y) const -> double;
+
+private:
+
+    template<typename Ring>
+    void addRing(const Ring &ring, bool hole);
+
+    auto test(double x, double y) const -> bool;
+
+private:
+
+    Window<Point_t> mWindow;
+    FillRule mFillRule;
+    std::vector<internal::PreparedPolygonEdge> mEdges;
+    double mMinY;
+    double mBandScale;
+    /// Start of the edges of each band in mBandEdges. The last element is the total
+    std::vector<size_t> mBandOffsets;
+    /// Edges of each band, copied so that every band is contiguous
+    std::vector<internal::PreparedPolygonEdge> mBandEdges;
+    RTree<Point<double>> mEdgeIndex;
+
+};
+
+
+/* Implementation */
+
+template<typename Point_t>
+PreparedPolygon<Point_t>::PreparedPolygon(const Polygon<Point_t> &polygon,
+                                          FillRule fillRule)
+  : mWindow(polygon.window()),
+    mFillRule(fillRule),
+    mMinY(0.),
+    mBandScale(0.)
+{
+    addRing(polygon, false);
+    for (size_t i = 0; i < polygon.holes(); i++) {
+        addRing(polygon.hole(i), true);
+    }
+
+    if (mEdges.empty()) return;
+
+    mMinY = static_cast<double>(std::min(mWindow.pt1.y, mWindow.pt2.y));
+    double height = static_cast<double>(std::max(mWindow.pt1.y, mWindow.pt2.y)) - mMinY;
+
+    /* Summed vertical extent of the edges */
+    double span = 0.;
+    for (const auto &edge : mEdges) {
+        span += std::abs(edge.y1 - edge.y0);
+    }
+
+    size_t bands = internal::prepared_polygon_band_count(mEdges.size(), height, span);
+    mBandScale = height > 0. ? static_cast<double>(bands) / height : 0.;
+
+    auto band = [&](double y) -> size_t {
+        auto b = static_cast<size_t>((y - mMinY) * mBandScale);
+        return std::min(b, bands - 1);
+    };
+
+    /* Counting pass and fill pass */
+    std::vector<size_t> counts(bands + 1, 0);
+    for (const auto &edge : mEdges) {
+        size_t first = band(std::min(edge.y0, edge.y1));
+        size_t last = band(std::max(edge.y0, edge.y1));
+        for (size_t b = first; b <= last; b++) counts[b + 1]++;
+    }
+
+    for (size_t b = 0; b < bands; b++) {
+        counts[b + 1] += counts[b];
+    }
+
+    mBandOffsets = counts;
+    mBandEdges.resize(mBandOffsets.back());
+
+    for (const auto &edge : mEdges) {
+        size_t first = band(std::min(edge.y0, edge.y1));
+        size_t last = band(std::max(edge.y0, edge.y1));
+        for (size_t b = first; b <= last; b++) {
+            mBandEdges[counts[b]++] = edge;
+        }
+    }
+
+    std::vector<Window<Point<double>>> edge_windows;
+    edge_windows.reserve(mEdges.size());
+    for (const auto &edge : mEdges) {
+        edge_windows.emplace_back(Point<double>(edge.x0, edge.y0), Point<double>(edge.x1, edge.y1));
+    }
+    mEdgeIndex.build(edge_windows);
+}
+
+template<typename Point_t>
+template<typename Ring>
+void PreparedPolygon<Point_t>::addRing(const Ring &ring, bool hole)
+{
+    size_t size = ring.size();
+    if (size < 2) return;
+
+    /* Outer ring counterclockwise and holes clockwise */
+    double signed_area = 0.;
+    for (size_t i = 0, j = size - 1; i < size; j = i++) {
+        signed_area += static_cast<double>(ring[j].x) * static_cast<double>(ring[i].y) -
+                       static_cast<double>(ring[i].x) * static_cast<double>(ring[j].y);
+    }
+
+    bool reverse = hole ? signed_area > 0. : signed_area < 0.;
+
+    for (size_t i = 0, j = size - 1; i < size; j = i++) {
+        internal::PreparedPolygonEdge edge{static_cast<double>(ring[j].x), static_cast<double>(ring[j].y),
+                                           static_cast<double>(ring[i].x), static_cast<double>(ring[i].y)};
+        if (reverse) {
+            std::swap(edge.x0, edge.x1);
+            std::swap(edge.y0, edge.y1);
+        }
+        mEdges.push_back(edge);
+    }
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::window() const -> const Window<Point_t> &
+{
+    return mWindow;
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::test(double x, double y) const -> bool
+{
+    size_t bands = mBandOffsets.size() - 1;
+    size_t band = std::min(static_cast<size_t>((y - mMinY) * mBandScale), bands - 1);
+
+    int winding_number = 0;
+
+    for (size_t i = mBandOffsets[band]; i < mBandOffsets[band + 1]; i++) {
+
+        const auto &edge = mBandEdges[i];
+
+        bool y_in_edge = y >= std::min(edge.y0, edge.y1) && y <= std::max(edge.y0, edge.y1);
+        if (!y_in_edge) continue;
+
+        /* 1 if the point is left of the edge, -1 if it is right and 0 if it is collinear */
+        int side = internal::orientation(edge.x0, edge.y0, edge.x1, edge.y1, x, y);
+
+        /* Point on the edge */
+        if (side == 0 && x >= std::min(edge.x0, edge.x1) && x <= std::max(edge.x0, edge.x1))
+            return true;
+
+        if (edge.y0 <= y) {
+            if (edge.y1 > y && side > 0) winding_number++;
+        } else {
+            if (edge.y1 <= y && side < 0) winding_number--;
+        }
+    }
+
+    return mFillRule == FillRule::even_odd ? (winding_number % 2 != 0) : (winding_number != 0);
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::isInner(const Point_t &point) const -> bool
+{
+    if (mBandOffsets.empty() || !mWindow.containsPoint(point)) return false;
+
+    return test(static_cast<double>(point.x), static_cast<double>(point.y));
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::isInner(double x, double y) const -> bool
+{
+    if (mBandOffsets.empty() ||
+        x < static_cast<double>(std::min(mWindow.pt1.x, mWindow.pt2.x)) ||
+        x > static_cast<double>(std::max(mWindow.pt1.x, mWindow.pt2.x)) ||
+        y < static_cast<double>(std::min(mWindow.pt1.y, mWindow.pt2.y)) ||
+        y > static_cast<double>(std::max(mWindow.pt1.y, mWindow.pt2.y)))
+        return false;
+
+    return test(x, y);
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::distance(const Point_t &point) const -> double
+{
+    return distance(static_cast<double>(point.x), static_cast<double>(point.y));
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::distance(double x, double y) const -> double
+{
+    if (mEdges.empty()) return std::numeric_limits<double>::max();
+
+    auto squared_distance = [this, x, y](size_t edge) {
+        return internal::prepared_polygon_squared_distance(mEdges[edge], x, y);
+    };
+
+    auto nearest = mEdgeIndex.nearest(Point<double>(x, y), 1, squared_distance);
+
+    return std::sqrt(squared_distance(nearest.front()));
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::signedDistance(const Point_t &point) const -> double
+{
+    return signedDistance(static_cast<double>(point.x), static_cast<double>(point.y));
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::signedDistance(double x, double y) const -> double
+{
+    double boundary_distance = distance(x, y);
+    return isInner(x, y) ? boundary_distance : -boundary_distance;
+}
+
+template<typename Point_t>
+void PreparedPolygon<Point_t>::isInner(const scalar *x,
+                                       const scalar *y,
+                                       size_t size,
+                                       unsigned char *inside) const
+{
+    if (mBandOffsets.empty()) {
+        std::fill(inside, inside + size, static_cast<unsigned char>(0));
+        return;
+    }
+
+    double min_x = static_cast<double>(std::min(mWindow.pt1.x, mWindow.pt2.x));
+    double max_x = static_cast<double>(std::max(mWindow.pt1.x, mWindow.pt2.x));
+    double min_y = static_cast<double>(std::min(mWindow.pt1.y, mWindow.pt2.y));
+    double max_y = static_cast<double>(std::max(mWindow.pt1.y, mWindow.pt2.y));
+
+    size_t blocks = (size + internal::prepared_polygon_block_size - 1) / internal::prepared_polygon_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * internal::prepared_polygon_block_size;
+        size_t end = std::min(ini + internal::prepared_polygon_block_size, size);
+        for (size_t i = ini; i < end; i++) {
+            auto px = static_cast<double>(x[i]);
+            auto py = static_cast<double>(y[i]);
+            bool in_window = px >= min_x && px <= max_x && py >= min_y && py <= max_y;
+            inside[i] = in_window && test(px, py) ? 1 : 0;
+        }
+    });
+}
+
+template<typename Point_t>
+auto PreparedPolygon<Point_t>::isInner(const std::vector<Point_t> &points) const -> std::vector<unsigned char>
+{
+    std::vector<scalar> x(points.size());
+    std::vector<scalar> y(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+    }
+
+    std::vector<unsigned char> inside(points.size());
+    isInner(x.data(), y.data(), points.size(), inside.data());
+
+    return inside;
+}
+
+
+/*! \} */ // end of geometry_algorithms
+
+/*! \} */ // end of geometry
+
+} // End namespace tl
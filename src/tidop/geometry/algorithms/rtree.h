@@ -0,0 +1,1593 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+#include "tidop/core/exception.h"
+#include "tidop/core/path.h"
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/geometry/entities/point.h"
+#include "tidop/geometry/entities/window.h"
+#include "tidop/geometry/entities/bbox.h"
+
+namespace tl
+{
+
+/*! \addtogroup geometry
+ *  \{
+ */
+
+/*! \addtogroup geometry_algorithms
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+template<typename Point_t>
+struct RTreeTraits;
+
+template<typename T>
+struct RTreeTraits<Point<T>>
+{
+    static constexpr size_t dimensions = 2;
+    using box_type = Window<Point<T>>;
+
+    static void bounds(const box_type &box, T *min, T *max)
+    {
+        min[0] = std::min(box.pt1.x, box.pt2.x);
+        min[1] = std::min(box.pt1.y, box.pt2.y);
+        max[0] = std::max(box.pt1.x, box.pt2.x);
+        max[1] = std::max(box.pt1.y, box.pt2.y);
+    }
+
+    static void coordinates(const Point<T> &point, T *coordinates)
+    {
+        coordinates[0] = point.x;
+        coordinates[1] = point.y;
+    }
+
+    template<typename Entity_t>
+    static auto entityBox(const Entity_t &entity) -> box_type
+    {
+        return static_cast<box_type>(entity.window());
+    }
+};
+
+template<typename T>
+struct RTreeTraits<Point3<T>>
+{
+    static constexpr size_t dimensions = 3;
+    using box_type = BoundingBox<Point3<T>>;
+
+    static void bounds(const box_type &box, T *min, T *max)
+    {
+        min[0] = std::min(box.pt1.x, box.pt2.x);
+        min[1] = std::min(box.pt1.y, box.pt2.y);
+        min[2] = std::min(box.pt1.z, box.pt2.z);
+        max[0] = std::max(box.pt1.x, box.pt2.x);
+        max[1] = std::max(box.pt1.y, box.pt2.y);
+        max[2] = std::max(box.pt1.z, box.pt2.z);
+    }
+
+    static void coordinates(const Point3<T> &point, T *coordinates)
+    {
+        coordinates[0] = point.x;
+        coordinates[1] = point.y;
+        coordinates[2] = point.z;
+    }
+
+    template<typename Entity_t>
+    static auto entityBox(const Entity_t &entity) -> box_type
+    {
+        return static_cast<box_type>(entity.boundingBox());
+    }
+};
+
+/*
+ * Boxes are stored as 2*Dim scalars: minimum coordinates followed by
+ * maximum coordinates
+ */
+
+template<size_t Dim, typename T>
+inline auto rtree_intersects(const T *a, const T *b) -> bool
+{
+    for (size_t d = 0; d < Dim; d++) {
+        if (a[d] > b[Dim + d] || b[d] > a[Dim + d]) return false;
+    }
+    return true;
+}
+
+template<size_t Dim, typename T>
+inline auto rtree_contains(const T *outer, const T *inner) -> bool
+{
+    for (size_t d = 0; d < Dim; d++) {
+        if (inner[d] < outer[d] || inner[Dim + d] > outer[Dim + d]) return false;
+    }
+    return true;
+}
+
+template<size_t Dim, typename T>
+inline auto rtree_contains_point(const T *box, const T *point) -> bool
+{
+    for (size_t d = 0; d < Dim; d++) {
+        if (point[d] < box[d] || point[d] > box[Dim + d]) return false;
+    }
+    return true;
+}
+
+template<size_t Dim, typename T>
+inline auto rtree_squared_distance(const T *box, const T *point) -> double
+{
+    double distance = 0.;
+    for (size_t d = 0; d < Dim; d++) {
+        double diff = 0.;
+        if (point[d] < box[d]) diff = static_cast<double>(box[d]) - static_cast<double>(point[d]);
+        else if (point[d] > box[Dim + d]) diff = static_cast<double>(point[d]) - static_cast<double>(box[Dim + d]);
+        distance += diff * diff;
+    }
+    return distance;
+}
+
+template<size_t Dim, typename T>
+inline void rtree_reset(T *box)
+{
+    for (size_t d = 0; d < Dim; d++) {
+        box[d] = std::numeric_limits<T>::max();
+        box[Dim + d] = std::numeric_limits<T>::lowest();
+    }
+}
+
+template<size_t Dim, typename T>
+inline void rtree_extend(T *box, const T *other)
+{
+    for (size_t d = 0; d < Dim; d++) {
+        box[d] = std::min(box[d], other[d]);
+        box[Dim + d] = std::max(box[Dim + d], other[Dim + d]);
+    }
+}
+
+template<size_t Dim, typename T>
+inline auto rtree_area(const T *box) -> double
+{
+    double area = 1.;
+    for (size_t d = 0; d < Dim; d++) {
+        area *= static_cast<double>(box[Dim + d]) - static_cast<double>(box[d]);
+    }
+    return area;
+}
+
+template<size_t Dim, typename T>
+inline auto rtree_union_area(const T *a, const T *b) -> double
+{
+    double area = 1.;
+    for (size_t d = 0; d < Dim; d++) {
+        area *= static_cast<double>(std::max(a[Dim + d], b[Dim + d])) - 
+                static_cast<double>(std::min(a[d], b[d]));
+    }
+    return area;
+}
+
+/* Binary file layout of a packed R-tree */
+struct RTreeHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t dimensions;
+    uint32_t scalarSize;
+    uint64_t nodeCapacity;
+    uint64_t itemCount;
+    uint64_t levelCount;
+};
+
+constexpr uint32_t rtree_magic = 0x45525452; // "RTRE"
+constexpr uint32_t rtree_version = 1;
+
+/* Nodes per parallel task when the upper levels are built */
+constexpr size_t rtree_block_size = 1024;
+
+} // namespace internal
+
+/// \endcond
+
+
+template<typename Point_t>
+class DynamicRTree;
+
+
+/*!
+ * \brief Packed R-tree over windows (2D) or bounding boxes (3D)
+ *
+ * Static R-tree bulk loaded with the Sort-Tile-Recursive (STR) algorithm:
+ * the boxes are partitioned into slabs by the centre of the first
+ * coordinate, each slab is sorted (or recursively tiled in 3D) by the next
+ * coordinates and consecutive runs of nodeCapacity boxes form the leaves.
+ * The slabs are sorted in parallel and every level is built from the
+ * previous one, so millions of features are indexed in a few passes.
+ *
+ * The tree is stored in flat arrays, level by level from the items to the
+ * root, and the children of each node are found by position. The same
+ * layout is written by save(), so a file can be memory mapped and queried
+ * in place with view().
+ *
+ * Queries return the index of the boxes in the vector used to build the
+ * tree.
+ *
+ * <h4>Example</h4>
+ * \code
+ * std::vector<Polygon<Point<double>>> polygons = ...;
+ * auto index = RTree<Point<double>>::fromEntities(polygons);
+ * auto candidates = index.search(tile_window);
+ * \endcode
+ *
+ * \tparam Point_t Point<T> (Window index) or Point3<T> (BoundingBox index)
+ * \see DynamicRTree
+ */
+template<typename Point_t>
+class RTree
+{
+
+public:
+
+    using point_type = Point_t;
+    using scalar = typename Point_t::value_type;
+    using box_type = typename internal::RTreeTraits<Point_t>::box_type;
+
+    static constexpr size_t dimensions = internal::RTreeTraits<Point_t>::dimensions;
+
+public:
+
+    /*!
+     * \brief Default constructor. Empty tree
+     */
+    RTree();
+
+    /*!
+     * \brief Bulk loads the tree
+     * \param[in] boxes Windows or bounding boxes of the features
+     * \param[in] nodeCapacity Maximum number of children per node
+     */
+    explicit RTree(const std::vector<box_type> &boxes,
+                   size_t nodeCapacity = 16);
+
+    RTree(const RTree &rtree);
+    RTree(RTree &&rtree) TL_NOEXCEPT;
+
+    ~RTree() = default;
+
+    auto operator=(const RTree &rtree) -> RTree &;
+    auto operator=(RTree &&rtree) TL_NOEXCEPT -> RTree &;
+
+    /*!
+     * \brief Bulk loads the tree, replacing the previous content
+     * \param[in] boxes Windows or bounding boxes of the features
+     * \param[in] nodeCapacity Maximum number of children per node
+     */
+    void build(const std::vector<box_type> &boxes,
+               size_t nodeCapacity = 16);
+
+    /*!
+     * \brief Index of a container of entities
+     * Uses window() of 2D entities and boundingBox() of 3D entities
+     */
+    template<typename Container>
+    static auto fromEntities(const Container &entities,
+                             size_t nodeCapacity = 16) -> RTree;
+
+    /*!
+     * \brief Number of indexed boxes
+     */
+    auto size() const -> size_t;
+
+    auto empty() const -> bool;
+
+    auto nodeCapacity() const -> size_t;
+
+    /*!
+     * \brief Boxes that intersect the query box
+     */
+    auto search(const box_type &box) const -> std::vector<size_t>;
+
+    /*!
+     * \brief Boxes completely inside the query box
+     */
+    auto searchWithin(const box_type &box) const -> std::vector<size_t>;
+
+    /*!
+     * \brief Boxes that contain a point
+     */
+    auto searchContaining(const Point_t &point) const -> std::vector<size_t>;
+
+    /*!
+     * \brief k nearest boxes to a point, sorted by distance
+     * The distance to a box that contains the point is zero
+     */
+    auto nearest(const Point_t &point,
+                 size_t k = 1) const -> std::vector<size_t>;
+
+    /*!
+     * \brief k nearest features with an exact distance, sorted by distance
+     *
+     * The boxes are used as lower bounds and the exact distance is only
+     * evaluated for the features whose box may be closer than the k-th
+     * nearest feature.
+     *
+     * \param[in] point Query point
+     * \param[in] k Number of features
+     * \param[in] squaredDistance Function with the squared distance from the point
+     * to a feature, given its index. It can't be less than the squared distance
+     * to the box of the feature
+     */
+    template<typename Distance>
+    auto nearest(const Point_t &point,
+                 size_t k,
+                 Distance squaredDistance) const -> std::vector<size_t>;
+
+    /*!
+     * \brief Writes the tree in binary format
+     */
+    void write(std::ostream &stream) const;
+
+    /*!
+     * \brief Saves the tree to a binary file
+     */
+    void save(const Path &file) const;
+
+    /*!
+     * \brief Loads a tree saved with save()
+     */
+    static auto load(const Path &file) -> RTree;
+
+    /*!
+     * \brief Tree over a buffer with the content of a file written by save()
+     *
+     * The buffer (usually a memory mapped file) is not copied and must
+     * outlive the tree. It must be aligned to 8 bytes.
+     */
+    static auto view(const void *data, size_t size) -> RTree;
+
+private:
+
+    void build(std::vector<scalar> &&bounds,
+               std::vector<uint64_t> &&ids,
+               size_t nodeCapacity);
+
+    void strOrder(std::vector<size_t>::iterator begin,
+                  std::vector<size_t>::iterator end,
+                  size_t dimension,
+                  const std::vector<scalar> &centers) const;
+
+    void updatePointers();
+
+    auto box(size_t position) const -> const scalar *;
+
+    auto levelStart(size_t level) const -> size_t;
+
+    template<typename NodeTest, typename ItemTest>
+    auto query(NodeTest nodeTest, ItemTest itemTest) const -> std::vector<size_t>;
+
+    template<typename Distance>
+    auto nearestSearch(const Point_t &point, size_t k,
+                       Distance squaredDistance, bool refine) const -> std::vector<size_t>;
+
+    friend class DynamicRTree<Point_t>;
+
+private:
+
+    size_t mNodeCapacity;
+    size_t mSize;
+    size_t mLevelCount;
+    /// End position of each level. Level 0 are the items, the last level is the root
+    std::vector<uint64_t> mLevelStorage;
+    std::vector<scalar> mBoxStorage;
+    std::vector<uint64_t> mIdStorage;
+    const uint64_t *mLevelEnd;
+    const scalar *mBoxes;
+    const uint64_t *mIds;
+    bool mOwner;
+
+};
+
+
+/*!
+ * \brief R-tree with incremental insertion and deletion
+ *
+ * Dynamic variant of RTree for indexes that are edited, with the classic
+ * insertion by least enlargement, quadratic node split and condensation of
+ * underflowing nodes on deletion. It has the same queries as RTree and
+ * pack() returns a packed copy.
+ *
+ * \tparam Point_t Point<T> (Window index) or Point3<T> (BoundingBox index)
+ */
+template<typename Point_t>
+class DynamicRTree
+{
+
+public:
+
+    using point_type = Point_t;
+    using scalar = typename Point_t::value_type;
+    using box_type = typename internal::RTreeTraits<Point_t>::box_type;
+
+    static constexpr size_t dimensions = internal::RTreeTraits<Point_t>::dimensions;
+
+public:
+
+    /*!
+     * \brief Constructor
+     * \param[in] maxEntries Maximum number of entries per node
+     */
+    explicit DynamicRTree(size_t maxEntries = 16);
+
+    ~DynamicRTree() = default;
+
+    /*!
+     * \brief Inserts a box
+     * \param[in] box Window or bounding box
+     * \param[in] id Value returned by the queries
+     */
+    void insert(const box_type &box, size_t id);
+
+    /*!
+     * \brief Removes a box
+     * \param[in] box Box used in the insertion
+     * \param[in] id Identifier used in the insertion
+     * \return false if the entry was not found
+     */
+    auto remove(const box_type &box, size_t id) -> bool;
+
+    void clear();
+
+    auto size() const -> size_t;
+
+    auto empty() const -> bool;
+
+    auto search(const box_type &box) const -> std::vector<size_t>;
+
+    auto searchWithin(const box_type &box) const -> std::vector<size_t>;
+
+    auto searchContaining(const Point_t &point) const -> std::vector<size_t>;
+
+    auto nearest(const Point_t &point,
+                 size_t k = 1) const -> std::vector<size_t>;
+
+    /*!
+     * \brief Packed (STR) copy of the tree
+     */
+    auto pack(size_t nodeCapacity = 16) const -> RTree<Point_t>;
+
+private:
+
+    using bounds_type = std::array<scalar, 2 * dimensions>;
+
+    struct Entry
+    {
+        bounds_type box;
+        /// Identifier in the leaves, child node in the internal nodes
+        size_t value;
+    };
+
+    struct Node
+    {
+        bool leaf{true};
+        std::vector<Entry> entries;
+    };
+
+    auto allocateNode(bool leaf) -> size_t;
+
+    auto nodeBox(size_t node) const -> bounds_type;
+
+    void insertEntry(const Entry &entry, size_t height);
+
+    auto split(size_t node) -> size_t;
+
+    auto findLeaf(size_t node, const bounds_type &box, size_t id, std::vector<size_t> &path) const -> bool;
+
+    template<typename NodeTest, typename ItemTest>
+    auto query(NodeTest nodeTest, ItemTest itemTest) const -> std::vector<size_t>;
+
+private:
+
+    size_t mMaxEntries;
+    size_t mMinEntries;
+    std::vector<Node> mNodes;
+    std::vector<size_t> mFreeNodes;
+    size_t mRoot;
+    /// Height of the root. The leaves are at height 0
+    size_t mHeight;
+    size_t mSize;
+
+};
+
+
+
+/* RTree implementation */
+
+template<typename Point_t>
+constexpr size_t RTree<Point_t>::dimensions;
+
+template<typename Point_t>
+RTree<Point_t>::RTree()
+  : mNodeCapacity(16),
+    mSize(0),
+    mLevelCount(0),
+    mLevelEnd(nullptr),
+    mBoxes(nullptr),
+    mIds(nullptr),
+    mOwner(true)
+{
+}
+
+template<typename Point_t>
+RTree<Point_t>::RTree(const std::vector<box_type> &boxes,
+                      size_t nodeCapacity)
+  : RTree()
+{
+    build(boxes, nodeCapacity);
+}
+
+template<typename Point_t>
+RTree<Point_t>::RTree(const RTree &rtree)
+  : mNodeCapacity(rtree.mNodeCapacity),
+    mSize(rtree.mSize),
+    mLevelCount(rtree.mLevelCount),
+    mLevelStorage(rtree.mLevelStorage),
+    mBoxStorage(rtree.mBoxStorage),
+    mIdStorage(rtree.mIdStorage),
+    mLevelEnd(rtree.mLevelEnd),
+    mBoxes(rtree.mBoxes),
+    mIds(rtree.mIds),
+    mOwner(rtree.mOwner)
+{
+    if (mOwner) updatePointers();
+}
+
+template<typename Point_t>
+RTree<Point_t>::RTree(RTree &&rtree) TL_NOEXCEPT
+  : mNodeCapacity(rtree.mNodeCapacity),
+    mSize(rtree.mSize),
+    mLevelCount(rtree.mLevelCount),
+    mLevelStorage(std::move(rtree.mLevelStorage)),
+    mBoxStorage(std::move(rtree.mBoxStorage)),
+    mIdStorage(std::move(rtree.mIdStorage)),
+    mLevelEnd(rtree.mLevelEnd),
+    mBoxes(rtree.mBoxes),
+    mIds(rtree.mIds),
+    mOwner(rtree.mOwner)
+{
+    if (mOwner) updatePointers();
+    rtree.mSize = 0;
+    rtree.mLevelCount = 0;
+    rtree.mOwner = true;
+    rtree.updatePointers();
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::operator=(const RTree &rtree) -> RTree &
+{
+    if (this != &rtree) {
+        mNodeCapacity = rtree.mNodeCapacity;
+        mSize = rtree.mSize;
+        mLevelCount = rtree.mLevelCount;
+        mLevelStorage = rtree.mLevelStorage;
+        mBoxStorage = rtree.mBoxStorage;
+        mIdStorage = rtree.mIdStorage;
+        mLevelEnd = rtree.mLevelEnd;
+        mBoxes = rtree.mBoxes;
+        mIds = rtree.mIds;
+        mOwner = rtree.mOwner;
+        if (mOwner) updatePointers();
+    }
+
+    return *this;
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::operator=(RTree &&rtree) TL_NOEXCEPT -> RTree &
+{
+    if (this != &rtree) {
+        mNodeCapacity = rtree.mNodeCapacity;
+        mSize = rtree.mSize;
+        mLevelCount = rtree.mLevelCount;
+        mLevelStorage = std::move(rtree.mLevelStorage);
+        mBoxStorage = std::move(rtree.mBoxStorage);
+        mIdStorage = std::move(rtree.mIdStorage);
+        mLevelEnd = rtree.mLevelEnd;
+        mBoxes = rtree.mBoxes;
+        mIds = rtree.mIds;
+        mOwner = rtree.mOwner;
+        if (mOwner) updatePointers();
+        rtree.mSize = 0;
+        rtree.mLevelCount = 0;
+        rtree.mOwner = true;
+        rtree.updatePointers();
+    }
+
+    return *this;
+}
+
+template<typename Point_t>
+void RTree<Point_t>::updatePointers()
+{
+    mLevelEnd = mLevelStorage.data();
+    mBoxes = mBoxStorage.data();
+    mIds = mIdStorage.data();
+}
+
+template<typename Point_t>
+void RTree<Point_t>::build(const std::vector<box_type> &boxes,
+                           size_t nodeCapacity)
+{
+    std::vector<scalar> bounds(boxes.size() * 2 * dimensions);
+    std::vector<uint64_t> ids(boxes.size());
+
+    parallel_for(0, (boxes.size() + internal::rtree_block_size - 1) / internal::rtree_block_size, [&](size_t block) {
+        size_t ini = block * internal::rtree_block_size;
+        size_t end = std::min(ini + internal::rtree_block_size, boxes.size());
+        for (size_t i = ini; i < end; i++) {
+            scalar *box = &bounds[i * 2 * dimensions];
+            internal::RTreeTraits<Point_t>::bounds(boxes[i], box, box + dimensions);
+            ids[i] = i;
+        }
+    });
+
+    build(std::move(bounds), std::move(ids), nodeCapacity);
+}
+
+template<typename Point_t>
+template<typename Container>
+auto RTree<Point_t>::fromEntities(const Container &entities,
+                                  size_t nodeCapacity) -> RTree
+{
+    std::vector<box_type> boxes;
+    boxes.reserve(entities.size());
+    for (const auto &entity : entities) {
+        boxes.push_back(internal::RTreeTraits<Point_t>::entityBox(entity));
+    }
+
+    return RTree(boxes, nodeCapacity);
+}
+
+template<typename Point_t>
+void RTree<Point_t>::build(std::vector<scalar> &&bounds,
+                           std::vector<uint64_t> &&ids,
+                           size_t nodeCapacity)
+{
+    TL_ASSERT(nodeCapacity >= 2, "Node capacity must be at least 2");
+
+    constexpr size_t stride = 2 * dimensions;
+
+    mOwner = true;
+    mNodeCapacity = nodeCapacity;
+    mSize = ids.size();
+    mLevelStorage.clear();
+    mBoxStorage.clear();
+    mIdStorage.clear();
+
+    if (mSize == 0) {
+        mLevelCount = 0;
+        updatePointers();
+        return;
+    }
+
+    /* Level sizes */
+    size_t total = mSize;
+    mLevelStorage.push_back(mSize);
+    for (size_t count = mSize; count > 1 || mLevelStorage.size() == 1;) {
+        count = (count + nodeCapacity - 1) / nodeCapacity;
+        total += count;
+        mLevelStorage.push_back(total);
+    }
+    mLevelCount = mLevelStorage.size();
+
+    /* STR order of the items */
+    std::vector<scalar> centers(mSize * dimensions);
+    for (size_t i = 0; i < mSize; i++) {
+        for (size_t d = 0; d < dimensions; d++) {
+            centers[i * dimensions + d] = bounds[i * stride + d] / 2 + bounds[i * stride + dimensions + d] / 2;
+        }
+    }
+
+    std::vector<size_t> order(mSize);
+    std::iota(order.begin(), order.end(), size_t{0});
+    strOrder(order.begin(), order.end(), 0, centers);
+
+    mBoxStorage.resize(total * stride);
+    mIdStorage.resize(mSize);
+
+    for (size_t i = 0; i < mSize; i++) {
+        std::copy(&bounds[order[i] * stride], &bounds[order[i] * stride] + stride, &mBoxStorage[i * stride]);
+        mIdStorage[i] = ids[order[i]];
+    }
+
+    /* Upper levels */
+    for (size_t level = 1; level < mLevelCount; level++) {
+
+        size_t child_start = level == 1 ? 0 : static_cast<size_t>(mLevelStorage[level - 2]);
+        size_t child_end = static_cast<size_t>(mLevelStorage[level - 1]);
+        size_t start = child_end;
+        size_t count = static_cast<size_t>(mLevelStorage[level]) - start;
+        size_t blocks = (count + internal::rtree_block_size - 1) / internal::rtree_block_size;
+
+        parallel_for(0, blocks, [&](size_t block) {
+            size_t ini = block * internal::rtree_block_size;
+            size_t end = std::min(ini + internal::rtree_block_size, count);
+            for (size_t node = ini; node < end; node++) {
+                scalar *box = &mBoxStorage[(start + node) * stride];
+                internal::rtree_reset<dimensions>(box);
+                size_t first = child_start + node * nodeCapacity;
+                size_t last = std::min(first + nodeCapacity, child_end);
+                for (size_t child = first; child < last; child++) {
+                    internal::rtree_extend<dimensions>(box, &mBoxStorage[child * stride]);
+                }
+            }
+        });
+    }
+
+    updatePointers();
+}
+
+template<typename Point_t>
+void RTree<Point_t>::strOrder(std::vector<size_t>::iterator begin,
+                              std::vector<size_t>::iterator end,
+                              size_t dimension,
+                              const std::vector<scalar> &centers) const
+{
+    auto compare = [&centers, dimension](size_t a, size_t b) {
+        return centers[a * dimensions + dimension] < centers[b * dimensions + dimension];
+    };
+
+    size_t count = static_cast<size_t>(end - begin);
+
+    if (dimension == dimensions - 1) {
+        std::sort(begin, end, compare);
+        return;
+    }
+
+    /* Slab size: runs of whole nodes so that the remaining dimensions are tiled evenly */
+    size_t nodes = (count + mNodeCapacity - 1) / mNodeCapacity;
+    auto slabs = static_cast<size_t>(std::ceil(std::pow(static_cast<double>(nodes), 1. / static_cast<double>(dimensions - dimension))));
+    size_t slab_size = mNodeCapacity * ((nodes + slabs - 1) / slabs);
+
+    /* Partition into slabs. Only the boundaries need to be in order */
+    std::vector<std::pair<size_t, size_t>> ranges{{0, count}};
+    for (size_t i = 0; i < ranges.size(); i++) {
+        size_t ini = ranges[i].first;
+        size_t fin = ranges[i].second;
+        size_t range_slabs = (fin - ini + slab_size - 1) / slab_size;
+        if (range_slabs < 2) continue;
+        size_t mid = ini + slab_size * (range_slabs / 2);
+        std::nth_element(begin + ini, begin + mid, begin + fin, compare);
+        ranges.emplace_back(ini, mid);
+        ranges.emplace_back(mid, fin);
+    }
+
+    size_t slab_count = (count + slab_size - 1) / slab_size;
+    auto order_slab = [&](size_t slab) {
+        size_t ini = slab * slab_size;
+        size_t fin = std::min(ini + slab_size, count);
+        strOrder(begin + ini, begin + fin, dimension + 1, centers);
+    };
+
+    if (dimension == 0) {
+        parallel_for(0, slab_count, order_slab);
+    } else {
+        for (size_t slab = 0; slab < slab_count; slab++) {
+            order_slab(slab);
+        }
+    }
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::size() const -> size_t
+{
+    return mSize;
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::empty() const -> bool
+{
+    return mSize == 0;
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::nodeCapacity() const -> size_t
+{
+    return mNodeCapacity;
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::box(size_t position) const -> const scalar *
+{
+    return mBoxes + position * 2 * dimensions;
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::levelStart(size_t level) const -> size_t
+{
+    return level == 0 ? 0 : static_cast<size_t>(mLevelEnd[level - 1]);
+}
+
+template<typename Point_t>
+template<typename NodeTest, typename ItemTest>
+auto RTree<Point_t>::query(NodeTest nodeTest, ItemTest itemTest) const -> std::vector<size_t>
+{
+    std::vector<size_t> result;
+
+    if (mSize == 0) return result;
+
+    size_t root = static_cast<size_t>(mLevelEnd[mLevelCount - 1]) - 1;
+    if (!nodeTest(box(root))) return result;
+
+    std::vector<std::pair<size_t, size_t>> stack{{root, mLevelCount - 1}};
+
+    while (!stack.empty()) {
+
+        size_t node = stack.back().first;
+        size_t level = stack.back().second;
+        stack.pop_back();
+
+        size_t child_level = level - 1;
+        size_t first = levelStart(child_level) + (node - levelStart(level)) * mNodeCapacity;
+        size_t last = std::min(first + mNodeCapacity, static_cast<size_t>(mLevelEnd[child_level]));
+
+        for (size_t child = first; child < last; child++) {
+            if (child_level == 0) {
+                if (itemTest(box(child))) result.push_back(static_cast<size_t>(mIds[child]));
+            } else if (nodeTest(box(child))) {
+                stack.emplace_back(child, child_level);
+            }
+        }
+    }
+
+    return result;
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::search(const box_type &box) const -> std::vector<size_t>
+{
+    std::array<scalar, 2 * dimensions> query_box;
+    internal::RTreeTraits<Point_t>::bounds(box, query_box.data(), query_box.data() + dimensions);
+
+    auto intersects = [&query_box](const scalar *node_box) {
+        return internal::rtree_intersects<dimensions>(node_box, query_box.data());
+    };
+
+    return query(intersects, intersects);
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::searchWithin(const box_type &box) const -> std::vector<size_t>
+{
+    std::array<scalar, 2 * dimensions> query_box;
+    internal::RTreeTraits<Point_t>::bounds(box, query_box.data(), query_box.data() + dimensions);
+
+    return query([&query_box](const scalar *node_box) {
+                     return internal::rtree_intersects<dimensions>(node_box, query_box.data());
+                 },
+                 [&query_box](const scalar *item_box) {
+                     return internal::rtree_contains<dimensions>(query_box.data(), item_box);
+                 });
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::searchContaining(const Point_t &point) const -> std::vector<size_t>
+{
+    std::array<scalar, dimensions> coordinates;
+    internal::RTreeTraits<Point_t>::coordinates(point, coordinates.data());
+
+    auto contains = [&coordinates](const scalar *node_box) {
+        return internal::rtree_contains_point<dimensions>(node_box, coordinates.data());
+    };
+
+    return query(contains, contains);
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::nearest(const Point_t &point,
+                             size_t k) const -> std::vector<size_t>
+{
+    return nearestSearch(point, k, [](size_t) { return 0.; }, false);
+}
+
+template<typename Point_t>
+template<typename Distance>
+auto RTree<Point_t>::nearest(const Point_t &point,
+                             size_t k,
+                             Distance squaredDistance) const -> std::vector<size_t>
+{
+    return nearestSearch(point, k, squaredDistance, true);
+}
+
+template<typename Point_t>
+template<typename Distance>
+auto RTree<Point_t>::nearestSearch(const Point_t &point, size_t k,
+                                   Distance squaredDistance, bool refine) const -> std::vector<size_t>
+{
+    std::vector<size_t> result;
+
+    if (mSize == 0 || k == 0) return result;
+
+    std::array<scalar, dimensions> coordinates;
+    internal::RTreeTraits<Point_t>::coordinates(point, coordinates.data());
+
+    /* Best-first search. Items and nodes share the queue, an item popped with
+       its exact distance is the next nearest. With refine, items are queued
+       first with the distance to their box and queued again with the exact one */
+    struct Candidate
+    {
+        double distance;
+        size_t position;
+        size_t level;
+        bool exact;
+        bool operator<(const Candidate &other) const { return distance > other.distance; }
+    };
+
+    std::priority_queue<Candidate> queue;
+    size_t root = static_cast<size_t>(mLevelEnd[mLevelCount - 1]) - 1;
+    queue.push({internal::rtree_squared_distance<dimensions>(box(root), coordinates.data()), root, mLevelCount - 1, false});
+
+    while (!queue.empty() && result.size() < k) {
+
+        Candidate candidate = queue.top();
+        queue.pop();
+
+        if (candidate.level == 0) {
+            if (candidate.exact) {
+                result.push_back(static_cast<size_t>(mIds[candidate.position]));
+            } else {
+                candidate.distance = static_cast<double>(squaredDistance(static_cast<size_t>(mIds[candidate.position])));
+                candidate.exact = true;
+                queue.push(candidate);
+            }
+            continue;
+        }
+
+        size_t child_level = candidate.level - 1;
+        size_t first = levelStart(child_level) + (candidate.position - levelStart(candidate.level)) * mNodeCapacity;
+        size_t last = std::min(first + mNodeCapacity, static_cast<size_t>(mLevelEnd[child_level]));
+
+        for (size_t child = first; child < last; child++) {
+            queue.push({internal::rtree_squared_distance<dimensions>(box(child), coordinates.data()),
+                        child, child_level, child_level == 0 && !refine});
+        }
+    }
+
+    return result;
+}
+
+template<typename Point_t>
+void RTree<Point_t>::write(std::ostream &stream) const
+{
+    internal::RTreeHeader header{};
+    header.magic = internal::rtree_magic;
+    header.version = internal::rtree_version;
+    header.dimensions = static_cast<uint32_t>(dimensions);
+    header.scalarSize = static_cast<uint32_t>(sizeof(scalar));
+    header.nodeCapacity = mNodeCapacity;
+    header.itemCount = mSize;
+    header.levelCount = mLevelCount;
+
+    size_t total = mLevelCount ? static_cast<size_t>(mLevelEnd[mLevelCount - 1]) : 0;
+
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char *>(mLevelEnd), static_cast<std::streamsize>(mLevelCount * sizeof(uint64_t)));
+    stream.write(reinterpret_cast<const char *>(mBoxes), static_cast<std::streamsize>(total * 2 * dimensions * sizeof(scalar)));
+    stream.write(reinterpret_cast<const char *>(mIds), static_cast<std::streamsize>(mSize * sizeof(uint64_t)));
+}
+
+template<typename Point_t>
+void RTree<Point_t>::save(const Path &file) const
+{
+    try {
+
+        std::ofstream stream(file.toString(), std::ios::binary | std::ios::trunc);
+        TL_ASSERT(stream.is_open(), "Can't open {}", file.toString());
+
+        write(stream);
+
+        TL_ASSERT(stream.good(), "Error writing {}", file.toString());
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::view(const void *data, size_t size) -> RTree
+{
+    RTree rtree;
+
+    try {
+
+        TL_ASSERT(data != nullptr && size >= sizeof(internal::RTreeHeader), "Invalid R-tree buffer");
+        TL_ASSERT(reinterpret_cast<uintptr_t>(data) % alignof(uint64_t) == 0, "R-tree buffer must be aligned to 8 bytes");
+
+        internal::RTreeHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        TL_ASSERT(header.magic == internal::rtree_magic, "Not an R-tree file");
+        TL_ASSERT(header.version == internal::rtree_version, "Unsupported R-tree version");
+        TL_ASSERT(header.dimensions == dimensions && header.scalarSize == sizeof(scalar), 
+                  "The R-tree file was written with a different point type");
+
+        TL_ASSERT(header.nodeCapacity >= 2, "Invalid R-tree node capacity");
+
+        /* Sizes are checked against the remaining bytes so that corrupt counts can't overflow */
+        const char *buffer = static_cast<const char *>(data) + sizeof(header);
+        size_t available = size - sizeof(header);
+
+        TL_ASSERT(header.levelCount <= available / sizeof(uint64_t), "Truncated R-tree buffer");
+        size_t level_count = static_cast<size_t>(header.levelCount);
+        const uint64_t *level_end = reinterpret_cast<const uint64_t *>(buffer);
+        available -= level_count * sizeof(uint64_t);
+
+        /* Level sizes of the packed layout: the items and then ceil(count / nodeCapacity) nodes up to the root */
+        TL_ASSERT(level_count == 0 ? header.itemCount == 0 : level_count >= 2 && level_end[0] == header.itemCount,
+                  "Invalid R-tree levels");
+        for (size_t level = 1; level < level_count; level++) {
+            uint64_t children = level_end[level - 1] - (level > 1 ? level_end[level - 2] : 0);
+            uint64_t nodes = children / header.nodeCapacity + (children % header.nodeCapacity != 0);
+            TL_ASSERT(level_end[level] > level_end[level - 1] &&
+                      level_end[level] - level_end[level - 1] == nodes &&
+                      (nodes == 1) == (level + 1 == level_count),
+                      "Invalid R-tree levels");
+        }
+
+        uint64_t total = level_count ? level_end[level_count - 1] : 0;
+        constexpr size_t box_size = 2 * dimensions * sizeof(scalar);
+        TL_ASSERT(total <= available / box_size, "Truncated R-tree buffer");
+        available -= static_cast<size_t>(total) * box_size;
+        TL_ASSERT(header.itemCount <= available / sizeof(uint64_t), "Truncated R-tree buffer");
+
+        rtree.mOwner = false;
+        rtree.mNodeCapacity = static_cast<size_t>(header.nodeCapacity);
+        rtree.mSize = static_cast<size_t>(header.itemCount);
+        rtree.mLevelCount = level_count;
+        rtree.mLevelEnd = level_end;
+        buffer += level_count * sizeof(uint64_t);
+        rtree.mBoxes = reinterpret_cast<const scalar *>(buffer);
+        buffer += static_cast<size_t>(total) * box_size;
+        rtree.mIds = reinterpret_cast<const uint64_t *>(buffer);
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return rtree;
+}
+
+template<typename Point_t>
+auto RTree<Point_t>::load(const Path &file) -> RTree
+{
+    RTree rtree;
+
+    try {
+
+        std::ifstream stream(file.toString(), std::ios::binary | std::ios::ate);
+        TL_ASSERT(stream.is_open(), "Can't open {}", file.toString());
+
+        auto size = static_cast<size_t>(stream.tellg());
+        stream.seekg(0);
+
+        std::vector<uint64_t> buffer((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        stream.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(size));
+        TL_ASSERT(stream.good(), "Error reading {}", file.toString());
+
+        RTree mapped = view(buffer.data(), size);
+
+        size_t total = mapped.mLevelCount ? static_cast<size_t>(mapped.mLevelEnd[mapped.mLevelCount - 1]) : 0;
+        rtree.mNodeCapacity = mapped.mNodeCapacity;
+        rtree.mSize = mapped.mSize;
+        rtree.mLevelCount = mapped.mLevelCount;
+        rtree.mLevelStorage.assign(mapped.mLevelEnd, mapped.mLevelEnd + mapped.mLevelCount);
+        rtree.mBoxStorage.assign(mapped.mBoxes, mapped.mBoxes + total * 2 * dimensions);
+        rtree.mIdStorage.assign(mapped.mIds, mapped.mIds + mapped.mSize);
+        rtree.updatePointers();
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return rtree;
+}
+
+
+
+/* DynamicRTree implementation */
+
+template<typename Point_t>
+constexpr size_t DynamicRTree<Point_t>::dimensions;
+
+template<typename Point_t>
+DynamicRTree<Point_t>::DynamicRTree(size_t maxEntries)
+  : mMaxEntries(maxEntries),
+    mMinEntries(std::max<size_t>(1, maxEntries * 2 / 5)),
+    mRoot(0),
+    mHeight(0),
+    mSize(0)
+{
+    TL_ASSERT(maxEntries >= 4, "The maximum number of entries must be at least 4");
+
+    clear();
+}
+
+template<typename Point_t>
+void DynamicRTree<Point_t>::clear()
+{
+    mNodes.clear();
+    mFreeNodes.clear();
+    mRoot = allocateNode(true);
+    mHeight = 0;
+    mSize = 0;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::size() const -> size_t
+{
+    return mSize;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::empty() const -> bool
+{
+    return mSize == 0;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::allocateNode(bool leaf) -> size_t
+{
+    size_t node;
+
+    if (mFreeNodes.empty()) {
+        node = mNodes.size();
+        mNodes.emplace_back();
+    } else {
+        node = mFreeNodes.back();
+        mFreeNodes.pop_back();
+    }
+
+    mNodes[node].leaf = leaf;
+    mNodes[node].entries.clear();
+    mNodes[node].entries.reserve(mMaxEntries + 1);
+
+    return node;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::nodeBox(size_t node) const -> bounds_type
+{
+    bounds_type box;
+    internal::rtree_reset<dimensions>(box.data());
+    for (const auto &entry : mNodes[node].entries) {
+        internal::rtree_extend<dimensions>(box.data(), entry.box.data());
+    }
+    return box;
+}
+
+template<typename Point_t>
+void DynamicRTree<Point_t>::insert(const box_type &box, size_t id)
+{
+    Entry entry;
+    internal::RTreeTraits<Point_t>::bounds(box, entry.box.data(), entry.box.data() + dimensions);
+    entry.value = id;
+
+    insertEntry(entry, 0);
+    mSize++;
+}
+
+template<typename Point_t>
+void DynamicRTree<Point_t>::insertEntry(const Entry &entry, size_t height)
+{
+    /* Choose the subtree that needs the least enlargement */
+    std::vector<size_t> path{mRoot};
+    size_t node = mRoot;
+
+    for (size_t level = mHeight; level > height; level--) {
+
+        const auto &entries = mNodes[node].entries;
+        size_t best = 0;
+        double best_enlargement = std::numeric_limits<double>::max();
+        double best_area = std::numeric_limits<double>::max();
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            double area = internal::rtree_area<dimensions>(entries[i].box.data());
+            double enlargement = internal::rtree_union_area<dimensions>(entries[i].box.data(), entry.box.data()) - area;
+            if (enlargement < best_enlargement || (enlargement == best_enlargement && area < best_area)) {
+                best = i;
+                best_enlargement = enlargement;
+                best_area = area;
+            }
+        }
+
+        node = entries[best].value;
+        path.push_back(node);
+    }
+
+    mNodes[node].entries.push_back(entry);
+
+    /* Split overflowing nodes and adjust the boxes up to the root */
+    size_t sibling = std::numeric_limits<size_t>::max();
+
+    for (size_t i = path.size(); i-- > 0;) {
+
+        node = path[i];
+
+        if (sibling != std::numeric_limits<size_t>::max()) {
+            mNodes[node].entries.push_back({nodeBox(sibling), sibling});
+            sibling = std::numeric_limits<size_t>::max();
+        }
+
+        if (mNodes[node].entries.size() > mMaxEntries)
+            sibling = split(node);
+
+        if (i > 0) {
+            for (auto &parent_entry : mNodes[path[i - 1]].entries) {
+                if (parent_entry.value == node) {
+                    parent_entry.box = nodeBox(node);
+                    break;
+                }
+            }
+        }
+    }
+
+    if (sibling != std::numeric_limits<size_t>::max()) {
+        size_t root = allocateNode(false);
+        mNodes[root].entries.push_back({nodeBox(mRoot), mRoot});
+        mNodes[root].entries.push_back({nodeBox(sibling), sibling});
+        mRoot = root;
+        mHeight++;
+    }
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::split(size_t node) -> size_t
+{
+    std::vector<Entry> entries = std::move(mNodes[node].entries);
+    size_t sibling = allocateNode(mNodes[node].leaf);
+    mNodes[node].entries.clear();
+
+    /* Quadratic split: seeds that waste the most area together */
+    size_t seed1 = 0;
+    size_t seed2 = 1;
+    double worst_waste = std::numeric_limits<double>::lowest();
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        for (size_t j = i + 1; j < entries.size(); j++) {
+            double waste = internal::rtree_union_area<dimensions>(entries[i].box.data(), entries[j].box.data()) -
+                           internal::rtree_area<dimensions>(entries[i].box.data()) -
+                           internal::rtree_area<dimensions>(entries[j].box.data());
+            if (waste > worst_waste) {
+                worst_waste = waste;
+                seed1 = i;
+                seed2 = j;
+            }
+        }
+    }
+
+    std::array<size_t, 2> groups{node, sibling};
+    std::array<bounds_type, 2> boxes{entries[seed1].box, entries[seed2].box};
+    mNodes[node].entries.push_back(entries[seed1]);
+    mNodes[sibling].entries.push_back(entries[seed2]);
+
+    std::vector<bool> assigned(entries.size(), false);
+    assigned[seed1] = true;
+    assigned[seed2] = true;
+    size_t remaining = entries.size() - 2;
+
+    while (remaining > 0) {
+
+        /* Fill a group that would stay under the minimum */
+        for (size_t g = 0; g < 2; g++) {
+            if (mNodes[groups[g]].entries.size() + remaining <= mMinEntries) {
+                for (size_t i = 0; i < entries.size(); i++) {
+                    if (!assigned[i]) {
+                        mNodes[groups[g]].entries.push_back(entries[i]);
+                        assigned[i] = true;
+                    }
+                }
+                remaining = 0;
+            }
+        }
+
+        if (remaining == 0) break;
+
+        /* Entry with the greatest preference for one group */
+        size_t next = 0;
+        double max_difference = -1.;
+        std::array<double, 2> next_enlargement{};
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (assigned[i]) continue;
+            std::array<double, 2> enlargement;
+            for (size_t g = 0; g < 2; g++) {
+                enlargement[g] = internal::rtree_union_area<dimensions>(boxes[g].data(), entries[i].box.data()) -
+                                 internal::rtree_area<dimensions>(boxes[g].data());
+            }
+            double difference = std::abs(enlargement[0] - enlargement[1]);
+            if (difference > max_difference) {
+                max_difference = difference;
+                next = i;
+                next_enlargement = enlargement;
+            }
+        }
+
+        size_t g;
+        if (next_enlargement[0] != next_enlargement[1]) {
+            g = next_enlargement[0] < next_enlargement[1] ? 0 : 1;
+        } else {
+            double area0 = internal::rtree_area<dimensions>(boxes[0].data());
+            double area1 = internal::rtree_area<dimensions>(boxes[1].data());
+            if (area0 != area1) g = area0 < area1 ? 0 : 1;
+            else g = mNodes[groups[0]].entries.size() <= mNodes[groups[1]].entries.size() ? 0 : 1;
+        }
+
+        mNodes[groups[g]].entries.push_back(entries[next]);
+        internal::rtree_extend<dimensions>(boxes[g].data(), entries[next].box.data());
+        assigned[next] = true;
+        remaining--;
+    }
+
+    return sibling;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::findLeaf(size_t node, 
+                                     const bounds_type &box, 
+                                     size_t id, 
+                                     std::vector<size_t> &path) const -> bool
+{
+    path.push_back(node);
+
+    for (const auto &entry : mNodes[node].entries) {
+        if (mNodes[node].leaf) {
+            if (entry.value == id && entry.box == box) return true;
+        } else if (internal::rtree_contains<dimensions>(entry.box.data(), box.data())) {
+            if (findLeaf(entry.value, box, id, path)) return true;
+        }
+    }
+
+    path.pop_back();
+
+    return false;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::remove(const box_type &box, size_t id) -> bool
+{
+    bounds_type bounds;
+    internal::RTreeTraits<Point_t>::bounds(box, bounds.data(), bounds.data() + dimensions);
+
+    std::vector<size_t> path;
+    if (!findLeaf(mRoot, bounds, id, path)) return false;
+
+    auto &leaf_entries = mNodes[path.back()].entries;
+    for (auto it = leaf_entries.begin(); it != leaf_entries.end(); ++it) {
+        if (it->value == id && it->box == bounds) {
+            leaf_entries.erase(it);
+            break;
+        }
+    }
+    mSize--;
+
+    /* Condense: underflowing nodes are removed and their entries reinserted */
+    std::vector<std::pair<Entry, size_t>> orphans;
+
+    for (size_t i = path.size() - 1; i > 0; i--) {
+
+        size_t node = path[i];
+        auto &parent_entries = mNodes[path[i - 1]].entries;
+        auto parent_entry = std::find_if(parent_entries.begin(), parent_entries.end(),
+                                         [node](const Entry &entry) { return entry.value == node; });
+
+        if (mNodes[node].entries.size() < mMinEntries) {
+            size_t height = path.size() - 1 - i;
+            for (const auto &entry : mNodes[node].entries) {
+                orphans.emplace_back(entry, height);
+            }
+            parent_entries.erase(parent_entry);
+            mNodes[node].entries.clear();
+            mFreeNodes.push_back(node);
+        } else {
+            parent_entry->box = nodeBox(node);
+        }
+    }
+
+    for (const auto &orphan : orphans) {
+        insertEntry(orphan.first, orphan.second);
+    }
+
+    /* Shorten the tree */
+    while (!mNodes[mRoot].leaf && mNodes[mRoot].entries.size() == 1) {
+        size_t root = mRoot;
+        mRoot = mNodes[root].entries.front().value;
+        mNodes[root].entries.clear();
+        mFreeNodes.push_back(root);
+        mHeight--;
+    }
+
+    if (!mNodes[mRoot].leaf && mNodes[mRoot].entries.empty()) {
+        mNodes[mRoot].leaf = true;
+        mHeight = 0;
+    }
+
+    return true;
+}
+
+template<typename Point_t>
+template<typename NodeTest, typename ItemTest>
+auto DynamicRTree<Point_t>::query(NodeTest nodeTest, ItemTest itemTest) const -> std::vector<size_t>
+{
+    std::vector<size_t> result;
+    std::vector<size_t> stack{mRoot};
+
+    while (!stack.empty()) {
+
+        const Node &node = mNodes[stack.back()];
+        stack.pop_back();
+
+        for (const auto &entry : node.entries) {
+            if (node.leaf) {
+                if (itemTest(entry.box.data())) result.push_back(entry.value);
+            } else if (nodeTest(entry.box.data())) {
+                stack.push_back(entry.value);
+            }
+        }
+    }
+
+    return result;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::search(const box_type &box) const -> std::vector<size_t>
+{
+    bounds_type query_box;
+    internal::RTreeTraits<Point_t>::bounds(box, query_box.data(), query_box.data() + dimensions);
+
+    auto intersects = [&query_box](const scalar *entry_box) {
+        return internal::rtree_intersects<dimensions>(entry_box, query_box.data());
+    };
+
+    return query(intersects, intersects);
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::searchWithin(const box_type &box) const -> std::vector<size_t>
+{
+    bounds_type query_box;
+    internal::RTreeTraits<Point_t>::bounds(box, query_box.data(), query_box.data() + dimensions);
+
+    return query([&query_box](const scalar *entry_box) {
+                     return internal::rtree_intersects<dimensions>(entry_box, query_box.data());
+                 },
+                 [&query_box](const scalar *entry_box) {
+                     return internal::rtree_contains<dimensions>(query_box.data(), entry_box);
+                 });
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::searchContaining(const Point_t &point) const -> std::vector<size_t>
+{
+    std::array<scalar, dimensions> coordinates;
+    internal::RTreeTraits<Point_t>::coordinates(point, coordinates.data());
+
+    auto contains = [&coordinates](const scalar *entry_box) {
+        return internal::rtree_contains_point<dimensions>(entry_box, coordinates.data());
+    };
+
+    return query(contains, contains);
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::nearest(const Point_t &point,
+                                    size_t k) const -> std::vector<size_t>
+{
+    std::vector<size_t> result;
+
+    if (mSize == 0 || k == 0) return result;
+
+    std::array<scalar, dimensions> coordinates;
+    internal::RTreeTraits<Point_t>::coordinates(point, coordinates.data());
+
+    struct Candidate
+    {
+        double distance;
+        size_t value;
+        bool item;
+        bool operator<(const Candidate &other) const { return distance > other.distance; }
+    };
+
+    std::priority_queue<Candidate> queue;
+    queue.push({0., mRoot, false});
+
+    while (!queue.empty() && result.size() < k) {
+
+        Candidate candidate = queue.top();
+        queue.pop();
+
+        if (candidate.item) {
+            result.push_back(candidate.value);
+            continue;
+        }
+
+        const Node &node = mNodes[candidate.value];
+        for (const auto &entry : node.entries) {
+            queue.push({internal::rtree_squared_distance<dimensions>(entry.box.data(), coordinates.data()),
+                        entry.value, node.leaf});
+        }
+    }
+
+    return result;
+}
+
+template<typename Point_t>
+auto DynamicRTree<Point_t>::pack(size_t nodeCapacity) const -> RTree<Point_t>
+{
+    std::vector<scalar> bounds;
+    std::vector<uint64_t> ids;
+    bounds.reserve(mSize * 2 * dimensions);
+    ids.reserve(mSize);
+
+    std::vector<size_t> stack{mRoot};
+    while (!stack.empty()) {
+        const Node &node = mNodes[stack.back()];
+        stack.pop_back();
+        for (const auto &entry : node.entries) {
+            if (node.leaf) {
+                bounds.insert(bounds.end(), entry.box.begin(), entry.box.end());
+                ids.push_back(entry.value);
+            } else {
+                stack.push_back(entry.value);
+            }
+        }
+    }
+
+    RTree<Point_t> rtree;
+    rtree.build(std::move(bounds), std::move(ids), nodeCapacity);
+    return rtree;
+}
+
+
+/*! \} */ // end of geometry_algorithms
+
+/*! \} */ // end of geometry
+
+} // End namespace tl
@@ -0,0 +1,655 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "tidop/core/defs.h"
+#include "tidop/geometry/entities/segment.h"
+#include "tidop/geometry/entities/linestring.h"
+#include "tidop/geometry/entities/polygon.h"
+#include "tidop/geometry/algorithms/predicates.h"
+
+namespace tl
+{
+
+/*! \addtogroup geometry
+ *  \{
+ */
+
+/*! \addtogroup geometry_algorithms
+ *  \{
+ */
+
+
+/*!
+ * \brief Intersection between two segments of a set
+ */
+template<typename Point_t>
+struct SegmentIntersection
+{
+
+    /*!
+     * \brief Type of intersection
+     */
+    enum class Type
+    {
+        point,   /*!< The segments cross or touch at pt1 */
+        overlap  /*!< The segments are collinear and overlap from pt1 to pt2 */
+    };
+
+    /*!
+     * \brief Index of the first segment
+     */
+    size_t segment1;
+
+    /*!
+     * \brief Index of the second segment
+     */
+    size_t segment2;
+
+    Type type;
+
+    /*!
+     * \brief Intersection point or first point of the overlap
+     */
+    Point_t pt1;
+
+    /*!
+     * \brief Last point of the overlap. Same as pt1 for a point intersection
+     */
+    Point_t pt2;
+};
+
+
+/// \cond
+
+namespace internal
+{
+
+struct IntersectionSegment
+{
+    double x1;
+    double y1;
+    double x2;
+    double y2;
+};
+
+/* How a pair of candidate segments is tested */
+enum class SegmentPair
+{
+    independent, /* Any intersection is reported */
+    adjacent     /* Consecutive segments of a chain. The shared vertex is not an intersection */
+};
+
+/* Lexicographic order (x, y). It is the order along the line for collinear points */
+inline bool segment_intersection_less(double ax, double ay, double bx, double by)
+{
+    return ax < bx || (ax == bx && ay < by);
+}
+
+/* Point collinear with the segment (or segment reduced to a point) between its endpoints */
+inline bool segment_intersection_between(const IntersectionSegment &segment, double x, double y)
+{
+    bool reverse = segment_intersection_less(segment.x2, segment.y2, segment.x1, segment.y1);
+    double min_x = reverse ? segment.x2 : segment.x1;
+    double min_y = reverse ? segment.y2 : segment.y1;
+    double max_x = reverse ? segment.x1 : segment.x2;
+    double max_y = reverse ? segment.y1 : segment.y2;
+
+    return !segment_intersection_less(x, y, min_x, min_y) &&
+           !segment_intersection_less(max_x, max_y, x, y);
+}
+
+template<typename Point_t>
+auto segment_intersection_point(double x, double y) -> Point_t
+{
+    using scalar = typename Point_t::value_type;
+
+    Point_t point;
+    if (std::is_integral<scalar>::value) {
+        point.x = static_cast<scalar>(roundToInteger(x));
+        point.y = static_cast<scalar>(roundToInteger(y));
+    } else {
+        point.x = static_cast<scalar>(x);
+        point.y = static_cast<scalar>(y);
+    }
+
+    return point;
+}
+
+/* Intersection of two segments with exact predicates.
+   The topology (crossing, touch, overlap or nothing) is exact and touching or
+   overlapping points are input vertices. Only the point of a proper crossing
+   is rounded, and it is clamped to the boxes of both segments. */
+template<typename Point_t>
+bool segment_intersection(const IntersectionSegment &s,
+                          const IntersectionSegment &t,
+                          SegmentIntersection<Point_t> *intersection)
+{
+    int o1 = orientation(s.x1, s.y1, s.x2, s.y2, t.x1, t.y1);
+    int o2 = orientation(s.x1, s.y1, s.x2, s.y2, t.x2, t.y2);
+    if (o1 != 0 && o1 == o2) return false;
+
+    int o3 = orientation(t.x1, t.y1, t.x2, t.y2, s.x1, s.y1);
+    int o4 = orientation(t.x1, t.y1, t.x2, t.y2, s.x2, s.y2);
+    if (o3 != 0 && o3 == o4) return false;
+
+    if (o1 == 0 && o2 == 0 && o3 == 0 && o4 == 0) {
+
+        /* Collinear segments (or segments reduced to a point) */
+        bool s_reverse = segment_intersection_less(s.x2, s.y2, s.x1, s.y1);
+        bool t_reverse = segment_intersection_less(t.x2, t.y2, t.x1, t.y1);
+        double s_min[2] = {s_reverse ? s.x2 : s.x1, s_reverse ? s.y2 : s.y1};
+        double s_max[2] = {s_reverse ? s.x1 : s.x2, s_reverse ? s.y1 : s.y2};
+        double t_min[2] = {t_reverse ? t.x2 : t.x1, t_reverse ? t.y2 : t.y1};
+        double t_max[2] = {t_reverse ? t.x1 : t.x2, t_reverse ? t.y1 : t.y2};
+
+        const double *first = segment_intersection_less(s_min[0], s_min[1], t_min[0], t_min[1]) ? t_min : s_min;
+        const double *last = segment_intersection_less(s_max[0], s_max[1], t_max[0], t_max[1]) ? s_max : t_max;
+
+        if (segment_intersection_less(last[0], last[1], first[0], first[1])) return false;
+
+        bool point = first[0] == last[0] && first[1] == last[1];
+        intersection->type = point ? SegmentIntersection<Point_t>::Type::point
+                                   : SegmentIntersection<Point_t>::Type::overlap;
+        intersection->pt1 = segment_intersection_point<Point_t>(first[0], first[1]);
+        intersection->pt2 = segment_intersection_point<Point_t>(last[0], last[1]);
+
+        return true;
+    }
+
+    intersection->type = SegmentIntersection<Point_t>::Type::point;
+
+    if (o1 != 0 && o2 != 0 && o3 != 0 && o4 != 0) {
+
+        /* Proper crossing */
+        double dx1 = s.x2 - s.x1;
+        double dy1 = s.y2 - s.y1;
+        double dx2 = t.x2 - t.x1;
+        double dy2 = t.y2 - t.y1;
+        double u = ((t.x1 - s.x1) * dy2 - (t.y1 - s.y1) * dx2) / (dx1 * dy2 - dy1 * dx2);
+        u = std::min(std::max(u, 0.), 1.);
+
+        double x = s.x1 + u * dx1;
+        double y = s.y1 + u * dy1;
+        x = std::max(x, std::max(std::min(s.x1, s.x2), std::min(t.x1, t.x2)));
+        x = std::min(x, std::min(std::max(s.x1, s.x2), std::max(t.x1, t.x2)));
+        y = std::max(y, std::max(std::min(s.y1, s.y2), std::min(t.y1, t.y2)));
+        y = std::min(y, std::min(std::max(s.y1, s.y2), std::max(t.y1, t.y2)));
+
+        intersection->pt1 = segment_intersection_point<Point_t>(x, y);
+
+    } else if (o1 == 0 && segment_intersection_between(s, t.x1, t.y1)) {
+        intersection->pt1 = segment_intersection_point<Point_t>(t.x1, t.y1);
+    } else if (o2 == 0 && segment_intersection_between(s, t.x2, t.y2)) {
+        intersection->pt1 = segment_intersection_point<Point_t>(t.x2, t.y2);
+    } else if (o3 == 0 && segment_intersection_between(t, s.x1, s.y1)) {
+        intersection->pt1 = segment_intersection_point<Point_t>(s.x1, s.y1);
+    } else if (o4 == 0 && segment_intersection_between(t, s.x2, s.y2)) {
+        intersection->pt1 = segment_intersection_point<Point_t>(s.x2, s.y2);
+    } else {
+        return false;
+    }
+
+    intersection->pt2 = intersection->pt1;
+
+    return true;
+}
+
+/*
+ * All the intersecting pairs of a set of segments.
+ *
+ * The segments are stored in every cell of a uniform grid covered by their box
+ * and only the pairs that share a cell are tested. A pair is tested in the
+ * first cell (lowest column and row) shared by both boxes, so that it is tested
+ * once without sorting or hashing the candidates. The cell size is the larger
+ * of the mean segment extent and the side of a cell with one segment on
+ * average, so a segment covers a few cells and a cell holds a few segments.
+ *
+ * Clustered input can still put most of the segments in a few cells, so the
+ * pairs of a cell are enumerated with a sweep: the segments are sorted by the
+ * lower end of their box along the axis where they overlap less and a pair is
+ * only visited if both intervals overlap.
+ *
+ * If split is not zero, segments [0, split) and [split, size) are two sets and
+ * only the pairs with a segment of each set are visited (red-blue). tests
+ * (optional) counts the visited pairs.
+ */
+template<typename Point_t, typename Pair>
+auto segment_intersections(const std::vector<IntersectionSegment> &segments,
+                           const Pair &pair,
+                           size_t split = 0,
+                           size_t *tests = nullptr) -> std::vector<SegmentIntersection<Point_t>>
+{
+    std::vector<SegmentIntersection<Point_t>> intersections;
+
+    size_t size = segments.size();
+    if (size < 2) return intersections;
+
+    double min_x = std::numeric_limits<double>::max();
+    double min_y = std::numeric_limits<double>::max();
+    double max_x = std::numeric_limits<double>::lowest();
+    double max_y = std::numeric_limits<double>::lowest();
+    double extent = 0.;
+
+    /* Box of each segment: min x, min y, max x, max y */
+    std::vector<std::array<double, 4>> boxes(size);
+
+    for (size_t i = 0; i < size; i++) {
+        const auto &segment = segments[i];
+        boxes[i] = {std::min(segment.x1, segment.x2), std::min(segment.y1, segment.y2),
+                    std::max(segment.x1, segment.x2), std::max(segment.y1, segment.y2)};
+        min_x = std::min(min_x, boxes[i][0]);
+        min_y = std::min(min_y, boxes[i][1]);
+        max_x = std::max(max_x, boxes[i][2]);
+        max_y = std::max(max_y, boxes[i][3]);
+        extent += std::max(boxes[i][2] - boxes[i][0], boxes[i][3] - boxes[i][1]);
+    }
+
+    double width = max_x - min_x;
+    double height = max_y - min_y;
+    double cell_size = std::max(extent / static_cast<double>(size),
+                                std::sqrt(width * height / static_cast<double>(size)));
+    /* Thin extents: at most one column (or row) per segment */
+    cell_size = std::max(cell_size, std::max(width, height) / static_cast<double>(size));
+    if (!(cell_size > 0.)) cell_size = 1.;
+
+    size_t cols = static_cast<size_t>(width / cell_size) + 1;
+    size_t rows = static_cast<size_t>(height / cell_size) + 1;
+
+    auto col = [&](double x) {
+        return std::min(static_cast<size_t>((x - min_x) / cell_size), cols - 1);
+    };
+    auto row = [&](double y) {
+        return std::min(static_cast<size_t>((y - min_y) / cell_size), rows - 1);
+    };
+
+    std::vector<std::array<size_t, 4>> ranges(size);
+    std::vector<size_t> cell_offset(cols * rows + 1, 0);
+
+    for (size_t i = 0; i < size; i++) {
+        ranges[i] = {col(boxes[i][0]), row(boxes[i][1]), col(boxes[i][2]), row(boxes[i][3])};
+        for (size_t r = ranges[i][1]; r <= ranges[i][3]; r++) {
+            for (size_t c = ranges[i][0]; c <= ranges[i][2]; c++) {
+                cell_offset[r * cols + c + 1]++;
+            }
+        }
+    }
+
+    for (size_t i = 1; i < cell_offset.size(); i++)
+        cell_offset[i] += cell_offset[i - 1];
+
+    /* Segments sorted by index in each cell, so the first set comes first */
+    std::vector<size_t> cell_segments(cell_offset.back());
+    std::vector<size_t> cell_fill(cell_offset.begin(), cell_offset.end() - 1);
+    for (size_t i = 0; i < size; i++) {
+        for (size_t r = ranges[i][1]; r <= ranges[i][3]; r++) {
+            for (size_t c = ranges[i][0]; c <= ranges[i][2]; c++) {
+                cell_segments[cell_fill[r * cols + c]++] = i;
+            }
+        }
+    }
+
+    SegmentIntersection<Point_t> intersection;
+
+    auto test = [&](size_t i, size_t j, size_t c, size_t r) {
+
+        if (tests) (*tests)++;
+
+        if (i > j) std::swap(i, j);
+
+        if (boxes[j][2] < boxes[i][0] || boxes[j][0] > boxes[i][2] ||
+            boxes[j][3] < boxes[i][1] || boxes[j][1] > boxes[i][3]) return;
+
+        /* First shared cell */
+        if (std::max(ranges[i][0], ranges[j][0]) != c ||
+            std::max(ranges[i][1], ranges[j][1]) != r) return;
+
+        if (!segment_intersection(segments[i], segments[j], &intersection)) return;
+
+        if (pair(i, j) == SegmentPair::adjacent &&
+            intersection.type == SegmentIntersection<Point_t>::Type::point) return;
+
+        intersection.segment1 = i;
+        intersection.segment2 = j;
+        intersections.push_back(intersection);
+    };
+
+    std::vector<size_t> order;
+
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+
+            size_t cell = r * cols + c;
+            auto begin = cell_segments.begin() + static_cast<std::ptrdiff_t>(cell_offset[cell]);
+            auto end = cell_segments.begin() + static_cast<std::ptrdiff_t>(cell_offset[cell + 1]);
+            auto middle = split > 0 ? std::lower_bound(begin, end, split) : end;
+
+            if (split > 0 ? (begin == middle || middle == end) : end - begin < 2) continue;
+
+            /* Sweep axis: the one with less overlap (sum of the extents
+               relative to the spread of the lower ends) */
+            double extent_x = 0.;
+            double extent_y = 0.;
+            double lower_x[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+            double lower_y[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+            for (auto it = begin; it != end; ++it) {
+                const auto &box = boxes[*it];
+                extent_x += box[2] - box[0];
+                extent_y += box[3] - box[1];
+                lower_x[0] = std::min(lower_x[0], box[0]);
+                lower_x[1] = std::max(lower_x[1], box[0]);
+                lower_y[0] = std::min(lower_y[0], box[1]);
+                lower_y[1] = std::max(lower_y[1], box[1]);
+            }
+            size_t axis = extent_x * (lower_y[1] - lower_y[0]) <= extent_y * (lower_x[1] - lower_x[0]) ? 0 : 1;
+
+            auto lower = [&](size_t i) { return boxes[i][axis]; };
+            auto upper = [&](size_t i) { return boxes[i][axis + 2]; };
+            auto compare = [&](size_t i, size_t j) { return lower(i) < lower(j); };
+
+            order.assign(begin, end);
+            size_t mid = static_cast<size_t>(middle - begin);
+            size_t count = order.size();
+            std::sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(mid), compare);
+            std::sort(order.begin() + static_cast<std::ptrdiff_t>(mid), order.end(), compare);
+
+            if (split == 0) {
+
+                for (size_t a = 0; a < count; a++) {
+                    for (size_t b = a + 1; b < count && lower(order[b]) <= upper(order[a]); b++) {
+                        test(order[a], order[b], c, r);
+                    }
+                }
+
+            } else {
+
+                /* Each pair is visited from the segment with the lower start */
+                size_t a = 0;
+                size_t b = mid;
+                while (a < mid && b < count) {
+                    if (lower(order[a]) <= lower(order[b])) {
+                        for (size_t k = b; k < count && lower(order[k]) <= upper(order[a]); k++)
+                            test(order[a], order[k], c, r);
+                        a++;
+                    } else {
+                        for (size_t k = a; k < mid && lower(order[k]) <= upper(order[b]); k++)
+                            test(order[k], order[b], c, r);
+                        b++;
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(intersections.begin(), intersections.end(),
+              [](const SegmentIntersection<Point_t> &i1, const SegmentIntersection<Point_t> &i2) {
+                  return i1.segment1 < i2.segment1 || (i1.segment1 == i2.segment1 && i1.segment2 < i2.segment2);
+              });
+
+    return intersections;
+}
+
+template<typename Point_t>
+auto segment_intersection_segment(const Point_t &pt1, const Point_t &pt2) -> IntersectionSegment
+{
+    return {static_cast<double>(pt1.x), static_cast<double>(pt1.y),
+            static_cast<double>(pt2.x), static_cast<double>(pt2.y)};
+}
+
+/*
+ * Segments of a set of chains (linestrings or rings). Zero length segments
+ * (repeated vertices) are skipped and consecutive segments of a chain are
+ * adjacent, as well as the first and the last segments of a closed chain.
+ */
+class SegmentChains
+{
+
+public:
+
+    template<typename It>
+    void add(It begin, It end, bool ring)
+    {
+        size_t count = static_cast<size_t>(std::distance(begin, end));
+        bool closed = ring || (count > 2 && *begin == *(end - 1));
+        size_t edges = 0;
+        if (ring && count > 1) edges = count;
+        else if (!ring && count > 0) edges = count - 1;
+
+        size_t first = mSegments.size();
+        for (size_t i = 0; i < edges; i++) {
+            const auto &pt1 = *(begin + i);
+            const auto &pt2 = *(begin + (i + 1) % count);
+            if (pt1 == pt2) continue;
+            mSegments.push_back(segment_intersection_segment(pt1, pt2));
+            mIndexes.push_back(mOffset + i);
+            mChainIds.push_back(mChains.size());
+        }
+
+        mChains.push_back({first, mSegments.size(), closed});
+        mOffset += edges;
+    }
+
+    auto operator()(size_t i, size_t j) const -> SegmentPair
+    {
+        if (mChainIds[i] != mChainIds[j]) return SegmentPair::independent;
+
+        const auto &chain = mChains[mChainIds[i]];
+        if (j == i + 1 || (chain.closed && i == chain.first && j + 1 == chain.last))
+            return SegmentPair::adjacent;
+
+        return SegmentPair::independent;
+    }
+
+    template<typename Point_t>
+    auto intersections() const -> std::vector<SegmentIntersection<Point_t>>
+    {
+        auto intersections = segment_intersections<Point_t>(mSegments, *this);
+        for (auto &intersection : intersections) {
+            intersection.segment1 = mIndexes[intersection.segment1];
+            intersection.segment2 = mIndexes[intersection.segment2];
+        }
+        return intersections;
+    }
+
+private:
+
+    struct Chain
+    {
+        size_t first;
+        size_t last;
+        bool closed;
+    };
+
+    std::vector<IntersectionSegment> mSegments;
+    /* Index of each segment counting the skipped ones */
+    std::vector<size_t> mIndexes;
+    std::vector<size_t> mChainIds;
+    std::vector<Chain> mChains;
+    size_t mOffset{0};
+
+};
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief All the intersections of a set of segments
+ *
+ * Finds every pair of intersecting segments (crossing, touching or collinear
+ * and overlapping) without testing all the pairs: the segments are bucketed in
+ * a uniform grid and only the pairs sharing a cell are tested, which for road
+ * networks, contours and polygon edges takes O(n + k) expected time for n
+ * segments and k intersections. The pairs of each cell are enumerated with a
+ * sweep, so clustered segments don't degrade to testing all the pairs.
+ *
+ * The predicates are exact (floating point filter with an exact fallback), so
+ * degenerate configurations (collinear overlaps, touching endpoints, shared
+ * vertices, zero length segments) are classified consistently. Touching and
+ * overlapping points are input vertices; only the point of a proper crossing
+ * is rounded.
+ *
+ * \param[in] segments Segments
+ * \return Intersections sorted by segment1 and segment2 (segment1 < segment2)
+ */
+template<typename Point_t>
+auto intersectSegments(const std::vector<Segment<Point_t>> &segments) -> std::vector<SegmentIntersection<Point_t>>
+{
+    std::vector<internal::IntersectionSegment> intersection_segments;
+    intersection_segments.reserve(segments.size());
+    for (const auto &segment : segments)
+        intersection_segments.push_back(internal::segment_intersection_segment(segment.pt1, segment.pt2));
+
+    return internal::segment_intersections<Point_t>(intersection_segments,
+                                                    [](size_t, size_t) {
+                                                        return internal::SegmentPair::independent;
+                                                    });
+}
+
+/*!
+ * \brief Intersections between two sets of segments
+ *
+ * Only the pairs with a segment of each set are reported (red-blue
+ * intersection), e.g. crossings between a road network and a river network.
+ * The pairs of segments of the same set are not even visited.
+ *
+ * \param[in] segments1 First set of segments
+ * \param[in] segments2 Second set of segments
+ * \return Intersections sorted by segment1 (index in segments1) and segment2 (index in segments2)
+ * \see intersectSegments(const std::vector<Segment<Point_t>> &)
+ */
+template<typename Point_t>
+auto intersectSegments(const std::vector<Segment<Point_t>> &segments1,
+                       const std::vector<Segment<Point_t>> &segments2) -> std::vector<SegmentIntersection<Point_t>>
+{
+    size_t size1 = segments1.size();
+
+    if (segments1.empty() || segments2.empty())
+        return std::vector<SegmentIntersection<Point_t>>();
+
+    std::vector<internal::IntersectionSegment> intersection_segments;
+    intersection_segments.reserve(size1 + segments2.size());
+    for (const auto &segment : segments1)
+        intersection_segments.push_back(internal::segment_intersection_segment(segment.pt1, segment.pt2));
+    for (const auto &segment : segments2)
+        intersection_segments.push_back(internal::segment_intersection_segment(segment.pt1, segment.pt2));
+
+    auto intersections = internal::segment_intersections<Point_t>(intersection_segments,
+                                                                  [](size_t, size_t) {
+                                                                      return internal::SegmentPair::independent;
+                                                                  },
+                                                                  size1);
+
+    for (auto &intersection : intersections)
+        intersection.segment2 -= size1;
+
+    return intersections;
+}
+
+/*!
+ * \brief Self-intersections of a linestring
+ *
+ * Segment i goes from vertex i to vertex i + 1. The vertex shared by two
+ * consecutive segments (and by the first and the last segments if the
+ * linestring is closed) is not an intersection, but a consecutive segment
+ * that folds back over the previous one is reported as an overlap.
+ *
+ * \param[in] lineString Linestring
+ * \return Intersections sorted by segment1 and segment2
+ * \see intersectSegments(const std::vector<Segment<Point_t>> &)
+ */
+template<typename Point_t>
+auto selfIntersections(const LineString<Point_t> &lineString) -> std::vector<SegmentIntersection<Point_t>>
+{
+    internal::SegmentChains chains;
+    chains.add(lineString.begin(), lineString.end(), false);
+
+    return chains.intersections<Point_t>();
+}
+
+/*!
+ * \brief Intersections of the linestrings of a multilinestring
+ *
+ * Reports the crossings between different linestrings and the self-intersections
+ * of each one. The segments are numbered consecutively across the linestrings:
+ * the segments of the first linestring, then those of the second one, and so on.
+ *
+ * \param[in] multiLineString Multilinestring
+ * \return Intersections sorted by segment1 and segment2
+ * \see selfIntersections(const LineString<Point_t> &)
+ */
+template<typename Point_t>
+auto selfIntersections(const MultiLineString<Point_t> &multiLineString) -> std::vector<SegmentIntersection<Point_t>>
+{
+    internal::SegmentChains chains;
+    for (const auto &lineString : multiLineString)
+        chains.add(lineString.begin(), lineString.end(), false);
+
+    return chains.intersections<Point_t>();
+}
+
+/*!
+ * \brief Self-intersections of a polygon
+ *
+ * Intersections between the edges of the outer ring and the holes. Edge i of a
+ * ring goes from vertex i to vertex i + 1 (the last one closes the ring) and
+ * the edges are numbered consecutively: outer ring first and then the holes.
+ *
+ * \param[in] polygon Polygon
+ * \return Intersections sorted by segment1 and segment2
+ * \see selfIntersections(const LineString<Point_t> &)
+ */
+template<typename Point_t>
+auto selfIntersections(const Polygon<Point_t> &polygon) -> std::vector<SegmentIntersection<Point_t>>
+{
+    internal::SegmentChains chains;
+    chains.add(polygon.begin(), polygon.end(), true);
+    for (size_t i = 0; i < polygon.holes(); i++) {
+        PolygonHole<Point_t> hole = polygon.hole(i);
+        chains.add(hole.begin(), hole.end(), true);
+    }
+
+    return chains.intersections<Point_t>();
+}
+
+
+/*! \} */ // end of geometry_algorithms
+
+/*! \} */ // end of geometry
+
+} // End namespace tl
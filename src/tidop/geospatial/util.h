@@ -28,6 +28,7 @@
 #include "tidop/core/defs.h"
 #include "tidop/geometry/entities/point.h"
 #include "tidop/geometry/entities/polygon.h"
+#include "tidop/geometry/algorithms/polylabel.h"
 #include "tidop/math/algebra/rotation_matrix.h"
 
 namespace tl
@@ -90,40 +91,29 @@ Point_t findInscribedCircleSequential(const Polygon<Point_t> &polygon,
     return pia;
 }
 
-// Polo de inaccesibilidad para un poligono 2D
+/*!
+ * \brief Polo de inaccesibilidad para un poligono 2D
+ *
+ * Se calcula con polylabel con una precisión de 0.01, la tolerancia con la
+ * que terminaba la búsqueda por rejillas anterior.
+ *
+ * \param[in] polygon Poligono
+ * \param[out] pole Polo de inaccesibilidad
+ * \param[in] nCells No se usa. Se mantiene por compatibilidad
+ * \param[in] mCells No se usa. Se mantiene por compatibilidad
+ * \see polylabel
+ */
 template<typename Point_t> inline
 void poleOfInaccessibility(const Polygon<Point_t> &polygon,
                            Point_t *pole,
                            double nCells = 20.,
                            double mCells = 20.)
 {
-    if (pole == NULL) return;
-    Window<Point_t> w = polygon.window();
-
-    Point_t point_tmp;
-
-    int count = 1;
-    while (count++) {
+    unusedParameter(nCells, mCells);
 
-        /*if (method == METHOD_SEQUENTIAL) {*/
-        point_tmp = findInscribedCircleSequential(polygon, w, nCells, mCells);
-        /*} else if (method == METHOD_RANDOMIZED) {
-          point_tmp = findInscribedCircleRandomized(polygon, w);
-        }*/
-
-        pole->x = point_tmp.x;
-        pole->y = point_tmp.y;
-
-        Point_t aux{};
-        aux.x = (w.pt2.x - w.pt1.x) / (sqrt(2.) * 2.);
-        aux.y = (w.pt2.y - w.pt1.y) / (sqrt(2.) * 2.);
-
-        w.pt1 = *pole - aux;
-        w.pt2 = *pole + aux;
-
-        if (w.pt2.x - w.pt1.x < 0.01 || w.pt2.y - w.pt1.y < 0.01) break;
+    if (pole == NULL) return;
 
-    }
+    *pole = polylabel(polygon, 0.01);
 }
 
 /*! \} */ // end of geospatial
@@ -27,6 +27,7 @@
 #include "tidop/math/math.h"
 #include "tidop/math/algebra/vector.h"
 #include "tidop/math/algebra/matrix.h"
+#include "tidop/math/algebra/dense_kernels.h"
 #include "tidop/math/lapack.h"
 
 
@@ -52,7 +53,13 @@ namespace tl
    * se pueden escoger los factores tales que U es la transpuesta de L, y esto se llama
    * la descomposición o factorización de Cholesky.
    *
-   * La matriz A tiene que ser simétrica y definida positiva.
+   * La matriz A tiene que ser simétrica y definida positiva. Sólo se lee el
+   * triángulo inferior.
+   *
+   * A partir de internal::blocked_decomposition_threshold filas la matriz se
+   * factoriza por bloques: tras factorizar el bloque diagonal se resuelve el
+   * panel inferior y el resto del triángulo se actualiza con productos de
+   * matrices (GEMM) repartidos entre hilos.
    */
 template<typename T>
 class CholeskyDecomposition;
@@ -69,11 +76,13 @@ public:
     CholeskyDecomposition(const Matrix_t<T, _rows, _cols> &a);
 
     auto solve(const Vector<T, _rows>& b) -> Vector<T, _rows>;
+    auto solve(const Matrix_t<T, _rows, _cols> &b) const -> Matrix_t<T, _rows, _cols>;
     auto l() const -> Matrix<T, _rows, _cols>;
 
 private:
 
     void decompose();
+    void decomposeDiagonalBlock(size_t ini, size_t end);
 
 protected:
 
@@ -137,6 +146,25 @@ auto CholeskyDecomposition<Matrix_t<T, _rows, _cols>>::solve(const Vector<T, _ro
     return x;
 }
 
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t _rows, size_t _cols
+>
+auto CholeskyDecomposition<Matrix_t<T, _rows, _cols>>::solve(const Matrix_t<T, _rows, _cols> &b) const -> Matrix_t<T, _rows, _cols>
+{
+    TL_ASSERT(b.rows() == mRows, "bad lengths in Cholesky");
+
+    Matrix_t<T, _rows, _cols> x(b);
+    size_t nrhs = x.cols();
+
+    /// L * Y = B
+    internal::solve_lower_triangular(mRows, nrhs, false, L.data(), L.cols(), size_t{1}, x.data(), nrhs);
+    /// L' * X = Y
+    internal::solve_upper_triangular(mRows, nrhs, false, L.data(), size_t{1}, L.cols(), x.data(), nrhs);
+
+    return x;
+}
+
 template<
     template<typename, size_t, size_t>
 class Matrix_t, typename T, size_t _rows, size_t _cols
@@ -150,26 +178,93 @@ void CholeskyDecomposition<Matrix_t<T, _rows, _cols>>::decompose()
 
     TL_ASSERT(info >= 0, "Cholesky decomposition failed");
 #else
-    for (size_t i = 0; i < mRows; i++) {
 
-        for (size_t j = i; j < mRows; j++) {
+    if (mRows < internal::blocked_decomposition_threshold) {
+        decomposeDiagonalBlock(0, mRows);
+        return;
+    }
+
+    T *l = L.data();
+    size_t ld = L.cols();
+
+    for (size_t k = 0; k < mRows; k += internal::blocked_decomposition_block_size) {
 
-            T sum = L[i][j];
+        size_t next = std::min(k + internal::blocked_decomposition_block_size, mRows);
 
-            for (size_t k = i; k > 0; k--) {
-                sum -= L[i][k - 1] * L[j][k - 1];
+        decomposeDiagonalBlock(k, next);
+
+        if (next == mRows) break;
+
+        size_t block = next - k;
+        size_t trailing = mRows - next;
+
+        /// L21 = A21 * L11^-T. Each row is a forward substitution with L11.
+        auto solve_rows = [&](size_t ini, size_t end) {
+            for (size_t r = ini; r < end; r++) {
+                T *row = &l[r * ld + k];
+                for (size_t j = 0; j < block; j++) {
+                    const T *l_j = &l[(k + j) * ld + k];
+                    row[j] = (row[j] - internal::dot(j, l_j, row)) / l_j[j];
+                }
             }
+        };
+
+        if (trailing * block * block < internal::gemm_parallel_threshold) {
+            solve_rows(next, mRows);
+        } else {
+            size_t tasks = (trailing + internal::gemm_mc - 1) / internal::gemm_mc;
+            parallel_for(0, tasks, [&](size_t task) {
+                size_t ini = next + task * internal::gemm_mc;
+                solve_rows(ini, std::min(ini + internal::gemm_mc, mRows));
+            });
+        }
+
+        /// A22 = A22 - L21 * L21'. Only the block columns of the lower triangle are updated.
+        for (size_t j = next; j < mRows; j += internal::blocked_decomposition_block_size) {
+
+            size_t cols = std::min(internal::blocked_decomposition_block_size, mRows - j);
+
+            internal::gemm(mRows - j, cols, block, -consts::one<T>,
+                           &l[j * ld + k], ld, size_t{1},
+                           &l[j * ld + k], size_t{1}, ld,
+                           &l[j * ld + j], ld);
+        }
+    }
+
+#endif
+}
+
+/*!
+ * \brief Factoriza el bloque diagonal [ini, end) x [ini, end)
+ *
+ * Las actualizaciones de los bloques anteriores ya tienen que estar aplicadas.
+ */
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t _rows, size_t _cols
+>
+void CholeskyDecomposition<Matrix_t<T, _rows, _cols>>::decomposeDiagonalBlock(size_t ini, size_t end)
+{
+    T *l = L.data();
+    size_t ld = L.cols();
+
+    for (size_t i = ini; i < end; i++) {
+
+        T *l_i = &l[i * ld + ini];
+
+        for (size_t j = ini; j <= i; j++) {
+
+            T *l_j = &l[j * ld + ini];
+            T sum = l_i[j - ini] - internal::dot(j - ini, l_i, l_j);
 
             if (i == j) {
                 TL_ASSERT(sum > 0.0, "Cholesky decomposition failed");
-                L[i][i] = sqrt(sum);
+                l_i[j - ini] = sqrt(sum);
             } else {
-                L[j][i] = sum / L[i][i];
+                l_i[j - ini] = sum / l_j[j - ini];
             }
-
         }
     }
-#endif
 }
 
 template<
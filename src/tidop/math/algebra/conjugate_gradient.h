@@ -0,0 +1,257 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <cmath>
+#include <vector>
+
+#include "tidop/math/math.h"
+#include "tidop/math/algebra/vector.h"
+#include "tidop/math/algebra/sparse_matrix.h"
+#include "tidop/math/algebra/preconditioner.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Algebra
+ *
+ * Algebra
+ *
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+template<typename T>
+auto sparse_dot(const std::vector<T> &a, const std::vector<T> &b) -> T
+{
+    T dot = consts::zero<T>;
+    for (size_t i = 0; i < a.size(); i++)
+        dot += a[i] * b[i];
+    return dot;
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Preconditioned conjugate gradient
+ *
+ * Iterative solver of A * x = b for a symmetric positive definite sparse matrix.
+ * The normal equations of a least squares problem can be solved with the matrix
+ * returned by normalMatrix().
+ *
+ * The solver keeps a reference to the matrix, which must outlive it.
+ *
+ * \code
+ * ConjugateGradient<double, IncompleteCholeskyPreconditioner<double>> cg(A);
+ * cg.setTolerance(1e-10);
+ * Vector<double> x = cg.solve(b);
+ * \endcode
+ */
+template<typename T, typename Preconditioner = JacobiPreconditioner<T>>
+class ConjugateGradient
+{
+
+public:
+
+    explicit ConjugateGradient(const SparseMatrixCSR<T> &matrix);
+
+    auto maxIterations() const -> size_t;
+    void setMaxIterations(size_t maxIterations);
+
+    /*!
+     * \brief Tolerance of the relative residual |b - A*x| / |b|
+     */
+    auto tolerance() const -> T;
+    void setTolerance(T tolerance);
+
+    auto solve(const Vector<T> &b) -> Vector<T>;
+
+    /*!
+     * \brief Solve with an initial guess
+     */
+    auto solve(const Vector<T> &b, const Vector<T> &x0) -> Vector<T>;
+
+    /*!
+     * \brief Iterations of the last solve
+     */
+    auto iterations() const -> size_t;
+
+    /*!
+     * \brief Relative residual of the last solve
+     */
+    auto error() const -> T;
+
+private:
+
+    const SparseMatrixCSR<T> &mMatrix;
+    Preconditioner mPreconditioner;
+    size_t mMaxIterations;
+    T mTolerance;
+    size_t mIterations;
+    T mError;
+};
+
+
+template<typename T, typename Preconditioner>
+ConjugateGradient<T, Preconditioner>::ConjugateGradient(const SparseMatrixCSR<T> &matrix)
+  : mMatrix(matrix),
+    mPreconditioner(matrix),
+    mMaxIterations(matrix.rows()),
+    mTolerance(std::numeric_limits<T>::epsilon() * 100),
+    mIterations(0),
+    mError(0)
+{
+    static_assert(std::is_floating_point<T>::value, "Integral type not supported");
+    TL_ASSERT(matrix.rows() == matrix.cols(), "Non-Square Matrix");
+}
+
+template<typename T, typename Preconditioner>
+auto ConjugateGradient<T, Preconditioner>::maxIterations() const -> size_t
+{
+    return mMaxIterations;
+}
+
+template<typename T, typename Preconditioner>
+void ConjugateGradient<T, Preconditioner>::setMaxIterations(size_t maxIterations)
+{
+    mMaxIterations = maxIterations;
+}
+
+template<typename T, typename Preconditioner>
+auto ConjugateGradient<T, Preconditioner>::tolerance() const -> T
+{
+    return mTolerance;
+}
+
+template<typename T, typename Preconditioner>
+void ConjugateGradient<T, Preconditioner>::setTolerance(T tolerance)
+{
+    mTolerance = tolerance;
+}
+
+template<typename T, typename Preconditioner>
+auto ConjugateGradient<T, Preconditioner>::solve(const Vector<T> &b) -> Vector<T>
+{
+    return solve(b, Vector<T>(b.size(), consts::zero<T>));
+}
+
+template<typename T, typename Preconditioner>
+auto ConjugateGradient<T, Preconditioner>::solve(const Vector<T> &b, const Vector<T> &x0) -> Vector<T>
+{
+    size_t n = mMatrix.rows();
+
+    TL_ASSERT(b.size() == n, "Matrix rows != Vector size");
+    TL_ASSERT(x0.size() == n, "Matrix rows != Vector size");
+
+    Vector<T> x(x0);
+    std::vector<T> r(n);
+    std::vector<T> z(n);
+    std::vector<T> p(n);
+    std::vector<T> q(n);
+
+    mMatrix.multiply(x.data(), r.data());
+    for (size_t i = 0; i < n; i++)
+        r[i] = b[i] - r[i];
+
+    T b_norm = static_cast<T>(b.module());
+    if (b_norm == consts::zero<T>) b_norm = consts::one<T>;
+
+    T threshold = mTolerance * b_norm;
+    mIterations = 0;
+    mError = std::sqrt(internal::sparse_dot(r, r)) / b_norm;
+
+    if (mError <= mTolerance) return x;
+
+    mPreconditioner.apply(r.data(), z.data());
+    p = z;
+    T rz = internal::sparse_dot(r, z);
+
+    while (mIterations < mMaxIterations) {
+
+        mMatrix.multiply(p.data(), q.data());
+
+        T pq = internal::sparse_dot(p, q);
+        if (pq <= consts::zero<T>) break;
+
+        T alpha = rz / pq;
+        T r_norm2 = consts::zero<T>;
+        for (size_t i = 0; i < n; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            r_norm2 += r[i] * r[i];
+        }
+
+        mIterations++;
+
+        T r_norm = std::sqrt(r_norm2);
+        mError = r_norm / b_norm;
+        if (r_norm <= threshold) break;
+
+        mPreconditioner.apply(r.data(), z.data());
+        T rz_new = internal::sparse_dot(r, z);
+        T beta = rz_new / rz;
+        rz = rz_new;
+
+        for (size_t i = 0; i < n; i++)
+            p[i] = z[i] + beta * p[i];
+    }
+
+    return x;
+}
+
+template<typename T, typename Preconditioner>
+auto ConjugateGradient<T, Preconditioner>::iterations() const -> size_t
+{
+    return mIterations;
+}
+
+template<typename T, typename Preconditioner>
+auto ConjugateGradient<T, Preconditioner>::error() const -> T
+{
+    return mError;
+}
+
+
+/*! \} */ // end of Algebra
+
+/*! \} */ // end of Math
+
+} // End namespace tl
@@ -0,0 +1,600 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/math.h"
+#include "tidop/math/simd.h"
+
+namespace tl
+{
+
+/*! \addtogroup math
+ *  \{
+ */
+
+/*! \addtogroup algebra
+ *  \{
+ */
+
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * Kernels shared by the dense decompositions (LU, QR, Cholesky and SVD).
+ *
+ * Matrices are addressed through a pointer and a row and column stride, so
+ * the same kernel works on a sub-block of a row-major matrix or on its
+ * transpose without copies. The result of the product and the right-hand
+ * sides of the triangular solves are always row-major.
+ *
+ * The product follows the usual GEMM layering: panels of B are packed in
+ * column strips of the register tile width and the C tiles are accumulated in
+ * Packed registers. Large products split the rows of C among threads.
+ */
+
+/// Block size of the blocked decompositions
+constexpr size_t blocked_decomposition_block_size = 64;
+/// Matrices with fewer rows use the unblocked algorithms
+constexpr size_t blocked_decomposition_threshold = 128;
+
+/// Columns of B packed per pass
+constexpr size_t gemm_nc = 256;
+/// Rows of B (columns of A) packed per pass
+constexpr size_t gemm_kc = 128;
+/// Rows of C computed by each task
+constexpr size_t gemm_mc = 64;
+/// Rows of the register tile
+constexpr size_t gemm_mr = 4;
+/// Products with fewer multiply-adds run in the calling thread
+constexpr size_t gemm_parallel_threshold = 1 << 21;
+
+/// Columns of the right-hand side solved by each task
+constexpr size_t trsm_nc = 256;
+
+/// One-sided Jacobi SVD: rounds of rotations run in parallel from this number of elements
+constexpr size_t svd_jacobi_parallel_threshold = 1 << 15;
+
+/// SVD without LAPACK: Golub-Reinsch from this number of rows and columns,
+/// unless the matrix is tall. One-sided Jacobi otherwise
+constexpr size_t svd_golub_reinsch_threshold = 6;
+
+/// SVD without LAPACK: one-sided Jacobi when there are at least this many rows per column
+constexpr size_t svd_jacobi_aspect_ratio = 5;
+
+template<typename T>
+struct is_simd_dense_type
+#ifdef TL_HAVE_SIMD_INTRINSICS
+  : std::integral_constant<bool, std::is_same<float, std::remove_cv_t<T>>::value ||
+                                 std::is_same<double, std::remove_cv_t<T>>::value>
+#else
+  : std::false_type
+#endif
+{
+};
+
+/// Columns of the register tile
+template<typename T>
+constexpr auto gemm_nr() -> std::enable_if_t<!is_simd_dense_type<T>::value, size_t>
+{
+    return 4;
+}
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+template<typename T>
+constexpr auto gemm_nr() -> std::enable_if_t<is_simd_dense_type<T>::value, size_t>
+{
+    return 2 * Packed<T>::size();
+}
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+
+/* Level 1 */
+
+/// y += alpha * x
+template<typename T>
+auto axpy(size_t n, T alpha, const T *x, T *y) -> std::enable_if_t<!is_simd_dense_type<T>::value, void>
+{
+    for (size_t i = 0; i < n; i++)
+        y[i] += alpha * x[i];
+}
+
+/// x *= alpha
+template<typename T>
+auto scale(size_t n, T alpha, T *x) -> std::enable_if_t<!is_simd_dense_type<T>::value, void>
+{
+    for (size_t i = 0; i < n; i++)
+        x[i] *= alpha;
+}
+
+/// Dot product of two contiguous vectors
+template<typename T>
+auto dot(size_t n, const T *x, const T *y) -> std::enable_if_t<!is_simd_dense_type<T>::value, T>
+{
+    T sum{0};
+    for (size_t i = 0; i < n; i++)
+        sum += x[i] * y[i];
+    return sum;
+}
+
+/// Plane rotation: x = c * x + s * y, y = c * y - s * x
+template<typename T>
+auto rot(size_t n, T *x, T *y, T c, T s) -> std::enable_if_t<!is_simd_dense_type<T>::value, void>
+{
+    for (size_t i = 0; i < n; i++) {
+        T _x = x[i];
+        T _y = y[i];
+        x[i] = c * _x + s * _y;
+        y[i] = c * _y - s * _x;
+    }
+}
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+auto axpy(size_t n, T alpha, const T *x, T *y) -> std::enable_if_t<is_simd_dense_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = n - n % packed_size;
+
+    Packed<T> packed_alpha(alpha);
+    Packed<T> packed_x;
+    Packed<T> packed_y;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+        packed_x.loadUnaligned(&x[i]);
+        packed_y.loadUnaligned(&y[i]);
+        packed_y = internal::fmadd(packed_alpha, packed_x, packed_y);
+        packed_y.storeUnaligned(&y[i]);
+    }
+
+    for (size_t i = max_vector; i < n; i++)
+        y[i] += alpha * x[i];
+}
+
+template<typename T>
+auto scale(size_t n, T alpha, T *x) -> std::enable_if_t<is_simd_dense_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = n - n % packed_size;
+
+    Packed<T> packed_alpha(alpha);
+    Packed<T> packed_x;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+        packed_x.loadUnaligned(&x[i]);
+        packed_x *= packed_alpha;
+        packed_x.storeUnaligned(&x[i]);
+    }
+
+    for (size_t i = max_vector; i < n; i++)
+        x[i] *= alpha;
+}
+
+template<typename T>
+auto dot(size_t n, const T *x, const T *y) -> std::enable_if_t<is_simd_dense_type<T>::value, T>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = n - n % packed_size;
+
+    Packed<T> packed_sum(consts::zero<T>);
+    Packed<T> packed_x;
+    Packed<T> packed_y;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+        packed_x.loadUnaligned(&x[i]);
+        packed_y.loadUnaligned(&y[i]);
+        packed_sum = internal::fmadd(packed_x, packed_y, packed_sum);
+    }
+
+    T sum = packed_sum.sum();
+
+    for (size_t i = max_vector; i < n; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+template<typename T>
+auto rot(size_t n, T *x, T *y, T c, T s) -> std::enable_if_t<is_simd_dense_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = n - n % packed_size;
+
+    Packed<T> packed_c(c);
+    Packed<T> packed_s(s);
+    Packed<T> packed_x;
+    Packed<T> packed_y;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+        packed_x.loadUnaligned(&x[i]);
+        packed_y.loadUnaligned(&y[i]);
+        internal::fmadd(packed_c, packed_x, packed_s * packed_y).storeUnaligned(&x[i]);
+        internal::fmadd(packed_c, packed_y, -(packed_s * packed_x)).storeUnaligned(&y[i]);
+    }
+
+    for (size_t i = max_vector; i < n; i++) {
+        T _x = x[i];
+        T _y = y[i];
+        x[i] = c * _x + s * _y;
+        y[i] = c * _y - s * _x;
+    }
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+
+/* Level 3 */
+
+/*!
+ * \brief Packs a kb x nb block of B (scaled by alpha) in strips of gemm_nr columns
+ * The last strip is padded with zeros.
+ */
+template<typename T>
+void gemm_pack_b(size_t kb, size_t nb, T alpha,
+                 const T *b, size_t rsb, size_t csb,
+                 T *buffer)
+{
+    constexpr size_t nr = gemm_nr<T>();
+
+    for (size_t j = 0; j < nb; j += nr) {
+
+        size_t jb = std::min(nr, nb - j);
+
+        for (size_t p = 0; p < kb; p++) {
+
+            const T *src = b + p * rsb + j * csb;
+
+            for (size_t jj = 0; jj < jb; jj++)
+                *buffer++ = alpha * src[jj * csb];
+
+            for (size_t jj = jb; jj < nr; jj++)
+                *buffer++ = consts::zero<T>;
+        }
+    }
+}
+
+/*!
+ * \brief C += A * B for a tile of mb <= gemm_mr rows and nb <= gemm_nr columns
+ * \param[in] b Packed strip of B
+ */
+template<typename T>
+void gemm_micro_kernel_cpp(size_t mb, size_t nb, size_t kb,
+                           const T *a, size_t rsa, size_t csa,
+                           const T *b,
+                           T *c, size_t ldc)
+{
+    constexpr size_t nr = gemm_nr<T>();
+
+    T tile[gemm_mr][nr] = {};
+
+    for (size_t p = 0; p < kb; p++) {
+        for (size_t i = 0; i < mb; i++) {
+            T a_ip = a[i * rsa + p * csa];
+            for (size_t j = 0; j < nr; j++) {
+                tile[i][j] += a_ip * b[j];
+            }
+        }
+        b += nr;
+    }
+
+    for (size_t i = 0; i < mb; i++) {
+        for (size_t j = 0; j < nb; j++) {
+            c[i * ldc + j] += tile[i][j];
+        }
+    }
+}
+
+template<typename T>
+auto gemm_micro_kernel(size_t kb,
+                       const T *a, size_t rsa, size_t csa,
+                       const T *b,
+                       T *c, size_t ldc) -> std::enable_if_t<!is_simd_dense_type<T>::value, void>
+{
+    gemm_micro_kernel_cpp(gemm_mr, gemm_nr<T>(), kb, a, rsa, csa, b, c, ldc);
+}
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+/// Full gemm_mr x gemm_nr tile with the accumulators in registers
+template<typename T>
+auto gemm_micro_kernel(size_t kb,
+                       const T *a, size_t rsa, size_t csa,
+                       const T *b,
+                       T *c, size_t ldc) -> std::enable_if_t<is_simd_dense_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+
+    Packed<T> c00(consts::zero<T>), c01(consts::zero<T>);
+    Packed<T> c10(consts::zero<T>), c11(consts::zero<T>);
+    Packed<T> c20(consts::zero<T>), c21(consts::zero<T>);
+    Packed<T> c30(consts::zero<T>), c31(consts::zero<T>);
+    Packed<T> b0;
+    Packed<T> b1;
+
+    for (size_t p = 0; p < kb; p++) {
+
+        b0.loadUnaligned(b);
+        b1.loadUnaligned(b + packed_size);
+        b += 2 * packed_size;
+
+        const T *a_p = a + p * csa;
+
+        Packed<T> a0(a_p[0]);
+        c00 = internal::fmadd(a0, b0, c00);
+        c01 = internal::fmadd(a0, b1, c01);
+
+        Packed<T> a1(a_p[rsa]);
+        c10 = internal::fmadd(a1, b0, c10);
+        c11 = internal::fmadd(a1, b1, c11);
+
+        Packed<T> a2(a_p[2 * rsa]);
+        c20 = internal::fmadd(a2, b0, c20);
+        c21 = internal::fmadd(a2, b1, c21);
+
+        Packed<T> a3(a_p[3 * rsa]);
+        c30 = internal::fmadd(a3, b0, c30);
+        c31 = internal::fmadd(a3, b1, c31);
+    }
+
+    auto update = [packed_size](T *row, const Packed<T> &acc0, const Packed<T> &acc1) {
+        Packed<T> packed_c;
+        packed_c.loadUnaligned(row);
+        packed_c += acc0;
+        packed_c.storeUnaligned(row);
+        packed_c.loadUnaligned(row + packed_size);
+        packed_c += acc1;
+        packed_c.storeUnaligned(row + packed_size);
+    };
+
+    update(c, c00, c01);
+    update(c + ldc, c10, c11);
+    update(c + 2 * ldc, c20, c21);
+    update(c + 3 * ldc, c30, c31);
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+/// Workspace of gemm_kernel for products with n columns
+template<typename T>
+constexpr auto gemm_buffer_size(size_t n) -> size_t
+{
+    return gemm_kc * ((std::min(n, gemm_nc) + gemm_nr<T>() - 1) / gemm_nr<T>()) * gemm_nr<T>();
+}
+
+/*!
+ * \brief C += alpha * A * B in the calling thread
+ * \param[in] m Rows of A and C
+ * \param[in] n Columns of B and C
+ * \param[in] k Columns of A and rows of B
+ * \param[in] buffer Workspace of at least gemm_buffer_size(n) elements
+ */
+template<typename T>
+void gemm_kernel(size_t m, size_t n, size_t k, T alpha,
+                 const T *a, size_t rsa, size_t csa,
+                 const T *b, size_t rsb, size_t csb,
+                 T *c, size_t ldc,
+                 T *buffer)
+{
+    constexpr size_t nr = gemm_nr<T>();
+
+    for (size_t jc = 0; jc < n; jc += gemm_nc) {
+
+        size_t nb = std::min(gemm_nc, n - jc);
+
+        for (size_t pc = 0; pc < k; pc += gemm_kc) {
+
+            size_t kb = std::min(gemm_kc, k - pc);
+
+            gemm_pack_b(kb, nb, alpha, b + pc * rsb + jc * csb, rsb, csb, buffer);
+
+            for (size_t ir = 0; ir < m; ir += gemm_mr) {
+
+                size_t mb = std::min(gemm_mr, m - ir);
+                const T *a_tile = a + ir * rsa + pc * csa;
+
+                for (size_t jr = 0; jr < nb; jr += nr) {
+
+                    size_t jb = std::min(nr, nb - jr);
+                    const T *b_strip = buffer + (jr / nr) * kb * nr;
+                    T *c_tile = c + ir * ldc + jc + jr;
+
+                    if (mb == gemm_mr && jb == nr) {
+                        gemm_micro_kernel(kb, a_tile, rsa, csa, b_strip, c_tile, ldc);
+                    } else {
+                        gemm_micro_kernel_cpp(mb, jb, kb, a_tile, rsa, csa, b_strip, c_tile, ldc);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * \brief C += alpha * A * B
+ * The rows of C are split among threads when the product is large enough.
+ */
+template<typename T>
+void gemm(size_t m, size_t n, size_t k, T alpha,
+          const T *a, size_t rsa, size_t csa,
+          const T *b, size_t rsb, size_t csb,
+          T *c, size_t ldc)
+{
+    if (m == 0 || n == 0 || k == 0) return;
+
+    if (m <= gemm_mc || m * n * k < gemm_parallel_threshold) {
+        std::vector<T> buffer(gemm_buffer_size<T>(n));
+        gemm_kernel(m, n, k, alpha, a, rsa, csa, b, rsb, csb, c, ldc, buffer.data());
+        return;
+    }
+
+    size_t tasks = (m + gemm_mc - 1) / gemm_mc;
+
+    parallel_for(0, tasks, [&](size_t task) {
+        size_t ini = task * gemm_mc;
+        size_t rows = std::min(gemm_mc, m - ini);
+        std::vector<T> buffer(gemm_buffer_size<T>(n));
+        gemm_kernel(rows, n, k, alpha, a + ini * rsa, rsa, csa, b, rsb, csb, c + ini * ldc, ldc, buffer.data());
+    });
+}
+
+/*!
+ * \brief Solves L * X = B in place in the calling thread
+ * L is a n x n lower triangular matrix and X a row-major n x nrhs matrix.
+ * The rows below each diagonal block are updated with gemm_kernel.
+ */
+template<typename T>
+void solve_lower_triangular_kernel(size_t n, size_t nrhs, bool unit_diagonal,
+                                   const T *l, size_t rsl, size_t csl,
+                                   T *x, size_t ldx,
+                                   T *buffer)
+{
+    for (size_t i0 = 0; i0 < n; i0 += blocked_decomposition_block_size) {
+
+        size_t i1 = std::min(i0 + blocked_decomposition_block_size, n);
+
+        for (size_t i = i0; i < i1; i++) {
+
+            T *x_i = x + i * ldx;
+
+            for (size_t j = i0; j < i; j++)
+                axpy(nrhs, -l[i * rsl + j * csl], x + j * ldx, x_i);
+
+            if (!unit_diagonal)
+                scale(nrhs, consts::one<T> / l[i * (rsl + csl)], x_i);
+        }
+
+        if (i1 < n) {
+            gemm_kernel(n - i1, nrhs, i1 - i0, -consts::one<T>,
+                        l + i1 * rsl + i0 * csl, rsl, csl,
+                        x + i0 * ldx, ldx, 1,
+                        x + i1 * ldx, ldx,
+                        buffer);
+        }
+    }
+}
+
+/*!
+ * \brief Solves U * X = B in place in the calling thread
+ * U is a n x n upper triangular matrix and X a row-major n x nrhs matrix.
+ */
+template<typename T>
+void solve_upper_triangular_kernel(size_t n, size_t nrhs, bool unit_diagonal,
+                                   const T *u, size_t rsu, size_t csu,
+                                   T *x, size_t ldx,
+                                   T *buffer)
+{
+    for (size_t i1 = n; i1 > 0;) {
+
+        size_t i0 = i1 > blocked_decomposition_block_size ? i1 - blocked_decomposition_block_size : 0;
+
+        for (size_t i = i1; i-- > i0;) {
+
+            T *x_i = x + i * ldx;
+
+            for (size_t j = i + 1; j < i1; j++)
+                axpy(nrhs, -u[i * rsu + j * csu], x + j * ldx, x_i);
+
+            if (!unit_diagonal)
+                scale(nrhs, consts::one<T> / u[i * (rsu + csu)], x_i);
+        }
+
+        if (i0 > 0) {
+            gemm_kernel(i0, nrhs, i1 - i0, -consts::one<T>,
+                        u + i0 * csu, rsu, csu,
+                        x + i0 * ldx, ldx, 1,
+                        x, ldx,
+                        buffer);
+        }
+
+        i1 = i0;
+    }
+}
+
+/*!
+ * \brief Solves a triangular system with several right-hand sides
+ * The columns of X are split among threads when the system is large enough.
+ */
+template<typename T, typename Kernel>
+void solve_triangular(size_t n, size_t nrhs, T *x, Kernel kernel)
+{
+    if (n == 0 || nrhs == 0) return;
+
+    if (nrhs <= trsm_nc || n * n * nrhs < gemm_parallel_threshold) {
+        std::vector<T> buffer(gemm_buffer_size<T>(nrhs));
+        kernel(nrhs, x, buffer.data());
+        return;
+    }
+
+    size_t tasks = (nrhs + trsm_nc - 1) / trsm_nc;
+
+    parallel_for(0, tasks, [&](size_t task) {
+        size_t ini = task * trsm_nc;
+        size_t cols = std::min(trsm_nc, nrhs - ini);
+        std::vector<T> buffer(gemm_buffer_size<T>(cols));
+        kernel(cols, x + ini, buffer.data());
+    });
+}
+
+/// Solves L * X = B in place
+template<typename T>
+void solve_lower_triangular(size_t n, size_t nrhs, bool unit_diagonal,
+                            const T *l, size_t rsl, size_t csl,
+                            T *x, size_t ldx)
+{
+    solve_triangular(n, nrhs, x, [&](size_t cols, T *x_cols, T *buffer) {
+        solve_lower_triangular_kernel(n, cols, unit_diagonal, l, rsl, csl, x_cols, ldx, buffer);
+    });
+}
+
+/// Solves U * X = B in place
+template<typename T>
+void solve_upper_triangular(size_t n, size_t nrhs, bool unit_diagonal,
+                            const T *u, size_t rsu, size_t csu,
+                            T *x, size_t ldx)
+{
+    solve_triangular(n, nrhs, x, [&](size_t cols, T *x_cols, T *buffer) {
+        solve_upper_triangular_kernel(n, cols, unit_diagonal, u, rsu, csu, x_cols, ldx, buffer);
+    });
+}
+
+} // namespace internal
+
+/// \endcond
+
+/*! \} */ // end of algebra
+
+/*! \} */ // end of math
+
+} // End namespace tl
@@ -0,0 +1,412 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "tidop/math/algebra/matrix.h"
+#include "tidop/math/algebra/vector.h"
+#include "tidop/math/lapack.h"
+
+namespace tl
+{
+
+/*! \addtogroup math
+ *  \{
+ */
+
+/*! \addtogroup algebra
+ *  \{
+ */
+
+
+/*!
+ * \brief Eigen decomposition of a symmetric matrix
+ *
+ * \f[ A = V \Lambda V^T \f]
+ *
+ * The matrix is reduced to tridiagonal form with Householder transformations
+ * and the tridiagonal matrix is diagonalized with the implicit QL algorithm.
+ * Only the upper triangle of the matrix is read.
+ *
+ * The eigenvalues are sorted in ascending order and the columns of V are the
+ * corresponding orthonormal eigenvectors. For a covariance matrix the first
+ * column is the direction of least variance (the normal of a plane fit) and the
+ * last one the principal direction.
+ *
+ * For batches of 3x3 covariance matrices see eigenSymmetric3x3().
+ *
+ * \code
+ * Matrix<double, 3, 3> covariance = ...;
+ * EigenDecomposition<Matrix<double, 3, 3>> eigen(covariance);
+ * auto normal = eigen.eigenvectors().col(0);
+ * \endcode
+ */
+template<typename T>
+class EigenDecomposition;
+
+template<
+    template<typename, size_t, size_t>
+    class Matrix_t, typename T, size_t Rows, size_t Cols>
+class EigenDecomposition<Matrix_t<T, Rows, Cols>>
+{
+
+public:
+
+    EigenDecomposition(const Matrix_t<T, Rows, Cols> &a);
+
+    auto eigenvalues() const -> Vector<T, Rows>;
+    auto eigenvectors() const -> Matrix<T, Rows, Cols>;
+
+private:
+
+    void decompose();
+    void tridiagonalize();
+    void diagonalize();
+#ifdef TL_HAVE_OPENBLAS
+    void lapackDecompose();
+#endif // TL_HAVE_OPENBLAS
+
+private:
+
+    Matrix<T, Rows, Cols> V;
+    Vector<T, Rows> D;
+    Vector<T, Rows> E;
+    size_t mSize;
+};
+
+
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+EigenDecomposition<Matrix_t<T, Rows, Cols>>::EigenDecomposition(const Matrix_t<T, Rows, Cols> &a)
+  : V(a),
+    mSize(a.rows())
+{
+    static_assert(std::is_floating_point<T>::value, "Integral type not supported");
+
+    TL_ASSERT(a.rows() == a.cols(), "Non-Square Matrix");
+
+    D = Vector<T, Rows>(mSize);
+    E = Vector<T, Rows>(mSize);
+
+#ifdef TL_HAVE_OPENBLAS
+    this->lapackDecompose();
+#else
+    this->decompose();
+#endif // TL_HAVE_OPENBLAS
+}
+
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+void EigenDecomposition<Matrix_t<T, Rows, Cols>>::decompose()
+{
+    /// Only the upper triangle is used
+    for (size_t i = 0; i < mSize; i++)
+        for (size_t j = 0; j < i; j++)
+            V[i][j] = V[j][i];
+
+    this->tridiagonalize();
+    this->diagonalize();
+}
+
+/*!
+ * Householder reduction to tridiagonal form (tred2).
+ * On output D is the diagonal, E the subdiagonal (E[0] = 0) and V the
+ * accumulated orthogonal transformation.
+ */
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+void EigenDecomposition<Matrix_t<T, Rows, Cols>>::tridiagonalize()
+{
+    size_t n = mSize;
+
+    if (n == 0) return;
+
+    for (size_t j = 0; j < n; j++)
+        D[j] = V[n - 1][j];
+
+    for (size_t i = n - 1; i > 0; i--) {
+
+        T scale = consts::zero<T>;
+        T h = consts::zero<T>;
+
+        for (size_t k = 0; k < i; k++)
+            scale += std::abs(D[k]);
+
+        if (scale == consts::zero<T>) {
+
+            E[i] = D[i - 1];
+            for (size_t j = 0; j < i; j++) {
+                D[j] = V[i - 1][j];
+                V[i][j] = consts::zero<T>;
+                V[j][i] = consts::zero<T>;
+            }
+
+        } else {
+
+            for (size_t k = 0; k < i; k++) {
+                D[k] /= scale;
+                h += D[k] * D[k];
+            }
+
+            T f = D[i - 1];
+            T g = std::sqrt(h);
+            if (f > consts::zero<T>) g = -g;
+            E[i] = scale * g;
+            h -= f * g;
+            D[i - 1] = f - g;
+
+            for (size_t j = 0; j < i; j++)
+                E[j] = consts::zero<T>;
+
+            for (size_t j = 0; j < i; j++) {
+                f = D[j];
+                V[j][i] = f;
+                g = E[j] + V[j][j] * f;
+                for (size_t k = j + 1; k <= i - 1; k++) {
+                    g += V[k][j] * D[k];
+                    E[k] += V[k][j] * f;
+                }
+                E[j] = g;
+            }
+
+            f = consts::zero<T>;
+            for (size_t j = 0; j < i; j++) {
+                E[j] /= h;
+                f += E[j] * D[j];
+            }
+
+            T hh = f / (h + h);
+            for (size_t j = 0; j < i; j++)
+                E[j] -= hh * D[j];
+
+            for (size_t j = 0; j < i; j++) {
+                f = D[j];
+                g = E[j];
+                for (size_t k = j; k <= i - 1; k++)
+                    V[k][j] -= (f * E[k] + g * D[k]);
+                D[j] = V[i - 1][j];
+                V[i][j] = consts::zero<T>;
+            }
+        }
+
+        D[i] = h;
+    }
+
+    /// Accumulate transformations
+
+    for (size_t i = 0; i < n - 1; i++) {
+
+        V[n - 1][i] = V[i][i];
+        V[i][i] = consts::one<T>;
+        T h = D[i + 1];
+
+        if (h != consts::zero<T>) {
+            for (size_t k = 0; k <= i; k++)
+                D[k] = V[k][i + 1] / h;
+            for (size_t j = 0; j <= i; j++) {
+                T g = consts::zero<T>;
+                for (size_t k = 0; k <= i; k++)
+                    g += V[k][i + 1] * V[k][j];
+                for (size_t k = 0; k <= i; k++)
+                    V[k][j] -= g * D[k];
+            }
+        }
+
+        for (size_t k = 0; k <= i; k++)
+            V[k][i + 1] = consts::zero<T>;
+    }
+
+    for (size_t j = 0; j < n; j++) {
+        D[j] = V[n - 1][j];
+        V[n - 1][j] = consts::zero<T>;
+    }
+
+    V[n - 1][n - 1] = consts::one<T>;
+    E[0] = consts::zero<T>;
+}
+
+/*!
+ * Implicit QL iterations on the tridiagonal matrix (tql2). The eigenvalues and
+ * the eigenvectors are sorted in ascending order.
+ */
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+void EigenDecomposition<Matrix_t<T, Rows, Cols>>::diagonalize()
+{
+    size_t n = mSize;
+
+    if (n == 0) return;
+
+    for (size_t i = 1; i < n; i++)
+        E[i - 1] = E[i];
+    E[n - 1] = consts::zero<T>;
+
+    T f = consts::zero<T>;
+    T tst1 = consts::zero<T>;
+    T eps = std::numeric_limits<T>::epsilon();
+
+    for (size_t l = 0; l < n; l++) {
+
+        /// Find small subdiagonal element
+        tst1 = std::max(tst1, std::abs(D[l]) + std::abs(E[l]));
+        size_t m = l;
+        while (m < n - 1) {
+            if (std::abs(E[m]) <= eps * tst1) break;
+            m++;
+        }
+
+        /// If m == l, D[l] is already an eigenvalue, otherwise iterate
+
+        if (m > l) {
+
+            do {
+
+                /// Compute implicit shift
+                T g = D[l];
+                T p = (D[l + 1] - g) / (2 * E[l]);
+                T r = std::hypot(p, consts::one<T>);
+                if (p < consts::zero<T>) r = -r;
+                D[l] = E[l] / (p + r);
+                D[l + 1] = E[l] * (p + r);
+                T dl1 = D[l + 1];
+                T h = g - D[l];
+                for (size_t i = l + 2; i < n; i++)
+                    D[i] -= h;
+                f += h;
+
+                /// Implicit QL transformation
+                p = D[m];
+                T c = consts::one<T>;
+                T c2 = c;
+                T c3 = c;
+                T el1 = E[l + 1];
+                T s = consts::zero<T>;
+                T s2 = consts::zero<T>;
+
+                for (size_t i = m; i-- > l;) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * E[i];
+                    h = c * p;
+                    r = std::hypot(p, E[i]);
+                    E[i + 1] = s * r;
+                    s = E[i] / r;
+                    c = p / r;
+                    p = c * D[i] - s * g;
+                    D[i + 1] = h + s * (c * g + s * D[i]);
+
+                    /// Accumulate transformation
+                    for (size_t k = 0; k < n; k++) {
+                        h = V[k][i + 1];
+                        V[k][i + 1] = s * V[k][i] + c * h;
+                        V[k][i] = c * V[k][i] - s * h;
+                    }
+                }
+
+                p = -s * s2 * c3 * el1 * E[l] / dl1;
+                E[l] = s * p;
+                D[l] = c * p;
+
+            } while (std::abs(E[l]) > eps * tst1);
+        }
+
+        D[l] = D[l] + f;
+        E[l] = consts::zero<T>;
+    }
+
+    /// Sort eigenvalues and corresponding vectors
+
+    for (size_t i = 0; i + 1 < n; i++) {
+
+        size_t k = i;
+        T p = D[i];
+        for (size_t j = i + 1; j < n; j++) {
+            if (D[j] < p) {
+                k = j;
+                p = D[j];
+            }
+        }
+
+        if (k != i) {
+            D[k] = D[i];
+            D[i] = p;
+            for (size_t j = 0; j < n; j++)
+                std::swap(V[j][i], V[j][k]);
+        }
+    }
+}
+
+#ifdef TL_HAVE_OPENBLAS
+
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+inline void EigenDecomposition<Matrix_t<T, Rows, Cols>>::lapackDecompose()
+{
+    lapack_int n = static_cast<lapack_int>(mSize);
+    lapack_int info = lapack::syev(n, V.data(), n, D.data());
+
+    TL_ASSERT(info == 0, "The algorithm computing the eigen decomposition failed to converge.");
+}
+
+#endif // TL_HAVE_OPENBLAS
+
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+auto EigenDecomposition<Matrix_t<T, Rows, Cols>>::eigenvalues() const -> Vector<T, Rows>
+{
+    return D;
+}
+
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+auto EigenDecomposition<Matrix_t<T, Rows, Cols>>::eigenvectors() const -> Matrix<T, Rows, Cols>
+{
+    return V;
+}
+
+
+/*! \} */ // end of algebra
+
+/*! \} */ // end of math
+
+} // End namespace tl
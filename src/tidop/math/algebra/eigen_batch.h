@@ -0,0 +1,603 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/math.h"
+#include "tidop/math/simd.h"
+
+namespace tl
+{
+
+/*! \addtogroup math
+ *  \{
+ */
+
+/*! \addtogroup algebra
+ *  \{
+ */
+
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * Closed-form eigen decomposition of 3x3 symmetric matrices stored as six
+ * separate arrays (structure of arrays).
+ *
+ * The eigenvalues are first estimated with the trigonometric solution of the
+ * characteristic polynomial (O. K. Smith, "Eigenvalues of a symmetric 3 × 3
+ * matrix", Commun. ACM 4, 4 (April 1961), 168, doi: 10.1145/355578.366316) on
+ * the matrix scaled by its largest element. acos loses precision when two
+ * eigenvalues are close, so only the most isolated eigenvalue (the smallest or
+ * the largest) is used: its eigenvector is the largest cross product of two
+ * rows of A - lambda * I, which is well conditioned. The other two eigenpairs
+ * are solved in closed form from the 2x2 matrix A restricted to the plane
+ * orthogonal to that eigenvector (D. Eberly, "A Robust Eigensolver for 3 × 3
+ * Symmetric Matrices", Geometric Tools, 2014).
+ */
+
+/// Number of matrices processed by each task
+constexpr size_t eigen_batch_block_size = 4096;
+/// Batches smaller than this are processed in the calling thread
+constexpr size_t eigen_batch_parallel_threshold = 16384;
+/// Matrices processed by each pass of the vectorized kernel
+constexpr size_t eigen_batch_chunk_size = 64;
+
+template<typename T>
+struct is_simd_eigen_type
+#ifdef TL_HAVE_SIMD_INTRINSICS
+  : std::integral_constant<bool, std::is_same<float, std::remove_cv_t<T>>::value ||
+                                 std::is_same<double, std::remove_cv_t<T>>::value>
+#else
+  : std::false_type
+#endif
+{
+};
+
+/*!
+ * \brief Eigen decomposition of a single matrix
+ * \param[out] lambda Eigenvalues in ascending order
+ * \param[out] v Unit eigenvector of lambda[0]
+ */
+template<typename T>
+void eigen_symmetric_3x3(T a00, T a01, T a02, T a11, T a12, T a22,
+                         T lambda[3], T v[3])
+{
+    T scale = std::max(std::max(std::max(std::abs(a00), std::abs(a01)), std::max(std::abs(a02), std::abs(a11))),
+                       std::max(std::abs(a12), std::abs(a22)));
+
+    v[0] = consts::zero<T>;
+    v[1] = consts::zero<T>;
+    v[2] = consts::one<T>;
+
+    if (scale == consts::zero<T>) {
+        lambda[0] = lambda[1] = lambda[2] = consts::zero<T>;
+        return;
+    }
+
+    T inv_scale = consts::one<T> / scale;
+    a00 *= inv_scale;
+    a01 *= inv_scale;
+    a02 *= inv_scale;
+    a11 *= inv_scale;
+    a12 *= inv_scale;
+    a22 *= inv_scale;
+
+    T q = (a00 + a11 + a22) / 3;
+    T b00 = a00 - q;
+    T b11 = a11 - q;
+    T b22 = a22 - q;
+    T p1 = a01 * a01 + a02 * a02 + a12 * a12;
+    T p2 = b00 * b00 + b11 * b11 + b22 * b22 + 2 * p1;
+    T p = std::sqrt(p2 / 6);
+
+    if (p <= std::numeric_limits<T>::epsilon()) {
+        /// Multiple of the identity
+        lambda[0] = lambda[1] = lambda[2] = q * scale;
+        return;
+    }
+
+    T det = b00 * (b11 * b22 - a12 * a12) - a01 * (a01 * b22 - a12 * a02) + a02 * (a01 * a12 - b11 * a02);
+    T r = det / (2 * p * p * p);
+    r = std::min(std::max(r, -consts::one<T>), consts::one<T>);
+    T phi = std::acos(r) / 3;
+
+    T l2 = q + 2 * p * std::cos(phi);
+    T l0 = q + 2 * p * std::cos(phi + consts::two_pi<T> / 3);
+    T l1 = 3 * q - l2 - l0;
+
+    bool isolated_max = l2 - l1 > l1 - l0;
+    T li = isolated_max ? l2 : l0;
+
+    /// Eigenvector of the isolated eigenvalue from the rows of A - li * I
+
+    T r0[3] = {a00 - li, a01, a02};
+    T r1[3] = {a01, a11 - li, a12};
+    T r2[3] = {a02, a12, a22 - li};
+
+    T c01[3] = {r0[1] * r1[2] - r0[2] * r1[1], r0[2] * r1[0] - r0[0] * r1[2], r0[0] * r1[1] - r0[1] * r1[0]};
+    T c02[3] = {r0[1] * r2[2] - r0[2] * r2[1], r0[2] * r2[0] - r0[0] * r2[2], r0[0] * r2[1] - r0[1] * r2[0]};
+    T c12[3] = {r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0]};
+
+    T n01 = c01[0] * c01[0] + c01[1] * c01[1] + c01[2] * c01[2];
+    T n02 = c02[0] * c02[0] + c02[1] * c02[1] + c02[2] * c02[2];
+    T n12 = c12[0] * c12[0] + c12[1] * c12[1] + c12[2] * c12[2];
+
+    const T *c = c01;
+    T n = n01;
+    if (n02 > n) {
+        c = c02;
+        n = n02;
+    }
+    if (n12 > n) {
+        c = c12;
+        n = n12;
+    }
+
+    T e[3] = {consts::zero<T>, consts::zero<T>, consts::one<T>};
+    if (n > consts::zero<T>) {
+        T inv = consts::one<T> / std::sqrt(n);
+        e[0] = c[0] * inv;
+        e[1] = c[1] * inv;
+        e[2] = c[2] * inv;
+    }
+
+    /// Orthonormal basis (u, w) of the plane orthogonal to e
+
+    T u[3];
+    if (std::abs(e[0]) > std::abs(e[1])) {
+        T inv = consts::one<T> / std::sqrt(e[0] * e[0] + e[2] * e[2]);
+        u[0] = -e[2] * inv;
+        u[1] = consts::zero<T>;
+        u[2] = e[0] * inv;
+    } else {
+        T inv = consts::one<T> / std::sqrt(e[1] * e[1] + e[2] * e[2]);
+        u[0] = consts::zero<T>;
+        u[1] = e[2] * inv;
+        u[2] = -e[1] * inv;
+    }
+
+    T w[3] = {e[1] * u[2] - e[2] * u[1],
+              e[2] * u[0] - e[0] * u[2],
+              e[0] * u[1] - e[1] * u[0]};
+
+    T ae[3] = {a00 * e[0] + a01 * e[1] + a02 * e[2],
+               a01 * e[0] + a11 * e[1] + a12 * e[2],
+               a02 * e[0] + a12 * e[1] + a22 * e[2]};
+    T au[3] = {a00 * u[0] + a01 * u[1] + a02 * u[2],
+               a01 * u[0] + a11 * u[1] + a12 * u[2],
+               a02 * u[0] + a12 * u[1] + a22 * u[2]};
+    T aw[3] = {a00 * w[0] + a01 * w[1] + a02 * w[2],
+               a01 * w[0] + a11 * w[1] + a12 * w[2],
+               a02 * w[0] + a12 * w[1] + a22 * w[2]};
+
+    /// Rayleigh quotient of the isolated eigenvalue
+    T rayleigh = e[0] * ae[0] + e[1] * ae[1] + e[2] * ae[2];
+
+    /// 2x2 matrix [m00 m01; m01 m11] in the basis (u, w)
+    T m00 = u[0] * au[0] + u[1] * au[1] + u[2] * au[2];
+    T m01 = u[0] * aw[0] + u[1] * aw[1] + u[2] * aw[2];
+    T m11 = w[0] * aw[0] + w[1] * aw[1] + w[2] * aw[2];
+    T mean = (m00 + m11) / 2;
+    T half = (m00 - m11) / 2;
+    T radius = std::sqrt(half * half + m01 * m01);
+    T low = mean - radius;
+    T high = mean + radius;
+
+    if (isolated_max) {
+
+        lambda[0] = low * scale;
+        lambda[1] = high * scale;
+        lambda[2] = rayleigh * scale;
+
+        /// Eigenvector of the 2x2 matrix for the smallest eigenvalue
+        T x0 = m01;
+        T y0 = low - m00;
+        T x1 = low - m11;
+        T y1 = m01;
+        T s0 = x0 * x0 + y0 * y0;
+        T s1 = x1 * x1 + y1 * y1;
+        T x = s0 > s1 ? x0 : x1;
+        T y = s0 > s1 ? y0 : y1;
+        T s = std::max(s0, s1);
+
+        if (s > consts::zero<T>) {
+            T inv = consts::one<T> / std::sqrt(s);
+            x *= inv;
+            y *= inv;
+        } else {
+            x = consts::one<T>;
+            y = consts::zero<T>;
+        }
+
+        v[0] = x * u[0] + y * w[0];
+        v[1] = x * u[1] + y * w[1];
+        v[2] = x * u[2] + y * w[2];
+
+    } else {
+
+        lambda[0] = rayleigh * scale;
+        lambda[1] = low * scale;
+        lambda[2] = high * scale;
+
+        v[0] = e[0];
+        v[1] = e[1];
+        v[2] = e[2];
+    }
+}
+
+template<typename T>
+void eigen_symmetric_3x3_cpp(const T *a00, const T *a01, const T *a02,
+                             const T *a11, const T *a12, const T *a22,
+                             T *lambda0, T *lambda1, T *lambda2,
+                             T *vx, T *vy, T *vz,
+                             size_t ini, size_t end)
+{
+    T lambda[3];
+    T v[3];
+
+    for (size_t i = ini; i < end; i++) {
+
+        eigen_symmetric_3x3(a00[i], a01[i], a02[i], a11[i], a12[i], a22[i], lambda, v);
+
+        lambda0[i] = lambda[0];
+        lambda1[i] = lambda[1];
+        lambda2[i] = lambda[2];
+
+        if (vx) {
+            vx[i] = v[0];
+            vy[i] = v[1];
+            vz[i] = v[2];
+        }
+    }
+}
+
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+/*!
+ * Vectorized kernel. The arithmetic runs on packed registers, acos and cos are
+ * evaluated lane by lane, and the zero matrices and the multiples of the
+ * identity are recomputed with the scalar kernel.
+ */
+template<typename T>
+auto eigen_symmetric_3x3_block(const T *a00, const T *a01, const T *a02,
+                               const T *a11, const T *a12, const T *a22,
+                               T *lambda0, T *lambda1, T *lambda2,
+                               T *vx, T *vy, T *vz,
+                               size_t ini, size_t end) -> std::enable_if_t<is_simd_eigen_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    constexpr size_t chunk = eigen_batch_chunk_size;
+
+    static_assert(chunk % packed_size == 0, "The chunk size must be a multiple of the packed size");
+
+    alignas(32) T scale[chunk];
+    alignas(32) T q[chunk];
+    alignas(32) T p[chunk];
+    alignas(32) T cos_max[chunk];
+    alignas(32) T cos_min[chunk];
+
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> one(consts::one<T>);
+    const Packed<T> two(static_cast<T>(2));
+    const Packed<T> three(static_cast<T>(3));
+    const Packed<T> six(static_cast<T>(6));
+
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    for (size_t first = ini; first < max_vector; first += chunk) {
+
+        size_t last = std::min(first + chunk, max_vector);
+
+        /// Invariants of the scaled matrix
+
+        for (size_t i = first; i < last; i += packed_size) {
+
+            Packed<T> m00, m01, m02, m11, m12, m22;
+            m00.loadUnaligned(&a00[i]);
+            m01.loadUnaligned(&a01[i]);
+            m02.loadUnaligned(&a02[i]);
+            m11.loadUnaligned(&a11[i]);
+            m12.loadUnaligned(&a12[i]);
+            m22.loadUnaligned(&a22[i]);
+
+            Packed<T> s = internal::max(internal::max(internal::max(m00, -m00), internal::max(m01, -m01)),
+                                        internal::max(internal::max(m02, -m02), internal::max(m11, -m11)));
+            s = internal::max(s, internal::max(internal::max(m12, -m12), internal::max(m22, -m22)));
+
+            Packed<T> inv_scale = one / s;
+            m00 *= inv_scale;
+            m01 *= inv_scale;
+            m02 *= inv_scale;
+            m11 *= inv_scale;
+            m12 *= inv_scale;
+            m22 *= inv_scale;
+
+            Packed<T> _q = (m00 + m11 + m22) / three;
+            Packed<T> b00 = m00 - _q;
+            Packed<T> b11 = m11 - _q;
+            Packed<T> b22 = m22 - _q;
+            Packed<T> p1 = internal::fmadd(m01, m01, internal::fmadd(m02, m02, m12 * m12));
+            Packed<T> p2 = internal::fmadd(b00, b00, internal::fmadd(b11, b11, internal::fmadd(b22, b22, two * p1)));
+            Packed<T> _p = internal::squareRoot(p2 / six);
+
+            Packed<T> det = b00 * (b11 * b22 - m12 * m12) - m01 * (m01 * b22 - m12 * m02) + m02 * (m01 * m12 - b11 * m02);
+            Packed<T> r = det / (two * _p * _p * _p);
+
+            size_t k = i - first;
+            s.storeAligned(&scale[k]);
+            _q.storeAligned(&q[k]);
+            _p.storeAligned(&p[k]);
+            r.storeAligned(&cos_max[k]);
+        }
+
+        /// Trigonometric solution
+
+        for (size_t k = 0; k < last - first; k++) {
+            T r = cos_max[k];
+            r = r < -consts::one<T> ? -consts::one<T> : (r > consts::one<T> ? consts::one<T> : r);
+            T phi = std::acos(r) / 3;
+            cos_max[k] = std::cos(phi);
+            cos_min[k] = std::cos(phi + consts::two_pi<T> / 3);
+        }
+
+        /// Eigenvector of the isolated eigenvalue and 2x2 problem in the orthogonal plane
+
+        for (size_t i = first; i < last; i += packed_size) {
+
+            size_t k = i - first;
+
+            Packed<T> s, _q, _p, _cos_max, _cos_min;
+            s.loadAligned(&scale[k]);
+            _q.loadAligned(&q[k]);
+            _p.loadAligned(&p[k]);
+            _cos_max.loadAligned(&cos_max[k]);
+            _cos_min.loadAligned(&cos_min[k]);
+
+            Packed<T> l2 = internal::fmadd(two * _p, _cos_max, _q);
+            Packed<T> l0 = internal::fmadd(two * _p, _cos_min, _q);
+            Packed<T> l1 = three * _q - l2 - l0;
+
+            Packed<T> isolated_max = internal::greaterThan(l2 - l1, l1 - l0);
+            Packed<T> li = internal::select(isolated_max, l2, l0);
+
+            Packed<T> m00, m01, m02, m11, m12, m22;
+            m00.loadUnaligned(&a00[i]);
+            m01.loadUnaligned(&a01[i]);
+            m02.loadUnaligned(&a02[i]);
+            m11.loadUnaligned(&a11[i]);
+            m12.loadUnaligned(&a12[i]);
+            m22.loadUnaligned(&a22[i]);
+
+            Packed<T> inv_scale = one / s;
+            m00 *= inv_scale;
+            m01 *= inv_scale;
+            m02 *= inv_scale;
+            m11 *= inv_scale;
+            m12 *= inv_scale;
+            m22 *= inv_scale;
+
+            /// Cross products of the rows (r00, m01, m02), (m01, r11, m12) and (m02, m12, r22)
+            Packed<T> r00 = m00 - li;
+            Packed<T> r11 = m11 - li;
+            Packed<T> r22 = m22 - li;
+
+            Packed<T> c01x = m01 * m12 - m02 * r11;
+            Packed<T> c01y = m02 * m01 - r00 * m12;
+            Packed<T> c01z = r00 * r11 - m01 * m01;
+            Packed<T> c02x = m01 * r22 - m02 * m12;
+            Packed<T> c02y = m02 * m02 - r00 * r22;
+            Packed<T> c02z = r00 * m12 - m01 * m02;
+            Packed<T> c12x = r11 * r22 - m12 * m12;
+            Packed<T> c12y = m12 * m02 - m01 * r22;
+            Packed<T> c12z = m01 * m12 - r11 * m02;
+
+            Packed<T> n01 = internal::fmadd(c01x, c01x, internal::fmadd(c01y, c01y, c01z * c01z));
+            Packed<T> n02 = internal::fmadd(c02x, c02x, internal::fmadd(c02y, c02y, c02z * c02z));
+            Packed<T> n12 = internal::fmadd(c12x, c12x, internal::fmadd(c12y, c12y, c12z * c12z));
+
+            Packed<T> mask = internal::greaterThan(n02, n01);
+            Packed<T> ex = internal::select(mask, c02x, c01x);
+            Packed<T> ey = internal::select(mask, c02y, c01y);
+            Packed<T> ez = internal::select(mask, c02z, c01z);
+            Packed<T> n = internal::max(n01, n02);
+
+            mask = internal::greaterThan(n12, n);
+            ex = internal::select(mask, c12x, ex);
+            ey = internal::select(mask, c12y, ey);
+            ez = internal::select(mask, c12z, ez);
+            n = internal::max(n, n12);
+
+            Packed<T> inv = one / internal::squareRoot(n);
+            ex *= inv;
+            ey *= inv;
+            ez *= inv;
+
+            /// Orthonormal basis (u, w) of the plane orthogonal to e
+
+            mask = internal::greaterThan(internal::max(ex, -ex), internal::max(ey, -ey));
+            Packed<T> ux = internal::select(mask, -ez, zero);
+            Packed<T> uy = internal::select(mask, zero, ez);
+            Packed<T> uz = internal::select(mask, ex, -ey);
+            inv = one / internal::squareRoot(internal::fmadd(ux, ux, internal::fmadd(uy, uy, uz * uz)));
+            ux *= inv;
+            uy *= inv;
+            uz *= inv;
+
+            Packed<T> wx = ey * uz - ez * uy;
+            Packed<T> wy = ez * ux - ex * uz;
+            Packed<T> wz = ex * uy - ey * ux;
+
+            Packed<T> rayleigh = ex * internal::fmadd(m00, ex, internal::fmadd(m01, ey, m02 * ez)) +
+                                 ey * internal::fmadd(m01, ex, internal::fmadd(m11, ey, m12 * ez)) +
+                                 ez * internal::fmadd(m02, ex, internal::fmadd(m12, ey, m22 * ez));
+
+            Packed<T> aux = internal::fmadd(m00, ux, internal::fmadd(m01, uy, m02 * uz));
+            Packed<T> auy = internal::fmadd(m01, ux, internal::fmadd(m11, uy, m12 * uz));
+            Packed<T> auz = internal::fmadd(m02, ux, internal::fmadd(m12, uy, m22 * uz));
+            Packed<T> awx = internal::fmadd(m00, wx, internal::fmadd(m01, wy, m02 * wz));
+            Packed<T> awy = internal::fmadd(m01, wx, internal::fmadd(m11, wy, m12 * wz));
+            Packed<T> awz = internal::fmadd(m02, wx, internal::fmadd(m12, wy, m22 * wz));
+
+            Packed<T> p00 = internal::fmadd(ux, aux, internal::fmadd(uy, auy, uz * auz));
+            Packed<T> p01 = internal::fmadd(ux, awx, internal::fmadd(uy, awy, uz * awz));
+            Packed<T> p11 = internal::fmadd(wx, awx, internal::fmadd(wy, awy, wz * awz));
+            Packed<T> mean = (p00 + p11) / two;
+            Packed<T> half = (p00 - p11) / two;
+            Packed<T> radius = internal::squareRoot(internal::fmadd(half, half, p01 * p01));
+            Packed<T> low = mean - radius;
+            Packed<T> high = mean + radius;
+
+            (internal::select(isolated_max, low, rayleigh) * s).storeUnaligned(&lambda0[i]);
+            (internal::select(isolated_max, high, low) * s).storeUnaligned(&lambda1[i]);
+            (internal::select(isolated_max, rayleigh, high) * s).storeUnaligned(&lambda2[i]);
+
+            if (vx) {
+
+                /// Eigenvector of the 2x2 matrix for the smallest eigenvalue
+                Packed<T> x0 = p01;
+                Packed<T> y0 = low - p00;
+                Packed<T> x1 = low - p11;
+                Packed<T> y1 = p01;
+                Packed<T> s0 = internal::fmadd(x0, x0, y0 * y0);
+                Packed<T> s1 = internal::fmadd(x1, x1, y1 * y1);
+                mask = internal::greaterThan(s0, s1);
+                Packed<T> x = internal::select(mask, x0, x1);
+                Packed<T> y = internal::select(mask, y0, y1);
+                Packed<T> norm = internal::max(s0, s1);
+                mask = internal::greaterThan(norm, zero);
+                inv = one / internal::squareRoot(internal::select(mask, norm, one));
+                x = internal::select(mask, x * inv, one);
+                y = internal::select(mask, y * inv, zero);
+
+                internal::select(isolated_max, internal::fmadd(x, ux, y * wx), ex).storeUnaligned(&vx[i]);
+                internal::select(isolated_max, internal::fmadd(x, uy, y * wy), ey).storeUnaligned(&vy[i]);
+                internal::select(isolated_max, internal::fmadd(x, uz, y * wz), ez).storeUnaligned(&vz[i]);
+            }
+        }
+
+        /// Zero matrices and multiples of the identity
+
+        for (size_t i = first; i < last; i++) {
+            size_t k = i - first;
+            if (!(scale[k] > consts::zero<T>) || !(p[k] > std::numeric_limits<T>::epsilon())) {
+                eigen_symmetric_3x3_cpp(a00, a01, a02, a11, a12, a22,
+                                        lambda0, lambda1, lambda2,
+                                        vx, vy, vz, i, i + 1);
+            }
+        }
+    }
+
+    eigen_symmetric_3x3_cpp(a00, a01, a02, a11, a12, a22,
+                            lambda0, lambda1, lambda2,
+                            vx, vy, vz, max_vector, end);
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+auto eigen_symmetric_3x3_block(const T *a00, const T *a01, const T *a02,
+                               const T *a11, const T *a12, const T *a22,
+                               T *lambda0, T *lambda1, T *lambda2,
+                               T *vx, T *vy, T *vz,
+                               size_t ini, size_t end) -> std::enable_if_t<!is_simd_eigen_type<T>::value, void>
+{
+    eigen_symmetric_3x3_cpp(a00, a01, a02, a11, a12, a22,
+                            lambda0, lambda1, lambda2,
+                            vx, vy, vz, ini, end);
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Eigen decomposition of a batch of 3x3 symmetric matrices
+ *
+ * The matrices are stored as six arrays with the upper triangle elements
+ * (structure of arrays), the layout of the covariance matrices of the
+ * neighbourhoods of a point cloud. Returns the eigenvalues in ascending order
+ * and the unit eigenvector of the smallest eigenvalue (the normal of the
+ * neighbourhood). The vectors are not computed if vx is null.
+ *
+ * The batch is split in blocks that run in parallel, and each block is
+ * vectorized when SIMD intrinsics are available.
+ *
+ * \code
+ * eigenSymmetric3x3(xx.data(), xy.data(), xz.data(), yy.data(), yz.data(), zz.data(),
+ *                   l0.data(), l1.data(), l2.data(),
+ *                   nx.data(), ny.data(), nz.data(),
+ *                   xx.size());
+ *
+ * // Surface variation (curvature)
+ * double curvature = l0[i] / (l0[i] + l1[i] + l2[i]);
+ * \endcode
+ */
+template<typename T>
+void eigenSymmetric3x3(const T *a00, const T *a01, const T *a02,
+                       const T *a11, const T *a12, const T *a22,
+                       T *lambda0, T *lambda1, T *lambda2,
+                       T *vx, T *vy, T *vz,
+                       size_t size)
+{
+    static_assert(std::is_floating_point<T>::value, "Integral type not supported");
+
+    auto kernel = [&](size_t ini, size_t end) {
+        internal::eigen_symmetric_3x3_block(a00, a01, a02, a11, a12, a22,
+                                            lambda0, lambda1, lambda2,
+                                            vx, vy, vz, ini, end);
+    };
+
+    if (size < internal::eigen_batch_parallel_threshold) {
+        kernel(0, size);
+        return;
+    }
+
+    size_t blocks = (size + internal::eigen_batch_block_size - 1) / internal::eigen_batch_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * internal::eigen_batch_block_size;
+        size_t end = std::min(ini + internal::eigen_batch_block_size, size);
+        kernel(ini, end);
+    });
+}
+
+
+/*! \} */ // end of algebra
+
+/*! \} */ // end of math
+
+} // End namespace tl
@@ -0,0 +1,566 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include "tidop/math/math.h"
+#include "tidop/math/simd.h"
+
+namespace tl
+{
+
+/*! \addtogroup math
+ *  \{
+ */
+
+/*! \addtogroup algebra
+ *  \{
+ */
+
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * Fully unrolled kernels for 2x2, 3x3 and 4x4 matrices.
+ *
+ * Matrices are row-major arrays of 4, 9 or 16 elements. The scalar kernels
+ * are constexpr, so they can be evaluated at compile time on local arrays.
+ * The output must not alias the inputs unless stated otherwise.
+ *
+ * The 4x4 float and double product, transpose and matrix-vector product have
+ * SIMD versions that keep each row in one SSE/AVX register (two registers for
+ * double rows without AVX). The overloads without suffix pick the SIMD
+ * version for float and double when it is available.
+ */
+
+
+/* Determinant */
+
+template<typename T>
+constexpr auto determinant2x2(const T *m) -> T
+{
+    return m[0] * m[3] - m[1] * m[2];
+}
+
+template<typename T>
+constexpr auto determinant3x3(const T *m) -> T
+{
+    return m[0] * (m[4] * m[8] - m[5] * m[7])
+         + m[1] * (m[5] * m[6] - m[3] * m[8])
+         + m[2] * (m[3] * m[7] - m[4] * m[6]);
+}
+
+template<typename T>
+constexpr auto determinant4x4(const T *m) -> T
+{
+    T a0 = m[0] * m[5] - m[1] * m[4];
+    T a1 = m[0] * m[6] - m[2] * m[4];
+    T a2 = m[0] * m[7] - m[3] * m[4];
+    T a3 = m[1] * m[6] - m[2] * m[5];
+    T a4 = m[1] * m[7] - m[3] * m[5];
+    T a5 = m[2] * m[7] - m[3] * m[6];
+    T b0 = m[8] * m[13] - m[9] * m[12];
+    T b1 = m[8] * m[14] - m[10] * m[12];
+    T b2 = m[8] * m[15] - m[11] * m[12];
+    T b3 = m[9] * m[14] - m[10] * m[13];
+    T b4 = m[9] * m[15] - m[11] * m[13];
+    T b5 = m[10] * m[15] - m[11] * m[14];
+
+    return a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+}
+
+
+/* Inverse */
+
+/*!
+ * The inverse kernels return false and leave the output untouched when the
+ * matrix is singular. The output may alias the input.
+ */
+
+template<typename T>
+constexpr auto inverse2x2(const T *m, T *inv) -> bool
+{
+    T det = determinant2x2(m);
+    if(det == consts::zero<T>) return false;
+
+    T inv_det = consts::one<T> / det;
+
+    T m00 = m[0];
+    T m01 = m[1];
+    T m10 = m[2];
+    T m11 = m[3];
+
+    inv[0] = m11 * inv_det;
+    inv[1] = -m01 * inv_det;
+    inv[2] = -m10 * inv_det;
+    inv[3] = m00 * inv_det;
+
+    return true;
+}
+
+template<typename T>
+constexpr auto inverse3x3(const T *m, T *inv) -> bool
+{
+    T c00 = m[4] * m[8] - m[5] * m[7];
+    T c01 = m[2] * m[7] - m[1] * m[8];
+    T c02 = m[1] * m[5] - m[2] * m[4];
+    T c10 = m[5] * m[6] - m[3] * m[8];
+    T c11 = m[0] * m[8] - m[2] * m[6];
+    T c12 = m[2] * m[3] - m[0] * m[5];
+    T c20 = m[3] * m[7] - m[4] * m[6];
+    T c21 = m[1] * m[6] - m[0] * m[7];
+    T c22 = m[0] * m[4] - m[1] * m[3];
+
+    T det = m[0] * c00 + m[1] * c10 + m[2] * c20;
+    if(det == consts::zero<T>) return false;
+
+    T inv_det = consts::one<T> / det;
+
+    inv[0] = c00 * inv_det;
+    inv[1] = c01 * inv_det;
+    inv[2] = c02 * inv_det;
+    inv[3] = c10 * inv_det;
+    inv[4] = c11 * inv_det;
+    inv[5] = c12 * inv_det;
+    inv[6] = c20 * inv_det;
+    inv[7] = c21 * inv_det;
+    inv[8] = c22 * inv_det;
+
+    return true;
+}
+
+template<typename T>
+constexpr auto inverse4x4(const T *m, T *inv) -> bool
+{
+    T m00 = m[0];
+    T m01 = m[1];
+    T m02 = m[2];
+    T m03 = m[3];
+    T m10 = m[4];
+    T m11 = m[5];
+    T m12 = m[6];
+    T m13 = m[7];
+    T m20 = m[8];
+    T m21 = m[9];
+    T m22 = m[10];
+    T m23 = m[11];
+    T m30 = m[12];
+    T m31 = m[13];
+    T m32 = m[14];
+    T m33 = m[15];
+
+    T a0 = m00 * m11 - m01 * m10;
+    T a1 = m00 * m12 - m02 * m10;
+    T a2 = m00 * m13 - m03 * m10;
+    T a3 = m01 * m12 - m02 * m11;
+    T a4 = m01 * m13 - m03 * m11;
+    T a5 = m02 * m13 - m03 * m12;
+    T b0 = m20 * m31 - m21 * m30;
+    T b1 = m20 * m32 - m22 * m30;
+    T b2 = m20 * m33 - m23 * m30;
+    T b3 = m21 * m32 - m22 * m31;
+    T b4 = m21 * m33 - m23 * m31;
+    T b5 = m22 * m33 - m23 * m32;
+
+    T det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+    if(det == consts::zero<T>) return false;
+
+    T inv_det = consts::one<T> / det;
+
+    inv[0] = (m11 * b5 - m12 * b4 + m13 * b3) * inv_det;
+    inv[1] = (-m01 * b5 + m02 * b4 - m03 * b3) * inv_det;
+    inv[2] = (m31 * a5 - m32 * a4 + m33 * a3) * inv_det;
+    inv[3] = (-m21 * a5 + m22 * a4 - m23 * a3) * inv_det;
+    inv[4] = (-m10 * b5 + m12 * b2 - m13 * b1) * inv_det;
+    inv[5] = (m00 * b5 - m02 * b2 + m03 * b1) * inv_det;
+    inv[6] = (-m30 * a5 + m32 * a2 - m33 * a1) * inv_det;
+    inv[7] = (m20 * a5 - m22 * a2 + m23 * a1) * inv_det;
+    inv[8] = (m10 * b4 - m11 * b2 + m13 * b0) * inv_det;
+    inv[9] = (-m00 * b4 + m01 * b2 - m03 * b0) * inv_det;
+    inv[10] = (m30 * a4 - m31 * a2 + m33 * a0) * inv_det;
+    inv[11] = (-m20 * a4 + m21 * a2 - m23 * a0) * inv_det;
+    inv[12] = (-m10 * b3 + m11 * b1 - m12 * b0) * inv_det;
+    inv[13] = (m00 * b3 - m01 * b1 + m02 * b0) * inv_det;
+    inv[14] = (-m30 * a3 + m31 * a1 - m32 * a0) * inv_det;
+    inv[15] = (m20 * a3 - m21 * a1 + m22 * a0) * inv_det;
+
+    return true;
+}
+
+
+/* Transpose */
+
+template<typename T>
+constexpr void transpose2x2_cpp(const T *m, T *t)
+{
+    t[0] = m[0];
+    t[1] = m[2];
+    t[2] = m[1];
+    t[3] = m[3];
+}
+
+template<typename T>
+constexpr void transpose3x3_cpp(const T *m, T *t)
+{
+    t[0] = m[0];
+    t[1] = m[3];
+    t[2] = m[6];
+    t[3] = m[1];
+    t[4] = m[4];
+    t[5] = m[7];
+    t[6] = m[2];
+    t[7] = m[5];
+    t[8] = m[8];
+}
+
+template<typename T>
+constexpr void transpose4x4_cpp(const T *m, T *t)
+{
+    t[0] = m[0];
+    t[1] = m[4];
+    t[2] = m[8];
+    t[3] = m[12];
+    t[4] = m[1];
+    t[5] = m[5];
+    t[6] = m[9];
+    t[7] = m[13];
+    t[8] = m[2];
+    t[9] = m[6];
+    t[10] = m[10];
+    t[11] = m[14];
+    t[12] = m[3];
+    t[13] = m[7];
+    t[14] = m[11];
+    t[15] = m[15];
+}
+
+
+/* Product C = A * B */
+
+template<typename T>
+constexpr void mulmat2x2_cpp(const T *a, const T *b, T *c)
+{
+    c[0] = a[0] * b[0] + a[1] * b[2];
+    c[1] = a[0] * b[1] + a[1] * b[3];
+    c[2] = a[2] * b[0] + a[3] * b[2];
+    c[3] = a[2] * b[1] + a[3] * b[3];
+}
+
+template<typename T>
+constexpr void mulmat3x3_cpp(const T *a, const T *b, T *c)
+{
+    c[0] = a[0] * b[0] + a[1] * b[3] + a[2] * b[6];
+    c[1] = a[0] * b[1] + a[1] * b[4] + a[2] * b[7];
+    c[2] = a[0] * b[2] + a[1] * b[5] + a[2] * b[8];
+    c[3] = a[3] * b[0] + a[4] * b[3] + a[5] * b[6];
+    c[4] = a[3] * b[1] + a[4] * b[4] + a[5] * b[7];
+    c[5] = a[3] * b[2] + a[4] * b[5] + a[5] * b[8];
+    c[6] = a[6] * b[0] + a[7] * b[3] + a[8] * b[6];
+    c[7] = a[6] * b[1] + a[7] * b[4] + a[8] * b[7];
+    c[8] = a[6] * b[2] + a[7] * b[5] + a[8] * b[8];
+}
+
+template<typename T>
+constexpr void mulmat4x4_cpp(const T *a, const T *b, T *c)
+{
+    for(size_t r = 0; r < 16; r += 4) {
+        c[r] = a[r] * b[0] + a[r + 1] * b[4] + a[r + 2] * b[8] + a[r + 3] * b[12];
+        c[r + 1] = a[r] * b[1] + a[r + 1] * b[5] + a[r + 2] * b[9] + a[r + 3] * b[13];
+        c[r + 2] = a[r] * b[2] + a[r + 1] * b[6] + a[r + 2] * b[10] + a[r + 3] * b[14];
+        c[r + 3] = a[r] * b[3] + a[r + 1] * b[7] + a[r + 2] * b[11] + a[r + 3] * b[15];
+    }
+}
+
+
+/* Matrix by vector y = A * x */
+
+template<typename T>
+constexpr void matrix_per_vector2x2_cpp(const T *a, const T *x, T *y)
+{
+    y[0] = a[0] * x[0] + a[1] * x[1];
+    y[1] = a[2] * x[0] + a[3] * x[1];
+}
+
+template<typename T>
+constexpr void matrix_per_vector3x3_cpp(const T *a, const T *x, T *y)
+{
+    y[0] = a[0] * x[0] + a[1] * x[1] + a[2] * x[2];
+    y[1] = a[3] * x[0] + a[4] * x[1] + a[5] * x[2];
+    y[2] = a[6] * x[0] + a[7] * x[1] + a[8] * x[2];
+}
+
+template<typename T>
+constexpr void matrix_per_vector4x4_cpp(const T *a, const T *x, T *y)
+{
+    y[0] = a[0] * x[0] + a[1] * x[1] + a[2] * x[2] + a[3] * x[3];
+    y[1] = a[4] * x[0] + a[5] * x[1] + a[6] * x[2] + a[7] * x[3];
+    y[2] = a[8] * x[0] + a[9] * x[1] + a[10] * x[2] + a[11] * x[3];
+    y[3] = a[12] * x[0] + a[13] * x[1] + a[14] * x[2] + a[15] * x[3];
+}
+
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+/* SIMD 4x4 kernels */
+
+inline void mulmat4x4_simd(const float *a, const float *b, float *c)
+{
+#ifdef TL_HAVE_AVX
+    // Each register holds two rows of A or C. The rows of B are duplicated in
+    // both lanes, and the in-lane permutes broadcast a(r, k) within each lane.
+    __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b));
+    __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+    __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+    __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+
+    for(size_t r = 0; r < 16; r += 8) {
+        __m256 a_rows = _mm256_loadu_ps(a + r);
+        __m256 c01 = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(a_rows, 0x00), b0),
+                                   _mm256_mul_ps(_mm256_permute_ps(a_rows, 0x55), b1));
+        __m256 c23 = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(a_rows, 0xAA), b2),
+                                   _mm256_mul_ps(_mm256_permute_ps(a_rows, 0xFF), b3));
+        _mm256_storeu_ps(c + r, _mm256_add_ps(c01, c23));
+    }
+#else
+    __m128 b0 = _mm_loadu_ps(b);
+    __m128 b1 = _mm_loadu_ps(b + 4);
+    __m128 b2 = _mm_loadu_ps(b + 8);
+    __m128 b3 = _mm_loadu_ps(b + 12);
+
+    for(size_t r = 0; r < 16; r += 4) {
+        __m128 a_row = _mm_loadu_ps(a + r);
+        __m128 c01 = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a_row, a_row, 0x00), b0),
+                                _mm_mul_ps(_mm_shuffle_ps(a_row, a_row, 0x55), b1));
+        __m128 c23 = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a_row, a_row, 0xAA), b2),
+                                _mm_mul_ps(_mm_shuffle_ps(a_row, a_row, 0xFF), b3));
+        _mm_storeu_ps(c + r, _mm_add_ps(c01, c23));
+    }
+#endif
+}
+
+inline void mulmat4x4_simd(const double *a, const double *b, double *c)
+{
+#ifdef TL_HAVE_AVX
+    __m256d b0 = _mm256_loadu_pd(b);
+    __m256d b1 = _mm256_loadu_pd(b + 4);
+    __m256d b2 = _mm256_loadu_pd(b + 8);
+    __m256d b3 = _mm256_loadu_pd(b + 12);
+
+    for(size_t r = 0; r < 16; r += 4) {
+        __m256d c01 = _mm256_add_pd(_mm256_mul_pd(_mm256_broadcast_sd(a + r), b0),
+                                    _mm256_mul_pd(_mm256_broadcast_sd(a + r + 1), b1));
+        __m256d c23 = _mm256_add_pd(_mm256_mul_pd(_mm256_broadcast_sd(a + r + 2), b2),
+                                    _mm256_mul_pd(_mm256_broadcast_sd(a + r + 3), b3));
+        _mm256_storeu_pd(c + r, _mm256_add_pd(c01, c23));
+    }
+#else
+    // A double row takes two SSE registers
+    __m128d b0_lo = _mm_loadu_pd(b);
+    __m128d b0_hi = _mm_loadu_pd(b + 2);
+    __m128d b1_lo = _mm_loadu_pd(b + 4);
+    __m128d b1_hi = _mm_loadu_pd(b + 6);
+    __m128d b2_lo = _mm_loadu_pd(b + 8);
+    __m128d b2_hi = _mm_loadu_pd(b + 10);
+    __m128d b3_lo = _mm_loadu_pd(b + 12);
+    __m128d b3_hi = _mm_loadu_pd(b + 14);
+
+    for(size_t r = 0; r < 16; r += 4) {
+        __m128d a0 = _mm_set1_pd(a[r]);
+        __m128d a1 = _mm_set1_pd(a[r + 1]);
+        __m128d a2 = _mm_set1_pd(a[r + 2]);
+        __m128d a3 = _mm_set1_pd(a[r + 3]);
+        __m128d c_lo = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a0, b0_lo), _mm_mul_pd(a1, b1_lo)),
+                                  _mm_add_pd(_mm_mul_pd(a2, b2_lo), _mm_mul_pd(a3, b3_lo)));
+        __m128d c_hi = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a0, b0_hi), _mm_mul_pd(a1, b1_hi)),
+                                  _mm_add_pd(_mm_mul_pd(a2, b2_hi), _mm_mul_pd(a3, b3_hi)));
+        _mm_storeu_pd(c + r, c_lo);
+        _mm_storeu_pd(c + r + 2, c_hi);
+    }
+#endif
+}
+
+inline void transpose4x4_simd(const float *m, float *t)
+{
+    __m128 r0 = _mm_loadu_ps(m);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(t, r0);
+    _mm_storeu_ps(t + 4, r1);
+    _mm_storeu_ps(t + 8, r2);
+    _mm_storeu_ps(t + 12, r3);
+}
+
+inline void transpose4x4_simd(const double *m, double *t)
+{
+#ifdef TL_HAVE_AVX
+    __m256d r0 = _mm256_loadu_pd(m);
+    __m256d r1 = _mm256_loadu_pd(m + 4);
+    __m256d r2 = _mm256_loadu_pd(m + 8);
+    __m256d r3 = _mm256_loadu_pd(m + 12);
+
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(t, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(t + 4, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(t + 8, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(t + 12, _mm256_permute2f128_pd(t1, t3, 0x31));
+#else
+    // Four 2x2 blocks: t(i, j) block = m(j, i) block transposed
+    for(size_t i = 0; i < 4; i += 2) {
+        for(size_t j = 0; j < 4; j += 2) {
+            __m128d r0 = _mm_loadu_pd(m + i * 4 + j);
+            __m128d r1 = _mm_loadu_pd(m + (i + 1) * 4 + j);
+            _mm_storeu_pd(t + j * 4 + i, _mm_unpacklo_pd(r0, r1));
+            _mm_storeu_pd(t + (j + 1) * 4 + i, _mm_unpackhi_pd(r0, r1));
+        }
+    }
+#endif
+}
+
+inline void matrix_per_vector4x4_simd(const float *a, const float *x, float *y)
+{
+    // y is the combination of the columns of A weighted by x
+    __m128 c0 = _mm_loadu_ps(a);
+    __m128 c1 = _mm_loadu_ps(a + 4);
+    __m128 c2 = _mm_loadu_ps(a + 8);
+    __m128 c3 = _mm_loadu_ps(a + 12);
+
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    __m128 v = _mm_loadu_ps(x);
+    __m128 y01 = _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00)),
+                            _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55)));
+    __m128 y23 = _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xAA)),
+                            _mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xFF)));
+    _mm_storeu_ps(y, _mm_add_ps(y01, y23));
+}
+
+inline void matrix_per_vector4x4_simd(const double *a, const double *x, double *y)
+{
+#ifdef TL_HAVE_AVX
+    __m256d v = _mm256_loadu_pd(x);
+    __m256d p0 = _mm256_mul_pd(_mm256_loadu_pd(a), v);
+    __m256d p1 = _mm256_mul_pd(_mm256_loadu_pd(a + 4), v);
+    __m256d p2 = _mm256_mul_pd(_mm256_loadu_pd(a + 8), v);
+    __m256d p3 = _mm256_mul_pd(_mm256_loadu_pd(a + 12), v);
+
+    // h01 = [p0_0 + p0_1, p1_0 + p1_1 | p0_2 + p0_3, p1_2 + p1_3]
+    __m256d h01 = _mm256_hadd_pd(p0, p1);
+    __m256d h23 = _mm256_hadd_pd(p2, p3);
+    _mm256_storeu_pd(y, _mm256_add_pd(_mm256_permute2f128_pd(h01, h23, 0x20),
+                                      _mm256_permute2f128_pd(h01, h23, 0x31)));
+#else
+    __m128d v_lo = _mm_loadu_pd(x);
+    __m128d v_hi = _mm_loadu_pd(x + 2);
+
+    __m128d p[4];
+    for(size_t r = 0; r < 4; r++) {
+        p[r] = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + r * 4), v_lo),
+                          _mm_mul_pd(_mm_loadu_pd(a + r * 4 + 2), v_hi));
+    }
+
+    _mm_storeu_pd(y, _mm_add_pd(_mm_unpacklo_pd(p[0], p[1]), _mm_unpackhi_pd(p[0], p[1])));
+    _mm_storeu_pd(y + 2, _mm_add_pd(_mm_unpacklo_pd(p[2], p[3]), _mm_unpackhi_pd(p[2], p[3])));
+#endif
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+
+/* 4x4 dispatch */
+
+template<typename T>
+inline void mulmat4x4(const T *a, const T *b, T *c)
+{
+    mulmat4x4_cpp(a, b, c);
+}
+
+template<typename T>
+inline void transpose4x4(const T *m, T *t)
+{
+    transpose4x4_cpp(m, t);
+}
+
+template<typename T>
+inline void matrix_per_vector4x4(const T *a, const T *x, T *y)
+{
+    matrix_per_vector4x4_cpp(a, x, y);
+}
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+inline void mulmat4x4(const float *a, const float *b, float *c)
+{
+    mulmat4x4_simd(a, b, c);
+}
+
+inline void mulmat4x4(const double *a, const double *b, double *c)
+{
+    mulmat4x4_simd(a, b, c);
+}
+
+inline void transpose4x4(const float *m, float *t)
+{
+    transpose4x4_simd(m, t);
+}
+
+inline void transpose4x4(const double *m, double *t)
+{
+    transpose4x4_simd(m, t);
+}
+
+inline void matrix_per_vector4x4(const float *a, const float *x, float *y)
+{
+    matrix_per_vector4x4_simd(a, x, y);
+}
+
+inline void matrix_per_vector4x4(const double *a, const double *x, double *y)
+{
+    matrix_per_vector4x4_simd(a, x, y);
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+} // namespace internal
+
+/// \endcond
+
+/*! \} */ // end of algebra
+
+/*! \} */ // end of math
+
+} // End namespace tl
@@ -0,0 +1,289 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <cmath>
+#include <vector>
+
+#include "tidop/math/math.h"
+#include "tidop/math/algebra/vector.h"
+#include "tidop/math/algebra/sparse_matrix.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Algebra
+ *
+ * Algebra
+ *
+ *  \{
+ */
+
+
+/*!
+ * \brief LSQR solver for sparse least squares problems
+ *
+ * Solves min |A * x - b| for a rectangular sparse matrix without forming the
+ * normal equations. It only needs the products A * v and A' * u.
+ *
+ * C. C. Paige and M. A. Saunders, "LSQR: An algorithm for sparse linear equations
+ * and sparse least squares", ACM Trans. Math. Softw. 8, 1 (March 1982), 43-71,
+ * doi: 10.1145/355984.355989.
+ *
+ * By default the columns of A are scaled to unit norm (Jacobi preconditioning of
+ * the normal equations), which reduces the iterations for badly scaled problems.
+ *
+ * The solver keeps a reference to the matrix, which must outlive it.
+ */
+template<typename T, SparseStorage Storage = SparseStorage::row>
+class Lsqr
+{
+
+public:
+
+    explicit Lsqr(const SparseMatrix<T, Storage> &matrix);
+
+    auto maxIterations() const -> size_t;
+    void setMaxIterations(size_t maxIterations);
+
+    /*!
+     * \brief Tolerance for the relative residual |A*x - b| / |b| and for
+     * the relative normal residual |A'(A*x - b)| / (|A| * |A*x - b|)
+     */
+    auto tolerance() const -> T;
+    void setTolerance(T tolerance);
+
+    auto columnScaling() const -> bool;
+    void setColumnScaling(bool columnScaling);
+
+    auto solve(const Vector<T> &b) -> Vector<T>;
+
+    auto iterations() const -> size_t;
+
+    /*!
+     * \brief Estimate of the residual norm |A*x - b| of the last solve
+     */
+    auto residual() const -> T;
+
+private:
+
+    const SparseMatrix<T, Storage> &mMatrix;
+    size_t mMaxIterations;
+    T mTolerance;
+    bool mColumnScaling;
+    size_t mIterations;
+    T mResidual;
+};
+
+
+template<typename T, SparseStorage Storage>
+Lsqr<T, Storage>::Lsqr(const SparseMatrix<T, Storage> &matrix)
+  : mMatrix(matrix),
+    mMaxIterations(4 * matrix.cols()),
+    mTolerance(std::numeric_limits<T>::epsilon() * 100),
+    mColumnScaling(true),
+    mIterations(0),
+    mResidual(0)
+{
+    static_assert(std::is_floating_point<T>::value, "Integral type not supported");
+}
+
+template<typename T, SparseStorage Storage>
+auto Lsqr<T, Storage>::maxIterations() const -> size_t
+{
+    return mMaxIterations;
+}
+
+template<typename T, SparseStorage Storage>
+void Lsqr<T, Storage>::setMaxIterations(size_t maxIterations)
+{
+    mMaxIterations = maxIterations;
+}
+
+template<typename T, SparseStorage Storage>
+auto Lsqr<T, Storage>::tolerance() const -> T
+{
+    return mTolerance;
+}
+
+template<typename T, SparseStorage Storage>
+void Lsqr<T, Storage>::setTolerance(T tolerance)
+{
+    mTolerance = tolerance;
+}
+
+template<typename T, SparseStorage Storage>
+auto Lsqr<T, Storage>::columnScaling() const -> bool
+{
+    return mColumnScaling;
+}
+
+template<typename T, SparseStorage Storage>
+void Lsqr<T, Storage>::setColumnScaling(bool columnScaling)
+{
+    mColumnScaling = columnScaling;
+}
+
+template<typename T, SparseStorage Storage>
+auto Lsqr<T, Storage>::solve(const Vector<T> &b) -> Vector<T>
+{
+    size_t m = mMatrix.rows();
+    size_t n = mMatrix.cols();
+
+    TL_ASSERT(b.size() == m, "Matrix rows != Vector size");
+
+    auto norm = [](const std::vector<T> &v) -> T {
+        T sum = consts::zero<T>;
+        for (auto value : v) sum += value * value;
+        return std::sqrt(sum);
+    };
+
+    /// Column scaling D. The solver works with A * D and x = D * y
+    std::vector<T> scale(n, consts::one<T>);
+    if (mColumnScaling) {
+        std::fill(scale.begin(), scale.end(), consts::zero<T>);
+        const auto &outer = mMatrix.outerIndex();
+        const auto &inner = mMatrix.innerIndex();
+        const auto &values = mMatrix.values();
+        for (size_t o = 0; o < mMatrix.outerSize(); o++) {
+            for (size_t p = outer[o]; p < outer[o + 1]; p++) {
+                size_t col = Storage == SparseStorage::row ? inner[p] : o;
+                scale[col] += values[p] * values[p];
+            }
+        }
+        for (auto &s : scale)
+            s = s > consts::zero<T> ? consts::one<T> / std::sqrt(s) : consts::one<T>;
+    }
+
+    std::vector<T> x(n, consts::zero<T>);
+    std::vector<T> u(b.begin(), b.end());
+    std::vector<T> v(n);
+    std::vector<T> w(n);
+    std::vector<T> aux_m(m);
+    std::vector<T> aux_n(n);
+
+    mIterations = 0;
+
+    T beta = norm(u);
+    T b_norm = beta;
+    mResidual = beta;
+
+    if (beta == consts::zero<T>) return Vector<T>(n, consts::zero<T>);
+
+    for (auto &value : u) value /= beta;
+
+    mMatrix.transposeMultiply(u.data(), v.data());
+    for (size_t j = 0; j < n; j++) v[j] *= scale[j];
+
+    T alpha = norm(v);
+    if (alpha == consts::zero<T>) return Vector<T>(n, consts::zero<T>);
+
+    for (auto &value : v) value /= alpha;
+
+    w = v;
+
+    T phi_bar = beta;
+    T rho_bar = alpha;
+    T a_norm2 = alpha * alpha;
+
+    while (mIterations < mMaxIterations) {
+
+        /// Bidiagonalization: beta * u = A * D * v - alpha * u
+        for (size_t j = 0; j < n; j++) aux_n[j] = v[j] * scale[j];
+        mMatrix.multiply(aux_n.data(), aux_m.data());
+        for (size_t i = 0; i < m; i++) u[i] = aux_m[i] - alpha * u[i];
+        beta = norm(u);
+
+        if (beta > consts::zero<T>) {
+            for (auto &value : u) value /= beta;
+
+            /// alpha * v = D * A' * u - beta * v
+            mMatrix.transposeMultiply(u.data(), aux_n.data());
+            for (size_t j = 0; j < n; j++) v[j] = aux_n[j] * scale[j] - beta * v[j];
+            alpha = norm(v);
+            if (alpha > consts::zero<T>) {
+                for (auto &value : v) value /= alpha;
+            }
+        }
+
+        a_norm2 += alpha * alpha + beta * beta;
+
+        /// Plane rotation
+        T rho = std::sqrt(rho_bar * rho_bar + beta * beta);
+        T c = rho_bar / rho;
+        T s = beta / rho;
+        T theta = s * alpha;
+        rho_bar = -c * alpha;
+        T phi = c * phi_bar;
+        phi_bar = s * phi_bar;
+
+        for (size_t j = 0; j < n; j++) {
+            x[j] += (phi / rho) * w[j];
+            w[j] = v[j] - (theta / rho) * w[j];
+        }
+
+        mIterations++;
+        mResidual = phi_bar;
+
+        T normal_residual = phi_bar * alpha * std::abs(c);
+
+        if (phi_bar <= mTolerance * b_norm) break;
+        if (normal_residual <= mTolerance * std::sqrt(a_norm2) * phi_bar) break;
+        if (alpha == consts::zero<T> || beta == consts::zero<T>) break;
+    }
+
+    Vector<T> solution(n);
+    for (size_t j = 0; j < n; j++)
+        solution[j] = x[j] * scale[j];
+
+    return solution;
+}
+
+template<typename T, SparseStorage Storage>
+auto Lsqr<T, Storage>::iterations() const -> size_t
+{
+    return mIterations;
+}
+
+template<typename T, SparseStorage Storage>
+auto Lsqr<T, Storage>::residual() const -> T
+{
+    return mResidual;
+}
+
+
+/*! \} */ // end of Algebra
+
+/*! \} */ // end of Math
+
+} // End namespace tl
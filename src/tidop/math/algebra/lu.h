@@ -28,6 +28,7 @@
 #include "tidop/core/exception.h"
 #include "tidop/math/algebra/matrix.h"
 #include "tidop/math/algebra/vector.h"
+#include "tidop/math/algebra/dense_kernels.h"
 #include "tidop/math/lapack.h"
 #include "tidop/math/cuda.h"
 
@@ -52,6 +53,10 @@ namespace tl
  *
  * donde L y U son matrices inferiores y superiores triangulares respectivamente.
  *
+ * A partir de internal::blocked_decomposition_threshold filas la matriz se
+ * factoriza por bloques (right-looking): cada panel de columnas se factoriza
+ * con pivotaje parcial y el resto de la matriz se actualiza con un producto
+ * de matrices (GEMM) repartido entre hilos.
  */
 template<typename T>
 class LuDecomposition;
@@ -78,6 +83,7 @@ public:
 private:
 
     void decompose();
+    void decomposePanel(size_t ini, size_t end, Vector<T, _rows> &maxElements);
     auto findMaxElementsByRows() const -> Vector<T, _rows>;
 
 private:
@@ -218,21 +224,16 @@ auto LuDecomposition<Matrix_t<T, _rows, _cols>>::solve(const Matrix_t<T, _rows,
 
 #else
 
-    Vector<T, _rows> xx(mRows);
+    size_t nrhs = x.cols();
 
-    for (size_t j = 0; j < x.cols(); j++) {
-
-        for (size_t i = 0; i < mRows; i++) {
-            xx[i] = b[i][j];
-        }
-
-        xx = this->solve(xx);
-
-        for (size_t i = 0; i < mRows; i++) {
-            x[i][j] = xx[i];
-        }
+    for (size_t i = 0; i < mRows; i++) {
+        if (mPivotIndex[i] != i)
+            x.swapRows(i, mPivotIndex[i]);
     }
 
+    internal::solve_lower_triangular(mRows, nrhs, true, LU.data(), LU.cols(), size_t{1}, x.data(), nrhs);
+    internal::solve_upper_triangular(mRows, nrhs, false, LU.data(), LU.cols(), size_t{1}, x.data(), nrhs);
+
 #endif
 
     return x;
@@ -263,13 +264,63 @@ void LuDecomposition<Matrix_t<T, _rows, _cols>>::decompose()
     
     Vector<T, _rows> max_elements = findMaxElementsByRows();
 
-    for (size_t k = 0; k < mRows; k++) {
+    if (mRows < internal::blocked_decomposition_threshold) {
+        decomposePanel(0, mRows, max_elements);
+        return;
+    }
+
+    T *lu = LU.data();
+    size_t ld = LU.cols();
+
+    for (size_t k = 0; k < mRows; k += internal::blocked_decomposition_block_size) {
+
+        size_t next = std::min(k + internal::blocked_decomposition_block_size, mRows);
+
+        decomposePanel(k, next, max_elements);
+
+        if (next < mRows) {
+
+            size_t block = next - k;
+            size_t trailing = mRows - next;
+
+            /// U12 = L11^-1 * A12
+            internal::solve_lower_triangular(block, trailing, true,
+                                             &lu[k * ld + k], ld, size_t{1},
+                                             &lu[k * ld + next], ld);
+
+            /// A22 = A22 - L21 * U12
+            internal::gemm(trailing, trailing, block, -consts::one<T>,
+                           &lu[next * ld + k], ld, size_t{1},
+                           &lu[k * ld + next], ld, size_t{1},
+                           &lu[next * ld + next], ld);
+        }
+    }
+
+#endif // TL_HAVE_OPENBLAS
+}
+
+/*!
+ * \brief Factoriza las columnas [ini, end) con pivotaje parcial escalado
+ *
+ * Sólo se actualizan las columnas del panel. Los intercambios de filas se
+ * aplican a la fila completa.
+ */
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t _rows, size_t _cols
+>
+void LuDecomposition<Matrix_t<T, _rows, _cols>>::decomposePanel(size_t ini, size_t end, Vector<T, _rows> &maxElements)
+{
+    T *lu = LU.data();
+    size_t ld = LU.cols();
+
+    for (size_t k = ini; k < end; k++) {
 
         T big = consts::zero<T>;
         size_t pivot_row = k;
 
         for (size_t i = k; i < mRows; i++) {
-            T temp = std::abs(LU[i][k]) / max_elements[i];
+            T temp = std::abs(lu[i * ld + k]) / maxElements[i];
             if (temp > big) {
                 big = temp;
                 pivot_row = i;
@@ -279,26 +330,23 @@ void LuDecomposition<Matrix_t<T, _rows, _cols>>::decompose()
         if (k != pivot_row) {
             LU.swapRows(pivot_row, k);
             this->d = -this->d;
-            std::swap(max_elements[pivot_row], max_elements[k]);
+            std::swap(maxElements[pivot_row], maxElements[k]);
         }
 
         mPivotIndex[k] = pivot_row;
 
-        if (isNearlyZero(LU[k][k]))
-            LU[k][k] = std::numeric_limits<T>().min();
+        if (isNearlyZero(lu[k * ld + k]))
+            lu[k * ld + k] = std::numeric_limits<T>().min();
 
-        T llkk = LU[k][k];
+        T llkk = lu[k * ld + k];
 
         for (size_t i = k + 1; i < mRows; i++) {
 
-            T temp = LU[i][k] /= llkk;
+            T temp = lu[i * ld + k] /= llkk;
 
-            for (size_t j = k + 1; j < mRows; j++)
-                LU[i][j] -= temp * LU[k][j];
+            internal::axpy(end - k - 1, -temp, &lu[k * ld + k + 1], &lu[i * ld + k + 1]);
         }
     }
-
-#endif // TL_HAVE_OPENBLAS
 }
 
 template<
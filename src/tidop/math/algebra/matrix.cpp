@@ -0,0 +1,191 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+#include "tidop/math/algebra/matrix.h"
+
+#include "tidop/core/path.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+namespace tl
+{
+
+namespace
+{
+
+/// Thresholds of Product::Auto, shared by all threads
+std::array<std::atomic<size_t>, 3> shared_thresholds{{{MatrixConfig::Thresholds().blocked},
+                                                      {MatrixConfig::Thresholds().blas},
+                                                      {MatrixConfig::Thresholds().cublas}}};
+
+/*!
+ * \brief Time of a size x size product with the backend, best of three runs
+ */
+auto time_matrix_product(MatrixConfig::Product product, size_t size) -> double
+{
+    Matrix<double> a(size, size);
+    Matrix<double> b(size, size);
+    for (size_t r = 0; r < size; r++) {
+        for (size_t c = 0; c < size; c++) {
+            a(r, c) = static_cast<double>((r * 7 + c * 3) % 11) - 5.;
+            b(r, c) = static_cast<double>((r * 5 + c) % 13) - 6.;
+        }
+    }
+
+    MatrixConfig &config = MatrixConfig::instance();
+    MatrixConfig::Product previous = config.product;
+    config.product = product;
+
+    /// About 2^20 multiply-adds per run
+    size_t repetitions = std::max<size_t>(1, (size_t{1} << 20) / (size * size * size));
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < 3; run++) {
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < repetitions; i++) {
+            Matrix<double> c(size, size, 0.);
+            mulmat(a, b, c);
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / static_cast<double>(repetitions));
+    }
+
+    config.product = previous;
+
+    return best;
+}
+
+/*!
+ * \brief Smallest m * n * k from which the backend is faster than the
+ * reference times at all the larger sizes
+ */
+auto autotune_threshold(MatrixConfig::Product product,
+                        const std::vector<size_t> &sizes,
+                        const std::vector<double> &reference) -> size_t
+{
+    size_t threshold = std::numeric_limits<size_t>::max();
+
+    for (size_t i = sizes.size(); i-- > 0;) {
+        if (time_matrix_product(product, sizes[i]) >= reference[i]) break;
+        threshold = sizes[i] * sizes[i] * sizes[i];
+    }
+
+    return threshold;
+}
+
+} // namespace
+
+
+auto MatrixConfig::instance() -> MatrixConfig &
+{
+    thread_local MatrixConfig _config;
+    return _config;
+}
+
+auto MatrixConfig::thresholds() -> Thresholds
+{
+    Thresholds thresholds;
+    thresholds.blocked = shared_thresholds[0].load(std::memory_order_relaxed);
+    thresholds.blas = shared_thresholds[1].load(std::memory_order_relaxed);
+    thresholds.cublas = shared_thresholds[2].load(std::memory_order_relaxed);
+
+    return thresholds;
+}
+
+void MatrixConfig::setThresholds(const Thresholds &thresholds)
+{
+    shared_thresholds[0].store(thresholds.blocked, std::memory_order_relaxed);
+    shared_thresholds[1].store(thresholds.blas, std::memory_order_relaxed);
+    shared_thresholds[2].store(thresholds.cublas, std::memory_order_relaxed);
+}
+
+auto MatrixConfig::autotune(const Path &file) -> Thresholds
+{
+    Thresholds thresholds;
+
+    if (!file.empty() && file.exists()) {
+
+        std::ifstream stream(file.toString());
+        std::string key;
+        size_t value;
+        while (stream >> key >> value) {
+            if (key == "blocked") thresholds.blocked = value;
+            else if (key == "blas") thresholds.blas = value;
+            else if (key == "cublas") thresholds.cublas = value;
+        }
+
+        setThresholds(thresholds);
+        return thresholds;
+    }
+
+    thresholds = autotune();
+
+    if (!file.empty()) {
+        std::ofstream stream(file.toString(), std::ios::trunc);
+        stream << "blocked " << thresholds.blocked << "\n";
+        stream << "blas " << thresholds.blas << "\n";
+        stream << "cublas " << thresholds.cublas << "\n";
+    }
+
+    return thresholds;
+}
+
+auto MatrixConfig::autotune() -> Thresholds
+{
+    Thresholds thresholds;
+
+    std::vector<size_t> sizes{16, 32, 48, 64, 96, 128, 192};
+    std::vector<double> reference(sizes.size());
+
+    Product direct =
+#ifdef TL_HAVE_SIMD_INTRINSICS
+        Product::SIMD;
+#else
+        Product::CPP;
+#endif
+
+    for (size_t i = 0; i < sizes.size(); i++) {
+        reference[i] = time_matrix_product(direct, sizes[i]);
+    }
+
+    thresholds.blocked = autotune_threshold(Product::Blocked, sizes, reference);
+#ifdef TL_HAVE_OPENBLAS
+    thresholds.blas = autotune_threshold(Product::BLAS, sizes, reference);
+#endif
+#ifdef TL_HAVE_CUDA
+    thresholds.cublas = autotune_threshold(Product::CuBLAS, sizes, reference);
+#endif
+
+    setThresholds(thresholds);
+
+    return thresholds;
+}
+
+} // End namespace tl
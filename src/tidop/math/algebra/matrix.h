@@ -33,6 +33,8 @@
 #include "tidop/math/blas.h"
 #include "tidop/math/cuda.h"
 #include "tidop/math/data.h"
+#include "tidop/math/algebra/dense_kernels.h"
+#include "tidop/math/algebra/fixed_kernels.h"
 #include "tidop/math/algebra/lu.h"
 //#include "tidop/math/algebra/matrix/operations.h"
 #include "tidop/geometry/rect.h"
@@ -41,12 +43,15 @@
 #include "tidop/math/algebra/matrix/block.h"
 #include "tidop/math/algebra/matrix/base.h"
 
-#include <type_traits>
 #include <iomanip>
+#include <limits>
+#include <type_traits>
 
 namespace tl
 {
 
+class Path;
+
 
 //TODO: Expression templates:
 //      Por ahora no se implementan las operaciones entre matrices con 
@@ -77,6 +82,27 @@ class LuDecomposition;
 
 
 
+/*!
+ * \brief Backend of the matrix products
+ *
+ * Product::Auto chooses the backend from the dimensions of each product
+ * (m x k by k x n). The direct kernels are used for small products, the
+ * cache-blocked multithreaded kernel (Product::Blocked) from
+ * Thresholds::blocked multiply-adds and BLAS or cuBLAS, when available,
+ * from their thresholds. The default thresholds can be calibrated for the
+ * host with autotune(), which caches them in a text file.
+ *
+ * The product selected with instance() only applies to the calling thread.
+ *
+ * <h4>Example</h4>
+ * \code
+ * // Once at startup
+ * MatrixConfig::autotune(Path("matrix_product.cfg"));
+ *
+ * // Forces the BLAS backend in this thread
+ * MatrixConfig::instance().product = MatrixConfig::Product::BLAS;
+ * \endcode
+ */
 class TL_EXPORT MatrixConfig
 {
 
@@ -93,27 +119,66 @@ public:
 #ifdef TL_HAVE_SIMD_INTRINSICS
         SIMD,
 #endif
-        CPP
+        Blocked,
+        CPP,
+        Auto
     };
 
-    Product product =
-#ifdef TL_HAVE_SIMD_INTRINSICS
-        Product::SIMD;
-#else
-        Product::CPP;
-#endif
-
-    static auto instance() -> MatrixConfig &
+    /*!
+     * \brief Number of multiply-adds (m * n * k) from which Product::Auto
+     * uses each backend
+     */
+    struct Thresholds
     {
-        static MatrixConfig _config;
-        return _config;
-    }
+        size_t blocked = 48 * 48 * 48;
+        size_t blas = 48 * 48 * 48;
+        size_t cublas = 512 * 512 * 512;
+    };
+
+    Product product = Product::Auto;
+
+public:
+
+    /*!
+     * \brief Configuration of the calling thread
+     */
+    static auto instance() -> MatrixConfig &;
+
+    /*!
+     * \brief Backend used for a m x k by k x n product
+     * Resolves Product::Auto with the thresholds
+     */
+    auto select(size_t m, size_t n, size_t k) const -> Product;
+
+    /*!
+     * \brief Thresholds of Product::Auto, shared by all threads
+     */
+    static auto thresholds() -> Thresholds;
+    static void setThresholds(const Thresholds &thresholds);
+
+    /*!
+     * \brief Calibrates the thresholds of Product::Auto
+     * The thresholds are read from the file if it exists. Otherwise each
+     * backend is timed with square products and the sizes from which it
+     * is faster than the direct kernel are saved in the file.
+     * \param[in] file Cache file. If empty the thresholds are not saved
+     * \return Thresholds in use
+     */
+    static auto autotune(const Path &file) -> Thresholds;
+
+    /*!
+     * \brief Calibrates the thresholds of Product::Auto without caching them
+     * \return Thresholds in use
+     */
+    static auto autotune() -> Thresholds;
+
 };
 
 
 template<typename T, size_t Rows = DynamicData, size_t Cols = DynamicData>
 class Matrix
-  : public MatrixBase<Matrix<T, Rows, Cols>>
+  : public MatrixBase<Matrix<T, Rows, Cols>>,
+    public internal::AlignedNew
 {
 
 public:
@@ -501,6 +566,14 @@ public:
 
 private:
 
+    /// Kernel selection by the compile-time size
+    auto inverse(bool *invertibility, std::integral_constant<size_t, 2>) const -> Matrix;
+    auto inverse(bool *invertibility, std::integral_constant<size_t, 3>) const -> Matrix;
+    auto inverse(bool *invertibility, std::integral_constant<size_t, 4>) const -> Matrix;
+    auto inverse(bool *invertibility, std::integral_constant<size_t, DynamicData>) const -> Matrix;
+    template<size_t Size>
+    auto inverse(bool *invertibility, std::integral_constant<size_t, Size>) const -> Matrix;
+
     auto inverse2x2(bool *invertibility) const->Matrix;
     auto inverse3x3(bool *invertibility) const->Matrix;
     auto inverse4x4(bool *invertibility) const->Matrix;
@@ -1022,16 +1095,18 @@ auto mulmat(const Matrix<T, _rows1, _col1> &matrix1,
     TL_ASSERT(matrix1.rows() == matrix.rows(), "C rows != A rows");
     TL_ASSERT(matrix2.cols() == matrix.cols(), "B columns != C columns");
 
+    /// BLAS and the blocked kernel are only used for floating point types
     switch (MatrixConfig::instance().product) {
+    case tl::MatrixConfig::Product::CPP:
+        mulmat_cpp(matrix1, matrix2, matrix);
+        break;
+    default:
 #ifdef TL_HAVE_SIMD_INTRINSICS
-    case tl::MatrixConfig::Product::SIMD:
         mulmat_simd(matrix1, matrix2, matrix);
         //mulmat_simd_parallel(matrix1, matrix2, matrix);
-        break;
-#endif
-    case tl::MatrixConfig::Product::CPP:
-    default:
+#else
         mulmat_cpp(matrix1, matrix2, matrix);
+#endif
         break;
     }
 }
@@ -1042,7 +1117,7 @@ auto mulmat(const Matrix<T, _rows1, _cols1> &matrix1,
             Matrix<T, _rows3, _cols3> &matrix) -> std::enable_if_t<std::is_floating_point<T>::value, void>
 {
 
-    switch (MatrixConfig::instance().product) {
+    switch (MatrixConfig::instance().select(matrix1.rows(), matrix2.cols(), matrix1.cols())) {
 #ifdef TL_HAVE_CUDA
     case tl::MatrixConfig::Product::CuBLAS:
         cuda::gemm(matrix1.rows(),
@@ -1063,6 +1138,15 @@ auto mulmat(const Matrix<T, _rows1, _cols1> &matrix1,
                    matrix.data());
         break;
 #endif
+    case tl::MatrixConfig::Product::Blocked:
+        gemm(matrix1.rows(),
+             matrix2.cols(),
+             matrix1.cols(),
+             consts::one<T>,
+             matrix1.data(), matrix1.cols(), 1,
+             matrix2.data(), matrix2.cols(), 1,
+             matrix.data(), matrix.cols());
+        break;
 #ifdef TL_HAVE_SIMD_INTRINSICS
     case tl::MatrixConfig::Product::SIMD:
         mulmat_simd(matrix1, matrix2, matrix);
@@ -1144,16 +1228,15 @@ auto matrix_per_vector(const Matrix<T, Rows, Cols> &matrix,
 //#endif
 
     switch (MatrixConfig::instance().product) {
-#ifdef TL_HAVE_SIMD_INTRINSICS
-    case tl::MatrixConfig::Product::SIMD:
-        matrix_per_vector_simd(matrix, vector, vectorOut);
-        break;
-#endif
     case tl::MatrixConfig::Product::CPP:
-        //matrix_per_vector_cpp(matrix, vector, vectorOut);
-        //break;
+        matrix_per_vector_cpp(matrix, vector, vectorOut);
+        break;
     default:
+#ifdef TL_HAVE_SIMD_INTRINSICS
+        matrix_per_vector_simd(matrix, vector, vectorOut);
+#else
         matrix_per_vector_cpp(matrix, vector, vectorOut);
+#endif
         break;
     }
 }
@@ -1166,7 +1249,8 @@ auto matrix_per_vector(const Matrix<T, Rows, Cols> &matrix,
 {       
     TL_ASSERT(matrix.cols() == vector.size(), "Matrix columns != Vector size");
 
-    switch (MatrixConfig::instance().product) {
+    /// The blocked kernel is not used for matrix-vector products
+    switch (MatrixConfig::instance().select(matrix.rows(), 1, matrix.cols())) {
 #ifdef TL_HAVE_CUDA
     case tl::MatrixConfig::Product::CuBLAS:
         cuda::gemv(matrix.rows(),
@@ -1184,22 +1268,57 @@ auto matrix_per_vector(const Matrix<T, Rows, Cols> &matrix,
                    vector.data(), 
                    vectorOut.data());
         break;
-#endif
-#ifdef TL_HAVE_SIMD_INTRINSICS
-    case tl::MatrixConfig::Product::SIMD:
-        matrix_per_vector_simd(matrix, vector, vectorOut);
-        break;
 #endif
     case tl::MatrixConfig::Product::CPP:
-        //matrix_per_vector_cpp(matrix, vector, vectorOut);
-        //break;
+        matrix_per_vector_cpp(matrix, vector, vectorOut);
+        break;
     default:
+#ifdef TL_HAVE_SIMD_INTRINSICS
+        matrix_per_vector_simd(matrix, vector, vectorOut);
+#else
         matrix_per_vector_cpp(matrix, vector, vectorOut);
+#endif
         break;
     }
 }
 
 
+template<typename T, size_t Rows, size_t Cols>
+void transpose(const Matrix<T, Rows, Cols> &matrix,
+               Matrix<T, Cols, Rows> &transposed)
+{
+    size_t rows = matrix.rows();
+    size_t cols = matrix.cols();
+
+    for(size_t r = 0; r < rows; r++) {
+        for(size_t c = 0; c < cols; c++) {
+            transposed(c, r) = matrix(r, c);
+        }
+    }
+}
+
+template<typename T>
+void transpose(const Matrix<T, 2, 2> &matrix,
+               Matrix<T, 2, 2> &transposed)
+{
+    transpose2x2_cpp(matrix.data(), transposed.data());
+}
+
+template<typename T>
+void transpose(const Matrix<T, 3, 3> &matrix,
+               Matrix<T, 3, 3> &transposed)
+{
+    transpose3x3_cpp(matrix.data(), transposed.data());
+}
+
+template<typename T>
+void transpose(const Matrix<T, 4, 4> &matrix,
+               Matrix<T, 4, 4> &transposed)
+{
+    transpose4x4(matrix.data(), transposed.data());
+}
+
+
 } // namespace internal 
 
 /// \endcond
@@ -1408,13 +1527,42 @@ auto Matrix<T, Rows, Cols>::inverse(bool *invertibility) const -> Matrix
     size_t cols = this->cols();
     TL_ASSERT(rows == cols, "Non-Square Matrix");
 
+    return inverse(invertibility, std::integral_constant<size_t, Rows>());
+}
+
+template<typename T, size_t Rows, size_t Cols>
+auto Matrix<T, Rows, Cols>::inverse(bool *invertibility,
+                                    std::integral_constant<size_t, 2>) const -> Matrix
+{
+    return inverse2x2(invertibility);
+}
+
+template<typename T, size_t Rows, size_t Cols>
+auto Matrix<T, Rows, Cols>::inverse(bool *invertibility,
+                                    std::integral_constant<size_t, 3>) const -> Matrix
+{
+    return inverse3x3(invertibility);
+}
+
+template<typename T, size_t Rows, size_t Cols>
+auto Matrix<T, Rows, Cols>::inverse(bool *invertibility,
+                                    std::integral_constant<size_t, 4>) const -> Matrix
+{
+    return inverse4x4(invertibility);
+}
+
+template<typename T, size_t Rows, size_t Cols>
+auto Matrix<T, Rows, Cols>::inverse(bool *invertibility,
+                                    std::integral_constant<size_t, DynamicData>) const -> Matrix
+{
+    /// The size is only known at runtime
     Matrix<T, Rows, Cols> matrix;
 
-    if(rows == 2)
+    if(this->rows() == 2)
         matrix = inverse2x2(invertibility);
-    else if(rows == 3)
+    else if(this->rows() == 3)
         matrix = inverse3x3(invertibility);
-    else if(rows == 4)
+    else if(this->rows() == 4)
         matrix = inverse4x4(invertibility);
     else
         matrix = inversenxn(invertibility);
@@ -1422,21 +1570,21 @@ auto Matrix<T, Rows, Cols>::inverse(bool *invertibility) const -> Matrix
     return matrix;
 }
 
+template<typename T, size_t Rows, size_t Cols>
+template<size_t Size>
+auto Matrix<T, Rows, Cols>::inverse(bool *invertibility,
+                                    std::integral_constant<size_t, Size>) const -> Matrix
+{
+    return inversenxn(invertibility);
+}
+
 template<typename T, size_t Rows, size_t Cols>
 auto Matrix<T, Rows, Cols>::inverse2x2(bool *invertibility) const -> Matrix
 {
     Matrix<T, Rows, Cols> matrix(*this);
 
-    T det = this->determinant2x2();
-    if(det != consts::zero<T>) {
-        matrix[0][0] = (*this)(1, 1) / det;
-        matrix[0][1] = -(*this)(0, 1) / det;
-        matrix[1][0] = -(*this)(1, 0) / det;
-        matrix[1][1] = (*this)(0, 0) / det;
-        if(invertibility) *invertibility = true;
-    } else {
-        if(invertibility) *invertibility = false;
-    }
+    bool invertible = internal::inverse2x2(this->data(), matrix.data());
+    if(invertibility) *invertibility = invertible;
 
     return matrix;
 }
@@ -1446,19 +1594,8 @@ auto Matrix<T, Rows, Cols>::inverse3x3(bool *invertibility) const -> Matrix
 {
     Matrix<T, Rows, Cols> matrix(*this);
 
-    Matrix<T, Rows, Cols> adj = this->adjoint3x3();
-    T det = (*this)(0, 0) * adj(0, 0)
-        + (*this)(0, 1) * adj(1, 0)
-        + (*this)(0, 2) * adj(2, 0);
-
-    if(det != consts::zero<T>) {
-
-        matrix = adj / det;
-
-        if(invertibility) *invertibility = true;
-    } else {
-        if(invertibility) *invertibility = false;
-    }
+    bool invertible = internal::inverse3x3(this->data(), matrix.data());
+    if(invertibility) *invertibility = invertible;
 
     return matrix;
 }
@@ -1468,61 +1605,8 @@ auto Matrix<T, Rows, Cols>::inverse4x4(bool *invertibility) const -> Matrix
 {
     Matrix<T, Rows, Cols> matrix(*this);
 
-    T m00 = (*this)(0, 0);
-    T m01 = (*this)(0, 1);
-    T m02 = (*this)(0, 2);
-    T m03 = (*this)(0, 3);
-    T m10 = (*this)(1, 0);
-    T m11 = (*this)(1, 1);
-    T m12 = (*this)(1, 2);
-    T m13 = (*this)(1, 3);
-    T m20 = (*this)(2, 0);
-    T m21 = (*this)(2, 1);
-    T m22 = (*this)(2, 2);
-    T m23 = (*this)(2, 3);
-    T m30 = (*this)(3, 0);
-    T m31 = (*this)(3, 1);
-    T m32 = (*this)(3, 2);
-    T m33 = (*this)(3, 3);
-
-    T a0 = m00 * m11 - m01 * m10;
-    T a1 = m00 * m12 - m02 * m10;
-    T a2 = m00 * m13 - m03 * m10;
-    T a3 = m01 * m12 - m02 * m11;
-    T a4 = m01 * m13 - m03 * m11;
-    T a5 = m02 * m13 - m03 * m12;
-    T b0 = m20 * m31 - m21 * m30;
-    T b1 = m20 * m32 - m22 * m30;
-    T b2 = m20 * m33 - m23 * m30;
-    T b3 = m21 * m32 - m22 * m31;
-    T b4 = m21 * m33 - m23 * m31;
-    T b5 = m22 * m33 - m23 * m32;
-    T det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
-
-    if(det != consts::zero<T>) {
-
-        matrix[0][0] = (m11 * b5 - m12 * b4 + m13 * b3) / det;
-        matrix[0][1] = (-m01 * b5 + m02 * b4 - m03 * b3) / det;
-        matrix[0][2] = (m31 * a5 - m32 * a4 + m33 * a3) / det;
-        matrix[0][3] = (-m21 * a5 + m22 * a4 - m23 * a3) / det;
-        matrix[1][0] = (-m10 * b5 + m12 * b2 - m13 * b1) / det;
-        matrix[1][1] = (m00 * b5 - m02 * b2 + m03 * b1) / det;
-        matrix[1][2] = (-m30 * a5 + m32 * a2 - m33 * a1) / det;
-        matrix[1][3] = (m20 * a5 - m22 * a2 + m23 * a1) / det;
-        matrix[2][0] = (m10 * b4 - m11 * b2 + m13 * b0) / det;
-        matrix[2][1] = (-m00 * b4 + m01 * b2 - m03 * b0) / det;
-        matrix[2][2] = (m30 * a4 - m31 * a2 + m33 * a0) / det;
-        matrix[2][3] = (-m20 * a4 + m21 * a2 - m23 * a0) / det;
-        matrix[3][0] = (-m10 * b3 + m11 * b1 - m12 * b0) / det;
-        matrix[3][1] = (m00 * b3 - m01 * b1 + m02 * b0) / det;
-        matrix[3][2] = (-m30 * a3 + m31 * a1 - m32 * a0) / det;
-        matrix[3][3] = (m20 * a3 - m21 * a1 + m22 * a0) / det;
-
-        if(invertibility) *invertibility = true;
-
-    } else if(invertibility) {
-        *invertibility = false;
-    }
+    bool invertible = internal::inverse4x4(this->data(), matrix.data());
+    if(invertibility) *invertibility = invertible;
 
     return matrix;
 }
@@ -1562,17 +1646,7 @@ auto Matrix<T, Rows, Cols>::transpose() const -> Matrix<T, Cols, Rows>
 
     Matrix<T, Cols, Rows> matrix(cols, rows);
 
-    for(size_t r = 0; r < rows; r++) {
-        for(size_t c = 0; c < cols; c++) {
-            matrix[c][r] = (*this)(r, c);
-        }
-    }
-
-#if defined TL_HAVE_SIMD_INTRINSICS
-
-
-
-#endif
+    internal::transpose(*this, matrix);
 
     return matrix;
 }
@@ -2298,6 +2372,39 @@ auto operator *(const Matrix<T, Rows, _dim>& matrix1,
     return matrix;
 }
 
+/*!
+ * \brief Product of 2x2, 3x3 and 4x4 matrices
+ *
+ * Fixed-size products use unrolled kernels (SSE/AVX for 4x4 float and
+ * double matrices) instead of the configured product backend.
+ */
+template<typename T>
+auto operator *(const Matrix<T, 2, 2>& matrix1,
+                const Matrix<T, 2, 2>& matrix2) -> Matrix<T, 2, 2>
+{
+    Matrix<T, 2, 2> matrix;
+    internal::mulmat2x2_cpp(matrix1.data(), matrix2.data(), matrix.data());
+    return matrix;
+}
+
+template<typename T>
+auto operator *(const Matrix<T, 3, 3>& matrix1,
+                const Matrix<T, 3, 3>& matrix2) -> Matrix<T, 3, 3>
+{
+    Matrix<T, 3, 3> matrix;
+    internal::mulmat3x3_cpp(matrix1.data(), matrix2.data(), matrix.data());
+    return matrix;
+}
+
+template<typename T>
+auto operator *(const Matrix<T, 4, 4>& matrix1,
+                const Matrix<T, 4, 4>& matrix2) -> Matrix<T, 4, 4>
+{
+    Matrix<T, 4, 4> matrix;
+    internal::mulmat4x4(matrix1.data(), matrix2.data(), matrix.data());
+    return matrix;
+}
+
 template<typename T>
 auto operator *(const Matrix<T>& matrix1,
                 const Matrix<T>& matrix2) -> Matrix<T>
@@ -2534,6 +2641,36 @@ auto operator *(const Matrix<T, Rows, Cols>& matrix,
     return vector_out;
 }
 
+/*!
+ * \brief Product of a 2x2, 3x3 or 4x4 matrix by a vector
+ */
+template<typename T>
+auto operator *(const Matrix<T, 2, 2>& matrix,
+                const Vector<T, 2>& vector) -> Vector<T, 2>
+{
+    Vector<T, 2> vector_out;
+    internal::matrix_per_vector2x2_cpp(matrix.data(), vector.data(), vector_out.data());
+    return vector_out;
+}
+
+template<typename T>
+auto operator *(const Matrix<T, 3, 3>& matrix,
+                const Vector<T, 3>& vector) -> Vector<T, 3>
+{
+    Vector<T, 3> vector_out;
+    internal::matrix_per_vector3x3_cpp(matrix.data(), vector.data(), vector_out.data());
+    return vector_out;
+}
+
+template<typename T>
+auto operator *(const Matrix<T, 4, 4>& matrix,
+                const Vector<T, 4>& vector) -> Vector<T, 4>
+{
+    Vector<T, 4> vector_out;
+    internal::matrix_per_vector4x4(matrix.data(), vector.data(), vector_out.data());
+    return vector_out;
+}
+
 template<typename T>
 auto operator *(const Matrix<T>& matrix,
                 const Vector<T>& vector) -> Vector<T>
@@ -2614,6 +2751,32 @@ auto operator *(const Vector<T, _dim>& vector,
     return matrix * vector;
 }
 
+
+/* MatrixConfig implementation */
+
+inline auto MatrixConfig::select(size_t m, size_t n, size_t k) const -> Product
+{
+    if (product != Product::Auto) return product;
+
+    Thresholds thresholds = MatrixConfig::thresholds();
+    size_t work = m * n * k;
+
+#ifdef TL_HAVE_CUDA
+    if (work >= thresholds.cublas) return Product::CuBLAS;
+#endif
+#ifdef TL_HAVE_OPENBLAS
+    if (work >= thresholds.blas) return Product::BLAS;
+#endif
+    if (work >= thresholds.blocked) return Product::Blocked;
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+    return Product::SIMD;
+#else
+    return Product::CPP;
+#endif
+}
+
+
 /*! \} */ // end of algebra
 
 /*! \} */ // end of math
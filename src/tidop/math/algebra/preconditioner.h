@@ -0,0 +1,267 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <cmath>
+#include <vector>
+
+#include "tidop/math/math.h"
+#include "tidop/math/algebra/sparse_matrix.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Algebra
+ *
+ * Algebra
+ *
+ *  \{
+ */
+
+/*!
+ * \brief Preconditioners for the iterative solvers
+ *
+ * A preconditioner M approximates the system matrix A. apply() computes
+ * z = M^-1 * r.
+ */
+
+/*!
+ * \brief No preconditioning (M = I)
+ */
+template<typename T>
+class IdentityPreconditioner
+{
+
+public:
+
+    IdentityPreconditioner() = default;
+    explicit IdentityPreconditioner(const SparseMatrixCSR<T> &matrix)
+      : mSize(matrix.rows())
+    {
+    }
+
+    void apply(const T *r, T *z) const
+    {
+        std::copy(r, r + mSize, z);
+    }
+
+private:
+
+    size_t mSize{0};
+};
+
+
+/*!
+ * \brief Jacobi preconditioner (M = diag(A))
+ */
+template<typename T>
+class JacobiPreconditioner
+{
+
+public:
+
+    JacobiPreconditioner() = default;
+    explicit JacobiPreconditioner(const SparseMatrixCSR<T> &matrix)
+    {
+        Vector<T> diagonal = matrix.diagonal();
+        mInverseDiagonal.resize(diagonal.size());
+        for (size_t i = 0; i < diagonal.size(); i++) {
+            mInverseDiagonal[i] = diagonal[i] != consts::zero<T> ? consts::one<T> / diagonal[i] : consts::one<T>;
+        }
+    }
+
+    void apply(const T *r, T *z) const
+    {
+        for (size_t i = 0; i < mInverseDiagonal.size(); i++)
+            z[i] = r[i] * mInverseDiagonal[i];
+    }
+
+private:
+
+    std::vector<T> mInverseDiagonal;
+};
+
+
+/*!
+ * \brief Incomplete Cholesky preconditioner with zero fill-in, IC(0)
+ *
+ * M = L * L', where L has the sparsity pattern of the lower triangle of A.
+ * The factorization of a symmetric positive definite matrix can break down.
+ * In that case the diagonal is shifted by a growing factor and the factorization
+ * is restarted (Manteuffel, 1980).
+ */
+template<typename T>
+class IncompleteCholeskyPreconditioner
+{
+
+public:
+
+    IncompleteCholeskyPreconditioner() = default;
+    explicit IncompleteCholeskyPreconditioner(const SparseMatrixCSR<T> &matrix);
+
+    void apply(const T *r, T *z) const;
+
+    /*!
+     * \brief Diagonal shift used in the factorization
+     */
+    auto shift() const -> T
+    {
+        return mShift;
+    }
+
+private:
+
+    auto factorize(const SparseMatrixCSR<T> &matrix, T shift) -> bool;
+
+private:
+
+    size_t mSize{0};
+    std::vector<size_t> mOuterIndex;
+    std::vector<size_t> mInnerIndex;
+    std::vector<T> mValues;
+    T mShift{0};
+};
+
+
+template<typename T>
+IncompleteCholeskyPreconditioner<T>::IncompleteCholeskyPreconditioner(const SparseMatrixCSR<T> &matrix)
+  : mSize(matrix.rows())
+{
+    TL_ASSERT(matrix.rows() == matrix.cols(), "Non-Square Matrix");
+
+    T shift = consts::zero<T>;
+
+    for (int i = 0; i < 20; i++) {
+        if (factorize(matrix, shift)) {
+            mShift = shift;
+            return;
+        }
+        shift = shift == consts::zero<T> ? static_cast<T>(1e-3) : shift * 2;
+    }
+
+    TL_THROW_EXCEPTION("Incomplete Cholesky factorization failed");
+}
+
+template<typename T>
+auto IncompleteCholeskyPreconditioner<T>::factorize(const SparseMatrixCSR<T> &matrix, T shift) -> bool
+{
+    const auto &outer = matrix.outerIndex();
+    const auto &inner = matrix.innerIndex();
+    const auto &values = matrix.values();
+
+    /// Lower triangle of A. The diagonal is the last entry of each row
+    mOuterIndex.assign(mSize + 1, 0);
+    mInnerIndex.clear();
+    mValues.clear();
+
+    for (size_t i = 0; i < mSize; i++) {
+        bool diagonal = false;
+        for (size_t p = outer[i]; p < outer[i + 1] && inner[p] <= i; p++) {
+            mInnerIndex.push_back(inner[p]);
+            mValues.push_back(inner[p] == i ? values[p] * (consts::one<T> + shift) : values[p]);
+            diagonal = inner[p] == i;
+        }
+        if (!diagonal) return false;
+        mOuterIndex[i + 1] = mInnerIndex.size();
+    }
+
+    for (size_t i = 0; i < mSize; i++) {
+
+        size_t row_ini = mOuterIndex[i];
+        size_t row_diagonal = mOuterIndex[i + 1] - 1;
+
+        for (size_t p = row_ini; p < row_diagonal; p++) {
+
+            size_t k = mInnerIndex[p];
+            T sum = mValues[p];
+
+            /// Dot product of rows i and k over the columns j < k
+            size_t pi = row_ini;
+            size_t pk = mOuterIndex[k];
+            size_t pk_end = mOuterIndex[k + 1] - 1;
+            while (pi < p && pk < pk_end) {
+                if (mInnerIndex[pi] == mInnerIndex[pk]) {
+                    sum -= mValues[pi] * mValues[pk];
+                    pi++;
+                    pk++;
+                } else if (mInnerIndex[pi] < mInnerIndex[pk]) {
+                    pi++;
+                } else {
+                    pk++;
+                }
+            }
+
+            mValues[p] = sum / mValues[pk_end];
+        }
+
+        T diagonal = mValues[row_diagonal];
+        for (size_t p = row_ini; p < row_diagonal; p++)
+            diagonal -= mValues[p] * mValues[p];
+
+        if (diagonal <= consts::zero<T> || !std::isfinite(diagonal)) return false;
+
+        mValues[row_diagonal] = std::sqrt(diagonal);
+    }
+
+    return true;
+}
+
+template<typename T>
+void IncompleteCholeskyPreconditioner<T>::apply(const T *r, T *z) const
+{
+    /// L * y = r
+    for (size_t i = 0; i < mSize; i++) {
+        T sum = r[i];
+        size_t row_diagonal = mOuterIndex[i + 1] - 1;
+        for (size_t p = mOuterIndex[i]; p < row_diagonal; p++)
+            sum -= mValues[p] * z[mInnerIndex[p]];
+        z[i] = sum / mValues[row_diagonal];
+    }
+
+    /// L' * z = y
+    for (size_t i = mSize; i > 0; i--) {
+        size_t row = i - 1;
+        size_t row_diagonal = mOuterIndex[row + 1] - 1;
+        z[row] /= mValues[row_diagonal];
+        T value = z[row];
+        for (size_t p = mOuterIndex[row]; p < row_diagonal; p++)
+            z[mInnerIndex[p]] -= mValues[p] * value;
+    }
+}
+
+
+/*! \} */ // end of Algebra
+
+/*! \} */ // end of Math
+
+} // End namespace tl
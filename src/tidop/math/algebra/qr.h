@@ -25,10 +25,12 @@
 #pragma once
 
 #include <algorithm>
+#include <vector>
 
 #include "tidop/math/math.h"
 #include "tidop/math/algebra/vector.h"
 #include "tidop/math/algebra/matrix.h"
+#include "tidop/math/algebra/dense_kernels.h"
 #include "tidop/math/lapack.h"
 
 namespace tl
@@ -62,6 +64,11 @@ namespace tl
  * \f[ Q^t*Q = I \f]
  *
  * y R es una matriz triangular superior.
+ *
+ * A partir de internal::blocked_decomposition_threshold filas se usa la
+ * versión por bloques: los reflectores de Householder de cada panel se
+ * acumulan en la representación compacta WY (I - V*T*V') y se aplican al
+ * resto de la matriz y a Q' con productos de matrices (GEMM).
  */
 template<typename T>
 class QRDecomposition;
@@ -78,6 +85,7 @@ public:
     QRDecomposition(const Matrix_t<T, _rows, _cols> &a);
 
     auto solve(const Vector<T, _rows>& b) -> Vector<T, _rows>;
+    auto solve(const Matrix_t<T, _rows, _cols> &b) const -> Matrix_t<T, _rows, _cols>;
 
     auto q() const -> Matrix<T, _rows, _cols>;
     auto r() const -> Matrix<T, _rows, _cols>;
@@ -87,6 +95,8 @@ private:
 
     //Householder
     void decompose();
+    void decomposeBlocked(Vector<T, _rows> &c, Vector<T, _rows> &diagonal);
+    void householder(size_t k, size_t end, Vector<T, _rows> &c, Vector<T, _rows> &diagonal);
 
     //#ifdef TL_HAVE_OPENBLAS
     //  void lapackeDecompose();
@@ -137,84 +147,199 @@ void QRDecomposition<Matrix_t<T, _rows, _cols>>::decompose()
     Vector<T, _rows> c(mRows);
     Vector<T, _rows> diagonal(mRows);
 
-    for (size_t k = 0; k < mRows - 1; k++) {
+    if (mRows >= internal::blocked_decomposition_threshold) {
 
-        T scale = consts::zero<T>;
+        decomposeBlocked(c, diagonal);
 
-        for (size_t i = k; i < mRows; i++) {
-            scale = std::max(scale, std::abs(R[i][k]));
+    } else {
+
+        for (size_t k = 0; k < mRows - 1; k++) {
+            householder(k, mRows, c, diagonal);
         }
 
-        if (scale == consts::zero<T>) {
+        for (size_t k = 0; k < mRows - 1; k++) {
 
-            singular = true;
-            c[k] = diagonal[k] = consts::zero<T>;
+            if (c[k] != consts::zero<T>) {
 
-        } else {
+                for (size_t j = 0; j < mRows; j++) {
 
-            for (size_t i = k; i < mRows; i++) {
-                R[i][k] /= scale;
-            }
+                    T aux{0};
+                    for (size_t i = k; i < mRows; i++)
+                        aux += R[i][k] * Q_t[i][j];
+
+                    aux /= c[k];
 
-            T aux{0};
+                    for (size_t i = k; i < mRows; i++)
+                        Q_t[i][j] -= aux * R[i][k];
+                }
 
-            for (size_t i = k; i < mRows; i++) {
-                aux += R[i][k] * R[i][k];
             }
+        }
+    }
 
-            T sigma = std::copysign(sqrt(aux), R[k][k]);
-            R.at(k, k) += sigma;
-            c[k] = sigma * R[k][k];
-            diagonal[k] = -scale * sigma;
+    diagonal[mRows - 1] = R[mRows - 1][mRows - 1];
 
-            for (size_t j = k + 1; j < mRows; j++) {
+    singular = (diagonal[mRows - 1] == consts::zero<T>);
 
-                T aux{0};
+    for (size_t r = 0; r < mRows; r++) {
 
-                for (size_t i = k; i < mRows; i++) {
-                    aux += R[i][k] * R[i][j];
-                }
+        R[r][r] = diagonal[r];
 
-                T tau = aux / c[k];
+        for (size_t c = 0; c < r; c++)
+            R[r][c] = consts::zero<T>;
 
-                for (size_t i = k; i < mRows; i++) {
-                    R[i][j] -= tau * R[i][k];
-                }
+    }
+}
 
-            }
-        }
+/*!
+ * \brief Reflector de Householder de la columna k
+ *
+ * El vector v del reflector H = I - v*v'/c se guarda en la columna k de R
+ * (filas k a mRows-1) y se aplica a las columnas [k+1, end).
+ */
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t _rows, size_t _cols
+>
+void QRDecomposition<Matrix_t<T, _rows, _cols>>::householder(size_t k, size_t end, Vector<T, _rows> &c, Vector<T, _rows> &diagonal)
+{
+    T scale = consts::zero<T>;
+
+    for (size_t i = k; i < mRows; i++) {
+        scale = std::max(scale, std::abs(R[i][k]));
     }
 
-    diagonal[mRows - 1] = R[mRows - 1][mRows - 1];
+    if (scale == consts::zero<T>) {
 
-    singular = (diagonal[mRows - 1] == consts::zero<T>);
+        singular = true;
+        c[k] = diagonal[k] = consts::zero<T>;
 
-    for (size_t k = 0; k < mRows - 1; k++) {
+    } else {
 
-        if (c[k] != consts::zero<T>) {
+        for (size_t i = k; i < mRows; i++) {
+            R[i][k] /= scale;
+        }
 
-            for (size_t j = 0; j < mRows; j++) {
+        T aux{0};
 
-                T aux{0};
-                for (size_t i = k; i < mRows; i++)
-                    aux += R[i][k] * Q_t[i][j];
+        for (size_t i = k; i < mRows; i++) {
+            aux += R[i][k] * R[i][k];
+        }
 
-                aux /= c[k];
+        T sigma = std::copysign(sqrt(aux), R[k][k]);
+        R.at(k, k) += sigma;
+        c[k] = sigma * R[k][k];
+        diagonal[k] = -scale * sigma;
 
-                for (size_t i = k; i < mRows; i++)
-                    Q_t[i][j] -= aux * R[i][k];
-            }
+        /// Rows are traversed in order so that the column updates are vectorized
+
+        T *r = R.data();
+        size_t ld = R.cols();
+        size_t cols = end - k - 1;
+        std::vector<T> tau(cols, consts::zero<T>);
+
+        for (size_t i = k; i < mRows; i++) {
+            internal::axpy(cols, r[i * ld + k], &r[i * ld + k + 1], tau.data());
+        }
+
+        for (size_t j = 0; j < cols; j++) {
+            tau[j] /= c[k];
+        }
 
+        for (size_t i = k; i < mRows; i++) {
+            internal::axpy(cols, -r[i * ld + k], tau.data(), &r[i * ld + k + 1]);
         }
     }
+}
 
-    for (size_t r = 0; r < mRows; r++) {
+/*!
+ * \brief Factorización por bloques
+ *
+ * Para cada panel de reflectores H1*H2*...*Hb = I - V*T*V' se aplica
+ * H' = I - V*T'*V' al resto de columnas de R y a las filas de Q'.
+ */
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t _rows, size_t _cols
+>
+void QRDecomposition<Matrix_t<T, _rows, _cols>>::decomposeBlocked(Vector<T, _rows> &c, Vector<T, _rows> &diagonal)
+{
+    T *r = R.data();
+    size_t ld = R.cols();
+    size_t block_size = internal::blocked_decomposition_block_size;
 
-        R[r][r] = diagonal[r];
+    std::vector<T> v(mRows * block_size);
+    std::vector<T> t(block_size * block_size);
+    std::vector<T> w(block_size * mRows);
+    std::vector<T> w2(block_size * mRows);
 
-        for (size_t c = 0; c < r; c++)
-            R[r][c] = consts::zero<T>;
+    for (size_t k = 0; k < mRows - 1; k += block_size) {
+
+        size_t next = std::min(k + block_size, mRows - 1);
+        size_t block = next - k;
+        size_t rows = mRows - k;
+
+        for (size_t j = k; j < next; j++) {
+            householder(j, next, c, diagonal);
+        }
+
+        /// V (rows x block) with the reflectors of the panel
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t j = 0; j < block; j++) {
+                v[i * block + j] = i >= j ? r[(k + i) * ld + k + j] : consts::zero<T>;
+            }
+        }
+
+        /// T (block x block), upper triangular
+        std::fill(t.begin(), t.end(), consts::zero<T>);
 
+        for (size_t i = 0; i < block; i++) {
+
+            if (c[k + i] == consts::zero<T>) continue;
+
+            T tau = consts::one<T> / c[k + i];
+            t[i * block + i] = tau;
+
+            /// T(0:i, i) = -tau * T(0:i, 0:i) * V(:, 0:i)' * v_i
+            for (size_t j = 0; j < i; j++) {
+                T z{0};
+                for (size_t p = i; p < rows; p++)
+                    z += v[p * block + j] * v[p * block + i];
+                w[j] = z;
+            }
+
+            for (size_t j = 0; j < i; j++) {
+                T sum{0};
+                for (size_t p = j; p < i; p++)
+                    sum += t[j * block + p] * w[p];
+                t[j * block + i] = -tau * sum;
+            }
+        }
+
+        /// C = C - V * T' * V' * C
+        auto apply = [&](T *c_block, size_t cols) {
+
+            std::fill(w.begin(), w.begin() + block * cols, consts::zero<T>);
+            std::fill(w2.begin(), w2.begin() + block * cols, consts::zero<T>);
+
+            internal::gemm(block, cols, rows, consts::one<T>,
+                           v.data(), size_t{1}, block,
+                           c_block, ld, size_t{1},
+                           w.data(), cols);
+            internal::gemm(block, cols, block, consts::one<T>,
+                           t.data(), size_t{1}, block,
+                           w.data(), cols, size_t{1},
+                           w2.data(), cols);
+            internal::gemm(rows, cols, block, -consts::one<T>,
+                           v.data(), block, size_t{1},
+                           w2.data(), cols, size_t{1},
+                           c_block, ld);
+        };
+
+        if (next < mRows)
+            apply(&r[k * ld + next], mRows - next);
+
+        apply(Q_t.data() + k * Q_t.cols(), mRows);
     }
 }
 
@@ -242,6 +367,30 @@ auto QRDecomposition<Matrix_t<T, _rows, _cols>>::solve(const Vector<T, _rows>& b
     return x;
 }
 
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t _rows, size_t _cols
+>
+auto QRDecomposition<Matrix_t<T, _rows, _cols>>::solve(const Matrix_t<T, _rows, _cols> &b) const -> Matrix_t<T, _rows, _cols>
+{
+    TL_ASSERT(b.rows() == mRows, "QRDecomposition::solve bad sizes");
+    TL_ASSERT(!singular, "Singular");
+
+    size_t nrhs = b.cols();
+
+    /// X = Q' * B
+    Matrix_t<T, _rows, _cols> x(b.rows(), b.cols(), consts::zero<T>);
+    internal::gemm(mRows, nrhs, mRows, consts::one<T>,
+                   Q_t.data(), Q_t.cols(), size_t{1},
+                   b.data(), nrhs, size_t{1},
+                   x.data(), nrhs);
+
+    /// R * X = Q' * B
+    internal::solve_upper_triangular(mRows, nrhs, false, R.data(), R.cols(), size_t{1}, x.data(), nrhs);
+
+    return x;
+}
+
 template<
     template<typename, size_t, size_t>
 class Matrix_t, typename T, size_t _rows, size_t _cols
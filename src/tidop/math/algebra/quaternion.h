@@ -601,6 +601,76 @@ auto dot(const Quaternion<T>& quat1, const Quaternion<T>& quat2) -> T
     return quat1.x * quat2.x + quat1.y * quat2.y + quat1.z * quat2.z + quat1.w * quat2.w;
 }
 
+/// \cond
+
+namespace internal
+{
+
+/// Above this cosine of the angle slerp falls back to nlerp
+template<typename T>
+constexpr T slerp_linear_threshold = static_cast<T>(0.9995);
+
+} // namespace internal
+
+/// \endcond
+
+/*!
+ * \brief Normalised linear interpolation between two unit quaternions
+ *
+ * Follows the shortest arc: quat2 is negated when the quaternions lie in
+ * opposite hemispheres.
+ *
+ * \param[in] quat1 Quaternion for t = 0
+ * \param[in] quat2 Quaternion for t = 1
+ * \param[in] t Interpolation parameter in [0, 1]
+ */
+template<typename T>
+auto nlerp(const Quaternion<T> &quat1, const Quaternion<T> &quat2, T t) -> Quaternion<T>
+{
+    T k1 = consts::one<T> - t;
+    T k2 = dot(quat1, quat2) < consts::zero<T> ? -t : t;
+
+    Quaternion<T> quaternion(k1 * quat1.x + k2 * quat2.x,
+                             k1 * quat1.y + k2 * quat2.y,
+                             k1 * quat1.z + k2 * quat2.z,
+                             k1 * quat1.w + k2 * quat2.w);
+    quaternion.normalize();
+
+    return quaternion;
+}
+
+/*!
+ * \brief Spherical linear interpolation between two unit quaternions
+ *
+ * Interpolates at constant angular velocity along the shortest arc. Nearly
+ * parallel quaternions are interpolated with nlerp.
+ *
+ * \param[in] quat1 Quaternion for t = 0
+ * \param[in] quat2 Quaternion for t = 1
+ * \param[in] t Interpolation parameter in [0, 1]
+ */
+template<typename T>
+auto slerp(const Quaternion<T> &quat1, const Quaternion<T> &quat2, T t) -> Quaternion<T>
+{
+    T cos_theta = dot(quat1, quat2);
+    bool opposite = cos_theta < consts::zero<T>;
+    if (opposite) cos_theta = -cos_theta;
+
+    if (cos_theta > internal::slerp_linear_threshold<T>)
+        return nlerp(quat1, quat2, t);
+
+    T theta = std::acos(cos_theta);
+    T inv_sin_theta = consts::one<T> / std::sin(theta);
+    T k1 = std::sin((consts::one<T> - t) * theta) * inv_sin_theta;
+    T k2 = std::sin(t * theta) * inv_sin_theta;
+    if (opposite) k2 = -k2;
+
+    return Quaternion<T>(k1 * quat1.x + k2 * quat2.x,
+                         k1 * quat1.y + k2 * quat2.y,
+                         k1 * quat1.z + k2 * quat2.z,
+                         k1 * quat1.w + k2 * quat2.w);
+}
+
 template<typename T> 
 auto operator ==(const Quaternion<T>& q1, const Quaternion<T>& q2) -> bool
 {
@@ -0,0 +1,1373 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/math.h"
+#include "tidop/math/simd.h"
+#include "tidop/math/algebra/rotation_convert.h"
+
+namespace tl
+{
+
+/*! \addtogroup math
+ *  \{
+ */
+
+/*! \addtogroup algebra
+ *  \{
+ */
+
+/*! \addtogroup rotations
+ *  \{
+ */
+
+
+/*!
+ * \brief Batch of quaternions stored as structure of arrays
+ */
+template<typename T>
+class QuaternionBatch
+{
+
+public:
+
+    QuaternionBatch() = default;
+    explicit QuaternionBatch(size_t size);
+
+    auto size() const -> size_t;
+    void resize(size_t size);
+    void push_back(const Quaternion<T> &quaternion);
+
+    auto at(size_t index) const -> Quaternion<T>;
+    void set(size_t index, const Quaternion<T> &quaternion);
+
+    /*!
+     * \brief Normalises all the quaternions
+     * A zero quaternion is left as zero, like Quaternion::normalize
+     */
+    void normalize();
+
+public:
+
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> z;
+    std::vector<T> w;
+
+};
+
+
+/*!
+ * \brief Batch of rotation matrices stored as structure of arrays
+ * Each member holds one element of all the matrices (r01 is row 0, column 1)
+ */
+template<typename T>
+class RotationMatrixBatch
+{
+
+public:
+
+    RotationMatrixBatch() = default;
+    explicit RotationMatrixBatch(size_t size);
+
+    auto size() const -> size_t;
+    void resize(size_t size);
+    void push_back(const RotationMatrix<T> &rotationMatrix);
+
+    auto at(size_t index) const -> RotationMatrix<T>;
+    void set(size_t index, const RotationMatrix<T> &rotationMatrix);
+
+public:
+
+    std::vector<T> r00;
+    std::vector<T> r01;
+    std::vector<T> r02;
+    std::vector<T> r10;
+    std::vector<T> r11;
+    std::vector<T> r12;
+    std::vector<T> r20;
+    std::vector<T> r21;
+    std::vector<T> r22;
+
+};
+
+
+/*!
+ * \brief Batch of rotations in axis-angle notation stored as structure of arrays
+ * The axes must be unit vectors
+ */
+template<typename T>
+class AxisAngleBatch
+{
+
+public:
+
+    AxisAngleBatch() = default;
+    explicit AxisAngleBatch(size_t size);
+
+    auto size() const -> size_t;
+    void resize(size_t size);
+    void push_back(const AxisAngle<T> &axisAngle);
+
+    auto at(size_t index) const -> AxisAngle<T>;
+    void set(size_t index, const AxisAngle<T> &axisAngle);
+
+public:
+
+    std::vector<T> angle;
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> z;
+
+};
+
+
+/*!
+ * \brief Batch of Euler angles stored as structure of arrays
+ * All the rotations share the same axes sequence
+ */
+template<typename T>
+class EulerAnglesBatch
+{
+
+public:
+
+    EulerAnglesBatch() = default;
+    explicit EulerAnglesBatch(size_t size, Axes axes = Axes::xyz);
+
+    auto size() const -> size_t;
+    void resize(size_t size);
+    void push_back(const EulerAngles<T> &eulerAngles);
+
+    auto at(size_t index) const -> EulerAngles<T>;
+    void set(size_t index, const EulerAngles<T> &eulerAngles);
+
+public:
+
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> z;
+    Axes axes{Axes::xyz};
+
+};
+
+
+/*!
+ * \brief Conversions between batches of rotations
+ *
+ * The results match RotationConverter applied to each rotation, up to
+ * rounding. Quaternion, rotation matrix and axis-angle conversions are
+ * vectorized with Packed; trigonometric functions are evaluated lane by lane.
+ * Euler angle conversions apply RotationConverter to each rotation. Large
+ * batches are split in blocks processed in parallel.
+ *
+ * <h4>Example</h4>
+ * \code
+ * QuaternionBatch<double> attitudes = ...;
+ * RotationMatrixBatch<double> matrices;
+ * RotationBatchConverter<double>::convert(attitudes, matrices);
+ * \endcode
+ */
+template<typename T>
+class RotationBatchConverter
+{
+
+public:
+
+    static void convert(const QuaternionBatch<T> &quaternions,
+                        RotationMatrixBatch<T> &rotationMatrices);
+    static void convert(const RotationMatrixBatch<T> &rotationMatrices,
+                        QuaternionBatch<T> &quaternions);
+
+    static void convert(const QuaternionBatch<T> &quaternions,
+                        AxisAngleBatch<T> &axisAngles);
+    static void convert(const AxisAngleBatch<T> &axisAngles,
+                        QuaternionBatch<T> &quaternions);
+
+    static void convert(const AxisAngleBatch<T> &axisAngles,
+                        RotationMatrixBatch<T> &rotationMatrices);
+    static void convert(const RotationMatrixBatch<T> &rotationMatrices,
+                        AxisAngleBatch<T> &axisAngles);
+
+    static void convert(const RotationMatrixBatch<T> &rotationMatrices,
+                        EulerAnglesBatch<T> &eulerAngles);
+    static void convert(const EulerAnglesBatch<T> &eulerAngles,
+                        RotationMatrixBatch<T> &rotationMatrices);
+
+    static void convert(const QuaternionBatch<T> &quaternions,
+                        EulerAnglesBatch<T> &eulerAngles);
+    static void convert(const EulerAnglesBatch<T> &eulerAngles,
+                        QuaternionBatch<T> &quaternions);
+
+    static void convert(const AxisAngleBatch<T> &axisAngles,
+                        EulerAnglesBatch<T> &eulerAngles);
+    static void convert(const EulerAnglesBatch<T> &eulerAngles,
+                        AxisAngleBatch<T> &axisAngles);
+
+};
+
+
+
+/// \cond
+
+namespace internal
+{
+
+/// Number of rotations processed by each task
+constexpr size_t rotation_batch_block_size = 4096;
+/// Batches smaller than this are processed in the calling thread
+constexpr size_t rotation_batch_parallel_threshold = 16384;
+/// Rotations processed by each pass of the kernels with trigonometric functions
+constexpr size_t rotation_batch_chunk_size = 64;
+
+template<typename T>
+struct is_simd_rotation_type
+#ifdef TL_HAVE_SIMD_INTRINSICS
+  : std::integral_constant<bool, std::is_same<float, std::remove_cv_t<T>>::value ||
+                                 std::is_same<double, std::remove_cv_t<T>>::value>
+#else
+  : std::false_type
+#endif
+{
+};
+
+/*!
+ * \brief Splits the batch in blocks and runs the kernel over them.
+ * Small batches are processed in the calling thread.
+ */
+template<typename Kernel>
+void rotation_batch_run(size_t size, Kernel kernel)
+{
+    if (size < rotation_batch_parallel_threshold) {
+        kernel(0, size);
+        return;
+    }
+
+    size_t blocks = (size + rotation_batch_block_size - 1) / rotation_batch_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * rotation_batch_block_size;
+        size_t end = std::min(ini + rotation_batch_block_size, size);
+        kernel(ini, end);
+    });
+}
+
+
+/* Scalar kernels */
+
+template<typename T>
+void quaternion_normalize_cpp(QuaternionBatch<T> &q, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        Quaternion<T> quaternion = q.at(i);
+        quaternion.normalize();
+        q.set(i, quaternion);
+    }
+}
+
+template<typename T>
+void quaternion_multiply_cpp(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2,
+                             QuaternionBatch<T> &q, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        q.set(i, q1.at(i) * q2.at(i));
+    }
+}
+
+template<typename T>
+void quaternion_nlerp_cpp(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2, const T *t,
+                          QuaternionBatch<T> &q, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        q.set(i, nlerp(q1.at(i), q2.at(i), t[i]));
+    }
+}
+
+template<typename T>
+void quaternion_slerp_cpp(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2, const T *t,
+                          QuaternionBatch<T> &q, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        q.set(i, slerp(q1.at(i), q2.at(i), t[i]));
+    }
+}
+
+template<typename T>
+void quaternion_to_rotation_matrix_cpp(const QuaternionBatch<T> &q, RotationMatrixBatch<T> &r,
+                                       size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        const T quaternion[4] = {q.x[i], q.y[i], q.z[i], q.w[i]};
+        T m[9];
+        quaternion_to_rotation_matrix(quaternion, m);
+        r.r00[i] = m[0];
+        r.r01[i] = m[1];
+        r.r02[i] = m[2];
+        r.r10[i] = m[3];
+        r.r11[i] = m[4];
+        r.r12[i] = m[5];
+        r.r20[i] = m[6];
+        r.r21[i] = m[7];
+        r.r22[i] = m[8];
+    }
+}
+
+template<typename T>
+void rotation_matrix_to_quaternion_cpp(const RotationMatrixBatch<T> &r, QuaternionBatch<T> &q,
+                                       size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        const T m[9] = {r.r00[i], r.r01[i], r.r02[i],
+                        r.r10[i], r.r11[i], r.r12[i],
+                        r.r20[i], r.r21[i], r.r22[i]};
+        T quaternion[4];
+        rotation_matrix_to_quaternion(m, quaternion);
+        q.x[i] = quaternion[0];
+        q.y[i] = quaternion[1];
+        q.z[i] = quaternion[2];
+        q.w[i] = quaternion[3];
+    }
+}
+
+template<typename T>
+void quaternion_to_axis_angle_cpp(const QuaternionBatch<T> &q, AxisAngleBatch<T> &a,
+                                  size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        T n = std::sqrt(q.x[i] * q.x[i] + q.y[i] * q.y[i] + q.z[i] * q.z[i]);
+        if (n > consts::zero<T>) {
+            a.x[i] = q.x[i] / n;
+            a.y[i] = q.y[i] / n;
+            a.z[i] = q.z[i] / n;
+            a.angle[i] = consts::two<T> * std::acos(clamp(q.w[i], -consts::one<T>, consts::one<T>));
+        } else {
+            a.x[i] = consts::one<T>;
+            a.y[i] = consts::zero<T>;
+            a.z[i] = consts::zero<T>;
+            a.angle[i] = consts::zero<T>;
+        }
+    }
+}
+
+template<typename T>
+void axis_angle_to_quaternion_cpp(const AxisAngleBatch<T> &a, QuaternionBatch<T> &q,
+                                  size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        T a_2 = a.angle[i] * consts::one_half<T>;
+        T sin_a_2 = std::sin(a_2);
+        q.x[i] = sin_a_2 * a.x[i];
+        q.y[i] = sin_a_2 * a.y[i];
+        q.z[i] = sin_a_2 * a.z[i];
+        q.w[i] = std::cos(a_2);
+    }
+}
+
+template<typename T>
+void axis_angle_to_rotation_matrix_cpp(const AxisAngleBatch<T> &a, RotationMatrixBatch<T> &r,
+                                       size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        T ca = std::cos(a.angle[i]);
+        T sa = std::sin(a.angle[i]);
+        T _1mca = consts::one<T> - ca;
+        T xy1mca = a.x[i] * a.y[i] * _1mca;
+        T xz1mca = a.x[i] * a.z[i] * _1mca;
+        T yz1mca = a.y[i] * a.z[i] * _1mca;
+        T xsa = a.x[i] * sa;
+        T ysa = a.y[i] * sa;
+        T zsa = a.z[i] * sa;
+
+        r.r00[i] = a.x[i] * a.x[i] * _1mca + ca;
+        r.r01[i] = xy1mca - zsa;
+        r.r02[i] = xz1mca + ysa;
+        r.r10[i] = xy1mca + zsa;
+        r.r11[i] = a.y[i] * a.y[i] * _1mca + ca;
+        r.r12[i] = yz1mca - xsa;
+        r.r20[i] = xz1mca - ysa;
+        r.r21[i] = yz1mca + xsa;
+        r.r22[i] = a.z[i] * a.z[i] * _1mca + ca;
+    }
+}
+
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+/* Vectorized kernels. The tail of each block runs the scalar kernel. */
+
+template<typename T>
+auto quaternion_normalize_block(QuaternionBatch<T> &q,
+                                size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> one(consts::one<T>);
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> x, y, z, w;
+        x.loadUnaligned(&q.x[i]);
+        y.loadUnaligned(&q.y[i]);
+        z.loadUnaligned(&q.z[i]);
+        w.loadUnaligned(&q.w[i]);
+
+        Packed<T> norm = internal::squareRoot(x * x + y * y + z * z + w * w);
+        Packed<T> mask = internal::greaterThan(norm, zero);
+        Packed<T> inv = one / internal::select(mask, norm, one);
+
+        internal::select(mask, x * inv, zero).storeUnaligned(&q.x[i]);
+        internal::select(mask, y * inv, zero).storeUnaligned(&q.y[i]);
+        internal::select(mask, z * inv, zero).storeUnaligned(&q.z[i]);
+        internal::select(mask, w * inv, zero).storeUnaligned(&q.w[i]);
+    }
+
+    quaternion_normalize_cpp(q, max_vector, end);
+}
+
+template<typename T>
+auto quaternion_multiply_block(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2,
+                               QuaternionBatch<T> &q,
+                               size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> x1, y1, z1, w1;
+        x1.loadUnaligned(&q1.x[i]);
+        y1.loadUnaligned(&q1.y[i]);
+        z1.loadUnaligned(&q1.z[i]);
+        w1.loadUnaligned(&q1.w[i]);
+
+        Packed<T> x2, y2, z2, w2;
+        x2.loadUnaligned(&q2.x[i]);
+        y2.loadUnaligned(&q2.y[i]);
+        z2.loadUnaligned(&q2.z[i]);
+        w2.loadUnaligned(&q2.w[i]);
+
+        (x1 * w2 + y1 * z2 - z1 * y2 + w1 * x2).storeUnaligned(&q.x[i]);
+        (-x1 * z2 + y1 * w2 + z1 * x2 + w1 * y2).storeUnaligned(&q.y[i]);
+        (x1 * y2 - y1 * x2 + z1 * w2 + w1 * z2).storeUnaligned(&q.z[i]);
+        (-x1 * x2 - y1 * y2 - z1 * z2 + w1 * w2).storeUnaligned(&q.w[i]);
+    }
+
+    quaternion_multiply_cpp(q1, q2, q, max_vector, end);
+}
+
+/*!
+ * Interpolates q = k1 * q1 + k2 * q2 for the packed lanes starting at i and
+ * normalises the lanes selected by the mask.
+ */
+template<typename T>
+void quaternion_combine_packed(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2,
+                               const Packed<T> &k1, const Packed<T> &k2, const Packed<T> &normalize,
+                               QuaternionBatch<T> &q, size_t i)
+{
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> one(consts::one<T>);
+
+    Packed<T> x1, y1, z1, w1;
+    x1.loadUnaligned(&q1.x[i]);
+    y1.loadUnaligned(&q1.y[i]);
+    z1.loadUnaligned(&q1.z[i]);
+    w1.loadUnaligned(&q1.w[i]);
+
+    Packed<T> x2, y2, z2, w2;
+    x2.loadUnaligned(&q2.x[i]);
+    y2.loadUnaligned(&q2.y[i]);
+    z2.loadUnaligned(&q2.z[i]);
+    w2.loadUnaligned(&q2.w[i]);
+
+    Packed<T> x = k1 * x1 + k2 * x2;
+    Packed<T> y = k1 * y1 + k2 * y2;
+    Packed<T> z = k1 * z1 + k2 * z2;
+    Packed<T> w = k1 * w1 + k2 * w2;
+
+    Packed<T> norm = internal::squareRoot(x * x + y * y + z * z + w * w);
+    Packed<T> nonzero = internal::greaterThan(norm, zero);
+    Packed<T> inv = internal::select(normalize, one / internal::select(nonzero, norm, one), one);
+    Packed<T> keep = internal::select(normalize, nonzero, internal::greaterThan(one, zero));
+
+    internal::select(keep, x * inv, zero).storeUnaligned(&q.x[i]);
+    internal::select(keep, y * inv, zero).storeUnaligned(&q.y[i]);
+    internal::select(keep, z * inv, zero).storeUnaligned(&q.z[i]);
+    internal::select(keep, w * inv, zero).storeUnaligned(&q.w[i]);
+}
+
+template<typename T>
+auto quaternion_nlerp_block(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2, const T *t,
+                            QuaternionBatch<T> &q,
+                            size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> one(consts::one<T>);
+    const Packed<T> all = internal::greaterThan(one, zero);
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> x1, y1, z1, w1;
+        x1.loadUnaligned(&q1.x[i]);
+        y1.loadUnaligned(&q1.y[i]);
+        z1.loadUnaligned(&q1.z[i]);
+        w1.loadUnaligned(&q1.w[i]);
+
+        Packed<T> x2, y2, z2, w2;
+        x2.loadUnaligned(&q2.x[i]);
+        y2.loadUnaligned(&q2.y[i]);
+        z2.loadUnaligned(&q2.z[i]);
+        w2.loadUnaligned(&q2.w[i]);
+
+        Packed<T> _t;
+        _t.loadUnaligned(&t[i]);
+
+        Packed<T> opposite = internal::lessThan(x1 * x2 + y1 * y2 + z1 * z2 + w1 * w2, zero);
+        Packed<T> k1 = one - _t;
+        Packed<T> k2 = internal::select(opposite, -_t, _t);
+
+        quaternion_combine_packed(q1, q2, k1, k2, all, q, i);
+    }
+
+    quaternion_nlerp_cpp(q1, q2, t, q, max_vector, end);
+}
+
+template<typename T>
+auto quaternion_slerp_block(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2, const T *t,
+                            QuaternionBatch<T> &q,
+                            size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    constexpr size_t chunk = rotation_batch_chunk_size;
+
+    static_assert(chunk % packed_size == 0, "The chunk size must be a multiple of the packed size");
+
+    alignas(32) T cos_theta[chunk];
+    alignas(32) T k1[chunk];
+    alignas(32) T k2[chunk];
+
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> threshold(slerp_linear_threshold<T>);
+
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    for (size_t first = ini; first < max_vector; first += chunk) {
+
+        size_t last = std::min(first + chunk, max_vector);
+
+        for (size_t i = first; i < last; i += packed_size) {
+
+            Packed<T> x1, y1, z1, w1;
+            x1.loadUnaligned(&q1.x[i]);
+            y1.loadUnaligned(&q1.y[i]);
+            z1.loadUnaligned(&q1.z[i]);
+            w1.loadUnaligned(&q1.w[i]);
+
+            Packed<T> x2, y2, z2, w2;
+            x2.loadUnaligned(&q2.x[i]);
+            y2.loadUnaligned(&q2.y[i]);
+            z2.loadUnaligned(&q2.z[i]);
+            w2.loadUnaligned(&q2.w[i]);
+
+            (x1 * x2 + y1 * y2 + z1 * z2 + w1 * w2).storeAligned(&cos_theta[i - first]);
+        }
+
+        /// Interpolation weights
+
+        for (size_t i = first; i < last; i++) {
+
+            size_t k = i - first;
+            T c = cos_theta[k];
+            bool opposite = c < consts::zero<T>;
+            if (opposite) c = -c;
+
+            T _k1;
+            T _k2;
+            if (c > slerp_linear_threshold<T>) {
+                _k1 = consts::one<T> - t[i];
+                _k2 = t[i];
+            } else {
+                T theta = std::acos(c);
+                T inv_sin_theta = consts::one<T> / std::sin(theta);
+                _k1 = std::sin((consts::one<T> - t[i]) * theta) * inv_sin_theta;
+                _k2 = std::sin(t[i] * theta) * inv_sin_theta;
+            }
+
+            k1[k] = _k1;
+            k2[k] = opposite ? -_k2 : _k2;
+            cos_theta[k] = c;
+        }
+
+        for (size_t i = first; i < last; i += packed_size) {
+
+            size_t k = i - first;
+
+            Packed<T> _k1, _k2, c;
+            _k1.loadAligned(&k1[k]);
+            _k2.loadAligned(&k2[k]);
+            c.loadAligned(&cos_theta[k]);
+
+            quaternion_combine_packed(q1, q2, _k1, _k2, internal::greaterThan(c, threshold), q, i);
+        }
+    }
+
+    quaternion_slerp_cpp(q1, q2, t, q, max_vector, end);
+}
+
+template<typename T>
+auto quaternion_to_rotation_matrix_block(const QuaternionBatch<T> &q, RotationMatrixBatch<T> &r,
+                                         size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    const Packed<T> one(consts::one<T>);
+    const Packed<T> two(consts::two<T>);
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> x, y, z, w;
+        x.loadUnaligned(&q.x[i]);
+        y.loadUnaligned(&q.y[i]);
+        z.loadUnaligned(&q.z[i]);
+        w.loadUnaligned(&q.w[i]);
+
+        Packed<T> _2x = two * x;
+        Packed<T> _2y = two * y;
+        Packed<T> _2z = two * z;
+        Packed<T> _2xx = _2x * x;
+        Packed<T> _2xy = _2x * y;
+        Packed<T> _2xz = _2x * z;
+        Packed<T> _2xw = _2x * w;
+        Packed<T> _2yy = _2y * y;
+        Packed<T> _2yz = _2y * z;
+        Packed<T> _2yw = _2y * w;
+        Packed<T> _2zz = _2z * z;
+        Packed<T> _2zw = _2z * w;
+
+        (one - _2yy - _2zz).storeUnaligned(&r.r00[i]);
+        (_2xy - _2zw).storeUnaligned(&r.r01[i]);
+        (_2xz + _2yw).storeUnaligned(&r.r02[i]);
+        (_2xy + _2zw).storeUnaligned(&r.r10[i]);
+        (one - _2xx - _2zz).storeUnaligned(&r.r11[i]);
+        (_2yz - _2xw).storeUnaligned(&r.r12[i]);
+        (_2xz - _2yw).storeUnaligned(&r.r20[i]);
+        (_2yz + _2xw).storeUnaligned(&r.r21[i]);
+        (one - _2xx - _2yy).storeUnaligned(&r.r22[i]);
+    }
+
+    quaternion_to_rotation_matrix_cpp(q, r, max_vector, end);
+}
+
+/*!
+ * The four branches of rotation_matrix_to_quaternion are evaluated with
+ * selects: the largest component comes from the diagonal and the other
+ * three from the off-diagonal sums and differences.
+ */
+template<typename T>
+auto rotation_matrix_to_quaternion_block(const RotationMatrixBatch<T> &r, QuaternionBatch<T> &q,
+                                         size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> one(consts::one<T>);
+    const Packed<T> four(static_cast<T>(4));
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> r00, r01, r02, r10, r11, r12, r20, r21, r22;
+        r00.loadUnaligned(&r.r00[i]);
+        r01.loadUnaligned(&r.r01[i]);
+        r02.loadUnaligned(&r.r02[i]);
+        r10.loadUnaligned(&r.r10[i]);
+        r11.loadUnaligned(&r.r11[i]);
+        r12.loadUnaligned(&r.r12[i]);
+        r20.loadUnaligned(&r.r20[i]);
+        r21.loadUnaligned(&r.r21[i]);
+        r22.loadUnaligned(&r.r22[i]);
+
+        Packed<T> r11_r00_diff = r11 - r00;
+        Packed<T> r11_r00_sum = r11 + r00;
+
+        /// x or y is the largest component when r22 <= 0, z or w otherwise
+        Packed<T> xy = internal::lessThanOrEqualTo(r22, zero);
+        Packed<T> x_largest = internal::lessThanOrEqualTo(r11_r00_diff, zero);
+        Packed<T> z_largest = internal::lessThanOrEqualTo(r11_r00_sum, zero);
+
+        Packed<T> c = internal::select(xy,
+                                       internal::select(x_largest, one - r22 - r11_r00_diff, one - r22 + r11_r00_diff),
+                                       internal::select(z_largest, one + r22 - r11_r00_sum, one + r22 + r11_r00_sum));
+        Packed<T> largest = internal::squareRoot(c / four);
+        Packed<T> largest4 = largest * four;
+
+        Packed<T> s01 = (r01 + r10) / largest4;
+        Packed<T> s02 = (r02 + r20) / largest4;
+        Packed<T> s12 = (r12 + r21) / largest4;
+        Packed<T> d21 = (r21 - r12) / largest4;
+        Packed<T> d02 = (r02 - r20) / largest4;
+        Packed<T> d10 = (r10 - r01) / largest4;
+
+        internal::select(xy, internal::select(x_largest, largest, s01),
+                             internal::select(z_largest, s02, d21)).storeUnaligned(&q.x[i]);
+        internal::select(xy, internal::select(x_largest, s01, largest),
+                             internal::select(z_largest, s12, d02)).storeUnaligned(&q.y[i]);
+        internal::select(xy, internal::select(x_largest, s02, s12),
+                             internal::select(z_largest, largest, d10)).storeUnaligned(&q.z[i]);
+        internal::select(xy, internal::select(x_largest, d21, d02),
+                             internal::select(z_largest, d10, largest)).storeUnaligned(&q.w[i]);
+    }
+
+    rotation_matrix_to_quaternion_cpp(r, q, max_vector, end);
+}
+
+template<typename T>
+auto quaternion_to_axis_angle_block(const QuaternionBatch<T> &q, AxisAngleBatch<T> &a,
+                                    size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> one(consts::one<T>);
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> x, y, z;
+        x.loadUnaligned(&q.x[i]);
+        y.loadUnaligned(&q.y[i]);
+        z.loadUnaligned(&q.z[i]);
+
+        Packed<T> n = internal::squareRoot(x * x + y * y + z * z);
+        Packed<T> mask = internal::greaterThan(n, zero);
+        n = internal::select(mask, n, one);
+
+        internal::select(mask, x / n, one).storeUnaligned(&a.x[i]);
+        internal::select(mask, y / n, zero).storeUnaligned(&a.y[i]);
+        internal::select(mask, z / n, zero).storeUnaligned(&a.z[i]);
+        mask.storeUnaligned(&a.angle[i]);
+    }
+
+    /// The angle is computed lane by lane. The mask bits stored in angle are
+    /// not a number, so the comparison below is false for the null rotations.
+    for (size_t i = ini; i < max_vector; i++) {
+        a.angle[i] = std::isnan(a.angle[i]) ?
+            consts::two<T> * std::acos(clamp(q.w[i], -consts::one<T>, consts::one<T>)) :
+            consts::zero<T>;
+    }
+
+    quaternion_to_axis_angle_cpp(q, a, max_vector, end);
+}
+
+template<typename T>
+auto axis_angle_to_quaternion_block(const AxisAngleBatch<T> &a, QuaternionBatch<T> &q,
+                                    size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    /// sin(angle / 2) is stored in x and scaled by the axis afterwards
+    for (size_t i = ini; i < max_vector; i++) {
+        T a_2 = a.angle[i] * consts::one_half<T>;
+        q.x[i] = std::sin(a_2);
+        q.w[i] = std::cos(a_2);
+    }
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> sin_a_2, x, y, z;
+        sin_a_2.loadUnaligned(&q.x[i]);
+        x.loadUnaligned(&a.x[i]);
+        y.loadUnaligned(&a.y[i]);
+        z.loadUnaligned(&a.z[i]);
+
+        (sin_a_2 * x).storeUnaligned(&q.x[i]);
+        (sin_a_2 * y).storeUnaligned(&q.y[i]);
+        (sin_a_2 * z).storeUnaligned(&q.z[i]);
+    }
+
+    axis_angle_to_quaternion_cpp(a, q, max_vector, end);
+}
+
+template<typename T>
+auto axis_angle_to_rotation_matrix_block(const AxisAngleBatch<T> &a, RotationMatrixBatch<T> &r,
+                                         size_t ini, size_t end) -> std::enable_if_t<is_simd_rotation_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    const Packed<T> one(consts::one<T>);
+
+    /// cos and sin of the angle are stored in r00 and r01 until the matrix is assembled
+    for (size_t i = ini; i < max_vector; i++) {
+        r.r00[i] = std::cos(a.angle[i]);
+        r.r01[i] = std::sin(a.angle[i]);
+    }
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        Packed<T> ca, sa, x, y, z;
+        ca.loadUnaligned(&r.r00[i]);
+        sa.loadUnaligned(&r.r01[i]);
+        x.loadUnaligned(&a.x[i]);
+        y.loadUnaligned(&a.y[i]);
+        z.loadUnaligned(&a.z[i]);
+
+        Packed<T> _1mca = one - ca;
+        Packed<T> xy1mca = x * y * _1mca;
+        Packed<T> xz1mca = x * z * _1mca;
+        Packed<T> yz1mca = y * z * _1mca;
+        Packed<T> xsa = x * sa;
+        Packed<T> ysa = y * sa;
+        Packed<T> zsa = z * sa;
+
+        (x * x * _1mca + ca).storeUnaligned(&r.r00[i]);
+        (xy1mca - zsa).storeUnaligned(&r.r01[i]);
+        (xz1mca + ysa).storeUnaligned(&r.r02[i]);
+        (xy1mca + zsa).storeUnaligned(&r.r10[i]);
+        (y * y * _1mca + ca).storeUnaligned(&r.r11[i]);
+        (yz1mca - xsa).storeUnaligned(&r.r12[i]);
+        (xz1mca - ysa).storeUnaligned(&r.r20[i]);
+        (yz1mca + xsa).storeUnaligned(&r.r21[i]);
+        (z * z * _1mca + ca).storeUnaligned(&r.r22[i]);
+    }
+
+    axis_angle_to_rotation_matrix_cpp(a, r, max_vector, end);
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+auto quaternion_normalize_block(QuaternionBatch<T> &q,
+                                size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    quaternion_normalize_cpp(q, ini, end);
+}
+
+template<typename T>
+auto quaternion_multiply_block(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2,
+                               QuaternionBatch<T> &q,
+                               size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    quaternion_multiply_cpp(q1, q2, q, ini, end);
+}
+
+template<typename T>
+auto quaternion_nlerp_block(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2, const T *t,
+                            QuaternionBatch<T> &q,
+                            size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    quaternion_nlerp_cpp(q1, q2, t, q, ini, end);
+}
+
+template<typename T>
+auto quaternion_slerp_block(const QuaternionBatch<T> &q1, const QuaternionBatch<T> &q2, const T *t,
+                            QuaternionBatch<T> &q,
+                            size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    quaternion_slerp_cpp(q1, q2, t, q, ini, end);
+}
+
+template<typename T>
+auto quaternion_to_rotation_matrix_block(const QuaternionBatch<T> &q, RotationMatrixBatch<T> &r,
+                                         size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    quaternion_to_rotation_matrix_cpp(q, r, ini, end);
+}
+
+template<typename T>
+auto rotation_matrix_to_quaternion_block(const RotationMatrixBatch<T> &r, QuaternionBatch<T> &q,
+                                         size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    rotation_matrix_to_quaternion_cpp(r, q, ini, end);
+}
+
+template<typename T>
+auto quaternion_to_axis_angle_block(const QuaternionBatch<T> &q, AxisAngleBatch<T> &a,
+                                    size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    quaternion_to_axis_angle_cpp(q, a, ini, end);
+}
+
+template<typename T>
+auto axis_angle_to_quaternion_block(const AxisAngleBatch<T> &a, QuaternionBatch<T> &q,
+                                    size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    axis_angle_to_quaternion_cpp(a, q, ini, end);
+}
+
+template<typename T>
+auto axis_angle_to_rotation_matrix_block(const AxisAngleBatch<T> &a, RotationMatrixBatch<T> &r,
+                                         size_t ini, size_t end) -> std::enable_if_t<!is_simd_rotation_type<T>::value, void>
+{
+    axis_angle_to_rotation_matrix_cpp(a, r, ini, end);
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+
+/*!
+ * \brief Hamilton product of two batches of quaternions, q[i] = q1[i] * q2[i]
+ */
+template<typename T>
+void multiply(const QuaternionBatch<T> &q1,
+              const QuaternionBatch<T> &q2,
+              QuaternionBatch<T> &q)
+{
+    TL_ASSERT(q1.size() == q2.size(), "Batches of different size");
+
+    q.resize(q1.size());
+    internal::rotation_batch_run(q1.size(), [&](size_t ini, size_t end) {
+        internal::quaternion_multiply_block(q1, q2, q, ini, end);
+    });
+}
+
+/*!
+ * \brief Normalised linear interpolation of two batches of unit quaternions
+ * q[i] = nlerp(q1[i], q2[i], t[i])
+ */
+template<typename T>
+void nlerp(const QuaternionBatch<T> &q1,
+           const QuaternionBatch<T> &q2,
+           const std::vector<T> &t,
+           QuaternionBatch<T> &q)
+{
+    TL_ASSERT(q1.size() == q2.size() && q1.size() == t.size(), "Batches of different size");
+
+    q.resize(q1.size());
+    internal::rotation_batch_run(q1.size(), [&](size_t ini, size_t end) {
+        internal::quaternion_nlerp_block(q1, q2, t.data(), q, ini, end);
+    });
+}
+
+/*!
+ * \brief Spherical linear interpolation of two batches of unit quaternions
+ * q[i] = slerp(q1[i], q2[i], t[i])
+ *
+ * <h4>Example</h4>
+ * \code
+ * // Attitude at the camera timestamps from the two closest IMU samples
+ * QuaternionBatch<double> attitude;
+ * slerp(imu_before, imu_after, t, attitude);
+ * \endcode
+ */
+template<typename T>
+void slerp(const QuaternionBatch<T> &q1,
+           const QuaternionBatch<T> &q2,
+           const std::vector<T> &t,
+           QuaternionBatch<T> &q)
+{
+    TL_ASSERT(q1.size() == q2.size() && q1.size() == t.size(), "Batches of different size");
+
+    q.resize(q1.size());
+    internal::rotation_batch_run(q1.size(), [&](size_t ini, size_t end) {
+        internal::quaternion_slerp_block(q1, q2, t.data(), q, ini, end);
+    });
+}
+
+
+
+/* QuaternionBatch implementation */
+
+template<typename T>
+QuaternionBatch<T>::QuaternionBatch(size_t size)
+  : x(size),
+    y(size),
+    z(size),
+    w(size)
+{
+}
+
+template<typename T>
+auto QuaternionBatch<T>::size() const -> size_t
+{
+    return x.size();
+}
+
+template<typename T>
+void QuaternionBatch<T>::resize(size_t size)
+{
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    w.resize(size);
+}
+
+template<typename T>
+void QuaternionBatch<T>::push_back(const Quaternion<T> &quaternion)
+{
+    x.push_back(quaternion.x);
+    y.push_back(quaternion.y);
+    z.push_back(quaternion.z);
+    w.push_back(quaternion.w);
+}
+
+template<typename T>
+auto QuaternionBatch<T>::at(size_t index) const -> Quaternion<T>
+{
+    return Quaternion<T>(x[index], y[index], z[index], w[index]);
+}
+
+template<typename T>
+void QuaternionBatch<T>::set(size_t index, const Quaternion<T> &quaternion)
+{
+    x[index] = quaternion.x;
+    y[index] = quaternion.y;
+    z[index] = quaternion.z;
+    w[index] = quaternion.w;
+}
+
+template<typename T>
+void QuaternionBatch<T>::normalize()
+{
+    internal::rotation_batch_run(size(), [&](size_t ini, size_t end) {
+        internal::quaternion_normalize_block(*this, ini, end);
+    });
+}
+
+
+
+/* RotationMatrixBatch implementation */
+
+template<typename T>
+RotationMatrixBatch<T>::RotationMatrixBatch(size_t size)
+  : r00(size), r01(size), r02(size),
+    r10(size), r11(size), r12(size),
+    r20(size), r21(size), r22(size)
+{
+}
+
+template<typename T>
+auto RotationMatrixBatch<T>::size() const -> size_t
+{
+    return r00.size();
+}
+
+template<typename T>
+void RotationMatrixBatch<T>::resize(size_t size)
+{
+    for (auto *element : {&r00, &r01, &r02, &r10, &r11, &r12, &r20, &r21, &r22})
+        element->resize(size);
+}
+
+template<typename T>
+void RotationMatrixBatch<T>::push_back(const RotationMatrix<T> &rotationMatrix)
+{
+    resize(size() + 1);
+    set(size() - 1, rotationMatrix);
+}
+
+template<typename T>
+auto RotationMatrixBatch<T>::at(size_t index) const -> RotationMatrix<T>
+{
+    RotationMatrix<T> rotationMatrix;
+    rotationMatrix(0, 0) = r00[index];
+    rotationMatrix(0, 1) = r01[index];
+    rotationMatrix(0, 2) = r02[index];
+    rotationMatrix(1, 0) = r10[index];
+    rotationMatrix(1, 1) = r11[index];
+    rotationMatrix(1, 2) = r12[index];
+    rotationMatrix(2, 0) = r20[index];
+    rotationMatrix(2, 1) = r21[index];
+    rotationMatrix(2, 2) = r22[index];
+    return rotationMatrix;
+}
+
+template<typename T>
+void RotationMatrixBatch<T>::set(size_t index, const RotationMatrix<T> &rotationMatrix)
+{
+    r00[index] = rotationMatrix(0, 0);
+    r01[index] = rotationMatrix(0, 1);
+    r02[index] = rotationMatrix(0, 2);
+    r10[index] = rotationMatrix(1, 0);
+    r11[index] = rotationMatrix(1, 1);
+    r12[index] = rotationMatrix(1, 2);
+    r20[index] = rotationMatrix(2, 0);
+    r21[index] = rotationMatrix(2, 1);
+    r22[index] = rotationMatrix(2, 2);
+}
+
+
+
+/* AxisAngleBatch implementation */
+
+template<typename T>
+AxisAngleBatch<T>::AxisAngleBatch(size_t size)
+  : angle(size),
+    x(size),
+    y(size),
+    z(size)
+{
+}
+
+template<typename T>
+auto AxisAngleBatch<T>::size() const -> size_t
+{
+    return angle.size();
+}
+
+template<typename T>
+void AxisAngleBatch<T>::resize(size_t size)
+{
+    angle.resize(size);
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+}
+
+template<typename T>
+void AxisAngleBatch<T>::push_back(const AxisAngle<T> &axisAngle)
+{
+    angle.push_back(axisAngle.angle());
+    x.push_back(axisAngle.axis(0));
+    y.push_back(axisAngle.axis(1));
+    z.push_back(axisAngle.axis(2));
+}
+
+template<typename T>
+auto AxisAngleBatch<T>::at(size_t index) const -> AxisAngle<T>
+{
+    return AxisAngle<T>(angle[index], {x[index], y[index], z[index]});
+}
+
+template<typename T>
+void AxisAngleBatch<T>::set(size_t index, const AxisAngle<T> &axisAngle)
+{
+    angle[index] = axisAngle.angle();
+    x[index] = axisAngle.axis(0);
+    y[index] = axisAngle.axis(1);
+    z[index] = axisAngle.axis(2);
+}
+
+
+
+/* EulerAnglesBatch implementation */
+
+template<typename T>
+EulerAnglesBatch<T>::EulerAnglesBatch(size_t size, Axes axes)
+  : x(size),
+    y(size),
+    z(size),
+    axes(axes)
+{
+}
+
+template<typename T>
+auto EulerAnglesBatch<T>::size() const -> size_t
+{
+    return x.size();
+}
+
+template<typename T>
+void EulerAnglesBatch<T>::resize(size_t size)
+{
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+}
+
+template<typename T>
+void EulerAnglesBatch<T>::push_back(const EulerAngles<T> &eulerAngles)
+{
+    x.push_back(static_cast<T>(eulerAngles.x));
+    y.push_back(static_cast<T>(eulerAngles.y));
+    z.push_back(static_cast<T>(eulerAngles.z));
+}
+
+template<typename T>
+auto EulerAnglesBatch<T>::at(size_t index) const -> EulerAngles<T>
+{
+    EulerAngles<T> eulerAngles(x[index], y[index], z[index]);
+    eulerAngles.axes = axes;
+    return eulerAngles;
+}
+
+template<typename T>
+void EulerAnglesBatch<T>::set(size_t index, const EulerAngles<T> &eulerAngles)
+{
+    x[index] = static_cast<T>(eulerAngles.x);
+    y[index] = static_cast<T>(eulerAngles.y);
+    z[index] = static_cast<T>(eulerAngles.z);
+}
+
+
+
+/* RotationBatchConverter implementation */
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const QuaternionBatch<T> &quaternions,
+                                        RotationMatrixBatch<T> &rotationMatrices)
+{
+    rotationMatrices.resize(quaternions.size());
+    internal::rotation_batch_run(quaternions.size(), [&](size_t ini, size_t end) {
+        internal::quaternion_to_rotation_matrix_block(quaternions, rotationMatrices, ini, end);
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const RotationMatrixBatch<T> &rotationMatrices,
+                                        QuaternionBatch<T> &quaternions)
+{
+    quaternions.resize(rotationMatrices.size());
+    internal::rotation_batch_run(rotationMatrices.size(), [&](size_t ini, size_t end) {
+        internal::rotation_matrix_to_quaternion_block(rotationMatrices, quaternions, ini, end);
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const QuaternionBatch<T> &quaternions,
+                                        AxisAngleBatch<T> &axisAngles)
+{
+    axisAngles.resize(quaternions.size());
+    internal::rotation_batch_run(quaternions.size(), [&](size_t ini, size_t end) {
+        internal::quaternion_to_axis_angle_block(quaternions, axisAngles, ini, end);
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const AxisAngleBatch<T> &axisAngles,
+                                        QuaternionBatch<T> &quaternions)
+{
+    quaternions.resize(axisAngles.size());
+    internal::rotation_batch_run(axisAngles.size(), [&](size_t ini, size_t end) {
+        internal::axis_angle_to_quaternion_block(axisAngles, quaternions, ini, end);
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const AxisAngleBatch<T> &axisAngles,
+                                        RotationMatrixBatch<T> &rotationMatrices)
+{
+    rotationMatrices.resize(axisAngles.size());
+    internal::rotation_batch_run(axisAngles.size(), [&](size_t ini, size_t end) {
+        internal::axis_angle_to_rotation_matrix_block(axisAngles, rotationMatrices, ini, end);
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const RotationMatrixBatch<T> &rotationMatrices,
+                                        AxisAngleBatch<T> &axisAngles)
+{
+    QuaternionBatch<T> quaternions;
+    convert(rotationMatrices, quaternions);
+    convert(quaternions, axisAngles);
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const RotationMatrixBatch<T> &rotationMatrices,
+                                        EulerAnglesBatch<T> &eulerAngles)
+{
+    eulerAngles.resize(rotationMatrices.size());
+    internal::rotation_batch_run(rotationMatrices.size(), [&](size_t ini, size_t end) {
+        EulerAngles<T> euler_angles;
+        euler_angles.axes = eulerAngles.axes;
+        for (size_t i = ini; i < end; i++) {
+            RotationConverter<T>::convert(rotationMatrices.at(i), euler_angles);
+            eulerAngles.set(i, euler_angles);
+        }
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const EulerAnglesBatch<T> &eulerAngles,
+                                        RotationMatrixBatch<T> &rotationMatrices)
+{
+    rotationMatrices.resize(eulerAngles.size());
+    internal::rotation_batch_run(eulerAngles.size(), [&](size_t ini, size_t end) {
+        RotationMatrix<T> rotation_matrix;
+        for (size_t i = ini; i < end; i++) {
+            RotationConverter<T>::convert(eulerAngles.at(i), rotation_matrix);
+            rotationMatrices.set(i, rotation_matrix);
+        }
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const QuaternionBatch<T> &quaternions,
+                                        EulerAnglesBatch<T> &eulerAngles)
+{
+    RotationMatrixBatch<T> rotationMatrices;
+    convert(quaternions, rotationMatrices);
+    convert(rotationMatrices, eulerAngles);
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const EulerAnglesBatch<T> &eulerAngles,
+                                        QuaternionBatch<T> &quaternions)
+{
+    quaternions.resize(eulerAngles.size());
+    internal::rotation_batch_run(eulerAngles.size(), [&](size_t ini, size_t end) {
+        Quaternion<T> quaternion;
+        for (size_t i = ini; i < end; i++) {
+            RotationConverter<T>::convert(eulerAngles.at(i), quaternion);
+            quaternions.set(i, quaternion);
+        }
+    });
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const AxisAngleBatch<T> &axisAngles,
+                                        EulerAnglesBatch<T> &eulerAngles)
+{
+    RotationMatrixBatch<T> rotationMatrices;
+    convert(axisAngles, rotationMatrices);
+    convert(rotationMatrices, eulerAngles);
+}
+
+template<typename T>
+void RotationBatchConverter<T>::convert(const EulerAnglesBatch<T> &eulerAngles,
+                                        AxisAngleBatch<T> &axisAngles)
+{
+    QuaternionBatch<T> quaternions;
+    convert(eulerAngles, quaternions);
+    convert(quaternions, axisAngles);
+}
+
+
+/*! \} */ // end of rotations
+
+/*! \} */ // end of algebra
+
+/*! \} */ // end of math
+
+} // End namespace tl
@@ -45,6 +45,94 @@ namespace tl
  *  \{
  */
 
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * Unrolled quaternion <-> rotation matrix kernels. The matrix is a row-major
+ * array of 9 elements and the quaternion is stored as x, y, z, w.
+ */
+
+template<typename T>
+constexpr void quaternion_to_rotation_matrix(const T *q, T *r)
+{
+    T _2x = consts::two<T> * q[0];
+    T _2y = consts::two<T> * q[1];
+    T _2z = consts::two<T> * q[2];
+    T _2xx = _2x * q[0];
+    T _2xy = _2x * q[1];
+    T _2xz = _2x * q[2];
+    T _2xw = _2x * q[3];
+    T _2yy = _2y * q[1];
+    T _2yz = _2y * q[2];
+    T _2yw = _2y * q[3];
+    T _2zz = _2z * q[2];
+    T _2zw = _2z * q[3];
+
+    r[0] = consts::one<T> - _2yy - _2zz;
+    r[1] = _2xy - _2zw;
+    r[2] = _2xz + _2yw;
+    r[3] = _2xy + _2zw;
+    r[4] = consts::one<T> - _2xx - _2zz;
+    r[5] = _2yz - _2xw;
+    r[6] = _2xz - _2yw;
+    r[7] = _2yz + _2xw;
+    r[8] = consts::one<T> - _2xx - _2yy;
+}
+
+/*!
+ * The largest of |x|, |y|, |z| and |w| is taken from the diagonal and the
+ * other three components from the off-diagonal sums and differences.
+ */
+template<typename T>
+inline void rotation_matrix_to_quaternion(const T *r, T *q)
+{
+    const T four{4};
+
+    if (r[8] <= consts::zero<T>) {
+
+        T r11_r00 = r[4] - r[0];
+        if (r11_r00 <= consts::zero<T>) {
+            q[0] = sqrt((consts::one<T> - r[8] - r11_r00) / four);
+            T qx4 = q[0] * four;
+            q[1] = (r[1] + r[3]) / qx4;
+            q[2] = (r[2] + r[6]) / qx4;
+            q[3] = (r[7] - r[5]) / qx4;
+        } else {
+            q[1] = sqrt((consts::one<T> - r[8] + r11_r00) / four);
+            T qy4 = q[1] * four;
+            q[0] = (r[1] + r[3]) / qy4;
+            q[2] = (r[5] + r[7]) / qy4;
+            q[3] = (r[2] - r[6]) / qy4;
+        }
+
+    } else {
+
+        T r11_r00 = r[4] + r[0];
+        if (r11_r00 <= consts::zero<T>) {
+            q[2] = sqrt((consts::one<T> + r[8] - r11_r00) / four);
+            T qz4 = q[2] * four;
+            q[0] = (r[2] + r[6]) / qz4;
+            q[1] = (r[5] + r[7]) / qz4;
+            q[3] = (r[3] - r[1]) / qz4;
+        } else {
+            q[3] = sqrt((consts::one<T> + r[8] + r11_r00) / four);
+            T qw4 = q[3] * four;
+            q[0] = (r[7] - r[5]) / qw4;
+            q[1] = (r[2] - r[6]) / qw4;
+            q[2] = (r[3] - r[1]) / qw4;
+        }
+
+    }
+}
+
+} // namespace internal
+
+/// \endcond
+
+
 /*!
  * \brief Clase para convertir entre diferentes sistemas de rotación
  */
@@ -316,72 +404,21 @@ template<typename T, int... P>
 void RotationConverter<T, P...>::convert(const RotationMatrix<T> &rotationMatrix,
                                          Quaternion<T> &quaternion)
 {
-    const T four{4};
-
-    T r22 = rotationMatrix[2][2];
-    if (r22 <= consts::zero<T>) {
+    T q[4]{};
+    internal::rotation_matrix_to_quaternion(rotationMatrix.data(), q);
 
-        T r11_r00 = rotationMatrix[1][1] - rotationMatrix[0][0];
-        if (r11_r00 <= consts::zero<T>) {
-            quaternion.x = sqrt((consts::one<T> -r22 - r11_r00) / four);
-            T qx4 = quaternion.x * four;
-            quaternion.y = (rotationMatrix[0][1] + rotationMatrix[1][0]) / qx4;
-            quaternion.z = (rotationMatrix[0][2] + rotationMatrix[2][0]) / qx4;
-            quaternion.w = (rotationMatrix[2][1] - rotationMatrix[1][2]) / qx4;
-        } else {
-            quaternion.y = sqrt((consts::one<T>  -r22 + r11_r00) / four);
-            T qy4 = quaternion.y * four;
-            quaternion.x = (rotationMatrix[0][1] + rotationMatrix[1][0]) / qy4;
-            quaternion.z = (rotationMatrix[1][2] + rotationMatrix[2][1]) / qy4;
-            quaternion.w = (rotationMatrix[0][2] - rotationMatrix[2][0]) / qy4;
-        }
-
-    } else {
-
-        T r11_r00 = rotationMatrix[1][1] + rotationMatrix[0][0];
-        if (r11_r00 <= consts::zero<T>) {
-            quaternion.z = sqrt((consts::one<T>  +r22 - r11_r00) / four);
-            T qz4 = quaternion.z * four;
-            quaternion.x = (rotationMatrix[0][2] + rotationMatrix[2][0]) / qz4;
-            quaternion.y = (rotationMatrix[1][2] + rotationMatrix[2][1]) / qz4;
-            quaternion.w = (rotationMatrix[1][0] - rotationMatrix[0][1]) / qz4;
-        } else {
-            quaternion.w = sqrt((consts::one<T>  +r22 + r11_r00) / four);
-            T qw4 = quaternion.w * four;
-            quaternion.x = (rotationMatrix[2][1] - rotationMatrix[1][2]) / qw4;
-            quaternion.y = (rotationMatrix[0][2] - rotationMatrix[2][0]) / qw4;
-            quaternion.z = (rotationMatrix[1][0] - rotationMatrix[0][1]) / qw4;
-        }
-
-    }
+    quaternion.x = q[0];
+    quaternion.y = q[1];
+    quaternion.z = q[2];
+    quaternion.w = q[3];
 }
 
 template<typename T, int... P>
 void RotationConverter<T, P...>::convert(const Quaternion<T> &quaternion,
                                          RotationMatrix<T> &rotationMatrix)
 {
-    T _2x = consts::two<T> *quaternion.x;
-    T _2y = consts::two<T> *quaternion.y;
-    T _2z = consts::two<T> *quaternion.z;
-    T _2xx = _2x * quaternion.x;
-    T _2xy = _2x * quaternion.y;
-    T _2xz = _2x * quaternion.z;
-    T _2xw = _2x * quaternion.w;
-    T _2yy = _2y * quaternion.y;
-    T _2yz = _2y * quaternion.z;
-    T _2yw = _2y * quaternion.w;
-    T _2zz = _2z * quaternion.z;
-    T _2zw = _2z * quaternion.w;
-
-    rotationMatrix[0][0] = consts::one<T> -_2yy - _2zz;
-    rotationMatrix[0][1] = _2xy - _2zw;
-    rotationMatrix[0][2] = _2xz + _2yw;
-    rotationMatrix[1][0] = _2xy + _2zw;
-    rotationMatrix[1][1] = consts::one<T> -_2xx - _2zz;
-    rotationMatrix[1][2] = _2yz - _2xw;
-    rotationMatrix[2][0] = _2xz - _2yw;
-    rotationMatrix[2][1] = _2yz + _2xw;
-    rotationMatrix[2][2] = consts::one<T> -_2xx - _2yy;
+    const T q[4] = {quaternion.x, quaternion.y, quaternion.z, quaternion.w};
+    internal::quaternion_to_rotation_matrix(q, rotationMatrix.data());
 }
 
 template<typename T, int... P>
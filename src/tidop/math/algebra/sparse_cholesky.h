@@ -0,0 +1,515 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "tidop/core/exception.h"
+#include "tidop/math/math.h"
+#include "tidop/math/algebra/vector.h"
+#include "tidop/math/algebra/sparse_matrix.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Algebra
+ *
+ * Algebra
+ *
+ *  \{
+ */
+
+/*!
+ * \brief Fill-reducing ordering for the sparse Cholesky decomposition
+ */
+enum class SparseOrdering
+{
+    natural, /*!< No reordering */
+    amd      /*!< Approximate minimum degree */
+};
+
+
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * \brief Approximate minimum degree ordering
+ *
+ * Quotient graph minimum degree with element absorption and the approximate
+ * external degree of Amestoy, Davis and Duff. Supervariable detection and
+ * mass elimination are not implemented.
+ *
+ * \param[in] matrix Square matrix with symmetric pattern
+ * \return Permutation. perm[k] is the original index of the k-th pivot
+ */
+template<typename T>
+auto approximate_minimum_degree(const SparseMatrixCSR<T> &matrix) -> std::vector<size_t>
+{
+    size_t n = matrix.rows();
+
+    const auto &outer = matrix.outerIndex();
+    const auto &inner = matrix.innerIndex();
+
+    std::vector<std::vector<size_t>> variables(n);
+    std::vector<std::vector<size_t>> elements(n);
+    std::vector<std::vector<size_t>> element_variables(n);
+    std::vector<bool> eliminated(n, false);
+    std::vector<bool> absorbed(n, false);
+    std::vector<size_t> degree(n);
+    std::vector<size_t> mark(n, 0);
+    std::vector<std::ptrdiff_t> w(n, -1);
+    size_t stamp = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t p = outer[i]; p < outer[i + 1]; p++) {
+            size_t j = inner[p];
+            if (j != i) {
+                variables[i].push_back(j);
+                variables[j].push_back(i);
+            }
+        }
+    }
+
+    std::set<std::pair<size_t, size_t>> queue;
+
+    for (size_t i = 0; i < n; i++) {
+        auto &adj = variables[i];
+        std::sort(adj.begin(), adj.end());
+        adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+        degree[i] = adj.size();
+        queue.emplace(degree[i], i);
+    }
+
+    std::vector<size_t> permutation;
+    permutation.reserve(n);
+
+    std::vector<size_t> lp;
+    std::vector<size_t> visited;
+
+    for (size_t k = 0; k < n; k++) {
+
+        size_t pivot = queue.begin()->second;
+        queue.erase(queue.begin());
+        permutation.push_back(pivot);
+
+        /// New element Lp = (A_p U (U L_e)) \ {p}
+
+        stamp++;
+        lp.clear();
+        eliminated[pivot] = true;
+        mark[pivot] = stamp;
+
+        for (size_t j : variables[pivot]) {
+            if (!eliminated[j] && mark[j] != stamp) {
+                mark[j] = stamp;
+                lp.push_back(j);
+            }
+        }
+
+        for (size_t e : elements[pivot]) {
+            if (absorbed[e]) continue;
+            for (size_t j : element_variables[e]) {
+                if (!eliminated[j] && mark[j] != stamp) {
+                    mark[j] = stamp;
+                    lp.push_back(j);
+                }
+            }
+            absorbed[e] = true;
+            std::vector<size_t>().swap(element_variables[e]);
+        }
+
+        std::vector<size_t>().swap(variables[pivot]);
+        std::vector<size_t>().swap(elements[pivot]);
+        element_variables[pivot] = lp;
+
+        /// Prune the variables of Lp and compute w(e) = |Le \ Lp|
+
+        visited.clear();
+
+        for (size_t i : lp) {
+
+            auto &adj = variables[i];
+            adj.erase(std::remove_if(adj.begin(), adj.end(), [&](size_t j) {
+                return eliminated[j] || mark[j] == stamp;
+            }), adj.end());
+
+            auto &elem = elements[i];
+            elem.erase(std::remove_if(elem.begin(), elem.end(), [&](size_t e) {
+                return absorbed[e];
+            }), elem.end());
+
+            for (size_t e : elem) {
+                if (w[e] < 0) {
+                    auto &le = element_variables[e];
+                    le.erase(std::remove_if(le.begin(), le.end(), [&](size_t j) {
+                        return eliminated[j];
+                    }), le.end());
+                    w[e] = static_cast<std::ptrdiff_t>(le.size());
+                    visited.push_back(e);
+                }
+                w[e]--;
+            }
+
+            elem.push_back(pivot);
+        }
+
+        /// Aggressive absorption of the elements contained in Lp
+
+        for (size_t e : visited) {
+            if (w[e] == 0) {
+                absorbed[e] = true;
+                std::vector<size_t>().swap(element_variables[e]);
+            }
+        }
+
+        /// Approximate external degree
+
+        size_t lp_size = lp.size();
+        size_t remaining = n - k - 1;
+
+        for (size_t i : lp) {
+
+            auto &elem = elements[i];
+            elem.erase(std::remove_if(elem.begin(), elem.end(), [&](size_t e) {
+                return absorbed[e];
+            }), elem.end());
+
+            size_t d = variables[i].size() + lp_size - 1;
+            for (size_t e : elem) {
+                if (e != pivot)
+                    d += static_cast<size_t>(w[e]);
+            }
+
+            d = std::min(d, degree[i] + lp_size - 1);
+            d = std::min(d, remaining > 0 ? remaining - 1 : 0);
+
+            queue.erase(std::make_pair(degree[i], i));
+            degree[i] = d;
+            queue.emplace(d, i);
+        }
+
+        for (size_t e : visited)
+            w[e] = -1;
+    }
+
+    return permutation;
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Sparse Cholesky decomposition
+ *
+ * Simplicial LDL' decomposition of a symmetric positive definite sparse matrix
+ * P * A * P' = L * D * L'. The matrix must be stored with both triangles, like
+ * the matrix returned by normalMatrix().
+ *
+ * The decomposition is split into a symbolic analysis, which only depends on
+ * the sparsity pattern, and a numeric factorization. When a sequence of
+ * matrices with the same pattern is solved (as in Gauss-Newton or
+ * Levenberg-Marquardt iterations) analyze() is called once and factorize()
+ * for every matrix.
+ *
+ * T. A. Davis, "Algorithm 849: A concise sparse Cholesky factorization package",
+ * ACM Trans. Math. Softw. 31, 4 (December 2005), 587-591, doi: 10.1145/1114268.1114277.
+ *
+ * \code
+ * SparseCholeskyDecomposition<double> cholesky;
+ * cholesky.analyze(A);
+ * cholesky.factorize(A);
+ * Vector<double> x = cholesky.solve(b);
+ * \endcode
+ */
+template<typename T>
+class SparseCholeskyDecomposition
+{
+
+public:
+
+    explicit SparseCholeskyDecomposition(SparseOrdering ordering = SparseOrdering::amd);
+    explicit SparseCholeskyDecomposition(const SparseMatrixCSR<T> &matrix,
+                                         SparseOrdering ordering = SparseOrdering::amd);
+
+    /*!
+     * \brief Fill-reducing ordering and elimination tree of the matrix pattern
+     */
+    void analyze(const SparseMatrixCSR<T> &matrix);
+
+    /*!
+     * \brief Numeric factorization
+     * The matrix must have the pattern of the analyzed matrix
+     * \throw Exception if the matrix is not positive definite
+     */
+    void factorize(const SparseMatrixCSR<T> &matrix);
+
+    /*!
+     * \brief analyze and factorize
+     */
+    void compute(const SparseMatrixCSR<T> &matrix);
+
+    auto solve(const Vector<T> &b) const -> Vector<T>;
+
+    auto permutation() const -> const std::vector<size_t> &;
+
+    /*!
+     * \brief Non zeros of the strictly lower triangular factor L
+     */
+    auto nonZerosL() const -> size_t;
+
+private:
+
+    SparseOrdering mOrdering;
+    size_t mSize;
+    std::vector<size_t> mPermutation;
+    std::vector<size_t> mInversePermutation;
+    std::vector<size_t> mParent;
+    std::vector<size_t> mColumnCount;
+    std::vector<size_t> mColumnPointer;
+    std::vector<size_t> mRowIndex;
+    std::vector<T> mL;
+    std::vector<T> mD;
+    bool mAnalyzed;
+    bool mFactorized;
+
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+};
+
+
+template<typename T>
+constexpr size_t SparseCholeskyDecomposition<T>::none;
+
+template<typename T>
+SparseCholeskyDecomposition<T>::SparseCholeskyDecomposition(SparseOrdering ordering)
+  : mOrdering(ordering),
+    mSize(0),
+    mAnalyzed(false),
+    mFactorized(false)
+{
+    static_assert(std::is_floating_point<T>::value, "Integral type not supported");
+}
+
+template<typename T>
+SparseCholeskyDecomposition<T>::SparseCholeskyDecomposition(const SparseMatrixCSR<T> &matrix,
+                                                            SparseOrdering ordering)
+  : SparseCholeskyDecomposition(ordering)
+{
+    compute(matrix);
+}
+
+template<typename T>
+void SparseCholeskyDecomposition<T>::analyze(const SparseMatrixCSR<T> &matrix)
+{
+    TL_ASSERT(matrix.rows() == matrix.cols(), "Non-Square Matrix");
+
+    mSize = matrix.rows();
+    size_t n = mSize;
+
+    if (mOrdering == SparseOrdering::amd) {
+        mPermutation = internal::approximate_minimum_degree(matrix);
+    } else {
+        mPermutation.resize(n);
+        for (size_t i = 0; i < n; i++)
+            mPermutation[i] = i;
+    }
+
+    mInversePermutation.resize(n);
+    for (size_t k = 0; k < n; k++)
+        mInversePermutation[mPermutation[k]] = k;
+
+    const auto &outer = matrix.outerIndex();
+    const auto &inner = matrix.innerIndex();
+
+    /// Elimination tree and column counts of L
+
+    mParent.assign(n, none);
+    mColumnCount.assign(n, 0);
+    std::vector<size_t> flag(n);
+
+    for (size_t k = 0; k < n; k++) {
+        flag[k] = k;
+        size_t row = mPermutation[k];
+        for (size_t p = outer[row]; p < outer[row + 1]; p++) {
+            size_t i = mInversePermutation[inner[p]];
+            if (i >= k) continue;
+            for (; flag[i] != k; i = mParent[i]) {
+                if (mParent[i] == none) mParent[i] = k;
+                mColumnCount[i]++;
+                flag[i] = k;
+            }
+        }
+    }
+
+    mColumnPointer.assign(n + 1, 0);
+    for (size_t k = 0; k < n; k++)
+        mColumnPointer[k + 1] = mColumnPointer[k] + mColumnCount[k];
+
+    mRowIndex.resize(mColumnPointer[n]);
+    mL.resize(mColumnPointer[n]);
+    mD.resize(n);
+
+    mAnalyzed = true;
+    mFactorized = false;
+}
+
+template<typename T>
+void SparseCholeskyDecomposition<T>::factorize(const SparseMatrixCSR<T> &matrix)
+{
+    TL_ASSERT(mAnalyzed, "The matrix has not been analyzed");
+    TL_ASSERT(matrix.rows() == mSize && matrix.cols() == mSize, "Matrix size does not match the analyzed matrix");
+
+    size_t n = mSize;
+
+    const auto &outer = matrix.outerIndex();
+    const auto &inner = matrix.innerIndex();
+    const auto &values = matrix.values();
+
+    std::vector<T> y(n, consts::zero<T>);
+    std::vector<size_t> pattern(n);
+    std::vector<size_t> flag(n);
+    std::vector<size_t> count(n, 0);
+
+    mFactorized = false;
+
+    /// Up-looking LDL': row k of L is computed from a sparse triangular solve
+
+    for (size_t k = 0; k < n; k++) {
+
+        size_t top = n;
+        flag[k] = k;
+        size_t row = mPermutation[k];
+
+        for (size_t p = outer[row]; p < outer[row + 1]; p++) {
+            size_t i = mInversePermutation[inner[p]];
+            if (i > k) continue;
+            y[i] += values[p];
+            size_t len = 0;
+            for (; flag[i] != k; i = mParent[i]) {
+                pattern[len++] = i;
+                flag[i] = k;
+            }
+            while (len > 0) pattern[--top] = pattern[--len];
+        }
+
+        T d = y[k];
+        y[k] = consts::zero<T>;
+
+        for (; top < n; top++) {
+            size_t i = pattern[top];
+            T yi = y[i];
+            y[i] = consts::zero<T>;
+            size_t p2 = mColumnPointer[i] + count[i];
+            for (size_t p = mColumnPointer[i]; p < p2; p++)
+                y[mRowIndex[p]] -= mL[p] * yi;
+            T l_ki = yi / mD[i];
+            d -= l_ki * yi;
+            mRowIndex[p2] = k;
+            mL[p2] = l_ki;
+            count[i]++;
+        }
+
+        if (d <= consts::zero<T>)
+            TL_THROW_EXCEPTION("Matrix is not positive definite");
+
+        mD[k] = d;
+    }
+
+    mFactorized = true;
+}
+
+template<typename T>
+void SparseCholeskyDecomposition<T>::compute(const SparseMatrixCSR<T> &matrix)
+{
+    analyze(matrix);
+    factorize(matrix);
+}
+
+template<typename T>
+auto SparseCholeskyDecomposition<T>::solve(const Vector<T> &b) const -> Vector<T>
+{
+    TL_ASSERT(mFactorized, "The matrix has not been factorized");
+    TL_ASSERT(b.size() == mSize, "Matrix rows != Vector size");
+
+    size_t n = mSize;
+    std::vector<T> x(n);
+
+    for (size_t k = 0; k < n; k++)
+        x[k] = b[mPermutation[k]];
+
+    for (size_t j = 0; j < n; j++) {
+        T xj = x[j];
+        for (size_t p = mColumnPointer[j]; p < mColumnPointer[j + 1]; p++)
+            x[mRowIndex[p]] -= mL[p] * xj;
+    }
+
+    for (size_t j = 0; j < n; j++)
+        x[j] /= mD[j];
+
+    for (size_t j = n; j-- > 0;) {
+        T xj = x[j];
+        for (size_t p = mColumnPointer[j]; p < mColumnPointer[j + 1]; p++)
+            xj -= mL[p] * x[mRowIndex[p]];
+        x[j] = xj;
+    }
+
+    Vector<T> solution(n);
+    for (size_t k = 0; k < n; k++)
+        solution[mPermutation[k]] = x[k];
+
+    return solution;
+}
+
+template<typename T>
+auto SparseCholeskyDecomposition<T>::permutation() const -> const std::vector<size_t> &
+{
+    return mPermutation;
+}
+
+template<typename T>
+auto SparseCholeskyDecomposition<T>::nonZerosL() const -> size_t
+{
+    return mColumnPointer.empty() ? 0 : mColumnPointer.back();
+}
+
+
+/*! \} */ // end of Algebra
+
+/*! \} */ // end of Math
+
+} // End namespace tl
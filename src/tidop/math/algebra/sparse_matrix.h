@@ -0,0 +1,635 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/math.h"
+#include "tidop/math/algebra/vector.h"
+#include "tidop/math/algebra/matrix.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Algebra
+ *
+ * Algebra
+ *
+ *  \{
+ */
+
+
+/*!
+ * \brief Entry (row, column, value) used to assemble a sparse matrix
+ */
+template<typename T>
+struct Triplet
+{
+    size_t row;
+    size_t col;
+    T value;
+
+    Triplet() = default;
+    Triplet(size_t row, size_t col, T value)
+      : row(row), col(col), value(value)
+    {
+    }
+};
+
+
+/*!
+ * \brief Storage order of a sparse matrix
+ */
+enum class SparseStorage
+{
+    row,   ///< Compressed sparse row (CSR)
+    column ///< Compressed sparse column (CSC)
+};
+
+
+/// \cond
+
+namespace internal
+{
+
+/// Minimum number of non-zero entries to run the matrix-vector product in parallel
+constexpr size_t sparse_parallel_threshold = 100000;
+/// Rows (or columns) processed by each task of the parallel matrix-vector product
+constexpr size_t sparse_block_size = 4096;
+
+template<SparseStorage Storage>
+struct SparseStorageTraits;
+
+template<>
+struct SparseStorageTraits<SparseStorage::row>
+{
+    static constexpr SparseStorage transposed = SparseStorage::column;
+};
+
+template<>
+struct SparseStorageTraits<SparseStorage::column>
+{
+    static constexpr SparseStorage transposed = SparseStorage::row;
+};
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Sparse matrix in compressed storage (CSR or CSC)
+ *
+ * The matrix is stored in three arrays. For row storage (CSR), outerIndex
+ * holds the position in innerIndex and values where each row starts. innerIndex
+ * holds the column of each entry and values holds its value. Column storage
+ * (CSC) swaps the role of rows and columns.
+ *
+ * The inner indices of each row (column) are sorted and have no duplicates.
+ *
+ * \code
+ * std::vector<Triplet<double>> triplets;
+ * triplets.emplace_back(0, 0, 4.);
+ * triplets.emplace_back(0, 1, -1.);
+ * triplets.emplace_back(1, 0, -1.);
+ * triplets.emplace_back(1, 1, 4.);
+ * SparseMatrix<double> A(2, 2, triplets);
+ * Vector<double> y = A * x;
+ * \endcode
+ */
+template<typename T, SparseStorage Storage = SparseStorage::row>
+class SparseMatrix
+{
+
+public:
+
+    using value_type = T;
+    using size_type = size_t;
+
+    static constexpr SparseStorage storage = Storage;
+
+public:
+
+    SparseMatrix();
+    SparseMatrix(size_t rows, size_t cols);
+
+    /*!
+     * \brief Assembly from a list of triplets. Duplicated entries are summed
+     */
+    SparseMatrix(size_t rows, size_t cols, const std::vector<Triplet<T>> &triplets);
+
+    /*!
+     * \brief Constructor from the compressed arrays
+     * \param[in] rows Number of rows
+     * \param[in] cols Number of columns
+     * \param[in] outerIndex Start of each row (column) in innerIndex. Size outerSize() + 1
+     * \param[in] innerIndex Column (row) index of each entry
+     * \param[in] values Value of each entry
+     */
+    SparseMatrix(size_t rows, size_t cols,
+                 std::vector<size_t> outerIndex,
+                 std::vector<size_t> innerIndex,
+                 std::vector<T> values);
+
+    /*!
+     * \brief Conversion between storage orders
+     */
+    template<SparseStorage Storage2>
+    explicit SparseMatrix(const SparseMatrix<T, Storage2> &matrix);
+
+    SparseMatrix(const SparseMatrix &matrix) = default;
+    SparseMatrix(SparseMatrix &&matrix) TL_NOEXCEPT = default;
+    ~SparseMatrix() = default;
+
+    auto operator=(const SparseMatrix &matrix) -> SparseMatrix & = default;
+    auto operator=(SparseMatrix &&matrix) TL_NOEXCEPT -> SparseMatrix & = default;
+
+    void setFromTriplets(const std::vector<Triplet<T>> &triplets);
+
+    auto rows() const -> size_t;
+    auto cols() const -> size_t;
+    auto nonZeros() const -> size_t;
+
+    /*!
+     * \brief Number of rows (CSR) or columns (CSC)
+     */
+    auto outerSize() const -> size_t;
+
+    auto outerIndex() const -> const std::vector<size_t> &;
+    auto innerIndex() const -> const std::vector<size_t> &;
+    auto values() const -> const std::vector<T> &;
+    auto values() -> std::vector<T> &;
+
+    /*!
+     * \brief Value of an entry. Zero for entries not stored
+     */
+    auto at(size_t row, size_t col) const -> T;
+    auto operator()(size_t row, size_t col) const -> T;
+
+    auto diagonal() const -> Vector<T>;
+    auto transpose() const -> SparseMatrix;
+    auto toDense() const -> Matrix<T>;
+
+    /*!
+     * \brief y = A * x
+     * Rows are processed in parallel for large CSR matrices
+     */
+    void multiply(const T *x, T *y) const;
+
+    /*!
+     * \brief y = A' * x
+     * Columns are processed in parallel for large CSC matrices
+     */
+    void transposeMultiply(const T *x, T *y) const;
+
+private:
+
+    /// y[outer] = sum(values * x[inner])
+    void gather(const T *x, T *y) const;
+    /// y[inner] += values * x[outer]
+    void scatter(const T *x, T *y) const;
+
+private:
+
+    size_t mRows;
+    size_t mCols;
+    std::vector<size_t> mOuterIndex;
+    std::vector<size_t> mInnerIndex;
+    std::vector<T> mValues;
+};
+
+template<typename T>
+using SparseMatrixCSR = SparseMatrix<T, SparseStorage::row>;
+
+template<typename T>
+using SparseMatrixCSC = SparseMatrix<T, SparseStorage::column>;
+
+
+
+/* SparseMatrix implementation */
+
+template<typename T, SparseStorage Storage>
+SparseMatrix<T, Storage>::SparseMatrix()
+  : mRows(0),
+    mCols(0),
+    mOuterIndex(1, 0)
+{
+}
+
+template<typename T, SparseStorage Storage>
+SparseMatrix<T, Storage>::SparseMatrix(size_t rows, size_t cols)
+  : mRows(rows),
+    mCols(cols),
+    mOuterIndex(outerSize() + 1, 0)
+{
+}
+
+template<typename T, SparseStorage Storage>
+SparseMatrix<T, Storage>::SparseMatrix(size_t rows, size_t cols, const std::vector<Triplet<T>> &triplets)
+  : mRows(rows),
+    mCols(cols)
+{
+    setFromTriplets(triplets);
+}
+
+template<typename T, SparseStorage Storage>
+SparseMatrix<T, Storage>::SparseMatrix(size_t rows, size_t cols,
+                                       std::vector<size_t> outerIndex,
+                                       std::vector<size_t> innerIndex,
+                                       std::vector<T> values)
+  : mRows(rows),
+    mCols(cols),
+    mOuterIndex(std::move(outerIndex)),
+    mInnerIndex(std::move(innerIndex)),
+    mValues(std::move(values))
+{
+    TL_ASSERT(mOuterIndex.size() == outerSize() + 1, "Invalid outer index size");
+    TL_ASSERT(mInnerIndex.size() == mValues.size(), "Different inner index and values sizes");
+    TL_ASSERT(mOuterIndex.back() == mValues.size(), "Invalid outer index");
+}
+
+template<typename T, SparseStorage Storage>
+template<SparseStorage Storage2>
+SparseMatrix<T, Storage>::SparseMatrix(const SparseMatrix<T, Storage2> &matrix)
+  : mRows(matrix.rows()),
+    mCols(matrix.cols())
+{
+    if (Storage == Storage2) {
+        mOuterIndex = matrix.outerIndex();
+        mInnerIndex = matrix.innerIndex();
+        mValues = matrix.values();
+        return;
+    }
+
+    /// The inner index of the source is the outer index of the new matrix.
+    /// Walking the source in order leaves the new inner indices sorted.
+    size_t outer_size = outerSize();
+    size_t non_zeros = matrix.nonZeros();
+
+    mOuterIndex.assign(outer_size + 1, 0);
+    mInnerIndex.resize(non_zeros);
+    mValues.resize(non_zeros);
+
+    const auto &src_outer = matrix.outerIndex();
+    const auto &src_inner = matrix.innerIndex();
+    const auto &src_values = matrix.values();
+
+    for (size_t i = 0; i < non_zeros; i++)
+        mOuterIndex[src_inner[i] + 1]++;
+
+    std::partial_sum(mOuterIndex.begin(), mOuterIndex.end(), mOuterIndex.begin());
+
+    std::vector<size_t> position(mOuterIndex.begin(), mOuterIndex.end() - 1);
+
+    for (size_t outer = 0; outer < matrix.outerSize(); outer++) {
+        for (size_t i = src_outer[outer]; i < src_outer[outer + 1]; i++) {
+            size_t dst = position[src_inner[i]]++;
+            mInnerIndex[dst] = outer;
+            mValues[dst] = src_values[i];
+        }
+    }
+}
+
+template<typename T, SparseStorage Storage>
+void SparseMatrix<T, Storage>::setFromTriplets(const std::vector<Triplet<T>> &triplets)
+{
+    bool row_storage = Storage == SparseStorage::row;
+    size_t outer_size = outerSize();
+
+    std::vector<size_t> count(outer_size + 1, 0);
+    for (const auto &triplet : triplets) {
+        TL_ASSERT(triplet.row < mRows && triplet.col < mCols, "Triplet ({}, {}) out of range", triplet.row, triplet.col);
+        count[(row_storage ? triplet.row : triplet.col) + 1]++;
+    }
+
+    std::partial_sum(count.begin(), count.end(), count.begin());
+
+    std::vector<std::pair<size_t, T>> entries(triplets.size());
+    std::vector<size_t> position(count.begin(), count.end() - 1);
+    for (const auto &triplet : triplets) {
+        size_t outer = row_storage ? triplet.row : triplet.col;
+        size_t inner = row_storage ? triplet.col : triplet.row;
+        entries[position[outer]++] = std::make_pair(inner, triplet.value);
+    }
+
+    mOuterIndex.assign(outer_size + 1, 0);
+    mInnerIndex.clear();
+    mValues.clear();
+    mInnerIndex.reserve(entries.size());
+    mValues.reserve(entries.size());
+
+    for (size_t outer = 0; outer < outer_size; outer++) {
+
+        auto first = entries.begin() + static_cast<std::ptrdiff_t>(count[outer]);
+        auto last = entries.begin() + static_cast<std::ptrdiff_t>(count[outer + 1]);
+        std::sort(first, last, [](const std::pair<size_t, T> &a, const std::pair<size_t, T> &b) {
+            return a.first < b.first;
+        });
+
+        for (auto it = first; it != last; it++) {
+            if (mInnerIndex.size() > mOuterIndex[outer] && mInnerIndex.back() == it->first) {
+                mValues.back() += it->second;
+            } else {
+                mInnerIndex.push_back(it->first);
+                mValues.push_back(it->second);
+            }
+        }
+
+        mOuterIndex[outer + 1] = mInnerIndex.size();
+    }
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::rows() const -> size_t
+{
+    return mRows;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::cols() const -> size_t
+{
+    return mCols;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::nonZeros() const -> size_t
+{
+    return mValues.size();
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::outerSize() const -> size_t
+{
+    return Storage == SparseStorage::row ? mRows : mCols;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::outerIndex() const -> const std::vector<size_t> &
+{
+    return mOuterIndex;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::innerIndex() const -> const std::vector<size_t> &
+{
+    return mInnerIndex;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::values() const -> const std::vector<T> &
+{
+    return mValues;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::values() -> std::vector<T> &
+{
+    return mValues;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::at(size_t row, size_t col) const -> T
+{
+    TL_ASSERT(row < mRows && col < mCols, "Index ({}, {}) out of range", row, col);
+
+    size_t outer = Storage == SparseStorage::row ? row : col;
+    size_t inner = Storage == SparseStorage::row ? col : row;
+
+    auto first = mInnerIndex.begin() + static_cast<std::ptrdiff_t>(mOuterIndex[outer]);
+    auto last = mInnerIndex.begin() + static_cast<std::ptrdiff_t>(mOuterIndex[outer + 1]);
+    auto it = std::lower_bound(first, last, inner);
+
+    if (it != last && *it == inner)
+        return mValues[static_cast<size_t>(it - mInnerIndex.begin())];
+
+    return consts::zero<T>;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::operator()(size_t row, size_t col) const -> T
+{
+    return at(row, col);
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::diagonal() const -> Vector<T>
+{
+    size_t size = std::min(mRows, mCols);
+    Vector<T> diagonal(size, consts::zero<T>);
+
+    for (size_t outer = 0; outer < size; outer++) {
+        for (size_t i = mOuterIndex[outer]; i < mOuterIndex[outer + 1]; i++) {
+            if (mInnerIndex[i] == outer) {
+                diagonal[outer] = mValues[i];
+                break;
+            }
+        }
+    }
+
+    return diagonal;
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::transpose() const -> SparseMatrix
+{
+    /// The arrays of A in one storage order are the arrays of A' in the other one
+    SparseMatrix<T, internal::SparseStorageTraits<Storage>::transposed> transposed(mCols, mRows,
+                                                                                 mOuterIndex,
+                                                                                 mInnerIndex,
+                                                                                 mValues);
+    return SparseMatrix(transposed);
+}
+
+template<typename T, SparseStorage Storage>
+auto SparseMatrix<T, Storage>::toDense() const -> Matrix<T>
+{
+    Matrix<T> matrix(mRows, mCols, consts::zero<T>);
+
+    for (size_t outer = 0; outer < outerSize(); outer++) {
+        for (size_t i = mOuterIndex[outer]; i < mOuterIndex[outer + 1]; i++) {
+            if (Storage == SparseStorage::row)
+                matrix(outer, mInnerIndex[i]) = mValues[i];
+            else
+                matrix(mInnerIndex[i], outer) = mValues[i];
+        }
+    }
+
+    return matrix;
+}
+
+template<typename T, SparseStorage Storage>
+void SparseMatrix<T, Storage>::multiply(const T *x, T *y) const
+{
+    if (Storage == SparseStorage::row) {
+        gather(x, y);
+    } else {
+        std::fill(y, y + mRows, consts::zero<T>);
+        scatter(x, y);
+    }
+}
+
+template<typename T, SparseStorage Storage>
+void SparseMatrix<T, Storage>::transposeMultiply(const T *x, T *y) const
+{
+    if (Storage == SparseStorage::column) {
+        gather(x, y);
+    } else {
+        std::fill(y, y + mCols, consts::zero<T>);
+        scatter(x, y);
+    }
+}
+
+template<typename T, SparseStorage Storage>
+void SparseMatrix<T, Storage>::gather(const T *x, T *y) const
+{
+    size_t outer_size = outerSize();
+
+    auto block = [&](size_t ini, size_t end) {
+        for (size_t outer = ini; outer < end; outer++) {
+            T sum = consts::zero<T>;
+            for (size_t i = mOuterIndex[outer]; i < mOuterIndex[outer + 1]; i++) {
+                sum += mValues[i] * x[mInnerIndex[i]];
+            }
+            y[outer] = sum;
+        }
+    };
+
+    if (nonZeros() < internal::sparse_parallel_threshold) {
+        block(0, outer_size);
+        return;
+    }
+
+    size_t blocks = (outer_size + internal::sparse_block_size - 1) / internal::sparse_block_size;
+    parallel_for(0, blocks, [&](size_t b) {
+        size_t ini = b * internal::sparse_block_size;
+        block(ini, std::min(ini + internal::sparse_block_size, outer_size));
+    });
+}
+
+template<typename T, SparseStorage Storage>
+void SparseMatrix<T, Storage>::scatter(const T *x, T *y) const
+{
+    for (size_t outer = 0; outer < outerSize(); outer++) {
+        T value = x[outer];
+        if (value == consts::zero<T>) continue;
+        for (size_t i = mOuterIndex[outer]; i < mOuterIndex[outer + 1]; i++) {
+            y[mInnerIndex[i]] += mValues[i] * value;
+        }
+    }
+}
+
+
+/* Operations */
+
+template<typename T, SparseStorage Storage>
+auto operator*(const SparseMatrix<T, Storage> &matrix,
+               const Vector<T> &vector) -> Vector<T>
+{
+    TL_ASSERT(matrix.cols() == vector.size(), "Matrix columns != Vector size");
+
+    Vector<T> result(matrix.rows(), consts::zero<T>);
+    matrix.multiply(vector.data(), result.data());
+
+    return result;
+}
+
+/*!
+ * \brief Normal matrix A' * A
+ *
+ * The product is built row by row with a dense accumulator (Gustavson's algorithm).
+ * This is the matrix of the normal equations of the least squares problem A * x = b.
+ */
+template<typename T, SparseStorage Storage>
+auto normalMatrix(const SparseMatrix<T, Storage> &matrix) -> SparseMatrixCSR<T>
+{
+    SparseMatrixCSR<T> csr(matrix);
+    SparseMatrixCSC<T> csc(matrix);
+
+    size_t n = matrix.cols();
+
+    const auto &row_outer = csr.outerIndex();
+    const auto &row_inner = csr.innerIndex();
+    const auto &row_values = csr.values();
+    const auto &col_outer = csc.outerIndex();
+    const auto &col_inner = csc.innerIndex();
+    const auto &col_values = csc.values();
+
+    std::vector<size_t> outer_index(n + 1, 0);
+    std::vector<size_t> inner_index;
+    std::vector<T> values;
+
+    std::vector<T> accumulator(n, consts::zero<T>);
+    std::vector<size_t> marker(n, n);
+    std::vector<size_t> pattern;
+
+    for (size_t j = 0; j < n; j++) {
+
+        pattern.clear();
+
+        /// Row j of A'A = sum of A(i, j) * (row i of A) over the entries of column j
+        for (size_t p = col_outer[j]; p < col_outer[j + 1]; p++) {
+            size_t i = col_inner[p];
+            T a_ij = col_values[p];
+            for (size_t q = row_outer[i]; q < row_outer[i + 1]; q++) {
+                size_t k = row_inner[q];
+                if (marker[k] != j) {
+                    marker[k] = j;
+                    accumulator[k] = consts::zero<T>;
+                    pattern.push_back(k);
+                }
+                accumulator[k] += a_ij * row_values[q];
+            }
+        }
+
+        std::sort(pattern.begin(), pattern.end());
+        for (size_t k : pattern) {
+            inner_index.push_back(k);
+            values.push_back(accumulator[k]);
+        }
+
+        outer_index[j + 1] = inner_index.size();
+    }
+
+    return SparseMatrixCSR<T>(n, n, std::move(outer_index), std::move(inner_index), std::move(values));
+}
+
+
+/*! \} */ // end of Algebra
+
+/*! \} */ // end of Math
+
+} // End namespace tl
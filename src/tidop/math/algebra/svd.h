@@ -26,9 +26,13 @@
 
 
 #include <algorithm>
+#include <numeric>
+#include <vector>
 
+#include "tidop/core/concurrency/parallel.h"
 #include "tidop/math/algebra/matrix.h"
 #include "tidop/math/algebra/vector.h"
+#include "tidop/math/algebra/dense_kernels.h"
 #include "tidop/math/lapack.h"
 
 namespace tl
@@ -60,10 +64,42 @@ namespace tl
  *
  * http://www.ehu.eus/izaballa/Cursos/valores_singulares.pdf
  * https://www.researchgate.net/publication/263583897_La_descomposicion_en_valores_singulares_SVD_y_algunas_de_sus_aplicaciones
+ *
+ * Sin LAPACK se usa el método de Jacobi de una cara (Hestenes): las columnas
+ * de A se ortogonalizan mediante rotaciones de pares de columnas hasta que
+ * son ortogonales entre sí. Los valores singulares son las normas de las
+ * columnas, V acumula las rotaciones y U son las columnas normalizadas.
+ * Cuando A tiene al menos tantas filas como columnas se aplica antes una
+ * factorización QR y las rotaciones se hacen sobre R (n x n), que converge
+ * en menos barridos. maxIterations() es el número máximo de barridos. Cada barrido recorre los pares
+ * en orden round-robin, de forma que los pares de una misma ronda son
+ * independientes y se rotan en paralelo en matrices grandes.
+ *
+ * El método de Jacobi se usa con matrices pequeñas o con muchas más filas que
+ * columnas. En el resto de casos es más rápido el método de Golub-Reinsch:
+ * bidiagonalización de Householder seguida de la iteración QR implícita con
+ * desplazamiento. En este caso maxIterations() es el número máximo de
+ * iteraciones por valor singular.
+ *
+ * J. Demmel, K. Veselić, "Jacobi's method is more accurate than QR",
+ * SIAM J. Matrix Anal. Appl. 13(4), 1992.
+ *
+ * G. H. Golub, C. Reinsch, "Singular value decomposition and least squares
+ * solutions", Numer. Math. 14, 1970.
  */
 template<typename T>
 class SingularValueDecomposition;
 
+/*!
+ * \brief Factores calculados por la SVD
+ */
+enum class SvdMode
+{
+    thin,            ///< W, V y U reducida (m x n). No se calcula nunca la U completa (m x m)
+    no_u,            ///< W y V. Suficiente para los sistemas homogéneos (núcleo de A)
+    singular_values  ///< Sólo W
+};
+
 template<
     template<typename, size_t, size_t>
     class Matrix_t, typename T, size_t Rows, size_t Cols>
@@ -72,7 +108,8 @@ class SingularValueDecomposition<Matrix_t<T, Rows, Cols>>
 
 public:
 
-    SingularValueDecomposition(const Matrix_t<T, Rows, Cols> &a);
+    SingularValueDecomposition(const Matrix_t<T, Rows, Cols> &a,
+                               SvdMode mode = SvdMode::thin);
 
     auto solve(const Vector<T, Rows>& b) -> Vector<T, Cols>;
 
@@ -86,7 +123,9 @@ public:
 private:
 
     void decompose();
-    void reorder();
+    void jacobiDecompose();
+    void golubReinschDecompose();
+    void signConvention();
 #ifdef TL_HAVE_OPENBLAS
     void lapackDecompose();
 #endif // TL_HAVE_OPENBLAS
@@ -101,6 +140,7 @@ private:
     T eps;
     size_t mRows;
     size_t mCols;
+    SvdMode mMode;
 };
 
 
@@ -108,24 +148,29 @@ template<
     template<typename, size_t, size_t>
 class Matrix_t, typename T, size_t Rows, size_t Cols
 >
-SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::SingularValueDecomposition(const Matrix_t<T, Rows, Cols> &a)
+SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::SingularValueDecomposition(const Matrix_t<T, Rows, Cols> &a,
+                                                                                  SvdMode mode)
     : A(a),
     mIterationMax(30),
     eps(std::numeric_limits<T>::epsilon()),
     mRows(a.rows()),
-    mCols(a.cols())
+    mCols(a.cols()),
+    mMode(mode)
 {
     static_assert(std::is_floating_point<T>::value, "Integral type not supported");
 
-    U = Matrix<T, Rows, Cols>(mRows, mCols);
-    V = Matrix<T, Cols, Cols>(mCols, mCols);
     W = Vector<T, Cols>(mCols);
 
+    if (mMode == SvdMode::thin)
+        U = Matrix<T, Rows, Cols>(mRows, mCols);
+
+    if (mMode != SvdMode::singular_values)
+        V = Matrix<T, Cols, Cols>(mCols, mCols);
+
 #ifdef TL_HAVE_OPENBLAS
     this->lapackDecompose();
 #else
     this->decompose();
-    this->reorder();
 #endif // TL_HAVE_OPENBLAS
 
 }
@@ -137,6 +182,8 @@ class Matrix_t, typename T, size_t Rows, size_t Cols
 >
 auto SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::solve(const Vector<T, Rows>& B) -> Vector<T, Cols>
 {
+    TL_ASSERT(mMode == SvdMode::thin, "SingularValueDecomposition::solve requires U and V");
+
     Vector<T, Cols> C(mCols);
     T tsh = consts::one_half<T> *std::sqrt(mRows + mCols + consts::one<T>) * W[0] * eps;
     T s;
@@ -168,192 +215,437 @@ class Matrix_t, typename T, size_t Rows, size_t Cols
 >
 void SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::decompose()
 {
-    this->U = this->A;
-    Vector<T, Cols> rv1(mCols);
-    int i;
-    int j;
-    int k;
-    int l;
-    T anorm;
-    T f;
-    T g;
-    T h;
-    T s;
-    T scale;
-    g = scale = anorm = consts::zero<T>; //Householder reduction to bidiagonal form.
+    if (mRows >= internal::svd_jacobi_aspect_ratio * mCols ||
+        std::min(mRows, mCols) < internal::svd_golub_reinsch_threshold) {
+        jacobiDecompose();
+    } else {
+        golubReinschDecompose();
+    }
+
+    signConvention();
+}
+
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+void SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::jacobiDecompose()
+{
+    bool compute_u = mMode == SvdMode::thin;
+    bool compute_v = mMode != SvdMode::singular_values;
+
+    size_t n = mCols;
+    bool precondition = mRows >= mCols;
+    size_t length = precondition ? mCols : mRows;
+
+    /// Columns of A (rows of G) are stored contiguously
+    std::vector<T> g(n * length, consts::zero<T>);
+
+    /// Householder vectors of the QR preconditioning, needed to recover U
+    std::vector<T> reflectors;
+    std::vector<T> betas;
+
+    if (precondition) {
+
+        size_t m = mRows;
+        std::vector<T> at(n * m);
+
+        for (size_t r = 0; r < m; r++) {
+            for (size_t c = 0; c < n; c++) {
+                at[c * m + r] = A(r, c);
+            }
+        }
+
+        if (compute_u) {
+            reflectors.resize(n * m);
+            betas.resize(n);
+        }
+
+        std::vector<T> v(m);
 
-    //int one = 1;
+        for (size_t k = 0; k < n; k++) {
+
+            T *a_k = &at[k * m + k];
+            size_t size = m - k;
+
+            T norm = std::sqrt(internal::dot(size, a_k, a_k));
+            T alpha = a_k[0] > consts::zero<T> ? -norm : norm;
+
+            std::copy(a_k, a_k + size, v.begin());
+            v[0] -= alpha;
+            T v_norm2 = internal::dot(size, v.data(), v.data());
+            T beta = v_norm2 > consts::zero<T> ? static_cast<T>(2) / v_norm2 : consts::zero<T>;
+
+            for (size_t j = k + 1; j < n; j++) {
+                T *a_j = &at[j * m + k];
+                T f = beta * internal::dot(size, v.data(), a_j);
+                internal::axpy(size, -f, v.data(), a_j);
+            }
 
-    for (i = 0; i < static_cast<int>(mCols); i++) {
-        l = i + 2;
+            a_k[0] = alpha;
+
+            if (compute_u) {
+                std::copy(v.begin(), v.begin() + size, &reflectors[k * m + k]);
+                betas[k] = beta;
+            }
+        }
+
+        /// Column j of R
+        for (size_t j = 0; j < n; j++) {
+            std::copy(&at[j * m], &at[j * m] + j + 1, &g[j * n]);
+        }
+
+    } else {
+
+        for (size_t r = 0; r < mRows; r++) {
+            for (size_t c = 0; c < n; c++) {
+                g[c * length + r] = A(r, c);
+            }
+        }
+    }
+
+    /// Rows of V'
+    std::vector<T> vt;
+    if (compute_v) {
+        vt.assign(n * n, consts::zero<T>);
+        for (size_t i = 0; i < n; i++) {
+            vt[i * n + i] = consts::one<T>;
+        }
+    }
+
+    T tolerance = std::sqrt(static_cast<T>(length)) * eps;
+    bool parallel = n * length >= internal::svd_jacobi_parallel_threshold;
+
+    /// Round-robin ordering. An odd number of columns is completed with a dummy column.
+    size_t players = n + n % 2;
+    std::vector<size_t> order(players);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<char> rotated(players / 2);
+
+    /// Squared column norms. They are updated after each rotation and recomputed every sweep.
+    std::vector<T> norms(n);
+
+    auto rotate_pair = [&](size_t pair) -> bool {
+
+        size_t p = order[pair];
+        size_t q = order[players - 1 - pair];
+        if (p >= n || q >= n) return false;
+
+        T *g_p = &g[p * length];
+        T *g_q = &g[q * length];
+
+        T alpha = norms[p];
+        T beta = norms[q];
+        T gamma = internal::dot(length, g_p, g_q);
+
+        if (alpha == consts::zero<T> || beta == consts::zero<T> ||
+            std::abs(gamma) <= tolerance * std::sqrt(alpha) * std::sqrt(beta)) return false;
+
+        T zeta = (beta - alpha) / (static_cast<T>(2) * gamma);
+        T t = std::copysign(consts::one<T>, zeta) / (std::abs(zeta) + std::sqrt(consts::one<T> + zeta * zeta));
+        T c = consts::one<T> / std::sqrt(consts::one<T> + t * t);
+        T s = c * t;
+
+        internal::rot(length, g_p, g_q, c, -s);
+        if (compute_v) internal::rot(n, &vt[p * n], &vt[q * n], c, -s);
+
+        norms[p] = alpha - t * gamma;
+        norms[q] = beta + t * gamma;
+
+        return true;
+    };
+
+    for (int sweep = 0; sweep < mIterationMax; sweep++) {
+
+        bool converged = true;
+
+        for (size_t i = 0; i < n; i++) {
+            norms[i] = internal::dot(length, &g[i * length], &g[i * length]);
+        }
+
+        for (size_t round = 0; round + 1 < players; round++) {
+
+            if (parallel) {
+                parallel_for(0, players / 2, [&](size_t pair) {
+                    rotated[pair] = rotate_pair(pair);
+                });
+                for (char r : rotated)
+                    if (r) converged = false;
+            } else {
+                for (size_t pair = 0; pair < players / 2; pair++) {
+                    if (rotate_pair(pair)) converged = false;
+                }
+            }
+
+            std::rotate(order.begin() + 1, order.end() - 1, order.end());
+        }
+
+        if (converged) break;
+    }
+
+    /// Singular values in descending order
+
+    std::vector<T> sigma(n);
+    for (size_t i = 0; i < n; i++) {
+        sigma[i] = std::sqrt(internal::dot(length, &g[i * length], &g[i * length]));
+    }
+
+    std::vector<size_t> index(n);
+    std::iota(index.begin(), index.end(), 0);
+    std::stable_sort(index.begin(), index.end(), [&sigma](size_t i, size_t j) {
+        return sigma[i] > sigma[j];
+    });
+
+    std::vector<T> u(compute_u ? mRows : 0);
+
+    for (size_t c = 0; c < n; c++) {
+
+        size_t i = index[c];
+        W[c] = sigma[i];
+
+        if (compute_v) {
+            for (size_t r = 0; r < n; r++)
+                V(r, c) = vt[i * n + r];
+        }
+
+        if (compute_u) {
+
+            std::fill(u.begin(), u.end(), consts::zero<T>);
+
+            if (sigma[i] > consts::zero<T>) {
+
+                T inv_sigma = consts::one<T> / sigma[i];
+                for (size_t r = 0; r < length; r++)
+                    u[r] = g[i * length + r] * inv_sigma;
+
+                /// U = Q * U_R
+                for (size_t k = precondition ? n : 0; k > 0; k--) {
+                    size_t size = mRows - k + 1;
+                    const T *v = &reflectors[(k - 1) * mRows + k - 1];
+                    T f = betas[k - 1] * internal::dot(size, v, &u[k - 1]);
+                    internal::axpy(size, -f, v, &u[k - 1]);
+                }
+            }
+
+            for (size_t r = 0; r < mRows; r++)
+                U(r, c) = u[r];
+        }
+    }
+
+}
+
+template<
+    template<typename, size_t, size_t>
+class Matrix_t, typename T, size_t Rows, size_t Cols
+>
+void SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::golubReinschDecompose()
+{
+    bool compute_u = mMode == SvdMode::thin;
+    bool compute_v = mMode != SvdMode::singular_values;
+
+    int m = static_cast<int>(mRows);
+    int n = static_cast<int>(mCols);
+
+    /// A by rows. It keeps the Householder vectors and then the left singular vectors
+    std::vector<T> a(mRows * mCols);
+    for (size_t r = 0; r < mRows; r++) {
+        for (size_t c = 0; c < mCols; c++) {
+            a[r * mCols + c] = A(r, c);
+        }
+    }
+
+    std::vector<T> v(compute_v ? mCols * mCols : 0);
+    std::vector<T> w(mCols);
+    std::vector<T> rv1(mCols);
+
+    auto u_ = [&a, n](int r, int c) -> T & { return a[static_cast<size_t>(r * n + c)]; };
+    auto v_ = [&v, n](int r, int c) -> T & { return v[static_cast<size_t>(r * n + c)]; };
+
+    int i, j, k, l = 0;
+    T anorm, f, g, h, s, scale;
+    g = scale = anorm = consts::zero<T>;
+
+    /// Householder reduction to bidiagonal form
+    for (i = 0; i < n; i++) {
+
+        l = i + 1;
         rv1[i] = scale * g;
-        g = s = scale = 0.0;
-
-        if (i < static_cast<int>(mRows)) {
-            for (k = i; k < static_cast<int>(mRows); k++) scale += std::abs(U[k][i]);
-            if (scale != 0.) {
-                for (k = i; k < static_cast<int>(mRows); k++) {
-                    U[k][i] /= scale;
-                    s += U[k][i] * U[k][i];
+        g = s = scale = consts::zero<T>;
+
+        if (i < m) {
+            for (k = i; k < m; k++) scale += std::abs(u_(k, i));
+            if (scale != consts::zero<T>) {
+                for (k = i; k < m; k++) {
+                    u_(k, i) /= scale;
+                    s += u_(k, i) * u_(k, i);
                 }
-                f = U[i][i];
-                g = -std::copysign(sqrt(s), f);
+                f = u_(i, i);
+                g = -std::copysign(std::sqrt(s), f);
                 h = f * g - s;
-                U[i][i] = f - g;
-                for (j = l - consts::one<int>; j < static_cast<int>(mCols); j++) {
-                    for (s = 0.0, k = i; k < static_cast<int>(mRows); k++)
-                        s += U[k][i] * U[k][j];
+                u_(i, i) = f - g;
+                for (j = l; j < n; j++) {
+                    for (s = consts::zero<T>, k = i; k < m; k++) s += u_(k, i) * u_(k, j);
                     f = s / h;
-                    for (k = i; k < mRows; k++)
-                        U[k][j] += f * U[k][i];
+                    for (k = i; k < m; k++) u_(k, j) += f * u_(k, i);
                 }
-                for (k = i; k < mRows; k++)
-                    U[k][i] *= scale;
+                for (k = i; k < m; k++) u_(k, i) *= scale;
             }
         }
 
-        W[i] = scale * g;
-        g = s = scale = 0.0;
-        if (i + consts::one<int> <= mRows && i + consts::one<int> != mCols) {
-            for (k = l - consts::one<int>; k < mCols; k++) scale += fabs(U[i][k]);
-            if (scale != 0.) {
-                for (k = l - consts::one<int>; k < mCols; k++) {
-                    U[i][k] /= scale;
-                    s += U[i][k] * U[i][k];
+        w[i] = scale * g;
+        g = s = scale = consts::zero<T>;
+
+        if (i < m && i + 1 != n) {
+            for (k = l; k < n; k++) scale += std::abs(u_(i, k));
+            if (scale != consts::zero<T>) {
+                for (k = l; k < n; k++) {
+                    u_(i, k) /= scale;
+                    s += u_(i, k) * u_(i, k);
                 }
-                f = U[i][l - consts::one<int>];
-                g = -std::copysign(sqrt(s), f);
+                f = u_(i, l);
+                g = -std::copysign(std::sqrt(s), f);
                 h = f * g - s;
-                U[i][l - consts::one<int>] = f - g;
+                u_(i, l) = f - g;
+                for (k = l; k < n; k++) rv1[k] = u_(i, k) / h;
+                for (j = l; j < m; j++) {
+                    for (s = consts::zero<T>, k = l; k < n; k++) s += u_(j, k) * u_(i, k);
+                    for (k = l; k < n; k++) u_(j, k) += s * rv1[k];
+                }
+                for (k = l; k < n; k++) u_(i, k) *= scale;
+            }
+        }
 
-                for (k = l - consts::one<int>; k < mCols; k++)
-                    rv1[k] = U[i][k] / h;
+        anorm = std::max(anorm, std::abs(w[i]) + std::abs(rv1[i]));
+    }
 
-                for (j = l - consts::one<int>; j < mRows; j++) {
-                    for (s = 0.0, k = l - consts::one<int>; k < mCols; k++)
-                        s += U[j][k] * U[i][k];
-                    for (k = l - consts::one<int>; k < mCols; k++)
-                        U[j][k] += s * rv1[k];
+    /// Accumulation of right-hand transformations
+    if (compute_v) {
+        for (i = n - 1; i >= 0; i--) {
+            if (i < n - 1) {
+                if (g != consts::zero<T>) {
+                    /// Double division to avoid possible underflow
+                    for (j = l; j < n; j++) v_(j, i) = (u_(i, j) / u_(i, l)) / g;
+                    for (j = l; j < n; j++) {
+                        for (s = consts::zero<T>, k = l; k < n; k++) s += u_(i, k) * v_(k, j);
+                        for (k = l; k < n; k++) v_(k, j) += s * v_(k, i);
+                    }
                 }
-
-                for (k = l - consts::one<int>; k < mCols; k++)
-                    U[i][k] *= scale;
+                for (j = l; j < n; j++) v_(i, j) = v_(j, i) = consts::zero<T>;
             }
+            v_(i, i) = consts::one<T>;
+            g = rv1[i];
+            l = i;
         }
-        anorm = std::max(anorm, std::abs(W[i]) + std::abs(rv1[i]));
     }
 
-    for (i = static_cast<int>(mCols) - consts::one<int>; i >= 0; i--) { //Accumulation of right-hand transformations.
-        if (i < mCols - consts::one<int>) {
-            if (g != 0.) {
-                for (j = l; j < mCols; j++) //Double division to avoid possible underflow.
-                    V[j][i] = (U[i][j] / U[i][l]) / g;
-                for (j = l; j < mCols; j++) {
-                    for (s = 0.0, k = l; k < mCols; k++)
-                        s += U[i][k] * V[k][j];
-                    for (k = l; k < mCols; k++)
-                        V[k][j] += s * V[k][i];
+    /// Accumulation of left-hand transformations
+    if (compute_u) {
+        for (i = std::min(m, n) - 1; i >= 0; i--) {
+            l = i + 1;
+            g = w[i];
+            for (j = l; j < n; j++) u_(i, j) = consts::zero<T>;
+            if (g != consts::zero<T>) {
+                g = consts::one<T> / g;
+                for (j = l; j < n; j++) {
+                    for (s = consts::zero<T>, k = l; k < m; k++) s += u_(k, i) * u_(k, j);
+                    f = (s / u_(i, i)) * g;
+                    for (k = i; k < m; k++) u_(k, j) += f * u_(k, i);
                 }
+                for (j = i; j < m; j++) u_(j, i) *= g;
+            } else {
+                for (j = i; j < m; j++) u_(j, i) = consts::zero<T>;
             }
-
-            for (j = l; j < mCols; j++)
-                V[i][j] = V[j][i] = consts::zero<T>;
+            ++u_(i, i);
         }
-
-        V[i][i] = consts::one<T>;
-        g = rv1[i];
-        l = i;
     }
 
-    for (i = static_cast<int>(std::min(mRows, mCols)) - consts::one<int>; i >= 0; i--) { //Accumulation of left-hand transformations.
-        l = i + consts::one<int>;
-        g = W[i];
-        for (j = l; j < mCols; j++) this->U.at(i, j) = 0.0;
-        if (g != consts::zero<T>) {
-            g = consts::one<T> / g;
-            for (j = l; j < mCols; j++) {
-                for (s = consts::zero<T>, k = l; k < mRows; k++)
-                    s += U[k][i] * U[k][j];
-                f = (s / U[i][i]) * g;
-                for (k = i; k < mRows; k++)
-                    U[k][j] += f * U[k][i];
-            }
-            for (j = i; j < mRows; j++)
-                U[j][i] *= g;
-        } else {
-            for (j = i; j < mRows; j++)
-                U[j][i] = consts::zero<T>;
+    /// Singular vectors by columns, so that the rotations are contiguous
+    std::vector<T> u_cols(compute_u ? mRows * mCols : 0);
+    std::vector<T> v_cols(compute_v ? mCols * mCols : 0);
+    for (size_t c = 0; c < mCols; c++) {
+        if (compute_u) {
+            for (size_t r = 0; r < mRows; r++)
+                u_cols[c * mRows + r] = a[r * mCols + c];
+        }
+        if (compute_v) {
+            for (size_t r = 0; r < mCols; r++)
+                v_cols[c * mCols + r] = v[r * mCols + c];
         }
-        ++U[i][i];
     }
 
-    bool flag;
-    int its;
-    size_t nm;
-    T c;
-    T x;
-    T y;
-    T z;
-    for (k = static_cast<int>(mCols) - consts::one<int>; k >= 0; k--) { //Diagonalization of the bidiagonal form: Loop over
-        for (its = 0; its < mIterationMax; its++) { // singular values, and over allowed iterations.
+    auto u_col = [&u_cols, m](int c) -> T * { return &u_cols[static_cast<size_t>(c * m)]; };
+    auto v_col = [&v_cols, n](int c) -> T * { return &v_cols[static_cast<size_t>(c * n)]; };
+
+    /// Diagonalization of the bidiagonal form with implicit shifted QR
+    T c, x, y, z;
+    int nm = 0;
+
+    for (k = n - 1; k >= 0; k--) {
 
-            flag = true;
+        for (int its = 0; its < mIterationMax; its++) {
 
-            for (l = k; l >= 0; l--) { //Test for splitting.
-                nm = static_cast<size_t>(l) - consts::one<int>; //Note that rv1[1] is always zero.
+            bool flag = true;
+
+            /// Test for splitting. rv1[0] is always zero
+            for (l = k; l >= 0; l--) {
+                nm = l - 1;
                 if (l == 0 || std::abs(rv1[l]) <= eps * anorm) {
                     flag = false;
                     break;
                 }
-                if (std::abs(W[nm]) <= eps * anorm) break;
+                if (std::abs(w[nm]) <= eps * anorm) break;
             }
 
+            /// Cancellation of rv1[l] if l > 0
             if (flag) {
-                c = consts::zero<T>; //Cancellation of rv1[l], if l > 1.
+                c = consts::zero<T>;
                 s = consts::one<T>;
-                for (i = l; i < k + consts::one<int>; i++) {
+                for (i = l; i <= k; i++) {
                     f = s * rv1[i];
                     rv1[i] = c * rv1[i];
                     if (std::abs(f) <= eps * anorm) break;
-                    g = W[i];
+                    g = w[i];
                     h = module(f, g);
-                    W[i] = h;
+                    w[i] = h;
                     h = consts::one<T> / h;
                     c = g * h;
                     s = -f * h;
-                    for (j = 0; j < mRows; j++) {
-                        y = U[j][nm];
-                        z = U[j][i];
-                        U[j][nm] = y * c + z * s;
-                        U[j][i] = z * c - y * s;
-                    }
+                    if (compute_u) internal::rot(mRows, u_col(nm), u_col(i), c, s);
                 }
             }
-            z = W[k];
-            if (l == k) { //Convergence.
-                if (z < consts::zero<T>) { //Singular value is made nonnegative.
-                    W[k] = -z;
-                    for (j = 0; j < mCols; j++)
-                        V[j][k] = -V[j][k];
+
+            z = w[k];
+
+            /// Convergence. The singular value is made nonnegative
+            if (l == k) {
+                if (z < consts::zero<T>) {
+                    w[k] = -z;
+                    if (compute_v) {
+                        T *v_k = v_col(k);
+                        for (j = 0; j < n; j++) v_k[j] = -v_k[j];
+                    }
                 }
                 break;
             }
 
-            if (its == 29) throw std::runtime_error("no convergence in 30 iterations");
-            x = W[l]; //Shift from bottom 2-by-2 minor.
-            nm = static_cast<size_t>(k - consts::one<int>);
-            y = W[nm];
+            TL_ASSERT(its + 1 < mIterationMax, "No convergence in {} iterations", mIterationMax);
+
+            /// Shift from bottom 2 x 2 minor
+            x = w[l];
+            nm = k - 1;
+            y = w[nm];
             g = rv1[nm];
             h = rv1[k];
             f = ((y - z) * (y + z) + (g - h) * (g + h)) / (static_cast<T>(2) * h * y);
             g = module(f, consts::one<T>);
             f = ((x - z) * (x + z) + h * ((y / (f + std::copysign(g, f))) - h)) / x;
-            c = s = consts::one<T>; //Next QR transformation:
 
+            /// Next QR transformation
+            c = s = consts::one<T>;
             for (j = l; j <= nm; j++) {
-                i = j + consts::one<int>;
+                i = j + 1;
                 g = rv1[i];
-                y = W[i];
+                y = w[i];
                 h = s * g;
                 g = c * g;
                 z = module(f, h);
@@ -364,32 +656,47 @@ void SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::decompose()
                 g = g * c - x * s;
                 h = y * s;
                 y *= c;
-                for (size_t jj = 0; jj < mCols; jj++) {
-                    x = V[jj][j];
-                    z = V[jj][i];
-                    V[jj][j] = x * c + z * s;
-                    V[jj][i] = z * c - x * s;
-                }
+                if (compute_v) internal::rot(mCols, v_col(j), v_col(i), c, s);
                 z = module(f, h);
-                W[j] = z; //Rotation can be arbitrary if z = 0.
-                if (z != 0.) {
+                /// Rotation can be arbitrary if z = 0
+                w[j] = z;
+                if (z != consts::zero<T>) {
                     z = consts::one<T> / z;
                     c = f * z;
                     s = h * z;
                 }
                 f = c * g + s * y;
                 x = c * y - s * g;
-                for (size_t jj = 0; jj < mRows; jj++) {
-                    y = U[jj][j];
-                    z = U[jj][i];
-                    U[jj][j] = y * c + z * s;
-                    U[jj][i] = z * c - y * s;
-                }
+                if (compute_u) internal::rot(mRows, u_col(j), u_col(i), c, s);
             }
 
             rv1[l] = consts::zero<T>;
             rv1[k] = f;
-            W[k] = x;
+            w[k] = x;
+        }
+    }
+
+    /// Singular values in descending order
+
+    std::vector<size_t> index(mCols);
+    std::iota(index.begin(), index.end(), 0);
+    std::stable_sort(index.begin(), index.end(), [&w](size_t i, size_t j) {
+        return w[i] > w[j];
+    });
+
+    for (size_t col = 0; col < mCols; col++) {
+
+        size_t i_col = index[col];
+        W[col] = w[i_col];
+
+        if (compute_v) {
+            for (size_t r = 0; r < mCols; r++)
+                V(r, col) = v_cols[i_col * mCols + r];
+        }
+
+        if (compute_u) {
+            for (size_t r = 0; r < mRows; r++)
+                U(r, col) = u_cols[i_col * mRows + r];
         }
     }
 }
@@ -398,59 +705,42 @@ template<
     template<typename, size_t, size_t>
 class Matrix_t, typename T, size_t Rows, size_t Cols
 >
-void SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::reorder()
+void SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::signConvention()
 {
-    int i;
-    int j;
-    size_t k;
-
-    int inc = 1;
-    T sw;
-    Vector<T, Rows> su(mRows);
-    Vector<T, Cols> sv(mCols);
-
-    do { inc *= 3; inc++; } while (inc <= mCols);
-
-    do {
-        inc /= 3;
-        for (i = inc; i < mCols; i++) {
-            sw = W[i];
-            for (k = 0; k < mRows; k++) su[k] = U.at(k, i);
-            for (k = 0; k < mCols; k++) sv[k] = V.at(k, i);
-            j = i;
-            while (W[j - inc] < sw) {
-                W[j] = W[j - inc];
-                for (k = 0; k < mRows; k++) U.at(k, j) = U.at(k, j - inc);
-                for (k = 0; k < mCols; k++) V.at(k, j) = V.at(k, j - inc);
-                j -= inc;
-                if (j < inc) break;
-            }
-            W[j] = sw;
-            for (k = 0; k < mRows; k++) U.at(k, j) = su[k];
-            for (k = 0; k < mCols; k++) V.at(k, j) = sv[k];
+    bool compute_u = mMode == SvdMode::thin;
+    bool compute_v = mMode != SvdMode::singular_values;
+    size_t n = mCols;
 
-        }
-    } while (inc > 1);
+    /// Sign convention: most of the elements of each pair of singular vectors are positive
+    if (compute_v) {
 
-    size_t s;
-    for (size_t c = 0; c < mCols; c++) {
-        s = 0;
+        size_t elements = n + (compute_u ? mRows : 0);
 
-        for (size_t r = 0; r < mRows; r++)
-            if (U[r][c] < consts::zero<T>)
-                s++;
+        for (size_t c = 0; c < n; c++) {
 
-        for (size_t r = 0; r < mCols; r++)
-            if (V[r][c] < consts::zero<T>)
-                s++;
+            size_t negatives = 0;
 
-        if (s > (mRows + mCols) / 2) {
-            U.col(c) = -U.col(c);
-            V.col(c) = -V.col(c);
+            for (size_t r = 0; r < n; r++)
+                if (V(r, c) < consts::zero<T>) negatives++;
+
+            if (compute_u) {
+                for (size_t r = 0; r < mRows; r++)
+                    if (U(r, c) < consts::zero<T>) negatives++;
+            }
+
+            if (negatives > elements / 2) {
+                for (size_t r = 0; r < n; r++)
+                    V(r, c) = -V(r, c);
+                if (compute_u) {
+                    for (size_t r = 0; r < mRows; r++)
+                        U(r, c) = -U(r, c);
+                }
+            }
         }
     }
 }
 
+
 #ifdef TL_HAVE_OPENBLAS
 
 template<
@@ -465,6 +755,9 @@ inline void SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::lapackDecompose
     lapack_int ldvt = static_cast<int>(mCols);
     T *superb = new T[std::min(mRows, mCols) - 1];
 
+    U = Matrix<T, Rows, Cols>(mRows, mCols);
+    V = Matrix<T, Cols, Cols>(mCols, mCols);
+
     info = lapack::gesvd(static_cast<int>(mRows), static_cast<int>(mCols), A.data(), lda, W.data(), U.data(), ldu, V.data(), ldvt, superb);
     V = V.transpose();
 
@@ -481,6 +774,8 @@ class Matrix_t, typename T, size_t Rows, size_t Cols
 >
 auto SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::u() const -> Matrix<T, Rows, Cols>
 {
+    TL_ASSERT(mMode == SvdMode::thin, "U has not been computed");
+
     return U;
 }
 
@@ -490,6 +785,8 @@ class Matrix_t, typename T, size_t Rows, size_t Cols
 >
 auto SingularValueDecomposition<Matrix_t<T, Rows, Cols>>::v() const -> Matrix<T, Cols, Cols>
 {
+    TL_ASSERT(mMode != SvdMode::singular_values, "V has not been computed");
+
     return V;
 }
 
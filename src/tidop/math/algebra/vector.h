@@ -134,7 +134,8 @@ private:
 
 template<typename T, size_t _size = DynamicData>
 class Vector
-    : public VectorBase<Vector<T, _size>>
+    : public VectorBase<Vector<T, _size>>,
+      public internal::AlignedNew
 {
 
 public:
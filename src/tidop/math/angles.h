@@ -25,9 +25,16 @@
 #pragma once
 
 
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include <utility>
 
+#include "tidop/core/concurrency/parallel.h"
 #include "tidop/math/math.h"
+#include "tidop/math/simd.h"
 
 namespace tl
 {
@@ -310,9 +317,545 @@ public:
     static void convert(const Radians<T> &radians,
                         Gradians<T> &gradians);
 
+    /*!
+     * \brief Convert an array of angles between units
+     * Each angle gives the same result as the scalar conversion
+     * \param[in] angles Angles
+     * \param[out] output Converted angles. It can be the input array
+     * \param[in] size Number of angles
+     * \param[in] from Unit of the input angles
+     * \param[in] to Unit of the output angles
+     */
+    static void convert(const T *angles,
+                        T *output,
+                        size_t size,
+                        Angle::Unit from,
+                        Angle::Unit to);
+
+    /*!
+     * \brief Convert an array of decimal degrees to degrees, minutes and seconds
+     * Each angle is split as Degrees::degrees, Degrees::minutes and Degrees::seconds
+     * \param[in] decimalDegrees Decimal degrees
+     * \param[out] degrees Degrees
+     * \param[out] minutes Minutes
+     * \param[out] seconds Seconds
+     * \param[in] size Number of angles
+     */
+    static void convert(const T *decimalDegrees,
+                        int *degrees,
+                        int *minutes,
+                        T *seconds,
+                        size_t size);
+
+    /*!
+     * \brief Convert an array of degrees, minutes and seconds to decimal degrees
+     * \param[in] degrees Degrees. The sign of the angle is the sign of the degrees
+     * \param[in] minutes Minutes
+     * \param[in] seconds Seconds
+     * \param[out] decimalDegrees Decimal degrees
+     * \param[in] size Number of angles
+     */
+    static void convert(const int *degrees,
+                        const int *minutes,
+                        const T *seconds,
+                        T *decimalDegrees,
+                        size_t size);
+
+};
+
+
+
+/*!
+ * \brief Trigonometric functions over arrays of angles
+ *
+ * In Precision::fast mode the float and double arrays are processed with
+ * Packed: the angle is reduced to [-pi/4, pi/4] (Cody-Waite) and sine, cosine
+ * and arctangent are evaluated with minimax polynomials (Cephes). Maximum
+ * error measured against a long double reference:
+ *
+ * | Function | double    | float     |
+ * |----------|-----------|-----------|
+ * | sincos   | 2.4 ulp   | 2.4 ulp   |
+ * | atan2    | 1.8 ulp   | 3.2 ulp   |
+ *
+ * sincos falls back to std::sin and std::cos for |angle| > 1e5 (double) or
+ * |angle| > 4096 (float), and atan2 to std::atan2 for non finite coordinates.
+ * Unlike std::sin, the fast sine of -0 is 0. Other types always use
+ * Precision::exact.
+ *
+ * <h4>Example</h4>
+ * \code
+ * std::vector<double> latitudes = ...;
+ * std::vector<double> sin_lat(latitudes.size());
+ * std::vector<double> cos_lat(latitudes.size());
+ * AngleConverter<double>::convert(latitudes.data(), latitudes.data(), latitudes.size(),
+ *                                 Angle::Unit::degrees, Angle::Unit::radians);
+ * Trigonometry<double>::sincos(latitudes.data(), sin_lat.data(), cos_lat.data(),
+ *                              latitudes.size(), Precision::fast);
+ * \endcode
+ */
+template<typename T>
+class Trigonometry
+{
+
+private:
+
+    Trigonometry() = default;
+
+public:
+
+    /*!
+     * \brief Sine and cosine of an array of angles in radians
+     * \param[in] angles Angles in radians
+     * \param[out] sin Sine of the angles
+     * \param[out] cos Cosine of the angles
+     * \param[in] size Number of angles
+     * \param[in] precision Exact or fast evaluation
+     */
+    static void sincos(const T *angles,
+                       T *sin,
+                       T *cos,
+                       size_t size,
+                       Precision precision = Precision::exact);
+
+    /*!
+     * \brief Arc tangent of y/x for arrays of coordinates, as std::atan2
+     * \param[in] y y coordinates
+     * \param[in] x x coordinates
+     * \param[out] angles Angles in radians in [-pi, pi]
+     * \param[in] size Number of coordinates
+     * \param[in] precision Exact or fast evaluation
+     */
+    static void atan2(const T *y,
+                      const T *x,
+                      T *angles,
+                      size_t size,
+                      Precision precision = Precision::exact);
+
+};
+
+
+
+
+/// \cond
+
+namespace internal
+{
+
+/// Number of angles processed by each task
+constexpr size_t angles_batch_block_size = 16384;
+/// Arrays smaller than this are processed in the calling thread
+constexpr size_t angles_batch_parallel_threshold = 65536;
+/// Angles processed by each pass of the fast trigonometric kernels
+constexpr size_t angles_batch_chunk_size = 64;
+
+template<typename T>
+struct is_simd_angles_type
+#ifdef TL_HAVE_SIMD_INTRINSICS
+  : std::integral_constant<bool, std::is_same<float, std::remove_cv_t<T>>::value ||
+                                 std::is_same<double, std::remove_cv_t<T>>::value>
+#else
+  : std::false_type
+#endif
+{
+};
+
+/*!
+ * \brief Splits the array in blocks and runs the kernel over them.
+ * Small arrays are processed in the calling thread.
+ */
+template<typename Kernel>
+void angles_batch_run(size_t size, Kernel kernel)
+{
+    if (size < angles_batch_parallel_threshold) {
+        kernel(0, size);
+        return;
+    }
+
+    size_t blocks = (size + angles_batch_block_size - 1) / angles_batch_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * angles_batch_block_size;
+        size_t end = std::min(ini + angles_batch_block_size, size);
+        kernel(ini, end);
+    });
+}
+
+/*!
+ * \brief Factor that converts an angle from one unit to other.
+ * The same constants as AngleConverter are used.
+ */
+template<typename T>
+auto angle_conversion_factor(Angle::Unit from, Angle::Unit to) -> T
+{
+    T factor = consts::one<T>;
+
+    if (from == Angle::Unit::degrees && to == Angle::Unit::radians) {
+        factor = consts::deg_to_rad<T>;
+    } else if (from == Angle::Unit::degrees && to == Angle::Unit::gradians) {
+        factor = consts::deg_to_grad<T>;
+    } else if (from == Angle::Unit::gradians && to == Angle::Unit::radians) {
+        factor = consts::grad_to_rad<T>;
+    } else if (from == Angle::Unit::gradians && to == Angle::Unit::degrees) {
+        factor = consts::grad_to_deg<T>;
+    } else if (from == Angle::Unit::radians && to == Angle::Unit::degrees) {
+        factor = consts::rad_to_deg<T>;
+    } else if (from == Angle::Unit::radians && to == Angle::Unit::gradians) {
+        factor = consts::rad_to_grad<T>;
+    }
+
+    return factor;
+}
+
+template<typename T>
+void scale_angles_cpp(const T *angles, T *output, T factor, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        output[i] = angles[i] * factor;
+    }
+}
+
+template<typename T>
+void sincos_cpp(const T *angles, T *sin, T *cos, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        T angle = angles[i];
+        sin[i] = std::sin(angle);
+        cos[i] = std::cos(angle);
+    }
+}
+
+template<typename T>
+void atan2_cpp(const T *y, const T *x, T *angles, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        angles[i] = std::atan2(y[i], x[i]);
+    }
+}
+
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+auto scale_angles_block(const T *angles, T *output, T factor,
+                        size_t ini, size_t end) -> std::enable_if_t<is_simd_angles_type<T>::value, void>
+{
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    const Packed<T> packed_factor(factor);
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+        Packed<T> packed_angles;
+        packed_angles.loadUnaligned(&angles[i]);
+        (packed_angles * packed_factor).storeUnaligned(&output[i]);
+    }
+
+    scale_angles_cpp(angles, output, factor, max_vector, end);
+}
+
+
+/* Fast trigonometry */
+
+template<typename T>
+struct fast_trigonometry;
+
+template<>
+struct fast_trigonometry<double>
+{
+    /// Adding and subtracting 1.5 * 2^52 rounds to the nearest integer
+    static constexpr auto roundConstant() -> double { return 6755399441055744.; }
+    /// The reduction keeps k * pi/2 exact up to this angle
+    static constexpr auto maxArgument() -> double { return 1.e5; }
+
+    /// Cody-Waite reduction r = x - k * pi/2. pi/2 is split in three parts
+    /// with 33, 33 and 53 bits
+    static auto reduce(const Packed<double> &x, const Packed<double> &k) -> Packed<double>
+    {
+        return ((x - k * 1.57079632673412561417e+00)
+                   - k * 6.07710050630396597660e-11)
+                   - k * 2.02226624879595063154e-21;
+    }
+
+    /// sin(r) in [-pi/4, pi/4], z = r * r
+    static auto sin(const Packed<double> &r, const Packed<double> &z) -> Packed<double>
+    {
+        Packed<double> p(1.58962301576546568060e-10);
+        p = internal::fmadd(p, z, Packed<double>(-2.50507477628578072866e-8));
+        p = internal::fmadd(p, z, Packed<double>(2.75573136213857245213e-6));
+        p = internal::fmadd(p, z, Packed<double>(-1.98412698295895385996e-4));
+        p = internal::fmadd(p, z, Packed<double>(8.33333333332211858878e-3));
+        p = internal::fmadd(p, z, Packed<double>(-1.66666666666666307295e-1));
+        return internal::fmadd(r * z, p, r);
+    }
+
+    /// cos(r) in [-pi/4, pi/4], z = r * r
+    static auto cos(const Packed<double> &z) -> Packed<double>
+    {
+        Packed<double> p(-1.13585365213876817300e-11);
+        p = internal::fmadd(p, z, Packed<double>(2.08757008419747316778e-9));
+        p = internal::fmadd(p, z, Packed<double>(-2.75573141792967388112e-7));
+        p = internal::fmadd(p, z, Packed<double>(2.48015872888517045348e-5));
+        p = internal::fmadd(p, z, Packed<double>(-1.38888888888730564116e-3));
+        p = internal::fmadd(p, z, Packed<double>(4.16666666666665929218e-2));
+        return internal::fmadd(z * z, p, 1. - 0.5 * z);
+    }
+
+    /// atan(a) in [0, 1]
+    static auto atan(const Packed<double> &a) -> Packed<double>
+    {
+        const Packed<double> one(1.);
+        const Packed<double> zero(0.);
+
+        Packed<double> reduced = internal::greaterThan(a, Packed<double>(0.66));
+        Packed<double> x = internal::select(reduced, (a - one) / (a + one), a);
+        Packed<double> z = x * x;
+
+        Packed<double> p(-8.750608600031904122785e-1);
+        p = internal::fmadd(p, z, Packed<double>(-1.615753718733365076637e1));
+        p = internal::fmadd(p, z, Packed<double>(-7.500855792314704667340e1));
+        p = internal::fmadd(p, z, Packed<double>(-1.228866684490136173410e2));
+        p = internal::fmadd(p, z, Packed<double>(-6.485021904942025371773e1));
+
+        Packed<double> q = z + 2.485846490142306297962e1;
+        q = internal::fmadd(q, z, Packed<double>(1.650270098316988542046e2));
+        q = internal::fmadd(q, z, Packed<double>(4.328810604912902668951e2));
+        q = internal::fmadd(q, z, Packed<double>(4.853903996359136964868e2));
+        q = internal::fmadd(q, z, Packed<double>(1.945506571482613964425e2));
+
+        Packed<double> y = internal::fmadd(x * z, p / q, x);
+        /// pi/4 is added in two parts
+        return y + internal::select(reduced, Packed<double>(0.5 * 6.123233995736765886130e-17), zero)
+                 + internal::select(reduced, Packed<double>(consts::pi<double> / 4.), zero);
+    }
+};
+
+template<>
+struct fast_trigonometry<float>
+{
+    /// Adding and subtracting 1.5 * 2^23 rounds to the nearest integer
+    static constexpr auto roundConstant() -> float { return 12582912.f; }
+    /// The reduction keeps k * pi/2 exact up to this angle
+    static constexpr auto maxArgument() -> float { return 4096.f; }
+
+    /// Cody-Waite reduction r = x - k * pi/2. pi/2 is split in four parts,
+    /// the first three with 12 bits
+    static auto reduce(const Packed<float> &x, const Packed<float> &k) -> Packed<float>
+    {
+        return (((x - k * 1.5703125f)
+                    - k * 4.837512969970703125e-4f)
+                    - k * 7.54953362047672271729e-8f)
+                    - k * 2.56334406825708960298e-12f;
+    }
+
+    /// sin(r) in [-pi/4, pi/4], z = r * r
+    static auto sin(const Packed<float> &r, const Packed<float> &z) -> Packed<float>
+    {
+        Packed<float> p(-1.9515295891e-4f);
+        p = internal::fmadd(p, z, Packed<float>(8.3321608736e-3f));
+        p = internal::fmadd(p, z, Packed<float>(-1.6666654611e-1f));
+        return internal::fmadd(r * z, p, r);
+    }
+
+    /// cos(r) in [-pi/4, pi/4], z = r * r
+    static auto cos(const Packed<float> &z) -> Packed<float>
+    {
+        Packed<float> p(2.443315711809948e-5f);
+        p = internal::fmadd(p, z, Packed<float>(-1.388731625493765e-3f));
+        p = internal::fmadd(p, z, Packed<float>(4.166664568298827e-2f));
+        return internal::fmadd(z * z, p, 1.f - 0.5f * z);
+    }
+
+    /// atan(a) in [0, 1]
+    static auto atan(const Packed<float> &a) -> Packed<float>
+    {
+        const Packed<float> one(1.f);
+        const Packed<float> zero(0.f);
+
+        Packed<float> reduced = internal::greaterThan(a, Packed<float>(0.4142135623730950f));
+        Packed<float> x = internal::select(reduced, (a - one) / (a + one), a);
+        Packed<float> z = x * x;
+
+        Packed<float> p(8.05374449538e-2f);
+        p = internal::fmadd(p, z, Packed<float>(-1.38776856032e-1f));
+        p = internal::fmadd(p, z, Packed<float>(1.99777106478e-1f));
+        p = internal::fmadd(p, z, Packed<float>(-3.33329491539e-1f));
+
+        return internal::fmadd(x * z, p, x) + internal::select(reduced, Packed<float>(consts::pi<float> / 4.f), zero);
+    }
 };
 
+/*!
+ * \brief Sine and cosine of aligned chunks.
+ * k = round(2x / pi) selects the quadrant: with k mod 4 = 2h + p, the
+ * polynomials are swapped when p is odd, the sine changes sign when h = 1
+ * and the cosine when h != p.
+ */
+template<typename T>
+void sincos_fast_chunk(const T *angles, T *sin, T *cos, size_t size)
+{
+    using trig = fast_trigonometry<T>;
+
+    constexpr size_t packed_size = Packed<T>::size();
+
+    const Packed<T> one(consts::one<T>);
+    const Packed<T> two(consts::two<T>);
+    const Packed<T> half(consts::one_half<T>);
+    const Packed<T> quarter(static_cast<T>(0.25));
+    const Packed<T> round(trig::roundConstant());
+    const Packed<T> two_over_pi(consts::two<T> / consts::pi<T>);
+
+    for (size_t i = 0; i < size; i += packed_size) {
+
+        Packed<T> x;
+        x.loadAligned(&angles[i]);
+
+        Packed<T> k = (x * two_over_pi + round) - round;
+        Packed<T> r = trig::reduce(x, k);
+        Packed<T> z = r * r;
+        Packed<T> s = trig::sin(r, z);
+        Packed<T> c = trig::cos(z);
+
+        /// floor(k / 4) = round(k / 4 - 3/8) and floor(m / 2) = round(m / 2 - 1/4)
+        Packed<T> m = k - static_cast<T>(4) * (((k * quarter - static_cast<T>(0.375)) + round) - round);
+        Packed<T> h = ((m * half - quarter) + round) - round;
+        Packed<T> p = m - two * h;
+        Packed<T> d = p - h;
+
+        Packed<T> swap = internal::greaterThan(p, half);
+        (internal::select(swap, c, s) * (one - two * h)).storeAligned(&sin[i]);
+        (internal::select(swap, s, c) * (one - two * d * d)).storeAligned(&cos[i]);
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        if (!(std::abs(angles[i]) <= trig::maxArgument())) {
+            sin[i] = std::sin(angles[i]);
+            cos[i] = std::cos(angles[i]);
+        }
+    }
+}
+
+/*!
+ * \brief atan2 of aligned chunks.
+ * atan(internal::min(|x|,|y|) / internal::max(|x|,|y|)) is moved to its octant. Both
+ * coordinates infinite are computed with std::atan2.
+ */
+template<typename T>
+void atan2_fast_chunk(const T *y, const T *x, T *angles, size_t size)
+{
+    using trig = fast_trigonometry<T>;
 
+    constexpr size_t packed_size = Packed<T>::size();
+
+    const Packed<T> zero(consts::zero<T>);
+    const Packed<T> one(consts::one<T>);
+    const Packed<T> pi(consts::pi<T>);
+    const Packed<T> half_pi(consts::half_pi<T>);
+
+    for (size_t i = 0; i < size; i += packed_size) {
+
+        Packed<T> _y;
+        Packed<T> _x;
+        _y.loadAligned(&y[i]);
+        _x.loadAligned(&x[i]);
+
+        Packed<T> abs_y = internal::max(_y, -_y);
+        Packed<T> abs_x = internal::max(_x, -_x);
+        Packed<T> num = internal::min(abs_x, abs_y);
+        Packed<T> den = internal::max(abs_x, abs_y);
+        Packed<T> nonzero = internal::greaterThan(den, zero);
+
+        Packed<T> angle = trig::atan(internal::select(nonzero, num / internal::select(nonzero, den, one), zero));
+        angle = internal::select(internal::greaterThan(abs_y, abs_x), half_pi - angle, angle);
+        /// The sign of 1/x and 1/y is also the sign of zero
+        angle = internal::select(internal::lessThan(one / _x, zero), pi - angle, angle);
+        internal::select(internal::lessThan(one / _y, zero), -angle, angle).storeAligned(&angles[i]);
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        if (!(std::isfinite(x[i]) && std::isfinite(y[i]))) {
+            angles[i] = std::atan2(y[i], x[i]);
+        }
+    }
+}
+
+/*!
+ * \brief Copies the angles in aligned chunks so that the tail and arrays
+ * that overlap the output are processed as the rest
+ */
+template<typename T>
+auto sincos_fast_block(const T *angles, T *sin, T *cos,
+                       size_t ini, size_t end) -> std::enable_if_t<is_simd_angles_type<T>::value, void>
+{
+    constexpr size_t chunk = angles_batch_chunk_size;
+
+    alignas(32) T _angles[chunk];
+    alignas(32) T _sin[chunk];
+    alignas(32) T _cos[chunk];
+
+    for (size_t first = ini; first < end; first += chunk) {
+
+        size_t n = std::min(chunk, end - first);
+        std::copy(angles + first, angles + first + n, _angles);
+        std::fill(_angles + n, _angles + chunk, consts::zero<T>);
+
+        sincos_fast_chunk(_angles, _sin, _cos, chunk);
+
+        std::copy(_sin, _sin + n, sin + first);
+        std::copy(_cos, _cos + n, cos + first);
+    }
+}
+
+template<typename T>
+auto atan2_fast_block(const T *y, const T *x, T *angles,
+                      size_t ini, size_t end) -> std::enable_if_t<is_simd_angles_type<T>::value, void>
+{
+    constexpr size_t chunk = angles_batch_chunk_size;
+
+    alignas(32) T _y[chunk];
+    alignas(32) T _x[chunk];
+    alignas(32) T _angles[chunk];
+
+    for (size_t first = ini; first < end; first += chunk) {
+
+        size_t n = std::min(chunk, end - first);
+        std::copy(y + first, y + first + n, _y);
+        std::copy(x + first, x + first + n, _x);
+        std::fill(_y + n, _y + chunk, consts::zero<T>);
+        std::fill(_x + n, _x + chunk, consts::one<T>);
+
+        atan2_fast_chunk(_y, _x, _angles, chunk);
+
+        std::copy(_angles, _angles + n, angles + first);
+    }
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+auto scale_angles_block(const T *angles, T *output, T factor,
+                        size_t ini, size_t end) -> std::enable_if_t<!is_simd_angles_type<T>::value, void>
+{
+    scale_angles_cpp(angles, output, factor, ini, end);
+}
+
+template<typename T>
+auto sincos_fast_block(const T *angles, T *sin, T *cos,
+                       size_t ini, size_t end) -> std::enable_if_t<!is_simd_angles_type<T>::value, void>
+{
+    sincos_cpp(angles, sin, cos, ini, end);
+}
+
+template<typename T>
+auto atan2_fast_block(const T *y, const T *x, T *angles,
+                      size_t ini, size_t end) -> std::enable_if_t<!is_simd_angles_type<T>::value, void>
+{
+    atan2_cpp(y, x, angles, ini, end);
+}
+
+} // namespace internal
+
+/// \endcond
 
 
 /* AngleBase implementation */
@@ -812,6 +1355,94 @@ void AngleConverter<T>::convert(const Radians<T> &radians,
   gradians = radians.value() * consts::rad_to_grad<T>;
 }
 
+template<typename T>
+void AngleConverter<T>::convert(const T *angles,
+                                T *output,
+                                size_t size,
+                                Angle::Unit from,
+                                Angle::Unit to)
+{
+    T factor = internal::angle_conversion_factor<T>(from, to);
+
+    internal::angles_batch_run(size, [&](size_t ini, size_t end) {
+        internal::scale_angles_block(angles, output, factor, ini, end);
+    });
+}
+
+template<typename T>
+void AngleConverter<T>::convert(const T *decimalDegrees,
+                                int *degrees,
+                                int *minutes,
+                                T *seconds,
+                                size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+
+        T value = decimalDegrees[i];
+        int _degrees = static_cast<int>(value);
+        int _seconds = static_cast<int>(std::round(value * consts::degrees_to_seconds));
+        _seconds = std::abs(_seconds % consts::degrees_to_seconds);
+        int _minutes = _seconds / consts::minutes_to_seconds;
+        T min = std::abs(value - static_cast<T>(_degrees)) * static_cast<T>(consts::degrees_to_minutes);
+
+        degrees[i] = _degrees;
+        minutes[i] = _minutes;
+        seconds[i] = std::abs(min - static_cast<T>(_minutes)) * static_cast<T>(consts::minutes_to_seconds);
+    }
+}
+
+template<typename T>
+void AngleConverter<T>::convert(const int *degrees,
+                                const int *minutes,
+                                const T *seconds,
+                                T *decimalDegrees,
+                                size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        decimalDegrees[i] = isNegative(degrees[i]) *
+                            (std::abs(degrees[i]) +
+                            minutes[i] / static_cast<T>(consts::degrees_to_minutes) +
+                            seconds[i] / static_cast<T>(consts::degrees_to_seconds));
+    }
+}
+
+
+
+/* Trigonometry implementation */
+
+template<typename T>
+void Trigonometry<T>::sincos(const T *angles,
+                             T *sin,
+                             T *cos,
+                             size_t size,
+                             Precision precision)
+{
+    internal::angles_batch_run(size, [&](size_t ini, size_t end) {
+        if (precision == Precision::fast) {
+            internal::sincos_fast_block(angles, sin, cos, ini, end);
+        } else {
+            internal::sincos_cpp(angles, sin, cos, ini, end);
+        }
+    });
+}
+
+template<typename T>
+void Trigonometry<T>::atan2(const T *y,
+                            const T *x,
+                            T *angles,
+                            size_t size,
+                            Precision precision)
+{
+    internal::angles_batch_run(size, [&](size_t ini, size_t end) {
+        if (precision == Precision::fast) {
+            internal::atan2_fast_block(y, x, angles, ini, end);
+        } else {
+            internal::atan2_cpp(y, x, angles, ini, end);
+        }
+    });
+}
+
+
 
 //Radians<double> operator""_rad(long double radians)
 //{
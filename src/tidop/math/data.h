@@ -27,9 +27,17 @@
 
 #include <vector>
 #include <array>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
 
 #include "tidop/math/math.h"
 
+#if defined TL_OS_WINDOWS
+#include <malloc.h>
+#endif
+
 
 namespace tl
 {
@@ -126,13 +134,81 @@ private:
 /*------------------------------------------------------------------------*/
 
 
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * \brief Allocates memory aligned to `alignment` bytes
+ */
+inline auto alignedMalloc(size_t size, size_t alignment) -> void *
+{
+    void *ptr = nullptr;
+    size = (size + alignment - 1) & ~(alignment - 1);
+
+#if defined TL_OS_WINDOWS
+    ptr = _aligned_malloc(size, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, size) != 0)
+        ptr = nullptr;
+#endif
+
+    if (!ptr) throw std::bad_alloc();
+
+    return ptr;
+}
+
+inline void alignedFree(void *ptr)
+{
+#if defined TL_OS_WINDOWS
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+/*!
+ * \brief Class allocation functions aligned to 64 bytes
+ *
+ * Base of the classes that hold a dynamic Data, whose inline buffer is over
+ * aligned. Before C++17 new ignores the alignment of over-aligned types.
+ */
+class AlignedNew
+{
+
+public:
+
+    static auto operator new(size_t size) -> void * { return alignedMalloc(size, 64); }
+    static auto operator new[](size_t size) -> void * { return alignedMalloc(size, 64); }
+    static void operator delete(void *ptr) TL_NOEXCEPT { alignedFree(ptr); }
+    static void operator delete[](void *ptr) TL_NOEXCEPT { alignedFree(ptr); }
+    static auto operator new(size_t, void *ptr) TL_NOEXCEPT -> void * { return ptr; }
+    static void operator delete(void *, void *) TL_NOEXCEPT {}
+
+};
+
+} // namespace internal
+
+/// \endcond
+
+
 /*!
  * \brief Dynamic data storage
+ *
+ * The storage is allocated with a `alignment` bytes alignment so SIMD kernels
+ * can rely on aligned loads at the start of the buffer. Buffers of up to
+ * `small_buffer_size` elements are kept inline in the object (small-buffer
+ * optimisation), so small matrices and vectors built at runtime do not pay a
+ * heap allocation. The inline buffer has the same alignment.
  */
 template<typename T>
 class Data<T, DynamicData>
+  : public internal::AlignedNew
 {
 
+    static_assert(std::is_trivially_copyable<T>::value, "Dynamic data requires a trivially copyable type");
+
 public:
 
     using value_type = T;
@@ -142,8 +218,18 @@ public:
     using reference = T &;
     using const_reference = const T &;
 
-    using iterator = typename std::vector<T>::iterator;
-    using const_iterator = typename std::vector<T>::const_iterator;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    /*!
+     * \brief Alignment in bytes of the storage (heap allocated and inline)
+     */
+    static constexpr size_t alignment = 64;
+
+    /*!
+     * \brief Maximum number of elements stored inline
+     */
+    static constexpr size_t small_buffer_size = 128 / sizeof(T) > 0 ? 128 / sizeof(T) : 1;
 
 public:
 
@@ -154,7 +240,7 @@ public:
     Data(Data &&matrix) TL_NOEXCEPT;
     Data(std::initializer_list<T> values);
     Data(const T *data, size_t size);
-    virtual ~Data() = default;
+    virtual ~Data();
 
     auto operator = (const Data &matrix)->Data &;
     auto operator = (Data &&matrix) TL_NOEXCEPT->Data &;
@@ -178,11 +264,37 @@ public:
     auto data() -> pointer;
     auto data() const -> const_pointer;
 
-    size_t size() const { return mData.size(); }
+    size_t size() const { return mSize; }
+
+    /*!
+     * \brief Resize the storage keeping the current values
+     * \param[in] size New size
+     */
+    void resize(size_t size);
+
+    /*!
+     * \brief Resize the storage keeping the current values
+     * \param[in] size New size
+     * \param[in] value Value for the new elements
+     */
+    void resize(size_t size, T value);
+
+    /*!
+     * \brief Checks if the data is stored inline
+     */
+    auto isSmall() const -> bool { return mData == mBuffer; }
 
 private:
 
-    std::vector<T> mData;
+    void allocate(size_t size);
+    void release();
+
+private:
+
+    T *mData{mBuffer};
+    size_t mSize{0};
+    size_t mCapacity{small_buffer_size};
+    alignas(alignment) T mBuffer[small_buffer_size];
 
 };
 
@@ -193,6 +305,15 @@ private:
 /*------------------------------------------------------------------------*/
 
 
+/* Dynamic Data static members */
+
+template<typename T>
+constexpr size_t Data<T, DynamicData>::alignment;
+
+template<typename T>
+constexpr size_t Data<T, DynamicData>::small_buffer_size;
+
+
 /* Static Data implementation */
 
 template<typename T, size_t _size>
@@ -400,47 +521,72 @@ auto Data<T, _size>::data() const -> const_pointer
 
 template<typename T>
 Data<T, DynamicData>::Data(size_t size)
-  : mData(size, -std::numeric_limits<T>().max())
 {
+    allocate(size);
+    std::fill(mData, mData + mSize, -std::numeric_limits<T>().max());
 }
 
 template<typename T>
 Data<T, DynamicData>::Data(size_t size, T val)
-  : mData(size, val)
 {
+    allocate(size);
+    std::fill(mData, mData + mSize, val);
 }
 
 template<typename T>
 Data<T, DynamicData>::Data(const Data &matrix)
-  : mData(matrix.mData)
 {
+    allocate(matrix.mSize);
+    std::copy(matrix.mData, matrix.mData + mSize, mData);
 }
 
 template<typename T>
 Data<T, DynamicData>::Data(Data &&matrix) TL_NOEXCEPT
-  : mData(std::move(matrix.mData))
+  : mSize(matrix.mSize)
 {
+    if (matrix.isSmall()) {
+        std::copy(matrix.mBuffer, matrix.mBuffer + std::min(mSize, small_buffer_size), mBuffer);
+    } else {
+        mData = matrix.mData;
+        mCapacity = matrix.mCapacity;
+        matrix.mData = matrix.mBuffer;
+        matrix.mCapacity = small_buffer_size;
+    }
+
+    matrix.mSize = 0;
 }
 
 template<typename T>
 Data<T, DynamicData>::Data(std::initializer_list<T> values)
 {
-    mData.resize(values.size());
-    std::copy(values.begin(), values.end(), mData.begin());
+    allocate(values.size());
+    std::copy(values.begin(), values.end(), mData);
 }
 
 template<typename T>
 Data<T, DynamicData>::Data(const T *data, size_t size)
-    : mData(size, -std::numeric_limits<T>().max())
 {
-    mData.assign(data, data + mData.size());
+    allocate(size);
+    std::copy(data, data + size, mData);
+}
+
+template<typename T>
+Data<T, DynamicData>::~Data()
+{
+    release();
 }
 
 template<typename T>
 auto Data<T, DynamicData>::operator = (const Data<T, DynamicData> &matrix) -> Data &
 {
     if (this != &matrix) {
-        this->mData = matrix.mData;
+        if (matrix.mSize > mCapacity) {
+            release();
+            allocate(matrix.mSize);
+        } else {
+            mSize = matrix.mSize;
+        }
+        std::copy(matrix.mData, matrix.mData + mSize, mData);
     }
     return *this;
 }
@@ -449,7 +595,22 @@ template<typename T>
 auto Data<T, DynamicData>::operator = (Data<T, DynamicData> &&matrix) TL_NOEXCEPT -> Data &
 {
     if (this != &matrix) {
-        this->mData = std::move(matrix.mData);
+
+        if (matrix.isSmall()) {
+            /// The source fits in the inline buffer. The current storage
+            /// (inline or heap) is big enough so it is reused.
+            mSize = matrix.mSize;
+            std::copy(matrix.mBuffer, matrix.mBuffer + std::min(mSize, small_buffer_size), mData);
+        } else {
+            release();
+            mData = matrix.mData;
+            mSize = matrix.mSize;
+            mCapacity = matrix.mCapacity;
+            matrix.mData = matrix.mBuffer;
+            matrix.mCapacity = small_buffer_size;
+        }
+
+        matrix.mSize = 0;
     }
     return *this;
 }
@@ -457,13 +618,15 @@ auto Data<T, DynamicData>::operator = (Data<T, DynamicData> &&matrix) TL_NOEXCEP
 template<typename T>
 auto Data<T, DynamicData>::at(size_t position) -> reference
 {
-    return mData.at(position);
+    if (position >= mSize) throw std::out_of_range("Data::at: position out of range");
+    return mData[position];
 }
 
 template<typename T>
 auto Data<T, DynamicData>::at(size_t position) const -> const_reference
 {
-    return mData.at(position);
+    if (position >= mSize) throw std::out_of_range("Data::at: position out of range");
+    return mData[position];
 }
 
 template<typename T>
@@ -481,67 +644,118 @@ auto Data<T, DynamicData>::operator[](size_t position) const -> const_reference
 template<typename T>
 void Data<T, DynamicData>::operator=(T value)
 {
-    std::fill(mData.begin(), mData.end(), value);
+    std::fill(mData, mData + mSize, value);
 }
 
 template<typename T>
 auto Data<T, DynamicData>::front() -> reference
 {
-    return mData.front();
+    return mData[0];
 }
 
 template<typename T>
 auto Data<T, DynamicData>::front() const-> const_reference
 {
-    return mData.front();
+    return mData[0];
 }
 
 template<typename T>
 auto Data<T, DynamicData>::back() -> reference
 {
-    return mData.back();
+    return mData[mSize - 1];
 }
 
 template<typename T>
 auto Data<T, DynamicData>::back() const -> const_reference
 {
-    return mData.back();
+    return mData[mSize - 1];
 }
 
 template<typename T>
 auto Data<T, DynamicData>::begin() TL_NOEXCEPT  -> iterator
 {
-    return mData.begin();
+    return mData;
 }
 
 template<typename T>
 auto Data<T, DynamicData>::begin() const TL_NOEXCEPT-> const_iterator
 {
-    return mData.begin();
+    return mData;
 }
 
 template<typename T>
 auto Data<T, DynamicData>::end() TL_NOEXCEPT -> iterator
 {
-    return mData.end();
+    return mData + mSize;
 }
 
 template<typename T>
 auto Data<T, DynamicData>::end() const TL_NOEXCEPT -> const_iterator
 {
-    return mData.end();
+    return mData + mSize;
 }
 
 template<typename T>
 auto Data<T, DynamicData>::data() -> pointer
 {
-    return mData.data();
+    return mData;
 }
 
 template<typename T>
 auto Data<T, DynamicData>::data() const -> const_pointer
 {
-    return mData.data();
+    return mData;
+}
+
+template<typename T>
+void Data<T, DynamicData>::resize(size_t size)
+{
+    resize(size, T{});
+}
+
+template<typename T>
+void Data<T, DynamicData>::resize(size_t size, T value)
+{
+    size_t old_size = mSize;
+
+    if (size > mCapacity) {
+        T *data = static_cast<T *>(internal::alignedMalloc(size * sizeof(T), alignment));
+        std::copy(mData, mData + old_size, data);
+        release();
+        mData = data;
+        mCapacity = size;
+    }
+
+    if (size > old_size)
+        std::fill(mData + old_size, mData + size, value);
+
+    mSize = size;
+}
+
+template<typename T>
+void Data<T, DynamicData>::allocate(size_t size)
+{
+    if (size > small_buffer_size) {
+        mData = static_cast<T *>(internal::alignedMalloc(size * sizeof(T), alignment));
+        mCapacity = size;
+    } else {
+        mData = mBuffer;
+        mCapacity = small_buffer_size;
+    }
+
+    mSize = size;
+}
+
+template<typename T>
+void Data<T, DynamicData>::release()
+{
+    if (!isSmall()) {
+        internal::alignedFree(mData);
+        mData = mBuffer;
+        mCapacity = small_buffer_size;
+    }
+
+    mSize = 0;
 }
 
 
@@ -32,6 +32,8 @@
 #include "tidop/math/geometry/translation.h"
 #include "tidop/math/geometry/scaling.h"
 #include "tidop/math/geometry/rotation.h"
+#include "tidop/math/geometry/transform_batch.h"
+#include "tidop/math/geometry/mixed_precision.h"
 
 namespace tl
 {
@@ -123,6 +125,34 @@ public:
     template<size_t _row, size_t _col>
     auto transform(const Matrix<T, _row, _col> &matrix) const -> Matrix<T, _row, _col>;
 
+    /*!
+     * \brief Transform a 2D point set stored as separate coordinate arrays
+     * The output arrays can be the same as the input arrays. Large point
+     * sets are split in blocks that are transformed in parallel.
+     * \param[in] x X coordinates
+     * \param[in] y Y coordinates
+     * \param[out] xOut Transformed X coordinates
+     * \param[out] yOut Transformed Y coordinates
+     * \param[in] size Number of points
+     */
+    void transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const;
+
+    /*!
+     * \brief Transform a 3D point set stored as separate coordinate arrays
+     * \see transform(const T *, const T *, T *, T *, size_t)
+     */
+    void transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 2D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 3D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, T *z, size_t size) const;
+
     auto operator * (const Point<T> &point) const -> Point<T>;
     auto operator * (const Point3<T> &point) const -> Point3<T>;
     template<size_t _size>
@@ -139,6 +169,14 @@ public:
 
 
 
+/*!
+ * \brief Least squares 2D affine transform estimator
+ *
+ * With Precision::fast the normal equations are accumulated in float with
+ * double accumulation and the solution is refined in double (see
+ * mixed_precision.h). The result matches Precision::exact, which solves
+ * the full design matrix with SVD.
+ */
 template <typename T>
 class Affine2DEstimator
 {
@@ -150,10 +188,12 @@ public:
 
     template<size_t Rows, size_t Cols>
     static auto estimate(const Matrix<T, Rows, Cols> &src,
-                         const Matrix<T, Rows, Cols> &dst) -> Affine<T, 2>;
+                         const Matrix<T, Rows, Cols> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, 2>;
 
     static auto estimate(const std::vector<Point<T>> &src,
-                         const std::vector<Point<T>> &dst) -> Affine<T, 2>;
+                         const std::vector<Point<T>> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, 2>;
 
 };
 
@@ -443,6 +483,41 @@ auto Affine<T, Dim>::transform(const Matrix<T, _row, _col> &matrix) const -> Mat
     return _matrix;
 }
 
+template<typename T, size_t Dim>
+void Affine<T, Dim>::transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const
+{
+    static_assert(dimensions == 2, "Transformation only allowed for 2D points");
+
+    const T m[6] = {_transform(0, 0), _transform(0, 1), _transform(0, 2),
+                    _transform(1, 0), _transform(1, 1), _transform(1, 2)};
+
+    internal::transform_batch_2d(m, x, y, xOut, yOut, size);
+}
+
+template<typename T, size_t Dim>
+void Affine<T, Dim>::transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const
+{
+    static_assert(dimensions == 3, "Transformation only allowed for 3D points");
+
+    const T m[12] = {_transform(0, 0), _transform(0, 1), _transform(0, 2), _transform(0, 3),
+                     _transform(1, 0), _transform(1, 1), _transform(1, 2), _transform(1, 3),
+                     _transform(2, 0), _transform(2, 1), _transform(2, 2), _transform(2, 3)};
+
+    internal::transform_batch_3d(m, x, y, z, xOut, yOut, zOut, size);
+}
+
+template<typename T, size_t Dim>
+void Affine<T, Dim>::transform(T *x, T *y, size_t size) const
+{
+    this->transform(x, y, x, y, size);
+}
+
+template<typename T, size_t Dim>
+void Affine<T, Dim>::transform(T *x, T *y, T *z, size_t size) const
+{
+    this->transform(x, y, z, x, y, z, size);
+}
+
 template<typename T, size_t Dim>
 auto Affine<T, Dim>::operator*(const Point<T> &point) const -> Point<T>
 {
@@ -493,7 +568,8 @@ auto Affine<T, Dim>::isEmpty() const
 template<typename T>
 template<size_t rows, size_t cols>
 auto Affine2DEstimator<T>::estimate(const Matrix<T, rows, cols> &src, 
-                                    const Matrix<T, rows, cols> &dst) -> Affine<T, 2>
+                                    const Matrix<T, rows, cols> &dst,
+                                    Precision precision) -> Affine<T, 2>
 {
 
     Affine<T, 2> affine;
@@ -505,6 +581,29 @@ auto Affine2DEstimator<T>::estimate(const Matrix<T, rows, cols> &src,
         TL_ASSERT(src.rows() == dst.rows(), "Different matrix sizes. Size src = {} and size dst = {}", src.rows(), dst.rows());
         TL_ASSERT(src.rows() >= 3 , "Invalid number of points: {} < {}", src.rows(), 3);
 
+        if (precision == Precision::fast) {
+
+            /// Centered normal equations: A = C * G^-1
+            auto solver = [](const Matrix<double, 2, 2> &gram,
+                             const Matrix<double, 2, 2> &cross,
+                             size_t) -> Matrix<double, 2, 2> {
+                bool invertible = false;
+                Matrix<double, 2, 2> gram_inverse = gram.inverse(&invertible);
+                TL_ASSERT(invertible, "Degenerate configuration of points");
+                return cross * gram_inverse;
+            };
+
+            Matrix<double, 2, 3> transform = internal::mixed_precision_estimate<2>(src, dst, solver);
+
+            for (size_t r = 0; r < 2; r++) {
+                for (size_t c = 0; c < 3; c++) {
+                    affine(r, c) = static_cast<T>(transform(r, c));
+                }
+            }
+
+            return affine;
+        }
+
         size_t size = src.rows() * 2;
 
         Matrix<double> A(size, 6, 0);
@@ -545,7 +644,8 @@ auto Affine2DEstimator<T>::estimate(const Matrix<T, rows, cols> &src,
 
 template<typename T>
 auto Affine2DEstimator<T>::estimate(const std::vector<Point<T>> &src, 
-                                    const std::vector<Point<T>> &dst) -> Affine<T, 2>
+                                    const std::vector<Point<T>> &dst,
+                                    Precision precision) -> Affine<T, 2>
 {
     TL_ASSERT(src.size() == dst.size(), "Size of origin and destination points different");
 
@@ -560,7 +660,7 @@ auto Affine2DEstimator<T>::estimate(const std::vector<Point<T>> &src,
         dst_mat[r][1] = dst[r].y;
     }
 
-    return Affine2DEstimator<T>::estimate(src_mat, dst_mat);
+    return Affine2DEstimator<T>::estimate(src_mat, dst_mat, precision);
 }
 
 
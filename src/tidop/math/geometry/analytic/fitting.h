@@ -0,0 +1,1323 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/geometry/entities/point.h"
+#include "tidop/math/algebra/eigen_batch.h"
+#include "tidop/math/geometry/analytic/line.h"
+#include "tidop/math/geometry/analytic/plane.h"
+#include "tidop/math/geometry/analytic/sphere.h"
+#include "tidop/math/geometry/ransac.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Geometry
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+/// Points evaluated per block in the residual computation
+constexpr size_t fitting_block_size = 256;
+/// Subsets fitted by each task of the batch fitting
+constexpr size_t fitting_batch_block_size = 16;
+
+template<typename T>
+inline auto fitting_sqrt(T value) -> T
+{
+    return std::sqrt(value);
+}
+
+template<typename T>
+inline auto fitting_max(T value1, T value2) -> T
+{
+    return std::max(value1, value2);
+}
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+inline auto fitting_sqrt(const Packed<T> &value) -> Packed<T>
+{
+    return squareRoot(value);
+}
+
+template<typename T>
+inline auto fitting_max(const Packed<T> &value1, const Packed<T> &value2) -> Packed<T>
+{
+    return internal::max(value1, value2);
+}
+
+#endif
+
+/*!
+ * \brief Squared residual of a plane
+ * The same code is used for scalars and packed values
+ */
+template<typename T>
+struct PlaneResidual
+{
+    T nx, ny, nz, d;
+
+    template<typename V>
+    auto operator()(const V &x, const V &y, const V &z) const -> V
+    {
+        V residual = x * nx + y * ny + z * nz + d;
+        return residual * residual;
+    }
+};
+
+/*!
+ * \brief Squared distance to a line with unit direction
+ */
+template<typename T>
+struct LineResidual
+{
+    T ox, oy, oz, ux, uy, uz;
+
+    template<typename V>
+    auto operator()(const V &x, const V &y, const V &z) const -> V
+    {
+        V vx = x - ox;
+        V vy = y - oy;
+        V vz = z - oz;
+        V t = vx * ux + vy * uy + vz * uz;
+        return fitting_max(vx * vx + vy * vy + vz * vz - t * t, V(0));
+    }
+};
+
+/*!
+ * \brief Squared distance to the surface of a sphere
+ */
+template<typename T>
+struct SphereResidual
+{
+    T cx, cy, cz, r;
+
+    template<typename V>
+    auto operator()(const V &x, const V &y, const V &z) const -> V
+    {
+        V dx = x - cx;
+        V dy = y - cy;
+        V dz = z - cz;
+        V residual = fitting_sqrt(dx * dx + dy * dy + dz * dz) - r;
+        return residual * residual;
+    }
+};
+
+template<typename T, typename Residual>
+void squared_residuals_cpp(const Residual &residual,
+                           const T *x, const T *y, const T *z,
+                           T *out, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        out[i] = residual(x[i], y[i], z[i]);
+    }
+}
+
+template<typename T, typename Residual>
+auto squared_residuals(const Residual &residual,
+                       const T *x, const T *y, const T *z,
+                       T *out, size_t size) -> std::enable_if_t<is_simd_transform_type<T>::value, void>
+{
+#ifdef TL_HAVE_SIMD_INTRINSICS
+    Packed<T> packed_x;
+    Packed<T> packed_y;
+    Packed<T> packed_z;
+
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = (size / packed_size) * packed_size;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+        packed_x.loadUnaligned(&x[i]);
+        packed_y.loadUnaligned(&y[i]);
+        packed_z.loadUnaligned(&z[i]);
+        residual(packed_x, packed_y, packed_z).storeUnaligned(&out[i]);
+    }
+
+    squared_residuals_cpp(residual, x, y, z, out, max_vector, size);
+#else
+    squared_residuals_cpp(residual, x, y, z, out, 0, size);
+#endif
+}
+
+template<typename T, typename Residual>
+auto squared_residuals(const Residual &residual,
+                       const T *x, const T *y, const T *z,
+                       T *out, size_t size) -> std::enable_if_t<!is_simd_transform_type<T>::value, void>
+{
+    squared_residuals_cpp(residual, x, y, z, out, 0, size);
+}
+
+/*!
+ * \brief Centroid and covariance matrix (upper triangle) of a set of points
+ * Two passes, the covariance is accumulated from the centered coordinates
+ */
+template<typename T>
+void centroid_covariance(const T *x, const T *y, const T *z, size_t size,
+                         T centroid[3], T covariance[6])
+{
+    T sx = 0;
+    T sy = 0;
+    T sz = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        sx += x[i];
+        sy += y[i];
+        sz += z[i];
+    }
+
+    T inv_size = size > 0 ? consts::one<T> / static_cast<T>(size) : consts::zero<T>;
+    centroid[0] = sx * inv_size;
+    centroid[1] = sy * inv_size;
+    centroid[2] = sz * inv_size;
+
+    T xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        T dx = x[i] - centroid[0];
+        T dy = y[i] - centroid[1];
+        T dz = z[i] - centroid[2];
+        xx += dx * dx;
+        xy += dx * dy;
+        xz += dx * dz;
+        yy += dy * dy;
+        yz += dy * dz;
+        zz += dz * dz;
+    }
+
+    covariance[0] = xx * inv_size;
+    covariance[1] = xy * inv_size;
+    covariance[2] = xz * inv_size;
+    covariance[3] = yy * inv_size;
+    covariance[4] = yz * inv_size;
+    covariance[5] = zz * inv_size;
+}
+
+/*!
+ * \brief Centroids and covariance matrices of the subsets of a point cloud
+ * The result is stored as separate arrays (cx, cy, cz, a00, a01, a02, a11, a12, a22)
+ */
+template<typename T>
+void batch_centroid_covariance(const T *x, const T *y, const T *z,
+                               const size_t *offsets, size_t count,
+                               std::array<std::vector<T>, 9> &moments)
+{
+    for (auto &moment : moments)
+        moment.resize(count);
+
+    size_t blocks = (count + fitting_batch_block_size - 1) / fitting_batch_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * fitting_batch_block_size;
+        size_t end = std::min(ini + fitting_batch_block_size, count);
+        for (size_t i = ini; i < end; i++) {
+            size_t offset = offsets[i];
+            T centroid[3];
+            T covariance[6];
+            centroid_covariance(&x[offset], &y[offset], &z[offset], offsets[i + 1] - offset,
+                                centroid, covariance);
+            for (size_t j = 0; j < 3; j++)
+                moments[j][i] = centroid[j];
+            for (size_t j = 0; j < 6; j++)
+                moments[j + 3][i] = covariance[j];
+        }
+    });
+}
+
+/*!
+ * \brief Solves a 4x4 linear system by Gaussian elimination with partial pivoting
+ * \return false if the matrix is singular
+ */
+template<typename T>
+auto solve_4x4(T a[4][4], T b[4], T x[4]) -> bool
+{
+    T max_element = 0;
+    for (size_t r = 0; r < 4; r++)
+        for (size_t c = 0; c < 4; c++)
+            max_element = std::max(max_element, std::abs(a[r][c]));
+
+    T tolerance = max_element * std::numeric_limits<T>::epsilon() * 16;
+
+    for (size_t c = 0; c < 4; c++) {
+
+        size_t pivot = c;
+        for (size_t r = c + 1; r < 4; r++) {
+            if (std::abs(a[r][c]) > std::abs(a[pivot][c])) pivot = r;
+        }
+
+        if (!(std::abs(a[pivot][c]) > tolerance)) return false;
+
+        if (pivot != c) {
+            std::swap(a[pivot], a[c]);
+            std::swap(b[pivot], b[c]);
+        }
+
+        for (size_t r = c + 1; r < 4; r++) {
+            T factor = a[r][c] / a[c][c];
+            for (size_t k = c; k < 4; k++)
+                a[r][k] -= factor * a[c][k];
+            b[r] -= factor * b[c];
+        }
+    }
+
+    for (size_t r = 4; r-- > 0;) {
+        T sum = b[r];
+        for (size_t k = r + 1; k < 4; k++)
+            sum -= a[r][k] * x[k];
+        x[r] = sum / a[r][r];
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Least squares sphere
+ *
+ * Algebraic fit of \f$ x^2 + y^2 + z^2 + D x + E y + F z + G = 0 \f$, refined
+ * with Gauss-Newton iterations on the geometric distance. The points are
+ * centered and scaled to unit mean distance for the conditioning of the
+ * normal equations.
+ * \param[in] geometric Refine the algebraic solution
+ */
+template<typename T>
+auto fit_sphere(const T *x, const T *y, const T *z, size_t size,
+                bool geometric, Sphere<T> &sphere) -> bool
+{
+    T centroid[3] = {0, 0, 0};
+    for (size_t i = 0; i < size; i++) {
+        centroid[0] += x[i];
+        centroid[1] += y[i];
+        centroid[2] += z[i];
+    }
+    for (auto &coordinate : centroid)
+        coordinate /= static_cast<T>(size);
+
+    T scale = 0;
+    for (size_t i = 0; i < size; i++) {
+        T dx = x[i] - centroid[0];
+        T dy = y[i] - centroid[1];
+        T dz = z[i] - centroid[2];
+        scale += dx * dx + dy * dy + dz * dz;
+    }
+    scale = std::sqrt(scale / static_cast<T>(size));
+
+    if (!(scale > 0)) return false;
+
+    T inv_scale = consts::one<T> / scale;
+
+    /* Algebraic fit */
+
+    T a[4][4] = {};
+    T b[4] = {};
+
+    for (size_t i = 0; i < size; i++) {
+        T row[4] = {(x[i] - centroid[0]) * inv_scale,
+                    (y[i] - centroid[1]) * inv_scale,
+                    (z[i] - centroid[2]) * inv_scale,
+                    consts::one<T>};
+        T rhs = -(row[0] * row[0] + row[1] * row[1] + row[2] * row[2]);
+        for (size_t r = 0; r < 4; r++) {
+            for (size_t c = r; c < 4; c++)
+                a[r][c] += row[r] * row[c];
+            b[r] += row[r] * rhs;
+        }
+    }
+
+    for (size_t r = 1; r < 4; r++)
+        for (size_t c = 0; c < r; c++)
+            a[r][c] = a[c][r];
+
+    T solution[4];
+    if (!solve_4x4(a, b, solution)) return false;
+
+    T params[4] = {-solution[0] / 2, -solution[1] / 2, -solution[2] / 2, 0};
+    T radius2 = params[0] * params[0] + params[1] * params[1] + params[2] * params[2] - solution[3];
+    if (!(radius2 > 0)) return false;
+    params[3] = std::sqrt(radius2);
+
+    /* Geometric refinement */
+
+    if (geometric) {
+
+        T tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+        T previous[4] = {params[0], params[1], params[2], params[3]};
+        T previous_cost = std::numeric_limits<T>::max();
+
+        for (int iteration = 0; iteration < 20; iteration++) {
+
+            T jtj[4][4] = {};
+            T jtr[4] = {};
+            T cost = 0;
+
+            for (size_t i = 0; i < size; i++) {
+                T dx = (x[i] - centroid[0]) * inv_scale - params[0];
+                T dy = (y[i] - centroid[1]) * inv_scale - params[1];
+                T dz = (z[i] - centroid[2]) * inv_scale - params[2];
+                T distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+                T residual = distance - params[3];
+                cost += residual * residual;
+                if (distance == 0) continue;
+                T j[4] = {-dx / distance, -dy / distance, -dz / distance, -consts::one<T>};
+                for (size_t r = 0; r < 4; r++) {
+                    for (size_t c = r; c < 4; c++)
+                        jtj[r][c] += j[r] * j[c];
+                    jtr[r] -= j[r] * residual;
+                }
+            }
+
+            if (cost >= previous_cost) {
+                std::copy(previous, previous + 4, params);
+                break;
+            }
+
+            std::copy(params, params + 4, previous);
+            previous_cost = cost;
+
+            for (size_t r = 1; r < 4; r++)
+                for (size_t c = 0; c < r; c++)
+                    jtj[r][c] = jtj[c][r];
+
+            T delta[4];
+            if (!solve_4x4(jtj, jtr, delta)) break;
+
+            T step = 0;
+            for (size_t k = 0; k < 4; k++) {
+                params[k] += delta[k];
+                step += delta[k] * delta[k];
+            }
+
+            if (std::sqrt(step) <= tolerance * std::abs(params[3])) break;
+        }
+    }
+
+    sphere = Sphere<T>({params[0] * scale + centroid[0],
+                        params[1] * scale + centroid[1],
+                        params[2] * scale + centroid[2]},
+                       std::abs(params[3]) * scale);
+
+    return true;
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+
+/*!
+ * \brief Least squares plane fitting
+ *
+ * The plane passes through the centroid of the points and its normal is the
+ * eigenvector of the smallest eigenvalue of the covariance matrix (principal
+ * component analysis). The points are given as separate coordinate arrays.
+ *
+ * estimateBatch fits a plane to each subset of a point cloud. The subsets are
+ * contiguous ranges defined by an offsets array of count + 1 elements, the
+ * subset i being [offsets[i], offsets[i + 1]). The covariance matrices are
+ * accumulated in parallel and decomposed with the batched 3x3 eigensolver.
+ *
+ * \code
+ * // Points of each segment stored contiguously
+ * std::vector<Plane<double>> planes = PlaneEstimator<double>::estimateBatch(x.data(), y.data(), z.data(),
+ *                                                                           offsets.data(), segments);
+ * \endcode
+ */
+template<typename T>
+class PlaneEstimator
+{
+
+public:
+
+    using value_type = T;
+    using model_type = Plane<T>;
+
+    enum
+    {
+        sample_size = 3
+    };
+
+public:
+
+    PlaneEstimator() = default;
+    ~PlaneEstimator() = default;
+
+    static auto estimate(const T *x, const T *y, const T *z, size_t size) -> Plane<T>;
+    static auto estimate(const std::vector<Point3<T>> &points) -> Plane<T>;
+
+    /*!
+     * \brief Plane of each subset
+     * Subsets with less than three points or collinear points get a default constructed plane
+     */
+    static auto estimateBatch(const T *x, const T *y, const T *z,
+                              const size_t *offsets, size_t count) -> std::vector<Plane<T>>;
+
+    /*!
+     * \brief Least squares fit without exceptions
+     * \return false if the points are degenerate
+     */
+    static auto fit(const T *x, const T *y, const T *z, size_t size, Plane<T> &plane) -> bool;
+
+    /*!
+     * \brief Plane through the three points of a minimal sample
+     */
+    static auto fitSample(const T *x, const T *y, const T *z, const size_t *sample, Plane<T> &plane) -> bool;
+
+    /*!
+     * \brief Squared distances from the points to the plane
+     */
+    static void squaredDistances(const Plane<T> &plane,
+                                 const T *x, const T *y, const T *z,
+                                 T *distances, size_t size);
+};
+
+
+/*!
+ * \brief Least squares line fitting
+ *
+ * The line passes through the centroid of the points with the direction of the
+ * eigenvector of the largest eigenvalue of the covariance matrix. The direction
+ * of the fitted line is a unit vector.
+ *
+ * estimateBatch works as PlaneEstimator::estimateBatch.
+ */
+template<typename T>
+class LineEstimator
+{
+
+public:
+
+    using value_type = T;
+    using model_type = Line<T>;
+
+    enum
+    {
+        sample_size = 2
+    };
+
+public:
+
+    LineEstimator() = default;
+    ~LineEstimator() = default;
+
+    static auto estimate(const T *x, const T *y, const T *z, size_t size) -> Line<T>;
+    static auto estimate(const std::vector<Point3<T>> &points) -> Line<T>;
+
+    /*!
+     * \brief Line of each subset
+     * Subsets with less than two different points get a default constructed line
+     */
+    static auto estimateBatch(const T *x, const T *y, const T *z,
+                              const size_t *offsets, size_t count) -> std::vector<Line<T>>;
+
+    static auto fit(const T *x, const T *y, const T *z, size_t size, Line<T> &line) -> bool;
+    static auto fitSample(const T *x, const T *y, const T *z, const size_t *sample, Line<T> &line) -> bool;
+    static void squaredDistances(const Line<T> &line,
+                                 const T *x, const T *y, const T *z,
+                                 T *distances, size_t size);
+};
+
+
+/*!
+ * \brief Least squares sphere fitting
+ *
+ * Algebraic fit (linear least squares) refined with Gauss-Newton iterations
+ * on the geometric distance to the surface. The minimal sample is the sphere
+ * through four points.
+ *
+ * estimateBatch works as PlaneEstimator::estimateBatch, the subsets are fitted
+ * in parallel.
+ */
+template<typename T>
+class SphereEstimator
+{
+
+public:
+
+    using value_type = T;
+    using model_type = Sphere<T>;
+
+    enum
+    {
+        sample_size = 4
+    };
+
+public:
+
+    SphereEstimator() = default;
+    ~SphereEstimator() = default;
+
+    static auto estimate(const T *x, const T *y, const T *z, size_t size) -> Sphere<T>;
+    static auto estimate(const std::vector<Point3<T>> &points) -> Sphere<T>;
+
+    /*!
+     * \brief Sphere of each subset
+     * Subsets with less than four points or coplanar points get a default constructed sphere
+     */
+    static auto estimateBatch(const T *x, const T *y, const T *z,
+                              const size_t *offsets, size_t count) -> std::vector<Sphere<T>>;
+
+    static auto fit(const T *x, const T *y, const T *z, size_t size, Sphere<T> &sphere) -> bool;
+    static auto fitSample(const T *x, const T *y, const T *z, const size_t *sample, Sphere<T> &sphere) -> bool;
+    static void squaredDistances(const Sphere<T> &sphere,
+                                 const T *x, const T *y, const T *z,
+                                 T *distances, size_t size);
+};
+
+
+/*!
+ * \brief Robust fitting of lines, planes and spheres (RANSAC, MSAC and LO-RANSAC)
+ *
+ * Hypotheses are estimated from minimal samples and scored with the
+ * properties of RansacProperties. The threshold is the maximum distance from an
+ * inlier to the model. Each new best model is refined with least squares over
+ * its inliers (local optimization) and the final model is fitted to all the
+ * inliers. The sequential probability ratio test is not used.
+ *
+ * estimateBatch fits a model to each subset of a point cloud (see
+ * PlaneEstimator::estimateBatch) in parallel. The seed of subset i is
+ * properties.seed + i, so the result does not depend on the number of threads.
+ *
+ * \code
+ * RansacProperties properties;
+ * properties.threshold = 0.02;
+ * RobustFitting<PlaneEstimator<double>> fitting(properties);
+ * Plane<double> plane = fitting.estimate(x.data(), y.data(), z.data(), x.size());
+ *
+ * std::vector<Plane<double>> planes = fitting.estimateBatch(x.data(), y.data(), z.data(),
+ *                                                           offsets.data(), segments);
+ * \endcode
+ */
+template<typename Estimator>
+class RobustFitting
+{
+
+public:
+
+    using value_type = typename Estimator::value_type;
+    using model_type = typename Estimator::model_type;
+
+    enum
+    {
+        sample_size = Estimator::sample_size
+    };
+
+public:
+
+    RobustFitting() = default;
+    explicit RobustFitting(const RansacProperties &properties);
+    ~RobustFitting() = default;
+
+    auto properties() const -> const RansacProperties &;
+    void setProperties(const RansacProperties &properties);
+
+    auto estimate(const value_type *x, const value_type *y, const value_type *z, size_t size) -> model_type;
+    auto estimate(const std::vector<Point3<value_type>> &points) -> model_type;
+
+    /*!
+     * \brief Robust fit of each subset
+     * Subsets without a valid model get a default constructed model and no inliers
+     */
+    auto estimateBatch(const value_type *x, const value_type *y, const value_type *z,
+                       const size_t *offsets, size_t count) -> std::vector<model_type>;
+
+    /*!
+     * \brief Inlier mask of the last estimation
+     */
+    auto inliers() const -> const std::vector<bool> &;
+    auto inliersCount() const -> size_t;
+
+    /*!
+     * \brief Number of inliers of each subset in the last batch estimation
+     */
+    auto batchInliersCount() const -> const std::vector<size_t> &;
+
+    /*!
+     * \brief Number of hypotheses evaluated in the last estimation
+     */
+    auto iterations() const -> size_t;
+
+private:
+
+    struct Score
+    {
+        double cost{std::numeric_limits<double>::max()};
+        size_t inliers{0};
+    };
+
+    auto run(model_type &model) -> bool;
+    auto evaluate(const model_type &model, double bestCost) const -> Score;
+    auto refit(const model_type &model, model_type &refined) -> bool;
+    void localOptimization(model_type &model, Score &score);
+    auto adaptiveIterations(size_t inliers) const -> size_t;
+
+private:
+
+    RansacProperties mProperties;
+    const value_type *mX{nullptr};
+    const value_type *mY{nullptr};
+    const value_type *mZ{nullptr};
+    size_t mSize{0};
+    std::array<std::vector<value_type>, 3> mInlierPoints;
+    std::vector<bool> mInliers;
+    size_t mInliersCount{0};
+    std::vector<size_t> mBatchInliers;
+    size_t mIterations{0};
+};
+
+
+
+/* PlaneEstimator implementation */
+
+template<typename T>
+auto PlaneEstimator<T>::estimate(const T *x, const T *y, const T *z, size_t size) -> Plane<T>
+{
+    TL_ASSERT(size >= sample_size, "Invalid number of points: {} < {}", size, static_cast<size_t>(sample_size));
+
+    Plane<T> plane;
+    bool valid = fit(x, y, z, size, plane);
+    TL_ASSERT(valid, "Degenerate configuration of points");
+
+    return plane;
+}
+
+template<typename T>
+auto PlaneEstimator<T>::estimate(const std::vector<Point3<T>> &points) -> Plane<T>
+{
+    std::vector<T> x(points.size());
+    std::vector<T> y(points.size());
+    std::vector<T> z(points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+
+    return estimate(x.data(), y.data(), z.data(), points.size());
+}
+
+template<typename T>
+auto PlaneEstimator<T>::estimateBatch(const T *x, const T *y, const T *z,
+                                      const size_t *offsets, size_t count) -> std::vector<Plane<T>>
+{
+    std::array<std::vector<T>, 9> moments;
+    internal::batch_centroid_covariance(x, y, z, offsets, count, moments);
+
+    std::array<std::vector<T>, 6> eigen;
+    for (auto &values : eigen)
+        values.resize(count);
+
+    eigenSymmetric3x3(moments[3].data(), moments[4].data(), moments[5].data(),
+                      moments[6].data(), moments[7].data(), moments[8].data(),
+                      eigen[0].data(), eigen[1].data(), eigen[2].data(),
+                      eigen[3].data(), eigen[4].data(), eigen[5].data(),
+                      count);
+
+    std::vector<Plane<T>> planes(count);
+
+    for (size_t i = 0; i < count; i++) {
+        /// Collinear points
+        if (offsets[i + 1] - offsets[i] < sample_size ||
+            !(eigen[1][i] > std::numeric_limits<T>::epsilon() * eigen[2][i])) continue;
+        planes[i] = Plane<T>(Vector<T, 3>{moments[0][i], moments[1][i], moments[2][i]},
+                             Vector<T, 3>{eigen[3][i], eigen[4][i], eigen[5][i]});
+    }
+
+    return planes;
+}
+
+template<typename T>
+auto PlaneEstimator<T>::fit(const T *x, const T *y, const T *z, size_t size, Plane<T> &plane) -> bool
+{
+    if (size < sample_size) return false;
+
+    T centroid[3];
+    T covariance[6];
+    internal::centroid_covariance(x, y, z, size, centroid, covariance);
+
+    T lambda[3];
+    T normal[3];
+    internal::eigen_symmetric_3x3(covariance[0], covariance[1], covariance[2],
+                                  covariance[3], covariance[4], covariance[5],
+                                  lambda, normal);
+
+    if (!(lambda[1] > std::numeric_limits<T>::epsilon() * lambda[2])) return false;
+
+    plane = Plane<T>(Vector<T, 3>{centroid[0], centroid[1], centroid[2]},
+                     Vector<T, 3>{normal[0], normal[1], normal[2]});
+
+    return true;
+}
+
+template<typename T>
+auto PlaneEstimator<T>::fitSample(const T *x, const T *y, const T *z, const size_t *sample, Plane<T> &plane) -> bool
+{
+    T ux = x[sample[1]] - x[sample[0]];
+    T uy = y[sample[1]] - y[sample[0]];
+    T uz = z[sample[1]] - z[sample[0]];
+    T vx = x[sample[2]] - x[sample[0]];
+    T vy = y[sample[2]] - y[sample[0]];
+    T vz = z[sample[2]] - z[sample[0]];
+
+    T nx = uy * vz - uz * vy;
+    T ny = uz * vx - ux * vz;
+    T nz = ux * vy - uy * vx;
+
+    T normal2 = nx * nx + ny * ny + nz * nz;
+    T u2 = ux * ux + uy * uy + uz * uz;
+    T v2 = vx * vx + vy * vy + vz * vz;
+
+    if (!(normal2 > std::numeric_limits<T>::epsilon() * u2 * v2)) return false;
+
+    plane = Plane<T>(Vector<T, 3>{x[sample[0]], y[sample[0]], z[sample[0]]},
+                     Vector<T, 3>{nx, ny, nz});
+
+    return true;
+}
+
+template<typename T>
+void PlaneEstimator<T>::squaredDistances(const Plane<T> &plane,
+                                         const T *x, const T *y, const T *z,
+                                         T *distances, size_t size)
+{
+    Vector<T, 3> normal = plane.normal();
+    internal::PlaneResidual<T> residual{normal[0], normal[1], normal[2], plane.d()};
+    internal::squared_residuals(residual, x, y, z, distances, size);
+}
+
+
+
+/* LineEstimator implementation */
+
+template<typename T>
+auto LineEstimator<T>::estimate(const T *x, const T *y, const T *z, size_t size) -> Line<T>
+{
+    TL_ASSERT(size >= sample_size, "Invalid number of points: {} < {}", size, static_cast<size_t>(sample_size));
+
+    Line<T> line;
+    bool valid = fit(x, y, z, size, line);
+    TL_ASSERT(valid, "Degenerate configuration of points");
+
+    return line;
+}
+
+template<typename T>
+auto LineEstimator<T>::estimate(const std::vector<Point3<T>> &points) -> Line<T>
+{
+    std::vector<T> x(points.size());
+    std::vector<T> y(points.size());
+    std::vector<T> z(points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+
+    return estimate(x.data(), y.data(), z.data(), points.size());
+}
+
+template<typename T>
+auto LineEstimator<T>::estimateBatch(const T *x, const T *y, const T *z,
+                                     const size_t *offsets, size_t count) -> std::vector<Line<T>>
+{
+    std::array<std::vector<T>, 9> moments;
+    internal::batch_centroid_covariance(x, y, z, offsets, count, moments);
+
+    /// The eigenvector of the smallest eigenvalue of -C is the principal direction
+    for (size_t j = 3; j < 9; j++) {
+        for (auto &value : moments[j])
+            value = -value;
+    }
+
+    std::array<std::vector<T>, 6> eigen;
+    for (auto &values : eigen)
+        values.resize(count);
+
+    eigenSymmetric3x3(moments[3].data(), moments[4].data(), moments[5].data(),
+                      moments[6].data(), moments[7].data(), moments[8].data(),
+                      eigen[0].data(), eigen[1].data(), eigen[2].data(),
+                      eigen[3].data(), eigen[4].data(), eigen[5].data(),
+                      count);
+
+    std::vector<Line<T>> lines(count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (offsets[i + 1] - offsets[i] < sample_size || !(eigen[0][i] < 0)) continue;
+        lines[i] = Line<T>(Vector<T, 3>{moments[0][i], moments[1][i], moments[2][i]},
+                           Vector<T, 3>{eigen[3][i], eigen[4][i], eigen[5][i]});
+    }
+
+    return lines;
+}
+
+template<typename T>
+auto LineEstimator<T>::fit(const T *x, const T *y, const T *z, size_t size, Line<T> &line) -> bool
+{
+    if (size < sample_size) return false;
+
+    T centroid[3];
+    T covariance[6];
+    internal::centroid_covariance(x, y, z, size, centroid, covariance);
+
+    T lambda[3];
+    T direction[3];
+    internal::eigen_symmetric_3x3(-covariance[0], -covariance[1], -covariance[2],
+                                  -covariance[3], -covariance[4], -covariance[5],
+                                  lambda, direction);
+
+    /// All the points are equal
+    if (!(lambda[0] < 0)) return false;
+
+    line = Line<T>(Vector<T, 3>{centroid[0], centroid[1], centroid[2]},
+                   Vector<T, 3>{direction[0], direction[1], direction[2]});
+
+    return true;
+}
+
+template<typename T>
+auto LineEstimator<T>::fitSample(const T *x, const T *y, const T *z, const size_t *sample, Line<T> &line) -> bool
+{
+    T dx = x[sample[1]] - x[sample[0]];
+    T dy = y[sample[1]] - y[sample[0]];
+    T dz = z[sample[1]] - z[sample[0]];
+
+    T module = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (!(module > 0)) return false;
+
+    line = Line<T>(Vector<T, 3>{x[sample[0]], y[sample[0]], z[sample[0]]},
+                   Vector<T, 3>{dx / module, dy / module, dz / module});
+
+    return true;
+}
+
+template<typename T>
+void LineEstimator<T>::squaredDistances(const Line<T> &line,
+                                        const T *x, const T *y, const T *z,
+                                        T *distances, size_t size)
+{
+    Vector<T, 3> origin = line.getOrigin();
+    Vector<T, 3> direction = line.getDirection();
+    T module = static_cast<T>(direction.module());
+
+    internal::LineResidual<T> residual{origin[0], origin[1], origin[2],
+                                       direction[0] / module,
+                                       direction[1] / module,
+                                       direction[2] / module};
+    internal::squared_residuals(residual, x, y, z, distances, size);
+}
+
+
+
+/* SphereEstimator implementation */
+
+template<typename T>
+auto SphereEstimator<T>::estimate(const T *x, const T *y, const T *z, size_t size) -> Sphere<T>
+{
+    TL_ASSERT(size >= sample_size, "Invalid number of points: {} < {}", size, static_cast<size_t>(sample_size));
+
+    Sphere<T> sphere;
+    bool valid = fit(x, y, z, size, sphere);
+    TL_ASSERT(valid, "Degenerate configuration of points");
+
+    return sphere;
+}
+
+template<typename T>
+auto SphereEstimator<T>::estimate(const std::vector<Point3<T>> &points) -> Sphere<T>
+{
+    std::vector<T> x(points.size());
+    std::vector<T> y(points.size());
+    std::vector<T> z(points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+
+    return estimate(x.data(), y.data(), z.data(), points.size());
+}
+
+template<typename T>
+auto SphereEstimator<T>::estimateBatch(const T *x, const T *y, const T *z,
+                                       const size_t *offsets, size_t count) -> std::vector<Sphere<T>>
+{
+    std::vector<Sphere<T>> spheres(count);
+
+    size_t blocks = (count + internal::fitting_batch_block_size - 1) / internal::fitting_batch_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * internal::fitting_batch_block_size;
+        size_t end = std::min(ini + internal::fitting_batch_block_size, count);
+        for (size_t i = ini; i < end; i++) {
+            size_t offset = offsets[i];
+            Sphere<T> sphere;
+            if (fit(&x[offset], &y[offset], &z[offset], offsets[i + 1] - offset, sphere))
+                spheres[i] = sphere;
+        }
+    });
+
+    return spheres;
+}
+
+template<typename T>
+auto SphereEstimator<T>::fit(const T *x, const T *y, const T *z, size_t size, Sphere<T> &sphere) -> bool
+{
+    if (size < sample_size) return false;
+
+    return internal::fit_sphere(x, y, z, size, true, sphere);
+}
+
+template<typename T>
+auto SphereEstimator<T>::fitSample(const T *x, const T *y, const T *z, const size_t *sample, Sphere<T> &sphere) -> bool
+{
+    T sample_x[4];
+    T sample_y[4];
+    T sample_z[4];
+
+    for (size_t i = 0; i < 4; i++) {
+        sample_x[i] = x[sample[i]];
+        sample_y[i] = y[sample[i]];
+        sample_z[i] = z[sample[i]];
+    }
+
+    /// The algebraic solution is exact for four points
+    return internal::fit_sphere(sample_x, sample_y, sample_z, 4, false, sphere);
+}
+
+template<typename T>
+void SphereEstimator<T>::squaredDistances(const Sphere<T> &sphere,
+                                          const T *x, const T *y, const T *z,
+                                          T *distances, size_t size)
+{
+    Vector<T, 3> center = sphere.center();
+    internal::SphereResidual<T> residual{center[0], center[1], center[2], sphere.radius()};
+    internal::squared_residuals(residual, x, y, z, distances, size);
+}
+
+
+
+/* RobustFitting implementation */
+
+template<typename Estimator>
+RobustFitting<Estimator>::RobustFitting(const RansacProperties &properties)
+  : mProperties(properties)
+{
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::properties() const -> const RansacProperties &
+{
+    return mProperties;
+}
+
+template<typename Estimator>
+void RobustFitting<Estimator>::setProperties(const RansacProperties &properties)
+{
+    mProperties = properties;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::estimate(const value_type *x,
+                                        const value_type *y,
+                                        const value_type *z,
+                                        size_t size) -> model_type
+{
+    model_type model;
+
+    try {
+
+        TL_ASSERT(size >= sample_size, "Invalid number of points: {} < {}", size, static_cast<size_t>(sample_size));
+
+        mX = x;
+        mY = y;
+        mZ = z;
+        mSize = size;
+
+        bool valid = run(model);
+        TL_ASSERT(valid, "No valid model found");
+
+        mInliers.assign(mSize, false);
+        mInliersCount = 0;
+
+        std::array<value_type, internal::fitting_block_size> distances;
+        value_type threshold2 = static_cast<value_type>(mProperties.threshold * mProperties.threshold);
+
+        for (size_t ini = 0; ini < mSize; ini += internal::fitting_block_size) {
+            size_t block = std::min(internal::fitting_block_size, mSize - ini);
+            Estimator::squaredDistances(model, &mX[ini], &mY[ini], &mZ[ini], distances.data(), block);
+            for (size_t i = 0; i < block; i++) {
+                if (distances[i] <= threshold2) {
+                    mInliers[ini + i] = true;
+                    mInliersCount++;
+                }
+            }
+        }
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return model;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::estimate(const std::vector<Point3<value_type>> &points) -> model_type
+{
+    std::vector<value_type> x(points.size());
+    std::vector<value_type> y(points.size());
+    std::vector<value_type> z(points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+
+    return estimate(x.data(), y.data(), z.data(), points.size());
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::estimateBatch(const value_type *x,
+                                             const value_type *y,
+                                             const value_type *z,
+                                             const size_t *offsets,
+                                             size_t count) -> std::vector<model_type>
+{
+    std::vector<model_type> models(count);
+    mBatchInliers.assign(count, 0);
+
+    size_t blocks = (count + internal::fitting_batch_block_size - 1) / internal::fitting_batch_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+
+        RobustFitting<Estimator> fitting(mProperties);
+
+        size_t ini = block * internal::fitting_batch_block_size;
+        size_t end = std::min(ini + internal::fitting_batch_block_size, count);
+
+        for (size_t i = ini; i < end; i++) {
+
+            size_t offset = offsets[i];
+            size_t size = offsets[i + 1] - offset;
+            if (size < sample_size) continue;
+
+            fitting.mProperties.seed = mProperties.seed + static_cast<unsigned int>(i);
+            fitting.mX = &x[offset];
+            fitting.mY = &y[offset];
+            fitting.mZ = &z[offset];
+            fitting.mSize = size;
+
+            model_type model;
+            if (fitting.run(model)) {
+                models[i] = model;
+                mBatchInliers[i] = fitting.evaluate(model, std::numeric_limits<double>::max()).inliers;
+            }
+        }
+    });
+
+    return models;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::inliers() const -> const std::vector<bool> &
+{
+    return mInliers;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::inliersCount() const -> size_t
+{
+    return mInliersCount;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::batchInliersCount() const -> const std::vector<size_t> &
+{
+    return mBatchInliers;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::iterations() const -> size_t
+{
+    return mIterations;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::run(model_type &model) -> bool
+{
+    internal::RansacSampler sampler(mSize, sample_size, mProperties.prosac,
+                                    mProperties.maxIterations, mProperties.seed);
+
+    std::array<size_t, sample_size> sample;
+    Score best;
+    bool valid = false;
+    size_t max_iterations = mProperties.maxIterations;
+
+    for (mIterations = 0; mIterations < max_iterations; mIterations++) {
+
+        sampler.sample(sample.data());
+
+        model_type hypothesis;
+        if (!Estimator::fitSample(mX, mY, mZ, sample.data(), hypothesis)) continue;
+
+        Score score = evaluate(hypothesis, best.cost);
+        if (score.cost >= best.cost) continue;
+
+        model = hypothesis;
+        best = score;
+        valid = true;
+
+        if (mProperties.localOptimization)
+            localOptimization(model, best);
+
+        max_iterations = std::min(max_iterations, adaptiveIterations(best.inliers));
+    }
+
+    if (valid && mProperties.refine) {
+        model_type refined;
+        if (refit(model, refined)) {
+            Score score = evaluate(refined, best.cost);
+            if (score.cost <= best.cost) model = refined;
+        }
+    }
+
+    return valid;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::evaluate(const model_type &model, double bestCost) const -> Score
+{
+    Score score;
+    score.cost = 0.;
+
+    std::array<value_type, internal::fitting_block_size> distances;
+    value_type threshold2 = static_cast<value_type>(mProperties.threshold * mProperties.threshold);
+    bool msac = mProperties.scoring == RansacScoring::msac;
+
+    for (size_t ini = 0; ini < mSize; ini += internal::fitting_block_size) {
+
+        size_t block = std::min(internal::fitting_block_size, mSize - ini);
+        Estimator::squaredDistances(model, &mX[ini], &mY[ini], &mZ[ini], distances.data(), block);
+
+        for (size_t i = 0; i < block; i++) {
+            if (distances[i] <= threshold2) {
+                score.inliers++;
+                if (msac) score.cost += static_cast<double>(distances[i]);
+            } else {
+                score.cost += msac ? static_cast<double>(threshold2) : 1.;
+            }
+        }
+
+        /// The hypothesis can not improve the best model
+        if (score.cost >= bestCost) break;
+    }
+
+    return score;
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::refit(const model_type &model, model_type &refined) -> bool
+{
+    std::array<value_type, internal::fitting_block_size> distances;
+    value_type threshold2 = static_cast<value_type>(mProperties.threshold * mProperties.threshold);
+
+    for (auto &coordinates : mInlierPoints)
+        coordinates.clear();
+
+    for (size_t ini = 0; ini < mSize; ini += internal::fitting_block_size) {
+        size_t block = std::min(internal::fitting_block_size, mSize - ini);
+        Estimator::squaredDistances(model, &mX[ini], &mY[ini], &mZ[ini], distances.data(), block);
+        for (size_t i = 0; i < block; i++) {
+            if (distances[i] <= threshold2) {
+                mInlierPoints[0].push_back(mX[ini + i]);
+                mInlierPoints[1].push_back(mY[ini + i]);
+                mInlierPoints[2].push_back(mZ[ini + i]);
+            }
+        }
+    }
+
+    return Estimator::fit(mInlierPoints[0].data(), mInlierPoints[1].data(), mInlierPoints[2].data(),
+                          mInlierPoints[0].size(), refined);
+}
+
+template<typename Estimator>
+void RobustFitting<Estimator>::localOptimization(model_type &model, Score &score)
+{
+    for (size_t i = 0; i < mProperties.loIterations; i++) {
+
+        model_type refined;
+        if (!refit(model, refined)) break;
+
+        Score refined_score = evaluate(refined, score.cost);
+        if (refined_score.cost >= score.cost) break;
+
+        model = refined;
+        score = refined_score;
+    }
+}
+
+template<typename Estimator>
+auto RobustFitting<Estimator>::adaptiveIterations(size_t inliers) const -> size_t
+{
+    double inlier_ratio = static_cast<double>(inliers) / static_cast<double>(mSize);
+    double probability = std::pow(inlier_ratio, static_cast<double>(sample_size));
+
+    if (probability >= 1.) return 0;
+    if (probability <= 0.) return mProperties.maxIterations;
+
+    double iterations = std::log(1. - mProperties.confidence) / std::log(1. - probability);
+
+    return static_cast<size_t>(std::min(std::ceil(iterations), static_cast<double>(mProperties.maxIterations)));
+}
+
+
+/*! \} */ // end of Geometry
+
+/*! \} */ // end of Math
+
+} // End namespace tl
@@ -30,6 +30,21 @@
 namespace tl
 {
 
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Geometry
+ *  \{
+ */
+
+/*!
+ * \brief Line in 3D space
+ *
+ * Line defined by a point and a direction vector:
+ * \f[ p(\lambda) = origin + \lambda \cdot direction \f]
+ */
 template <typename T>
 class Line
 {
@@ -46,12 +61,15 @@ public:
     ~Line() = default;
 
 public:
-    Vector<T, 3> evaluate(T lambda)
+    Vector<T, 3> evaluate(T lambda) const
     {
         return origin + direction * lambda;
     }
 
-    T distance(const Vector<T, 3>& point)
+    /*!
+     * \brief Distance from a point to the line
+     */
+    T distance(const Vector<T, 3>& point) const
     {
         T numModule = crossProduct(point - origin, direction).module();
         T directionModule = direction.module();
@@ -64,4 +82,8 @@ public:
 
 };
 
-}
\ No newline at end of file
+/*! \} */ // end of Geometry
+
+/*! \} */ // end of Math
+
+}
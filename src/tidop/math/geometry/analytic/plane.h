@@ -0,0 +1,125 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <cmath>
+
+#include "tidop/math/algebra/vector.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Geometry
+ *  \{
+ */
+
+/*!
+ * \brief Plane in 3D space
+ *
+ * Plane in Hessian normal form:
+ * \f[ n \cdot p + d = 0 \f]
+ * with unit normal n. A default constructed plane has a null normal.
+ */
+template <typename T>
+class Plane
+{
+
+public:
+
+    Plane()
+      : mNormal{0, 0, 0},
+        mD(0)
+    {
+    }
+
+    /*!
+     * \brief Plane from its normal vector and the independent term
+     * The normal vector is normalized
+     */
+    Plane(const Vector<T, 3> &normal, T d)
+      : mNormal(normal),
+        mD(d)
+    {
+        T module = static_cast<T>(mNormal.module());
+        if (module > 0) {
+            mNormal /= module;
+            mD /= module;
+        }
+    }
+
+    /*!
+     * \brief Plane through a point with the given normal
+     */
+    Plane(const Vector<T, 3> &point, const Vector<T, 3> &normal)
+      : Plane(normal, -static_cast<T>(normal.dotProduct(point)))
+    {
+    }
+
+    ~Plane() = default;
+
+    auto normal() const -> Vector<T, 3>
+    {
+        return mNormal;
+    }
+
+    auto d() const -> T
+    {
+        return mD;
+    }
+
+    /*!
+     * \brief Signed distance from a point to the plane
+     * Positive on the side the normal points to
+     */
+    auto signedDistance(const Vector<T, 3> &point) const -> T
+    {
+        return mNormal[0] * point[0] + mNormal[1] * point[1] + mNormal[2] * point[2] + mD;
+    }
+
+    auto distance(const Vector<T, 3> &point) const -> T
+    {
+        return std::abs(signedDistance(point));
+    }
+
+private:
+
+    Vector<T, 3> mNormal;
+    T mD;
+
+};
+
+/*! \} */ // end of Geometry
+
+/*! \} */ // end of Math
+
+} // End namespace tl
@@ -0,0 +1,107 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <cmath>
+
+#include "tidop/math/algebra/vector.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Geometry
+ *  \{
+ */
+
+/*!
+ * \brief Sphere in 3D space
+ */
+template <typename T>
+class Sphere
+{
+
+public:
+
+    Sphere()
+      : mCenter{0, 0, 0},
+        mRadius(0)
+    {
+    }
+
+    Sphere(const Vector<T, 3> &center, T radius)
+      : mCenter(center),
+        mRadius(radius)
+    {
+    }
+
+    ~Sphere() = default;
+
+    auto center() const -> Vector<T, 3>
+    {
+        return mCenter;
+    }
+
+    auto radius() const -> T
+    {
+        return mRadius;
+    }
+
+    /*!
+     * \brief Signed distance from a point to the surface of the sphere
+     * Negative inside the sphere
+     */
+    auto signedDistance(const Vector<T, 3> &point) const -> T
+    {
+        T dx = point[0] - mCenter[0];
+        T dy = point[1] - mCenter[1];
+        T dz = point[2] - mCenter[2];
+        return std::sqrt(dx * dx + dy * dy + dz * dz) - mRadius;
+    }
+
+    auto distance(const Vector<T, 3> &point) const -> T
+    {
+        return std::abs(signedDistance(point));
+    }
+
+private:
+
+    Vector<T, 3> mCenter;
+    T mRadius;
+
+};
+
+/*! \} */ // end of Geometry
+
+/*! \} */ // end of Math
+
+} // End namespace tl
@@ -88,7 +88,7 @@ void helmert(const Matrix<T, rows, cols> &src,
         Vector<double> C = svd.solve(B);
 
         affine(0, 0) = C[0];
-        affine(0, 1) = C[1];
+        affine(0, 1) = -C[1];
         affine(0, 2) = C[2];
         affine(1, 0) = C[1];
         affine(1, 1) = C[0];
@@ -150,10 +150,66 @@ void helmert(const Matrix<T, rows, cols> &src,
     }
 }
 
+template<typename T, size_t rows, size_t cols>
+void helmert(const Matrix<T, rows, cols> &src,
+             const Matrix<T, rows, cols> &dst, Affine<T, 2> &affine,
+             Precision precision)
+{
+    if (precision == Precision::exact) {
+        helmert(src, dst, affine);
+        return;
+    }
+
+    try {
+
+        TL_ASSERT(src.rows() == dst.rows(), "Different matrix sizes. Size src = {} and size dst = {}", src.rows(), dst.rows());
+        TL_ASSERT(src.rows() >= 2, "Invalid number of points: {} < {}", src.rows(), 2);
+
+        /// a = (Cxx + Cyy) / tr(G), b = (Cyx - Cxy) / tr(G)
+        auto solver = [](const Matrix<double, 2, 2> &gram,
+                         const Matrix<double, 2, 2> &cross,
+                         size_t) -> Matrix<double, 2, 2> {
+            double trace = gram(0, 0) + gram(1, 1);
+            TL_ASSERT(trace > 0., "Degenerate configuration of points");
+            double a = (cross(0, 0) + cross(1, 1)) / trace;
+            double b = (cross(1, 0) - cross(0, 1)) / trace;
+            return Matrix<double, 2, 2>{{a, -b},
+                                        {b, a}};
+        };
+
+        Matrix<double, 2, 3> transform = mixed_precision_estimate<2>(src, dst, solver);
+
+        for (size_t r = 0; r < 2; r++) {
+            for (size_t c = 0; c < 3; c++) {
+                affine(r, c) = static_cast<T>(transform(r, c));
+            }
+        }
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+}
+
+/// The 3D estimator is linearized for small rotations and is always solved in double
+template<typename T, size_t rows, size_t cols>
+void helmert(const Matrix<T, rows, cols> &src,
+             const Matrix<T, rows, cols> &dst, Affine<T, 3> &affine,
+             Precision)
+{
+    helmert(src, dst, affine);
+}
+
 } /// end namespace internal
 
 /// \endcond
 
+/*!
+ * \brief Helmert (similarity) transform estimator
+ *
+ * Precision::fast solves the 2D transform from the centered moments in float
+ * with double accumulation and iterative refinement (see mixed_precision.h).
+ * The 3D estimator ignores the precision.
+ */
 template <typename T, size_t Dim>
 class HelmertEstimator
 {
@@ -169,12 +225,15 @@ public:
 
     template<size_t rows, size_t cols>
     static auto estimate(const Matrix<T, rows, cols> &src,
-                         const Matrix<T, rows, cols> &dst) -> Affine<T, Dim>;
+                         const Matrix<T, rows, cols> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, Dim>;
 
     static auto estimate(const std::vector<Point<T>> &src,
-                         const std::vector<Point<T>> &dst) -> Affine<T, Dim>;
+                         const std::vector<Point<T>> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, Dim>;
     static auto estimate(const std::vector<Point3<T>> &src,
-                         const std::vector<Point3<T>> &dst) -> Affine<T, Dim>;
+                         const std::vector<Point3<T>> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, Dim>;
 };
 
 
@@ -184,13 +243,14 @@ public:
 template<typename T, size_t Dim>
 template<size_t rows, size_t cols>
 auto HelmertEstimator<T, Dim>::estimate(const Matrix<T, rows, cols> &src, 
-                                        const Matrix<T, rows, cols> &dst) -> Affine<T, Dim>
+                                        const Matrix<T, rows, cols> &dst,
+                                        Precision precision) -> Affine<T, Dim>
 {
     Affine<T, Dim> affine;
 
     try {
 
-        internal::helmert(src, dst, affine);
+        internal::helmert(src, dst, affine, precision);
 
     } catch (...) {
         TL_THROW_EXCEPTION_WITH_NESTED("");
@@ -201,7 +261,8 @@ auto HelmertEstimator<T, Dim>::estimate(const Matrix<T, rows, cols> &src,
 
 template<typename T, size_t Dim>
 auto HelmertEstimator<T, Dim>::estimate(const std::vector<Point<T>> &src, 
-                                        const std::vector<Point<T>> &dst) -> Affine<T, Dim>
+                                        const std::vector<Point<T>> &dst,
+                                        Precision precision) -> Affine<T, Dim>
 {
     TL_ASSERT(src.size() == dst.size(), "Size of origin and destination points different");
 
@@ -216,12 +277,13 @@ auto HelmertEstimator<T, Dim>::estimate(const std::vector<Point<T>> &src,
         dst_mat[r][1] = dst[r].y;
     }
 
-    return HelmertEstimator<T, Dim>::estimate(src_mat, dst_mat);
+    return HelmertEstimator<T, Dim>::estimate(src_mat, dst_mat, precision);
 }
 
 template<typename T, size_t Dim>
 auto HelmertEstimator<T, Dim>::estimate(const std::vector<Point3<T>> &src, 
-                                        const std::vector<Point3<T>> &dst) -> Affine<T, Dim>
+                                        const std::vector<Point3<T>> &dst,
+                                        Precision precision) -> Affine<T, Dim>
 {
     TL_ASSERT(src.size() == dst.size(), "Size of origin and destination points different");
 
@@ -238,7 +300,7 @@ auto HelmertEstimator<T, Dim>::estimate(const std::vector<Point3<T>> &src,
         dst_mat[r][2] = dst[r].z;
     }
 
-    return HelmertEstimator<T, Dim>::estimate(src_mat, dst_mat);
+    return HelmertEstimator<T, Dim>::estimate(src_mat, dst_mat, precision);
 }
 
 
@@ -0,0 +1,286 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "tidop/math/math.h"
+#include "tidop/math/simd.h"
+#include "tidop/math/algebra/matrix.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Geometry
+ *  \{
+ */
+
+
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * Mixed precision estimation of affine models (Precision::fast)
+ *
+ * The estimators are solved from the second order moments of the centered
+ * points: the Gram matrix G of the source points and the cross matrix
+ * C = sum(dst * src^T). These bulk products are computed in float, with
+ * twice the SIMD lanes of double, and each block of partial sums is
+ * accumulated in double. The means are computed in double so that large
+ * georeferenced coordinates do not lose precision.
+ *
+ * The solution is improved with iterative refinement: the residuals
+ * e = dst - A * src of the current solution are evaluated in double and
+ * the estimator is solved again with C = A * G + sum(e * src^T). The
+ * float rounding of G cancels out and the refined solution matches the
+ * double one.
+ */
+
+/// Points converted to float and accumulated per block
+constexpr size_t mixed_precision_block_size = 128;
+/// Maximum number of refinement iterations
+constexpr int mixed_precision_refinement_iterations = 3;
+
+template<size_t Dim>
+struct MixedPrecisionMoments
+{
+    std::array<double, Dim> mean_src{};
+    std::array<double, Dim> mean_dst{};
+    Matrix<double, Dim, Dim> gram = Matrix<double, Dim, Dim>::zero();
+    Matrix<double, Dim, Dim> cross = Matrix<double, Dim, Dim>::zero();
+    size_t size{0};
+};
+
+template<size_t Dim>
+void mixed_precision_block_moments_cpp(const std::array<std::array<float, mixed_precision_block_size>, Dim> &src,
+                                       const std::array<std::array<float, mixed_precision_block_size>, Dim> &dst,
+                                       size_t ini, size_t end,
+                                       MixedPrecisionMoments<Dim> &moments)
+{
+    for (size_t r = 0; r < Dim; r++) {
+        for (size_t c = 0; c < Dim; c++) {
+            float gram = 0.f;
+            float cross = 0.f;
+            for (size_t i = ini; i < end; i++) {
+                gram += src[r][i] * src[c][i];
+                cross += dst[r][i] * src[c][i];
+            }
+            moments.gram(r, c) += static_cast<double>(gram);
+            moments.cross(r, c) += static_cast<double>(cross);
+        }
+    }
+}
+
+template<size_t Dim>
+void mixed_precision_block_moments(const std::array<std::array<float, mixed_precision_block_size>, Dim> &src,
+                                   const std::array<std::array<float, mixed_precision_block_size>, Dim> &dst,
+                                   size_t size,
+                                   MixedPrecisionMoments<Dim> &moments)
+{
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+    constexpr size_t packed_size = Packed<float>::size();
+    size_t max_vector = (size / packed_size) * packed_size;
+
+    std::array<Packed<float>, Dim * Dim> gram;
+    std::array<Packed<float>, Dim * Dim> cross;
+    gram.fill(Packed<float>(0.f));
+    cross.fill(Packed<float>(0.f));
+
+    std::array<Packed<float>, Dim> packed_src;
+    std::array<Packed<float>, Dim> packed_dst;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+
+        for (size_t c = 0; c < Dim; c++) {
+            packed_src[c].loadAligned(&src[c][i]);
+            packed_dst[c].loadAligned(&dst[c][i]);
+        }
+
+        for (size_t r = 0; r < Dim; r++) {
+            for (size_t c = r; c < Dim; c++)
+                gram[r * Dim + c] = internal::fmadd(packed_src[r], packed_src[c], gram[r * Dim + c]);
+            for (size_t c = 0; c < Dim; c++)
+                cross[r * Dim + c] = internal::fmadd(packed_dst[r], packed_src[c], cross[r * Dim + c]);
+        }
+    }
+
+    for (size_t r = 0; r < Dim; r++) {
+        for (size_t c = r; c < Dim; c++) {
+            double sum = static_cast<double>(gram[r * Dim + c].sum());
+            moments.gram(r, c) += sum;
+            if (c != r) moments.gram(c, r) += sum;
+        }
+        for (size_t c = 0; c < Dim; c++)
+            moments.cross(r, c) += static_cast<double>(cross[r * Dim + c].sum());
+    }
+
+    mixed_precision_block_moments_cpp(src, dst, max_vector, size, moments);
+
+#else
+
+    mixed_precision_block_moments_cpp(src, dst, 0, size, moments);
+
+#endif
+}
+
+/*!
+ * \brief Means in double and centered moments in float with double accumulation
+ */
+template<size_t Dim, typename MatrixType>
+auto mixed_precision_moments(const MatrixType &src, const MatrixType &dst) -> MixedPrecisionMoments<Dim>
+{
+    MixedPrecisionMoments<Dim> moments;
+    moments.size = src.rows();
+
+    for (size_t r = 0; r < moments.size; r++) {
+        for (size_t c = 0; c < Dim; c++) {
+            moments.mean_src[c] += static_cast<double>(src(r, c));
+            moments.mean_dst[c] += static_cast<double>(dst(r, c));
+        }
+    }
+
+    for (size_t c = 0; c < Dim; c++) {
+        moments.mean_src[c] /= static_cast<double>(moments.size);
+        moments.mean_dst[c] /= static_cast<double>(moments.size);
+    }
+
+    alignas(32) std::array<std::array<float, mixed_precision_block_size>, Dim> src_block;
+    alignas(32) std::array<std::array<float, mixed_precision_block_size>, Dim> dst_block;
+
+    for (size_t ini = 0; ini < moments.size; ini += mixed_precision_block_size) {
+
+        size_t block = std::min(mixed_precision_block_size, moments.size - ini);
+
+        for (size_t i = 0; i < block; i++) {
+            for (size_t c = 0; c < Dim; c++) {
+                src_block[c][i] = static_cast<float>(static_cast<double>(src(ini + i, c)) - moments.mean_src[c]);
+                dst_block[c][i] = static_cast<float>(static_cast<double>(dst(ini + i, c)) - moments.mean_dst[c]);
+            }
+        }
+
+        mixed_precision_block_moments<Dim>(src_block, dst_block, block, moments);
+    }
+
+    return moments;
+}
+
+/*!
+ * \brief sum(e * src^T) with the residuals e = dst - A * src of the centered points, in double
+ */
+template<size_t Dim, typename MatrixType>
+auto mixed_precision_residual_cross(const MatrixType &src,
+                                    const MatrixType &dst,
+                                    const MixedPrecisionMoments<Dim> &moments,
+                                    const Matrix<double, Dim, Dim> &a) -> Matrix<double, Dim, Dim>
+{
+    Matrix<double, Dim, Dim> cross = Matrix<double, Dim, Dim>::zero();
+
+    for (size_t i = 0; i < moments.size; i++) {
+
+        std::array<double, Dim> s;
+        for (size_t c = 0; c < Dim; c++)
+            s[c] = static_cast<double>(src(i, c)) - moments.mean_src[c];
+
+        for (size_t r = 0; r < Dim; r++) {
+            double residual = static_cast<double>(dst(i, r)) - moments.mean_dst[r];
+            for (size_t c = 0; c < Dim; c++)
+                residual -= a(r, c) * s[c];
+            for (size_t c = 0; c < Dim; c++)
+                cross(r, c) += residual * s[c];
+        }
+    }
+
+    return cross;
+}
+
+/*!
+ * \brief Mixed precision estimation with iterative refinement
+ * \param[in] solver Linear part of the model from the Gram and cross matrices
+ * \return Transformation matrix [A | t]
+ */
+template<size_t Dim, typename MatrixType, typename Solver>
+auto mixed_precision_estimate(const MatrixType &src,
+                              const MatrixType &dst,
+                              Solver solver) -> Matrix<double, Dim, Dim + 1>
+{
+    MixedPrecisionMoments<Dim> moments = mixed_precision_moments<Dim>(src, dst);
+
+    Matrix<double, Dim, Dim> a = solver(moments.gram, moments.cross, moments.size);
+
+    for (int iteration = 0; iteration < mixed_precision_refinement_iterations; iteration++) {
+
+        Matrix<double, Dim, Dim> residual_cross = mixed_precision_residual_cross(src, dst, moments, a);
+        Matrix<double, Dim, Dim> refined = solver(moments.gram, a * moments.gram + residual_cross, moments.size);
+
+        double correction = 0.;
+        double norm = 0.;
+        for (size_t r = 0; r < Dim; r++) {
+            for (size_t c = 0; c < Dim; c++) {
+                correction = std::max(correction, std::abs(refined(r, c) - a(r, c)));
+                norm = std::max(norm, std::abs(refined(r, c)));
+            }
+        }
+
+        a = refined;
+
+        if (correction <= 4. * std::numeric_limits<double>::epsilon() * norm) break;
+    }
+
+    Matrix<double, Dim, Dim + 1> transform;
+    for (size_t r = 0; r < Dim; r++) {
+        double translation = moments.mean_dst[r];
+        for (size_t c = 0; c < Dim; c++) {
+            transform(r, c) = a(r, c);
+            translation -= a(r, c) * moments.mean_src[c];
+        }
+        transform(r, Dim) = translation;
+    }
+
+    return transform;
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*! \} */ // end of Geometry
+
+/*! \} */ // end of Math
+
+} // End namespace tl
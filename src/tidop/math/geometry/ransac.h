@@ -0,0 +1,1059 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/algebra/matrix.h"
+#include "tidop/math/geometry/affine.h"
+#include "tidop/math/geometry/helmert.h"
+#include "tidop/math/geometry/umeyama.h"
+#include "tidop/math/geometry/transform_batch.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Geometry
+ *  \{
+ */
+
+
+/*!
+ * \brief Estimator traits for the robust estimation engine
+ *
+ * Each estimator must provide the model type, the dimension of the points
+ * and the size of the minimal sample needed to estimate a model.
+ * The model must implement the batch transform of separate coordinate arrays.
+ */
+template<typename Estimator>
+struct RansacEstimatorTraits;
+
+template<typename T>
+struct RansacEstimatorTraits<Affine2DEstimator<T>>
+{
+    using value_type = T;
+    using model_type = Affine<T, 2>;
+    static constexpr size_t dimensions = 2;
+    static constexpr size_t sample_size = 3;
+};
+
+template<typename T, size_t Dim>
+struct RansacEstimatorTraits<HelmertEstimator<T, Dim>>
+{
+    using value_type = T;
+    using model_type = Affine<T, Dim>;
+    static constexpr size_t dimensions = Dim;
+    static constexpr size_t sample_size = Dim;
+};
+
+template<typename T>
+struct RansacEstimatorTraits<RotationEstimator<T, 2>>
+{
+    using value_type = T;
+    using model_type = Rotation<T, 2>;
+    static constexpr size_t dimensions = 2;
+    static constexpr size_t sample_size = 1;
+};
+
+template<typename T>
+struct RansacEstimatorTraits<ScalingEstimator<T, 2>>
+{
+    using value_type = T;
+    using model_type = Scaling<T, 2>;
+    static constexpr size_t dimensions = 2;
+    static constexpr size_t sample_size = 2;
+};
+
+template<typename T>
+struct RansacEstimatorTraits<TranslationEstimator<T, 2>>
+{
+    using value_type = T;
+    using model_type = Translation<T, 2>;
+    static constexpr size_t dimensions = 2;
+    static constexpr size_t sample_size = 2;
+};
+
+template<typename T, size_t Dim>
+struct RansacEstimatorTraits<Umeyama<T, Dim>>
+{
+    using value_type = T;
+    using model_type = Affine<T, Dim>;
+    static constexpr size_t dimensions = Dim;
+    static constexpr size_t sample_size = Dim;
+};
+
+
+/*!
+ * \brief Hypothesis scoring
+ */
+enum class RansacScoring
+{
+    ransac, ///< Number of outliers
+    msac    ///< Truncated quadratic cost (M-estimator sample consensus)
+};
+
+/*!
+ * \brief Robust estimation properties
+ */
+struct RansacProperties
+{
+    RansacScoring scoring{RansacScoring::msac};
+    /// Maximum distance between the transformed source point and the destination point for an inlier
+    double threshold{1.};
+    double confidence{0.99};
+    size_t maxIterations{10000};
+    /// Local optimization (LO-RANSAC) of each new best model
+    bool localOptimization{true};
+    size_t loIterations{5};
+    /// Progressive sampling (PROSAC). Points must be sorted by decreasing quality
+    bool prosac{false};
+    /// Early rejection of bad hypotheses with the sequential probability ratio test
+    bool sprt{false};
+    /// Least squares fit over the inliers of the best model
+    bool refine{true};
+    unsigned int seed{0};
+    /// Precision::fast scores the hypotheses with float residuals of the centered points
+    Precision precision{Precision::exact};
+};
+
+
+/// \cond
+
+namespace internal
+{
+
+/// Points evaluated per block in the hypothesis scoring
+constexpr size_t ransac_block_size = 256;
+/// Below this number of points the hypotheses are scored in the calling thread
+constexpr size_t ransac_parallel_threshold = 1000;
+
+struct RansacScore
+{
+    double cost{std::numeric_limits<double>::max()};
+    size_t inliers{0};
+    /// Points evaluated before the model was accepted or rejected
+    size_t tested{0};
+    bool valid{false};
+};
+
+
+/*!
+ * \brief Minimal sample generator
+ *
+ * Uniform sampling or PROSAC progressive sampling:
+ * O. Chum and J. Matas, "Matching with PROSAC - progressive sample consensus,"
+ * 2005 IEEE Computer Society Conference on Computer Vision and Pattern Recognition (CVPR'05),
+ * pp. 220-226 vol. 1, doi: 10.1109/CVPR.2005.221.
+ */
+class RansacSampler
+{
+
+public:
+
+    RansacSampler(size_t size,
+                  size_t sampleSize,
+                  bool prosac,
+                  size_t maxIterations,
+                  unsigned int seed)
+      : mSize(size),
+        mSampleSize(sampleSize),
+        mProsac(prosac),
+        mGenerator(seed),
+        mIteration(0),
+        mSubsetSize(sampleSize),
+        mTn(static_cast<double>(maxIterations)),
+        mTnPrime(1)
+    {
+        for (size_t i = 0; i < mSampleSize; i++) {
+            mTn *= static_cast<double>(mSubsetSize - i) / static_cast<double>(mSize - i);
+        }
+    }
+
+    void sample(size_t *indices)
+    {
+        if (!mProsac) {
+            draw(indices, mSampleSize, mSize);
+            return;
+        }
+
+        mIteration++;
+
+        if (mIteration > mTnPrime && mSubsetSize < mSize) {
+            double tn_next = mTn * static_cast<double>(mSubsetSize + 1) / static_cast<double>(mSubsetSize + 1 - mSampleSize);
+            mSubsetSize++;
+            mTnPrime += static_cast<size_t>(std::ceil(tn_next - mTn));
+            mTn = tn_next;
+        }
+
+        if (mTnPrime < mIteration) {
+            draw(indices, mSampleSize, mSubsetSize);
+        } else {
+            draw(indices, mSampleSize - 1, mSubsetSize - 1);
+            indices[mSampleSize - 1] = mSubsetSize - 1;
+        }
+    }
+
+private:
+
+    /// Draws count different indices from [0, range)
+    void draw(size_t *indices, size_t count, size_t range)
+    {
+        std::uniform_int_distribution<size_t> distribution(0, range - 1);
+
+        for (size_t i = 0; i < count; i++) {
+            size_t index;
+            do {
+                index = distribution(mGenerator);
+            } while (std::find(indices, indices + i, index) != indices + i);
+            indices[i] = index;
+        }
+    }
+
+private:
+
+    size_t mSize;
+    size_t mSampleSize;
+    bool mProsac;
+    std::mt19937 mGenerator;
+    size_t mIteration;
+    size_t mSubsetSize;
+    double mTn;
+    size_t mTnPrime;
+};
+
+
+template<typename T>
+void squared_difference_cpp(const T *a, const T *b, T *result, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        T difference = a[i] - b[i];
+        result[i] += difference * difference;
+    }
+}
+
+/*!
+ * \brief result += (a - b)^2
+ */
+template<typename T>
+auto squared_difference(const T *a, const T *b, T *result, size_t size) -> std::enable_if_t<is_simd_transform_type<T>::value, void>
+{
+#ifdef TL_HAVE_SIMD_INTRINSICS
+    Packed<T> packed_a;
+    Packed<T> packed_b;
+    Packed<T> packed_result;
+
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = (size / packed_size) * packed_size;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+        packed_a.loadUnaligned(&a[i]);
+        packed_b.loadUnaligned(&b[i]);
+        packed_result.loadUnaligned(&result[i]);
+        Packed<T> difference = packed_a - packed_b;
+        packed_result = internal::fmadd(difference, difference, packed_result);
+        packed_result.storeUnaligned(&result[i]);
+    }
+
+    squared_difference_cpp(a, b, result, max_vector, size);
+#else
+    squared_difference_cpp(a, b, result, 0, size);
+#endif
+}
+
+template<typename T>
+auto squared_difference(const T *a, const T *b, T *result, size_t size) -> std::enable_if_t<!is_simd_transform_type<T>::value, void>
+{
+    squared_difference_cpp(a, b, result, 0, size);
+}
+
+template<typename Model, typename T>
+void ransac_transform(const Model &model,
+                      const std::array<std::vector<T>, 2> &src,
+                      size_t ini, size_t size,
+                      std::array<std::array<T, ransac_block_size>, 2> &dst)
+{
+    model.transform(&src[0][ini], &src[1][ini], dst[0].data(), dst[1].data(), size);
+}
+
+template<typename Model, typename T>
+void ransac_transform(const Model &model,
+                      const std::array<std::vector<T>, 3> &src,
+                      size_t ini, size_t size,
+                      std::array<std::array<T, ransac_block_size>, 3> &dst)
+{
+    model.transform(&src[0][ini], &src[1][ini], &src[2][ini],
+                    dst[0].data(), dst[1].data(), dst[2].data(), size);
+}
+
+/*!
+ * \brief Linear part and translation [A | t] of an affine model
+ * Obtained by transforming the origin and the unit vectors
+ */
+template<typename Model, typename T>
+void ransac_transform_basis(const Model &model,
+                           const std::array<std::array<T, 3>, 2> &basis,
+                           std::array<std::array<T, 3>, 2> &transformed)
+{
+    model.transform(basis[0].data(), basis[1].data(), transformed[0].data(), transformed[1].data(), 3);
+}
+
+template<typename Model, typename T>
+void ransac_transform_basis(const Model &model,
+                           const std::array<std::array<T, 4>, 3> &basis,
+                           std::array<std::array<T, 4>, 3> &transformed)
+{
+    model.transform(basis[0].data(), basis[1].data(), basis[2].data(),
+                    transformed[0].data(), transformed[1].data(), transformed[2].data(), 4);
+}
+
+template<typename Model, typename T, size_t Dim>
+void ransac_affine_parameters(const Model &model, std::array<std::array<double, Dim + 1>, Dim> &parameters)
+{
+    std::array<std::array<T, Dim + 1>, Dim> basis{};
+    std::array<std::array<T, Dim + 1>, Dim> transformed;
+
+    for (size_t c = 0; c < Dim; c++)
+        basis[c][c + 1] = consts::one<T>;
+
+    ransac_transform_basis(model, basis, transformed);
+
+    for (size_t r = 0; r < Dim; r++) {
+        parameters[r][Dim] = static_cast<double>(transformed[r][0]);
+        for (size_t c = 0; c < Dim; c++)
+            parameters[r][c] = static_cast<double>(transformed[r][c + 1]) - parameters[r][Dim];
+    }
+}
+
+template<size_t Dim>
+void ransac_squared_residuals_float_cpp(const std::array<const float *, Dim> &src,
+                                        const std::array<const float *, Dim> &dst,
+                                        const std::array<std::array<float, Dim + 1>, Dim> &parameters,
+                                        float *residuals, size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        float residual = 0.f;
+        for (size_t r = 0; r < Dim; r++) {
+            float difference = parameters[r][Dim] - dst[r][i];
+            for (size_t c = 0; c < Dim; c++)
+                difference += parameters[r][c] * src[c][i];
+            residual += difference * difference;
+        }
+        residuals[i] = residual;
+    }
+}
+
+/*!
+ * \brief Squared residuals |A * src + t - dst|^2 in float
+ */
+template<size_t Dim>
+void ransac_squared_residuals_float(const std::array<const float *, Dim> &src,
+                                    const std::array<const float *, Dim> &dst,
+                                    const std::array<std::array<float, Dim + 1>, Dim> &parameters,
+                                    float *residuals, size_t size)
+{
+#ifdef TL_HAVE_SIMD_INTRINSICS
+    constexpr size_t packed_size = Packed<float>::size();
+    size_t max_vector = (size / packed_size) * packed_size;
+
+    std::array<Packed<float>, Dim> packed_src;
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+
+        for (size_t c = 0; c < Dim; c++)
+            packed_src[c].loadUnaligned(&src[c][i]);
+
+        Packed<float> residual(0.f);
+        for (size_t r = 0; r < Dim; r++) {
+            Packed<float> packed_dst;
+            packed_dst.loadUnaligned(&dst[r][i]);
+            Packed<float> difference = Packed<float>(parameters[r][Dim]) - packed_dst;
+            for (size_t c = 0; c < Dim; c++)
+                difference = internal::fmadd(Packed<float>(parameters[r][c]), packed_src[c], difference);
+            residual = internal::fmadd(difference, difference, residual);
+        }
+
+        residual.storeUnaligned(&residuals[i]);
+    }
+
+    ransac_squared_residuals_float_cpp(src, dst, parameters, residuals, max_vector, size);
+#else
+    ransac_squared_residuals_float_cpp(src, dst, parameters, residuals, 0, size);
+#endif
+}
+
+/*!
+ * \brief Cost and inliers of a block of float residuals
+ * The block sums are returned in double
+ */
+inline void ransac_score_float(const float *residuals, size_t size, float threshold, bool msac,
+                               double &cost, size_t &inliers)
+{
+    float block_cost = 0.f;
+    float block_inliers = 0.f;
+    size_t ini = 0;
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+    constexpr size_t packed_size = Packed<float>::size();
+    size_t max_vector = (size / packed_size) * packed_size;
+
+    Packed<float> packed_threshold(threshold);
+    Packed<float> packed_one(1.f);
+    Packed<float> packed_zero(0.f);
+    Packed<float> packed_cost(0.f);
+    Packed<float> packed_inliers(0.f);
+
+    for (size_t i = 0; i < max_vector; i += packed_size) {
+        Packed<float> residual;
+        residual.loadUnaligned(&residuals[i]);
+        Packed<float> inlier = select(lessThan(residual, packed_threshold), packed_one, packed_zero);
+        packed_inliers += inlier;
+        packed_cost += msac ? internal::min(residual, packed_threshold) : packed_one - inlier;
+    }
+
+    block_cost = packed_cost.sum();
+    block_inliers = packed_inliers.sum();
+    ini = max_vector;
+#endif
+
+    for (size_t i = ini; i < size; i++) {
+        bool inlier = residuals[i] < threshold;
+        block_inliers += inlier ? 1.f : 0.f;
+        block_cost += msac ? std::min(residuals[i], threshold) : (inlier ? 0.f : 1.f);
+    }
+
+    cost += static_cast<double>(block_cost);
+    inliers += static_cast<size_t>(block_inliers);
+}
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Robust estimation engine (RANSAC, MSAC and LO-RANSAC)
+ *
+ * Estimates a model from minimal samples of point correspondences and keeps
+ * the hypothesis with the lowest cost. The number of iterations is adapted
+ * to the inlier ratio of the best model found.
+ *
+ * - M. A. Fischler and R. C. Bolles, "Random sample consensus: a paradigm for model
+ *   fitting with applications to image analysis and automated cartography",
+ *   Commun. ACM 24, 6 (June 1981), 381-395, doi: 10.1145/358669.358692.
+ * - P. H. S. Torr and A. Zisserman, "MLESAC: A new robust estimator with application
+ *   to estimating image geometry", Computer Vision and Image Understanding, 78 (2000), 138-156.
+ * - O. Chum, J. Matas and J. Kittler, "Locally optimized RANSAC", DAGM 2003, pp. 236-243.
+ * - J. Matas and O. Chum, "Randomized RANSAC with sequential probability ratio test",
+ *   ICCV 2005, vol. 2, pp. 1727-1732, doi: 10.1109/ICCV.2005.198.
+ *
+ * Hypotheses are generated in rounds. The samples of a round are drawn in the calling
+ * thread, so the result only depends on the seed, and the models are estimated and
+ * scored in parallel. Residuals are computed in blocks with the batch transform of the model.
+ * With Precision::fast the residuals are computed in float, with twice the SIMD lanes,
+ * from the points centered in double. The float error is relative to the extent of the
+ * point set and far below the usual thresholds. Only the scoring without SPRT uses float:
+ * the SPRT decisions, the final inliers and the local optimization residuals are
+ * computed in the working precision, as are the models.
+ *
+ * \code
+ * RansacProperties properties;
+ * properties.threshold = 0.5;
+ * Ransac<Affine2DEstimator<double>> ransac(properties);
+ * Affine<double, 2> affine = ransac.estimate(src_points, dst_points);
+ * std::vector<bool> inliers = ransac.inliers();
+ * \endcode
+ */
+template<typename Estimator>
+class Ransac
+{
+
+public:
+
+    using traits = RansacEstimatorTraits<Estimator>;
+    using value_type = typename traits::value_type;
+    using model_type = typename traits::model_type;
+
+    enum
+    {
+        dimensions = traits::dimensions,
+        sample_size = traits::sample_size
+    };
+
+public:
+
+    Ransac() = default;
+    explicit Ransac(const RansacProperties &properties);
+    ~Ransac() = default;
+
+    auto properties() const -> const RansacProperties &;
+    void setProperties(const RansacProperties &properties);
+
+    template<size_t rows, size_t cols>
+    auto estimate(const Matrix<value_type, rows, cols> &src,
+                  const Matrix<value_type, rows, cols> &dst) -> model_type;
+    auto estimate(const std::vector<Point<value_type>> &src,
+                  const std::vector<Point<value_type>> &dst) -> model_type;
+    auto estimate(const std::vector<Point3<value_type>> &src,
+                  const std::vector<Point3<value_type>> &dst) -> model_type;
+
+    /*!
+     * \brief Inlier mask of the last estimation
+     */
+    auto inliers() const -> const std::vector<bool> &;
+    auto inliersCount() const -> size_t;
+
+    /*!
+     * \brief Number of hypotheses evaluated in the last estimation
+     */
+    auto iterations() const -> size_t;
+
+private:
+
+    auto run() -> model_type;
+    auto fit(const size_t *indices, size_t count, model_type &model) const -> bool;
+    auto evaluate(const model_type &model, bool sprt) const -> internal::RansacScore;
+    /// Scoring with float residuals and vectorized cost (Precision::fast without SPRT)
+    auto evaluateFloat(const model_type &model) const -> internal::RansacScore;
+    void residuals(const model_type &model, size_t ini, size_t end, value_type *residuals) const;
+    auto centeredParameters(const model_type &model) const -> std::array<std::array<float, dimensions + 1>, dimensions>;
+    void residualsFloat(const std::array<std::array<float, dimensions + 1>, dimensions> &parameters,
+                        size_t ini, size_t end, float *residuals) const;
+    auto inlierIndices(const model_type &model) const -> std::vector<size_t>;
+    void localOptimization(model_type &model, internal::RansacScore &score, size_t iterations) const;
+    auto adaptiveIterations(size_t inliers) const -> size_t;
+    void updateSprt(double epsilon, double delta);
+
+private:
+
+    RansacProperties mProperties;
+    std::array<std::vector<value_type>, dimensions> mSrc;
+    std::array<std::vector<value_type>, dimensions> mDst;
+    /// Centered points for Precision::fast
+    std::array<std::vector<float>, dimensions> mSrcFloat;
+    std::array<std::vector<float>, dimensions> mDstFloat;
+    std::array<double, dimensions> mSrcMean{};
+    std::array<double, dimensions> mDstMean{};
+    size_t mSize{0};
+    std::vector<bool> mInliers;
+    size_t mInliersCount{0};
+    size_t mIterations{0};
+    double mSprtThreshold{std::numeric_limits<double>::max()};
+    double mSprtInlierRatio{1.};
+    double mSprtOutlierRatio{1.};
+};
+
+
+/* Ransac implementation */
+
+template<typename Estimator>
+Ransac<Estimator>::Ransac(const RansacProperties &properties)
+  : mProperties(properties)
+{
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::properties() const -> const RansacProperties &
+{
+    return mProperties;
+}
+
+template<typename Estimator>
+void Ransac<Estimator>::setProperties(const RansacProperties &properties)
+{
+    mProperties = properties;
+}
+
+template<typename Estimator>
+template<size_t rows, size_t cols>
+auto Ransac<Estimator>::estimate(const Matrix<value_type, rows, cols> &src,
+                                 const Matrix<value_type, rows, cols> &dst) -> model_type
+{
+    model_type model;
+
+    try {
+
+        TL_ASSERT(src.cols() == dimensions, "Invalid matrix columns size");
+        TL_ASSERT(dst.cols() == dimensions, "Invalid matrix columns size");
+        TL_ASSERT(src.rows() == dst.rows(), "Different matrix sizes. Size src = {} and size dst = {}", src.rows(), dst.rows());
+        TL_ASSERT(src.rows() >= sample_size, "Invalid number of points: {} < {}", src.rows(), static_cast<size_t>(sample_size));
+
+        mSize = src.rows();
+
+        for (size_t c = 0; c < dimensions; c++) {
+            mSrc[c].resize(mSize);
+            mDst[c].resize(mSize);
+            for (size_t r = 0; r < mSize; r++) {
+                mSrc[c][r] = src(r, c);
+                mDst[c][r] = dst(r, c);
+            }
+        }
+
+        model = run();
+
+    } catch (...) {
+        TL_THROW_EXCEPTION_WITH_NESTED("");
+    }
+
+    return model;
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::estimate(const std::vector<Point<value_type>> &src,
+                                 const std::vector<Point<value_type>> &dst) -> model_type
+{
+    static_assert(dimensions == 2, "Estimator for 3D points");
+
+    TL_ASSERT(src.size() == dst.size(), "Size of origin and destination points different");
+
+    Matrix<value_type> src_mat(src.size(), 2);
+    Matrix<value_type> dst_mat(dst.size(), 2);
+
+    for (size_t r = 0; r < src_mat.rows(); r++) {
+        src_mat[r][0] = src[r].x;
+        src_mat[r][1] = src[r].y;
+
+        dst_mat[r][0] = dst[r].x;
+        dst_mat[r][1] = dst[r].y;
+    }
+
+    return this->estimate(src_mat, dst_mat);
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::estimate(const std::vector<Point3<value_type>> &src,
+                                 const std::vector<Point3<value_type>> &dst) -> model_type
+{
+    static_assert(dimensions == 3, "Estimator for 2D points");
+
+    TL_ASSERT(src.size() == dst.size(), "Size of origin and destination points different");
+
+    Matrix<value_type> src_mat(src.size(), 3);
+    Matrix<value_type> dst_mat(dst.size(), 3);
+
+    for (size_t r = 0; r < src_mat.rows(); r++) {
+        src_mat[r][0] = src[r].x;
+        src_mat[r][1] = src[r].y;
+        src_mat[r][2] = src[r].z;
+
+        dst_mat[r][0] = dst[r].x;
+        dst_mat[r][1] = dst[r].y;
+        dst_mat[r][2] = dst[r].z;
+    }
+
+    return this->estimate(src_mat, dst_mat);
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::inliers() const -> const std::vector<bool> &
+{
+    return mInliers;
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::inliersCount() const -> size_t
+{
+    return mInliersCount;
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::iterations() const -> size_t
+{
+    return mIterations;
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::run() -> model_type
+{
+    model_type best_model;
+    internal::RansacScore best_score;
+
+    if (mProperties.precision == Precision::fast) {
+        for (size_t c = 0; c < dimensions; c++) {
+            mSrcMean[c] = 0.;
+            mDstMean[c] = 0.;
+            for (size_t i = 0; i < mSize; i++) {
+                mSrcMean[c] += static_cast<double>(mSrc[c][i]);
+                mDstMean[c] += static_cast<double>(mDst[c][i]);
+            }
+            mSrcMean[c] /= static_cast<double>(mSize);
+            mDstMean[c] /= static_cast<double>(mSize);
+
+            mSrcFloat[c].resize(mSize);
+            mDstFloat[c].resize(mSize);
+            for (size_t i = 0; i < mSize; i++) {
+                mSrcFloat[c][i] = static_cast<float>(static_cast<double>(mSrc[c][i]) - mSrcMean[c]);
+                mDstFloat[c][i] = static_cast<float>(static_cast<double>(mDst[c][i]) - mDstMean[c]);
+            }
+        }
+    }
+
+    internal::RansacSampler sampler(mSize, sample_size, mProperties.prosac,
+                                    mProperties.maxIterations, mProperties.seed);
+
+    /// Initial SPRT parameters: probability of a point being consistent with a good (epsilon)
+    /// or a bad model (delta). They are updated with the best model and the rejected models.
+    double sprt_delta = 0.05;
+    double sprt_delta_sum = 0.;
+    size_t sprt_rejected = 0;
+    if (mProperties.sprt) updateSprt(0.2, sprt_delta);
+
+    size_t round_size = std::max<size_t>(8, 4 * static_cast<size_t>(optimalNumberOfThreads()));
+    size_t max_iterations = mProperties.maxIterations;
+    bool parallel = mSize >= internal::ransac_parallel_threshold;
+
+    std::vector<size_t> samples;
+    std::vector<model_type> models;
+    std::vector<internal::RansacScore> scores;
+
+    mIterations = 0;
+
+    while (mIterations < max_iterations) {
+
+        size_t hypotheses = std::min(round_size, max_iterations - mIterations);
+
+        samples.resize(hypotheses * sample_size);
+        models.assign(hypotheses, model_type());
+        scores.assign(hypotheses, internal::RansacScore());
+
+        for (size_t h = 0; h < hypotheses; h++) {
+            sampler.sample(&samples[h * sample_size]);
+        }
+
+        bool sprt = mProperties.sprt;
+        auto hypothesis = [&](size_t h) {
+            if (fit(&samples[h * sample_size], sample_size, models[h]))
+                scores[h] = evaluate(models[h], sprt);
+        };
+
+        if (parallel) {
+            parallel_for(0, hypotheses, hypothesis);
+        } else {
+            for (size_t h = 0; h < hypotheses; h++)
+                hypothesis(h);
+        }
+
+        mIterations += hypotheses;
+
+        size_t round_best = hypotheses;
+        for (size_t h = 0; h < hypotheses; h++) {
+            if (scores[h].valid) {
+                if (scores[h].cost < best_score.cost &&
+                    (round_best == hypotheses || scores[h].cost < scores[round_best].cost))
+                    round_best = h;
+            } else if (scores[h].tested > 0) {
+                sprt_delta_sum += static_cast<double>(scores[h].inliers) / static_cast<double>(scores[h].tested);
+                sprt_rejected++;
+            }
+        }
+
+        if (round_best < hypotheses) {
+
+            best_model = models[round_best];
+            best_score = scores[round_best];
+
+            if (mProperties.localOptimization)
+                localOptimization(best_model, best_score, mProperties.loIterations);
+
+            max_iterations = std::min(max_iterations, adaptiveIterations(best_score.inliers));
+        }
+
+        if (mProperties.sprt) {
+            if (sprt_rejected > 0)
+                sprt_delta = std::max(sprt_delta_sum / static_cast<double>(sprt_rejected), 0.001);
+            double sprt_epsilon = best_score.valid ? static_cast<double>(best_score.inliers) / static_cast<double>(mSize) : 0.2;
+            updateSprt(sprt_epsilon, sprt_delta);
+        }
+    }
+
+    TL_ASSERT(best_score.valid, "No valid model found");
+
+    if (mProperties.refine)
+        localOptimization(best_model, best_score, 1);
+
+    std::vector<size_t> inlier_indices = inlierIndices(best_model);
+    mInliers.assign(mSize, false);
+    for (auto index : inlier_indices)
+        mInliers[index] = true;
+    mInliersCount = inlier_indices.size();
+
+    return best_model;
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::fit(const size_t *indices, size_t count, model_type &model) const -> bool
+{
+    Matrix<value_type> src(count, dimensions);
+    Matrix<value_type> dst(count, dimensions);
+
+    for (size_t r = 0; r < count; r++) {
+        for (size_t c = 0; c < dimensions; c++) {
+            src(r, c) = mSrc[c][indices[r]];
+            dst(r, c) = mDst[c][indices[r]];
+        }
+    }
+
+    try {
+        model = Estimator::estimate(src, dst);
+    } catch (...) {
+        /// Degenerate sample
+        return false;
+    }
+
+    return true;
+}
+
+template<typename Estimator>
+void Ransac<Estimator>::residuals(const model_type &model,
+                                  size_t ini,
+                                  size_t end,
+                                  value_type *residuals) const
+{
+    size_t size = end - ini;
+
+    std::array<std::array<value_type, internal::ransac_block_size>, dimensions> transformed;
+
+    internal::ransac_transform(model, mSrc, ini, size, transformed);
+
+    std::fill(residuals, residuals + size, consts::zero<value_type>);
+    for (size_t c = 0; c < dimensions; c++) {
+        internal::squared_difference(transformed[c].data(), &mDst[c][ini], residuals, size);
+    }
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::centeredParameters(const model_type &model) const -> std::array<std::array<float, dimensions + 1>, dimensions>
+{
+    std::array<std::array<double, dimensions + 1>, dimensions> parameters;
+    internal::ransac_affine_parameters<model_type, value_type, dimensions>(model, parameters);
+
+    /// Model for the centered points: t' = A * mean_src + t - mean_dst
+    std::array<std::array<float, dimensions + 1>, dimensions> centered;
+
+    for (size_t r = 0; r < dimensions; r++) {
+        double translation = parameters[r][dimensions] - mDstMean[r];
+        for (size_t c = 0; c < dimensions; c++) {
+            centered[r][c] = static_cast<float>(parameters[r][c]);
+            translation += parameters[r][c] * mSrcMean[c];
+        }
+        centered[r][dimensions] = static_cast<float>(translation);
+    }
+
+    return centered;
+}
+
+template<typename Estimator>
+void Ransac<Estimator>::residualsFloat(const std::array<std::array<float, dimensions + 1>, dimensions> &parameters,
+                                       size_t ini,
+                                       size_t end,
+                                       float *residuals) const
+{
+    std::array<const float *, dimensions> src;
+    std::array<const float *, dimensions> dst;
+
+    for (size_t c = 0; c < dimensions; c++) {
+        src[c] = &mSrcFloat[c][ini];
+        dst[c] = &mDstFloat[c][ini];
+    }
+
+    internal::ransac_squared_residuals_float<dimensions>(src, dst, parameters, residuals, end - ini);
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::evaluateFloat(const model_type &model) const -> internal::RansacScore
+{
+    internal::RansacScore score;
+    score.cost = 0.;
+
+    float threshold = static_cast<float>(mProperties.threshold * mProperties.threshold);
+    bool msac = mProperties.scoring == RansacScoring::msac;
+
+    auto parameters = centeredParameters(model);
+    std::array<float, internal::ransac_block_size> block_residuals;
+
+    for (size_t ini = 0; ini < mSize; ini += internal::ransac_block_size) {
+        size_t end = std::min(ini + internal::ransac_block_size, mSize);
+        residualsFloat(parameters, ini, end, block_residuals.data());
+        internal::ransac_score_float(block_residuals.data(), end - ini, threshold, msac,
+                                     score.cost, score.inliers);
+    }
+
+    score.tested = mSize;
+    score.valid = true;
+
+    return score;
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::evaluate(const model_type &model, bool sprt) const -> internal::RansacScore
+{
+    internal::RansacScore score;
+    score.cost = 0.;
+
+    double threshold = mProperties.threshold * mProperties.threshold;
+    bool msac = mProperties.scoring == RansacScoring::msac;
+    double lambda = 1.;
+
+    if (mProperties.precision == Precision::fast && !sprt)
+        return evaluateFloat(model);
+
+    std::array<value_type, internal::ransac_block_size> block_residuals;
+
+    for (size_t ini = 0; ini < mSize; ini += internal::ransac_block_size) {
+
+        size_t end = std::min(ini + internal::ransac_block_size, mSize);
+        residuals(model, ini, end, block_residuals.data());
+
+        for (size_t i = 0; i < end - ini; i++) {
+
+            double residual = static_cast<double>(block_residuals[i]);
+            bool inlier = residual < threshold;
+
+            if (inlier) {
+                score.inliers++;
+                if (msac) score.cost += residual;
+            } else {
+                score.cost += msac ? threshold : 1.;
+            }
+
+            if (sprt) {
+                lambda *= inlier ? mSprtInlierRatio : mSprtOutlierRatio;
+                if (lambda > mSprtThreshold) {
+                    score.tested = ini + i + 1;
+                    return score;
+                }
+            }
+        }
+    }
+
+    score.tested = mSize;
+    score.valid = true;
+
+    return score;
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::inlierIndices(const model_type &model) const -> std::vector<size_t>
+{
+    std::vector<size_t> indices;
+    double threshold = mProperties.threshold * mProperties.threshold;
+
+    std::array<value_type, internal::ransac_block_size> block_residuals;
+
+    for (size_t ini = 0; ini < mSize; ini += internal::ransac_block_size) {
+        size_t end = std::min(ini + internal::ransac_block_size, mSize);
+        residuals(model, ini, end, block_residuals.data());
+        for (size_t i = 0; i < end - ini; i++) {
+            if (static_cast<double>(block_residuals[i]) < threshold)
+                indices.push_back(ini + i);
+        }
+    }
+
+    return indices;
+}
+
+template<typename Estimator>
+void Ransac<Estimator>::localOptimization(model_type &model,
+                                          internal::RansacScore &score,
+                                          size_t iterations) const
+{
+    for (size_t i = 0; i < iterations; i++) {
+
+        std::vector<size_t> indices = inlierIndices(model);
+        if (indices.size() <= sample_size) break;
+
+        model_type optimized_model;
+        if (!fit(indices.data(), indices.size(), optimized_model)) break;
+
+        internal::RansacScore optimized_score = evaluate(optimized_model, false);
+        if (optimized_score.cost > score.cost) break;
+
+        model = optimized_model;
+        score = optimized_score;
+    }
+}
+
+template<typename Estimator>
+auto Ransac<Estimator>::adaptiveIterations(size_t inliers) const -> size_t
+{
+    double inlier_ratio = static_cast<double>(inliers) / static_cast<double>(mSize);
+    double probability = std::pow(inlier_ratio, static_cast<double>(sample_size));
+
+    if (probability <= std::numeric_limits<double>::epsilon())
+        return mProperties.maxIterations;
+    if (probability >= 1. - std::numeric_limits<double>::epsilon())
+        return 1;
+
+    double iterations = std::ceil(std::log(1. - mProperties.confidence) / std::log(1. - probability));
+
+    return iterations < static_cast<double>(mProperties.maxIterations) ?
+        static_cast<size_t>(iterations) : mProperties.maxIterations;
+}
+
+template<typename Estimator>
+void Ransac<Estimator>::updateSprt(double epsilon, double delta)
+{
+    /// Without a clear separation between good and bad models the test is disabled
+    if (epsilon <= delta || epsilon >= 1.) {
+        mSprtThreshold = std::numeric_limits<double>::max();
+        mSprtInlierRatio = 1.;
+        mSprtOutlierRatio = 1.;
+        return;
+    }
+
+    mSprtInlierRatio = delta / epsilon;
+    mSprtOutlierRatio = (1. - delta) / (1. - epsilon);
+
+    /// Decision threshold A (Matas and Chum, eq. 2). The estimation time of a model
+    /// is measured in point evaluations and the models per sample is 1.
+    constexpr double model_time = 200.;
+    double c = (1. - delta) * std::log((1. - delta) / (1. - epsilon)) + delta * std::log(delta / epsilon);
+    double a0 = model_time * c + 1.;
+    double a = a0;
+    for (int i = 0; i < 10; i++)
+        a = a0 + std::log(a);
+
+    mSprtThreshold = a;
+}
+
+
+/*! \} */ // end of Geometry
+
+/*! \} */ // end of Math
+
+} // End namespace tl
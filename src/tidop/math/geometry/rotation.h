@@ -33,6 +33,7 @@
 #include "tidop/math/algebra/euler_angles.h"
 #include "tidop/math/algebra/rotation_matrix.h"
 #include "tidop/geometry/entities/point.h"
+#include "tidop/math/geometry/transform_batch.h"
 
 namespace tl
 {
@@ -106,6 +107,34 @@ public:
     template<size_t _row, size_t _col>
     auto transform(const Matrix<T, _row, _col> &matrix) const -> Matrix<T, _row, _col>;
 
+    /*!
+     * \brief Transform a 2D point set stored as separate coordinate arrays
+     * The output arrays can be the same as the input arrays. Large point
+     * sets are split in blocks that are transformed in parallel.
+     * \param[in] x X coordinates
+     * \param[in] y Y coordinates
+     * \param[out] xOut Transformed X coordinates
+     * \param[out] yOut Transformed Y coordinates
+     * \param[in] size Number of points
+     */
+    void transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const;
+
+    /*!
+     * \brief Transform a 3D point set stored as separate coordinate arrays
+     * \see transform(const T *, const T *, T *, T *, size_t)
+     */
+    void transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 2D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 3D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, T *z, size_t size) const;
+
     auto operator * (const Point<T> &point) const -> Point<T>;
     auto operator * (const Point3<T> &point) const -> Point3<T>;
     template<size_t _size>
@@ -327,6 +356,41 @@ auto Rotation<T, Dim>::transform(const Matrix<T, _row, _col> &matrix) const -> M
     return matrix * rotation;
 }
 
+template<typename T, size_t Dim>
+void Rotation<T, Dim>::transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const
+{
+    static_assert(dimensions == 2, "Transformation only allowed for 2D points");
+
+    const T m[6] = {rotation(0, 0), rotation(0, 1), consts::zero<T>,
+                    rotation(1, 0), rotation(1, 1), consts::zero<T>};
+
+    internal::transform_batch_2d(m, x, y, xOut, yOut, size);
+}
+
+template<typename T, size_t Dim>
+void Rotation<T, Dim>::transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const
+{
+    static_assert(dimensions == 3, "Transformation only allowed for 3D points");
+
+    const T m[12] = {rotation(0, 0), rotation(0, 1), rotation(0, 2), consts::zero<T>,
+                     rotation(1, 0), rotation(1, 1), rotation(1, 2), consts::zero<T>,
+                     rotation(2, 0), rotation(2, 1), rotation(2, 2), consts::zero<T>};
+
+    internal::transform_batch_3d(m, x, y, z, xOut, yOut, zOut, size);
+}
+
+template<typename T, size_t Dim>
+void Rotation<T, Dim>::transform(T *x, T *y, size_t size) const
+{
+    this->transform(x, y, x, y, size);
+}
+
+template<typename T, size_t Dim>
+void Rotation<T, Dim>::transform(T *x, T *y, T *z, size_t size) const
+{
+    this->transform(x, y, z, x, y, z, size);
+}
+
 template<typename T, size_t Dim>
 auto Rotation<T, Dim>::operator * (const Point<T> &point) const -> Point<T>
 {
@@ -412,10 +476,10 @@ auto RotationEstimator<T, Dim>::estimate(const Matrix<T, rows, cols> &src,
         SingularValueDecomposition<Matrix<double>> svd(A);
         Vector<double> C = svd.solve(B);
 
-        rotation[0][0] = C[0];
-        rotation[0][1] = -C[1];
-        rotation[1][0] = C[1];
-        rotation[1][1] = C[0];
+        rotation(0, 0) = C[0];
+        rotation(0, 1) = -C[1];
+        rotation(1, 0) = C[1];
+        rotation(1, 1) = C[0];
 
     } catch (...) {
         TL_THROW_EXCEPTION_WITH_NESTED("");
@@ -30,6 +30,7 @@
 #include "tidop/math/algebra/vector.h"
 #include "tidop/math/algebra/svd.h"
 #include "tidop/geometry/entities/point.h"
+#include "tidop/math/geometry/transform_batch.h"
 
 namespace tl
 {
@@ -107,6 +108,34 @@ public:
     template<size_t _row, size_t _col>
     auto transform(const Matrix<T, _row, _col> &matrix) const -> Matrix<T, _row, _col>;
 
+    /*!
+     * \brief Transform a 2D point set stored as separate coordinate arrays
+     * The output arrays can be the same as the input arrays. Large point
+     * sets are split in blocks that are transformed in parallel.
+     * \param[in] x X coordinates
+     * \param[in] y Y coordinates
+     * \param[out] xOut Transformed X coordinates
+     * \param[out] yOut Transformed Y coordinates
+     * \param[in] size Number of points
+     */
+    void transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const;
+
+    /*!
+     * \brief Transform a 3D point set stored as separate coordinate arrays
+     * \see transform(const T *, const T *, T *, T *, size_t)
+     */
+    void transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 2D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 3D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, T *z, size_t size) const;
+
     auto operator * (const Point<T> &point) const -> Point<T>;
     auto operator * (const Point3<T> &point) const -> Point3<T>;
     template<size_t _size>
@@ -191,7 +220,7 @@ Scaling<T, Dim>::Scaling(const Vector<T, Dim> &vector)
 
 template<typename T, size_t Dim>
 Scaling<T, Dim>::Scaling(const Scaling &scaling)
-    : scale(scaling)
+    : scale(scaling.scale)
 {
 }
 
@@ -341,6 +370,37 @@ auto Scaling<T, Dim>::transform(const Matrix<T, _row, _col> &matrix) const -> Ma
     return aux;
 }
 
+template<typename T, size_t Dim>
+void Scaling<T, Dim>::transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const
+{
+    static_assert(dimensions == 2, "Transformation only allowed for 2D points");
+
+    internal::transform_batch_axis(scale[0], consts::zero<T>, x, xOut, size);
+    internal::transform_batch_axis(scale[1], consts::zero<T>, y, yOut, size);
+}
+
+template<typename T, size_t Dim>
+void Scaling<T, Dim>::transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const
+{
+    static_assert(dimensions == 3, "Transformation only allowed for 3D points");
+
+    internal::transform_batch_axis(scale[0], consts::zero<T>, x, xOut, size);
+    internal::transform_batch_axis(scale[1], consts::zero<T>, y, yOut, size);
+    internal::transform_batch_axis(scale[2], consts::zero<T>, z, zOut, size);
+}
+
+template<typename T, size_t Dim>
+void Scaling<T, Dim>::transform(T *x, T *y, size_t size) const
+{
+    this->transform(x, y, x, y, size);
+}
+
+template<typename T, size_t Dim>
+void Scaling<T, Dim>::transform(T *x, T *y, T *z, size_t size) const
+{
+    this->transform(x, y, z, x, y, z, size);
+}
+
 template<typename T, size_t Dim>
 auto Scaling<T, Dim>::operator * (const Point<T> &point) const -> Point<T>
 {
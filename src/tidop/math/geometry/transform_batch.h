@@ -0,0 +1,305 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/simd.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Geometry
+ *  \{
+ */
+
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * Batch transformation kernels for point sets stored as separate coordinate
+ * arrays (structure of arrays). Input and output arrays may be the same
+ * pointers, each lane is read before it is written.
+ *
+ * The coefficients of the transformation are passed as a row-major Dim x (Dim + 1)
+ * matrix: 6 values for 2D and 12 values for 3D.
+ */
+
+/// Number of points processed by each task
+constexpr size_t transform_batch_block_size = 8192;
+/// Point sets smaller than this are transformed in the calling thread
+constexpr size_t transform_batch_parallel_threshold = 65536;
+
+/// Types with a vectorized kernel
+template<typename T>
+struct is_simd_transform_type
+#ifdef TL_HAVE_SIMD_INTRINSICS
+  : std::integral_constant<bool, std::is_same<float, std::remove_cv_t<T>>::value ||
+                                 std::is_same<double, std::remove_cv_t<T>>::value>
+#else
+  : std::false_type
+#endif
+{
+};
+
+
+/* Scalar kernels */
+
+template<typename T>
+void transform_batch_2d_cpp(const T *m,
+                            const T *x, const T *y,
+                            T *xOut, T *yOut,
+                            size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        T _x = x[i];
+        T _y = y[i];
+        xOut[i] = m[0] * _x + m[1] * _y + m[2];
+        yOut[i] = m[3] * _x + m[4] * _y + m[5];
+    }
+}
+
+template<typename T>
+void transform_batch_3d_cpp(const T *m,
+                            const T *x, const T *y, const T *z,
+                            T *xOut, T *yOut, T *zOut,
+                            size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        T _x = x[i];
+        T _y = y[i];
+        T _z = z[i];
+        xOut[i] = m[0] * _x + m[1] * _y + m[2] * _z + m[3];
+        yOut[i] = m[4] * _x + m[5] * _y + m[6] * _z + m[7];
+        zOut[i] = m[8] * _x + m[9] * _y + m[10] * _z + m[11];
+    }
+}
+
+template<typename T>
+void transform_batch_axis_cpp(T a, T b,
+                              const T *x, T *xOut,
+                              size_t ini, size_t end)
+{
+    for (size_t i = ini; i < end; i++) {
+        xOut[i] = a * x[i] + b;
+    }
+}
+
+
+/* SIMD kernels */
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+auto transform_batch_2d_block(const T *m,
+                              const T *x, const T *y,
+                              T *xOut, T *yOut,
+                              size_t ini, size_t end) -> std::enable_if_t<is_simd_transform_type<T>::value, void>
+{
+    const Packed<T> m00(m[0]), m01(m[1]), m02(m[2]);
+    const Packed<T> m10(m[3]), m11(m[4]), m12(m[5]);
+
+    Packed<T> packed_x;
+    Packed<T> packed_y;
+
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        packed_x.loadUnaligned(&x[i]);
+        packed_y.loadUnaligned(&y[i]);
+
+        Packed<T> packed_x_out = internal::fmadd(m00, packed_x, internal::fmadd(m01, packed_y, m02));
+        Packed<T> packed_y_out = internal::fmadd(m10, packed_x, internal::fmadd(m11, packed_y, m12));
+
+        packed_x_out.storeUnaligned(&xOut[i]);
+        packed_y_out.storeUnaligned(&yOut[i]);
+    }
+
+    transform_batch_2d_cpp(m, x, y, xOut, yOut, max_vector, end);
+}
+
+template<typename T>
+auto transform_batch_3d_block(const T *m,
+                              const T *x, const T *y, const T *z,
+                              T *xOut, T *yOut, T *zOut,
+                              size_t ini, size_t end) -> std::enable_if_t<is_simd_transform_type<T>::value, void>
+{
+    const Packed<T> m00(m[0]), m01(m[1]), m02(m[2]), m03(m[3]);
+    const Packed<T> m10(m[4]), m11(m[5]), m12(m[6]), m13(m[7]);
+    const Packed<T> m20(m[8]), m21(m[9]), m22(m[10]), m23(m[11]);
+
+    Packed<T> packed_x;
+    Packed<T> packed_y;
+    Packed<T> packed_z;
+
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+
+        packed_x.loadUnaligned(&x[i]);
+        packed_y.loadUnaligned(&y[i]);
+        packed_z.loadUnaligned(&z[i]);
+
+        Packed<T> packed_x_out = internal::fmadd(m00, packed_x, internal::fmadd(m01, packed_y, internal::fmadd(m02, packed_z, m03)));
+        Packed<T> packed_y_out = internal::fmadd(m10, packed_x, internal::fmadd(m11, packed_y, internal::fmadd(m12, packed_z, m13)));
+        Packed<T> packed_z_out = internal::fmadd(m20, packed_x, internal::fmadd(m21, packed_y, internal::fmadd(m22, packed_z, m23)));
+
+        packed_x_out.storeUnaligned(&xOut[i]);
+        packed_y_out.storeUnaligned(&yOut[i]);
+        packed_z_out.storeUnaligned(&zOut[i]);
+    }
+
+    transform_batch_3d_cpp(m, x, y, z, xOut, yOut, zOut, max_vector, end);
+}
+
+template<typename T>
+auto transform_batch_axis_block(T a, T b,
+                                const T *x, T *xOut,
+                                size_t ini, size_t end) -> std::enable_if_t<is_simd_transform_type<T>::value, void>
+{
+    const Packed<T> packed_a(a);
+    const Packed<T> packed_b(b);
+
+    Packed<T> packed_x;
+
+    constexpr size_t packed_size = Packed<T>::size();
+    size_t max_vector = ini + ((end - ini) / packed_size) * packed_size;
+
+    for (size_t i = ini; i < max_vector; i += packed_size) {
+        packed_x.loadUnaligned(&x[i]);
+        internal::fmadd(packed_a, packed_x, packed_b).storeUnaligned(&xOut[i]);
+    }
+
+    transform_batch_axis_cpp(a, b, x, xOut, max_vector, end);
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+template<typename T>
+auto transform_batch_2d_block(const T *m,
+                              const T *x, const T *y,
+                              T *xOut, T *yOut,
+                              size_t ini, size_t end) -> std::enable_if_t<!is_simd_transform_type<T>::value, void>
+{
+    transform_batch_2d_cpp(m, x, y, xOut, yOut, ini, end);
+}
+
+template<typename T>
+auto transform_batch_3d_block(const T *m,
+                              const T *x, const T *y, const T *z,
+                              T *xOut, T *yOut, T *zOut,
+                              size_t ini, size_t end) -> std::enable_if_t<!is_simd_transform_type<T>::value, void>
+{
+    transform_batch_3d_cpp(m, x, y, z, xOut, yOut, zOut, ini, end);
+}
+
+template<typename T>
+auto transform_batch_axis_block(T a, T b,
+                                const T *x, T *xOut,
+                                size_t ini, size_t end) -> std::enable_if_t<!is_simd_transform_type<T>::value, void>
+{
+    transform_batch_axis_cpp(a, b, x, xOut, ini, end);
+}
+
+/*!
+ * \brief Splits the point set in blocks and runs the kernel over them.
+ * Small point sets are processed in the calling thread.
+ */
+template<typename Kernel>
+void transform_batch_run(size_t size, Kernel kernel)
+{
+    if (size < transform_batch_parallel_threshold) {
+        kernel(0, size);
+        return;
+    }
+
+    size_t blocks = (size + transform_batch_block_size - 1) / transform_batch_block_size;
+
+    parallel_for(0, blocks, [&](size_t block) {
+        size_t ini = block * transform_batch_block_size;
+        size_t end = std::min(ini + transform_batch_block_size, size);
+        kernel(ini, end);
+    });
+}
+
+template<typename T>
+void transform_batch_2d(const T *m,
+                        const T *x, const T *y,
+                        T *xOut, T *yOut,
+                        size_t size)
+{
+    transform_batch_run(size, [&](size_t ini, size_t end) {
+        transform_batch_2d_block(m, x, y, xOut, yOut, ini, end);
+    });
+}
+
+template<typename T>
+void transform_batch_3d(const T *m,
+                        const T *x, const T *y, const T *z,
+                        T *xOut, T *yOut, T *zOut,
+                        size_t size)
+{
+    transform_batch_run(size, [&](size_t ini, size_t end) {
+        transform_batch_3d_block(m, x, y, z, xOut, yOut, zOut, ini, end);
+    });
+}
+
+/*!
+ * \brief Per axis transformation xOut = a * x + b (scaling and translation)
+ */
+template<typename T>
+void transform_batch_axis(T a, T b,
+                          const T *x, T *xOut,
+                          size_t size)
+{
+    transform_batch_run(size, [&](size_t ini, size_t end) {
+        transform_batch_axis_block(a, b, x, xOut, ini, end);
+    });
+}
+
+} // namespace internal
+
+/// \endcond
+
+/*! \} */ // end of Geometry
+
+/*! \} */ // end of Math
+
+} // End namespace tl
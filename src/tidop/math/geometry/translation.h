@@ -30,6 +30,7 @@
 #include "tidop/math/algebra/matrix.h"
 #include "tidop/math/algebra/svd.h"
 #include "tidop/geometry/entities/point.h"
+#include "tidop/math/geometry/transform_batch.h"
 
 namespace tl
 {
@@ -105,6 +106,34 @@ public:
     template<size_t _row, size_t _col>
     auto transform(const Matrix<T, _row, _col> &matrix) const -> Matrix<T, _row, _col>;
 
+    /*!
+     * \brief Transform a 2D point set stored as separate coordinate arrays
+     * The output arrays can be the same as the input arrays. Large point
+     * sets are split in blocks that are transformed in parallel.
+     * \param[in] x X coordinates
+     * \param[in] y Y coordinates
+     * \param[out] xOut Transformed X coordinates
+     * \param[out] yOut Transformed Y coordinates
+     * \param[in] size Number of points
+     */
+    void transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const;
+
+    /*!
+     * \brief Transform a 3D point set stored as separate coordinate arrays
+     * \see transform(const T *, const T *, T *, T *, size_t)
+     */
+    void transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 2D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, size_t size) const;
+
+    /*!
+     * \brief In-place transformation of a 3D point set stored as separate coordinate arrays
+     */
+    void transform(T *x, T *y, T *z, size_t size) const;
+
     auto operator * (const Point<T> &point) const -> Point<T>;
     auto operator * (const Point3<T> &point) const -> Point3<T>;
     template<size_t _size>
@@ -328,6 +357,37 @@ auto Translation<T, Dim>::transform(const Matrix<T, _row, _col> &matrix) const -
     return aux;
 }
 
+template<typename T, size_t Dim>
+void Translation<T, Dim>::transform(const T *x, const T *y, T *xOut, T *yOut, size_t size) const
+{
+    static_assert(dimensions == 2, "Transformation only allowed for 2D points");
+
+    internal::transform_batch_axis(consts::one<T>, translation[0], x, xOut, size);
+    internal::transform_batch_axis(consts::one<T>, translation[1], y, yOut, size);
+}
+
+template<typename T, size_t Dim>
+void Translation<T, Dim>::transform(const T *x, const T *y, const T *z, T *xOut, T *yOut, T *zOut, size_t size) const
+{
+    static_assert(dimensions == 3, "Transformation only allowed for 3D points");
+
+    internal::transform_batch_axis(consts::one<T>, translation[0], x, xOut, size);
+    internal::transform_batch_axis(consts::one<T>, translation[1], y, yOut, size);
+    internal::transform_batch_axis(consts::one<T>, translation[2], z, zOut, size);
+}
+
+template<typename T, size_t Dim>
+void Translation<T, Dim>::transform(T *x, T *y, size_t size) const
+{
+    this->transform(x, y, x, y, size);
+}
+
+template<typename T, size_t Dim>
+void Translation<T, Dim>::transform(T *x, T *y, T *z, size_t size) const
+{
+    this->transform(x, y, z, x, y, z, size);
+}
+
 template<typename T, size_t Dim>
 auto Translation<T, Dim>::operator * (const Point<T> &point) const -> Point<T>
 {
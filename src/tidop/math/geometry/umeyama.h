@@ -54,6 +54,10 @@ namespace tl
  * and Machine Intelligence, vol. 13, no. 4, pp. 376-380, April 1991,
  * doi: 10.1109/34.88573.
  * https://web.stanford.edu/class/cs273/refs/umeyama.pdf
+ *
+ * With Precision::fast the covariance matrices are computed in float with
+ * double accumulation and the solution is refined in double (see
+ * mixed_precision.h).
  */
 template <typename T, size_t Dim>
 class Umeyama
@@ -74,7 +78,8 @@ public:
 
     template<size_t rows, size_t cols>
     static auto estimate(const Matrix<T, rows, cols> &src,
-                         const Matrix<T, rows, cols> &dst) -> Affine<T, Dim>
+                         const Matrix<T, rows, cols> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, Dim>
     {     
         Affine<T, Dim> affine;
         
@@ -84,6 +89,19 @@ public:
             TL_ASSERT(dst.cols() == dimensions, "Invalid matrix columns size");
             TL_ASSERT(src.rows() == dst.rows(), "Different matrix sizes");
 
+            if (precision == Precision::fast) {
+
+                Matrix<double, dimensions, dimensions + 1> transform = internal::mixed_precision_estimate<dimensions>(src, dst, similarity);
+
+                for (size_t r = 0; r < dimensions; r++) {
+                    for (size_t c = 0; c <= dimensions; c++) {
+                        affine(r, c) = static_cast<T>(transform(r, c));
+                    }
+                }
+
+                return affine;
+            }
+
             auto transformMatrix = Matrix<double, matrix_size, matrix_size>::identity();
 
             size_t size = src.rows();
@@ -153,7 +171,8 @@ public:
     }
 
     static auto estimate(const std::vector<Point3<T>> &src,
-                         const std::vector<Point3<T>> &dst) -> Affine<T, Dim>
+                         const std::vector<Point3<T>> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, Dim>
     {
         Affine<T, Dim> affine;
 
@@ -174,7 +193,7 @@ public:
                 dst_mat[r][2] = dst[r].z;
             }
 
-            affine = Umeyama<T, dimensions>::estimate(src_mat, dst_mat);
+            affine = Umeyama<T, dimensions>::estimate(src_mat, dst_mat, precision);
 
         } catch (...) {
             TL_THROW_EXCEPTION_WITH_NESTED("");
@@ -184,7 +203,8 @@ public:
     }
 
     static auto estimate(const std::vector<Point<T>> &src,
-                         const std::vector<Point<T>> &dst) -> Affine<T, Dim>
+                         const std::vector<Point<T>> &dst,
+                         Precision precision = Precision::exact) -> Affine<T, Dim>
     {
         Affine<T, Dim> affine;
 
@@ -203,7 +223,7 @@ public:
                 dst_mat[r][1] = dst[r].y;
             }
 
-            affine = Umeyama<T, dimensions>::estimate(src_mat, dst_mat);
+            affine = Umeyama<T, dimensions>::estimate(src_mat, dst_mat, precision);
 
         } catch (...) {
             TL_THROW_EXCEPTION_WITH_NESTED("");
@@ -211,6 +231,48 @@ public:
 
         return affine;
     }
+
+private:
+
+    /*!
+     * \brief Scaled rotation from the Gram and cross matrices of the centered points
+     */
+    static auto similarity(const Matrix<double, dimensions, dimensions> &gram,
+                           const Matrix<double, dimensions, dimensions> &cross,
+                           size_t size) -> Matrix<double, dimensions, dimensions>
+    {
+        Matrix<double> sigma = cross / static_cast<double>(size);
+        SingularValueDecomposition<Matrix<double>> svd(sigma);
+
+        Matrix<double, dimensions, dimensions> S = Matrix<double, dimensions, dimensions>::identity();
+        if (sigma.determinant() < 0) {
+            S[dimensions - 1][dimensions - 1] = -1;
+        }
+
+        if (sigma.rank() == dimensions - 1) {
+            if (svd.u().determinant() * svd.v().determinant() < 0)
+                S[dimensions - 1][dimensions - 1] = -1;
+        }
+
+        double src_var = 0.;
+        for (size_t i = 0; i < dimensions; i++)
+            src_var += gram(i, i);
+        src_var /= static_cast<double>(size);
+
+        TL_ASSERT(src_var > 0., "Degenerate configuration of points");
+
+        double scale = svd.w().dotProduct(S.diagonal()) / src_var;
+        Matrix<double> rotation = svd.u() * S * svd.v().transpose();
+
+        Matrix<double, dimensions, dimensions> a;
+        for (size_t r = 0; r < dimensions; r++) {
+            for (size_t c = 0; c < dimensions; c++) {
+                a(r, c) = scale * rotation(r, c);
+            }
+        }
+
+        return a;
+    }
 };
 
 
@@ -136,6 +136,22 @@ auto gesvd(lapack_int rows, lapack_int cols, T* a, lapack_int lda, T* s, T* u,
 }
 
 
+/* Descomposición en valores propios de matrices simétricas */
+
+template<typename T>
+auto syev(lapack_int rows, T *a, lapack_int lda, T *w) -> enableIfFloat<T, lapack_int>
+{
+    lapack_int info = LAPACKE_ssyev(LAPACK_ROW_MAJOR, 'V', 'U', rows, a, lda, w);
+    return info;
+}
+
+template<typename T>
+auto syev(lapack_int rows, T *a, lapack_int lda, T *w) -> enableIfDouble<T, lapack_int>
+{
+    lapack_int info = LAPACKE_dsyev(LAPACK_ROW_MAJOR, 'V', 'U', rows, a, lda, w);
+    return info;
+}
+
 } // End namespace lapack
 
 /*! \} */ // end of Math
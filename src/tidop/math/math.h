@@ -129,6 +129,15 @@ constexpr enableIfFloating<T,T> grad_to_deg = static_cast<T>(0.9);
 
 }
 
+/*!
+ * \brief Precision policy of the batch kernels and estimators
+ */
+enum class Precision
+{
+    exact, ///< Computed in the working type with the standard library functions
+    fast   ///< Vectorized polynomial approximations, or float computation with double accumulation
+};
+
 /*!
   * \brief "clamping" a value between a pair of boundary values
   * If value compares less than min, returns min; otherwise if max 
@@ -0,0 +1,246 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "tidop/math/math.h"
+#include "tidop/math/optimization/jet.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Optimization
+ *  \{
+ */
+
+/*!
+ * \brief Residual block of a nonlinear least squares problem
+ *
+ * A cost function computes a vector of residuals f(x1, ..., xk) from k parameter
+ * blocks and, optionally, the Jacobian of the residuals with respect to each
+ * parameter block.
+ *
+ * Cost functions with analytic derivatives derive from this class. For
+ * automatic derivatives see AutoDiffCostFunction.
+ */
+template<typename T>
+class CostFunction
+{
+
+public:
+
+    CostFunction(size_t numResiduals, std::vector<size_t> parameterBlockSizes)
+      : mNumResiduals(numResiduals),
+        mParameterBlockSizes(std::move(parameterBlockSizes))
+    {
+    }
+
+    virtual ~CostFunction() = default;
+
+    /*!
+     * \brief Evaluate the residuals and the Jacobians
+     * \param[in] parameters Parameter blocks
+     * \param[out] residuals Residuals
+     * \param[out] jacobians Jacobians of each parameter block stored in row major
+     * order (numResiduals x block size). jacobians, or any of its entries, may
+     * be null when the Jacobian is not needed
+     * \return false if the residuals can not be computed
+     */
+    virtual auto evaluate(const T *const *parameters,
+                          T *residuals,
+                          T **jacobians) const -> bool = 0;
+
+    auto numResiduals() const -> size_t
+    {
+        return mNumResiduals;
+    }
+
+    auto parameterBlockSizes() const -> const std::vector<size_t> &
+    {
+        return mParameterBlockSizes;
+    }
+
+private:
+
+    size_t mNumResiduals;
+    std::vector<size_t> mParameterBlockSizes;
+
+};
+
+
+/// \cond
+
+namespace internal
+{
+
+template<size_t... Sizes>
+struct parameter_sum;
+
+template<>
+struct parameter_sum<>
+{
+    static constexpr size_t value = 0;
+};
+
+template<size_t Size, size_t... Sizes>
+struct parameter_sum<Size, Sizes...>
+{
+    static constexpr size_t value = Size + parameter_sum<Sizes...>::value;
+};
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Cost function with forward-mode automatic derivatives
+ *
+ * The functor evaluates the residuals for any scalar type:
+ *
+ * \code
+ * struct DistanceError
+ * {
+ *     template<typename T>
+ *     bool operator()(const T *point, T *residuals) const
+ *     {
+ *         using std::sqrt;
+ *         residuals[0] = sqrt(point[0] * point[0] + point[1] * point[1]) - T(distance);
+ *         return true;
+ *     }
+ *
+ *     double distance;
+ * };
+ *
+ * auto cost = std::make_shared<AutoDiffCostFunction<DistanceError, double, 1, 2>>(DistanceError{5.});
+ * \endcode
+ *
+ * The Jacobians are obtained in a single evaluation of the functor with Jet
+ * parameters.
+ *
+ * \tparam Functor Residual functor
+ * \tparam T Scalar type
+ * \tparam Residuals Number of residuals
+ * \tparam Sizes Size of each parameter block
+ */
+template<typename Functor, typename T, size_t Residuals, size_t... Sizes>
+class AutoDiffCostFunction
+  : public CostFunction<T>
+{
+
+    static_assert(sizeof...(Sizes) > 0, "At least one parameter block is required");
+
+public:
+
+    static constexpr size_t num_parameters = internal::parameter_sum<Sizes...>::value;
+    using jet_type = Jet<T, num_parameters>;
+
+public:
+
+    explicit AutoDiffCostFunction(Functor functor)
+      : CostFunction<T>(Residuals, {Sizes...}),
+        mFunctor(std::move(functor))
+    {
+    }
+
+    ~AutoDiffCostFunction() override = default;
+
+    auto evaluate(const T *const *parameters,
+                  T *residuals,
+                  T **jacobians) const -> bool override
+    {
+        return evaluate(parameters, residuals, jacobians, std::make_index_sequence<sizeof...(Sizes)>());
+    }
+
+private:
+
+    template<size_t... I>
+    auto evaluate(const T *const *parameters,
+                  T *residuals,
+                  T **jacobians,
+                  std::index_sequence<I...>) const -> bool
+    {
+        if (jacobians == nullptr)
+            return mFunctor(parameters[I]..., residuals);
+
+        constexpr std::array<size_t, sizeof...(Sizes)> sizes{{Sizes...}};
+        std::array<size_t, sizeof...(Sizes)> offsets{};
+        for (size_t i = 1; i < sizes.size(); i++)
+            offsets[i] = offsets[i - 1] + sizes[i - 1];
+
+        std::array<jet_type, num_parameters> x;
+        for (size_t i = 0; i < sizes.size(); i++) {
+            for (size_t j = 0; j < sizes[i]; j++) {
+                size_t k = offsets[i] + j;
+                x[k] = jet_type(parameters[i][j], k);
+            }
+        }
+
+        std::array<jet_type, Residuals> f;
+
+        if (!mFunctor(static_cast<const jet_type *>(x.data() + offsets[I])..., f.data()))
+            return false;
+
+        for (size_t r = 0; r < Residuals; r++)
+            residuals[r] = f[r].a;
+
+        for (size_t i = 0; i < sizes.size(); i++) {
+            if (jacobians[i] == nullptr) continue;
+            for (size_t r = 0; r < Residuals; r++) {
+                for (size_t j = 0; j < sizes[i]; j++) {
+                    jacobians[i][r * sizes[i] + j] = f[r].v[offsets[i] + j];
+                }
+            }
+        }
+
+        return true;
+    }
+
+private:
+
+    Functor mFunctor;
+
+};
+
+template<typename Functor, typename T, size_t Residuals, size_t... Sizes>
+constexpr size_t AutoDiffCostFunction<Functor, T, Residuals, Sizes...>::num_parameters;
+
+
+/*! \} */ // end of Optimization
+
+/*! \} */ // end of Math
+
+} // End namespace tl
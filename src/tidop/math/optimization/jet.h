@@ -0,0 +1,439 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <array>
+#include <cmath>
+#include <ostream>
+
+#include "tidop/math/math.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Optimization
+ *
+ * Nonlinear optimization
+ *
+ *  \{
+ */
+
+/*!
+ * \brief Dual number for forward-mode automatic differentiation
+ *
+ * A Jet holds a value a and the derivatives v of that value with respect to
+ * N variables. The arithmetic operators and the elementary functions apply the
+ * chain rule, so a function templated on the scalar type evaluated with Jets
+ * returns its value and its gradient in a single pass.
+ *
+ * Functions written for Jets must call the elementary functions unqualified
+ * (with a `using std::sin;` declaration for the scalar case) so that the Jet
+ * overloads are found by argument-dependent lookup.
+ *
+ * \code
+ * template<typename T>
+ * T f(const T &x, const T &y)
+ * {
+ *     using std::sin;
+ *     return x * sin(y);
+ * }
+ *
+ * Jet<double, 2> x(3., 0);
+ * Jet<double, 2> y(0.5, 1);
+ * Jet<double, 2> z = f(x, y); // z.v = {sin(0.5), 3 * cos(0.5)}
+ * \endcode
+ */
+template<typename T, size_t N>
+class Jet
+{
+
+public:
+
+    using value_type = T;
+
+    static constexpr size_t size = N;
+
+public:
+
+    /*!
+     * \brief Zero value and zero derivatives
+     */
+    Jet()
+      : a(consts::zero<T>)
+    {
+        v.fill(consts::zero<T>);
+    }
+
+    /*!
+     * \brief Constant
+     */
+    explicit Jet(T value)
+      : a(value)
+    {
+        v.fill(consts::zero<T>);
+    }
+
+    /*!
+     * \brief Variable
+     * \param[in] value Value
+     * \param[in] k Index of the variable. The derivative k is 1
+     */
+    Jet(T value, size_t k)
+      : a(value)
+    {
+        v.fill(consts::zero<T>);
+        v[k] = consts::one<T>;
+    }
+
+    Jet(T value, const std::array<T, N> &derivatives)
+      : a(value),
+        v(derivatives)
+    {
+    }
+
+    auto operator+=(const Jet &jet) -> Jet &
+    {
+        a += jet.a;
+        for (size_t i = 0; i < N; i++) v[i] += jet.v[i];
+        return *this;
+    }
+
+    auto operator-=(const Jet &jet) -> Jet &
+    {
+        a -= jet.a;
+        for (size_t i = 0; i < N; i++) v[i] -= jet.v[i];
+        return *this;
+    }
+
+    auto operator*=(const Jet &jet) -> Jet &
+    {
+        for (size_t i = 0; i < N; i++) v[i] = v[i] * jet.a + a * jet.v[i];
+        a *= jet.a;
+        return *this;
+    }
+
+    auto operator/=(const Jet &jet) -> Jet &
+    {
+        T inv = consts::one<T> / jet.a;
+        a *= inv;
+        for (size_t i = 0; i < N; i++) v[i] = (v[i] - a * jet.v[i]) * inv;
+        return *this;
+    }
+
+    auto operator+=(T scalar) -> Jet &
+    {
+        a += scalar;
+        return *this;
+    }
+
+    auto operator-=(T scalar) -> Jet &
+    {
+        a -= scalar;
+        return *this;
+    }
+
+    auto operator*=(T scalar) -> Jet &
+    {
+        a *= scalar;
+        for (size_t i = 0; i < N; i++) v[i] *= scalar;
+        return *this;
+    }
+
+    auto operator/=(T scalar) -> Jet &
+    {
+        return *this *= consts::one<T> / scalar;
+    }
+
+    /* Elementary functions. They are hidden friends, so they are only found
+       by argument-dependent lookup on a Jet and don't hide the standard
+       functions for scalar arguments in unqualified calls */
+
+    friend auto abs(const Jet &jet) -> Jet
+    {
+        return jet.a < consts::zero<T> ? -jet : jet;
+    }
+
+    friend auto sqrt(const Jet &jet) -> Jet
+    {
+        T s = std::sqrt(jet.a);
+        return chain(jet, s, consts::one<T> / (static_cast<T>(2) * s));
+    }
+
+    friend auto exp(const Jet &jet) -> Jet
+    {
+        T e = std::exp(jet.a);
+        return chain(jet, e, e);
+    }
+
+    friend auto log(const Jet &jet) -> Jet
+    {
+        return chain(jet, std::log(jet.a), consts::one<T> / jet.a);
+    }
+
+    friend auto sin(const Jet &jet) -> Jet
+    {
+        return chain(jet, std::sin(jet.a), std::cos(jet.a));
+    }
+
+    friend auto cos(const Jet &jet) -> Jet
+    {
+        return chain(jet, std::cos(jet.a), -std::sin(jet.a));
+    }
+
+    friend auto tan(const Jet &jet) -> Jet
+    {
+        T t = std::tan(jet.a);
+        return chain(jet, t, consts::one<T> + t * t);
+    }
+
+    friend auto asin(const Jet &jet) -> Jet
+    {
+        return chain(jet, std::asin(jet.a), consts::one<T> / std::sqrt(consts::one<T> - jet.a * jet.a));
+    }
+
+    friend auto acos(const Jet &jet) -> Jet
+    {
+        return chain(jet, std::acos(jet.a), -consts::one<T> / std::sqrt(consts::one<T> - jet.a * jet.a));
+    }
+
+    friend auto atan(const Jet &jet) -> Jet
+    {
+        return chain(jet, std::atan(jet.a), consts::one<T> / (consts::one<T> + jet.a * jet.a));
+    }
+
+    friend auto atan2(const Jet &y, const Jet &x) -> Jet
+    {
+        T inv = consts::one<T> / (x.a * x.a + y.a * y.a);
+        Jet result(std::atan2(y.a, x.a));
+        for (size_t i = 0; i < N; i++)
+            result.v[i] = (x.a * y.v[i] - y.a * x.v[i]) * inv;
+        return result;
+    }
+
+    friend auto pow(const Jet &jet, T exponent) -> Jet
+    {
+        T p = std::pow(jet.a, exponent - consts::one<T>);
+        return chain(jet, p * jet.a, exponent * p);
+    }
+
+private:
+
+    /*!
+     * \brief Jet with value f(a) and derivatives df * v
+     */
+    static auto chain(const Jet &jet, T f, T df) -> Jet
+    {
+        Jet result(f);
+        for (size_t i = 0; i < N; i++) result.v[i] = df * jet.v[i];
+        return result;
+    }
+
+public:
+
+    /*!
+     * \brief Value
+     */
+    T a;
+
+    /*!
+     * \brief Derivatives
+     */
+    std::array<T, N> v;
+
+};
+
+template<typename T, size_t N>
+constexpr size_t Jet<T, N>::size;
+
+
+/* Arithmetic operators */
+
+template<typename T, size_t N>
+auto operator+(const Jet<T, N> &jet) -> Jet<T, N>
+{
+    return jet;
+}
+
+template<typename T, size_t N>
+auto operator-(const Jet<T, N> &jet) -> Jet<T, N>
+{
+    Jet<T, N> result(-jet.a);
+    for (size_t i = 0; i < N; i++) result.v[i] = -jet.v[i];
+    return result;
+}
+
+template<typename T, size_t N>
+auto operator+(Jet<T, N> jet1, const Jet<T, N> &jet2) -> Jet<T, N>
+{
+    return jet1 += jet2;
+}
+
+template<typename T, size_t N>
+auto operator+(Jet<T, N> jet, T scalar) -> Jet<T, N>
+{
+    return jet += scalar;
+}
+
+template<typename T, size_t N>
+auto operator+(T scalar, Jet<T, N> jet) -> Jet<T, N>
+{
+    return jet += scalar;
+}
+
+template<typename T, size_t N>
+auto operator-(Jet<T, N> jet1, const Jet<T, N> &jet2) -> Jet<T, N>
+{
+    return jet1 -= jet2;
+}
+
+template<typename T, size_t N>
+auto operator-(Jet<T, N> jet, T scalar) -> Jet<T, N>
+{
+    return jet -= scalar;
+}
+
+template<typename T, size_t N>
+auto operator-(T scalar, const Jet<T, N> &jet) -> Jet<T, N>
+{
+    Jet<T, N> result = -jet;
+    return result += scalar;
+}
+
+template<typename T, size_t N>
+auto operator*(Jet<T, N> jet1, const Jet<T, N> &jet2) -> Jet<T, N>
+{
+    return jet1 *= jet2;
+}
+
+template<typename T, size_t N>
+auto operator*(Jet<T, N> jet, T scalar) -> Jet<T, N>
+{
+    return jet *= scalar;
+}
+
+template<typename T, size_t N>
+auto operator*(T scalar, Jet<T, N> jet) -> Jet<T, N>
+{
+    return jet *= scalar;
+}
+
+template<typename T, size_t N>
+auto operator/(Jet<T, N> jet1, const Jet<T, N> &jet2) -> Jet<T, N>
+{
+    return jet1 /= jet2;
+}
+
+template<typename T, size_t N>
+auto operator/(Jet<T, N> jet, T scalar) -> Jet<T, N>
+{
+    return jet /= scalar;
+}
+
+template<typename T, size_t N>
+auto operator/(T scalar, const Jet<T, N> &jet) -> Jet<T, N>
+{
+    T inv = consts::one<T> / jet.a;
+    Jet<T, N> result(scalar * inv);
+    T factor = -result.a * inv;
+    for (size_t i = 0; i < N; i++) result.v[i] = factor * jet.v[i];
+    return result;
+}
+
+
+/* Comparison operators. Only the value is compared */
+
+template<typename T, size_t N>
+auto operator<(const Jet<T, N> &jet1, const Jet<T, N> &jet2) -> bool
+{
+    return jet1.a < jet2.a;
+}
+
+template<typename T, size_t N>
+auto operator>(const Jet<T, N> &jet1, const Jet<T, N> &jet2) -> bool
+{
+    return jet1.a > jet2.a;
+}
+
+template<typename T, size_t N>
+auto operator<=(const Jet<T, N> &jet1, const Jet<T, N> &jet2) -> bool
+{
+    return jet1.a <= jet2.a;
+}
+
+template<typename T, size_t N>
+auto operator>=(const Jet<T, N> &jet1, const Jet<T, N> &jet2) -> bool
+{
+    return jet1.a >= jet2.a;
+}
+
+template<typename T, size_t N>
+auto operator<(const Jet<T, N> &jet, T scalar) -> bool
+{
+    return jet.a < scalar;
+}
+
+template<typename T, size_t N>
+auto operator>(const Jet<T, N> &jet, T scalar) -> bool
+{
+    return jet.a > scalar;
+}
+
+template<typename T, size_t N>
+auto operator<(T scalar, const Jet<T, N> &jet) -> bool
+{
+    return scalar < jet.a;
+}
+
+template<typename T, size_t N>
+auto operator>(T scalar, const Jet<T, N> &jet) -> bool
+{
+    return scalar > jet.a;
+}
+
+
+template<typename T, size_t N>
+auto operator<<(std::ostream &os, const Jet<T, N> &jet) -> std::ostream &
+{
+    os << "[" << jet.a << "; ";
+    for (size_t i = 0; i < N; i++)
+        os << (i == 0 ? "" : ", ") << jet.v[i];
+    os << "]";
+    return os;
+}
+
+
+/*! \} */ // end of Optimization
+
+/*! \} */ // end of Math
+
+} // End namespace tl
@@ -0,0 +1,756 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "tidop/core/exception.h"
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/math.h"
+#include "tidop/math/algebra/vector.h"
+#include "tidop/math/algebra/sparse_matrix.h"
+#include "tidop/math/algebra/sparse_cholesky.h"
+#include "tidop/math/optimization/cost_function.h"
+#include "tidop/math/optimization/loss.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Optimization
+ *  \{
+ */
+
+template<typename T>
+class LevenbergMarquardt;
+
+
+/*!
+ * \brief Nonlinear least squares problem
+ *
+ * \f[ \min_x \frac{1}{2} \sum_i \rho_i(\| f_i(x_{i_1}, ..., x_{i_k}) \|^2) \f]
+ *
+ * The parameters are stored by the user and are registered in blocks through
+ * the residual blocks that use them. The problem does not own the parameter
+ * memory, which is updated in place by the solver.
+ *
+ * \code
+ * LeastSquaresProblem<double> problem;
+ * for (const auto &observation : observations) {
+ *     problem.addResidualBlock(std::make_shared<AutoDiffCostFunction<ReprojectionError, double, 2, 6, 3>>(ReprojectionError(observation)),
+ *                              std::make_shared<HuberLoss<double>>(1.),
+ *                              {camera[observation.camera].data(), points[observation.point].data()});
+ * }
+ * problem.setParameterBlockConstant(camera[0].data());
+ * \endcode
+ */
+template<typename T>
+class LeastSquaresProblem
+{
+
+    friend class LevenbergMarquardt<T>;
+
+    struct ParameterBlock
+    {
+        T *data;
+        size_t size;
+        bool constant;
+        size_t offset;
+    };
+
+    struct ResidualBlock
+    {
+        std::shared_ptr<CostFunction<T>> cost;
+        std::shared_ptr<LossFunction<T>> loss;
+        std::vector<size_t> parameters;
+        size_t offset;
+    };
+
+public:
+
+    LeastSquaresProblem() = default;
+    ~LeastSquaresProblem() = default;
+
+    /*!
+     * \brief Add a residual block
+     * \param[in] cost Cost function
+     * \param[in] loss Loss function. nullptr for least squares
+     * \param[in] parameters Parameter blocks. Their sizes must match the cost function
+     */
+    void addResidualBlock(std::shared_ptr<CostFunction<T>> cost,
+                          std::shared_ptr<LossFunction<T>> loss,
+                          const std::vector<T *> &parameters);
+
+    void setParameterBlockConstant(T *block);
+    void setParameterBlockVariable(T *block);
+
+    auto numParameterBlocks() const -> size_t;
+    auto numResidualBlocks() const -> size_t;
+    auto numResiduals() const -> size_t;
+
+    /*!
+     * \brief Number of variable parameters
+     */
+    auto numParameters() const -> size_t;
+
+    /*!
+     * \brief Cost 1/2 * sum(rho(|f|^2)) at the current parameters
+     */
+    auto cost() const -> T;
+
+private:
+
+    auto parameterBlock(T *block) -> ParameterBlock &;
+    void update();
+
+private:
+
+    std::vector<ParameterBlock> mParameterBlocks;
+    std::vector<ResidualBlock> mResidualBlocks;
+    std::unordered_map<T *, size_t> mParameterBlockIndex;
+    size_t mNumResiduals{0};
+    size_t mNumParameters{0};
+    size_t mStructureVersion{0};
+
+};
+
+
+template<typename T>
+void LeastSquaresProblem<T>::addResidualBlock(std::shared_ptr<CostFunction<T>> cost,
+                                              std::shared_ptr<LossFunction<T>> loss,
+                                              const std::vector<T *> &parameters)
+{
+    TL_ASSERT(cost, "Null cost function");
+
+    const auto &sizes = cost->parameterBlockSizes();
+    TL_ASSERT(sizes.size() == parameters.size(), "The cost function expects {} parameter blocks", sizes.size());
+
+    ResidualBlock residual_block;
+    residual_block.cost = std::move(cost);
+    residual_block.loss = std::move(loss);
+    residual_block.offset = mNumResiduals;
+
+    for (size_t i = 0; i < parameters.size(); i++) {
+
+        auto it = mParameterBlockIndex.find(parameters[i]);
+
+        if (it == mParameterBlockIndex.end()) {
+            mParameterBlockIndex[parameters[i]] = mParameterBlocks.size();
+            residual_block.parameters.push_back(mParameterBlocks.size());
+            mParameterBlocks.push_back({parameters[i], sizes[i], false, 0});
+        } else {
+            TL_ASSERT(mParameterBlocks[it->second].size == sizes[i], "Parameter block size mismatch");
+            residual_block.parameters.push_back(it->second);
+        }
+    }
+
+    mNumResiduals += residual_block.cost->numResiduals();
+    mResidualBlocks.push_back(std::move(residual_block));
+
+    update();
+}
+
+template<typename T>
+void LeastSquaresProblem<T>::setParameterBlockConstant(T *block)
+{
+    parameterBlock(block).constant = true;
+    update();
+}
+
+template<typename T>
+void LeastSquaresProblem<T>::setParameterBlockVariable(T *block)
+{
+    parameterBlock(block).constant = false;
+    update();
+}
+
+template<typename T>
+auto LeastSquaresProblem<T>::numParameterBlocks() const -> size_t
+{
+    return mParameterBlocks.size();
+}
+
+template<typename T>
+auto LeastSquaresProblem<T>::numResidualBlocks() const -> size_t
+{
+    return mResidualBlocks.size();
+}
+
+template<typename T>
+auto LeastSquaresProblem<T>::numResiduals() const -> size_t
+{
+    return mNumResiduals;
+}
+
+template<typename T>
+auto LeastSquaresProblem<T>::numParameters() const -> size_t
+{
+    return mNumParameters;
+}
+
+template<typename T>
+auto LeastSquaresProblem<T>::cost() const -> T
+{
+    T cost = consts::zero<T>;
+    std::vector<T> residuals;
+    std::vector<const T *> parameters;
+
+    for (const auto &residual_block : mResidualBlocks) {
+
+        residuals.resize(residual_block.cost->numResiduals());
+        parameters.clear();
+        for (size_t index : residual_block.parameters)
+            parameters.push_back(mParameterBlocks[index].data);
+
+        if (!residual_block.cost->evaluate(parameters.data(), residuals.data(), nullptr))
+            TL_THROW_EXCEPTION("Residual block evaluation failed");
+
+        T s = consts::zero<T>;
+        for (auto r : residuals) s += r * r;
+
+        if (residual_block.loss) {
+            T rho[3];
+            residual_block.loss->evaluate(s, rho);
+            s = rho[0];
+        }
+
+        cost += s / 2;
+    }
+
+    return cost;
+}
+
+template<typename T>
+auto LeastSquaresProblem<T>::parameterBlock(T *block) -> ParameterBlock &
+{
+    auto it = mParameterBlockIndex.find(block);
+    TL_ASSERT(it != mParameterBlockIndex.end(), "Unknown parameter block");
+    return mParameterBlocks[it->second];
+}
+
+template<typename T>
+void LeastSquaresProblem<T>::update()
+{
+    /// Columns of the variable parameter blocks in the order they were added
+    mNumParameters = 0;
+    for (auto &parameter_block : mParameterBlocks) {
+        parameter_block.offset = mNumParameters;
+        if (!parameter_block.constant)
+            mNumParameters += parameter_block.size;
+    }
+
+    mStructureVersion++;
+}
+
+
+
+/*!
+ * \brief Termination criteria of the Levenberg-Marquardt solver
+ */
+enum class LevenbergMarquardtTermination
+{
+    function_tolerance,  /*!< Relative cost decrease below functionTolerance */
+    gradient_tolerance,  /*!< Max norm of the gradient below gradientTolerance */
+    parameter_tolerance, /*!< Relative step size below parameterTolerance */
+    max_iterations,      /*!< Maximum number of iterations reached */
+    failure              /*!< The residuals could not be evaluated at the initial parameters */
+};
+
+struct LevenbergMarquardtProperties
+{
+    size_t maxIterations = 100;
+    double functionTolerance = 1e-10;
+    double gradientTolerance = 1e-10;
+    double parameterTolerance = 1e-10;
+    /*!
+     * \brief Initial damping factor, relative to the diagonal of J'J
+     */
+    double initialDamping = 1e-4;
+};
+
+template<typename T>
+struct LevenbergMarquardtSummary
+{
+    T initialCost{};
+    T finalCost{};
+    size_t iterations{0};
+    size_t successfulSteps{0};
+    LevenbergMarquardtTermination termination{LevenbergMarquardtTermination::max_iterations};
+};
+
+
+/*!
+ * \brief Levenberg-Marquardt solver
+ *
+ * Each iteration solves the damped normal equations
+ *
+ * \f[ (J^T J + \mu D) \delta = -J^T f \f]
+ *
+ * with D the diagonal of J'J and updates mu with the ratio between the actual
+ * and the predicted cost reduction (Nielsen's rule). Robust losses are applied
+ * by rescaling the residuals and the Jacobian of each residual block (Triggs
+ * correction) so the problem is solved as a weighted least squares problem.
+ *
+ * The normal equations are solved with SparseCholeskyDecomposition. The sparsity
+ * pattern of J'J does not change between iterations, so the ordering and the
+ * symbolic factorization are computed once and only the numeric factorization
+ * runs in each iteration. They are also kept between calls to solve() while the
+ * structure of the problem does not change.
+ *
+ * For problems with a block-arrow structure (bundle adjustment, network
+ * adjustments with many points and few stations) the minimum degree ordering
+ * eliminates the small point blocks first, which is the elimination order of
+ * the Schur complement.
+ */
+template<typename T>
+class LevenbergMarquardt
+{
+
+public:
+
+    explicit LevenbergMarquardt(const LevenbergMarquardtProperties &properties = LevenbergMarquardtProperties());
+
+    auto properties() const -> const LevenbergMarquardtProperties &;
+    void setProperties(const LevenbergMarquardtProperties &properties);
+
+    auto solve(LeastSquaresProblem<T> &problem) -> LevenbergMarquardtSummary<T>;
+
+private:
+
+    void prepare(const LeastSquaresProblem<T> &problem);
+    auto evaluate(const LeastSquaresProblem<T> &problem, bool jacobian) -> bool;
+
+private:
+
+    LevenbergMarquardtProperties mProperties;
+
+    /// Structure of the Jacobian
+
+    const LeastSquaresProblem<T> *mProblem;
+    size_t mStructureVersion;
+    std::vector<Triplet<T>> mJacobianTriplets;
+    std::vector<size_t> mJacobianOffsets;
+
+    /// Evaluation buffers
+
+    std::vector<T> mResiduals;
+    std::vector<T> mBlockCost;
+    std::vector<char> mBlockValid;
+    T mCost;
+
+    /// Normal equations
+
+    SparseCholeskyDecomposition<T> mCholesky;
+    std::vector<size_t> mDiagonal;
+    bool mAnalyzed;
+
+};
+
+
+/// \cond
+
+namespace internal
+{
+
+/// Minimum number of residual blocks to evaluate them in parallel
+constexpr size_t levenberg_marquardt_parallel_threshold = 1000;
+
+} // namespace internal
+
+/// \endcond
+
+
+template<typename T>
+LevenbergMarquardt<T>::LevenbergMarquardt(const LevenbergMarquardtProperties &properties)
+  : mProperties(properties),
+    mProblem(nullptr),
+    mStructureVersion(0),
+    mCost(0),
+    mAnalyzed(false)
+{
+    static_assert(std::is_floating_point<T>::value, "Integral type not supported");
+}
+
+template<typename T>
+auto LevenbergMarquardt<T>::properties() const -> const LevenbergMarquardtProperties &
+{
+    return mProperties;
+}
+
+template<typename T>
+void LevenbergMarquardt<T>::setProperties(const LevenbergMarquardtProperties &properties)
+{
+    mProperties = properties;
+}
+
+template<typename T>
+void LevenbergMarquardt<T>::prepare(const LeastSquaresProblem<T> &problem)
+{
+    if (mProblem == &problem && mStructureVersion == problem.mStructureVersion)
+        return;
+
+    mProblem = &problem;
+    mStructureVersion = problem.mStructureVersion;
+    mAnalyzed = false;
+
+    /// Jacobian triplets. The values of each block (residual block, parameter block)
+    /// are contiguous and stored in row major order
+
+    mJacobianTriplets.clear();
+    mJacobianOffsets.clear();
+
+    for (const auto &residual_block : problem.mResidualBlocks) {
+
+        size_t rows = residual_block.cost->numResiduals();
+
+        for (size_t index : residual_block.parameters) {
+
+            const auto &parameter_block = problem.mParameterBlocks[index];
+            mJacobianOffsets.push_back(mJacobianTriplets.size());
+
+            if (parameter_block.constant) continue;
+
+            for (size_t r = 0; r < rows; r++) {
+                for (size_t c = 0; c < parameter_block.size; c++) {
+                    mJacobianTriplets.push_back({residual_block.offset + r,
+                                                 parameter_block.offset + c,
+                                                 consts::zero<T>});
+                }
+            }
+        }
+    }
+
+    mResiduals.resize(problem.numResiduals());
+    mBlockCost.resize(problem.numResidualBlocks());
+    mBlockValid.resize(problem.numResidualBlocks());
+}
+
+template<typename T>
+auto LevenbergMarquardt<T>::evaluate(const LeastSquaresProblem<T> &problem, bool jacobian) -> bool
+{
+    size_t block_count = problem.mResidualBlocks.size();
+
+    std::vector<size_t> first_jacobian(block_count + 1, 0);
+    for (size_t i = 0; i < block_count; i++)
+        first_jacobian[i + 1] = first_jacobian[i] + problem.mResidualBlocks[i].parameters.size();
+
+    auto evaluate_block = [&](size_t i) {
+
+        const auto &residual_block = problem.mResidualBlocks[i];
+        size_t rows = residual_block.cost->numResiduals();
+        size_t blocks = residual_block.parameters.size();
+
+        std::vector<const T *> parameters(blocks);
+        std::vector<std::vector<T>> jacobian_blocks(blocks);
+        std::vector<T *> jacobians(blocks, nullptr);
+
+        for (size_t j = 0; j < blocks; j++) {
+            const auto &parameter_block = problem.mParameterBlocks[residual_block.parameters[j]];
+            parameters[j] = parameter_block.data;
+            if (jacobian && !parameter_block.constant) {
+                jacobian_blocks[j].resize(rows * parameter_block.size);
+                jacobians[j] = jacobian_blocks[j].data();
+            }
+        }
+
+        T *residuals = &mResiduals[residual_block.offset];
+
+        mBlockValid[i] = residual_block.cost->evaluate(parameters.data(), residuals,
+                                                       jacobian ? jacobians.data() : nullptr);
+        if (!mBlockValid[i]) return;
+
+        T s = consts::zero<T>;
+        for (size_t r = 0; r < rows; r++) s += residuals[r] * residuals[r];
+
+        T residual_scaling = consts::one<T>;
+        T alpha_s = consts::zero<T>;
+        T sqrt_rho1 = consts::one<T>;
+
+        if (residual_block.loss) {
+
+            T rho[3];
+            residual_block.loss->evaluate(s, rho);
+            mBlockCost[i] = rho[0] / 2;
+
+            sqrt_rho1 = std::sqrt(rho[1]);
+
+            if (s == consts::zero<T> || rho[2] <= consts::zero<T>) {
+                residual_scaling = sqrt_rho1;
+            } else {
+                T d = consts::one<T> + 2 * s * rho[2] / rho[1];
+                T alpha = consts::one<T> - std::sqrt(d);
+                residual_scaling = sqrt_rho1 / (consts::one<T> - alpha);
+                alpha_s = alpha / s;
+            }
+
+        } else {
+            mBlockCost[i] = s / 2;
+        }
+
+        if (jacobian) {
+
+            for (size_t j = 0; j < blocks; j++) {
+
+                if (!jacobians[j]) continue;
+
+                size_t cols = problem.mParameterBlocks[residual_block.parameters[j]].size;
+                T *jac = jacobians[j];
+
+                /// J = sqrt(rho') * (I - alpha * f * f' / |f|^2) * J
+                if (residual_block.loss) {
+                    for (size_t c = 0; c < cols; c++) {
+                        T ftj = consts::zero<T>;
+                        for (size_t r = 0; r < rows; r++) ftj += residuals[r] * jac[r * cols + c];
+                        for (size_t r = 0; r < rows; r++)
+                            jac[r * cols + c] = sqrt_rho1 * (jac[r * cols + c] - alpha_s * residuals[r] * ftj);
+                    }
+                }
+
+                Triplet<T> *triplets = &mJacobianTriplets[mJacobianOffsets[first_jacobian[i] + j]];
+                for (size_t k = 0; k < rows * cols; k++)
+                    triplets[k].value = jac[k];
+            }
+        }
+
+        if (residual_block.loss) {
+            for (size_t r = 0; r < rows; r++)
+                residuals[r] *= residual_scaling;
+        }
+    };
+
+    if (block_count >= internal::levenberg_marquardt_parallel_threshold) {
+        parallel_for(0, block_count, evaluate_block);
+    } else {
+        for (size_t i = 0; i < block_count; i++)
+            evaluate_block(i);
+    }
+
+    if (std::find(mBlockValid.begin(), mBlockValid.end(), 0) != mBlockValid.end())
+        return false;
+
+    mCost = consts::zero<T>;
+    for (auto cost : mBlockCost)
+        mCost += cost;
+
+    return std::isfinite(mCost);
+}
+
+template<typename T>
+auto LevenbergMarquardt<T>::solve(LeastSquaresProblem<T> &problem) -> LevenbergMarquardtSummary<T>
+{
+    LevenbergMarquardtSummary<T> summary;
+
+    prepare(problem);
+
+    size_t m = problem.numResiduals();
+    size_t n = problem.numParameters();
+
+    if (!evaluate(problem, true)) {
+        summary.termination = LevenbergMarquardtTermination::failure;
+        return summary;
+    }
+
+    summary.initialCost = mCost;
+    summary.finalCost = mCost;
+
+    if (n == 0) {
+        summary.termination = LevenbergMarquardtTermination::gradient_tolerance;
+        return summary;
+    }
+
+    SparseMatrixCSR<T> jacobian(m, n, mJacobianTriplets);
+    std::vector<T> gradient(n);
+    std::vector<T> step(n);
+    std::vector<T> jacobian_step(m);
+    std::vector<T> backup(n);
+    std::vector<T> scaling(n);
+
+    T mu = static_cast<T>(mProperties.initialDamping);
+    T nu = 2;
+    bool new_jacobian = true;
+    SparseMatrixCSR<T> normal;
+    SparseMatrixCSR<T> damped;
+
+    auto for_each_variable = [&problem](const std::function<void(T &, size_t)> &f) {
+        for (auto &parameter_block : problem.mParameterBlocks) {
+            if (parameter_block.constant) continue;
+            for (size_t i = 0; i < parameter_block.size; i++)
+                f(parameter_block.data[i], parameter_block.offset + i);
+        }
+    };
+
+    while (summary.iterations < mProperties.maxIterations) {
+
+        if (new_jacobian) {
+
+            jacobian.setFromTriplets(mJacobianTriplets);
+            normal = normalMatrix(jacobian);
+
+            /// Gradient J'f
+            jacobian.transposeMultiply(mResiduals.data(), gradient.data());
+
+            T max_gradient = consts::zero<T>;
+            for (auto g : gradient) max_gradient = std::max(max_gradient, std::abs(g));
+            if (max_gradient <= mProperties.gradientTolerance) {
+                summary.termination = LevenbergMarquardtTermination::gradient_tolerance;
+                break;
+            }
+
+            if (!mAnalyzed) {
+                mCholesky.analyze(normal);
+                const auto &outer = normal.outerIndex();
+                const auto &inner = normal.innerIndex();
+                mDiagonal.assign(n, 0);
+                for (size_t i = 0; i < n; i++) {
+                    auto first = inner.begin() + static_cast<std::ptrdiff_t>(outer[i]);
+                    auto last = inner.begin() + static_cast<std::ptrdiff_t>(outer[i + 1]);
+                    mDiagonal[i] = static_cast<size_t>(std::lower_bound(first, last, i) - inner.begin());
+                }
+                mAnalyzed = true;
+            }
+
+            for (size_t i = 0; i < n; i++)
+                scaling[i] = std::min(std::max(normal.values()[mDiagonal[i]], static_cast<T>(1e-6)), static_cast<T>(1e32));
+
+            new_jacobian = false;
+        }
+
+        summary.iterations++;
+
+        /// Damped normal equations
+
+        damped = normal;
+        for (size_t i = 0; i < n; i++)
+            damped.values()[mDiagonal[i]] += mu * scaling[i];
+
+        bool factorized = true;
+        try {
+            mCholesky.factorize(damped);
+        } catch (...) {
+            factorized = false;
+        }
+
+        if (!factorized) {
+            mu *= nu;
+            nu *= 2;
+            continue;
+        }
+
+        Vector<T> rhs(n);
+        for (size_t i = 0; i < n; i++) rhs[i] = -gradient[i];
+        Vector<T> delta = mCholesky.solve(rhs);
+
+        T step_norm = consts::zero<T>;
+        T x_norm = consts::zero<T>;
+        for_each_variable([&](T &x, size_t i) {
+            step[i] = delta[i];
+            step_norm += delta[i] * delta[i];
+            x_norm += x * x;
+        });
+
+        step_norm = std::sqrt(step_norm);
+        x_norm = std::sqrt(x_norm);
+
+        T parameter_tolerance = static_cast<T>(mProperties.parameterTolerance);
+        if (step_norm <= parameter_tolerance * (x_norm + parameter_tolerance)) {
+            summary.termination = LevenbergMarquardtTermination::parameter_tolerance;
+            break;
+        }
+
+        /// Predicted reduction -(g'd + 1/2 |J d|^2)
+
+        jacobian.multiply(step.data(), jacobian_step.data());
+        T model_change = consts::zero<T>;
+        for (size_t i = 0; i < n; i++) model_change -= gradient[i] * step[i];
+        T jd2 = consts::zero<T>;
+        for (auto value : jacobian_step) jd2 += value * value;
+        model_change -= jd2 / 2;
+
+        T cost = mCost;
+        std::vector<T> residuals = mResiduals;
+
+        for_each_variable([&](T &x, size_t i) {
+            backup[i] = x;
+            x += step[i];
+        });
+
+        bool valid = evaluate(problem, false);
+        T rho = valid && model_change > consts::zero<T> ? (cost - mCost) / model_change : -consts::one<T>;
+
+        if (rho > consts::zero<T>) {
+
+            summary.successfulSteps++;
+            summary.finalCost = mCost;
+
+            T factor = 2 * rho - 1;
+            mu *= std::max(static_cast<T>(1) / 3, consts::one<T> - factor * factor * factor);
+            nu = 2;
+
+            bool converged = cost - mCost <= mProperties.functionTolerance * cost;
+
+            evaluate(problem, true);
+            new_jacobian = true;
+
+            if (converged) {
+                summary.termination = LevenbergMarquardtTermination::function_tolerance;
+                break;
+            }
+
+        } else {
+
+            for_each_variable([&](T &x, size_t i) {
+                x = backup[i];
+            });
+
+            mCost = cost;
+            mResiduals = std::move(residuals);
+            mu *= nu;
+            nu *= 2;
+        }
+    }
+
+    summary.finalCost = mCost;
+
+    return summary;
+}
+
+
+/*! \} */ // end of Optimization
+
+/*! \} */ // end of Math
+
+} // End namespace tl
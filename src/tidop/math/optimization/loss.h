@@ -0,0 +1,186 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include "tidop/config.h"
+
+#include <cmath>
+#include <limits>
+
+#include "tidop/math/math.h"
+
+namespace tl
+{
+
+/*! \addtogroup Math
+ *  \{
+ */
+
+
+/*! \addtogroup Optimization
+ *  \{
+ */
+
+/*!
+ * \brief Loss function of a residual block
+ *
+ * A loss function rho(s) is applied to the squared norm s = |f|^2 of a residual
+ * block. The cost of the block is 1/2 * rho(s). Robust losses grow slower than s
+ * for large residuals, which reduces the influence of outliers.
+ */
+template<typename T>
+class LossFunction
+{
+
+public:
+
+    LossFunction() = default;
+    virtual ~LossFunction() = default;
+
+    /*!
+     * \brief Evaluate the loss function
+     * \param[in] s Squared norm of the residual block
+     * \param[out] rho rho(s), rho'(s) and rho''(s)
+     */
+    virtual void evaluate(T s, T rho[3]) const = 0;
+
+};
+
+
+/*!
+ * \brief Least squares loss rho(s) = s
+ */
+template<typename T>
+class TrivialLoss
+  : public LossFunction<T>
+{
+
+public:
+
+    TrivialLoss() = default;
+    ~TrivialLoss() override = default;
+
+    void evaluate(T s, T rho[3]) const override
+    {
+        rho[0] = s;
+        rho[1] = consts::one<T>;
+        rho[2] = consts::zero<T>;
+    }
+
+};
+
+
+/*!
+ * \brief Huber loss
+ *
+ * \f[ \rho(s) = s \quad s \leq \delta^2 \f]
+ * \f[ \rho(s) = 2 \delta \sqrt{s} - \delta^2 \quad s > \delta^2 \f]
+ */
+template<typename T>
+class HuberLoss
+  : public LossFunction<T>
+{
+
+public:
+
+    /*!
+     * \param[in] delta Residual norm from which the loss becomes linear
+     */
+    explicit HuberLoss(T delta)
+      : mDelta(delta),
+        mDelta2(delta * delta)
+    {
+    }
+
+    ~HuberLoss() override = default;
+
+    void evaluate(T s, T rho[3]) const override
+    {
+        if (s > mDelta2) {
+            T r = std::sqrt(s);
+            rho[0] = 2 * mDelta * r - mDelta2;
+            rho[1] = std::max(std::numeric_limits<T>::min(), mDelta / r);
+            rho[2] = -rho[1] / (2 * s);
+        } else {
+            rho[0] = s;
+            rho[1] = consts::one<T>;
+            rho[2] = consts::zero<T>;
+        }
+    }
+
+private:
+
+    T mDelta;
+    T mDelta2;
+
+};
+
+
+/*!
+ * \brief Cauchy loss
+ *
+ * \f[ \rho(s) = \delta^2 \log(1 + s / \delta^2) \f]
+ */
+template<typename T>
+class CauchyLoss
+  : public LossFunction<T>
+{
+
+public:
+
+    /*!
+     * \param[in] delta Scale of the residuals
+     */
+    explicit CauchyLoss(T delta)
+      : mDelta2(delta * delta),
+        mInvDelta2(consts::one<T> / (delta * delta))
+    {
+    }
+
+    ~CauchyLoss() override = default;
+
+    void evaluate(T s, T rho[3]) const override
+    {
+        T sum = consts::one<T> + s * mInvDelta2;
+        T inv = consts::one<T> / sum;
+        rho[0] = mDelta2 * std::log(sum);
+        rho[1] = std::max(std::numeric_limits<T>::min(), inv);
+        rho[2] = -mInvDelta2 * inv * inv;
+    }
+
+private:
+
+    T mDelta2;
+    T mInvDelta2;
+
+};
+
+
+/*! \} */ // end of Optimization
+
+/*! \} */ // end of Math
+
+} // End namespace tl
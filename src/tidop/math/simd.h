@@ -909,6 +909,126 @@ auto div(const Packed<T> &packed1, const Packed<T> &packed2) -> enableIfDouble<T
     return packed;
 }
 
+/// Multiplicación y suma fusionadas (a * b + c).
+/// Con FMA se emite una única instrucción; en otro caso se descompone en mul + add
+template<typename T>
+auto fmadd(const Packed<T> &a, const Packed<T> &b, const Packed<T> &c) -> enableIfFloat<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#if defined TL_HAVE_AVX2 && defined __FMA__
+    packed = _mm256_fmadd_ps(a, b, c);
+#elif defined TL_HAVE_AVX
+    packed = _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#elif defined TL_HAVE_SSE
+    packed = _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+
+    return packed;
+}
+
+template<typename T>
+auto fmadd(const Packed<T> &a, const Packed<T> &b, const Packed<T> &c) -> enableIfDouble<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#if defined TL_HAVE_AVX2 && defined __FMA__
+    packed = _mm256_fmadd_pd(a, b, c);
+#elif defined TL_HAVE_AVX
+    packed = _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#elif defined TL_HAVE_SSE2
+    packed = _mm_add_pd(_mm_mul_pd(a, b), c);
+#endif
+
+    return packed;
+}
+
+template<typename T>
+auto max(const Packed<T> &packed1, const Packed<T> &packed2) -> enableIfFloat<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#ifdef TL_HAVE_AVX
+    packed = _mm256_max_ps(packed1, packed2);
+#elif defined TL_HAVE_SSE
+    packed = _mm_max_ps(packed1, packed2);
+#endif
+
+    return packed;
+}
+
+template<typename T>
+auto max(const Packed<T> &packed1, const Packed<T> &packed2) -> enableIfDouble<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#ifdef TL_HAVE_AVX
+    packed = _mm256_max_pd(packed1, packed2);
+#elif defined TL_HAVE_SSE2
+    packed = _mm_max_pd(packed1, packed2);
+#endif
+
+    return packed;
+}
+
+/// Raíz cuadrada
+template<typename T>
+auto squareRoot(const Packed<T> &packed1) -> enableIfFloat<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#ifdef TL_HAVE_AVX
+    packed = _mm256_sqrt_ps(packed1);
+#elif defined TL_HAVE_SSE
+    packed = _mm_sqrt_ps(packed1);
+#endif
+
+    return packed;
+}
+
+template<typename T>
+auto squareRoot(const Packed<T> &packed1) -> enableIfDouble<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#ifdef TL_HAVE_AVX
+    packed = _mm256_sqrt_pd(packed1);
+#elif defined TL_HAVE_SSE2
+    packed = _mm_sqrt_pd(packed1);
+#endif
+
+    return packed;
+}
+
+/// Selección por elemento: packed1 donde la máscara (resultado de una comparación) está activa, packed2 en otro caso
+template<typename T>
+auto select(const Packed<T> &mask, const Packed<T> &packed1, const Packed<T> &packed2) -> enableIfFloat<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#ifdef TL_HAVE_AVX
+    packed = _mm256_blendv_ps(packed2, packed1, mask);
+#elif defined TL_HAVE_SSE
+    packed = _mm_or_ps(_mm_and_ps(mask, packed1), _mm_andnot_ps(mask, packed2));
+#endif
+
+    return packed;
+}
+
+template<typename T>
+auto select(const Packed<T> &mask, const Packed<T> &packed1, const Packed<T> &packed2) -> enableIfDouble<T, Packed<T>>
+{
+    Packed<T> packed;
+
+#ifdef TL_HAVE_AVX
+    packed = _mm256_blendv_pd(packed2, packed1, mask);
+#elif defined TL_HAVE_SSE2
+    packed = _mm_or_pd(_mm_and_pd(mask, packed1), _mm_andnot_pd(mask, packed2));
+#endif
+
+    return packed;
+}
+
 /// División entre enteros no permitida
 
 /// Suma de todos los elementos de un vector
@@ -1134,7 +1254,7 @@ auto min(const Packed<T> &packed1, const Packed<T> &packed2) -> enableIfFloat<T,
 {
     Packed<T> packed;
 
-#ifdef TL_HAVE_AVX2
+#ifdef TL_HAVE_AVX
     packed = _mm256_min_ps(packed1, packed2);
 #else
     packed = _mm_min_ps(packed1, packed2);
@@ -1148,7 +1268,7 @@ auto min(const Packed<T> &packed1, const Packed<T> &packed2) -> enableIfDouble<T
 {
     Packed<T> packed;
 
-#ifdef TL_HAVE_AVX2
+#ifdef TL_HAVE_AVX
     packed = _mm256_min_pd(packed1, packed2);
 #else
     packed = _mm_min_pd(packed1, packed2);
@@ -1698,6 +1818,18 @@ auto operator/(T scalar, const Packed<T> &packed) -> Packed<T>
     return Packed<T>(scalar) / packed;
 }
 
+/*!
+ * \brief Fused multiply-add
+ * \return a * b + c
+ */
+template<typename T>
+auto fmadd(const Packed<T> &a,
+           const Packed<T> &b,
+           const Packed<T> &c) -> Packed<T>
+{
+    return internal::fmadd(a, b, c);
+}
+
 /* Comparison Operators */
 
 
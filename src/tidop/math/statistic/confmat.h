@@ -25,7 +25,14 @@
 #pragma once
 
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <vector>
+
 #include "tidop/core/defs.h"
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/math.h"
 
 
 namespace tl
@@ -41,6 +48,30 @@ namespace tl
   */
 
 
+/*!
+ * \brief Curve obtained by sweeping the classification threshold
+ *
+ * One point per distinct score, ordered by increasing threshold.
+ */
+template<typename T>
+struct ClassificationCurve
+{
+    std::vector<T> thresholds;
+    std::vector<double> x;
+    std::vector<double> y;
+    /*! Area under the curve (trapezoidal rule) */
+    double auc = 0.;
+};
+
+
+/*!
+ * \brief Confusion matrix of a binary classifier
+ *
+ * The scores are sorted once and the number of positives below each of
+ * them is accumulated, so every threshold query is a binary search and a
+ * whole curve is a single sweep. Values lower than the threshold are
+ * classified as negatives.
+ */
 template<typename T>
 class ConfusionMatrix
 {
@@ -58,6 +89,8 @@ public:
 private:
 
     std::vector<std::pair<T, int>> mData;
+    /* Number of positives in the first i sorted scores */
+    std::vector<size_t> mCumulativePositives;
     size_t mPositives;
     size_t mNegatives;
 
@@ -157,6 +190,24 @@ public:
      */
     auto falseNegativeRate(T threshold) const -> double;
 
+    /*!
+     * \brief Receiver Operating Characteristic curve
+     * x: False Positive Rate, y: True Positive Rate
+     */
+    auto rocCurve() const -> ClassificationCurve<T>;
+
+    /*!
+     * \brief Precision-Recall curve
+     * x: Recall, y: Precision. The curve ends at recall 0 with precision 1
+     */
+    auto precisionRecallCurve() const -> ClassificationCurve<T>;
+
+    /*!
+     * \brief Detection Error Tradeoff curve
+     * x: False Positive Rate, y: False Negative Rate
+     */
+    auto detCurve() const -> ClassificationCurve<T>;
+
     static auto truePositiveRate(size_t tp, size_t fn) -> double;
     static auto falsePositiveRate(size_t fp, size_t tn) -> double;
     static auto trueNegativeRate(size_t tn, size_t fp) -> double;
@@ -174,6 +225,18 @@ private:
      */
     auto compute(T threshold) const -> std::map<Classification, size_t>;
 
+    /*!
+     * \brief Confusion matrix when the first index scores are negatives
+     */
+    void counts(size_t index, size_t &tp, size_t &fp, size_t &tn, size_t &fn) const;
+
+    /*!
+     * \brief Sweeps the distinct scores in increasing order
+     * \param[in] point Function that maps tp, fp, tn, fn to a point of the curve
+     */
+    template<typename Function>
+    auto sweep(Function point) const -> ClassificationCurve<T>;
+
 };
 
 
@@ -183,17 +246,21 @@ ConfusionMatrix<T>::ConfusionMatrix(const std::vector<std::pair<T, int>> &data)
     mPositives(0),
     mNegatives(0)
 {
-    std::sort(mData.begin(), mData.end(),
-              [](const std::pair<T, int> &data1,
-              const std::pair<T, int> &data2) {
-                  return data1.first < data2.first; });
+    parallel_sort(mData.begin(), mData.end(),
+                  [](const std::pair<T, int> &data1,
+                  const std::pair<T, int> &data2) {
+                      return data1.first < data2.first; });
+
+    mCumulativePositives.resize(mData.size() + 1);
+    mCumulativePositives[0] = 0;
 
-    for (const auto &pair : mData) {
-        if (pair.second == 1) {
+    for (size_t i = 0; i < mData.size(); i++) {
+        if (mData[i].second == 1) {
             mPositives++;
         } else {
             mNegatives++;
         }
+        mCumulativePositives[i + 1] = mPositives;
     }
 
 }
@@ -346,34 +413,47 @@ auto ConfusionMatrix<T>::accuracy(size_t tp, size_t tn, size_t positives, size_t
         -consts::one<double>;
 }
 
+template<typename T>
+auto ConfusionMatrix<T>::rocCurve() const -> ClassificationCurve<T>
+{
+    return sweep([](size_t tp, size_t fp, size_t tn, size_t fn) {
+        return std::make_pair(falsePositiveRate(fp, tn), truePositiveRate(tp, fn));
+    });
+}
+
+template<typename T>
+auto ConfusionMatrix<T>::precisionRecallCurve() const -> ClassificationCurve<T>
+{
+    return sweep([](size_t tp, size_t fp, size_t, size_t fn) {
+        /// Without predicted positives the precision is taken as 1
+        double precision = tp + fp > 0 ? positivePredictiveValue(tp, fp) : consts::one<double>;
+        return std::make_pair(truePositiveRate(tp, fn), precision);
+    });
+}
+
+template<typename T>
+auto ConfusionMatrix<T>::detCurve() const -> ClassificationCurve<T>
+{
+    return sweep([](size_t tp, size_t fp, size_t tn, size_t fn) {
+        return std::make_pair(falsePositiveRate(fp, tn), falseNegativeRate(fn, tp));
+    });
+}
+
 template<typename T>
 auto ConfusionMatrix<T>::compute(T threshold) const -> std::map<Classification, size_t>
 {
-    size_t true_positives = 0;
-    size_t false_positives = 0;
-    size_t true_negatives = 0;
-    size_t false_negatives = 0;
-
-#if CPP_VERSION >= 17
-    for (const auto &[value, tag] : mData) {
-#else
-    for (const auto &pair : mData) {
-        auto value = pair.first;
-        auto tag = pair.second;
-#endif
-
-        if (value < threshold) {
-            if (tag == 1)
-                false_negatives++;
-            else
-                true_negatives++;
-        } else {
-            if (tag == 0)
-                false_positives++;
-            else
-                true_positives++;
-        }
-    }
+    auto it = std::lower_bound(mData.begin(), mData.end(), threshold,
+                               [](const std::pair<T, int> &data, T value) {
+                                   return data.first < value;
+                               });
+
+    size_t true_positives;
+    size_t false_positives;
+    size_t true_negatives;
+    size_t false_negatives;
+
+    counts(static_cast<size_t>(std::distance(mData.begin(), it)),
+           true_positives, false_positives, true_negatives, false_negatives);
 
     std::map<Classification, size_t> confussionMatrix;
     confussionMatrix[Classification::true_positives] = true_positives;
@@ -384,6 +464,51 @@ auto ConfusionMatrix<T>::compute(T threshold) const -> std::map<Classification,
     return confussionMatrix;
 }
 
+template<typename T>
+void ConfusionMatrix<T>::counts(size_t index, size_t &tp, size_t &fp, size_t &tn, size_t &fn) const
+{
+    fn = mCumulativePositives[index];
+    tn = index - fn;
+    tp = mPositives - fn;
+    fp = mNegatives - tn;
+}
+
+template<typename T>
+template<typename Function>
+auto ConfusionMatrix<T>::sweep(Function point) const -> ClassificationCurve<T>
+{
+    ClassificationCurve<T> curve;
+
+    size_t size = mData.size();
+    if (size == 0) return curve;
+
+    size_t tp, fp, tn, fn;
+    size_t i = 0;
+
+    auto add_point = [&](T threshold) {
+        counts(i, tp, fp, tn, fn);
+        auto xy = point(tp, fp, tn, fn);
+        if (!curve.x.empty()) {
+            curve.auc += std::abs(xy.first - curve.x.back()) * (xy.second + curve.y.back()) / 2.;
+        }
+        curve.thresholds.push_back(threshold);
+        curve.x.push_back(xy.first);
+        curve.y.push_back(xy.second);
+    };
+
+    while (i < size) {
+        T threshold = mData[i].first;
+        add_point(threshold);
+        while (i < size && !(threshold < mData[i].first)) i++;
+    }
+
+    /// Every score classified as negative
+    add_point(std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                   : std::numeric_limits<T>::max());
+
+    return curve;
+}
+
 
 
 /*! \} */ // end of statistic
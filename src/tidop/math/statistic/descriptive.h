@@ -33,6 +33,7 @@
 #include "tidop/math/statistic/mean.h"
 #include "tidop/math/statistic/median.h"
 #include "tidop/math/statistic/mode.h"
+#include "tidop/math/statistic/moments.h"
 #include "tidop/math/statistic/quantile.h"
 #include "tidop/math/statistic/rms.h"
 #include "tidop/math/statistic/series.h"
@@ -50,6 +51,13 @@ namespace tl
  */
 
 
+/*!
+ * \brief Above this size min, max, mean, sum of squares and variance are
+ * obtained together in a single fused pass
+ * \see fusedMoments
+ */
+constexpr size_t descriptive_statistics_fused_threshold = 4096;
+
 template<typename T>
 class DescriptiveStatistics
 {
@@ -353,6 +361,8 @@ private:
 
     void configure();
 
+    auto useFusedMoments() const -> bool;
+    void computeFusedMoments() const;
     void computeMinMax() const;
     void computeMean() const;
     void computeSumOfSquares() const;
@@ -361,11 +371,10 @@ private:
     void computeStandarDeviation() const;
     void computeMode() const;
     void computeRange() const;
-    void computeFirstQuartile() const;
-    void computeSecondQuartile() const;
-    void computeThirdQuartile() const;
-    template<typename It>
-    void quantile(It &first, It &last) const;
+    void computeQuartiles() const;
+    auto selectionBuffer() const -> std::vector<T>;
+    template<size_t N>
+    auto equallySpacedQuantiles() const -> std::array<double, N>;
 };
 
 
@@ -464,7 +473,7 @@ template<typename T>
 auto DescriptiveStatistics<T>::median() const -> T
 {
     if (!mStatus.isEnabled(InternalStatus::median)) {
-        computeSecondQuartile();
+        computeQuartiles();
     }
 
     return mMedian;
@@ -513,14 +522,17 @@ auto DescriptiveStatistics<T>::range() const -> T
 template<typename T>
 auto DescriptiveStatistics<T>::quantile(double p) const -> double
 {
-    return tl::quantile(mData.begin(), mData.end(), p);
+    double q;
+    std::vector<T> data = selectionBuffer();
+    quantilesInPlace(data.begin(), data.end(), &p, &p + 1, &q);
+    return q;
 }
 
 template<typename T>
 auto DescriptiveStatistics<T>::firstQuartile() const -> double
 {
     if (!mStatus.isEnabled(InternalStatus::first_quartile)) {
-        computeFirstQuartile();
+        computeQuartiles();
     }
 
     return mQ1;
@@ -530,7 +542,7 @@ template<typename T>
 auto DescriptiveStatistics<T>::secondQuartile() const -> double
 {
     if (!mStatus.isEnabled(InternalStatus::second_quartile)) {
-        computeSecondQuartile();
+        computeQuartiles();
     }
 
     return mQ2;
@@ -540,7 +552,7 @@ template<typename T>
 auto DescriptiveStatistics<T>::thirdQuartile() const -> double
 {
     if (!mStatus.isEnabled(InternalStatus::third_quartile)) {
-        computeThirdQuartile();
+        computeQuartiles();
     }
 
     return mQ3;
@@ -555,32 +567,19 @@ auto DescriptiveStatistics<T>::quartiles() const -> std::array<double, 3>
 template<typename T>
 auto DescriptiveStatistics<T>::quintiles() const -> std::array<double, 4>
 {
-    double q1 = quantile(0.2);
-    double q2 = quantile(0.4);
-    double q3 = quantile(0.6);
-    double q4 = quantile(0.8);
-    
-    return std::array<double, 4>{q1, q2, q3, q4};
+    return equallySpacedQuantiles<4>();
 }
 
 template<typename T>
 auto DescriptiveStatistics<T>::deciles() const -> std::array<double, 9>
 {
-    std::array<double, 9> _deciles{};
-
-    quantile(_deciles.begin(), _deciles.end());
-
-    return _deciles;
+    return equallySpacedQuantiles<9>();
 }
 
 template<typename T>
 auto DescriptiveStatistics<T>::percentiles() const -> std::array<double, 99>
 {
-    std::array<double, 99> _percentiles{};
-
-    quantile(_percentiles.begin(), _percentiles.end());
-
-    return _percentiles;
+    return equallySpacedQuantiles<99>();
 }
 
 template<typename T>
@@ -620,7 +619,11 @@ auto DescriptiveStatistics<T>::medianAbsoluteDeviation() const -> double
         *x_it++ = std::abs(static_cast<double>(data) - _median);
     }
 
-    return tl::median(x.begin(), x.end());
+    double p = 0.5;
+    double mad;
+    quantilesInPlace(x.begin(), x.end(), &p, &p + 1, &mad);
+
+    return mad;
 }
 
 template<typename T>
@@ -780,9 +783,40 @@ void DescriptiveStatistics<T>::configure()
 
 }
 
+template<typename T>
+auto DescriptiveStatistics<T>::useFusedMoments() const -> bool
+{
+    return mData.size() >= descriptive_statistics_fused_threshold;
+}
+
+template<typename T>
+void DescriptiveStatistics<T>::computeFusedMoments() const
+{
+    FusedMoments<T> moments = fusedMoments(&(*mData.begin()), mData.size());
+
+    size_t div = mConfig.sample ? moments.count - 1 : moments.count;
+
+    mMin = moments.min;
+    mMax = moments.max;
+    mMean = moments.mean();
+    mSumOfSquares = moments.centralSumOfSquares();
+    mVariance = mSumOfSquares / static_cast<double>(div);
+
+    mStatus.enable(InternalStatus::min);
+    mStatus.enable(InternalStatus::max);
+    mStatus.enable(InternalStatus::mean);
+    mStatus.enable(InternalStatus::sum_of_squares);
+    mStatus.enable(InternalStatus::variance);
+}
+
 template<typename T>
 void DescriptiveStatistics<T>::computeMinMax() const
 {
+    if (useFusedMoments()) {
+        computeFusedMoments();
+        return;
+    }
+
     auto min_max = std::minmax_element(mData.begin(), mData.end());
     mMin = *min_max.first;
     mMax = *min_max.second;
@@ -793,6 +827,11 @@ void DescriptiveStatistics<T>::computeMinMax() const
 template<typename T>
 void DescriptiveStatistics<T>::computeMean() const
 {
+    if (useFusedMoments()) {
+        computeFusedMoments();
+        return;
+    }
+
 #ifdef TL_HAVE_SIMD_INTRINSICS
     mMean = tl::mean(mData.begin(), mData.end(), true);
 #else
@@ -804,7 +843,12 @@ void DescriptiveStatistics<T>::computeMean() const
 
 template<typename T>
 void DescriptiveStatistics<T>::computeSumOfSquares() const
-{   
+{
+    if (useFusedMoments()) {
+        computeFusedMoments();
+        return;
+    }
+
     double _mean = mean();
     size_t i{0};
 
@@ -848,6 +892,11 @@ void DescriptiveStatistics<T>::computeRootMeanSquare() const
 template<typename T>
 void DescriptiveStatistics<T>::computeVariance() const
 {
+    if (useFusedMoments()) {
+        computeFusedMoments();
+        return;
+    }
+
     size_t n = mData.size();
     TL_TODO("¿Devolver error?")
     //if (n <= 1) return consts::one<T>;
@@ -892,41 +941,48 @@ void DescriptiveStatistics<T>::computeRange() const
 }
 
 template<typename T>
-void DescriptiveStatistics<T>::computeFirstQuartile() const
+void DescriptiveStatistics<T>::computeQuartiles() const
 {
-    mQ1 = tl::quantile(mData.begin(), mData.end(), 0.25);
-    mStatus.enable(InternalStatus::first_quartile);
-}
+    std::array<double, 3> p{0.25, 0.5, 0.75};
+    std::array<double, 3> q{};
 
-template<typename T>
-void DescriptiveStatistics<T>::computeSecondQuartile() const
-{
-    mQ2 = tl::quantile(mData.begin(), mData.end(), 0.5);
+    std::vector<T> data = selectionBuffer();
+    quantilesInPlace(data.begin(), data.end(), p.begin(), p.end(), q.begin());
+
+    mQ1 = q[0];
+    mQ2 = q[1];
+    mQ3 = q[2];
     mMedian = static_cast<T>(mQ2);
+    mStatus.enable(InternalStatus::first_quartile);
     mStatus.enable(InternalStatus::second_quartile);
+    mStatus.enable(InternalStatus::third_quartile);
     mStatus.enable(InternalStatus::median);
 }
 
+/* Copy of the data for the quantile selections, which reorder it. It is not
+   kept: the quartiles are cached and the data isn't duplicated for the life
+   of the object */
 template<typename T>
-void DescriptiveStatistics<T>::computeThirdQuartile() const
+auto DescriptiveStatistics<T>::selectionBuffer() const -> std::vector<T>
 {
-    mQ3 = tl::quantile(mData.begin(), mData.end(), 0.75);
-    mStatus.enable(InternalStatus::third_quartile);
+    return std::vector<T>(mData.begin(), mData.end());
 }
 
-
 template<typename T>
-template<typename It>
-void DescriptiveStatistics<T>::quantile(It &first, It &last) const
+template<size_t N>
+auto DescriptiveStatistics<T>::equallySpacedQuantiles() const -> std::array<double, N>
 {
-    auto n = std::distance(first, last);
+    std::array<double, N> p{};
+    std::array<double, N> q{};
 
-    double step = (static_cast<double>(n) + 1.) / 10.;
-    double p = 0.;
-    for (size_t i = 0; i < n; i++) {
-        p += step;
-        *first++ = quantile(p);
+    for (size_t i = 0; i < N; i++) {
+        p[i] = static_cast<double>(i + 1) / static_cast<double>(N + 1);
     }
+
+    std::vector<T> data = selectionBuffer();
+    quantilesInPlace(data.begin(), data.end(), p.begin(), p.end(), q.begin());
+
+    return q;
 }
 
 
@@ -51,10 +51,11 @@ namespace tl
 template<typename It>
 auto interquartileRange(It first, It last) -> enableIfIntegral<iteratorValueType<It>, double>
 {
-    double q1 = tl::quantile(first, last, 0.25);
-    double q3 = tl::quantile(first, last, 0.75);
+    std::array<double, 2> p{0.25, 0.75};
+    std::array<double, 2> q{};
+    tl::quantiles(first, last, p.begin(), p.end(), q.begin());
 
-    return q3 - q1;
+    return q[1] - q[0];
 }
 
 template<typename It>
@@ -63,10 +64,11 @@ auto interquartileRange(It first, It last) -> enableIfFloating<iteratorValueType
 {
     using T = std::remove_cv_t<iteratorValueType<It>>;
 
-    T q1 = tl::quantile(first, last, 0.25);
-    T q3 = tl::quantile(first, last, 0.75);
+    std::array<double, 2> p{0.25, 0.75};
+    std::array<T, 2> q{};
+    tl::quantiles(first, last, p.begin(), p.end(), q.begin());
 
-    return q3 - q1;
+    return q[1] - q[0];
 }
 
 
@@ -100,7 +100,11 @@ auto medianAbsoluteDeviation(It first, It last) -> enableIfIntegral<iteratorValu
         *x_it++ = std::abs(static_cast<double>(*first++) - _median);
     }
 
-    return median(x.begin(), x.end());
+    double p = 0.5;
+    double mad;
+    quantilesInPlace(x.begin(), x.end(), &p, &p + 1, &mad);
+
+    return mad;
 }
 
 template<typename It>
@@ -123,7 +127,11 @@ auto medianAbsoluteDeviation(It first, It last) -> enableIfFloating<iteratorValu
         *x_it++ = std::abs(*first++ - _median);
     }
 
-    return median(x.begin(), x.end());
+    double p = 0.5;
+    T mad;
+    quantilesInPlace(x.begin(), x.end(), &p, &p + 1, &mad);
+
+    return mad;
 }
 
 
@@ -0,0 +1,381 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "tidop/core/defs.h"
+#include "tidop/core/concurrency/parallel.h"
+#include "tidop/math/math.h"
+#include "tidop/math/simd.h"
+
+namespace tl
+{
+
+/*! \addtogroup math
+ *  \{
+ */
+
+
+/*! \addtogroup statistics Statistics
+ *  \{
+ */
+
+/*!
+ * \brief Moments of a data set obtained in a single pass
+ *
+ * The sums are accumulated over the values shifted by an estimate of the
+ * mean, so the sum of squared deviations does not suffer cancellation.
+ */
+template<typename T>
+struct FusedMoments
+{
+    size_t count{};
+    T min{};
+    T max{};
+    /*! Shift applied to the values */
+    double shift{};
+    /*! \f[ \sum_{i=1}^{n}(x_i - shift) \f] */
+    double sum{};
+    /*! \f[ \sum_{i=1}^{n}(x_i - shift)^{2} \f] */
+    double sum_of_squares{};
+
+    auto mean() const -> double
+    {
+        return count == 0 ? consts::zero<double> : shift + sum / static_cast<double>(count);
+    }
+
+    /*!
+     * \brief Sum of squared differences from the mean
+     * \f[ SS = \sum_{i=1}^{n}(x_i - \overline{x})^{2} \f]
+     */
+    auto centralSumOfSquares() const -> double
+    {
+        if (count == 0) return consts::zero<double>;
+        double ss = sum_of_squares - sum * sum / static_cast<double>(count);
+        return std::max(ss, consts::zero<double>);
+    }
+};
+
+
+/// \cond
+
+namespace internal
+{
+
+/*!
+ * \brief Arrays of this size or larger are processed in parallel
+ */
+constexpr size_t fused_moments_parallel_threshold = 1 << 20;
+
+/*!
+ * \brief Size of the blocks reduced independently. The blocks do not depend
+ * on the number of threads, so the result is the same on any machine.
+ */
+constexpr size_t fused_moments_block_size = 1 << 16;
+
+/*!
+ * \brief Compensated (Kahan) accumulator
+ */
+struct KahanSum
+{
+    double sum{};
+    double compensation{};
+
+    void add(double value)
+    {
+        double y = value - compensation;
+        double t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+    }
+};
+
+template<typename T>
+void fusedMomentsBlockScalar(const T *data, size_t size, double shift,
+                             T &min, T &max, KahanSum &sum, KahanSum &sum_of_squares)
+{
+    for (size_t i = 0; i < size; i++) {
+        T x = data[i];
+        if (x < min) min = x;
+        if (x > max) max = x;
+        double dif = static_cast<double>(x) - shift;
+        sum.add(dif);
+        sum_of_squares.add(dif * dif);
+    }
+}
+
+template<typename T>
+auto fusedMomentsBlock(const T *data, size_t size, double shift) -> FusedMoments<T>
+{
+    FusedMoments<T> moments;
+    moments.count = size;
+    moments.shift = shift;
+    moments.min = data[0];
+    moments.max = data[0];
+
+    KahanSum sum;
+    KahanSum sum_of_squares;
+
+    fusedMomentsBlockScalar(data, size, shift, moments.min, moments.max, sum, sum_of_squares);
+
+    moments.sum = sum.sum - sum.compensation;
+    moments.sum_of_squares = sum_of_squares.sum - sum_of_squares.compensation;
+
+    return moments;
+}
+
+#ifdef TL_HAVE_SIMD_INTRINSICS
+
+/*!
+ * \brief Loads Packed<double>::size() consecutive values as doubles
+ */
+inline void fusedMomentsLoad(Packed<double> &packed, const double *data)
+{
+    packed.loadUnaligned(data);
+}
+
+inline void fusedMomentsLoad(Packed<double> &packed, const float *data)
+{
+    double values[Packed<double>::size()];
+    for (size_t j = 0; j < Packed<double>::size(); j++) {
+        values[j] = static_cast<double>(data[j]);
+    }
+    packed.loadUnaligned(values);
+}
+
+/*!
+ * \brief SIMD block for float and double
+ *
+ * The values are widened to double lanes. They are summed in two sets of
+ * packed accumulators over short runs (pairwise summation), and the
+ * partial sums of each run are added to compensated (Kahan) packed
+ * totals. This keeps the cost of a plain sum, and float data gets the same
+ * accuracy as the scalar path.
+ */
+template<typename T>
+auto fusedMomentsBlockSimd(const T *data, size_t size, double shift) -> FusedMoments<T>
+{
+    constexpr size_t packed_size = Packed<double>::size();
+    constexpr size_t run_size = 32 * packed_size;
+
+    FusedMoments<T> moments;
+    moments.count = size;
+    moments.shift = shift;
+
+    size_t max_vector = (size / (2 * packed_size)) * (2 * packed_size);
+
+    KahanSum sum;
+    KahanSum sum_of_squares;
+    T min = data[0];
+    T max = data[0];
+
+    if (max_vector > 0) {
+
+        Packed<double> packed_shift(shift);
+        Packed<double> packed_min_0;
+        Packed<double> packed_max_0;
+        Packed<double> packed_min_1;
+        Packed<double> packed_max_1;
+        Packed<double> packed_sum(0.);
+        Packed<double> packed_sum_compensation(0.);
+        Packed<double> packed_squares(0.);
+        Packed<double> packed_squares_compensation(0.);
+        Packed<double> packed_x_0;
+        Packed<double> packed_x_1;
+
+        fusedMomentsLoad(packed_min_0, data);
+        packed_max_0 = packed_min_0;
+        packed_min_1 = packed_min_0;
+        packed_max_1 = packed_min_0;
+
+        auto compensated_add = [](Packed<double> &total, Packed<double> &compensation, const Packed<double> &value) {
+            Packed<double> y = value - compensation;
+            Packed<double> t = total + y;
+            compensation = (t - total) - y;
+            total = t;
+        };
+
+        for (size_t ini = 0; ini < max_vector; ini += run_size) {
+
+            size_t end = std::min(ini + run_size, max_vector);
+
+            Packed<double> run_sum_0(0.);
+            Packed<double> run_sum_1(0.);
+            Packed<double> run_squares_0(0.);
+            Packed<double> run_squares_1(0.);
+
+            for (size_t i = ini; i < end; i += 2 * packed_size) {
+
+                fusedMomentsLoad(packed_x_0, &data[i]);
+                fusedMomentsLoad(packed_x_1, &data[i + packed_size]);
+
+                packed_min_0 = internal::min(packed_min_0, packed_x_0);
+                packed_max_0 = internal::max(packed_max_0, packed_x_0);
+                packed_min_1 = internal::min(packed_min_1, packed_x_1);
+                packed_max_1 = internal::max(packed_max_1, packed_x_1);
+
+                Packed<double> dif_0 = packed_x_0 - packed_shift;
+                Packed<double> dif_1 = packed_x_1 - packed_shift;
+
+                run_sum_0 += dif_0;
+                run_sum_1 += dif_1;
+                run_squares_0 += dif_0 * dif_0;
+                run_squares_1 += dif_1 * dif_1;
+            }
+
+            compensated_add(packed_sum, packed_sum_compensation, run_sum_0 + run_sum_1);
+            compensated_add(packed_squares, packed_squares_compensation, run_squares_0 + run_squares_1);
+        }
+
+        packed_min_0 = internal::min(packed_min_0, packed_min_1);
+        packed_max_0 = internal::max(packed_max_0, packed_max_1);
+
+        double lanes_min[packed_size];
+        double lanes_max[packed_size];
+        double lanes_sum[packed_size];
+        double lanes_sum_compensation[packed_size];
+        double lanes_squares[packed_size];
+        double lanes_squares_compensation[packed_size];
+
+        packed_min_0.storeUnaligned(lanes_min);
+        packed_max_0.storeUnaligned(lanes_max);
+        packed_sum.storeUnaligned(lanes_sum);
+        packed_sum_compensation.storeUnaligned(lanes_sum_compensation);
+        packed_squares.storeUnaligned(lanes_squares);
+        packed_squares_compensation.storeUnaligned(lanes_squares_compensation);
+
+        /// The extremes are values of the data, so the conversion back to T is exact
+        for (size_t j = 0; j < packed_size; j++) {
+            min = std::min(min, static_cast<T>(lanes_min[j]));
+            max = std::max(max, static_cast<T>(lanes_max[j]));
+            sum.add(lanes_sum[j]);
+            sum.add(-lanes_sum_compensation[j]);
+            sum_of_squares.add(lanes_squares[j]);
+            sum_of_squares.add(-lanes_squares_compensation[j]);
+        }
+    }
+
+    fusedMomentsBlockScalar(data + max_vector, size - max_vector, shift, min, max, sum, sum_of_squares);
+
+    moments.min = min;
+    moments.max = max;
+    moments.sum = sum.sum - sum.compensation;
+    moments.sum_of_squares = sum_of_squares.sum - sum_of_squares.compensation;
+
+    return moments;
+}
+
+template<>
+inline auto fusedMomentsBlock<float>(const float *data, size_t size, double shift) -> FusedMoments<float>
+{
+    return fusedMomentsBlockSimd(data, size, shift);
+}
+
+template<>
+inline auto fusedMomentsBlock<double>(const double *data, size_t size, double shift) -> FusedMoments<double>
+{
+    return fusedMomentsBlockSimd(data, size, shift);
+}
+
+#endif // TL_HAVE_SIMD_INTRINSICS
+
+} // namespace internal
+
+/// \endcond
+
+
+/*!
+ * \brief Minimum, maximum, sum and sum of squares in a single pass
+ *
+ * The data is divided in blocks of fixed size that are reduced with SIMD
+ * instructions and compensated sums. Large arrays reduce the blocks in
+ * parallel, and the partial results are always combined in the same order,
+ * so the result does not depend on the number of threads.
+ *
+ * \param[in] data Contiguous data
+ * \param[in] size Number of elements
+ * \return Moments of the data
+ */
+template<typename T>
+auto fusedMoments(const T *data, size_t size) -> FusedMoments<T>
+{
+    FusedMoments<T> moments;
+
+    if (size == 0) return moments;
+
+    /// Shift by the mean of the first values
+    size_t shift_size = std::min<size_t>(size, 64);
+    double shift{};
+    for (size_t i = 0; i < shift_size; i++)
+        shift += static_cast<double>(data[i]);
+    /// Representable in T, so that the SIMD blocks subtract the same value
+    shift = static_cast<double>(static_cast<T>(shift / static_cast<double>(shift_size)));
+
+    size_t blocks = (size + internal::fused_moments_block_size - 1) / internal::fused_moments_block_size;
+    std::vector<FusedMoments<T>> partial(blocks);
+
+    auto reduce_block = [&](size_t block) {
+        size_t ini = block * internal::fused_moments_block_size;
+        size_t end = std::min(ini + internal::fused_moments_block_size, size);
+        partial[block] = internal::fusedMomentsBlock(data + ini, end - ini, shift);
+    };
+
+    if (size >= internal::fused_moments_parallel_threshold) {
+        parallel_for(0, blocks, reduce_block);
+    } else {
+        for (size_t block = 0; block < blocks; block++)
+            reduce_block(block);
+    }
+
+    internal::KahanSum sum;
+    internal::KahanSum sum_of_squares;
+
+    moments.count = size;
+    moments.shift = shift;
+    moments.min = partial[0].min;
+    moments.max = partial[0].max;
+
+    for (const auto &block : partial) {
+        moments.min = std::min(moments.min, block.min);
+        moments.max = std::max(moments.max, block.max);
+        sum.add(block.sum);
+        sum_of_squares.add(block.sum_of_squares);
+    }
+
+    moments.sum = sum.sum - sum.compensation;
+    moments.sum_of_squares = sum_of_squares.sum - sum_of_squares.compensation;
+
+    return moments;
+}
+
+
+/*! \} */ // end of statistic
+
+/*! \} */ // end of math
+
+} // End namespace tl
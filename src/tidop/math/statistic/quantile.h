@@ -24,7 +24,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "tidop/math/math.h"
+#include "tidop/core/exception.h"
+#include "tidop/core/concurrency/parallel.h"
 
 namespace tl
 {
@@ -38,58 +44,249 @@ namespace tl
  *  \{
  */
  
+/// \cond
+
+namespace internal
+{
+
 /*!
- * \brief Quantile
- * \param[in] first Iterador al inicio
- * \param[in] last Iterador al final
- * \param[in] p [0,1]
- * \return
+ * \brief Ranges larger than this are partitioned in parallel
  */
-template<typename It>
-auto quantile(It first, It last, double p) -> enableIfIntegral<iteratorValueType<It>, double>
+constexpr size_t selection_parallel_threshold = 1 << 18;
+
+template<typename T>
+using quantile_type = std::conditional_t<std::is_integral<T>::value, double, T>;
+
+/*!
+ * \brief Partitions [first, last) with the elements that satisfy the predicate first.
+ * Each thread partitions a chunk and then the misplaced elements are swapped.
+ */
+template<typename RandomIt, typename Predicate>
+auto parallelPartition(RandomIt first, RandomIt last, Predicate pred, size_t chunks) -> RandomIt
 {
-    double q;
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    chunks = std::min(chunks, n);
+
+    if (chunks <= 1) return std::partition(first, last, pred);
+
+    std::vector<size_t> begins(chunks + 1);
+    std::vector<size_t> middles(chunks);
+    for (size_t i = 0; i <= chunks; i++)
+        begins[i] = i * n / chunks;
+
+    parallel_for(0, chunks, [&](size_t i) {
+        middles[i] = static_cast<size_t>(std::distance(first, std::partition(first + begins[i], first + begins[i + 1], pred)));
+    });
+
+    size_t split = 0;
+    for (size_t i = 0; i < chunks; i++)
+        split += middles[i] - begins[i];
+
+    /// Elements that do not satisfy the predicate in [first, split) are exchanged
+    /// with the elements that satisfy it in [split, last). There are as many of each.
+    size_t left_chunk = 0;
+    size_t left = middles[0];
+    size_t right_chunk = 0;
+    size_t right = std::max(begins[0], split);
+
+    while (true) {
+
+        while (left_chunk < chunks && left >= std::min(begins[left_chunk + 1], split)) {
+            left_chunk++;
+            if (left_chunk < chunks) left = middles[left_chunk];
+        }
+        if (left_chunk >= chunks || left >= split) break;
+
+        while (right_chunk < chunks && right >= middles[right_chunk]) {
+            right_chunk++;
+            if (right_chunk < chunks) right = std::max(begins[right_chunk], split);
+        }
+        if (right_chunk >= chunks) break;
+
+        std::iter_swap(first + left++, first + right++);
+    }
 
-    auto n = std::distance(first, last);
-    std::vector<iteratorValueType<It>> sort_vector(n);
-    std::copy(first, last, sort_vector.begin());
-    std::sort(sort_vector.begin(), sort_vector.end());
+    return first + split;
+}
 
-    double idx = static_cast<double>(n + 1) * p - 1.;
-    size_t idx_1 = static_cast<size_t>(std::floor(idx));
-    size_t idx_2 = static_cast<size_t>(std::ceil(idx));
+/*!
+ * \brief Places the order statistics of ranks [rank_first, rank_last) at their
+ * sorted position. The ranks are sorted, unique and relative to first - offset.
+ * Each partition splits the pending ranks, so every element is compared
+ * O(log k) times for k ranks instead of being sorted.
+ */
+template<typename RandomIt, typename RankIt>
+void selectOrderStatistics(RandomIt first, RandomIt last,
+                           RankIt rank_first, RankIt rank_last,
+                           size_t offset)
+{
+    using T = std::remove_cv_t<iteratorValueType<RandomIt>>;
+
+    while (rank_first != rank_last && first != last) {
+
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        size_t threads = n >= selection_parallel_threshold ? optimalNumberOfThreads() : 1;
+
+        if (threads > 1) {
+
+            /// Three way partition around the median of three samples. Ranks
+            /// that fall in the band of elements equal to the pivot are already placed.
+            T a = *first;
+            T b = *(first + n / 2);
+            T c = *(last - 1);
+            T pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+            auto lower = parallelPartition(first, last, [pivot](const T &x) { return x < pivot; }, threads);
+            auto upper = parallelPartition(lower, last, [pivot](const T &x) { return !(pivot < x); }, threads);
+
+            size_t lower_rank = offset + static_cast<size_t>(std::distance(first, lower));
+            size_t upper_rank = offset + static_cast<size_t>(std::distance(first, upper));
+
+            auto rank_lower = std::lower_bound(rank_first, rank_last, lower_rank);
+            auto rank_upper = std::lower_bound(rank_lower, rank_last, upper_rank);
+
+            selectOrderStatistics(first, lower, rank_first, rank_lower, offset);
+
+            first = upper;
+            offset = upper_rank;
+            rank_first = rank_upper;
 
-    if (idx_1 == idx_2) {
-        q = static_cast<double>(sort_vector[idx_1]);
-    } else {
-        q = static_cast<double>(sort_vector[idx_1]) + static_cast<double>(sort_vector[idx_2] - sort_vector[idx_1]) * fabs(idx - static_cast<int>(idx));
+        } else {
+
+            auto rank_middle = rank_first + std::distance(rank_first, rank_last) / 2;
+            auto nth = first + static_cast<std::ptrdiff_t>(*rank_middle - offset);
+
+            std::nth_element(first, nth, last);
+
+            selectOrderStatistics(first, nth, rank_first, rank_middle, offset);
+
+            offset = *rank_middle + 1;
+            first = nth + 1;
+            rank_first = rank_middle + 1;
+        }
     }
+}
 
-    return q;
+/*!
+ * \brief Position of the p quantile between two order statistics
+ */
+inline void quantileRanks(size_t n, double p, size_t &idx_1, size_t &idx_2, double &fraction)
+{
+    double idx = static_cast<double>(n + 1) * p - 1.;
+    idx = std::min(std::max(idx, 0.), static_cast<double>(n - 1));
+    idx_1 = static_cast<size_t>(std::floor(idx));
+    idx_2 = static_cast<size_t>(std::ceil(idx));
+    fraction = idx - std::floor(idx);
 }
 
-template<typename It>
-auto quantile(It first, It last, double p) -> enableIfFloating<iteratorValueType<It>, std::remove_cv_t<iteratorValueType<It>>>
+template<typename RandomIt>
+auto interpolateQuantile(RandomIt first, size_t idx_1, size_t idx_2, double fraction)
+    -> quantile_type<std::remove_cv_t<iteratorValueType<RandomIt>>>
 {
-    using T = std::remove_cv_t<iteratorValueType<It>>;
+    using T = std::remove_cv_t<iteratorValueType<RandomIt>>;
+    using Q = quantile_type<T>;
 
-    T q;
+    T v1 = *(first + static_cast<std::ptrdiff_t>(idx_1));
 
-    auto n = std::distance(first, last);
-    std::vector<T> sort_vector(n);
-    std::copy(first, last, sort_vector.begin());
-    std::sort(sort_vector.begin(), sort_vector.end());
+    if (idx_1 == idx_2) return static_cast<Q>(v1);
 
-    double idx = static_cast<double>(n + 1) * p - 1.;
-    size_t idx_1 = static_cast<size_t>(std::floor(idx));
-    size_t idx_2 = static_cast<size_t>(std::ceil(idx));
+    T v2 = *(first + static_cast<std::ptrdiff_t>(idx_2));
+    return static_cast<Q>(v1) + static_cast<Q>(v2 - v1) * static_cast<Q>(fraction);
+}
+
+} // namespace internal
 
-    if (idx_1 == idx_2) {
-        q = sort_vector[idx_1];
-    } else {
-        q = sort_vector[idx_1] + (sort_vector[idx_2] - sort_vector[idx_1]) * static_cast<T>(fabs(idx - static_cast<int>(idx)));
+/// \endcond
+
+
+/*!
+ * \brief Quantiles of a range reordering it
+ *
+ * Computes any number of quantiles with a single selection over the range,
+ * without sorting it. The elements of the range are reordered. Large ranges
+ * are partitioned in parallel.
+ *
+ * \param[in,out] first Iterador al inicio
+ * \param[in,out] last Iterador al final
+ * \param[in] p_first Iterador al inicio de las probabilidades [0,1]
+ * \param[in] p_last Iterador al final de las probabilidades
+ * \param[out] out Iterador de salida con un cuantil por probabilidad
+ */
+template<typename RandomIt, typename ProbabilityIt, typename OutIt>
+void quantilesInPlace(RandomIt first, RandomIt last,
+                      ProbabilityIt p_first, ProbabilityIt p_last,
+                      OutIt out)
+{
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    size_t count = static_cast<size_t>(std::distance(p_first, p_last));
+
+    TL_ASSERT(n > 0, "Empty range");
+
+    std::vector<size_t> idx_1(count);
+    std::vector<size_t> idx_2(count);
+    std::vector<double> fraction(count);
+    std::vector<size_t> ranks;
+    ranks.reserve(2 * count);
+
+    size_t i = 0;
+    for (auto p = p_first; p != p_last; ++p, ++i) {
+        internal::quantileRanks(n, static_cast<double>(*p), idx_1[i], idx_2[i], fraction[i]);
+        ranks.push_back(idx_1[i]);
+        ranks.push_back(idx_2[i]);
     }
 
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    internal::selectOrderStatistics(first, last, ranks.begin(), ranks.end(), 0);
+
+    for (i = 0; i < count; i++) {
+        *out++ = internal::interpolateQuantile(first, idx_1[i], idx_2[i], fraction[i]);
+    }
+}
+
+/*!
+ * \brief Quantiles
+ *
+ * Computes all the quantiles with a single selection over one working copy
+ * of the data.
+ *
+ * \param[in] first Iterador al inicio
+ * \param[in] last Iterador al final
+ * \param[in] p_first Iterador al inicio de las probabilidades [0,1]
+ * \param[in] p_last Iterador al final de las probabilidades
+ * \param[out] out Iterador de salida con un cuantil por probabilidad
+ */
+template<typename It, typename ProbabilityIt, typename OutIt>
+void quantiles(It first, It last,
+               ProbabilityIt p_first, ProbabilityIt p_last,
+               OutIt out)
+{
+    std::vector<std::remove_cv_t<iteratorValueType<It>>> working_copy(first, last);
+
+    quantilesInPlace(working_copy.begin(), working_copy.end(), p_first, p_last, out);
+}
+
+/*!
+ * \brief Quantile
+ * \param[in] first Iterador al inicio
+ * \param[in] last Iterador al final
+ * \param[in] p [0,1]
+ * \return
+ */
+template<typename It>
+auto quantile(It first, It last, double p) -> enableIfIntegral<iteratorValueType<It>, double>
+{
+    double q;
+    quantiles(first, last, &p, &p + 1, &q);
+    return q;
+}
+
+template<typename It>
+auto quantile(It first, It last, double p) -> enableIfFloating<iteratorValueType<It>, std::remove_cv_t<iteratorValueType<It>>>
+{
+    std::remove_cv_t<iteratorValueType<It>> q;
+    quantiles(first, last, &p, &p + 1, &q);
     return q;
 }
 
@@ -103,10 +300,11 @@ auto quantile(It first, It last, double p) -> enableIfFloating<iteratorValueType
 template<typename It>
 auto quartileCoefficientOfDispersion(It first, It last) -> enableIfIntegral<iteratorValueType<It>, double>
 {
-    double q1 = quantile(first, last, 0.25);
-    double q3 = quantile(first, last, 0.75);
+    std::array<double, 2> p{0.25, 0.75};
+    std::array<double, 2> q{};
+    quantiles(first, last, p.begin(), p.end(), q.begin());
 
-    return (q3 - q1) / (q3 + q1);
+    return (q[1] - q[0]) / (q[1] + q[0]);
 }
 
 template<typename It>
@@ -114,10 +312,11 @@ auto quartileCoefficientOfDispersion(It first, It last) -> enableIfFloating<iter
 {
     using T = std::remove_cv_t<iteratorValueType<It>>;
 
-    T q1 = quantile(first, last, 0.25);
-    T q3 = quantile(first, last, 0.75);
+    std::array<double, 2> p{0.25, 0.75};
+    std::array<T, 2> q{};
+    quantiles(first, last, p.begin(), p.end(), q.begin());
 
-    return (q3 - q1) / (q3 + q1);
+    return (q[1] - q[0]) / (q[1] + q[0]);
 }
 
 
@@ -130,10 +329,11 @@ auto quartileCoefficientOfDispersion(It first, It last) -> enableIfFloating<iter
 template<typename It>
 auto quartileDeviation(It first, It last) -> enableIfIntegral<iteratorValueType<It>, double>
 {
-    double q1 = quantile(first, last, 0.25);
-    double q3 = quantile(first, last, 0.75);
+    std::array<double, 2> p{0.25, 0.75};
+    std::array<double, 2> q{};
+    quantiles(first, last, p.begin(), p.end(), q.begin());
 
-    return (q3 - q1) / consts::two<double>;
+    return (q[1] - q[0]) / consts::two<double>;
 }
 
 template<typename It>
@@ -141,10 +341,11 @@ auto quartileDeviation(It first, It last) -> enableIfFloating<iteratorValueType<
 {
     using T = std::remove_cv_t<iteratorValueType<It>>;
 
-    T q1 = quantile(first, last, 0.25);
-    T q3 = quantile(first, last, 0.75);
+    std::array<double, 2> p{0.25, 0.75};
+    std::array<T, 2> q{};
+    quantiles(first, last, p.begin(), p.end(), q.begin());
 
-    return (q3 - q1) / consts::two<T>;
+    return (q[1] - q[0]) / consts::two<T>;
 }
 
 
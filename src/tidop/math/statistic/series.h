@@ -90,6 +90,12 @@ public:
      */
     Series(std::initializer_list<std::pair<size_t, T>> data);
 
+    /*!
+     * \brief Series from a vector of data
+     * \param[in] data
+     */
+    explicit Series(std::vector<T> data);
+
     /*!
      * \brief Copy constructor
      * \param[in] series Series object to copy
@@ -178,6 +184,12 @@ Series<T>::Series(std::initializer_list<std::pair<size_t, T>> data)
     }
 }
 
+template<typename T> inline
+Series<T>::Series(std::vector<T> data)
+  : mData(std::move(data))
+{
+}
+
 template<typename T> inline
 Series<T>::Series(const Series<T> &series)
   : mIndex(series.mIndex),
@@ -0,0 +1,1019 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "tidop/core/defs.h"
+#include "tidop/core/exception.h"
+#include "tidop/math/math.h"
+
+namespace tl
+{
+
+/*! \addtogroup math
+ *  \{
+ */
+
+
+/*! \addtogroup statistics Statistics
+ *  \{
+ */
+
+
+/*!
+ * \brief Streaming quantile sketch (merging t-digest)
+ *
+ * Summarizes a stream with a bounded set of weighted centroids. The size
+ * of each centroid is limited by the arcsine scale function
+ * \f$ k(q) = \frac{\delta}{2\pi} \arcsin(2q - 1) \f$, so centroids are
+ * small near the tails and the error of extreme quantiles is low. Memory
+ * is \f$ O(\delta) \f$ independently of the number of values.
+ *
+ * Digests built over different chunks of data can be merged.
+ *
+ * The values are buffered and add() and merge() fold the buffer into the
+ * centroids when it fills up. finalize() folds the rest. The const member
+ * functions never modify the digest, so they can be called concurrently.
+ * Before finalize() they merge the buffer into a temporary copy on each
+ * call.
+ *
+ * Dunning T., Ertl O. (2019). Computing extremely accurate quantiles
+ * using t-digests.
+ */
+template<typename T>
+class TDigest
+{
+
+public:
+
+    struct Centroid
+    {
+        double mean;
+        double weight;
+    };
+
+public:
+
+    /*!
+     * \brief Constructor
+     * \param[in] compression Compression parameter \f$ \delta \f$. Higher
+     * values retain more centroids and give more accurate quantiles
+     */
+    explicit TDigest(double compression = 100.);
+
+    /*!
+     * \brief Add a value
+     * \param[in] value Value
+     * \param[in] weight Weight of the value
+     */
+    void add(T value, double weight = 1.);
+
+    /*!
+     * \brief Merge another digest
+     * \param[in] digest Digest built over another chunk of data
+     */
+    void merge(const TDigest<T> &digest);
+
+    /*!
+     * \brief Fold the buffered values into the centroids
+     * Call it after the last add() or merge() so that the queries don't
+     * merge the buffer on each call
+     */
+    void finalize();
+
+    /*!
+     * \brief Estimated quantile
+     * \param[in] p Probability [0,1]
+     * \return Quantile
+     */
+    auto quantile(double p) const -> double;
+
+    /*!
+     * \brief Estimated cumulative distribution function
+     * \param[in] value Value
+     * \return Fraction of the values lower or equal than value
+     */
+    auto cdf(double value) const -> double;
+
+    /*!
+     * \brief Total weight added to the digest
+     */
+    auto weight() const -> double;
+
+    auto compression() const -> double;
+
+    /*!
+     * \brief Centroids of the digest sorted by mean, including the buffered values
+     */
+    auto centroids() const -> std::vector<Centroid>;
+
+    auto empty() const -> bool;
+
+    void clear();
+
+private:
+
+    auto scale(double q) const -> double;
+    void compress();
+
+    /*!
+     * \brief Merge the buffer into the centroids. The buffer is left empty
+     */
+    void compress(std::vector<Centroid> &buffer, std::vector<Centroid> &centroids) const;
+
+    /*!
+     * \brief Centroids with the buffered values merged
+     * \param[out] storage Storage for the merge if the buffer isn't empty
+     */
+    auto summary(std::vector<Centroid> &storage) const -> const std::vector<Centroid> &;
+
+private:
+
+    double mCompression;
+    size_t mBufferSize;
+    std::vector<Centroid> mCentroids;
+    std::vector<Centroid> mBuffer;
+    double mWeight{};
+    double mMin;
+    double mMax;
+
+};
+
+
+/*!
+ * \brief Histogram with fixed bins
+ *
+ * The bins divide the range [lower, upper) in intervals of the same
+ * width. Values out of the range are counted as underflow or overflow.
+ * Histograms with the same layout can be merged.
+ */
+template<typename T>
+class FixedHistogram
+{
+
+public:
+
+    FixedHistogram();
+    FixedHistogram(size_t bins, double lower, double upper);
+
+    void add(T value);
+
+    /*!
+     * \brief Merge another histogram with the same bins
+     */
+    void merge(const FixedHistogram<T> &histogram);
+
+    auto bins() const -> size_t;
+    auto count(size_t bin) const -> uint64_t;
+    auto underflow() const -> uint64_t;
+    auto overflow() const -> uint64_t;
+    auto lower() const -> double;
+    auto upper() const -> double;
+    auto binWidth() const -> double;
+    auto binCenter(size_t bin) const -> double;
+
+    /*!
+     * \brief Center of the bin with the highest frequency
+     */
+    auto mode() const -> double;
+
+    void clear();
+
+private:
+
+    std::vector<uint64_t> mCounts;
+    uint64_t mUnderflow{};
+    uint64_t mOverflow{};
+    double mLower{};
+    double mUpper{};
+    double mScale{};
+
+};
+
+
+/*!
+ * \brief Single pass descriptive statistics
+ *
+ * Unlike DescriptiveStatistics the data is not stored. The first four
+ * central moments are updated with the Welford/Terriberry recurrences,
+ * quantiles are estimated with a t-digest and the mode with an optional
+ * histogram of fixed bins.
+ *
+ * Accumulators built over different chunks of data can be merged
+ * (Pébay P. (2008). Formulas for robust, one-pass parallel computation
+ * of covariances and arbitrary-order statistical moments), so the chunks
+ * can be processed in parallel.
+ *
+ * The moment based statistics use the same formulas as
+ * DescriptiveStatistics with the Fisher-Pearson skewness.
+ */
+template<typename T>
+class StreamingStatistics
+{
+
+public:
+
+    struct Config
+    {
+        bool sample = true;
+        /*! Compression of the quantile sketch */
+        double compression = 100.;
+        /*! Number of bins of the histogram. Zero disables the histogram and mode() */
+        size_t histogram_bins = 0;
+        double histogram_min = 0.;
+        double histogram_max = 0.;
+    };
+
+public:
+
+    StreamingStatistics(Config config = Config());
+
+    /*!
+     * \brief Add a value
+     */
+    void push(T value);
+
+    /*!
+     * \brief Add a range of values
+     */
+    template<typename It>
+    void push(It first, It last);
+
+    /*!
+     * \brief Merge the statistics of another chunk of data
+     * \param[in] statistics Statistics with the same configuration
+     */
+    void merge(const StreamingStatistics<T> &statistics);
+
+    /*!
+     * \brief Fold the buffered values of the digest
+     * \see TDigest::finalize
+     */
+    void finalize();
+
+    auto size() const -> size_t;
+    auto min() const -> T;
+    auto max() const -> T;
+    auto range() const -> T;
+    auto sum() const -> double;
+    auto mean() const -> double;
+    auto variance() const -> double;
+    auto standarDeviation() const -> double;
+    auto sumOfSquares() const -> double;
+    auto rootMeanSquare() const -> double;
+    auto coefficientOfVariation() const -> double;
+
+    /*!
+     * \brief Adjusted Fisher-Pearson skewness
+     */
+    auto skewness() const -> double;
+    auto kurtosis() const -> double;
+    auto kurtosisExcess() const -> double;
+
+    /*!
+     * \brief Estimated quantile
+     * \param[in] p Probability [0,1]
+     */
+    auto quantile(double p) const -> double;
+    auto median() const -> double;
+    auto firstQuartile() const -> double;
+    auto secondQuartile() const -> double;
+    auto thirdQuartile() const -> double;
+    auto quartiles() const -> std::array<double, 3>;
+    auto interquartileRange() const -> double;
+
+    /*!
+     * \brief Center of the most frequent bin of the histogram
+     * \note Requires Config::histogram_bins > 0
+     */
+    auto mode() const -> double;
+
+    auto digest() const -> const TDigest<T> &;
+    auto histogram() const -> const FixedHistogram<T> &;
+
+    auto isSample() const -> bool;
+    auto isPopulation() const -> bool;
+
+    void clear();
+
+private:
+
+    Config mConfig;
+    size_t mSize{};
+    T mMin{};
+    T mMax{};
+    double mMean{};
+    double mM2{};
+    double mM3{};
+    double mM4{};
+    TDigest<T> mDigest;
+    FixedHistogram<T> mHistogram;
+
+};
+
+
+
+/* TDigest implementation */
+
+template<typename T>
+TDigest<T>::TDigest(double compression)
+  : mCompression(compression),
+    mBufferSize(static_cast<size_t>(5. * compression)),
+    mMin(std::numeric_limits<double>::max()),
+    mMax(std::numeric_limits<double>::lowest())
+{
+    TL_ASSERT(compression > 0., "Invalid compression");
+    mBuffer.reserve(mBufferSize);
+}
+
+template<typename T>
+void TDigest<T>::add(T value, double weight)
+{
+    double x = static_cast<double>(value);
+
+    if (std::isnan(x)) return;
+
+    mBuffer.push_back({x, weight});
+    mWeight += weight;
+    mMin = std::min(mMin, x);
+    mMax = std::max(mMax, x);
+
+    if (mBuffer.size() >= mBufferSize)
+        compress();
+}
+
+template<typename T>
+void TDigest<T>::merge(const TDigest<T> &digest)
+{
+    if (digest.empty()) return;
+
+    mBuffer.insert(mBuffer.end(), digest.mCentroids.begin(), digest.mCentroids.end());
+    mBuffer.insert(mBuffer.end(), digest.mBuffer.begin(), digest.mBuffer.end());
+    mWeight += digest.mWeight;
+    mMin = std::min(mMin, digest.mMin);
+    mMax = std::max(mMax, digest.mMax);
+
+    if (mBuffer.size() >= mBufferSize)
+        compress();
+}
+
+template<typename T>
+void TDigest<T>::finalize()
+{
+    compress();
+}
+
+template<typename T>
+auto TDigest<T>::quantile(double p) const -> double
+{
+    if (empty()) return std::numeric_limits<double>::quiet_NaN();
+
+    if (p <= consts::zero<double>) return mMin;
+    if (p >= consts::one<double>) return mMax;
+
+    std::vector<Centroid> storage;
+    const std::vector<Centroid> &centroids = summary(storage);
+
+    if (centroids.size() == 1) return centroids.front().mean;
+
+    /// The centroids are placed at the center of their weight and the
+    /// extremes at the ends. The quantile is interpolated linearly.
+    double index = p * mWeight;
+
+    const Centroid &first = centroids.front();
+    if (index < first.weight / 2.) {
+        if (first.weight == consts::one<double>) return first.mean;
+        return mMin + (first.mean - mMin) * index / (first.weight / 2.);
+    }
+
+    double weight_so_far = first.weight / 2.;
+
+    for (size_t i = 0; i + 1 < centroids.size(); i++) {
+
+        const Centroid &left = centroids[i];
+        const Centroid &right = centroids[i + 1];
+        double dw = (left.weight + right.weight) / 2.;
+
+        if (weight_so_far + dw > index) {
+
+            /// Single values are exact and are not spread
+            double left_unit = left.weight == consts::one<double> ? 0.5 : 0.;
+            double right_unit = right.weight == consts::one<double> ? 0.5 : 0.;
+
+            double z1 = index - weight_so_far - left_unit;
+            double z2 = weight_so_far + dw - index - right_unit;
+
+            if (z1 <= consts::zero<double>) return left.mean;
+            if (z2 <= consts::zero<double>) return right.mean;
+
+            return (left.mean * z2 + right.mean * z1) / (z1 + z2);
+        }
+
+        weight_so_far += dw;
+    }
+
+    const Centroid &last = centroids.back();
+    if (last.weight == consts::one<double>) return last.mean;
+
+    double z = (index - weight_so_far) / (last.weight / 2.);
+    return last.mean + (mMax - last.mean) * std::min(z, consts::one<double>);
+}
+
+template<typename T>
+auto TDigest<T>::cdf(double value) const -> double
+{
+    if (empty()) return std::numeric_limits<double>::quiet_NaN();
+
+    if (value < mMin) return consts::zero<double>;
+    if (value >= mMax) return consts::one<double>;
+
+    std::vector<Centroid> storage;
+    const std::vector<Centroid> &centroids = summary(storage);
+
+    double weight_so_far = 0.;
+    double previous_mean = mMin;
+    double previous_weight = 0.;
+
+    for (const auto &centroid : centroids) {
+
+        double center = weight_so_far + centroid.weight / 2.;
+
+        if (value < centroid.mean) {
+            double previous_center = weight_so_far - previous_weight / 2.;
+            double t = (value - previous_mean) / (centroid.mean - previous_mean);
+            return (previous_center + t * (center - previous_center)) / mWeight;
+        }
+
+        previous_mean = centroid.mean;
+        previous_weight = centroid.weight;
+        weight_so_far += centroid.weight;
+    }
+
+    double previous_center = weight_so_far - previous_weight / 2.;
+    double t = (value - previous_mean) / (mMax - previous_mean);
+    return (previous_center + t * (mWeight - previous_center)) / mWeight;
+}
+
+template<typename T>
+auto TDigest<T>::weight() const -> double
+{
+    return mWeight;
+}
+
+template<typename T>
+auto TDigest<T>::compression() const -> double
+{
+    return mCompression;
+}
+
+template<typename T>
+auto TDigest<T>::centroids() const -> std::vector<Centroid>
+{
+    std::vector<Centroid> storage;
+    return summary(storage);
+}
+
+template<typename T>
+auto TDigest<T>::empty() const -> bool
+{
+    return mWeight == consts::zero<double>;
+}
+
+template<typename T>
+void TDigest<T>::clear()
+{
+    mCentroids.clear();
+    mBuffer.clear();
+    mWeight = 0.;
+    mMin = std::numeric_limits<double>::max();
+    mMax = std::numeric_limits<double>::lowest();
+}
+
+template<typename T>
+auto TDigest<T>::scale(double q) const -> double
+{
+    return mCompression / consts::two_pi<double> * std::asin(2. * q - 1.);
+}
+
+template<typename T>
+void TDigest<T>::compress()
+{
+    compress(mBuffer, mCentroids);
+}
+
+template<typename T>
+void TDigest<T>::compress(std::vector<Centroid> &buffer, std::vector<Centroid> &centroids) const
+{
+    if (buffer.empty()) return;
+
+    buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+    std::sort(buffer.begin(), buffer.end(), [](const Centroid &c1, const Centroid &c2) {
+        return c1.mean < c2.mean;
+    });
+
+    centroids.clear();
+
+    /// A centroid may grow while k(q_right) - k(q_left) <= 1. The limit is
+    /// converted to a weight with the inverse of the scale function.
+    auto weight_limit = [this](double weight_so_far) {
+        double k = scale(weight_so_far / mWeight) + consts::one<double>;
+        double q = k >= mCompression / 4. ? consts::one<double>
+                                          : (std::sin(k * consts::two_pi<double> / mCompression) + 1.) / 2.;
+        return q * mWeight;
+    };
+
+    Centroid current = buffer.front();
+    double weight_so_far = 0.;
+    double limit = weight_limit(weight_so_far);
+
+    for (size_t i = 1; i < buffer.size(); i++) {
+
+        const Centroid &centroid = buffer[i];
+
+        if (weight_so_far + current.weight + centroid.weight <= limit) {
+            current.weight += centroid.weight;
+            current.mean += (centroid.mean - current.mean) * centroid.weight / current.weight;
+        } else {
+            weight_so_far += current.weight;
+            limit = weight_limit(weight_so_far);
+            centroids.push_back(current);
+            current = centroid;
+        }
+    }
+
+    centroids.push_back(current);
+    buffer.clear();
+}
+
+template<typename T>
+auto TDigest<T>::summary(std::vector<Centroid> &storage) const -> const std::vector<Centroid> &
+{
+    if (mBuffer.empty()) return mCentroids;
+
+    std::vector<Centroid> buffer(mBuffer);
+    storage = mCentroids;
+    compress(buffer, storage);
+
+    return storage;
+}
+
+
+
+/* FixedHistogram implementation */
+
+template<typename T>
+FixedHistogram<T>::FixedHistogram()
+{
+}
+
+template<typename T>
+FixedHistogram<T>::FixedHistogram(size_t bins, double lower, double upper)
+  : mCounts(bins, 0),
+    mLower(lower),
+    mUpper(upper)
+{
+    TL_ASSERT(bins > 0, "Invalid number of bins");
+    TL_ASSERT(lower < upper, "Invalid histogram range");
+    mScale = static_cast<double>(bins) / (upper - lower);
+}
+
+template<typename T>
+void FixedHistogram<T>::add(T value)
+{
+    double x = static_cast<double>(value);
+
+    if (x < mLower) {
+        mUnderflow++;
+    } else if (x >= mUpper) {
+        mOverflow++;
+    } else {
+        size_t bin = std::min(static_cast<size_t>((x - mLower) * mScale), mCounts.size() - 1);
+        mCounts[bin]++;
+    }
+}
+
+template<typename T>
+void FixedHistogram<T>::merge(const FixedHistogram<T> &histogram)
+{
+    TL_ASSERT(mCounts.size() == histogram.mCounts.size() &&
+              mLower == histogram.mLower && mUpper == histogram.mUpper,
+              "Histograms with different bins");
+
+    for (size_t i = 0; i < mCounts.size(); i++)
+        mCounts[i] += histogram.mCounts[i];
+
+    mUnderflow += histogram.mUnderflow;
+    mOverflow += histogram.mOverflow;
+}
+
+template<typename T>
+auto FixedHistogram<T>::bins() const -> size_t
+{
+    return mCounts.size();
+}
+
+template<typename T>
+auto FixedHistogram<T>::count(size_t bin) const -> uint64_t
+{
+    return mCounts[bin];
+}
+
+template<typename T>
+auto FixedHistogram<T>::underflow() const -> uint64_t
+{
+    return mUnderflow;
+}
+
+template<typename T>
+auto FixedHistogram<T>::overflow() const -> uint64_t
+{
+    return mOverflow;
+}
+
+template<typename T>
+auto FixedHistogram<T>::lower() const -> double
+{
+    return mLower;
+}
+
+template<typename T>
+auto FixedHistogram<T>::upper() const -> double
+{
+    return mUpper;
+}
+
+template<typename T>
+auto FixedHistogram<T>::binWidth() const -> double
+{
+    return (mUpper - mLower) / static_cast<double>(mCounts.size());
+}
+
+template<typename T>
+auto FixedHistogram<T>::binCenter(size_t bin) const -> double
+{
+    return mLower + (static_cast<double>(bin) + 0.5) * binWidth();
+}
+
+template<typename T>
+auto FixedHistogram<T>::mode() const -> double
+{
+    TL_ASSERT(!mCounts.empty(), "Empty histogram");
+
+    auto max = std::max_element(mCounts.begin(), mCounts.end());
+    return binCenter(static_cast<size_t>(std::distance(mCounts.begin(), max)));
+}
+
+template<typename T>
+void FixedHistogram<T>::clear()
+{
+    std::fill(mCounts.begin(), mCounts.end(), 0);
+    mUnderflow = 0;
+    mOverflow = 0;
+}
+
+
+
+/* StreamingStatistics implementation */
+
+template<typename T>
+StreamingStatistics<T>::StreamingStatistics(Config config)
+  : mConfig(std::move(config)),
+    mDigest(mConfig.compression)
+{
+    if (mConfig.histogram_bins > 0) {
+        mHistogram = FixedHistogram<T>(mConfig.histogram_bins,
+                                       mConfig.histogram_min,
+                                       mConfig.histogram_max);
+    }
+}
+
+template<typename T>
+void StreamingStatistics<T>::push(T value)
+{
+    if (mSize == 0) {
+        mMin = value;
+        mMax = value;
+    } else {
+        if (value < mMin) mMin = value;
+        if (value > mMax) mMax = value;
+    }
+
+    /// Terriberry's extension of the Welford recurrence to the third
+    /// and fourth central moments
+    double n1 = static_cast<double>(mSize);
+    mSize++;
+    double n = static_cast<double>(mSize);
+    double delta = static_cast<double>(value) - mMean;
+    double delta_n = delta / n;
+    double delta_n2 = delta_n * delta_n;
+    double term1 = delta * delta_n * n1;
+
+    mMean += delta_n;
+    mM4 += term1 * delta_n2 * (n * n - 3. * n + 3.) + 6. * delta_n2 * mM2 - 4. * delta_n * mM3;
+    mM3 += term1 * delta_n * (n - 2.) - 3. * delta_n * mM2;
+    mM2 += term1;
+
+    mDigest.add(value);
+
+    if (mConfig.histogram_bins > 0)
+        mHistogram.add(value);
+}
+
+template<typename T>
+template<typename It>
+void StreamingStatistics<T>::push(It first, It last)
+{
+    while (first != last) {
+        push(*first++);
+    }
+}
+
+template<typename T>
+void StreamingStatistics<T>::merge(const StreamingStatistics<T> &statistics)
+{
+    if (statistics.mSize == 0) return;
+
+    if (mSize == 0) {
+        mMin = statistics.mMin;
+        mMax = statistics.mMax;
+    } else {
+        if (statistics.mMin < mMin) mMin = statistics.mMin;
+        if (statistics.mMax > mMax) mMax = statistics.mMax;
+    }
+
+    double na = static_cast<double>(mSize);
+    double nb = static_cast<double>(statistics.mSize);
+    double n = na + nb;
+    double delta = statistics.mMean - mMean;
+    double delta2 = delta * delta;
+    double delta3 = delta2 * delta;
+    double delta4 = delta2 * delta2;
+
+    double m2 = mM2 + statistics.mM2 + delta2 * na * nb / n;
+    double m3 = mM3 + statistics.mM3
+              + delta3 * na * nb * (na - nb) / (n * n)
+              + 3. * delta * (na * statistics.mM2 - nb * mM2) / n;
+    double m4 = mM4 + statistics.mM4
+              + delta4 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+              + 6. * delta2 * (na * na * statistics.mM2 + nb * nb * mM2) / (n * n)
+              + 4. * delta * (na * statistics.mM3 - nb * mM3) / n;
+
+    mMean += delta * nb / n;
+    mM2 = m2;
+    mM3 = m3;
+    mM4 = m4;
+    mSize += statistics.mSize;
+
+    mDigest.merge(statistics.mDigest);
+
+    if (mConfig.histogram_bins > 0)
+        mHistogram.merge(statistics.mHistogram);
+}
+
+template<typename T>
+void StreamingStatistics<T>::finalize()
+{
+    mDigest.finalize();
+}
+
+template<typename T>
+auto StreamingStatistics<T>::size() const -> size_t
+{
+    return mSize;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::min() const -> T
+{
+    return mMin;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::max() const -> T
+{
+    return mMax;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::range() const -> T
+{
+    return mMax - mMin;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::sum() const -> double
+{
+    return mMean * static_cast<double>(mSize);
+}
+
+template<typename T>
+auto StreamingStatistics<T>::mean() const -> double
+{
+    return mMean;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::variance() const -> double
+{
+    if (mSize <= 1) return consts::zero<double>;
+
+    size_t div = mConfig.sample ? mSize - 1 : mSize;
+
+    return mM2 / static_cast<double>(div);
+}
+
+template<typename T>
+auto StreamingStatistics<T>::standarDeviation() const -> double
+{
+    return std::sqrt(variance());
+}
+
+template<typename T>
+auto StreamingStatistics<T>::sumOfSquares() const -> double
+{
+    return mM2;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::rootMeanSquare() const -> double
+{
+    if (mSize == 0) return consts::zero<double>;
+
+    return std::sqrt(mMean * mMean + mM2 / static_cast<double>(mSize));
+}
+
+template<typename T>
+auto StreamingStatistics<T>::coefficientOfVariation() const -> double
+{
+    return standarDeviation() / std::abs(mean());
+}
+
+template<typename T>
+auto StreamingStatistics<T>::skewness() const -> double
+{
+    double n = static_cast<double>(mSize);
+    if (mSize <= (mConfig.sample ? 2u : 1u)) return consts::zero<double>;
+
+    double _variance = variance();
+    if (_variance == consts::zero<double>) return consts::zero<double>;
+
+    double _stddev = std::sqrt(_variance);
+
+    if (mConfig.sample) {
+        return mM3 * n / ((n - 1.) * (n - 2.) * _variance * _stddev);
+    } else {
+        return mM3 / (n * _variance * _stddev);
+    }
+}
+
+template<typename T>
+auto StreamingStatistics<T>::kurtosis() const -> double
+{
+    double n = static_cast<double>(mSize);
+    if (mSize <= (mConfig.sample ? 3u : 1u)) return consts::zero<double>;
+
+    double _variance = variance();
+    if (_variance == consts::zero<double>) return consts::zero<double>;
+
+    if (mConfig.sample) {
+        return n * (n + 1.) * mM4 / ((n - 1.) * (n - 2.) * (n - 3.) * _variance * _variance);
+    } else {
+        return mM4 / (n * _variance * _variance);
+    }
+}
+
+template<typename T>
+auto StreamingStatistics<T>::kurtosisExcess() const -> double
+{
+    double n = static_cast<double>(mSize);
+    if (mSize < (mConfig.sample ? 4u : 1u)) return consts::zero<double>;
+
+    if (mConfig.sample) {
+        return kurtosis() - 3. * (n - 1.) * (n - 1.) / ((n - 2.) * (n - 3.));
+    } else {
+        return kurtosis() - 3.;
+    }
+}
+
+template<typename T>
+auto StreamingStatistics<T>::quantile(double p) const -> double
+{
+    return mDigest.quantile(p);
+}
+
+template<typename T>
+auto StreamingStatistics<T>::median() const -> double
+{
+    return mDigest.quantile(0.5);
+}
+
+template<typename T>
+auto StreamingStatistics<T>::firstQuartile() const -> double
+{
+    return mDigest.quantile(0.25);
+}
+
+template<typename T>
+auto StreamingStatistics<T>::secondQuartile() const -> double
+{
+    return mDigest.quantile(0.5);
+}
+
+template<typename T>
+auto StreamingStatistics<T>::thirdQuartile() const -> double
+{
+    return mDigest.quantile(0.75);
+}
+
+template<typename T>
+auto StreamingStatistics<T>::quartiles() const -> std::array<double, 3>
+{
+    return std::array<double, 3>{firstQuartile(), secondQuartile(), thirdQuartile()};
+}
+
+template<typename T>
+auto StreamingStatistics<T>::interquartileRange() const -> double
+{
+    return thirdQuartile() - firstQuartile();
+}
+
+template<typename T>
+auto StreamingStatistics<T>::mode() const -> double
+{
+    TL_ASSERT(mConfig.histogram_bins > 0, "Histogram disabled");
+
+    return mHistogram.mode();
+}
+
+template<typename T>
+auto StreamingStatistics<T>::digest() const -> const TDigest<T> &
+{
+    return mDigest;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::histogram() const -> const FixedHistogram<T> &
+{
+    return mHistogram;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::isSample() const -> bool
+{
+    return mConfig.sample;
+}
+
+template<typename T>
+auto StreamingStatistics<T>::isPopulation() const -> bool
+{
+    return !mConfig.sample;
+}
+
+template<typename T>
+void StreamingStatistics<T>::clear()
+{
+    mSize = 0;
+    mMin = T{};
+    mMax = T{};
+    mMean = 0.;
+    mM2 = 0.;
+    mM3 = 0.;
+    mM4 = 0.;
+    mDigest.clear();
+    mHistogram.clear();
+}
+
+
+/*! \} */ // end of statistic
+
+/*! \} */ // end of math
+
+} // End namespace tl
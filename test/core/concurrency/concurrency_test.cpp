@@ -98,6 +98,22 @@ BOOST_FIXTURE_TEST_CASE(parallel_for_each_test, ConcurrencyTest)
   BOOST_CHECK_EQUAL(299, sum.sum);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_sort_test)
+{
+  std::vector<int> values(300007);
+  for (size_t i = 0; i < values.size(); i++)
+    values[i] = static_cast<int>((i * 7919) % 100003);
+
+  std::vector<int> sorted(values);
+  std::sort(sorted.begin(), sorted.end());
+
+  parallel_sort(values.begin(), values.end());
+  BOOST_CHECK(values == sorted);
+
+  parallel_sort(values.begin(), values.end(), std::greater<int>());
+  BOOST_CHECK(std::is_sorted(values.begin(), values.end(), std::greater<int>()));
+}
+
 //BOOST_FIXTURE_TEST_CASE(parallel_for_each_2_test, ConcurrencyTest)
 //{
 //  std::vector<int> aux;
@@ -216,6 +216,42 @@ BOOST_FIXTURE_TEST_CASE(roc, CurvesTest)
   BOOST_CHECK_CLOSE(0.75, mROCCurve->auc(), 0.1);
 }
 
+BOOST_FIXTURE_TEST_CASE(roc_auc_mann_whitney, CurvesTest)
+{
+  mROCCurve->compute();
+
+  // El área bajo la curva ROC completa es el estadístico U de Mann-Whitney normalizado
+  double u = 0.;
+  for (const auto &positive : data) {
+    if (positive.second != 1) continue;
+    for (const auto &negative : data) {
+      if (negative.second == 1) continue;
+      if (positive.first < negative.first) u += 1.;
+      else if (positive.first == negative.first) u += 0.5;
+    }
+  }
+  u /= static_cast<double>(mROCCurve->positives() * mROCCurve->negatives());
+
+  BOOST_CHECK_CLOSE(u, mROCCurve->auc(), 1e-9);
+
+  // El barrido termina con todas las puntuaciones clasificadas como negativas
+  auto curve = mROCCurve->curve();
+  BOOST_CHECK_EQUAL(0., curve.back().x);
+  BOOST_CHECK_EQUAL(0., curve.back().y);
+}
+
+BOOST_AUTO_TEST_CASE(roc_auc_ties)
+{
+  // Empate entre un positivo y un negativo en la menor puntuación. El último
+  // tramo de la curva aporta la mitad del empate: U = (1 + 0.5 + 1) / 4
+  std::vector<std::pair<double, int>> data{{0.1, 0}, {0.1, 1}, {0.5, 0}, {0.3, 1}};
+
+  ROCCurve<double> roc(data);
+  roc.compute();
+
+  BOOST_CHECK_CLOSE(0.625, roc.auc(), 1e-9);
+}
+
 BOOST_FIXTURE_TEST_CASE(det, CurvesTest)
 {
   BOOST_CHECK_CLOSE(0.75, mDETCurve->auc(), 0.1);
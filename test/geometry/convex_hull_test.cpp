@@ -0,0 +1,217 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop convex hull test
+#include <boost/test/unit_test.hpp>
+
+#include <tidop/geometry/algorithms/convex_hull.h>
+
+#include <cmath>
+#include <map>
+#include <random>
+
+using namespace tl;
+
+
+BOOST_AUTO_TEST_SUITE(ConvexHullTestSuite)
+
+/* Casco estrictamente convexo que contiene todos los puntos */
+template<typename Point_t>
+void checkHull(const Polygon<Point_t> &hull, const std::vector<Point_t> &points)
+{
+    size_t size = hull.size();
+    BOOST_REQUIRE(size >= 3);
+
+    for (size_t i = 0; i < size; i++) {
+        BOOST_CHECK_EQUAL(1, orientation(hull[i], hull[(i + 1) % size], hull[(i + 2) % size]));
+        BOOST_CHECK(std::find(points.begin(), points.end(), hull[i]) != points.end());
+    }
+
+    for (const auto &point : points) {
+        for (size_t i = 0; i < size; i++) {
+            BOOST_REQUIRE(orientation(hull[i], hull[(i + 1) % size], point) >= 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(degenerate)
+{
+    BOOST_CHECK_EQUAL(0, convexHull(std::vector<Point<double>>()).size());
+
+    std::vector<Point<int>> points(10, Point<int>(3, 4));
+    BOOST_CHECK_EQUAL(1, convexHull(points).size());
+
+    /* Puntos alineados: sólo los extremos */
+    std::vector<Point<int>> line;
+    for (int i = 0; i < 20; i++) line.emplace_back(i, 2 * i);
+    Polygon<Point<int>> hull = convexHull(line);
+    BOOST_REQUIRE_EQUAL(2, hull.size());
+    BOOST_CHECK(Point<int>(0, 0) == hull[0]);
+    BOOST_CHECK(Point<int>(19, 38) == hull[1]);
+
+    /* Cuadrícula: sólo las esquinas */
+    MultiPoint<Point<int>> grid;
+    for (int x = 0; x <= 10; x++)
+        for (int y = 0; y <= 10; y++)
+            grid.push_back(Point<int>(x, y));
+    hull = convexHull(grid);
+    BOOST_REQUIRE_EQUAL(4, hull.size());
+    BOOST_CHECK(Point<int>(0, 0) == hull[0]);
+    BOOST_CHECK(Point<int>(10, 0) == hull[1]);
+    BOOST_CHECK(Point<int>(10, 10) == hull[2]);
+    BOOST_CHECK(Point<int>(0, 10) == hull[3]);
+}
+
+BOOST_AUTO_TEST_CASE(random_points)
+{
+    std::mt19937 generator(5);
+    std::normal_distribution<double> normal(0., 100.);
+
+    std::vector<Point<double>> points;
+    for (size_t i = 0; i < 5000; i++)
+        points.emplace_back(normal(generator), normal(generator));
+    checkHull(convexHull(points), points);
+
+    /* Varios bloques en paralelo: mismo resultado que una única cadena monótona */
+    std::uniform_real_distribution<double> angle(0., 2. * consts::pi<double>);
+    std::uniform_real_distribution<double> radius(0., 1.);
+    points.clear();
+    for (size_t i = 0; i < 300000; i++) {
+        double a = angle(generator);
+        double r = std::sqrt(radius(generator));
+        points.emplace_back(r * std::cos(a), r * std::sin(a));
+    }
+
+    Polygon<Point<double>> hull = convexHull(points);
+    std::vector<Point<double>> all = points;
+    std::vector<Point<double>> expected = internal::convex_hull_chain(all);
+    BOOST_REQUIRE_EQUAL(expected.size(), hull.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        BOOST_CHECK(expected[i] == hull[i]);
+}
+
+BOOST_AUTO_TEST_CASE(rectangles)
+{
+    /* Rectángulo de 40 x 10 girado 30º con puntos interiores */
+    double angle = consts::pi<double> / 6.;
+    double c = std::cos(angle);
+    double s = std::sin(angle);
+    auto rotate = [&](double x, double y) {
+        return Point<double>(x * c - y * s + 100., x * s + y * c + 50.);
+    };
+
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<double> u(0., 40.);
+    std::uniform_real_distribution<double> v(0., 10.);
+    std::vector<Point<double>> points{rotate(0., 0.), rotate(40., 0.), rotate(40., 10.), rotate(0., 10.)};
+    for (size_t i = 0; i < 1000; i++)
+        points.push_back(rotate(u(generator), v(generator)));
+
+    Polygon<Point<double>> rectangle = minimumAreaRectangle(points);
+    BOOST_REQUIRE_EQUAL(4, rectangle.size());
+    BOOST_CHECK_CLOSE(400., rectangle.area(), 1e-8);
+    BOOST_CHECK_CLOSE(40., distance(rectangle[0], rectangle[1]) + distance(rectangle[1], rectangle[2]) - 10., 1e-8);
+
+    rectangle = minimumPerimeterRectangle(points);
+    BOOST_CHECK_CLOSE(400., rectangle.area(), 1e-8);
+
+    /* Rombo de diagonales 8 y 2: el rectángulo apoyado en una arista (32/√17 x 8/√17)
+       mejora en área y perímetro al alineado con las diagonales (8 x 2) */
+    std::vector<Point<double>> rhombus{Point<double>(0., -1.), Point<double>(4., 0.), Point<double>(0., 1.), Point<double>(-4., 0.)};
+    Polygon<Point<double>> area_rectangle = minimumAreaRectangle(rhombus);
+    Polygon<Point<double>> perimeter_rectangle = minimumPerimeterRectangle(rhombus);
+    BOOST_CHECK_CLOSE(256. / 17., area_rectangle.area(), 1e-8);
+    double perimeter = 0.;
+    for (size_t i = 0; i < 4; i++)
+        perimeter += distance(perimeter_rectangle[i], perimeter_rectangle[(i + 1) % 4]);
+    BOOST_CHECK_CLOSE(80. / std::sqrt(17.), perimeter, 1e-8);
+
+    for (const auto &rect : {area_rectangle, perimeter_rectangle}) {
+        for (const auto &point : rhombus) {
+            for (size_t i = 0; i < 4; i++)
+                BOOST_CHECK(orientation(rect[i], rect[(i + 1) % 4], point) >= 0 ||
+                            std::abs(crossProduct(rect[(i + 1) % 4] - rect[i], point - rect[i])) < 1e-9);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(quickhull3d)
+{
+    /* Cubo con puntos interiores y sobre las caras */
+    std::vector<Point3<double>> points;
+    for (int x = 0; x <= 1; x++)
+        for (int y = 0; y <= 1; y++)
+            for (int z = 0; z <= 1; z++)
+                points.emplace_back(x, y, z);
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> u(0., 1.);
+    for (size_t i = 0; i < 2000; i++)
+        points.emplace_back(u(generator), u(generator), u(generator));
+    for (size_t i = 0; i < 200; i++)
+        points.emplace_back(u(generator), u(generator), 1.);
+
+    auto triangles = convexHull3D(points);
+    BOOST_CHECK_EQUAL(12, triangles.size());
+    for (const auto &triangle : triangles)
+        for (size_t vertex : triangle)
+            BOOST_CHECK(vertex < 8);
+
+    /* Puntos sobre una esfera: todos son vértices del casco */
+    MultiPoint3D<Point3<double>> sphere;
+    std::normal_distribution<double> normal(0., 1.);
+    for (size_t i = 0; i < 3000; i++) {
+        Point3<double> point(normal(generator), normal(generator), normal(generator));
+        double length = std::sqrt(point.x * point.x + point.y * point.y + point.z * point.z);
+        sphere.push_back(Point3<double>(point.x / length, point.y / length, point.z / length));
+    }
+
+    triangles = convexHull3D(sphere);
+    BOOST_CHECK_EQUAL(2 * sphere.size() - 4, triangles.size());
+
+    /* Cada arista aparece una vez en cada sentido y todos los puntos quedan por debajo de las caras */
+    std::map<std::pair<size_t, size_t>, int> edges;
+    for (const auto &triangle : triangles) {
+        for (size_t i = 0; i < 3; i++)
+            edges[std::make_pair(triangle[i], triangle[(i + 1) % 3])]++;
+
+        const auto &a = sphere[triangle[0]];
+        Point3<double> normal_vector = crossProduct3D(sphere[triangle[1]] - a, sphere[triangle[2]] - a);
+        for (const auto &point : sphere) {
+            Point3<double> v = point - a;
+            BOOST_REQUIRE(normal_vector.x * v.x + normal_vector.y * v.y + normal_vector.z * v.z < 1e-12);
+        }
+    }
+    for (const auto &edge : edges) {
+        BOOST_CHECK_EQUAL(1, edge.second);
+        BOOST_CHECK(edges.find(std::make_pair(edge.first.second, edge.first.first)) != edges.end());
+    }
+
+    std::vector<Point3<double>> plane{Point3<double>(0., 0., 0.), Point3<double>(1., 0., 0.),
+                                      Point3<double>(0., 1., 0.), Point3<double>(1., 1., 0.)};
+    BOOST_CHECK_THROW(convexHull3D(plane), Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
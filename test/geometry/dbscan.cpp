@@ -27,6 +27,8 @@
 
 #include <tidop/geometry/algorithms/dbscan.h>
 
+#include <random>
+
 using namespace tl;
 
 
@@ -1121,6 +1123,80 @@ BOOST_FIXTURE_TEST_CASE(test, DBSCANTest)
 	auto groups = dbscan->groups();
 	
 	BOOST_CHECK_EQUAL(4, groups.size());
+	BOOST_CHECK_EQUAL(4, dbscan->clusterCount());
+
+	size_t clustered = 0;
+	for (const auto &group : groups)
+		clustered += group.size();
+
+	size_t noise = 0;
+	for (auto label : dbscan->labels()) {
+		if (label == DbScan<double>::noise) noise++;
+	}
+
+	BOOST_CHECK_EQUAL(dbscan->labels().size(), clustered + noise);
+}
+
+BOOST_AUTO_TEST_CASE(noise_and_border_points)
+{
+	/* Dos grupos de 5 puntos y un punto aislado */
+	std::vector<Point<double>> points{
+		Point<double>(0., 0.), Point<double>(0.1, 0.), Point<double>(0., 0.1), Point<double>(0.1, 0.1), Point<double>(0.25, 0.05),
+		Point<double>(5., 5.), Point<double>(5.1, 5.), Point<double>(5., 5.1), Point<double>(5.1, 5.1), Point<double>(5.05, 5.05),
+		Point<double>(20., 20.)
+	};
+
+	DbScan<double> dbscan(points, 0.16, 4);
+	dbscan.run();
+
+	BOOST_CHECK_EQUAL(2, dbscan.clusterCount());
+
+	auto &labels = dbscan.labels();
+	BOOST_CHECK_EQUAL(labels[0], labels[3]);
+	BOOST_CHECK_EQUAL(labels[5], labels[9]);
+	BOOST_CHECK(labels[0] != labels[5]);
+	BOOST_CHECK_EQUAL(DbScan<double>::noise, labels[10]);
+
+	/* El punto 4 es un punto borde: pertenece al grupo pero no es núcleo */
+	BOOST_CHECK_EQUAL(labels[0], labels[4]);
+	BOOST_CHECK(!dbscan.isCore(4));
+	BOOST_CHECK(dbscan.isCore(1));
+
+	auto neighbours = dbscan.regionQuery(10);
+	BOOST_CHECK_EQUAL(1, neighbours.size());
+}
+
+BOOST_AUTO_TEST_CASE(clusters_3d)
+{
+	std::mt19937 generator(3);
+	std::normal_distribution<double> distribution(0., 0.5);
+
+	std::vector<Point3<double>> centers{
+		Point3<double>(0., 0., 0.),
+		Point3<double>(10., 0., 0.),
+		Point3<double>(0., 10., 5.)
+	};
+
+	std::vector<Point3<double>> points;
+	for (const auto &center : centers) {
+		for (size_t i = 0; i < 3000; i++) {
+			points.emplace_back(center.x + distribution(generator),
+			                    center.y + distribution(generator),
+			                    center.z + distribution(generator));
+		}
+	}
+
+	DbScan3D<double> dbscan(points, 0.5, 8);
+	dbscan.run();
+
+	BOOST_CHECK_EQUAL(3, dbscan.clusterCount());
+
+	auto &labels = dbscan.labels();
+	for (size_t i = 0; i < centers.size(); i++) {
+		BOOST_CHECK(labels[i * 3000] != DbScan3D<double>::noise);
+	}
+	BOOST_CHECK(labels[0] != labels[3000]);
+	BOOST_CHECK(labels[3000] != labels[6000]);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,278 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop KD-tree test
+#include <boost/test/unit_test.hpp>
+
+#include <tidop/geometry/algorithms/kdtree.h>
+#include <tidop/geometry/algorithms/distance.h>
+
+#include <random>
+
+using namespace tl;
+
+
+BOOST_AUTO_TEST_SUITE(KDTreeTestSuite)
+
+struct KDTreeTest
+{
+
+    KDTreeTest()
+    {
+        std::mt19937 generator(17);
+        std::uniform_real_distribution<double> distribution(-100., 100.);
+
+        for (size_t i = 0; i < 2000; i++) {
+            points_2d.emplace_back(static_cast<float>(distribution(generator)), 
+                                   static_cast<float>(distribution(generator)));
+            points_3d.emplace_back(distribution(generator), 
+                                   distribution(generator), 
+                                   distribution(generator));
+        }
+
+        /* Puntos duplicados */
+        points_2d.push_back(points_2d[10]);
+        points_2d.push_back(points_2d[10]);
+
+        for (size_t i = 0; i < 50; i++) {
+            queries_2d.emplace_back(static_cast<float>(distribution(generator)), 
+                                    static_cast<float>(distribution(generator)));
+            queries_3d.emplace_back(distribution(generator), 
+                                    distribution(generator), 
+                                    distribution(generator));
+        }
+
+        /* Consultas fuera de la nube de puntos */
+        queries_2d.emplace_back(500.f, -300.f);
+        queries_3d.emplace_back(-250., 400., 1000.);
+    }
+
+    ~KDTreeTest()
+    {
+    }
+
+    static auto pointDistance(const Point<float> &pt1, const Point<float> &pt2) -> double
+    {
+        return static_cast<double>(distance(pt1, pt2));
+    }
+
+    static auto pointDistance(const Point3<double> &pt1, const Point3<double> &pt2) -> double
+    {
+        return distance3D(pt1, pt2);
+    }
+
+    template<typename Point_t>
+    static auto bruteForceKnn(const std::vector<Point_t> &points, const Point_t &query, size_t k) -> std::vector<double>
+    {
+        std::vector<double> distances;
+        for (const auto &point : points) {
+            distances.push_back(pointDistance(point, query));
+        }
+        std::sort(distances.begin(), distances.end());
+        distances.resize(std::min(k, distances.size()));
+        return distances;
+    }
+
+    template<typename Point_t>
+    static auto bruteForceRadius(const std::vector<Point_t> &points, const Point_t &query, double radius) -> std::vector<size_t>
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < points.size(); i++) {
+            Point_t diff = points[i] - query;
+            double squared_distance = static_cast<double>(diff.x) * diff.x + static_cast<double>(diff.y) * diff.y;
+            if (squared_distance <= radius * radius) indices.push_back(i);
+        }
+        return indices;
+    }
+
+    std::vector<Point<float>> points_2d;
+    std::vector<Point3<double>> points_3d;
+    std::vector<Point<float>> queries_2d;
+    std::vector<Point3<double>> queries_3d;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(empty_tree, KDTreeTest)
+{
+    KDTree<Point<float>> tree;
+
+    BOOST_CHECK(tree.empty());
+    BOOST_CHECK_EQUAL(0, tree.size());
+    BOOST_CHECK(tree.knnSearch(Point<float>(0.f, 0.f), 3).empty());
+    BOOST_CHECK(tree.radiusSearch(Point<float>(0.f, 0.f), 10.f).empty());
+    BOOST_CHECK(tree.windowSearch(Window<Point<float>>(Point<float>(-1.f, -1.f), Point<float>(1.f, 1.f))).empty());
+
+    BOOST_CHECK_THROW(tree.build(points_2d, 0), Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(knn_2d, KDTreeTest)
+{
+    KDTree<Point<float>> tree(points_2d, 8);
+
+    BOOST_CHECK_EQUAL(points_2d.size(), tree.size());
+
+    for (const auto &query : queries_2d) {
+        std::vector<size_t> indices;
+        std::vector<float> squared_distances;
+        tree.knnSearch(query, 10, indices, squared_distances);
+
+        auto expected = bruteForceKnn(points_2d, query, 10);
+        BOOST_REQUIRE_EQUAL(expected.size(), indices.size());
+
+        for (size_t i = 0; i < indices.size(); i++) {
+            BOOST_CHECK_CLOSE(expected[i], static_cast<double>(distance(points_2d[indices[i]], query)), 0.001);
+            BOOST_CHECK_CLOSE(expected[i] * expected[i], static_cast<double>(squared_distances[i]), 0.001);
+        }
+    }
+
+    /* El vecino más próximo de un punto indexado es el propio punto */
+    auto nearest = tree.knnSearch(points_2d[25], 1);
+    BOOST_CHECK_EQUAL(25, nearest[0]);
+
+    /* k mayor que el número de puntos */
+    BOOST_CHECK_EQUAL(points_2d.size(), tree.knnSearch(queries_2d[0], 5000).size());
+}
+
+BOOST_FIXTURE_TEST_CASE(knn_3d, KDTreeTest)
+{
+    KDTree<Point3<double>> tree(points_3d);
+
+    for (const auto &query : queries_3d) {
+        auto indices = tree.knnSearch(query, 7);
+        auto expected = bruteForceKnn(points_3d, query, 7);
+        BOOST_REQUIRE_EQUAL(expected.size(), indices.size());
+        for (size_t i = 0; i < indices.size(); i++) {
+            BOOST_CHECK_CLOSE(expected[i], distance3D(points_3d[indices[i]], query), 1e-10);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(radius_2d, KDTreeTest)
+{
+    KDTree<Point<float>> tree(points_2d, 4);
+
+    for (const auto &query : queries_2d) {
+        auto indices = tree.radiusSearch(query, 12.f);
+        std::sort(indices.begin(), indices.end());
+        BOOST_CHECK(bruteForceRadius(points_2d, query, 12.) == indices);
+    }
+
+    /* Los duplicados se devuelven todos */
+    auto indices = tree.radiusSearch(points_2d[10], 0.f);
+    BOOST_CHECK_EQUAL(3, indices.size());
+
+    std::vector<size_t> indices_with_distances;
+    std::vector<float> squared_distances;
+    tree.radiusSearch(queries_2d[3], 20.f, indices_with_distances, squared_distances);
+    BOOST_CHECK_EQUAL(indices_with_distances.size(), squared_distances.size());
+    for (auto squared_distance : squared_distances) {
+        BOOST_CHECK(squared_distance <= 400.f);
+    }
+
+    BOOST_CHECK(tree.radiusSearch(queries_2d.back(), 10.f).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(window_and_box, KDTreeTest)
+{
+    KDTree<Point<float>> tree_2d(points_2d);
+    Window<Point<float>> window(Point<float>(-20.f, 10.f), Point<float>(35.f, 60.f));
+
+    auto indices = tree_2d.windowSearch(window);
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < points_2d.size(); i++) {
+        if (window.containsPoint(points_2d[i])) expected.push_back(i);
+    }
+    BOOST_CHECK(expected == indices);
+
+    KDTree<Point3<double>> tree_3d(points_3d);
+    BoundingBox<Point3<double>> box(Point3<double>(-50., -10., 0.), Point3<double>(0., 40., 70.));
+
+    indices = tree_3d.boxSearch(box);
+    std::sort(indices.begin(), indices.end());
+
+    expected.clear();
+    for (size_t i = 0; i < points_3d.size(); i++) {
+        if (box.containsPoint(points_3d[i])) expected.push_back(i);
+    }
+    BOOST_CHECK(expected == indices);
+}
+
+BOOST_FIXTURE_TEST_CASE(batch_queries, KDTreeTest)
+{
+    KDTree<Point3<double>> tree(points_3d);
+
+    auto knn = tree.knnSearch(queries_3d, 5);
+    auto radius = tree.radiusSearch(queries_3d, 15.);
+
+    BOOST_REQUIRE_EQUAL(queries_3d.size(), knn.size());
+    BOOST_REQUIRE_EQUAL(queries_3d.size(), radius.size());
+
+    for (size_t i = 0; i < queries_3d.size(); i++) {
+        BOOST_CHECK(tree.knnSearch(queries_3d[i], 5) == knn[i]);
+        BOOST_CHECK(tree.radiusSearch(queries_3d[i], 15.) == radius[i]);
+    }
+
+    KDTree<Point<float>> tree_2d(points_2d);
+    std::vector<Window<Point<float>>> windows;
+    for (const auto &query : queries_2d) {
+        windows.emplace_back(query, 30.f);
+    }
+
+    auto window_results = tree_2d.windowSearch(windows);
+    for (size_t i = 0; i < windows.size(); i++) {
+        BOOST_CHECK(tree_2d.windowSearch(windows[i]) == window_results[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_build)
+{
+    /* Suficientes puntos para la construcción en paralelo */
+    std::mt19937 generator(5);
+    std::normal_distribution<double> distribution(0., 10.);
+
+    std::vector<Point3<double>> points;
+    for (size_t i = 0; i < 100000; i++) {
+        points.emplace_back(distribution(generator), distribution(generator), distribution(generator));
+    }
+
+    KDTree<Point3<double>> tree(points, 10);
+    BOOST_CHECK_EQUAL(points.size(), tree.size());
+
+    for (size_t i = 0; i < points.size(); i += 997) {
+        auto nearest = tree.knnSearch(points[i], 1);
+        BOOST_CHECK_EQUAL(i, nearest[0]);
+    }
+
+    auto indices = tree.radiusSearch(Point3<double>(), 2.);
+    size_t expected = 0;
+    for (const auto &point : points) {
+        if (point.x * point.x + point.y * point.y + point.z * point.z <= 4.) expected++;
+    }
+    BOOST_CHECK_EQUAL(expected, indices.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop polylabel test
+#include <boost/test/unit_test.hpp>
+
+#include <tidop/geometry/algorithms/polylabel.h>
+#include <tidop/geometry/algorithms/distance.h>
+
+using namespace tl;
+
+
+BOOST_AUTO_TEST_SUITE(PolylabelTestSuite)
+
+BOOST_AUTO_TEST_CASE(square)
+{
+    PolygonD square{Point<double>(0., 0.),
+                    Point<double>(10., 0.),
+                    Point<double>(10., 10.),
+                    Point<double>(0., 10.)};
+
+    double distance = 0.;
+    Point<double> pole = polylabel(square, 0.001, &distance);
+
+    BOOST_CHECK_CLOSE(5., pole.x, 0.1);
+    BOOST_CHECK_CLOSE(5., pole.y, 0.1);
+    BOOST_CHECK_CLOSE(5., distance, 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(prepared_polygon_distance)
+{
+    PolygonD polygon{Point<double>(0., 0.),
+                     Point<double>(100., 0.),
+                     Point<double>(100., 100.),
+                     Point<double>(0., 100.)};
+    polygon.addHole(PolygonHole<Point<double>>{Point<double>(20., 20.),
+                                               Point<double>(80., 20.),
+                                               Point<double>(50., 80.)});
+
+    PreparedPolygon<Point<double>> prepared(polygon);
+    PolygonHole<Point<double>> polygon_hole = polygon.hole(0);
+    PolygonD hole(std::vector<Point<double>>(polygon_hole.begin(), polygon_hole.end()));
+
+    BOOST_CHECK_CLOSE(10., prepared.signedDistance(Point<double>(10., 50.)), 1e-10);
+    BOOST_CHECK_CLOSE(5., prepared.distance(Point<double>(50., 15.)), 1e-10);
+    BOOST_CHECK_CLOSE(-5., prepared.signedDistance(Point<double>(50., 25.)), 1e-10);
+    BOOST_CHECK_CLOSE(-50., prepared.signedDistance(Point<double>(150., 50.)), 1e-10);
+
+    for (double x = 1.; x < 100.; x += 7.3) {
+        for (double y = 1.; y < 100.; y += 6.1) {
+            Point<double> point(x, y);
+            double expected = std::min(distPointToPolygon(point, polygon),
+                                       distPointToPolygon(point, hole));
+            BOOST_CHECK_CLOSE(expected + 1., prepared.distance(point) + 1., 1e-8);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(holes)
+{
+    /* El agujero central desplaza el polo hacia una esquina */
+    PolygonD polygon{Point<double>(0., 0.),
+                     Point<double>(100., 0.),
+                     Point<double>(100., 100.),
+                     Point<double>(0., 100.)};
+    polygon.addHole(PolygonHole<Point<double>>{Point<double>(30., 30.),
+                                               Point<double>(70., 30.),
+                                               Point<double>(70., 70.),
+                                               Point<double>(30., 70.)});
+
+    double distance = 0.;
+    Point<double> pole = polylabel(polygon, 0.01, &distance);
+
+    PreparedPolygon<Point<double>> prepared(polygon);
+    BOOST_CHECK(prepared.isInner(pole));
+    BOOST_CHECK_CLOSE(prepared.signedDistance(pole), distance, 1e-10);
+
+    /* Máximo por fuerza bruta en una malla fina */
+    double max_distance = 0.;
+    for (double x = 0.; x <= 100.; x += 0.5) {
+        for (double y = 0.; y <= 100.; y += 0.5) {
+            max_distance = std::max(max_distance, prepared.signedDistance(x, y));
+        }
+    }
+
+    BOOST_CHECK(distance >= max_distance - 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(degenerate)
+{
+    PolygonD empty;
+    double distance = -1.;
+    polylabel(empty, 1., &distance);
+    BOOST_CHECK_EQUAL(0., distance);
+
+    PolygonD line{Point<double>(0., 0.), Point<double>(10., 0.), Point<double>(5., 0.)};
+    Point<double> pole = polylabel(line, 1., &distance);
+    BOOST_CHECK_EQUAL(0., distance);
+    BOOST_CHECK_EQUAL(0., pole.y);
+
+    PolygonD square{Point<double>(0., 0.),
+                    Point<double>(10., 0.),
+                    Point<double>(10., 10.),
+                    Point<double>(0., 10.)};
+    BOOST_CHECK_THROW(polylabel(square, 0.), std::exception);
+    BOOST_CHECK_THROW(polylabel(square, -1.), std::exception);
+    BOOST_CHECK_THROW(polylabel(PreparedPolygon<Point<double>>(square), 0.), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(thin_polygon)
+{
+    /* Con una malla inicial del lado corto serían 10^8 celdas */
+    PolygonD strip{Point<double>(0., 0.),
+                   Point<double>(1.e5, 0.),
+                   Point<double>(1.e5, 1.e-3),
+                   Point<double>(0., 1.e-3)};
+
+    double distance = -1.;
+    Point<double> pole = polylabel(strip, 1., &distance);
+
+    PreparedPolygon<Point<double>> prepared(strip);
+    BOOST_CHECK(prepared.isInner(pole));
+    BOOST_CHECK(distance > 0.);
+    BOOST_CHECK(distance <= 5.e-4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
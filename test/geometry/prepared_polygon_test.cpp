@@ -0,0 +1,241 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop prepared polygon test
+#include <boost/test/unit_test.hpp>
+
+#include <tidop/geometry/algorithms/prepared_polygon.h>
+
+#include <cmath>
+#include <random>
+
+using namespace tl;
+
+
+BOOST_AUTO_TEST_SUITE(PreparedPolygonTestSuite)
+
+struct PreparedPolygonTest
+{
+
+    PreparedPolygonTest()
+      : polygon_integer{Point<int>(4157222, 664789),
+                        Point<int>(4149043, 688836),
+                        Point<int>(4172803, 690340),
+                        Point<int>(4177148, 642997),
+                        Point<int>(4137012, 671808),
+                        Point<int>(4146292, 666953),
+                        Point<int>(4138759, 702670)},
+        polygon_holes({Point<double>(0., 0.),
+                       Point<double>(100., 0.),
+                       Point<double>(100., 100.),
+                       Point<double>(0., 100.)}),
+        star(),
+        star_ccw()
+    {
+        PolygonHole<Point<double>> hole{Point<double>(20., 20.),
+                                        Point<double>(80., 20.),
+                                        Point<double>(50., 80.)};
+        polygon_holes.addHole(hole);
+
+        /* Estrella cóncava */
+        for (int i = 0; i < 10; i++) {
+            double angle = i * 3.14159265358979323846 / 5.;
+            double radius = i % 2 == 0 ? 50. : 20.;
+            star.push_back(Point<double>(radius * std::cos(angle), radius * std::sin(angle)));
+        }
+
+        for (size_t i = star.size(); i > 0; i--) {
+            star_ccw.push_back(star[i - 1]);
+        }
+    }
+
+    ~PreparedPolygonTest()
+    {
+    }
+
+    PolygonI polygon_integer;
+    PolygonD polygon_holes;
+    PolygonD star;
+    PolygonD star_ccw;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(is_inner, PreparedPolygonTest)
+{
+    PreparedPolygon<Point<int>> prepared(polygon_integer);
+
+    BOOST_CHECK(false == prepared.isInner(Point<int>(0, 0)));
+    BOOST_CHECK(prepared.isInner(Point<int>(4160000, 675000)));
+
+    /* Vértices */
+    for (size_t i = 0; i < polygon_integer.size(); i++) {
+        BOOST_CHECK(prepared.isInner(polygon_integer[i]));
+    }
+
+    /* Mismo resultado que Polygon::isInner */
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> x(4130000, 4180000);
+    std::uniform_int_distribution<int> y(640000, 705000);
+
+    for (size_t i = 0; i < 5000; i++) {
+        Point<int> point(x(generator), y(generator));
+        BOOST_CHECK_EQUAL(polygon_integer.isInner(point), prepared.isInner(point));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(concave, PreparedPolygonTest)
+{
+    PreparedPolygon<Point<double>> prepared(star);
+    PreparedPolygon<Point<double>> prepared_ccw(star_ccw, PreparedPolygon<Point<double>>::FillRule::non_zero);
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> coordinate(-55., 55.);
+
+    for (size_t i = 0; i < 5000; i++) {
+        Point<double> point(coordinate(generator), coordinate(generator));
+        bool inner = star.isInner(point);
+        BOOST_CHECK_EQUAL(inner, prepared.isInner(point));
+        BOOST_CHECK_EQUAL(inner, prepared_ccw.isInner(point));
+    }
+
+    /* Punto en una arista */
+    BOOST_CHECK(prepared.isInner(Point<double>((star[0].x + star[1].x) / 2., (star[0].y + star[1].y) / 2.)));
+}
+
+BOOST_FIXTURE_TEST_CASE(holes, PreparedPolygonTest)
+{
+    PreparedPolygon<Point<double>> prepared(polygon_holes);
+    PreparedPolygon<Point<double>> prepared_non_zero(polygon_holes, PreparedPolygon<Point<double>>::FillRule::non_zero);
+
+    BOOST_CHECK(prepared.isInner(Point<double>(10., 10.)));
+    BOOST_CHECK(prepared.isInner(Point<double>(90., 50.)));
+    BOOST_CHECK(false == prepared.isInner(Point<double>(50., 40.)));
+    BOOST_CHECK(false == prepared_non_zero.isInner(Point<double>(50., 40.)));
+    BOOST_CHECK(prepared_non_zero.isInner(Point<double>(10., 10.)));
+
+    /* El borde del agujero pertenece al polígono */
+    BOOST_CHECK(prepared.isInner(Point<double>(50., 20.)));
+    BOOST_CHECK(false == prepared.isInner(Point<double>(150., 20.)));
+}
+
+BOOST_AUTO_TEST_CASE(diagonal_edge)
+{
+    /* El origen está en la arista (0.7, 0.9) - (-1.4, -1.8), pero el
+       producto vectorial redondeado no es cero */
+    PolygonD left{Point<double>(0.7, 0.9),
+                  Point<double>(-1.4, -1.8),
+                  Point<double>(-2., 1.)};
+    PolygonD right{Point<double>(0.7, 0.9),
+                   Point<double>(-1.4, -1.8),
+                   Point<double>(2., -1.)};
+
+    for (const auto &polygon : {left, right}) {
+        PreparedPolygon<Point<double>> prepared(polygon);
+        BOOST_CHECK(prepared.isInner(Point<double>(0., 0.)));
+        BOOST_CHECK(prepared.isInner(Point<double>(-0.7, -0.9)));
+        BOOST_CHECK(prepared.isInner(0., 0.));
+
+        double x = 0.;
+        double y = 0.;
+        unsigned char inside = 0;
+        prepared.isInner(&x, &y, 1, &inside);
+        BOOST_CHECK_EQUAL(1, inside);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(comb)
+{
+    /* Peine con dientes de toda la altura: cada arista vertical cruza
+       todas las bandas */
+    size_t teeth = 2000;
+    PolygonD polygon;
+    polygon.push_back(Point<double>(0., 0.));
+    polygon.push_back(Point<double>(2. * teeth, 0.));
+    for (size_t i = teeth; i > 0; i--) {
+        double x = 2. * static_cast<double>(i);
+        polygon.push_back(Point<double>(x, 100.));
+        polygon.push_back(Point<double>(x - 1., 100.));
+        polygon.push_back(Point<double>(x - 1., 1.));
+        polygon.push_back(Point<double>(x - 2., 1.));
+    }
+
+    size_t edges = polygon.size();
+    double span = 0.;
+    for (size_t i = 0, j = edges - 1; i < edges; j = i++) {
+        span += std::abs(polygon[i].y - polygon[j].y);
+    }
+
+    size_t bands = internal::prepared_polygon_band_count(edges, 100., span);
+    double copies = span * static_cast<double>(bands) / 100. + 2. * static_cast<double>(edges);
+    BOOST_CHECK(bands >= 1);
+    BOOST_CHECK(copies <= static_cast<double>(internal::prepared_polygon_max_band_copies * edges));
+
+    /* Sin aristas largas se mantiene una banda por arista */
+    BOOST_CHECK_EQUAL(1000, internal::prepared_polygon_band_count(1000, 100., 100.));
+
+    PreparedPolygon<Point<double>> prepared(polygon);
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> x(-1., 2. * teeth + 1.);
+    std::uniform_real_distribution<double> y(-1., 101.);
+
+    for (size_t i = 0; i < 5000; i++) {
+        Point<double> point(x(generator), y(generator));
+        BOOST_CHECK_EQUAL(polygon.isInner(point), prepared.isInner(point));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(batch, PreparedPolygonTest)
+{
+    PreparedPolygon<Point<double>> prepared(star);
+
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> coordinate(-60., 60.);
+
+    std::vector<double> x(20000);
+    std::vector<double> y(20000);
+    std::vector<Point<double>> points;
+    for (size_t i = 0; i < x.size(); i++) {
+        x[i] = coordinate(generator);
+        y[i] = coordinate(generator);
+        points.emplace_back(x[i], y[i]);
+    }
+
+    std::vector<unsigned char> inside(x.size());
+    prepared.isInner(x.data(), y.data(), x.size(), inside.data());
+
+    auto inside_points = prepared.isInner(points);
+
+    for (size_t i = 0; i < x.size(); i++) {
+        BOOST_CHECK_EQUAL(prepared.isInner(points[i]), inside[i] == 1);
+    }
+    BOOST_CHECK(inside == inside_points);
+
+    PreparedPolygon<Point<double>> empty(PolygonD{});
+    empty.isInner(x.data(), y.data(), x.size(), inside.data());
+    BOOST_CHECK(std::all_of(inside.begin(), inside.end(), [](unsigned char value) { return value == 0; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,311 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop R-tree test
+#include <boost/test/unit_test.hpp>
+
+#include <tidop/geometry/algorithms/rtree.h>
+#include <tidop/geometry/entities/polygon.h>
+
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace tl;
+
+
+BOOST_AUTO_TEST_SUITE(RTreeTestSuite)
+
+struct RTreeTest
+{
+
+    RTreeTest()
+    {
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<double> position(0., 1000.);
+        std::uniform_real_distribution<double> size(0.5, 20.);
+
+        for (size_t i = 0; i < 5000; i++) {
+            Point<double> pt(position(generator), position(generator));
+            windows.emplace_back(pt, Point<double>(pt.x + size(generator), pt.y + size(generator)));
+
+            Point3<double> pt3(position(generator), position(generator), position(generator));
+            boxes.emplace_back(pt3, Point3<double>(pt3.x + size(generator), pt3.y + size(generator), pt3.z + size(generator)));
+        }
+
+        for (size_t i = 0; i < 40; i++) {
+            Point<double> pt(position(generator), position(generator));
+            queries.emplace_back(pt, Point<double>(pt.x + 60., pt.y + 45.));
+            points.push_back(pt);
+        }
+    }
+
+    ~RTreeTest()
+    {
+    }
+
+    static auto sorted(std::vector<size_t> indices) -> std::vector<size_t>
+    {
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+
+    auto intersecting(const Window<Point<double>> &query) const -> std::vector<size_t>
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < windows.size(); i++) {
+            if (intersectWindows(windows[i], query)) indices.push_back(i);
+        }
+        return indices;
+    }
+
+    auto within(const Window<Point<double>> &query) const -> std::vector<size_t>
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < windows.size(); i++) {
+            if (query.containsWindow(windows[i])) indices.push_back(i);
+        }
+        return indices;
+    }
+
+    auto containing(const Point<double> &point) const -> std::vector<size_t>
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < windows.size(); i++) {
+            if (windows[i].containsPoint(point)) indices.push_back(i);
+        }
+        return indices;
+    }
+
+    static auto boxDistance(const Window<Point<double>> &window, const Point<double> &point) -> double
+    {
+        double dx = std::max({window.pt1.x - point.x, 0., point.x - window.pt2.x});
+        double dy = std::max({window.pt1.y - point.y, 0., point.y - window.pt2.y});
+        return dx * dx + dy * dy;
+    }
+
+    std::vector<Window<Point<double>>> windows;
+    std::vector<BoundingBox<Point3<double>>> boxes;
+    std::vector<Window<Point<double>>> queries;
+    std::vector<Point<double>> points;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(empty_tree, RTreeTest)
+{
+    RTree<Point<double>> rtree;
+
+    BOOST_CHECK(rtree.empty());
+    BOOST_CHECK(rtree.search(queries[0]).empty());
+    BOOST_CHECK(rtree.nearest(points[0], 3).empty());
+
+    BOOST_CHECK_THROW(RTree<Point<double>>(windows, 1), Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(search_2d, RTreeTest)
+{
+    RTree<Point<double>> rtree(windows, 8);
+
+    BOOST_CHECK_EQUAL(windows.size(), rtree.size());
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        BOOST_CHECK(intersecting(queries[i]) == sorted(rtree.search(queries[i])));
+        BOOST_CHECK(within(queries[i]) == sorted(rtree.searchWithin(queries[i])));
+        BOOST_CHECK(containing(points[i]) == sorted(rtree.searchContaining(points[i])));
+    }
+
+    /* Ventana con los vértices invertidos */
+    Window<Point<double>> inverted(queries[0].pt2, queries[0].pt1);
+    BOOST_CHECK(intersecting(queries[0]) == sorted(rtree.search(inverted)));
+}
+
+BOOST_FIXTURE_TEST_CASE(nearest, RTreeTest)
+{
+    RTree<Point<double>> rtree(windows);
+
+    for (const auto &point : points) {
+
+        auto indices = rtree.nearest(point, 5);
+        BOOST_REQUIRE_EQUAL(5, indices.size());
+
+        std::vector<double> distances;
+        for (const auto &window : windows) {
+            distances.push_back(boxDistance(window, point));
+        }
+        std::sort(distances.begin(), distances.end());
+
+        for (size_t i = 0; i < indices.size(); i++) {
+            BOOST_CHECK_CLOSE(distances[i] + 1., boxDistance(windows[indices[i]], point) + 1., 1e-10);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(search_3d, RTreeTest)
+{
+    RTree<Point3<double>> rtree(boxes, 12);
+
+    BoundingBox<Point3<double>> query(Point3<double>(100., 200., 300.), Point3<double>(400., 350., 500.));
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        const auto &box = boxes[i];
+        if (box.pt1.x <= query.pt2.x && box.pt2.x >= query.pt1.x &&
+            box.pt1.y <= query.pt2.y && box.pt2.y >= query.pt1.y &&
+            box.pt1.z <= query.pt2.z && box.pt2.z >= query.pt1.z)
+            expected.push_back(i);
+    }
+
+    BOOST_CHECK(!expected.empty());
+    BOOST_CHECK(expected == sorted(rtree.search(query)));
+
+    auto containing = rtree.searchContaining(boxes[7].center());
+    BOOST_CHECK(std::find(containing.begin(), containing.end(), 7) != containing.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(save_load_and_view, RTreeTest)
+{
+    RTree<Point<double>> rtree(windows);
+
+    Path file = Path::tempPath();
+    file.append("tidop_rtree_test.bin");
+
+    rtree.save(file);
+
+    RTree<Point<double>> loaded = RTree<Point<double>>::load(file);
+    BOOST_CHECK_EQUAL(rtree.size(), loaded.size());
+    BOOST_CHECK(sorted(rtree.search(queries[3])) == sorted(loaded.search(queries[3])));
+
+    /* Buffer con el contenido del fichero, como si estuviera mapeado en memoria */
+    std::ifstream stream(file.toString(), std::ios::binary | std::ios::ate);
+    auto size = static_cast<size_t>(stream.tellg());
+    stream.seekg(0);
+    std::vector<uint64_t> buffer(size / sizeof(uint64_t) + 1);
+    stream.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(size));
+    stream.close();
+
+    RTree<Point<double>> view = RTree<Point<double>>::view(buffer.data(), size);
+    BOOST_CHECK_EQUAL(rtree.size(), view.size());
+    for (size_t i = 0; i < queries.size(); i++) {
+        BOOST_CHECK(sorted(rtree.search(queries[i])) == sorted(view.search(queries[i])));
+        BOOST_CHECK(rtree.nearest(points[i], 3) == view.nearest(points[i], 3));
+    }
+
+    /* Tipo de punto distinto */
+    BOOST_CHECK_THROW(RTree<Point<float>>::view(buffer.data(), size), Exception);
+    /* Buffer truncado */
+    BOOST_CHECK_THROW(RTree<Point<double>>::view(buffer.data(), size / 2), Exception);
+    /* Cabecera completa sin la tabla de niveles */
+    BOOST_CHECK_THROW(RTree<Point<double>>::view(buffer.data(), 48), Exception);
+
+    /* Cabeceras corruptas. Campos: magic, version, dimensions, scalarSize (4 bytes),
+       nodeCapacity, itemCount, levelCount (8 bytes) */
+    auto corrupt = [&](size_t offset, uint64_t value) {
+        std::vector<uint64_t> copy(buffer);
+        std::memcpy(reinterpret_cast<char *>(copy.data()) + offset, &value, sizeof(value));
+        return copy;
+    };
+
+    std::vector<uint64_t> zero_capacity = corrupt(16, 0);
+    BOOST_CHECK_THROW(RTree<Point<double>>::view(zero_capacity.data(), size), Exception);
+    std::vector<uint64_t> huge_items = corrupt(24, std::numeric_limits<uint64_t>::max() / 2);
+    BOOST_CHECK_THROW(RTree<Point<double>>::view(huge_items.data(), size), Exception);
+    std::vector<uint64_t> huge_levels = corrupt(32, std::numeric_limits<uint64_t>::max());
+    BOOST_CHECK_THROW(RTree<Point<double>>::view(huge_levels.data(), size), Exception);
+    /* Fin del primer nivel mayor que el del segundo */
+    std::vector<uint64_t> decreasing = corrupt(48 + 8, 1);
+    BOOST_CHECK_THROW(RTree<Point<double>>::view(decreasing.data(), size), Exception);
+
+    Path::removeFile(file);
+}
+
+BOOST_FIXTURE_TEST_CASE(dynamic_insert_remove, RTreeTest)
+{
+    DynamicRTree<Point<double>> rtree(8);
+
+    for (size_t i = 0; i < windows.size(); i++) {
+        rtree.insert(windows[i], i);
+    }
+
+    BOOST_CHECK_EQUAL(windows.size(), rtree.size());
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        BOOST_CHECK(intersecting(queries[i]) == sorted(rtree.search(queries[i])));
+        BOOST_CHECK(within(queries[i]) == sorted(rtree.searchWithin(queries[i])));
+        BOOST_CHECK(containing(points[i]) == sorted(rtree.searchContaining(points[i])));
+    }
+
+    /* Se eliminan los índices pares */
+    for (size_t i = 0; i < windows.size(); i += 2) {
+        BOOST_CHECK(rtree.remove(windows[i], i));
+    }
+    BOOST_CHECK(!rtree.remove(windows[0], 0));
+    BOOST_CHECK_EQUAL(windows.size() / 2, rtree.size());
+
+    for (const auto &query : queries) {
+        std::vector<size_t> expected;
+        for (auto index : intersecting(query)) {
+            if (index % 2 == 1) expected.push_back(index);
+        }
+        BOOST_CHECK(expected == sorted(rtree.search(query)));
+    }
+
+    auto nearest = rtree.nearest(points[0], 1);
+    BOOST_REQUIRE_EQUAL(1, nearest.size());
+    BOOST_CHECK_EQUAL(1, nearest[0] % 2);
+
+    RTree<Point<double>> packed = rtree.pack();
+    BOOST_CHECK_EQUAL(rtree.size(), packed.size());
+    BOOST_CHECK(sorted(rtree.search(queries[5])) == sorted(packed.search(queries[5])));
+
+    for (size_t i = 1; i < windows.size(); i += 2) {
+        BOOST_CHECK(rtree.remove(windows[i], i));
+    }
+    BOOST_CHECK(rtree.empty());
+    BOOST_CHECK(rtree.search(queries[0]).empty());
+
+    rtree.insert(windows[3], 3);
+    BOOST_CHECK_EQUAL(1, rtree.search(windows[3]).size());
+}
+
+BOOST_AUTO_TEST_CASE(from_entities)
+{
+    std::vector<Polygon<Point<double>>> polygons;
+    for (int i = 0; i < 100; i++) {
+        double x = (i % 10) * 10.;
+        double y = (i / 10) * 10.;
+        polygons.emplace_back(std::initializer_list<Point<double>>{
+            Point<double>(x, y), Point<double>(x + 5., y), Point<double>(x + 5., y + 5.), Point<double>(x, y + 5.)});
+    }
+
+    auto rtree = RTree<Point<double>>::fromEntities(polygons, 4);
+
+    auto indices = rtree.search(Window<Point<double>>(Point<double>(12., 12.), Point<double>(31., 24.)));
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<size_t> expected{11, 12, 13, 21, 22, 23};
+    BOOST_CHECK(expected == indices);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
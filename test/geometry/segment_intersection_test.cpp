@@ -0,0 +1,297 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop segment intersection test
+#include <boost/test/unit_test.hpp>
+
+#include <tidop/geometry/algorithms/segment_intersection.h>
+
+#include <cmath>
+#include <random>
+
+using namespace tl;
+
+
+BOOST_AUTO_TEST_SUITE(SegmentIntersectionTestSuite)
+
+/* Todos los pares por fuerza bruta */
+template<typename Point_t>
+std::vector<SegmentIntersection<Point_t>> bruteForce(const std::vector<Segment<Point_t>> &segments)
+{
+    std::vector<SegmentIntersection<Point_t>> intersections;
+    SegmentIntersection<Point_t> intersection;
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        for (size_t j = i + 1; j < segments.size(); j++) {
+            if (internal::segment_intersection(internal::segment_intersection_segment(segments[i].pt1, segments[i].pt2),
+                                               internal::segment_intersection_segment(segments[j].pt1, segments[j].pt2),
+                                               &intersection)) {
+                intersection.segment1 = i;
+                intersection.segment2 = j;
+                intersections.push_back(intersection);
+            }
+        }
+    }
+
+    return intersections;
+}
+
+template<typename Point_t>
+void checkEqual(const std::vector<SegmentIntersection<Point_t>> &intersections,
+                const std::vector<SegmentIntersection<Point_t>> &expected)
+{
+    BOOST_REQUIRE_EQUAL(expected.size(), intersections.size());
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        BOOST_CHECK_EQUAL(expected[i].segment1, intersections[i].segment1);
+        BOOST_CHECK_EQUAL(expected[i].segment2, intersections[i].segment2);
+        BOOST_CHECK(expected[i].type == intersections[i].type);
+        BOOST_CHECK(expected[i].pt1 == intersections[i].pt1);
+        BOOST_CHECK(expected[i].pt2 == intersections[i].pt2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(degenerate_cases)
+{
+    std::vector<Segment<Point<double>>> segments{
+        Segment<Point<double>>(Point<double>(0., 0.), Point<double>(10., 10.)),   // 0
+        Segment<Point<double>>(Point<double>(0., 10.), Point<double>(10., 0.)),   // 1: cruza 0 en (5, 5)
+        Segment<Point<double>>(Point<double>(10., 10.), Point<double>(20., 10.)), // 2: extremo compartido con 0
+        Segment<Point<double>>(Point<double>(15., 10.), Point<double>(30., 10.)), // 3: solape con 2
+        Segment<Point<double>>(Point<double>(25., 0.), Point<double>(25., 10.)),  // 4: toca 3 en (25, 10)
+        Segment<Point<double>>(Point<double>(2., 2.), Point<double>(2., 2.)),     // 5: punto sobre 0
+        Segment<Point<double>>(Point<double>(0., -1.), Point<double>(10., -1.))   // 6: sin intersección
+    };
+
+    auto intersections = intersectSegments(segments);
+
+    BOOST_REQUIRE_EQUAL(5, intersections.size());
+
+    BOOST_CHECK_EQUAL(0, intersections[0].segment1);
+    BOOST_CHECK_EQUAL(1, intersections[0].segment2);
+    BOOST_CHECK(SegmentIntersection<Point<double>>::Type::point == intersections[0].type);
+    BOOST_CHECK_CLOSE(5., intersections[0].pt1.x, 1e-10);
+    BOOST_CHECK_CLOSE(5., intersections[0].pt1.y, 1e-10);
+
+    BOOST_CHECK_EQUAL(2, intersections[1].segment2);
+    BOOST_CHECK(Point<double>(10., 10.) == intersections[1].pt1);
+
+    BOOST_CHECK_EQUAL(0, intersections[2].segment1);
+    BOOST_CHECK_EQUAL(5, intersections[2].segment2);
+    BOOST_CHECK(Point<double>(2., 2.) == intersections[2].pt1);
+
+    BOOST_CHECK_EQUAL(2, intersections[3].segment1);
+    BOOST_CHECK_EQUAL(3, intersections[3].segment2);
+    BOOST_CHECK(SegmentIntersection<Point<double>>::Type::overlap == intersections[3].type);
+    BOOST_CHECK(Point<double>(15., 10.) == intersections[3].pt1);
+    BOOST_CHECK(Point<double>(20., 10.) == intersections[3].pt2);
+
+    BOOST_CHECK_EQUAL(3, intersections[4].segment1);
+    BOOST_CHECK_EQUAL(4, intersections[4].segment2);
+    BOOST_CHECK(Point<double>(25., 10.) == intersections[4].pt1);
+}
+
+BOOST_AUTO_TEST_CASE(exact_orientation)
+{
+    /* Puntos casi alineados: el determinante en coma flotante no es fiable */
+    BOOST_CHECK_EQUAL(0, internal::orientation(0.5, 0.5, 12., 12., 24., 24.));
+
+    double above = 24.;
+    double below = 24.;
+    for (int k = 0; k < 8; k++) {
+        above = std::nextafter(above, 100.);
+        below = std::nextafter(below, 0.);
+        BOOST_CHECK_EQUAL(-1, internal::orientation(0.5, 0.5, 12., 12., above, 24.));
+        BOOST_CHECK_EQUAL(1, internal::orientation(0.5, 0.5, 12., 12., below, 24.));
+        BOOST_CHECK_EQUAL(-1, internal::orientation_exact(0.5, 0.5, 12., 12., above, 24.));
+        BOOST_CHECK_EQUAL(1, internal::orientation_exact(0.5, 0.5, 12., 12., below, 24.));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(brute_force)
+{
+    std::mt19937 generator(17);
+
+    /* Coordenadas enteras en un rango pequeño: muchos solapes, contactos y segmentos degenerados */
+    std::uniform_int_distribution<int> small(0, 20);
+    std::vector<Segment<Point<int>>> int_segments;
+    for (size_t i = 0; i < 400; i++) {
+        int_segments.emplace_back(Point<int>(small(generator), small(generator)),
+                                  Point<int>(small(generator), small(generator)));
+    }
+    checkEqual(intersectSegments(int_segments), bruteForce(int_segments));
+
+    std::uniform_real_distribution<double> position(0., 1000.);
+    std::uniform_real_distribution<double> length(-15., 15.);
+    std::vector<Segment<Point<double>>> segments;
+    for (size_t i = 0; i < 3000; i++) {
+        Point<double> pt(position(generator), position(generator));
+        segments.emplace_back(pt, Point<double>(pt.x + length(generator), pt.y + length(generator)));
+    }
+    /* Algunos segmentos largos que atraviesan muchas celdas */
+    for (size_t i = 0; i < 10; i++) {
+        segments.emplace_back(Point<double>(position(generator), 0.), Point<double>(position(generator), 1000.));
+    }
+    checkEqual(intersectSegments(segments), bruteForce(segments));
+}
+
+BOOST_AUTO_TEST_CASE(clustered)
+{
+    std::mt19937 generator(31);
+
+    /* Casi todos los segmentos en la misma celda de la malla */
+    std::uniform_real_distribution<double> position(0., 1.);
+    std::uniform_real_distribution<double> length(-0.01, 0.01);
+    std::vector<Segment<Point<double>>> segments;
+    for (size_t i = 0; i < 1990; i++) {
+        Point<double> pt(position(generator), position(generator));
+        segments.emplace_back(pt, Point<double>(pt.x + length(generator), pt.y + length(generator)));
+    }
+    for (size_t i = 0; i < 10; i++) {
+        segments.emplace_back(Point<double>(position(generator) * 1.e4, 0.), Point<double>(position(generator) * 1.e4, 1.e4));
+    }
+
+    std::vector<internal::IntersectionSegment> intersection_segments;
+    for (const auto &segment : segments)
+        intersection_segments.push_back(internal::segment_intersection_segment(segment.pt1, segment.pt2));
+
+    size_t tests = 0;
+    auto intersections = internal::segment_intersections<Point<double>>(intersection_segments,
+                                                                        [](size_t, size_t) {
+                                                                            return internal::SegmentPair::independent;
+                                                                        },
+                                                                        0, &tests);
+
+    checkEqual(intersections, bruteForce(segments));
+    /* Todos los pares serían unos 2 millones */
+    BOOST_CHECK(tests < 25 * segments.size());
+
+    /* Rojo-azul: los pares del mismo conjunto no se visitan */
+    intersection_segments.clear();
+    for (size_t i = 0; i < 1000; i++) {
+        double y = static_cast<double>(i) * 1.e-3;
+        intersection_segments.push_back({0., y, 1., y});
+    }
+    intersection_segments.push_back({0.25, -1., 0.25, 2.});
+    intersection_segments.push_back({0.75, -1., 0.75, 2.});
+
+    tests = 0;
+    intersections = internal::segment_intersections<Point<double>>(intersection_segments,
+                                                                   [](size_t, size_t) {
+                                                                       return internal::SegmentPair::independent;
+                                                                   },
+                                                                   1000, &tests);
+
+    BOOST_CHECK_EQUAL(2000, intersections.size());
+    BOOST_CHECK(tests <= 2000);
+}
+
+BOOST_AUTO_TEST_CASE(red_blue)
+{
+    std::vector<Segment<Point<double>>> roads{
+        Segment<Point<double>>(Point<double>(0., 0.), Point<double>(10., 0.)),
+        Segment<Point<double>>(Point<double>(10., 0.), Point<double>(10., 10.))
+    };
+    std::vector<Segment<Point<double>>> rivers{
+        Segment<Point<double>>(Point<double>(5., -5.), Point<double>(5., 5.)),
+        Segment<Point<double>>(Point<double>(5., 5.), Point<double>(15., 5.)),
+        Segment<Point<double>>(Point<double>(20., 0.), Point<double>(30., 0.))
+    };
+
+    auto intersections = intersectSegments(roads, rivers);
+
+    BOOST_REQUIRE_EQUAL(2, intersections.size());
+    BOOST_CHECK_EQUAL(0, intersections[0].segment1);
+    BOOST_CHECK_EQUAL(0, intersections[0].segment2);
+    BOOST_CHECK(Point<double>(5., 0.) == intersections[0].pt1);
+    BOOST_CHECK_EQUAL(1, intersections[1].segment1);
+    BOOST_CHECK_EQUAL(1, intersections[1].segment2);
+    BOOST_CHECK(Point<double>(10., 5.) == intersections[1].pt1);
+}
+
+BOOST_AUTO_TEST_CASE(linestrings)
+{
+    /* Los vértices compartidos por segmentos consecutivos no son intersecciones */
+    LineStringD square{Point<double>(0., 0.), Point<double>(10., 0.), Point<double>(10., 10.),
+                       Point<double>(0., 10.), Point<double>(0., 0.)};
+    BOOST_CHECK(selfIntersections(square).empty());
+
+    LineStringD loop{Point<double>(0., 0.), Point<double>(10., 0.), Point<double>(10., 10.),
+                     Point<double>(5., 10.), Point<double>(5., -5.)};
+    auto intersections = selfIntersections(loop);
+    BOOST_REQUIRE_EQUAL(1, intersections.size());
+    BOOST_CHECK_EQUAL(0, intersections[0].segment1);
+    BOOST_CHECK_EQUAL(3, intersections[0].segment2);
+    BOOST_CHECK(Point<double>(5., 0.) == intersections[0].pt1);
+
+    /* Vértice repetido y segmento que vuelve sobre el anterior */
+    LineStringD back{Point<double>(0., 0.), Point<double>(10., 0.), Point<double>(10., 0.), Point<double>(4., 0.)};
+    intersections = selfIntersections(back);
+    BOOST_REQUIRE_EQUAL(1, intersections.size());
+    BOOST_CHECK_EQUAL(0, intersections[0].segment1);
+    BOOST_CHECK_EQUAL(2, intersections[0].segment2);
+    BOOST_CHECK(SegmentIntersection<Point<double>>::Type::overlap == intersections[0].type);
+    BOOST_CHECK(Point<double>(4., 0.) == intersections[0].pt1);
+    BOOST_CHECK(Point<double>(10., 0.) == intersections[0].pt2);
+
+    MultiLineString<Point<double>> network;
+    network.push_back(LineStringD{Point<double>(0., 5.), Point<double>(10., 5.), Point<double>(20., 5.)});
+    network.push_back(LineStringD{Point<double>(5., 0.), Point<double>(5., 10.)});
+    network.push_back(LineStringD{Point<double>(15., 0.), Point<double>(15., 10.)});
+    intersections = selfIntersections(network);
+    BOOST_REQUIRE_EQUAL(2, intersections.size());
+    BOOST_CHECK_EQUAL(0, intersections[0].segment1);
+    BOOST_CHECK_EQUAL(2, intersections[0].segment2);
+    BOOST_CHECK_EQUAL(1, intersections[1].segment1);
+    BOOST_CHECK_EQUAL(3, intersections[1].segment2);
+    BOOST_CHECK(Point<double>(15., 5.) == intersections[1].pt1);
+}
+
+BOOST_AUTO_TEST_CASE(polygons)
+{
+    PolygonD bowtie{Point<double>(0., 0.), Point<double>(10., 10.),
+                    Point<double>(10., 0.), Point<double>(0., 10.)};
+    auto intersections = selfIntersections(bowtie);
+    BOOST_REQUIRE_EQUAL(1, intersections.size());
+    BOOST_CHECK_EQUAL(0, intersections[0].segment1);
+    BOOST_CHECK_EQUAL(2, intersections[0].segment2);
+    BOOST_CHECK_CLOSE(5., intersections[0].pt1.x, 1e-10);
+    BOOST_CHECK_CLOSE(5., intersections[0].pt1.y, 1e-10);
+
+    /* Agujero que toca el anillo exterior */
+    PolygonD polygon{Point<double>(0., 0.), Point<double>(10., 0.),
+                     Point<double>(10., 10.), Point<double>(0., 10.)};
+    BOOST_CHECK(selfIntersections(polygon).empty());
+    polygon.addHole(PolygonHole<Point<double>>{Point<double>(5., 0.), Point<double>(7., 3.), Point<double>(3., 3.)});
+    intersections = selfIntersections(polygon);
+    BOOST_REQUIRE_EQUAL(2, intersections.size());
+    BOOST_CHECK_EQUAL(0, intersections[0].segment1);
+    BOOST_CHECK_EQUAL(4, intersections[0].segment2);
+    BOOST_CHECK_EQUAL(0, intersections[1].segment1);
+    BOOST_CHECK_EQUAL(6, intersections[1].segment2);
+    BOOST_CHECK(Point<double>(5., 0.) == intersections[1].pt1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -73,3 +73,21 @@ BOOST_AUTO_TEST_CASE(TEST_utmZoneFromLonLat)
   BOOST_CHECK_EQUAL('F', zone_band.second);
 
 }
+
+BOOST_AUTO_TEST_CASE(TEST_poleOfInaccessibility)
+{
+  /* Polígono en L: el círculo inscrito máximo toca el vértice reflejo (40, 40) */
+  Polygon<Point<double>> polygon{Point<double>(0., 0.),
+                                 Point<double>(100., 0.),
+                                 Point<double>(100., 40.),
+                                 Point<double>(40., 40.),
+                                 Point<double>(40., 100.),
+                                 Point<double>(0., 100.)};
+  Point<double> pole;
+  poleOfInaccessibility(polygon, &pole);
+
+  BOOST_CHECK(polygon.isInner(pole));
+  double radius = 40. * std::sqrt(2.) / (1. + std::sqrt(2.));
+  BOOST_CHECK_CLOSE(radius, pole.x, 0.1);
+  BOOST_CHECK_CLOSE(radius, pole.y, 0.1);
+}
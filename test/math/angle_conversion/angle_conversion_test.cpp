@@ -27,6 +27,9 @@
 #include <tidop/math/angles.h>
 #include <tidop/core/utils.h>
 
+#include <limits>
+#include <vector>
+
 using namespace tl;
 
 
@@ -954,3 +957,143 @@ BOOST_FIXTURE_TEST_CASE(gradians_to_radians, AngleConvertion)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+
+
+
+/* ---------------------------------------------------------------------------------- */
+/*                    Test conversión de arrays y trigonometría                       */
+/* ---------------------------------------------------------------------------------- */
+
+BOOST_AUTO_TEST_SUITE(AngleBatchTestSuite)
+
+BOOST_AUTO_TEST_CASE(convert_array)
+{
+    /// Tamaño que no es múltiplo del registro SIMD para probar la cola escalar
+    std::vector<double> degrees{0., 0.5, 135.574166, 86.999722, -269.385, 45., 360., -0.25, 12.5};
+    std::vector<double> radians(degrees.size());
+    std::vector<double> gradians(degrees.size());
+
+    AngleConverter<double>::convert(degrees.data(), radians.data(), degrees.size(),
+                                    Angle::Unit::degrees, Angle::Unit::radians);
+    AngleConverter<double>::convert(radians.data(), gradians.data(), radians.size(),
+                                    Angle::Unit::radians, Angle::Unit::gradians);
+
+    for (size_t i = 0; i < degrees.size(); i++) {
+        Radians<double> rad = Degrees<double>(degrees[i]);
+        BOOST_CHECK_EQUAL(rad.value(), radians[i]);
+        Gradians<double> grad = rad;
+        BOOST_CHECK_EQUAL(grad.value(), gradians[i]);
+    }
+
+    /// In-place
+    AngleConverter<double>::convert(gradians.data(), gradians.data(), gradians.size(),
+                                    Angle::Unit::gradians, Angle::Unit::degrees);
+
+    for (size_t i = 0; i < degrees.size(); i++) {
+        BOOST_CHECK_CLOSE(degrees[i] + 1., gradians[i] + 1., 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(convert_array_dms)
+{
+    std::vector<double> decimal_degrees{0., 0.5, 135.574166, 86.999722, -269.385};
+    std::vector<int> degrees(decimal_degrees.size());
+    std::vector<int> minutes(decimal_degrees.size());
+    std::vector<double> seconds(decimal_degrees.size());
+
+    AngleConverter<double>::convert(decimal_degrees.data(), degrees.data(), minutes.data(),
+                                    seconds.data(), decimal_degrees.size());
+
+    for (size_t i = 0; i < decimal_degrees.size(); i++) {
+        Degrees<double> deg(decimal_degrees[i]);
+        BOOST_CHECK_EQUAL(deg.degrees(), degrees[i]);
+        BOOST_CHECK_EQUAL(deg.minutes(), minutes[i]);
+        BOOST_CHECK_EQUAL(deg.seconds(), seconds[i]);
+    }
+
+    BOOST_CHECK_EQUAL(-269, degrees[4]);
+    BOOST_CHECK_EQUAL(23, minutes[4]);
+    BOOST_CHECK_EQUAL(6, roundToInteger(seconds[4]));
+
+    std::vector<double> result(decimal_degrees.size());
+    AngleConverter<double>::convert(degrees.data(), minutes.data(), seconds.data(),
+                                    result.data(), result.size());
+
+    for (size_t i = 0; i < decimal_degrees.size(); i++) {
+        BOOST_CHECK_EQUAL(Degrees<double>(degrees[i], minutes[i], seconds[i]).value(), result[i]);
+        BOOST_CHECK_CLOSE(decimal_degrees[i] + 1., result[i] + 1., 1e-10);
+    }
+}
+
+template<typename T>
+void checkTrigonometry(T range, T ulps)
+{
+    size_t size = 1003;
+    std::vector<T> angles(size);
+    std::vector<T> x(size);
+    std::vector<T> y(size);
+    for (size_t i = 0; i < size; i++) {
+        T t = static_cast<T>(i) / static_cast<T>(size - 1);
+        angles[i] = -range + consts::two<T> * range * t;
+        x[i] = std::cos(static_cast<T>(7 * i)) * static_cast<T>(i % 13);
+        y[i] = std::sin(static_cast<T>(5 * i)) * static_cast<T>(i % 7);
+    }
+
+    /// Out of the range of the fast reduction and non finite values
+    angles[1] = static_cast<T>(1.e6);
+    angles[2] = std::numeric_limits<T>::infinity();
+    x[3] = -std::numeric_limits<T>::infinity();
+    y[3] = std::numeric_limits<T>::infinity();
+    x[4] = std::numeric_limits<T>::quiet_NaN();
+    x[5] = consts::zero<T>;
+    y[5] = consts::zero<T>;
+
+    std::vector<T> sin(size);
+    std::vector<T> cos(size);
+    std::vector<T> sin_fast(size);
+    std::vector<T> cos_fast(size);
+    std::vector<T> atan2(size);
+    std::vector<T> atan2_fast(size);
+
+    Trigonometry<T>::sincos(angles.data(), sin.data(), cos.data(), size);
+    Trigonometry<T>::sincos(angles.data(), sin_fast.data(), cos_fast.data(), size, Precision::fast);
+    Trigonometry<T>::atan2(y.data(), x.data(), atan2.data(), size);
+    Trigonometry<T>::atan2(y.data(), x.data(), atan2_fast.data(), size, Precision::fast);
+
+    T tolerance = ulps * std::numeric_limits<T>::epsilon();
+
+    for (size_t i = 0; i < size; i++) {
+
+        BOOST_CHECK_EQUAL(std::sin(angles[i]) == sin[i] || std::isnan(sin[i]), true);
+        BOOST_CHECK_EQUAL(std::atan2(y[i], x[i]) == atan2[i] || std::isnan(atan2[i]), true);
+
+        if (std::isfinite(angles[i])) {
+            BOOST_CHECK_SMALL(sin[i] - sin_fast[i], tolerance);
+            BOOST_CHECK_SMALL(cos[i] - cos_fast[i], tolerance);
+        } else {
+            BOOST_CHECK(std::isnan(sin_fast[i]));
+            BOOST_CHECK(std::isnan(cos_fast[i]));
+        }
+
+        if (std::isnan(atan2[i])) {
+            BOOST_CHECK(std::isnan(atan2_fast[i]));
+        } else {
+            BOOST_CHECK_SMALL(atan2[i] - atan2_fast[i], static_cast<T>(4) * tolerance);
+        }
+    }
+
+    /// In-place
+    Trigonometry<T>::sincos(angles.data(), angles.data(), cos_fast.data(), size, Precision::fast);
+    for (size_t i = 0; i < size; i++) {
+        BOOST_CHECK_EQUAL(sin_fast[i] == angles[i] || std::isnan(angles[i]), true);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(trigonometry)
+{
+    checkTrigonometry<double>(100., 4.);
+    checkTrigonometry<float>(100.f, 4.f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
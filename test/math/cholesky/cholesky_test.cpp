@@ -24,6 +24,9 @@
  
 #define BOOST_TEST_MODULE Tidop cholesky test
 #include <boost/test/unit_test.hpp>
+
+#include <random>
+
 #include <tidop/math/algebra/cholesky.h>
 
 using namespace tl;
@@ -139,4 +142,51 @@ BOOST_FIXTURE_TEST_CASE(solve, CholeskyTest)
   BOOST_CHECK_CLOSE(1., C2[2], 0.1);
 }
 
+BOOST_AUTO_TEST_CASE(blocked)
+{
+  /// Larger than the blocked threshold and not a multiple of the block size
+  size_t n = 203;
+
+  std::mt19937 generator(12345);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  Matrix<double> m(n, n);
+  for (size_t r = 0; r < n; r++) {
+    for (size_t c = 0; c < n; c++) {
+      m[r][c] = distribution(generator);
+    }
+  }
+
+  Matrix<double> a = m * m.transpose();
+  for (size_t r = 0; r < n; r++) {
+    a[r][r] += 1.;
+  }
+
+  Matrix<double> mb(n, 3);
+  for (size_t r = 0; r < n; r++) {
+    for (size_t c = 0; c < 3; c++) {
+      mb[r][c] = std::cos(static_cast<double>(r * (c + 2)));
+    }
+  }
+
+  CholeskyDecomposition<Matrix<double>> decomp(a);
+
+  Matrix<double> l = decomp.l();
+  Matrix<double> llt = l * l.transpose();
+  for (size_t r = 0; r < n; r++) {
+    for (size_t c = 0; c < n; c++) {
+      BOOST_CHECK_SMALL(llt[r][c] - a[r][c], 1e-9);
+      if (c > r) BOOST_CHECK_EQUAL(0., l[r][c]);
+    }
+  }
+
+  Matrix<double> mx = decomp.solve(mb);
+  Matrix<double> amx = a * mx;
+  for (size_t r = 0; r < n; r++) {
+    for (size_t c = 0; c < 3; c++) {
+      BOOST_CHECK_SMALL(amx[r][c] - mb[r][c], 1e-8);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
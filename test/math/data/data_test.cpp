@@ -0,0 +1,132 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+ 
+#define BOOST_TEST_MODULE Tidop data test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/data.h>
+#include <tidop/math/algebra/matrix.h>
+
+#include <cstdint>
+
+using namespace tl;
+
+
+BOOST_AUTO_TEST_SUITE(DataTestSuite)
+
+using DynamicDatad = Data<double, DynamicData>;
+
+BOOST_AUTO_TEST_CASE(small_buffer)
+{
+  DynamicDatad data(9, 1.);
+  BOOST_CHECK(data.isSmall());
+  BOOST_CHECK_EQUAL(9, data.size());
+  for (auto value : data)
+    BOOST_CHECK_EQUAL(1., value);
+
+  DynamicDatad big(DynamicDatad::small_buffer_size + 1, 2.);
+  BOOST_CHECK(!big.isSmall());
+  BOOST_CHECK_EQUAL(0u, reinterpret_cast<std::uintptr_t>(big.data()) % DynamicDatad::alignment);
+}
+
+BOOST_AUTO_TEST_CASE(copy)
+{
+  DynamicDatad small{1., 2., 3.};
+  DynamicDatad small_copy(small);
+  BOOST_CHECK(small_copy.isSmall());
+  BOOST_CHECK_EQUAL(3., small_copy[2]);
+  small_copy[2] = 5.;
+  BOOST_CHECK_EQUAL(3., small[2]);
+
+  DynamicDatad big(100, 4.);
+  DynamicDatad big_copy(big);
+  BOOST_CHECK(big_copy.data() != big.data());
+  BOOST_CHECK_EQUAL(100, big_copy.size());
+  BOOST_CHECK_EQUAL(4., big_copy[99]);
+
+  small_copy = big;
+  BOOST_CHECK_EQUAL(100, small_copy.size());
+  BOOST_CHECK_EQUAL(4., small_copy.back());
+
+  big_copy = small;
+  BOOST_CHECK_EQUAL(3, big_copy.size());
+  BOOST_CHECK_EQUAL(3., big_copy.back());
+}
+
+BOOST_AUTO_TEST_CASE(move)
+{
+  DynamicDatad big(100, 4.);
+  const double *ptr = big.data();
+  DynamicDatad moved(std::move(big));
+  BOOST_CHECK(moved.data() == ptr);
+  BOOST_CHECK_EQUAL(100, moved.size());
+  BOOST_CHECK_EQUAL(0, big.size());
+
+  DynamicDatad small{1., 2., 3.};
+  DynamicDatad small_moved(std::move(small));
+  BOOST_CHECK(small_moved.isSmall());
+  BOOST_CHECK_EQUAL(2., small_moved[1]);
+
+  DynamicDatad assigned;
+  assigned = std::move(moved);
+  BOOST_CHECK(assigned.data() == ptr);
+  BOOST_CHECK_EQUAL(4., assigned[50]);
+
+  assigned = std::move(small_moved);
+  BOOST_CHECK_EQUAL(3, assigned.size());
+  BOOST_CHECK_EQUAL(3., assigned[2]);
+}
+
+BOOST_AUTO_TEST_CASE(resize)
+{
+  DynamicDatad data{1., 2., 3.};
+  data.resize(50, 7.);
+  BOOST_CHECK(!data.isSmall());
+  BOOST_CHECK_EQUAL(50, data.size());
+  BOOST_CHECK_EQUAL(3., data[2]);
+  BOOST_CHECK_EQUAL(7., data[49]);
+
+  data.resize(2);
+  BOOST_CHECK_EQUAL(2, data.size());
+  BOOST_CHECK_EQUAL(2., data.back());
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_matrix)
+{
+  Matrix<double> a(3, 3, 1.);
+  Matrix<double> b = a * a;
+  BOOST_CHECK_EQUAL(3., b(2, 2));
+
+  Matrix<double> c(20, 20, 1.);
+  Matrix<double> d = c * c;
+  BOOST_CHECK_EQUAL(20., d(19, 19));
+
+  Vector<double> v(3, 2.);
+  v.resize(40, 1.);
+  BOOST_CHECK_EQUAL(40, v.size());
+  BOOST_CHECK_EQUAL(2., v[2]);
+  BOOST_CHECK_EQUAL(1., v[39]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,241 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+
+#define BOOST_TEST_MODULE Tidop eigen test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/algebra/eigen.h>
+#include <tidop/math/algebra/eigen_batch.h>
+
+#include <random>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(EigenTestSuite)
+
+struct EigenTest
+{
+
+  EigenTest()
+  {}
+
+  ~EigenTest()
+  {}
+
+  void setup()
+  {
+    A = Matrix<double, 3, 3>{{2., -1., 0.},
+                             {-1., 2., -1.},
+                             {0., -1., 2.}};
+
+    std::mt19937 generator(2024);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+
+    B = Matrix<double>(6, 6);
+    for (size_t r = 0; r < 6; r++) {
+      for (size_t c = r; c < 6; c++) {
+        B(r, c) = distribution(generator);
+        B(c, r) = B(r, c);
+      }
+    }
+  }
+
+  void teardown()
+  {
+
+  }
+
+  /// Random covariance matrices R * diag(l) * R' and a few degenerate ones
+  template<typename T>
+  void covariances(size_t size,
+                   std::vector<T> &xx, std::vector<T> &xy, std::vector<T> &xz,
+                   std::vector<T> &yy, std::vector<T> &yz, std::vector<T> &zz)
+  {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> angle(-3.14159, 3.14159);
+    std::uniform_real_distribution<double> value(0., 10.);
+
+    xx.resize(size); xy.resize(size); xz.resize(size);
+    yy.resize(size); yz.resize(size); zz.resize(size);
+
+    for (size_t i = 0; i < size; i++) {
+
+      double l[3] = {value(generator), value(generator), value(generator)};
+
+      if (i % 97 == 1) l[1] = l[0];          // repeated smallest eigenvalue
+      if (i % 97 == 2) l[1] = l[2] = l[0];   // multiple of the identity
+      if (i % 97 == 3) l[0] = l[1] = l[2] = 0.;
+      if (i % 97 == 4) l[0] = 0.;            // flat neighbourhood
+
+      double a = angle(generator), b = angle(generator), c = angle(generator);
+      double ca = std::cos(a), sa = std::sin(a), cb = std::cos(b), sb = std::sin(b), cc = std::cos(c), sc = std::sin(c);
+      double R[3][3] = {{cb * cc, -cb * sc, sb},
+                        {sa * sb * cc + ca * sc, -sa * sb * sc + ca * cc, -sa * cb},
+                        {-ca * sb * cc + sa * sc, ca * sb * sc + sa * cc, ca * cb}};
+
+      double M[3][3];
+      for (int r = 0; r < 3; r++)
+        for (int s = 0; s < 3; s++)
+          M[r][s] = R[r][0] * l[0] * R[s][0] + R[r][1] * l[1] * R[s][1] + R[r][2] * l[2] * R[s][2];
+
+      xx[i] = static_cast<T>(M[0][0]); xy[i] = static_cast<T>(M[0][1]); xz[i] = static_cast<T>(M[0][2]);
+      yy[i] = static_cast<T>(M[1][1]); yz[i] = static_cast<T>(M[1][2]); zz[i] = static_cast<T>(M[2][2]);
+    }
+  }
+
+  template<typename T>
+  void checkBatch(size_t size, T tolerance)
+  {
+    std::vector<T> xx, xy, xz, yy, yz, zz;
+    covariances(size, xx, xy, xz, yy, yz, zz);
+
+    std::vector<T> l0(size), l1(size), l2(size), vx(size), vy(size), vz(size);
+    eigenSymmetric3x3(xx.data(), xy.data(), xz.data(), yy.data(), yz.data(), zz.data(),
+                      l0.data(), l1.data(), l2.data(),
+                      vx.data(), vy.data(), vz.data(), size);
+
+    for (size_t i = 0; i < size; i++) {
+
+      Matrix<double, 3, 3> M{{xx[i], xy[i], xz[i]},
+                             {xy[i], yy[i], yz[i]},
+                             {xz[i], yz[i], zz[i]}};
+      EigenDecomposition<Matrix<double, 3, 3>> eigen(M);
+      auto lambda = eigen.eigenvalues();
+
+      double norm = std::max(std::abs(lambda[0]), std::abs(lambda[2])) + 1.;
+
+      BOOST_CHECK_SMALL(lambda[0] - l0[i], tolerance * norm);
+      BOOST_CHECK_SMALL(lambda[1] - l1[i], tolerance * norm);
+      BOOST_CHECK_SMALL(lambda[2] - l2[i], tolerance * norm);
+
+      /// Unit eigenvector: |A v - l0 v| small
+      double v[3] = {vx[i], vy[i], vz[i]};
+      BOOST_CHECK_CLOSE(1., v[0] * v[0] + v[1] * v[1] + v[2] * v[2], tolerance * 100.);
+      for (size_t r = 0; r < 3; r++) {
+        double av = M[r][0] * v[0] + M[r][1] * v[1] + M[r][2] * v[2];
+        BOOST_CHECK_SMALL(av - l0[i] * v[r], tolerance * 10. * norm);
+      }
+    }
+  }
+
+  Matrix<double, 3, 3> A;
+  Matrix<double> B;
+};
+
+BOOST_FIXTURE_TEST_CASE(eigenvalues, EigenTest)
+{
+  EigenDecomposition<Matrix<double, 3, 3>> eigen(A);
+  auto values = eigen.eigenvalues();
+
+  BOOST_CHECK_CLOSE(2. - std::sqrt(2.), values[0], 1e-10);
+  BOOST_CHECK_CLOSE(2., values[1], 1e-10);
+  BOOST_CHECK_CLOSE(2. + std::sqrt(2.), values[2], 1e-10);
+
+  auto vectors = eigen.eigenvectors();
+  /// (1, sqrt(2), 1) / 2
+  BOOST_CHECK_CLOSE(0.5, std::abs(vectors[0][0]), 1e-10);
+  BOOST_CHECK_CLOSE(std::sqrt(2.) / 2., std::abs(vectors[1][0]), 1e-10);
+  BOOST_CHECK_CLOSE(0.5, std::abs(vectors[2][0]), 1e-10);
+}
+
+BOOST_FIXTURE_TEST_CASE(dynamic_matrix, EigenTest)
+{
+  EigenDecomposition<Matrix<double>> eigen(B);
+  auto values = eigen.eigenvalues();
+  auto vectors = eigen.eigenvectors();
+
+  for (size_t i = 1; i < 6; i++)
+    BOOST_CHECK(values[i - 1] <= values[i]);
+
+  for (size_t k = 0; k < 6; k++) {
+    for (size_t r = 0; r < 6; r++) {
+      double av = 0.;
+      for (size_t c = 0; c < 6; c++)
+        av += B(r, c) * vectors[c][k];
+      BOOST_CHECK_SMALL(av - values[k] * vectors[r][k], 1e-12);
+    }
+  }
+
+  /// Orthonormal eigenvectors
+  for (size_t i = 0; i < 6; i++) {
+    for (size_t j = 0; j < 6; j++) {
+      double dot = 0.;
+      for (size_t r = 0; r < 6; r++)
+        dot += vectors[r][i] * vectors[r][j];
+      BOOST_CHECK_SMALL(dot - (i == j ? 1. : 0.), 1e-12);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(diagonal_matrix, EigenTest)
+{
+  Matrix<double, 3, 3> D{{3., 0., 0.},
+                         {0., 1., 0.},
+                         {0., 0., 2.}};
+
+  EigenDecomposition<Matrix<double, 3, 3>> eigen(D);
+  auto values = eigen.eigenvalues();
+  auto vectors = eigen.eigenvectors();
+
+  BOOST_CHECK_EQUAL(1., values[0]);
+  BOOST_CHECK_EQUAL(2., values[1]);
+  BOOST_CHECK_EQUAL(3., values[2]);
+  BOOST_CHECK_EQUAL(1., std::abs(vectors[1][0]));
+  BOOST_CHECK_EQUAL(1., std::abs(vectors[2][1]));
+  BOOST_CHECK_EQUAL(1., std::abs(vectors[0][2]));
+}
+
+BOOST_FIXTURE_TEST_CASE(batch_3x3_double, EigenTest)
+{
+  checkBatch<double>(1003, 1e-9);
+}
+
+BOOST_FIXTURE_TEST_CASE(batch_3x3_float, EigenTest)
+{
+  checkBatch<float>(1003, 1e-4f);
+}
+
+BOOST_FIXTURE_TEST_CASE(batch_3x3_parallel, EigenTest)
+{
+  checkBatch<double>(20011, 1e-9);
+}
+
+BOOST_FIXTURE_TEST_CASE(batch_3x3_without_vectors, EigenTest)
+{
+  std::vector<double> xx, xy, xz, yy, yz, zz;
+  covariances(101, xx, xy, xz, yy, yz, zz);
+
+  std::vector<double> l0(101), l1(101), l2(101);
+  eigenSymmetric3x3<double>(xx.data(), xy.data(), xz.data(), yy.data(), yz.data(), zz.data(),
+                            l0.data(), l1.data(), l2.data(),
+                            nullptr, nullptr, nullptr, 101);
+
+  for (size_t i = 0; i < 101; i++) {
+    BOOST_CHECK(l0[i] <= l1[i] + 1e-9);
+    BOOST_CHECK(l1[i] <= l2[i] + 1e-9);
+    BOOST_CHECK_CLOSE(xx[i] + yy[i] + zz[i] + 1., l0[i] + l1[i] + l2[i] + 1., 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
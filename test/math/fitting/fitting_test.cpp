@@ -0,0 +1,317 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop fitting test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/geometry/analytic/fitting.h>
+
+#include <random>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(FittingTestSuite)
+
+struct FittingTest
+{
+
+    FittingTest()
+      : plane(Vector<double, 3>{1., 2., 2.}, -15.),
+        line(Vector<double, 3>{5., -3., 2.}, Vector<double, 3>{0.6, 0., 0.8}),
+        sphere(Vector<double, 3>{10., -5., 3.}, 2.5)
+    {
+    }
+
+    ~FittingTest() {}
+
+    void setup()
+    {
+        size = 400;
+        outliers = 120;
+        generator.seed(12345);
+    }
+
+    void teardown()
+    {
+
+    }
+
+    /// Puntos sobre el plano con ruido y outliers
+    void planePoints(double noise_sigma, size_t outliers_count)
+    {
+        std::uniform_real_distribution<double> coordinates(-20., 20.);
+        std::normal_distribution<double> noise(0., noise_sigma);
+        std::uniform_real_distribution<double> gross_error(1., 10.);
+
+        Vector<double, 3> normal = plane.normal();
+        Vector<double, 3> u{2. / 3., -2. / 3., 1. / 3.};
+        Vector<double, 3> v = crossProduct(normal, u);
+        Vector<double, 3> origin = normal * -plane.d();
+
+        clear();
+        for (size_t i = 0; i < size; i++) {
+            double a = coordinates(generator);
+            double b = coordinates(generator);
+            double offset = i < outliers_count ? gross_error(generator) : noise(generator);
+            add(origin + u * a + v * b + normal * offset);
+        }
+    }
+
+    void linePoints(double noise_sigma, size_t outliers_count)
+    {
+        std::uniform_real_distribution<double> coordinates(-20., 20.);
+        std::normal_distribution<double> noise(0., noise_sigma);
+        std::uniform_real_distribution<double> gross_error(1., 10.);
+
+        Vector<double, 3> u{0., 1., 0.};
+        Vector<double, 3> v{0.8, 0., -0.6};
+
+        clear();
+        for (size_t i = 0; i < size; i++) {
+            double offset_u = i < outliers_count ? gross_error(generator) : noise(generator);
+            double offset_v = i < outliers_count ? gross_error(generator) : noise(generator);
+            add(line.evaluate(coordinates(generator)) + u * offset_u + v * offset_v);
+        }
+    }
+
+    /// Casquete esférico (z > centro) con ruido y outliers
+    void spherePoints(double noise_sigma, size_t outliers_count)
+    {
+        std::normal_distribution<double> direction(0., 1.);
+        std::normal_distribution<double> noise(0., noise_sigma);
+        std::uniform_real_distribution<double> gross_error(0.5, 3.);
+
+        clear();
+        for (size_t i = 0; i < size; i++) {
+            Vector<double, 3> d{direction(generator), direction(generator), std::abs(direction(generator))};
+            d /= d.module();
+            double radius = sphere.radius() + (i < outliers_count ? gross_error(generator) : noise(generator));
+            add(sphere.center() + d * radius);
+        }
+    }
+
+    void clear()
+    {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    void add(const Vector<double, 3> &point)
+    {
+        x.push_back(point[0]);
+        y.push_back(point[1]);
+        z.push_back(point[2]);
+    }
+
+    void checkPlane(const Plane<double> &estimated, double tolerance) const
+    {
+        double sign = estimated.normal().dotProduct(plane.normal()) < 0. ? -1. : 1.;
+        for (size_t i = 0; i < 3; i++)
+            BOOST_CHECK_SMALL(plane.normal()[i] - sign * estimated.normal()[i], tolerance);
+        BOOST_CHECK_SMALL(plane.d() - sign * estimated.d(), tolerance * 10.);
+    }
+
+    void checkLine(const Line<double> &estimated, double tolerance) const
+    {
+        Vector<double, 3> direction = estimated.getDirection();
+        BOOST_CHECK_CLOSE(1., std::abs(direction.dotProduct(line.getDirection())), tolerance);
+        BOOST_CHECK_SMALL(line.distance(estimated.getOrigin()), tolerance);
+    }
+
+    void checkSphere(const Sphere<double> &estimated, double tolerance) const
+    {
+        for (size_t i = 0; i < 3; i++)
+            BOOST_CHECK_SMALL(sphere.center()[i] - estimated.center()[i], tolerance);
+        BOOST_CHECK_SMALL(sphere.radius() - estimated.radius(), tolerance);
+    }
+
+    Plane<double> plane;
+    Line<double> line;
+    Sphere<double> sphere;
+    size_t size;
+    size_t outliers;
+    std::mt19937 generator;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+};
+
+BOOST_FIXTURE_TEST_CASE(primitives, FittingTest)
+{
+    BOOST_CHECK_CLOSE(1., plane.normal().module(), 1e-12);
+    BOOST_CHECK_CLOSE(-5., plane.d(), 1e-12);
+    BOOST_CHECK_CLOSE(5., plane.distance(Vector<double, 3>{0., 0., 0.}), 1e-12);
+    BOOST_CHECK_CLOSE(-0.5, sphere.signedDistance(Vector<double, 3>{12., -5., 3.}), 1e-12);
+    BOOST_CHECK_SMALL(line.distance(line.evaluate(3.)), 1e-12);
+}
+
+BOOST_FIXTURE_TEST_CASE(plane_least_squares, FittingTest)
+{
+    planePoints(0., 0);
+    checkPlane(PlaneEstimator<double>::estimate(x.data(), y.data(), z.data(), size), 1e-10);
+
+    std::vector<Point3<double>> points(size);
+    for (size_t i = 0; i < size; i++)
+        points[i] = Point3<double>(x[i], y[i], z[i]);
+    checkPlane(PlaneEstimator<double>::estimate(points), 1e-10);
+
+    /// Puntos colineales
+    std::vector<double> collinear{0., 1., 2., 3.};
+    BOOST_CHECK_THROW(PlaneEstimator<double>::estimate(collinear.data(), collinear.data(), collinear.data(), 4), Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(line_least_squares, FittingTest)
+{
+    linePoints(0., 0);
+    checkLine(LineEstimator<double>::estimate(x.data(), y.data(), z.data(), size), 1e-10);
+}
+
+BOOST_FIXTURE_TEST_CASE(sphere_least_squares, FittingTest)
+{
+    spherePoints(0.01, 0);
+    checkSphere(SphereEstimator<double>::estimate(x.data(), y.data(), z.data(), size), 0.01);
+
+    Sphere<double> estimated;
+    std::vector<size_t> sample{0, 1, 2, 3};
+    BOOST_CHECK(SphereEstimator<double>::fitSample(x.data(), y.data(), z.data(), sample.data(), estimated));
+}
+
+BOOST_FIXTURE_TEST_CASE(plane_msac, FittingTest)
+{
+    planePoints(0.01, outliers);
+
+    RansacProperties properties;
+    properties.threshold = 0.1;
+
+    RobustFitting<PlaneEstimator<double>> fitting(properties);
+    checkPlane(fitting.estimate(x.data(), y.data(), z.data(), size), 1e-3);
+
+    BOOST_CHECK_EQUAL(size - outliers, fitting.inliersCount());
+    for (size_t i = 0; i < size; i++)
+        BOOST_CHECK(fitting.inliers()[i] == (i >= outliers));
+    BOOST_CHECK(fitting.iterations() < properties.maxIterations);
+}
+
+BOOST_FIXTURE_TEST_CASE(line_ransac, FittingTest)
+{
+    linePoints(0.01, outliers);
+
+    RansacProperties properties;
+    properties.threshold = 0.1;
+    properties.scoring = RansacScoring::ransac;
+
+    RobustFitting<LineEstimator<double>> fitting(properties);
+    checkLine(fitting.estimate(x.data(), y.data(), z.data(), size), 1e-3);
+    BOOST_CHECK_EQUAL(size - outliers, fitting.inliersCount());
+}
+
+BOOST_FIXTURE_TEST_CASE(sphere_msac, FittingTest)
+{
+    spherePoints(0.005, outliers);
+
+    RansacProperties properties;
+    properties.threshold = 0.05;
+
+    RobustFitting<SphereEstimator<double>> fitting(properties);
+    checkSphere(fitting.estimate(x.data(), y.data(), z.data(), size), 0.01);
+    BOOST_CHECK_EQUAL(size - outliers, fitting.inliersCount());
+}
+
+BOOST_FIXTURE_TEST_CASE(batch, FittingTest)
+{
+    /// Tres segmentos: plano, plano con outliers y puntos colineales
+    std::vector<double> bx, by, bz;
+    std::vector<size_t> offsets{0};
+
+    planePoints(0.01, 0);
+    bx.insert(bx.end(), x.begin(), x.end());
+    by.insert(by.end(), y.begin(), y.end());
+    bz.insert(bz.end(), z.begin(), z.end());
+    offsets.push_back(bx.size());
+
+    planePoints(0.01, outliers);
+    bx.insert(bx.end(), x.begin(), x.end());
+    by.insert(by.end(), y.begin(), y.end());
+    bz.insert(bz.end(), z.begin(), z.end());
+    offsets.push_back(bx.size());
+
+    for (int i = 0; i < 5; i++) {
+        bx.push_back(i);
+        by.push_back(2. * i);
+        bz.push_back(1.);
+    }
+    offsets.push_back(bx.size());
+
+    std::vector<Plane<double>> planes = PlaneEstimator<double>::estimateBatch(bx.data(), by.data(), bz.data(), offsets.data(), 3);
+    BOOST_REQUIRE_EQUAL(3, planes.size());
+
+    Plane<double> single = PlaneEstimator<double>::estimate(bx.data(), by.data(), bz.data(), size);
+    for (size_t i = 0; i < 3; i++)
+        BOOST_CHECK_SMALL(single.normal()[i] - planes[0].normal()[i], 1e-8);
+    BOOST_CHECK_SMALL(single.d() - planes[0].d(), 1e-8);
+    BOOST_CHECK_EQUAL(0., planes[2].normal().module());
+
+    std::vector<Line<double>> lines = LineEstimator<double>::estimateBatch(bx.data(), by.data(), bz.data(), offsets.data(), 3);
+    BOOST_CHECK_CLOSE(1., std::abs(lines[2].getDirection().dotProduct(Vector<double, 3>{0.4472135954999579, 0.8944271909999159, 0.})), 1e-8);
+
+    RansacProperties properties;
+    properties.threshold = 0.1;
+    properties.seed = 7;
+
+    RobustFitting<PlaneEstimator<double>> fitting(properties);
+    std::vector<Plane<double>> robust = fitting.estimateBatch(bx.data(), by.data(), bz.data(), offsets.data(), 3);
+    BOOST_REQUIRE_EQUAL(3, robust.size());
+    checkPlane(robust[0], 1e-3);
+    checkPlane(robust[1], 1e-3);
+    BOOST_CHECK_EQUAL(0., robust[2].normal().module());
+    BOOST_CHECK_EQUAL(size, fitting.batchInliersCount()[0]);
+    BOOST_CHECK_EQUAL(size - outliers, fitting.batchInliersCount()[1]);
+    BOOST_CHECK_EQUAL(0, fitting.batchInliersCount()[2]);
+
+    /// La semilla del subconjunto i es seed + i
+    properties.seed = 8;
+    fitting.setProperties(properties);
+    Plane<double> second = fitting.estimate(&bx[offsets[1]], &by[offsets[1]], &bz[offsets[1]], size);
+    BOOST_CHECK_EQUAL(second.d(), robust[1].d());
+}
+
+BOOST_FIXTURE_TEST_CASE(sphere_batch_float, FittingTest)
+{
+    spherePoints(0.001, 0);
+
+    std::vector<float> fx(x.begin(), x.end());
+    std::vector<float> fy(y.begin(), y.end());
+    std::vector<float> fz(z.begin(), z.end());
+    std::vector<size_t> offsets{0, size / 2, size};
+
+    std::vector<Sphere<float>> spheres = SphereEstimator<float>::estimateBatch(fx.data(), fy.data(), fz.data(), offsets.data(), 2);
+    for (const auto &estimated : spheres) {
+        for (size_t i = 0; i < 3; i++)
+            BOOST_CHECK_SMALL(static_cast<float>(sphere.center()[i]) - estimated.center()[i], 0.01f);
+        BOOST_CHECK_SMALL(static_cast<float>(sphere.radius()) - estimated.radius(), 0.01f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,338 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+
+#define BOOST_TEST_MODULE Tidop levenberg marquardt test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/optimization/levenberg_marquardt.h>
+
+#include <random>
+
+using namespace tl;
+
+namespace
+{
+
+struct ExponentialResidual
+{
+  ExponentialResidual(double x, double y)
+    : x(x), y(y)
+  {}
+
+  template<typename T>
+  bool operator()(const T *m, const T *c, T *residual) const
+  {
+    using std::exp;
+    residual[0] = T(y) - exp(m[0] * T(x) + c[0]);
+    return true;
+  }
+
+  double x;
+  double y;
+};
+
+class ExponentialAnalytic
+  : public CostFunction<double>
+{
+
+public:
+
+  ExponentialAnalytic(double x, double y)
+    : CostFunction<double>(1, {2}), x(x), y(y)
+  {}
+
+  bool evaluate(const double *const *parameters,
+                double *residuals,
+                double **jacobians) const override
+  {
+    double m = parameters[0][0];
+    double c = parameters[0][1];
+    double e = std::exp(m * x + c);
+    residuals[0] = y - e;
+    if (jacobians && jacobians[0]) {
+      jacobians[0][0] = -x * e;
+      jacobians[0][1] = -e;
+    }
+    return true;
+  }
+
+private:
+
+  double x;
+  double y;
+};
+
+struct LineResidual
+{
+  LineResidual(double x, double y)
+    : x(x), y(y)
+  {}
+
+  template<typename T>
+  bool operator()(const T *line, T *residual) const
+  {
+    residual[0] = T(y) - (line[0] * T(x) + line[1]);
+    return true;
+  }
+
+  double x;
+  double y;
+};
+
+struct PointDistance
+{
+  PointDistance(double distance)
+    : distance(distance)
+  {}
+
+  /// Distance between a fixed station and a point
+  template<typename T>
+  bool operator()(const T *station, const T *point, T *residual) const
+  {
+    using std::sqrt;
+    T dx = point[0] - station[0];
+    T dy = point[1] - station[1];
+    residual[0] = sqrt(dx * dx + dy * dy) - T(distance);
+    return true;
+  }
+
+  double distance;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(LevenbergMarquardtTestSuite)
+
+struct LevenbergMarquardtTest
+{
+
+  LevenbergMarquardtTest()
+  {}
+
+  ~LevenbergMarquardtTest()
+  {}
+
+  void setup()
+  {
+    std::mt19937 generator(1234);
+    std::normal_distribution<double> noise(0., 0.01);
+
+    for (int i = 0; i < 60; i++) {
+      double x = 0.1 * i;
+      data_x.push_back(x);
+      data_y.push_back(std::exp(0.3 * x + 0.1) + noise(generator));
+    }
+
+    for (int i = 0; i < 100; i++) {
+      double x = static_cast<double>(i);
+      double y = 2. * x - 5. + noise(generator);
+      if (i % 10 == 0) y += 150.;
+      line_x.push_back(x);
+      line_y.push_back(y);
+    }
+  }
+
+  void teardown()
+  {
+
+  }
+
+  std::vector<double> data_x;
+  std::vector<double> data_y;
+  std::vector<double> line_x;
+  std::vector<double> line_y;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(jet, LevenbergMarquardtTest)
+{
+  using J = Jet<double, 2>;
+
+  J x(3., 0);
+  J y(0.5, 1);
+
+  J f = x * sin(y) + exp(x) / y - 2. * sqrt(x) + atan2(y, x);
+
+  BOOST_CHECK_CLOSE(3. * std::sin(0.5) + std::exp(3.) / 0.5 - 2. * std::sqrt(3.) + std::atan2(0.5, 3.), f.a, 1e-10);
+  /// df/dx
+  BOOST_CHECK_CLOSE(std::sin(0.5) + std::exp(3.) / 0.5 - 1. / std::sqrt(3.) - 0.5 / (9. + 0.25), f.v[0], 1e-10);
+  /// df/dy
+  BOOST_CHECK_CLOSE(3. * std::cos(0.5) - std::exp(3.) / 0.25 + 3. / (9. + 0.25), f.v[1], 1e-10);
+
+  J g = pow(x, 3.) - log(x) * cos(y);
+  BOOST_CHECK_CLOSE(27. - std::log(3.) * std::cos(0.5), g.a, 1e-10);
+  BOOST_CHECK_CLOSE(27. - std::cos(0.5) / 3., g.v[0], 1e-10);
+  BOOST_CHECK_CLOSE(std::log(3.) * std::sin(0.5), g.v[1], 1e-10);
+}
+
+BOOST_FIXTURE_TEST_CASE(loss_functions, LevenbergMarquardtTest)
+{
+  double rho[3];
+
+  TrivialLoss<double> trivial;
+  trivial.evaluate(4., rho);
+  BOOST_CHECK_EQUAL(4., rho[0]);
+  BOOST_CHECK_EQUAL(1., rho[1]);
+  BOOST_CHECK_EQUAL(0., rho[2]);
+
+  HuberLoss<double> huber(1.);
+  huber.evaluate(0.25, rho);
+  BOOST_CHECK_EQUAL(0.25, rho[0]);
+  huber.evaluate(4., rho);
+  BOOST_CHECK_CLOSE(3., rho[0], 1e-10);
+  BOOST_CHECK_CLOSE(0.5, rho[1], 1e-10);
+
+  CauchyLoss<double> cauchy(2.);
+  cauchy.evaluate(4., rho);
+  BOOST_CHECK_CLOSE(4. * std::log(2.), rho[0], 1e-10);
+  BOOST_CHECK_CLOSE(0.5, rho[1], 1e-10);
+  BOOST_CHECK_CLOSE(-0.0625, rho[2], 1e-10);
+}
+
+BOOST_FIXTURE_TEST_CASE(auto_diff_curve_fitting, LevenbergMarquardtTest)
+{
+  double m = 0.;
+  double c = 0.;
+
+  LeastSquaresProblem<double> problem;
+  for (size_t i = 0; i < data_x.size(); i++) {
+    problem.addResidualBlock(std::make_shared<AutoDiffCostFunction<ExponentialResidual, double, 1, 1, 1>>(ExponentialResidual(data_x[i], data_y[i])),
+                             nullptr, {&m, &c});
+  }
+
+  BOOST_CHECK_EQUAL(60, problem.numResidualBlocks());
+  BOOST_CHECK_EQUAL(2, problem.numParameterBlocks());
+  BOOST_CHECK_EQUAL(2, problem.numParameters());
+
+  LevenbergMarquardt<double> solver;
+  auto summary = solver.solve(problem);
+
+  BOOST_CHECK(summary.termination != LevenbergMarquardtTermination::failure);
+  BOOST_CHECK(summary.finalCost < summary.initialCost);
+  BOOST_CHECK_CLOSE(summary.finalCost, problem.cost(), 1e-6);
+  BOOST_CHECK_SMALL(m - 0.3, 0.005);
+  BOOST_CHECK_SMALL(c - 0.1, 0.01);
+}
+
+BOOST_FIXTURE_TEST_CASE(analytic_curve_fitting, LevenbergMarquardtTest)
+{
+  double parameters[2] = {0., 0.};
+  double m = 0.;
+  double c = 0.;
+
+  LeastSquaresProblem<double> analytic;
+  LeastSquaresProblem<double> automatic;
+  for (size_t i = 0; i < data_x.size(); i++) {
+    analytic.addResidualBlock(std::make_shared<ExponentialAnalytic>(data_x[i], data_y[i]), nullptr, {parameters});
+    automatic.addResidualBlock(std::make_shared<AutoDiffCostFunction<ExponentialResidual, double, 1, 1, 1>>(ExponentialResidual(data_x[i], data_y[i])),
+                               nullptr, {&m, &c});
+  }
+
+  LevenbergMarquardt<double> solver;
+  solver.solve(analytic);
+  solver.solve(automatic);
+
+  BOOST_CHECK_CLOSE(m, parameters[0], 1e-4);
+  BOOST_CHECK_CLOSE(c, parameters[1], 1e-4);
+}
+
+BOOST_FIXTURE_TEST_CASE(robust_loss, LevenbergMarquardtTest)
+{
+  double trivial_line[2] = {0., 0.};
+  double huber_line[2] = {0., 0.};
+  double cauchy_line[2] = {0., 0.};
+
+  LeastSquaresProblem<double> trivial;
+  LeastSquaresProblem<double> huber;
+  LeastSquaresProblem<double> cauchy;
+
+  for (size_t i = 0; i < line_x.size(); i++) {
+    auto cost = std::make_shared<AutoDiffCostFunction<LineResidual, double, 1, 2>>(LineResidual(line_x[i], line_y[i]));
+    trivial.addResidualBlock(cost, nullptr, {trivial_line});
+    huber.addResidualBlock(cost, std::make_shared<HuberLoss<double>>(0.1), {huber_line});
+    cauchy.addResidualBlock(cost, std::make_shared<CauchyLoss<double>>(0.1), {cauchy_line});
+  }
+
+  LevenbergMarquardt<double> solver;
+  solver.solve(trivial);
+  solver.solve(huber);
+  solver.solve(cauchy);
+
+  BOOST_CHECK(std::abs(trivial_line[1] + 5.) > 5.);
+  BOOST_CHECK_SMALL(huber_line[0] - 2., 0.01);
+  BOOST_CHECK_SMALL(huber_line[1] + 5., 0.5);
+  BOOST_CHECK_SMALL(cauchy_line[0] - 2., 0.001);
+  BOOST_CHECK_SMALL(cauchy_line[1] + 5., 0.05);
+}
+
+BOOST_FIXTURE_TEST_CASE(constant_parameter_block, LevenbergMarquardtTest)
+{
+  /// Trilateration of 50 points from 4 stations. The first station is fixed
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> coordinates(-50., 50.);
+  std::uniform_real_distribution<double> perturbation(-1., 1.);
+
+  std::vector<std::array<double, 2>> stations{{{0., 0.}}, {{100., 0.}}, {{0., 100.}}, {{100., 100.}}};
+  std::vector<std::array<double, 2>> stations_true = stations;
+  std::vector<std::array<double, 2>> points(50);
+  std::vector<std::array<double, 2>> points_true(50);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    points_true[i] = {{50. + coordinates(generator), 50. + coordinates(generator)}};
+    points[i] = {{points_true[i][0] + perturbation(generator), points_true[i][1] + perturbation(generator)}};
+  }
+
+  LeastSquaresProblem<double> problem;
+
+  for (size_t i = 0; i < points.size(); i++) {
+    for (size_t j = 0; j < stations.size(); j++) {
+      double dx = points_true[i][0] - stations_true[j][0];
+      double dy = points_true[i][1] - stations_true[j][1];
+      problem.addResidualBlock(std::make_shared<AutoDiffCostFunction<PointDistance, double, 1, 2, 2>>(PointDistance(std::sqrt(dx * dx + dy * dy))),
+                               nullptr, {stations[j].data(), points[i].data()});
+    }
+  }
+
+  for (auto &station : stations)
+    problem.setParameterBlockConstant(station.data());
+
+  BOOST_CHECK_EQUAL(100, problem.numParameters());
+
+  LevenbergMarquardt<double> solver;
+  auto summary = solver.solve(problem);
+
+  BOOST_CHECK(summary.finalCost < 1e-12);
+  for (size_t i = 0; i < points.size(); i++) {
+    BOOST_CHECK_SMALL(points[i][0] - points_true[i][0], 1e-6);
+    BOOST_CHECK_SMALL(points[i][1] - points_true[i][1], 1e-6);
+  }
+
+  for (size_t j = 0; j < stations.size(); j++) {
+    BOOST_CHECK_EQUAL(stations_true[j][0], stations[j][0]);
+    BOOST_CHECK_EQUAL(stations_true[j][1], stations[j][1]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
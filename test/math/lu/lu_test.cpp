@@ -24,6 +24,9 @@
  
 #define BOOST_TEST_MODULE Tidop lu test
 #include <boost/test/unit_test.hpp>
+
+#include <random>
+
 #include <tidop/math/algebra/lu.h>
 #include <tidop/math/algebra/matrix.h>
 
@@ -204,4 +207,43 @@ BOOST_FIXTURE_TEST_CASE(solve_matrix, LuTest)
 
 }
 
+BOOST_AUTO_TEST_CASE(blocked)
+{
+  /// Larger than the blocked threshold and not a multiple of the block size
+  size_t n = 203;
+
+  std::mt19937 generator(12345);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  Matrix<double> a(n, n);
+  Vector<double> b(n);
+  Matrix<double> mb(n, 3);
+
+  for (size_t r = 0; r < n; r++) {
+    for (size_t c = 0; c < n; c++) {
+      a[r][c] = distribution(generator);
+    }
+    b[r] = std::cos(static_cast<double>(r));
+    for (size_t c = 0; c < 3; c++) {
+      mb[r][c] = std::cos(static_cast<double>(r * (c + 2)));
+    }
+  }
+
+  LuDecomposition<Matrix<double>> decomp(a);
+
+  Vector<double> x = decomp.solve(b);
+  Vector<double> ax = a * x;
+  for (size_t r = 0; r < n; r++) {
+    BOOST_CHECK_SMALL(ax[r] - b[r], 1e-9);
+  }
+
+  Matrix<double> mx = decomp.solve(mb);
+  Matrix<double> amx = a * mx;
+  for (size_t r = 0; r < n; r++) {
+    for (size_t c = 0; c < 3; c++) {
+      BOOST_CHECK_SMALL(amx[r][c] - mb[r][c], 1e-9);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,10 @@
 #define BOOST_TEST_MODULE Tidop matrix test
 #include <boost/test/unit_test.hpp>
 #include <tidop/math/algebra/matrix.h>
+#include <tidop/core/path.h>
+
+#include <random>
+#include <thread>
 
 using namespace tl;
 
@@ -4226,4 +4230,235 @@ BOOST_FIXTURE_TEST_CASE(block, MatrixBlockTest)
 
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_SUITE_END()
+
+
+
+BOOST_AUTO_TEST_SUITE(MatrixFixedSizeTestSuite)
+
+template<typename T, size_t N>
+Matrix<T, N, N> randomMatrix(std::mt19937 &generator)
+{
+  std::uniform_real_distribution<T> distribution(-1, 1);
+  Matrix<T, N, N> matrix;
+  for (size_t r = 0; r < N; r++) {
+    for (size_t c = 0; c < N; c++) {
+      matrix(r, c) = distribution(generator);
+    }
+    matrix(r, r) += static_cast<T>(N);
+  }
+  return matrix;
+}
+
+template<typename T, size_t N>
+Matrix<T> toDynamic(const Matrix<T, N, N> &matrix)
+{
+  Matrix<T> dynamic(N, N);
+  for (size_t r = 0; r < N; r++)
+    for (size_t c = 0; c < N; c++)
+      dynamic(r, c) = matrix(r, c);
+  return dynamic;
+}
+
+template<typename T, size_t N>
+void checkFixedSize(std::mt19937 &generator, T tolerance)
+{
+  Matrix<T, N, N> a = randomMatrix<T, N>(generator);
+  Matrix<T, N, N> b = randomMatrix<T, N>(generator);
+
+  Matrix<T> product = toDynamic(a) * toDynamic(b);
+  Matrix<T, N, N> fixed_product = a * b;
+
+  Vector<T, N> x;
+  for (size_t i = 0; i < N; i++)
+    x[i] = static_cast<T>(i + 1);
+  Vector<T, N> y = a * x;
+
+  Matrix<T, N, N> transposed = a.transpose();
+
+  bool invertible = false;
+  Matrix<T, N, N> identity = a * a.inverse(&invertible);
+  BOOST_CHECK(invertible);
+
+  for (size_t r = 0; r < N; r++) {
+    T y_r = 0;
+    for (size_t c = 0; c < N; c++) {
+      BOOST_CHECK_SMALL(fixed_product(r, c) - product(r, c), tolerance);
+      BOOST_CHECK_EQUAL(a(c, r), transposed(r, c));
+      BOOST_CHECK_SMALL(identity(r, c) - (r == c ? T{1} : T{0}), tolerance);
+      y_r += a(r, c) * x[c];
+    }
+    BOOST_CHECK_SMALL(y[r] - y_r, tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fixed_size_operations)
+{
+  std::mt19937 generator(42);
+
+  for (int i = 0; i < 10; i++) {
+    checkFixedSize<double, 2>(generator, 1e-12);
+    checkFixedSize<double, 3>(generator, 1e-12);
+    checkFixedSize<double, 4>(generator, 1e-12);
+    checkFixedSize<float, 2>(generator, 1e-5f);
+    checkFixedSize<float, 3>(generator, 1e-5f);
+    checkFixedSize<float, 4>(generator, 1e-5f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(singular_inverse)
+{
+  Matrix<double, 3, 3> singular{1, 2, 3,
+                                2, 4, 6,
+                                1, 0, 1};
+
+  bool invertible = true;
+  Matrix<double, 3, 3> inverse = singular.inverse(&invertible);
+  BOOST_CHECK(!invertible);
+  BOOST_CHECK_EQUAL(0., singular.determinant());
+  BOOST_CHECK_EQUAL(6., inverse(1, 2));
+}
+
+constexpr double constexprDeterminant()
+{
+  double a[9] = {1, 2, 0,
+                 0, 1, 3,
+                 0, 0, 1};
+  double b[9]{};
+  internal::transpose3x3_cpp(a, b);
+  double c[9]{};
+  internal::mulmat3x3_cpp(a, b, c);
+  return internal::determinant3x3(c);
+}
+
+constexpr double constexprInverse()
+{
+  double a[16] = {2, 0, 0, 1,
+                  0, 4, 0, 0,
+                  0, 0, 8, 0,
+                  0, 0, 0, 1};
+  double inverse[16]{};
+  internal::inverse4x4(a, inverse);
+  return inverse[0] + inverse[3] + inverse[5];
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_kernels)
+{
+  // det(A * A^T) = det(A)^2 = 1
+  static_assert(constexprDeterminant() == 1., "");
+  static_assert(constexprInverse() == 0.5 - 0.5 + 0.25, "");
+  BOOST_CHECK_EQUAL(1., constexprDeterminant());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+/* MatrixConfig */
+
+BOOST_AUTO_TEST_SUITE(MatrixConfigTestSuite)
+
+struct MatrixConfigTest
+{
+  MatrixConfigTest()
+    : product(MatrixConfig::instance().product),
+      thresholds(MatrixConfig::thresholds()),
+      a(37, 53),
+      b(53, 29)
+  {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+
+    for (size_t r = 0; r < a.rows(); r++)
+      for (size_t c = 0; c < a.cols(); c++)
+        a(r, c) = distribution(random);
+    for (size_t r = 0; r < b.rows(); r++)
+      for (size_t c = 0; c < b.cols(); c++)
+        b(r, c) = distribution(random);
+  }
+
+  ~MatrixConfigTest()
+  {
+    MatrixConfig::instance().product = product;
+    MatrixConfig::setThresholds(thresholds);
+  }
+
+  MatrixConfig::Product product;
+  MatrixConfig::Thresholds thresholds;
+  Matrix<double> a;
+  Matrix<double> b;
+};
+
+BOOST_FIXTURE_TEST_CASE(backends_agree, MatrixConfigTest)
+{
+  MatrixConfig::instance().product = MatrixConfig::Product::CPP;
+  Matrix<double> reference = a * b;
+
+  std::vector<MatrixConfig::Product> products{MatrixConfig::Product::Auto,
+                                              MatrixConfig::Product::Blocked};
+#ifdef TL_HAVE_SIMD_INTRINSICS
+  products.push_back(MatrixConfig::Product::SIMD);
+#endif
+
+  for (auto product : products) {
+    MatrixConfig::instance().product = product;
+    Matrix<double> c = a * b;
+    BOOST_REQUIRE_EQUAL(reference.rows(), c.rows());
+    BOOST_REQUIRE_EQUAL(reference.cols(), c.cols());
+    for (size_t r = 0; r < c.rows(); r++)
+      for (size_t col = 0; col < c.cols(); col++)
+        BOOST_CHECK_CLOSE(reference(r, col), c(r, col), 1e-9);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(select_by_size, MatrixConfigTest)
+{
+  MatrixConfig::Thresholds custom;
+  custom.blocked = 1000;
+  MatrixConfig::setThresholds(custom);
+
+  MatrixConfig &config = MatrixConfig::instance();
+  config.product = MatrixConfig::Product::Auto;
+
+  BOOST_CHECK(MatrixConfig::Product::Blocked == config.select(10, 10, 10));
+  BOOST_CHECK(MatrixConfig::Product::Blocked != config.select(9, 10, 10));
+
+  config.product = MatrixConfig::Product::CPP;
+  BOOST_CHECK(MatrixConfig::Product::CPP == config.select(100, 100, 100));
+}
+
+BOOST_FIXTURE_TEST_CASE(thread_local_override, MatrixConfigTest)
+{
+  MatrixConfig::instance().product = MatrixConfig::Product::CPP;
+
+  MatrixConfig::Product other_thread = MatrixConfig::Product::CPP;
+  std::thread thread([&other_thread]() {
+    other_thread = MatrixConfig::instance().product;
+  });
+  thread.join();
+
+  BOOST_CHECK(MatrixConfig::Product::Auto == other_thread);
+  BOOST_CHECK(MatrixConfig::Product::CPP == MatrixConfig::instance().product);
+}
+
+BOOST_FIXTURE_TEST_CASE(autotune_cache, MatrixConfigTest)
+{
+  Path file = Path::tempPath();
+  file.append("tidop_matrix_autotune.txt");
+  if (file.exists()) Path::removeFile(file);
+
+  MatrixConfig::Thresholds tuned = MatrixConfig::autotune(file);
+  BOOST_CHECK(file.exists());
+  BOOST_CHECK_EQUAL(tuned.blocked, MatrixConfig::thresholds().blocked);
+
+  MatrixConfig::setThresholds(MatrixConfig::Thresholds());
+
+  MatrixConfig::Thresholds cached = MatrixConfig::autotune(file);
+  BOOST_CHECK_EQUAL(tuned.blocked, cached.blocked);
+  BOOST_CHECK_EQUAL(tuned.blas, cached.blas);
+  BOOST_CHECK_EQUAL(tuned.cublas, cached.cublas);
+  BOOST_CHECK_EQUAL(tuned.blocked, MatrixConfig::thresholds().blocked);
+
+  Path::removeFile(file);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
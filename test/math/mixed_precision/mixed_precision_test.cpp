@@ -0,0 +1,228 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with Foobar. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+
+
+#define BOOST_TEST_MODULE Tidop mixed precision test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/geometry/affine.h>
+#include <tidop/math/geometry/helmert.h>
+#include <tidop/math/geometry/umeyama.h>
+
+#include <random>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(MixedPrecisionTestSuite)
+
+/*!
+ * Georreferenciación: coordenadas UTM (huso 30) de puntos de apoyo y
+ * coordenadas locales de un levantamiento con ruido de 1 cm
+ */
+struct MixedPrecisionTest
+{
+
+    MixedPrecisionTest()
+      : affine(1.0003, 0.9998, 452318.25, 4489577.5, 0.35),
+        helmert(0.9996, 0.9996, 452318.25, 4489577.5, -1.2),
+        similarity(Matrix<double, 3, 4>{{0.9994 * 0.8, -0.9994 * 0.6, 0., 452318.25},
+                                        {0.9994 * 0.6, 0.9994 * 0.8, 0., 4489577.5},
+                                        {0., 0., 0.9994, 652.75}})
+    {
+    }
+
+    ~MixedPrecisionTest() {}
+
+    void setup()
+    {
+        size = 2000;
+
+        std::mt19937 generator(4321);
+        std::uniform_real_distribution<double> coordinates(-2500., 2500.);
+        std::uniform_real_distribution<double> heights(-50., 150.);
+        std::normal_distribution<double> noise(0., 0.01);
+
+        local_2d = Matrix<double>(size, 2);
+        local_3d = Matrix<double>(size, 3);
+        noise_3d = Matrix<double>(size, 3);
+
+        for (size_t i = 0; i < size; i++) {
+            local_2d(i, 0) = local_3d(i, 0) = coordinates(generator);
+            local_2d(i, 1) = local_3d(i, 1) = coordinates(generator);
+            local_3d(i, 2) = heights(generator);
+            for (size_t c = 0; c < 3; c++)
+                noise_3d(i, c) = noise(generator);
+        }
+    }
+
+    void teardown()
+    {
+
+    }
+
+    template<typename Model>
+    auto utm(const Model &model) const -> Matrix<double>
+    {
+        Matrix<double> dst(size, 2);
+        for (size_t i = 0; i < size; i++) {
+            Point<double> point = model.transform(Point<double>(local_2d(i, 0), local_2d(i, 1)));
+            dst(i, 0) = point.x + noise_3d(i, 0);
+            dst(i, 1) = point.y + noise_3d(i, 1);
+        }
+        return dst;
+    }
+
+    /// Parámetros de la transformación con los puntos a 1000 m del centro
+    template<typename Model1, typename Model2>
+    void checkParity(const Model1 &exact, const Model2 &fast, size_t dim) const
+    {
+        for (size_t r = 0; r < dim; r++) {
+            for (size_t c = 0; c < dim; c++)
+                BOOST_CHECK_SMALL(exact(r, c) - fast(r, c), 1e-8);
+            BOOST_CHECK_SMALL(exact(r, dim) - fast(r, dim), 1e-5);
+        }
+    }
+
+    Affine<double, 2> affine;
+    Affine<double, 2> helmert;
+    Affine<double, 3> similarity;
+    size_t size;
+    Matrix<double> local_2d;
+    Matrix<double> local_3d;
+    Matrix<double> noise_3d;
+};
+
+BOOST_FIXTURE_TEST_CASE(affine_2d, MixedPrecisionTest)
+{
+    Matrix<double> dst = utm(affine);
+
+    Affine<double, 2> exact = Affine2DEstimator<double>::estimate(local_2d, dst);
+    Affine<double, 2> fast = Affine2DEstimator<double>::estimate(local_2d, dst, Precision::fast);
+
+    checkParity(exact, fast, 2);
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_SMALL(affine(r, c) - fast(r, c), 1e-3);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(affine_2d_utm_source, MixedPrecisionTest)
+{
+    /// Transformación inversa: el origen son coordenadas UTM
+    Matrix<double> src = utm(affine);
+
+    Affine<double, 2> exact = Affine2DEstimator<double>::estimate(src, local_2d);
+    Affine<double, 2> fast = Affine2DEstimator<double>::estimate(src, local_2d, Precision::fast);
+
+    /// La traslación depende de las coordenadas UTM (4.5e6 m)
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 2; c++)
+            BOOST_CHECK_SMALL(exact(r, c) - fast(r, c), 1e-8);
+        BOOST_CHECK_SMALL(exact(r, 2) - fast(r, 2), 0.01);
+    }
+
+    /// Residuos de las dos soluciones
+    double exact_error = 0.;
+    double fast_error = 0.;
+    for (size_t i = 0; i < size; i++) {
+        Point<double> point(src(i, 0), src(i, 1));
+        Point<double> exact_point = exact.transform(point);
+        Point<double> fast_point = fast.transform(point);
+        exact_error += std::pow(exact_point.x - local_2d(i, 0), 2) + std::pow(exact_point.y - local_2d(i, 1), 2);
+        fast_error += std::pow(fast_point.x - local_2d(i, 0), 2) + std::pow(fast_point.y - local_2d(i, 1), 2);
+    }
+
+    BOOST_CHECK_CLOSE(exact_error, fast_error, 1e-3);
+}
+
+BOOST_FIXTURE_TEST_CASE(helmert_2d, MixedPrecisionTest)
+{
+    Matrix<double> dst = utm(helmert);
+
+    Affine<double, 2> exact = HelmertEstimator<double, 2>::estimate(local_2d, dst);
+    Affine<double, 2> fast = HelmertEstimator<double, 2>::estimate(local_2d, dst, Precision::fast);
+
+    checkParity(exact, fast, 2);
+    BOOST_CHECK_SMALL(fast(0, 0) - fast(1, 1), 1e-12);
+    BOOST_CHECK_SMALL(fast(0, 1) + fast(1, 0), 1e-12);
+}
+
+BOOST_FIXTURE_TEST_CASE(umeyama_2d, MixedPrecisionTest)
+{
+    Matrix<double> dst = utm(helmert);
+
+    Affine<double, 2> exact = Umeyama<double, 2>::estimate(local_2d, dst);
+    Affine<double, 2> fast = Umeyama<double, 2>::estimate(local_2d, dst, Precision::fast);
+
+    for (size_t r = 0; r < 2; r++)
+        for (size_t c = 0; c < 2; c++)
+            BOOST_CHECK_SMALL(exact(r, c) - fast(r, c), 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(umeyama_3d, MixedPrecisionTest)
+{
+    Matrix<double> dst(size, 3);
+    for (size_t i = 0; i < size; i++) {
+        Point3<double> point = similarity.transform(Point3<double>(local_3d(i, 0), local_3d(i, 1), local_3d(i, 2)));
+        dst(i, 0) = point.x + noise_3d(i, 0);
+        dst(i, 1) = point.y + noise_3d(i, 1);
+        dst(i, 2) = point.z + noise_3d(i, 2);
+    }
+
+    Affine<double, 3> exact = Umeyama<double, 3>::estimate(local_3d, dst);
+    Affine<double, 3> fast = Umeyama<double, 3>::estimate(local_3d, dst, Precision::fast);
+
+    checkParity(exact, fast, 3);
+
+    for (size_t r = 0; r < 3; r++) {
+        for (size_t c = 0; c < 4; c++) {
+            BOOST_CHECK_SMALL(similarity(r, c) - fast(r, c), 1e-3);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(float_input, MixedPrecisionTest)
+{
+    /// Coordenadas locales en float
+    Matrix<float> src(size, 2);
+    Matrix<float> dst(size, 2);
+    for (size_t i = 0; i < size; i++) {
+        src(i, 0) = static_cast<float>(local_2d(i, 0));
+        src(i, 1) = static_cast<float>(local_2d(i, 1));
+        dst(i, 0) = static_cast<float>(1.2 * local_2d(i, 0) + 0.3 * local_2d(i, 1) + 100.);
+        dst(i, 1) = static_cast<float>(-0.3 * local_2d(i, 0) + 0.9 * local_2d(i, 1) - 50.);
+    }
+
+    Affine<float, 2> fast = Affine2DEstimator<float>::estimate(src, dst, Precision::fast);
+
+    BOOST_CHECK_CLOSE(1.2f, fast(0, 0), 1e-3f);
+    BOOST_CHECK_CLOSE(0.3f, fast(0, 1), 1e-3f);
+    BOOST_CHECK_CLOSE(100.f, fast(0, 2), 1e-3f);
+    BOOST_CHECK_CLOSE(-0.3f, fast(1, 0), 1e-3f);
+    BOOST_CHECK_CLOSE(0.9f, fast(1, 1), 1e-3f);
+    BOOST_CHECK_CLOSE(-50.f, fast(1, 2), 1e-3f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,9 @@
  
 #define BOOST_TEST_MODULE Tidop qr test
 #include <boost/test/unit_test.hpp>
+
+#include <random>
+
 #include <tidop/math/algebra/qr.h>
 
 using namespace tl;
@@ -139,4 +142,56 @@ BOOST_FIXTURE_TEST_CASE(solve, QrTest)
   BOOST_CHECK_CLOSE(1., C.at(2), 0.1);
 }
 
+BOOST_AUTO_TEST_CASE(blocked)
+{
+  /// Larger than the blocked threshold and not a multiple of the block size
+  size_t n = 203;
+
+  std::mt19937 generator(12345);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  Matrix<double> a(n, n);
+  Vector<double> b(n);
+  Matrix<double> mb(n, 3);
+
+  for (size_t r = 0; r < n; r++) {
+    for (size_t c = 0; c < n; c++) {
+      a[r][c] = distribution(generator);
+    }
+    b[r] = std::cos(static_cast<double>(r));
+    for (size_t c = 0; c < 3; c++) {
+      mb[r][c] = std::cos(static_cast<double>(r * (c + 2)));
+    }
+  }
+
+  QRDecomposition<Matrix<double>> decomp(a);
+
+  Matrix<double> q = decomp.q();
+  Matrix<double> r = decomp.r();
+  Matrix<double> qr = q * r;
+  Matrix<double> qtq = q.transpose() * q;
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      BOOST_CHECK_SMALL(qr[i][j] - a[i][j], 1e-10);
+      BOOST_CHECK_SMALL(qtq[i][j] - (i == j ? 1. : 0.), 1e-10);
+      if (j < i) BOOST_CHECK_EQUAL(0., r[i][j]);
+    }
+  }
+
+  Vector<double> x = decomp.solve(b);
+  Vector<double> ax = a * x;
+  for (size_t i = 0; i < n; i++) {
+    BOOST_CHECK_SMALL(ax[i] - b[i], 1e-9);
+  }
+
+  Matrix<double> mx = decomp.solve(mb);
+  Matrix<double> amx = a * mx;
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      BOOST_CHECK_SMALL(amx[i][j] - mb[i][j], 1e-9);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
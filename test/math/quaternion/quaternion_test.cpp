@@ -26,6 +26,7 @@
 #include <boost/test/unit_test.hpp>
 #include <tidop/math/algebra/quaternion.h>
 #include <tidop/math/algebra/rotation_matrix.h>
+#include <tidop/math/algebra/rotation_convert.h>
 
 using namespace tl;
 
@@ -396,4 +397,35 @@ BOOST_FIXTURE_TEST_CASE(quaternion_by_vector, QuaternionTest)
     BOOST_CHECK_CLOSE(-1.78571415, rotate_point.z(), 0.001);
 }
 
+BOOST_AUTO_TEST_CASE(rotation_matrix_round_trip)
+{
+    // The dominant component is x, y, z and w in turn, so every branch of
+    // the matrix to quaternion conversion is used
+    std::vector<Quaterniond> quaternions{
+        Quaterniond(0.9, 0.1, -0.3, 0.2),
+        Quaterniond(0.1, -0.8, 0.3, 0.2),
+        Quaterniond(-0.2, 0.1, 0.7, 0.3),
+        Quaterniond(0.1, 0.2, -0.3, 0.9)
+    };
+
+    for (auto quaternion : quaternions) {
+        quaternion.normalize();
+        if (quaternion.w < 0.) quaternion = -quaternion;
+
+        RotationMatrix<double> rotation_matrix;
+        RotationConverter<double>::convert(quaternion, rotation_matrix);
+
+        BOOST_CHECK_CLOSE(1., rotation_matrix.determinant(), 1e-10);
+
+        Quaterniond quaternion2;
+        RotationConverter<double>::convert(rotation_matrix, quaternion2);
+        if (quaternion2.w < 0.) quaternion2 = -quaternion2;
+
+        BOOST_CHECK_SMALL(quaternion.x - quaternion2.x, 1e-12);
+        BOOST_CHECK_SMALL(quaternion.y - quaternion2.y, 1e-12);
+        BOOST_CHECK_SMALL(quaternion.z - quaternion2.z, 1e-12);
+        BOOST_CHECK_SMALL(quaternion.w - quaternion2.w, 1e-12);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
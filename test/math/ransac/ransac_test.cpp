@@ -0,0 +1,369 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+
+#define BOOST_TEST_MODULE Tidop ransac test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/geometry/ransac.h>
+
+#include <random>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(RansacTestSuite)
+
+struct RansacTest
+{
+
+    RansacTest()
+      : affine(1.2, 0.8, 150., 75., 0.35),
+        helmert(1.5, 1.5, -25., 40., 0.5),
+        translation(150., 75.),
+        rotation(Matrix<double, 2, 2>{{0.8, -0.6},
+                                      {0.6, 0.8}}),
+        scaling(2., 0.5)
+    {
+    }
+
+    ~RansacTest() {}
+
+    void setup()
+    {
+        size = 500;
+        outliers = 150;
+
+        std::mt19937 generator(12345);
+        std::uniform_real_distribution<double> coordinates(-1000., 1000.);
+        std::normal_distribution<double> noise(0., 0.05);
+        std::uniform_real_distribution<double> gross_error(20., 200.);
+
+        src.resize(size);
+        noise_x.resize(size);
+        noise_y.resize(size);
+        is_outlier.assign(size, false);
+
+        for (size_t i = 0; i < size; i++) {
+            src[i] = Point<double>(coordinates(generator), coordinates(generator));
+            noise_x[i] = noise(generator);
+            noise_y[i] = noise(generator);
+        }
+
+        /// Los outliers se reparten por todo el conjunto
+        for (size_t i = 0; i < outliers; i++) {
+            size_t index = (i * 7) % size;
+            is_outlier[index] = true;
+            noise_x[index] = gross_error(generator);
+            noise_y[index] = -gross_error(generator);
+        }
+    }
+
+    void teardown()
+    {
+
+    }
+
+    template<typename Model>
+    auto destination(const Model &model) const -> std::vector<Point<double>>
+    {
+        std::vector<Point<double>> dst(size);
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = model.transform(src[i]);
+            dst[i].x += noise_x[i];
+            dst[i].y += noise_y[i];
+        }
+        return dst;
+    }
+
+    void checkInliers(const std::vector<bool> &inliers) const
+    {
+        BOOST_REQUIRE_EQUAL(size, inliers.size());
+        for (size_t i = 0; i < size; i++) {
+            BOOST_CHECK(inliers[i] != is_outlier[i]);
+        }
+    }
+
+    Affine<double, 2> affine;
+    Affine<double, 2> helmert;
+    Translation<double, 2> translation;
+    Rotation<double, 2> rotation;
+    Scaling<double, 2> scaling;
+    size_t size;
+    size_t outliers;
+    std::vector<Point<double>> src;
+    std::vector<double> noise_x;
+    std::vector<double> noise_y;
+    std::vector<bool> is_outlier;
+};
+
+BOOST_FIXTURE_TEST_CASE(affine_msac, RansacTest)
+{
+    RansacProperties properties;
+    properties.threshold = 1.;
+
+    Ransac<Affine2DEstimator<double>> ransac(properties);
+    Affine<double, 2> estimated = ransac.estimate(src, destination(affine));
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_SMALL(affine(r, c) - estimated(r, c), 0.01);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(size - outliers, ransac.inliersCount());
+    checkInliers(ransac.inliers());
+    BOOST_CHECK(ransac.iterations() < properties.maxIterations);
+}
+
+BOOST_FIXTURE_TEST_CASE(affine_ransac_sprt, RansacTest)
+{
+    RansacProperties properties;
+    properties.threshold = 1.;
+    properties.scoring = RansacScoring::ransac;
+    properties.localOptimization = false;
+    properties.sprt = true;
+
+    Ransac<Affine2DEstimator<double>> ransac(properties);
+    Affine<double, 2> estimated = ransac.estimate(src, destination(affine));
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_SMALL(affine(r, c) - estimated(r, c), 0.01);
+        }
+    }
+
+    checkInliers(ransac.inliers());
+}
+
+BOOST_FIXTURE_TEST_CASE(affine_ransac_sprt_fast, RansacTest)
+{
+    /// Con SPRT los residuos se calculan en double también con Precision::fast
+    RansacProperties properties;
+    properties.threshold = 1.;
+    properties.scoring = RansacScoring::ransac;
+    properties.localOptimization = false;
+    properties.sprt = true;
+    properties.seed = 11;
+
+    std::vector<Point<double>> dst = destination(affine);
+
+    Ransac<Affine2DEstimator<double>> ransac(properties);
+    Affine<double, 2> exact = ransac.estimate(src, dst);
+    std::vector<bool> exact_inliers = ransac.inliers();
+    size_t exact_iterations = ransac.iterations();
+
+    properties.precision = Precision::fast;
+    ransac.setProperties(properties);
+    Affine<double, 2> fast = ransac.estimate(src, dst);
+
+    BOOST_CHECK_EQUAL(exact_iterations, ransac.iterations());
+    BOOST_CHECK(exact_inliers == ransac.inliers());
+    checkInliers(ransac.inliers());
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_EQUAL(exact(r, c), fast(r, c));
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(affine_prosac, RansacTest)
+{
+    /// PROSAC necesita los puntos ordenados por calidad. Los inliers van primero.
+    std::vector<Point<double>> dst = destination(affine);
+    std::vector<Point<double>> src_sorted;
+    std::vector<Point<double>> dst_sorted;
+    for (int outlier = 0; outlier < 2; outlier++) {
+        for (size_t i = 0; i < size; i++) {
+            if (is_outlier[i] == (outlier == 1)) {
+                src_sorted.push_back(src[i]);
+                dst_sorted.push_back(dst[i]);
+            }
+        }
+    }
+
+    RansacProperties properties;
+    properties.threshold = 1.;
+    properties.prosac = true;
+
+    Ransac<Affine2DEstimator<double>> ransac(properties);
+    Affine<double, 2> estimated = ransac.estimate(src_sorted, dst_sorted);
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_SMALL(affine(r, c) - estimated(r, c), 0.01);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(size - outliers, ransac.inliersCount());
+}
+
+BOOST_FIXTURE_TEST_CASE(helmert_2d, RansacTest)
+{
+    RansacProperties properties;
+    properties.threshold = 1.;
+
+    Ransac<HelmertEstimator<double, 2>> ransac(properties);
+    Affine<double, 2> estimated = ransac.estimate(src, destination(helmert));
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_SMALL(helmert(r, c) - estimated(r, c), 0.01);
+        }
+    }
+
+    checkInliers(ransac.inliers());
+}
+
+BOOST_FIXTURE_TEST_CASE(translation_2d, RansacTest)
+{
+    RansacProperties properties;
+    properties.threshold = 1.;
+
+    Ransac<TranslationEstimator<double, 2>> ransac(properties);
+    Translation<double, 2> estimated = ransac.estimate(src, destination(translation));
+
+    BOOST_CHECK_SMALL(translation.x() - estimated.x(), 0.01);
+    BOOST_CHECK_SMALL(translation.y() - estimated.y(), 0.01);
+    checkInliers(ransac.inliers());
+}
+
+BOOST_FIXTURE_TEST_CASE(rotation_2d, RansacTest)
+{
+    RansacProperties properties;
+    properties.threshold = 1.;
+
+    Ransac<RotationEstimator<double, 2>> ransac(properties);
+    Rotation<double, 2> estimated = ransac.estimate(src, destination(rotation));
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 2; c++) {
+            BOOST_CHECK_SMALL(rotation(r, c) - estimated(r, c), 0.0001);
+        }
+    }
+
+    checkInliers(ransac.inliers());
+}
+
+BOOST_FIXTURE_TEST_CASE(scaling_2d, RansacTest)
+{
+    RansacProperties properties;
+    properties.threshold = 1.;
+
+    Ransac<ScalingEstimator<double, 2>> ransac(properties);
+    Scaling<double, 2> estimated = ransac.estimate(src, destination(scaling));
+
+    BOOST_CHECK_SMALL(scaling.x() - estimated.x(), 0.0001);
+    BOOST_CHECK_SMALL(scaling.y() - estimated.y(), 0.0001);
+    checkInliers(ransac.inliers());
+}
+
+BOOST_FIXTURE_TEST_CASE(umeyama_3d, RansacTest)
+{
+    Affine<double, 3> similarity(Matrix<double, 3, 4>{{0., -2., 0., 10.},
+                                                      {2., 0., 0., -5.},
+                                                      {0., 0., 2., 2.5}});
+
+    std::vector<Point3<double>> src_3d(size);
+    std::vector<Point3<double>> dst_3d(size);
+    for (size_t i = 0; i < size; i++) {
+        src_3d[i] = Point3<double>(src[i].x, src[i].y, src[(i + 1) % size].x);
+        dst_3d[i] = similarity.transform(src_3d[i]);
+        dst_3d[i].x += noise_x[i];
+        dst_3d[i].y += noise_y[i];
+    }
+
+    RansacProperties properties;
+    properties.threshold = 1.;
+
+    Ransac<Umeyama<double, 3>> ransac(properties);
+    Affine<double, 3> estimated = ransac.estimate(src_3d, dst_3d);
+
+    for (size_t r = 0; r < 3; r++) {
+        for (size_t c = 0; c < 4; c++) {
+            BOOST_CHECK_SMALL(similarity(r, c) - estimated(r, c), 0.01);
+        }
+    }
+
+    checkInliers(ransac.inliers());
+}
+
+BOOST_FIXTURE_TEST_CASE(affine_float_residuals, RansacTest)
+{
+    /// Coordenadas UTM: los residuos en float se calculan con los puntos centrados
+    std::vector<Point<double>> src_utm(size);
+    for (size_t i = 0; i < size; i++)
+        src_utm[i] = Point<double>(src[i].x + 450000., src[i].y + 4500000.);
+
+    std::vector<Point<double>> dst(size);
+    for (size_t i = 0; i < size; i++) {
+        dst[i] = affine.transform(src_utm[i]);
+        dst[i].x += noise_x[i];
+        dst[i].y += noise_y[i];
+    }
+
+    RansacProperties properties;
+    properties.threshold = 1.;
+
+    Ransac<Affine2DEstimator<double>> ransac(properties);
+    Affine<double, 2> exact = ransac.estimate(src_utm, dst);
+    std::vector<bool> exact_inliers = ransac.inliers();
+
+    properties.precision = Precision::fast;
+    ransac.setProperties(properties);
+    Affine<double, 2> fast = ransac.estimate(src_utm, dst);
+
+    BOOST_CHECK_EQUAL(size - outliers, ransac.inliersCount());
+    BOOST_CHECK(exact_inliers == ransac.inliers());
+    checkInliers(ransac.inliers());
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 2; c++) {
+            BOOST_CHECK_SMALL(exact(r, c) - fast(r, c), 1e-6);
+        }
+        BOOST_CHECK_SMALL(exact(r, 2) - fast(r, 2), 1e-3);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(deterministic, RansacTest)
+{
+    RansacProperties properties;
+    properties.threshold = 1.;
+    properties.seed = 7;
+
+    std::vector<Point<double>> dst = destination(affine);
+
+    Ransac<Affine2DEstimator<double>> ransac1(properties);
+    Affine<double, 2> estimated1 = ransac1.estimate(src, dst);
+    Ransac<Affine2DEstimator<double>> ransac2(properties);
+    Affine<double, 2> estimated2 = ransac2.estimate(src, dst);
+
+    BOOST_CHECK_EQUAL(ransac1.iterations(), ransac2.iterations());
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_EQUAL(estimated1(r, c), estimated2(r, c));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
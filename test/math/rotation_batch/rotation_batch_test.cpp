@@ -0,0 +1,247 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+
+#define BOOST_TEST_MODULE Tidop rotation batch test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/algebra/rotation_batch.h>
+
+#include <random>
+#include <vector>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(RotationBatchTestSuite)
+
+template<typename T>
+auto randomQuaternions(size_t size, unsigned int seed) -> QuaternionBatch<T>
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<T> distribution(-1, 1);
+
+    QuaternionBatch<T> quaternions;
+    for (size_t i = 0; i < size; i++) {
+        Quaternion<T> quaternion(distribution(generator),
+                                 distribution(generator),
+                                 distribution(generator),
+                                 distribution(generator));
+        quaternion.normalize();
+        quaternions.push_back(quaternion);
+    }
+
+    return quaternions;
+}
+
+template<typename T>
+void checkQuaternion(const Quaternion<T> &expected, const Quaternion<T> &quaternion, T tolerance)
+{
+    BOOST_CHECK_SMALL(expected.x - quaternion.x, tolerance);
+    BOOST_CHECK_SMALL(expected.y - quaternion.y, tolerance);
+    BOOST_CHECK_SMALL(expected.z - quaternion.z, tolerance);
+    BOOST_CHECK_SMALL(expected.w - quaternion.w, tolerance);
+}
+
+template<typename T>
+void checkRotationMatrix(const RotationMatrix<T> &expected, const RotationMatrix<T> &rotationMatrix, T tolerance)
+{
+    for (size_t r = 0; r < 3; r++) {
+        for (size_t c = 0; c < 3; c++) {
+            BOOST_CHECK_SMALL(expected(r, c) - rotationMatrix(r, c), tolerance);
+        }
+    }
+}
+
+template<typename T>
+void checkConversions(size_t size, T tolerance)
+{
+    QuaternionBatch<T> quaternions = randomQuaternions<T>(size, 42);
+
+    /// Quaternion <-> rotation matrix
+
+    RotationMatrixBatch<T> rotation_matrices;
+    RotationBatchConverter<T>::convert(quaternions, rotation_matrices);
+    BOOST_REQUIRE_EQUAL(size, rotation_matrices.size());
+
+    for (size_t i = 0; i < size; i++) {
+        RotationMatrix<T> rotation_matrix;
+        RotationConverter<T>::convert(quaternions.at(i), rotation_matrix);
+        checkRotationMatrix(rotation_matrix, rotation_matrices.at(i), tolerance);
+    }
+
+    QuaternionBatch<T> quaternions_from_matrices;
+    RotationBatchConverter<T>::convert(rotation_matrices, quaternions_from_matrices);
+
+    for (size_t i = 0; i < size; i++) {
+        Quaternion<T> quaternion;
+        RotationConverter<T>::convert(rotation_matrices.at(i), quaternion);
+        checkQuaternion(quaternion, quaternions_from_matrices.at(i), tolerance);
+    }
+
+    /// Quaternion <-> axis-angle
+
+    AxisAngleBatch<T> axis_angles;
+    RotationBatchConverter<T>::convert(quaternions, axis_angles);
+
+    for (size_t i = 0; i < size; i++) {
+        AxisAngle<T> axis_angle;
+        RotationConverter<T>::convert(quaternions.at(i), axis_angle);
+        BOOST_CHECK_SMALL(axis_angle.angle() - axis_angles.angle[i], tolerance);
+        BOOST_CHECK_SMALL(axis_angle.axis(0) - axis_angles.x[i], tolerance);
+        BOOST_CHECK_SMALL(axis_angle.axis(1) - axis_angles.y[i], tolerance);
+        BOOST_CHECK_SMALL(axis_angle.axis(2) - axis_angles.z[i], tolerance);
+    }
+
+    QuaternionBatch<T> quaternions_from_axis_angles;
+    RotationBatchConverter<T>::convert(axis_angles, quaternions_from_axis_angles);
+
+    for (size_t i = 0; i < size; i++) {
+        Quaternion<T> quaternion;
+        RotationConverter<T>::convert(axis_angles.at(i), quaternion);
+        checkQuaternion(quaternion, quaternions_from_axis_angles.at(i), tolerance);
+    }
+
+    /// Axis-angle -> rotation matrix
+
+    RotationMatrixBatch<T> rotation_matrices_from_axis_angles;
+    RotationBatchConverter<T>::convert(axis_angles, rotation_matrices_from_axis_angles);
+
+    for (size_t i = 0; i < size; i++) {
+        RotationMatrix<T> rotation_matrix;
+        RotationConverter<T>::convert(axis_angles.at(i), rotation_matrix);
+        checkRotationMatrix(rotation_matrix, rotation_matrices_from_axis_angles.at(i), tolerance);
+    }
+
+    /// Rotation matrix <-> Euler angles
+
+    for (auto axes : {Axes::xyz, Axes::zyx, Axes::zxz}) {
+
+        EulerAnglesBatch<T> euler_angles(0, axes);
+        RotationBatchConverter<T>::convert(rotation_matrices, euler_angles);
+
+        RotationMatrixBatch<T> rotation_matrices_from_euler_angles;
+        RotationBatchConverter<T>::convert(euler_angles, rotation_matrices_from_euler_angles);
+
+        for (size_t i = 0; i < size; i++) {
+            EulerAngles<T> euler_angle;
+            euler_angle.axes = axes;
+            RotationConverter<T>::convert(rotation_matrices.at(i), euler_angle);
+            BOOST_CHECK_SMALL(static_cast<T>(euler_angle.x) - euler_angles.x[i], tolerance);
+            BOOST_CHECK_SMALL(static_cast<T>(euler_angle.y) - euler_angles.y[i], tolerance);
+            BOOST_CHECK_SMALL(static_cast<T>(euler_angle.z) - euler_angles.z[i], tolerance);
+            checkRotationMatrix(rotation_matrices.at(i), rotation_matrices_from_euler_angles.at(i), 10 * tolerance);
+        }
+    }
+}
+
+template<typename T>
+void checkInterpolation(size_t size, T tolerance)
+{
+    QuaternionBatch<T> q1 = randomQuaternions<T>(size, 7);
+    QuaternionBatch<T> q2 = randomQuaternions<T>(size, 11);
+
+    /// Quaternions close enough to use the linear interpolation
+    for (size_t i = 0; i < size; i += 3) {
+        q2.set(i, q1.at(i));
+    }
+
+    std::vector<T> t(size);
+    for (size_t i = 0; i < size; i++) {
+        t[i] = static_cast<T>(i % 17) / static_cast<T>(16);
+    }
+
+    QuaternionBatch<T> q;
+
+    slerp(q1, q2, t, q);
+    for (size_t i = 0; i < size; i++) {
+        checkQuaternion(slerp(q1.at(i), q2.at(i), t[i]), q.at(i), tolerance);
+    }
+
+    nlerp(q1, q2, t, q);
+    for (size_t i = 0; i < size; i++) {
+        checkQuaternion(nlerp(q1.at(i), q2.at(i), t[i]), q.at(i), tolerance);
+    }
+
+    multiply(q1, q2, q);
+    for (size_t i = 0; i < size; i++) {
+        checkQuaternion(q1.at(i) * q2.at(i), q.at(i), tolerance);
+    }
+
+    q1.x[0] = q1.y[0] = q1.z[0] = q1.w[0] = 0;
+    q1.normalize();
+    checkQuaternion(Quaternion<T>(0, 0, 0, 0), q1.at(0), tolerance);
+    for (size_t i = 1; i < size; i++) {
+        Quaternion<T> quaternion = q1.at(i);
+        quaternion.normalize();
+        checkQuaternion(quaternion, q1.at(i), tolerance);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(conversions)
+{
+    /// Tamaño que no es múltiplo del registro SIMD para probar la cola escalar
+    checkConversions<double>(37, 1e-12);
+    checkConversions<float>(37, 1e-5f);
+    /// Suficientemente grande para que se procese en paralelo
+    checkConversions<double>(20011, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(matrix_to_quaternion_branches)
+{
+    /// The largest component is x, y, z and w respectively
+    std::vector<Quaternion<double>> expected{
+        Quaternion<double>(0.9, 0.3, -0.2, 0.245),
+        Quaternion<double>(0.3, -0.9, 0.2, 0.245),
+        Quaternion<double>(-0.2, 0.3, 0.9, 0.245),
+        Quaternion<double>(0.3, 0.2, -0.245, 0.9)};
+
+    QuaternionBatch<double> quaternions;
+    for (auto quaternion : expected) {
+        quaternion.normalize();
+        quaternions.push_back(quaternion);
+    }
+
+    RotationMatrixBatch<double> rotation_matrices;
+    RotationBatchConverter<double>::convert(quaternions, rotation_matrices);
+    QuaternionBatch<double> result;
+    RotationBatchConverter<double>::convert(rotation_matrices, result);
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        Quaternion<double> quaternion = quaternions.at(i);
+        /// q and -q are the same rotation
+        double sign = dot(quaternion, result.at(i)) < 0. ? -1. : 1.;
+        BOOST_CHECK_SMALL(quaternion.x - sign * result.x[i], 1e-12);
+        BOOST_CHECK_SMALL(quaternion.y - sign * result.y[i], 1e-12);
+        BOOST_CHECK_SMALL(quaternion.z - sign * result.z[i], 1e-12);
+        BOOST_CHECK_SMALL(quaternion.w - sign * result.w[i], 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(interpolation)
+{
+    checkInterpolation<double>(37, 1e-12);
+    checkInterpolation<float>(37, 1e-5f);
+    checkInterpolation<double>(20011, 1e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,210 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+
+#define BOOST_TEST_MODULE Tidop sparse matrix test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/algebra/sparse_matrix.h>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(SparseMatrixTestSuite)
+
+struct SparseMatrixTest
+{
+
+  SparseMatrixTest()
+  {}
+
+  ~SparseMatrixTest()
+  {}
+
+  void setup()
+  {
+    /// 4x3
+    /// | 1  0  2 |
+    /// | 0  3  0 |
+    /// | 4  0  5 |
+    /// | 0  6  7 |
+    triplets = {{0, 0, 1.}, {0, 2, 2.}, {1, 1, 3.}, {2, 0, 4.},
+                {2, 2, 5.}, {3, 1, 6.}, {3, 2, 3.}, {3, 2, 4.}};
+
+    csr = SparseMatrixCSR<double>(4, 3, triplets);
+    csc = SparseMatrixCSC<double>(4, 3, triplets);
+
+    dense = Matrix<double>(4, 3, 0.);
+    dense(0, 0) = 1.;
+    dense(0, 2) = 2.;
+    dense(1, 1) = 3.;
+    dense(2, 0) = 4.;
+    dense(2, 2) = 5.;
+    dense(3, 1) = 6.;
+    dense(3, 2) = 7.;
+  }
+
+  void teardown()
+  {
+
+  }
+
+  std::vector<Triplet<double>> triplets;
+  SparseMatrixCSR<double> csr;
+  SparseMatrixCSC<double> csc;
+  Matrix<double> dense;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(default_constructor, SparseMatrixTest)
+{
+  SparseMatrixCSR<double> matrix;
+  BOOST_CHECK_EQUAL(0, matrix.rows());
+  BOOST_CHECK_EQUAL(0, matrix.cols());
+  BOOST_CHECK_EQUAL(0, matrix.nonZeros());
+}
+
+BOOST_FIXTURE_TEST_CASE(triplets_duplicates, SparseMatrixTest)
+{
+  BOOST_CHECK_EQUAL(4, csr.rows());
+  BOOST_CHECK_EQUAL(3, csr.cols());
+  BOOST_CHECK_EQUAL(7, csr.nonZeros());
+  BOOST_CHECK_EQUAL(7, csc.nonZeros());
+  BOOST_CHECK_EQUAL(7., csr.at(3, 2));
+  BOOST_CHECK_EQUAL(7., csc(3, 2));
+}
+
+BOOST_FIXTURE_TEST_CASE(at, SparseMatrixTest)
+{
+  for (size_t r = 0; r < 4; r++) {
+    for (size_t c = 0; c < 3; c++) {
+      BOOST_CHECK_EQUAL(dense(r, c), csr.at(r, c));
+      BOOST_CHECK_EQUAL(dense(r, c), csc.at(r, c));
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(storage_conversion, SparseMatrixTest)
+{
+  SparseMatrixCSC<double> matrix(csr);
+  BOOST_CHECK_EQUAL(csc.outerIndex().size(), matrix.outerIndex().size());
+
+  for (size_t i = 0; i < csc.outerIndex().size(); i++)
+    BOOST_CHECK_EQUAL(csc.outerIndex()[i], matrix.outerIndex()[i]);
+
+  for (size_t i = 0; i < csc.nonZeros(); i++) {
+    BOOST_CHECK_EQUAL(csc.innerIndex()[i], matrix.innerIndex()[i]);
+    BOOST_CHECK_EQUAL(csc.values()[i], matrix.values()[i]);
+  }
+
+  SparseMatrixCSR<double> matrix2(matrix);
+  for (size_t r = 0; r < 4; r++) {
+    for (size_t c = 0; c < 3; c++) {
+      BOOST_CHECK_EQUAL(dense(r, c), matrix2(r, c));
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(transpose, SparseMatrixTest)
+{
+  auto transpose = csr.transpose();
+  BOOST_CHECK_EQUAL(3, transpose.rows());
+  BOOST_CHECK_EQUAL(4, transpose.cols());
+
+  for (size_t r = 0; r < 4; r++) {
+    for (size_t c = 0; c < 3; c++) {
+      BOOST_CHECK_EQUAL(dense(r, c), transpose(c, r));
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(to_dense, SparseMatrixTest)
+{
+  Matrix<double> matrix = csc.toDense();
+
+  for (size_t r = 0; r < 4; r++) {
+    for (size_t c = 0; c < 3; c++) {
+      BOOST_CHECK_EQUAL(dense(r, c), matrix(r, c));
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(diagonal, SparseMatrixTest)
+{
+  Vector<double> diagonal = csr.diagonal();
+  BOOST_CHECK_EQUAL(3, diagonal.size());
+  BOOST_CHECK_EQUAL(1., diagonal[0]);
+  BOOST_CHECK_EQUAL(3., diagonal[1]);
+  BOOST_CHECK_EQUAL(5., diagonal[2]);
+}
+
+BOOST_FIXTURE_TEST_CASE(multiply, SparseMatrixTest)
+{
+  Vector<double> x{1., -2., 3.};
+
+  Vector<double> y = csr * x;
+  Vector<double> y2 = csc * x;
+
+  for (size_t r = 0; r < 4; r++) {
+    double value = 0.;
+    for (size_t c = 0; c < 3; c++)
+      value += dense(r, c) * x[c];
+    BOOST_CHECK_CLOSE(value, y[r], 0.0001);
+    BOOST_CHECK_CLOSE(value, y2[r], 0.0001);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(transpose_multiply, SparseMatrixTest)
+{
+  std::vector<double> x{1., -2., 3., 0.5};
+  std::vector<double> y(3);
+  std::vector<double> y2(3);
+
+  csr.transposeMultiply(x.data(), y.data());
+  csc.transposeMultiply(x.data(), y2.data());
+
+  for (size_t c = 0; c < 3; c++) {
+    double value = 0.;
+    for (size_t r = 0; r < 4; r++)
+      value += dense(r, c) * x[r];
+    BOOST_CHECK_CLOSE(value, y[c], 0.0001);
+    BOOST_CHECK_CLOSE(value, y2[c], 0.0001);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(normal_matrix, SparseMatrixTest)
+{
+  SparseMatrixCSR<double> normal = normalMatrix(csr);
+  BOOST_CHECK_EQUAL(3, normal.rows());
+  BOOST_CHECK_EQUAL(3, normal.cols());
+
+  for (size_t i = 0; i < 3; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      double value = 0.;
+      for (size_t r = 0; r < 4; r++)
+        value += dense(r, i) * dense(r, j);
+      BOOST_CHECK_CLOSE(value, normal(i, j), 0.0001);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,244 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+
+#define BOOST_TEST_MODULE Tidop sparse solvers test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/algebra/sparse_matrix.h>
+#include <tidop/math/algebra/preconditioner.h>
+#include <tidop/math/algebra/conjugate_gradient.h>
+#include <tidop/math/algebra/lsqr.h>
+#include <tidop/math/algebra/sparse_cholesky.h>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(SparseSolversTestSuite)
+
+struct SparseSolversTest
+{
+
+  SparseSolversTest()
+  {}
+
+  ~SparseSolversTest()
+  {}
+
+  void setup()
+  {
+    /// 2D Laplacian on a 20x20 grid plus a diagonal term
+
+    size_t grid = 20;
+    size = grid * grid;
+
+    std::vector<Triplet<double>> triplets;
+    for (size_t i = 0; i < grid; i++) {
+      for (size_t j = 0; j < grid; j++) {
+        size_t k = i * grid + j;
+        triplets.push_back({k, k, 4.1 + 0.01 * static_cast<double>(k % 7)});
+        if (i > 0) triplets.push_back({k, k - grid, -1.});
+        if (i < grid - 1) triplets.push_back({k, k + grid, -1.});
+        if (j > 0) triplets.push_back({k, k - 1, -1.});
+        if (j < grid - 1) triplets.push_back({k, k + 1, -1.});
+      }
+    }
+
+    laplacian = SparseMatrixCSR<double>(size, size, triplets);
+
+    solution = Vector<double>(size);
+    for (size_t i = 0; i < size; i++)
+      solution[i] = std::sin(0.1 * static_cast<double>(i)) + 2.;
+
+    b = laplacian * solution;
+
+    /// Overdetermined system 3 equations per unknown
+
+    size_t unknowns = 50;
+    std::vector<Triplet<double>> rect_triplets;
+    for (size_t j = 0; j < unknowns; j++) {
+      rect_triplets.push_back({3 * j, j, 2.});
+      rect_triplets.push_back({3 * j + 1, j, 1.});
+      rect_triplets.push_back({3 * j + 1, (j + 1) % unknowns, -1.});
+      rect_triplets.push_back({3 * j + 2, j, 100.});
+      rect_triplets.push_back({3 * j + 2, (j + 7) % unknowns, 0.5});
+    }
+
+    rectangular = SparseMatrixCSR<double>(3 * unknowns, unknowns, rect_triplets);
+
+    rect_solution = Vector<double>(unknowns);
+    for (size_t j = 0; j < unknowns; j++)
+      rect_solution[j] = static_cast<double>(j % 5) - 2.;
+
+    rect_b = rectangular * rect_solution;
+  }
+
+  void teardown()
+  {
+
+  }
+
+  size_t size;
+  SparseMatrixCSR<double> laplacian;
+  Vector<double> solution;
+  Vector<double> b;
+  SparseMatrixCSR<double> rectangular;
+  Vector<double> rect_solution;
+  Vector<double> rect_b;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(conjugate_gradient_identity, SparseSolversTest)
+{
+  ConjugateGradient<double, IdentityPreconditioner<double>> cg(laplacian);
+  cg.setTolerance(1e-12);
+  Vector<double> x = cg.solve(b);
+
+  BOOST_CHECK(cg.error() < 1e-12);
+  for (size_t i = 0; i < size; i++)
+    BOOST_CHECK_SMALL(solution[i] - x[i], 1e-9);
+}
+
+BOOST_FIXTURE_TEST_CASE(conjugate_gradient_jacobi, SparseSolversTest)
+{
+  ConjugateGradient<double> cg(laplacian);
+  cg.setTolerance(1e-12);
+  Vector<double> x = cg.solve(b);
+
+  BOOST_CHECK(cg.error() < 1e-12);
+  for (size_t i = 0; i < size; i++)
+    BOOST_CHECK_SMALL(solution[i] - x[i], 1e-9);
+}
+
+BOOST_FIXTURE_TEST_CASE(conjugate_gradient_incomplete_cholesky, SparseSolversTest)
+{
+  ConjugateGradient<double, IdentityPreconditioner<double>> cg(laplacian);
+  cg.setTolerance(1e-12);
+  cg.solve(b);
+
+  ConjugateGradient<double, IncompleteCholeskyPreconditioner<double>> cg_ic(laplacian);
+  cg_ic.setTolerance(1e-12);
+  Vector<double> x = cg_ic.solve(b);
+
+  BOOST_CHECK(cg_ic.error() < 1e-12);
+  BOOST_CHECK(cg_ic.iterations() < cg.iterations());
+  for (size_t i = 0; i < size; i++)
+    BOOST_CHECK_SMALL(solution[i] - x[i], 1e-9);
+}
+
+BOOST_FIXTURE_TEST_CASE(conjugate_gradient_initial_guess, SparseSolversTest)
+{
+  ConjugateGradient<double> cg(laplacian);
+  cg.setTolerance(1e-12);
+  Vector<double> x = cg.solve(b, solution);
+
+  BOOST_CHECK_EQUAL(0, cg.iterations());
+  for (size_t i = 0; i < size; i++)
+    BOOST_CHECK_SMALL(solution[i] - x[i], 1e-9);
+}
+
+BOOST_FIXTURE_TEST_CASE(lsqr, SparseSolversTest)
+{
+  Lsqr<double> lsqr(rectangular);
+  lsqr.setTolerance(1e-14);
+  Vector<double> x = lsqr.solve(rect_b);
+
+  BOOST_CHECK(lsqr.residual() < 1e-8);
+  for (size_t j = 0; j < x.size(); j++)
+    BOOST_CHECK_SMALL(rect_solution[j] - x[j], 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(lsqr_without_scaling, SparseSolversTest)
+{
+  Lsqr<double> lsqr(rectangular);
+  lsqr.setTolerance(1e-14);
+  lsqr.setColumnScaling(false);
+  Vector<double> x = lsqr.solve(rect_b);
+
+  for (size_t j = 0; j < x.size(); j++)
+    BOOST_CHECK_SMALL(rect_solution[j] - x[j], 1e-7);
+}
+
+BOOST_FIXTURE_TEST_CASE(sparse_cholesky, SparseSolversTest)
+{
+  SparseCholeskyDecomposition<double> cholesky(laplacian, SparseOrdering::natural);
+  Vector<double> x = cholesky.solve(b);
+
+  for (size_t i = 0; i < size; i++)
+    BOOST_CHECK_CLOSE(solution[i], x[i], 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(sparse_cholesky_amd, SparseSolversTest)
+{
+  SparseCholeskyDecomposition<double> natural(laplacian, SparseOrdering::natural);
+  SparseCholeskyDecomposition<double> amd(laplacian, SparseOrdering::amd);
+  Vector<double> x = amd.solve(b);
+
+  BOOST_CHECK(amd.nonZerosL() < natural.nonZerosL());
+
+  std::vector<bool> used(size, false);
+  for (auto i : amd.permutation()) used[i] = true;
+  BOOST_CHECK(std::all_of(used.begin(), used.end(), [](bool u) { return u; }));
+
+  for (size_t i = 0; i < size; i++)
+    BOOST_CHECK_CLOSE(solution[i], x[i], 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(sparse_cholesky_refactorize, SparseSolversTest)
+{
+  SparseCholeskyDecomposition<double> cholesky;
+  cholesky.analyze(laplacian);
+  cholesky.factorize(laplacian);
+
+  SparseMatrixCSR<double> scaled = laplacian;
+  for (auto &value : scaled.values()) value *= 2.;
+
+  cholesky.factorize(scaled);
+  Vector<double> x = cholesky.solve(b);
+
+  for (size_t i = 0; i < size; i++)
+    BOOST_CHECK_CLOSE(0.5 * solution[i], x[i], 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(sparse_cholesky_not_positive_definite, SparseSolversTest)
+{
+  SparseMatrixCSR<double> matrix(2, 2, {{0, 0, 1.}, {0, 1, 2.}, {1, 0, 2.}, {1, 1, 1.}});
+  SparseCholeskyDecomposition<double> cholesky;
+  BOOST_CHECK_THROW(cholesky.compute(matrix), Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(normal_equations, SparseSolversTest)
+{
+  SparseMatrixCSR<double> normal = normalMatrix(rectangular);
+  std::vector<double> atb(rectangular.cols());
+  rectangular.transposeMultiply(rect_b.data(), atb.data());
+  Vector<double> rhs(atb.size());
+  for (size_t i = 0; i < atb.size(); i++) rhs[i] = atb[i];
+
+  SparseCholeskyDecomposition<double> cholesky(normal);
+  Vector<double> x = cholesky.solve(rhs);
+
+  for (size_t j = 0; j < x.size(); j++)
+    BOOST_CHECK_SMALL(rect_solution[j] - x[j], 1e-8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,9 @@
 #include <tidop/math/statistic/confmat.h>
 #include <tidop/math/statistic/covariance.h>
 #include <tidop/math/statistic/tukeyfences.h>
+#include <tidop/math/statistic/streaming.h>
+
+#include <random>
 
 using namespace tl;
 
@@ -338,6 +341,24 @@ BOOST_FIXTURE_TEST_CASE(thirdQuartile, DescriptiveStatisticsTest)
   BOOST_CHECK_CLOSE(18.5, stat_3.thirdQuartile(), 0.1);
 }
 
+BOOST_FIXTURE_TEST_CASE(deciles, DescriptiveStatisticsTest)
+{
+    std::array<double, 9> deciles = stat_1.deciles();
+
+    for (size_t i = 0; i < deciles.size(); i++) {
+        BOOST_CHECK_CLOSE(stat_1.quantile((i + 1) / 10.), deciles[i], 1e-10);
+    }
+
+    BOOST_CHECK_CLOSE(5.5, deciles[0], 0.1);
+    BOOST_CHECK_CLOSE(8, deciles[4], 0.1);
+    BOOST_CHECK_CLOSE(9, deciles[8], 0.1);
+
+    std::array<double, 99> percentiles = stat_3.percentiles();
+    BOOST_CHECK_CLOSE(7, percentiles[0], 0.1);
+    BOOST_CHECK_CLOSE(14, percentiles[49], 0.1);
+    BOOST_CHECK_CLOSE(23, percentiles[98], 0.1);
+}
+
 BOOST_FIXTURE_TEST_CASE(interquartileRange, DescriptiveStatisticsTest)
 {
   BOOST_CHECK_CLOSE(1.625, stat_1.interquartileRange(), 0.1);
@@ -359,6 +380,81 @@ BOOST_FIXTURE_TEST_CASE(quartileDeviation, DescriptiveStatisticsTest)
   //BOOST_CHECK_CLOSE(5, tl::quartileDeviation(vi2.begin(), vi2.end()), 0.1);
 }
 
+BOOST_AUTO_TEST_CASE(fused_moments)
+{
+    std::mt19937 generator(41);
+    std::normal_distribution<double> distribution(1.e6, 2.);
+
+    std::vector<double> values(300000);
+    for (auto &value : values)
+        value = distribution(generator);
+
+    std::vector<float> values_f(values.begin(), values.end());
+
+    long double mean_reference = 0.;
+    for (auto value : values_f)
+        mean_reference += value;
+    mean_reference /= values_f.size();
+
+    long double ss_reference = 0.;
+    for (auto value : values_f)
+        ss_reference += (value - mean_reference) * (value - mean_reference);
+
+    FusedMoments<float> moments = fusedMoments(values_f.data(), values_f.size());
+
+    BOOST_CHECK_EQUAL(values_f.size(), moments.count);
+    BOOST_CHECK_EQUAL(*std::min_element(values_f.begin(), values_f.end()), moments.min);
+    BOOST_CHECK_EQUAL(*std::max_element(values_f.begin(), values_f.end()), moments.max);
+    BOOST_CHECK_CLOSE(static_cast<double>(mean_reference), moments.mean(), 1e-10);
+    BOOST_CHECK_CLOSE(static_cast<double>(ss_reference), moments.centralSumOfSquares(), 1e-9);
+
+    /* Los float se acumulan en double: los cuadrados no pierden precisión */
+    std::uniform_real_distribution<float> uniform(0.f, 1.e4f);
+    std::vector<float> uniform_f(300000);
+    for (auto &value : uniform_f)
+        value = uniform(generator);
+
+    mean_reference = 0.;
+    for (auto value : uniform_f)
+        mean_reference += value;
+    mean_reference /= uniform_f.size();
+
+    ss_reference = 0.;
+    for (auto value : uniform_f)
+        ss_reference += (value - mean_reference) * (value - mean_reference);
+
+    moments = fusedMoments(uniform_f.data(), uniform_f.size());
+    BOOST_CHECK_CLOSE(static_cast<double>(mean_reference), moments.mean(), 1e-11);
+    BOOST_CHECK_CLOSE(static_cast<double>(ss_reference), moments.centralSumOfSquares(), 1e-11);
+
+    Series<double> series(values);
+    DescriptiveStatistics<double> stat(series);
+
+    mean_reference = 0.;
+    for (auto value : values)
+        mean_reference += value;
+    mean_reference /= values.size();
+
+    ss_reference = 0.;
+    for (auto value : values)
+        ss_reference += (value - mean_reference) * (value - mean_reference);
+
+    BOOST_CHECK_EQUAL(*std::min_element(values.begin(), values.end()), stat.min());
+    BOOST_CHECK_EQUAL(*std::max_element(values.begin(), values.end()), stat.max());
+    BOOST_CHECK_CLOSE(static_cast<double>(mean_reference), stat.mean(), 1e-12);
+    BOOST_CHECK_CLOSE(static_cast<double>(ss_reference), stat.sumOfSquares(), 1e-9);
+    BOOST_CHECK_CLOSE(static_cast<double>(ss_reference / (values.size() - 1)), stat.variance(), 1e-9);
+
+    std::vector<int> values_i(5000);
+    for (size_t i = 0; i < values_i.size(); i++)
+        values_i[i] = static_cast<int>(i % 7) - 3;
+
+    FusedMoments<int> moments_i = fusedMoments(values_i.data(), values_i.size());
+    BOOST_CHECK_EQUAL(-3, moments_i.min);
+    BOOST_CHECK_EQUAL(3, moments_i.max);
+    BOOST_CHECK_CLOSE(tl::mean(values_i.begin(), values_i.end()), moments_i.mean(), 1e-9);
+}
+
 BOOST_FIXTURE_TEST_CASE(covariance, DescriptiveStatisticsTest)
 {
     tl::Covariance<double> covariance;
@@ -372,6 +468,174 @@ BOOST_FIXTURE_TEST_CASE(covariance, DescriptiveStatisticsTest)
 BOOST_AUTO_TEST_SUITE_END()
 
 
+BOOST_AUTO_TEST_SUITE(StreamingStatisticsTestSuite)
+
+struct StreamingStatisticsTest
+{
+    StreamingStatisticsTest()
+    {
+    }
+
+    ~StreamingStatisticsTest()
+    {
+    }
+
+    void setup()
+    {
+        data = {8.0, 8.5, 7.5, 9.0, 6.25, 5.5, 8.5, 7.5, 8.5};
+        stat_1.push(data.begin(), data.end());
+
+        StreamingStatistics<double>::Config config{};
+        config.sample = false;
+        stat_1_population = StreamingStatistics<double>(config);
+        stat_1_population.push(data.begin(), data.end());
+
+        std::vector<int> data_2{1, 0, 1, 3, 2, 0, 1};
+        stat_2.push(data_2.begin(), data_2.end());
+    }
+
+    void teardown()
+    {
+    }
+
+    std::vector<double> data;
+    StreamingStatistics<double> stat_1;
+    StreamingStatistics<double> stat_1_population;
+    StreamingStatistics<int> stat_2;
+};
+
+BOOST_FIXTURE_TEST_CASE(moments, StreamingStatisticsTest)
+{
+    DescriptiveStatistics<double> descriptive(Series<double>({8.0, 8.5, 7.5, 9.0, 6.25, 5.5, 8.5, 7.5, 8.5}));
+
+    BOOST_CHECK_EQUAL(9, stat_1.size());
+    BOOST_CHECK_EQUAL(5.5, stat_1.min());
+    BOOST_CHECK_EQUAL(9., stat_1.max());
+    BOOST_CHECK_EQUAL(3.5, stat_1.range());
+    BOOST_CHECK_CLOSE(descriptive.mean(), stat_1.mean(), 1e-10);
+    BOOST_CHECK_CLOSE(descriptive.variance(), stat_1.variance(), 1e-10);
+    BOOST_CHECK_CLOSE(descriptive.standarDeviation(), stat_1.standarDeviation(), 1e-10);
+    BOOST_CHECK_CLOSE(descriptive.rootMeanSquare(), stat_1.rootMeanSquare(), 1e-10);
+    BOOST_CHECK_CLOSE(-1.01235079, stat_1.skewness(), 0.1);
+    BOOST_CHECK_CLOSE(4.73030915, stat_1.kurtosis(), 0.1);
+    BOOST_CHECK_CLOSE(0.158880584, stat_1.kurtosisExcess(), 0.1);
+
+    BOOST_CHECK_CLOSE(-0.835146793, stat_1_population.skewness(), 0.1);
+    BOOST_CHECK_CLOSE(2.48341231, stat_1_population.kurtosis(), 0.1);
+    BOOST_CHECK_CLOSE(-0.516587694, stat_1_population.kurtosisExcess(), 0.1);
+
+    BOOST_CHECK_CLOSE(0.771716836, stat_2.skewness(), 0.1);
+    BOOST_CHECK_CLOSE(5.6625, stat_2.kurtosis(), 0.1);
+}
+
+BOOST_FIXTURE_TEST_CASE(merge, StreamingStatisticsTest)
+{
+    std::mt19937 generator(17);
+    std::normal_distribution<double> distribution(100., 15.);
+
+    std::vector<double> values(10000);
+    for (auto &value : values)
+        value = distribution(generator);
+
+    StreamingStatistics<double> whole;
+    whole.push(values.begin(), values.end());
+
+    StreamingStatistics<double> merged;
+    for (size_t i = 0; i < values.size(); i += 1250) {
+        StreamingStatistics<double> chunk;
+        chunk.push(values.begin() + i, values.begin() + i + 1250);
+        merged.merge(chunk);
+    }
+
+    BOOST_CHECK_EQUAL(whole.size(), merged.size());
+    BOOST_CHECK_EQUAL(whole.min(), merged.min());
+    BOOST_CHECK_EQUAL(whole.max(), merged.max());
+    BOOST_CHECK_CLOSE(whole.mean(), merged.mean(), 1e-9);
+    BOOST_CHECK_CLOSE(whole.variance(), merged.variance(), 1e-9);
+    BOOST_CHECK_CLOSE(whole.skewness(), merged.skewness(), 1e-6);
+    BOOST_CHECK_CLOSE(whole.kurtosis(), merged.kurtosis(), 1e-9);
+    BOOST_CHECK_CLOSE(whole.median(), merged.median(), 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(quantiles)
+{
+    std::mt19937 generator(23);
+    std::uniform_real_distribution<double> distribution(0., 1.);
+
+    StreamingStatistics<double> stat;
+    for (size_t i = 0; i < 100000; i++)
+        stat.push(distribution(generator));
+
+    BOOST_CHECK(stat.digest().centroids().size() < 200);
+
+    /// Rank error of the sketch
+    BOOST_CHECK_SMALL(stat.quantile(0.001) - 0.001, 0.0005);
+    BOOST_CHECK_SMALL(stat.firstQuartile() - 0.25, 0.005);
+    BOOST_CHECK_SMALL(stat.median() - 0.5, 0.005);
+    BOOST_CHECK_SMALL(stat.thirdQuartile() - 0.75, 0.005);
+    BOOST_CHECK_SMALL(stat.quantile(0.999) - 0.999, 0.0005);
+    BOOST_CHECK_SMALL(stat.digest().cdf(0.3) - 0.3, 0.005);
+    BOOST_CHECK_EQUAL(stat.min(), stat.quantile(0.));
+    BOOST_CHECK_EQUAL(stat.max(), stat.quantile(1.));
+}
+
+BOOST_AUTO_TEST_CASE(finalize)
+{
+    std::mt19937 generator(29);
+    std::normal_distribution<double> distribution(0., 1.);
+
+    StreamingStatistics<double> source;
+    for (size_t i = 0; i < 1010; i++)
+        source.push(distribution(generator));
+
+    /// Las consultas no modifican el digest
+    std::vector<TDigest<double>::Centroid> centroids = source.digest().centroids();
+    double median = source.median();
+    BOOST_CHECK_EQUAL(centroids.size(), source.digest().centroids().size());
+    BOOST_CHECK_EQUAL(median, source.median());
+
+    /// merge no modifica el origen
+    StreamingStatistics<double> merged;
+    merged.merge(source);
+    BOOST_CHECK_EQUAL(median, source.median());
+    BOOST_CHECK_EQUAL(centroids.size(), source.digest().centroids().size());
+    BOOST_CHECK_EQUAL(source.size(), merged.size());
+
+    source.finalize();
+    BOOST_CHECK_EQUAL(centroids.size(), source.digest().centroids().size());
+    BOOST_CHECK_EQUAL(median, source.median());
+}
+
+BOOST_AUTO_TEST_CASE(mode)
+{
+    StreamingStatistics<int>::Config config{};
+    config.histogram_bins = 10;
+    config.histogram_min = 0.;
+    config.histogram_max = 10.;
+
+    StreamingStatistics<int> stat(config);
+    std::vector<int> values{1, 2, 2, 3, 3, 3, 4, 4, 4, 4, 12, -1};
+    stat.push(values.begin(), values.end());
+
+    BOOST_CHECK_EQUAL(4.5, stat.mode());
+    BOOST_CHECK_EQUAL(4, stat.histogram().count(4));
+    BOOST_CHECK_EQUAL(1, stat.histogram().underflow());
+    BOOST_CHECK_EQUAL(1, stat.histogram().overflow());
+
+    StreamingStatistics<int> stat2(config);
+    std::vector<int> values2{7, 7, 7, 7, 7};
+    stat2.push(values2.begin(), values2.end());
+    stat.merge(stat2);
+
+    BOOST_CHECK_EQUAL(7.5, stat.mode());
+
+    StreamingStatistics<int> no_histogram;
+    BOOST_CHECK_THROW(no_histogram.mode(), std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
 
 
 BOOST_AUTO_TEST_SUITE(ConfusionMatrixTestSuite)
@@ -634,6 +898,50 @@ BOOST_FIXTURE_TEST_CASE(falseNegativeRate, ConfusionMatrixTest)
   BOOST_CHECK_CLOSE(0.3333, ConfusionMatrix<double>::falseNegativeRate(10, 20), 0.1);
 }
 
+BOOST_FIXTURE_TEST_CASE(rocCurve, ConfusionMatrixTest)
+{
+  ClassificationCurve<double> roc = mConfusionMatrix->rocCurve();
+
+  /// Mann-Whitney U statistic
+  double u = 0.;
+  for (const auto &positive : data) {
+    if (positive.second != 1) continue;
+    for (const auto &negative : data) {
+      if (negative.second == 1) continue;
+      if (positive.first > negative.first) u += 1.;
+      else if (positive.first == negative.first) u += 0.5;
+    }
+  }
+
+  BOOST_CHECK_CLOSE(u / (80. * 68.), roc.auc, 1e-9);
+  BOOST_CHECK_EQUAL(1., roc.x.front());
+  BOOST_CHECK_EQUAL(1., roc.y.front());
+  BOOST_CHECK_EQUAL(0., roc.x.back());
+  BOOST_CHECK_EQUAL(0., roc.y.back());
+  BOOST_CHECK(std::is_sorted(roc.thresholds.begin(), roc.thresholds.end()));
+
+  for (size_t i = 0; i + 1 < roc.thresholds.size(); i++) {
+    BOOST_CHECK_EQUAL(mConfusionMatrix->truePositiveRate(roc.thresholds[i]), roc.y[i]);
+    BOOST_CHECK_EQUAL(mConfusionMatrix->falsePositiveRate(roc.thresholds[i]), roc.x[i]);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(precisionRecallCurve, ConfusionMatrixTest)
+{
+  ClassificationCurve<double> pr = mConfusionMatrix->precisionRecallCurve();
+  ClassificationCurve<double> det = mConfusionMatrix->detCurve();
+
+  BOOST_CHECK_EQUAL(1., pr.x.front());
+  BOOST_CHECK_CLOSE(80. / 148., pr.y.front(), 1e-9);
+  BOOST_CHECK_EQUAL(0., pr.x.back());
+  BOOST_CHECK_EQUAL(1., pr.y.back());
+  BOOST_CHECK(pr.auc > 0.5 && pr.auc < 1.);
+
+  for (size_t i = 0; i < det.x.size(); i++) {
+    BOOST_CHECK_CLOSE(1. - det.y[i], pr.x[i], 1e-9);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
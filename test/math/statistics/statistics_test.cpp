@@ -30,6 +30,7 @@
 
 #include <array>
 #include <list>
+#include <random>
 
 using namespace tl;
 
@@ -238,6 +239,65 @@ BOOST_FIXTURE_TEST_CASE(quantile, StatisticsTest)
   BOOST_CHECK_CLOSE(14, tl::quantile(vi2.begin(), vi2.end(), 0.5), 0.1);
 }
 
+BOOST_FIXTURE_TEST_CASE(quantiles, StatisticsTest)
+{
+  std::array<double, 3> p{0.75, 0.25, 0.5};
+  std::array<double, 3> q{};
+
+  tl::quantiles(vd.begin(), vd.end(), p.begin(), p.end(), q.begin());
+  BOOST_CHECK_CLOSE(8.5, q[0], 0.1);
+  BOOST_CHECK_CLOSE(6.875, q[1], 0.1);
+  BOOST_CHECK_CLOSE(8, q[2], 0.1);
+
+  tl::quantiles(l.begin(), l.end(), p.begin() + 2, p.end(), q.begin());
+  BOOST_CHECK_CLOSE(4.5, q[0], 0.1);
+
+  std::mt19937 generator(31);
+  std::uniform_int_distribution<int> distribution(0, 500);
+  std::vector<int> values(10001);
+  for (auto &value : values)
+    value = distribution(generator);
+
+  std::vector<int> sorted(values);
+  std::sort(sorted.begin(), sorted.end());
+
+  std::vector<double> probabilities;
+  for (int i = 1; i < 100; i++)
+    probabilities.push_back(i / 100.);
+
+  std::vector<double> percentiles(probabilities.size());
+  tl::quantilesInPlace(values.begin(), values.end(), probabilities.begin(), probabilities.end(), percentiles.begin());
+
+  for (size_t i = 0; i < probabilities.size(); i++) {
+    BOOST_CHECK_CLOSE(tl::quantile(sorted.begin(), sorted.end(), probabilities[i]), percentiles[i], 1e-10);
+    double idx = 10002. * probabilities[i] - 1.;
+    double expected = sorted[static_cast<size_t>(idx)] +
+      (sorted[static_cast<size_t>(std::ceil(idx))] - sorted[static_cast<size_t>(idx)]) * (idx - std::floor(idx));
+    BOOST_CHECK_CLOSE(expected, percentiles[i], 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_partition)
+{
+  std::mt19937 generator(37);
+  std::uniform_int_distribution<int> distribution(0, 100);
+  std::vector<int> values(100003);
+  for (auto &value : values)
+    value = distribution(generator);
+
+  std::vector<int> sorted(values);
+  std::sort(sorted.begin(), sorted.end());
+
+  auto middle = tl::internal::parallelPartition(values.begin(), values.end(), [](int x) { return x < 37; }, 4);
+
+  BOOST_CHECK(std::all_of(values.begin(), middle, [](int x) { return x < 37; }));
+  BOOST_CHECK(std::none_of(middle, values.end(), [](int x) { return x < 37; }));
+  BOOST_CHECK_EQUAL(std::lower_bound(sorted.begin(), sorted.end(), 37) - sorted.begin(), middle - values.begin());
+
+  std::sort(values.begin(), values.end());
+  BOOST_CHECK(values == sorted);
+}
+
 BOOST_FIXTURE_TEST_CASE(quartileCoefficientOfDispersion, StatisticsTest)
 {
   BOOST_CHECK_CLOSE(0.10569, tl::quartileCoefficientOfDispersion(vd.begin(), vd.end()), 0.1);
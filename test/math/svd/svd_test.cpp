@@ -24,6 +24,9 @@
  
 #define BOOST_TEST_MODULE Tidop svd test
 #include <boost/test/unit_test.hpp>
+
+#include <random>
+
 #include <tidop/math/algebra/svd.h>
 
 using namespace tl;
@@ -305,4 +308,125 @@ BOOST_FIXTURE_TEST_CASE(solve_matrix, SvdTest)
 
 }
 
+BOOST_AUTO_TEST_CASE(modes)
+{
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  /// One-sided Jacobi (12 x 5) and Golub-Reinsch (40 x 30)
+  for (size_t cols : {5, 30}) {
+
+    Matrix<double> a(cols == 5 ? 12 : 40, cols);
+    for (size_t r = 0; r < a.rows(); r++) {
+      for (size_t c = 0; c < a.cols(); c++) {
+        a[r][c] = distribution(generator);
+      }
+    }
+
+    SingularValueDecomposition<Matrix<double>> thin(a);
+    SingularValueDecomposition<Matrix<double>> no_u(a, SvdMode::no_u);
+    SingularValueDecomposition<Matrix<double>> values(a, SvdMode::singular_values);
+
+    Vector<double> w = thin.w();
+    Matrix<double> u = thin.u();
+    Matrix<double> v = thin.v();
+    Matrix<double> v2 = no_u.v();
+
+    for (size_t i = 0; i < a.cols(); i++) {
+      BOOST_CHECK_CLOSE(w[i], no_u.w()[i], 1e-8);
+      BOOST_CHECK_CLOSE(w[i], values.w()[i], 1e-8);
+      if (i > 0) BOOST_CHECK(w[i - 1] >= w[i]);
+      /// The sign convention takes U into account, so columns may be flipped
+      double sign = v[0][i] * v2[0][i] < 0. ? -1. : 1.;
+      for (size_t j = 0; j < a.cols(); j++) {
+        BOOST_CHECK_SMALL(v[j][i] - sign * v2[j][i], 1e-10);
+      }
+    }
+
+    for (size_t r = 0; r < a.rows(); r++) {
+      for (size_t c = 0; c < a.cols(); c++) {
+        double value = 0.;
+        for (size_t k = 0; k < a.cols(); k++)
+          value += u[r][k] * w[k] * v[c][k];
+        BOOST_CHECK_SMALL(value - a[r][c], 1e-12);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nullspace)
+{
+  /// 8 x 9 system: the last column of V spans the null space
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  Matrix<double> a(8, 9);
+  for (size_t r = 0; r < a.rows(); r++) {
+    for (size_t c = 0; c < a.cols(); c++) {
+      a[r][c] = distribution(generator);
+    }
+  }
+
+  SingularValueDecomposition<Matrix<double>> svd(a, SvdMode::no_u);
+
+  Matrix<double> v = svd.v();
+  BOOST_CHECK_SMALL(svd.w()[8], 1e-12);
+
+  for (size_t r = 0; r < a.rows(); r++) {
+    double value = 0.;
+    for (size_t c = 0; c < a.cols(); c++) {
+      value += a[r][c] * v[c][8];
+    }
+    BOOST_CHECK_SMALL(value, 1e-12);
+  }
+
+  double norm = 0.;
+  for (size_t c = 0; c < a.cols(); c++) {
+    norm += v[c][8] * v[c][8];
+  }
+  BOOST_CHECK_CLOSE(1., norm, 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_sweeps)
+{
+  /// Tall enough for the one-sided Jacobi and large enough to rotate the
+  /// pairs of each round in parallel
+  std::mt19937 generator(13);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  Matrix<double> a(1000, 190);
+  for (size_t r = 0; r < a.rows(); r++) {
+    for (size_t c = 0; c < a.cols(); c++) {
+      a[r][c] = distribution(generator);
+    }
+  }
+
+  SingularValueDecomposition<Matrix<double>> svd(a);
+
+  Matrix<double> u = svd.u();
+  Matrix<double> v = svd.v();
+  Vector<double> w = svd.w();
+
+  for (size_t r = 0; r < u.rows(); r++) {
+    for (size_t c = 0; c < u.cols(); c++) {
+      u[r][c] *= w[c];
+    }
+  }
+
+  Matrix<double> usvt = u * v.transpose();
+  Matrix<double> vtv = v.transpose() * v;
+
+  for (size_t r = 0; r < a.rows(); r++) {
+    for (size_t c = 0; c < a.cols(); c++) {
+      BOOST_CHECK_SMALL(usvt[r][c] - a[r][c], 1e-11);
+    }
+  }
+
+  for (size_t r = 0; r < a.cols(); r++) {
+    for (size_t c = 0; c < a.cols(); c++) {
+      BOOST_CHECK_SMALL(vtv[r][c] - (r == c ? 1. : 0.), 1e-11);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
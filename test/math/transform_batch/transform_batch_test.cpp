@@ -0,0 +1,210 @@
+/**************************************************************************
+ *                                                                        *
+ * Copyright (C) 2021 by Tidop Research Group                             *
+ * Copyright (C) 2021 by Esteban Ruiz de Oña Crespo                       *
+ *                                                                        *
+ * This file is part of TidopLib                                          *
+ *                                                                        *
+ * TidopLib is free software: you can redistribute it and/or modify       *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * TidopLib is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with TidopLib. If not, see <http://www.gnu.org/licenses>.*
+ *                                                                        *
+ * @license LGPL-3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>         *
+ *                                                                        *
+ **************************************************************************/
+ 
+
+#define BOOST_TEST_MODULE Tidop transform batch test
+#include <boost/test/unit_test.hpp>
+#include <tidop/math/geometry/affine.h>
+#include <tidop/math/geometry/rotation.h>
+#include <tidop/math/geometry/scaling.h>
+#include <tidop/math/geometry/translation.h>
+
+#include <vector>
+
+using namespace tl;
+
+BOOST_AUTO_TEST_SUITE(TransformBatchTestSuite)
+
+struct TransformBatchTest
+{
+
+    TransformBatchTest()
+      : affine_2d(1.5, 0.75, 150., 75., 0.25),
+        affine_3d(Matrix<double, 3, 4>{{0.9, -0.1, 0.2, 10.},
+                                       {0.1, 1.1, -0.3, -5.},
+                                       {-0.2, 0.3, 0.95, 2.5}}),
+        rotation_2d(Matrix<double, 2, 2>{{0.8, -0.6},
+                                         {0.6, 0.8}}),
+        scaling_2d(2., 0.5),
+        scaling_3d(2., 0.5, 3.),
+        translation_2d(150., 75.),
+        translation_3d(150., 75., -10.)
+    {
+    }
+
+    ~TransformBatchTest() {}
+
+    void setup()
+    {
+        /// Tamaño que no es múltiplo del registro SIMD para probar la cola escalar
+        small_size = 11;
+        /// Suficientemente grande para que se procese en paralelo
+        large_size = 100003;
+
+        x.resize(large_size);
+        y.resize(large_size);
+        z.resize(large_size);
+
+        for (size_t i = 0; i < large_size; i++) {
+            x[i] = 4157222.543 + static_cast<double>(i) * 0.25;
+            y[i] = 664789.307 - static_cast<double>(i) * 0.5;
+            z[i] = 850.2 + static_cast<double>(i % 100);
+        }
+    }
+
+    void teardown()
+    {
+
+    }
+
+    Affine<double, 2> affine_2d;
+    Affine<double, 3> affine_3d;
+    Rotation<double, 2> rotation_2d;
+    Scaling<double, 2> scaling_2d;
+    Scaling<double, 3> scaling_3d;
+    Translation<double, 2> translation_2d;
+    Translation<double, 3> translation_3d;
+    size_t small_size;
+    size_t large_size;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+};
+
+template<typename Transform>
+void checkTransform2D(const Transform &transform,
+                      const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      size_t size)
+{
+    std::vector<double> x_out(size);
+    std::vector<double> y_out(size);
+
+    transform.transform(x.data(), y.data(), x_out.data(), y_out.data(), size);
+
+    for (size_t i = 0; i < size; i++) {
+        Point<double> point = transform.transform(Point<double>(x[i], y[i]));
+        BOOST_CHECK_CLOSE(point.x, x_out[i], 0.000001);
+        BOOST_CHECK_CLOSE(point.y, y_out[i], 0.000001);
+    }
+
+    /// In-place
+    std::vector<double> x_in_place(x.begin(), x.begin() + size);
+    std::vector<double> y_in_place(y.begin(), y.begin() + size);
+
+    transform.transform(x_in_place.data(), y_in_place.data(), size);
+
+    for (size_t i = 0; i < size; i++) {
+        BOOST_CHECK_EQUAL(x_out[i], x_in_place[i]);
+        BOOST_CHECK_EQUAL(y_out[i], y_in_place[i]);
+    }
+}
+
+template<typename Transform>
+void checkTransform3D(const Transform &transform,
+                      const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      const std::vector<double> &z,
+                      size_t size)
+{
+    std::vector<double> x_out(size);
+    std::vector<double> y_out(size);
+    std::vector<double> z_out(size);
+
+    transform.transform(x.data(), y.data(), z.data(), x_out.data(), y_out.data(), z_out.data(), size);
+
+    for (size_t i = 0; i < size; i++) {
+        Point3<double> point = transform.transform(Point3<double>(x[i], y[i], z[i]));
+        BOOST_CHECK_CLOSE(point.x, x_out[i], 0.000001);
+        BOOST_CHECK_CLOSE(point.y, y_out[i], 0.000001);
+        BOOST_CHECK_CLOSE(point.z, z_out[i], 0.000001);
+    }
+
+    /// In-place
+    std::vector<double> x_in_place(x.begin(), x.begin() + size);
+    std::vector<double> y_in_place(y.begin(), y.begin() + size);
+    std::vector<double> z_in_place(z.begin(), z.begin() + size);
+
+    transform.transform(x_in_place.data(), y_in_place.data(), z_in_place.data(), size);
+
+    for (size_t i = 0; i < size; i++) {
+        BOOST_CHECK_EQUAL(x_out[i], x_in_place[i]);
+        BOOST_CHECK_EQUAL(y_out[i], y_in_place[i]);
+        BOOST_CHECK_EQUAL(z_out[i], z_in_place[i]);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(affine, TransformBatchTest)
+{
+    checkTransform2D(affine_2d, x, y, small_size);
+    checkTransform2D(affine_2d, x, y, large_size);
+    checkTransform3D(affine_3d, x, y, z, small_size);
+    checkTransform3D(affine_3d, x, y, z, large_size);
+}
+
+BOOST_FIXTURE_TEST_CASE(rotation, TransformBatchTest)
+{
+    checkTransform2D(rotation_2d, x, y, small_size);
+    checkTransform2D(rotation_2d, x, y, large_size);
+}
+
+BOOST_FIXTURE_TEST_CASE(scaling, TransformBatchTest)
+{
+    checkTransform2D(scaling_2d, x, y, small_size);
+    checkTransform2D(scaling_2d, x, y, large_size);
+    checkTransform3D(scaling_3d, x, y, z, small_size);
+    checkTransform3D(scaling_3d, x, y, z, large_size);
+}
+
+BOOST_FIXTURE_TEST_CASE(translation, TransformBatchTest)
+{
+    checkTransform2D(translation_2d, x, y, small_size);
+    checkTransform2D(translation_2d, x, y, large_size);
+    checkTransform3D(translation_3d, x, y, z, small_size);
+    checkTransform3D(translation_3d, x, y, z, large_size);
+}
+
+BOOST_FIXTURE_TEST_CASE(float_points, TransformBatchTest)
+{
+    Affine<float, 2> affine(1.5f, 0.75f, 150.f, 75.f, 0.25f);
+
+    std::vector<float> x_float(small_size);
+    std::vector<float> y_float(small_size);
+    for (size_t i = 0; i < small_size; i++) {
+        x_float[i] = static_cast<float>(i) * 10.f;
+        y_float[i] = static_cast<float>(i) * -5.f;
+    }
+
+    std::vector<float> x_out(small_size);
+    std::vector<float> y_out(small_size);
+    affine.transform(x_float.data(), y_float.data(), x_out.data(), y_out.data(), small_size);
+
+    for (size_t i = 0; i < small_size; i++) {
+        Point<float> point = affine.transform(Point<float>(x_float[i], y_float[i]));
+        BOOST_CHECK_CLOSE(point.x, x_out[i], 0.001f);
+        BOOST_CHECK_CLOSE(point.y, y_out[i], 0.001f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()